@@ -0,0 +1,165 @@
+#include "assetloader.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define ASSET_TIMELINE_NAME_LENGTH  32      // TimelineEvent name length
+
+// Decode and upload wrapped in a startup timeline section each
+static bool DecodeAssetJob(const AssetJob *job)
+{
+    char section[ASSET_TIMELINE_NAME_LENGTH];
+    snprintf(section, sizeof(section), "decode %s", job->name);
+
+    BeginTimelineSection(section);
+    bool decoded = job->decode(job->context);
+    EndTimelineSection(section);
+
+    return decoded;
+}
+
+static bool UploadAssetJob(const AssetJob *job, bool decoded)
+{
+    char section[ASSET_TIMELINE_NAME_LENGTH];
+    snprintf(section, sizeof(section), "upload %s", job->name);
+
+    BeginTimelineSection(section);
+    bool ready = job->upload(job->context, decoded);
+    EndTimelineSection(section);
+
+    return ready;
+}
+
+static void *AssetLoaderWorker(void *arg)
+{
+    AssetLoader *loader = (AssetLoader *)arg;
+
+    pthread_mutex_lock(&loader->mutex);
+
+    while (!loader->closing) {
+        if (loader->decodedCount == loader->jobCount) {
+            pthread_cond_wait(&loader->workAdded, &loader->mutex);
+            continue;
+        }
+
+        // NOTE: Only the worker moves decodedCount, the job can be read without holding the lock
+        int index = loader->decodedCount;
+        AssetJob job = loader->jobs[index];
+        pthread_mutex_unlock(&loader->mutex);
+
+        bool decoded = DecodeAssetJob(&job);
+
+        pthread_mutex_lock(&loader->mutex);
+        loader->jobs[index].decoded = decoded;
+        loader->jobs[index].state = ASSET_STATE_DECODED;
+        loader->decodedCount++;
+    }
+
+    pthread_mutex_unlock(&loader->mutex);
+
+    return NULL;
+}
+
+void AssetLoaderInit(AssetLoader *loader)
+{
+    memset(loader, 0, sizeof(AssetLoader));
+    pthread_mutex_init(&loader->mutex, NULL);
+    pthread_cond_init(&loader->workAdded, NULL);
+
+    loader->threaded = (pthread_create(&loader->worker, NULL, AssetLoaderWorker, loader) == 0);
+    if (!loader->threaded) TraceLog(LOG_WARNING, "ASSETS: Worker thread not available, assets are decoded on the GL thread");
+}
+
+int AssetLoaderAdd(AssetLoader *loader, const char *name, AssetDecodeCallback decode, AssetUploadCallback upload, void *context)
+{
+    pthread_mutex_lock(&loader->mutex);
+
+    if (loader->jobCount >= ASSET_LOADER_MAX_JOBS) {
+        pthread_mutex_unlock(&loader->mutex);
+        TraceLog(LOG_WARNING, "ASSETS: Job queue full, loading right away");
+        upload(context, decode(context));
+        return -1;
+    }
+
+    int handle = loader->jobCount;
+    loader->jobs[handle] = (AssetJob){ name, decode, upload, context, false, ASSET_STATE_QUEUED };
+    loader->jobCount++;
+
+    pthread_cond_signal(&loader->workAdded);
+    pthread_mutex_unlock(&loader->mutex);
+
+    return handle;
+}
+
+void AssetLoaderUpdate(AssetLoader *loader, float budgetMs)
+{
+    double startTime = GetTime();
+
+    // NOTE: Without a worker, the GL thread decodes one job per frame (the loading screen still updates)
+    if (!loader->threaded && (loader->decodedCount < loader->jobCount)) {
+        AssetJob *job = &loader->jobs[loader->decodedCount];
+        job->decoded = DecodeAssetJob(job);
+        job->state = ASSET_STATE_DECODED;
+        loader->decodedCount++;
+    }
+
+    pthread_mutex_lock(&loader->mutex);
+
+    while (loader->uploadedCount < loader->decodedCount) {
+        int index = loader->uploadedCount;
+        AssetJob job = loader->jobs[index];
+        pthread_mutex_unlock(&loader->mutex);
+
+        bool ready = UploadAssetJob(&job, job.decoded) && job.decoded;
+
+        pthread_mutex_lock(&loader->mutex);
+        loader->jobs[index].state = ready? ASSET_STATE_READY : ASSET_STATE_FAILED;
+        loader->uploadedCount++;
+
+        if ((GetTime() - startTime)*1000.0 >= budgetMs) break;
+    }
+
+    pthread_mutex_unlock(&loader->mutex);
+}
+
+AssetState GetAssetState(AssetLoader *loader, int handle)
+{
+    // NOTE: Jobs run right away (queue full) have no state left, the asset itself tells if it loaded
+    if ((handle < 0) || (handle >= ASSET_LOADER_MAX_JOBS)) return ASSET_STATE_READY;
+
+    pthread_mutex_lock(&loader->mutex);
+    AssetState state = (handle < loader->jobCount)? loader->jobs[handle].state : ASSET_STATE_FAILED;
+    pthread_mutex_unlock(&loader->mutex);
+
+    return state;
+}
+
+float GetAssetLoaderProgress(AssetLoader *loader)
+{
+    // NOTE: Job and upload counts only change on the GL thread
+    return (loader->jobCount > 0)? (float)loader->uploadedCount/(float)loader->jobCount : 1.0f;
+}
+
+bool IsAssetLoaderDone(AssetLoader *loader)
+{
+    return (loader->uploadedCount == loader->jobCount);
+}
+
+void AssetLoaderUnload(AssetLoader *loader)
+{
+    if (loader->threaded) {
+        pthread_mutex_lock(&loader->mutex);
+        loader->closing = true;
+        pthread_cond_signal(&loader->workAdded);
+        pthread_mutex_unlock(&loader->mutex);
+
+        pthread_join(loader->worker, NULL);
+    }
+
+    // Decoded or not, contexts are released by their upload callback
+    for (int i = loader->uploadedCount; i < loader->jobCount; i++) loader->jobs[i].upload(loader->jobs[i].context, false);
+
+    pthread_cond_destroy(&loader->workAdded);
+    pthread_mutex_destroy(&loader->mutex);
+    memset(loader, 0, sizeof(AssetLoader));
+}
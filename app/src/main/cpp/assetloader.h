@@ -0,0 +1,88 @@
+#ifndef ASSETLOADER_H
+#define ASSETLOADER_H
+
+#include "raylib.h"
+
+#include <pthread.h>
+
+// --- Asynchronous Asset Loading ---
+// Each job is split in two: file reads and decoding (PNG, KTX/ASTC, baked fonts) run on a worker thread,
+// the GPU upload runs on the GL thread from AssetLoaderUpdate(), a few per frame within a time budget.
+// The first frames can then draw a loading screen while assets come in. Jobs are decoded and uploaded
+// in the order they were added. Without a worker thread, AssetLoaderUpdate() decodes one job per frame.
+// Decodes and uploads are startup timeline sections ("decode <name>", "upload <name>").
+#define ASSET_LOADER_MAX_JOBS       32
+#define ASSET_UPLOAD_BUDGET_MS    4.0f      // Default GL thread time per frame spent on uploads
+
+// Decoding must not call GL (textures, shaders) nor TextFormat() (shared buffers)
+typedef bool (*AssetDecodeCallback)(void *context);                 // Worker thread, returns false on failure
+typedef bool (*AssetUploadCallback)(void *context, bool decoded);   // GL thread, always called once (also to clean up)
+
+typedef enum AssetState {
+    ASSET_STATE_QUEUED = 0,
+    ASSET_STATE_DECODED,        // Waiting for its upload
+    ASSET_STATE_READY,
+    ASSET_STATE_FAILED
+} AssetState;
+
+typedef struct AssetJob {
+    const char *name;           // Timeline name (the asset file), kept by the caller
+    AssetDecodeCallback decode;
+    AssetUploadCallback upload;
+    void *context;
+    bool decoded;               // Decode result, valid once the job is past ASSET_STATE_QUEUED
+    AssetState state;
+} AssetJob;
+
+typedef struct AssetLoader {
+    AssetJob jobs[ASSET_LOADER_MAX_JOBS];
+    int jobCount;               // Jobs added
+    int decodedCount;           // Jobs decoded (the first ones)
+    int uploadedCount;          // Jobs uploaded (the first ones)
+    bool threaded;              // Worker thread running
+    bool closing;               // Worker asked to stop
+    pthread_t worker;
+    pthread_mutex_t mutex;      // Protects the counts, job states and flags
+    pthread_cond_t workAdded;
+} AssetLoader;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Starts the worker thread (jobs are decoded on the GL thread when it can't be created).
+ */
+void AssetLoaderInit(AssetLoader *loader);
+
+/**
+ * @brief Queues a job, returns its handle.
+ *
+ * Returns -1 when the queue is full, the job is then decoded and uploaded right away.
+ */
+int AssetLoaderAdd(AssetLoader *loader, const char *name, AssetDecodeCallback decode, AssetUploadCallback upload, void *context);
+
+/**
+ * @brief Uploads decoded jobs (GL thread, once per frame), at least one and then up to 'budgetMs'.
+ */
+void AssetLoaderUpdate(AssetLoader *loader, float budgetMs);
+
+AssetState GetAssetState(AssetLoader *loader, int handle);
+
+/**
+ * @brief Jobs done (ready or failed) over jobs added, 1.0 when nothing is queued.
+ */
+float GetAssetLoaderProgress(AssetLoader *loader);
+
+bool IsAssetLoaderDone(AssetLoader *loader);
+
+/**
+ * @brief Stops the worker after its current job, jobs left are only cleaned up (never become ready).
+ */
+void AssetLoaderUnload(AssetLoader *loader);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // ASSETLOADER_H
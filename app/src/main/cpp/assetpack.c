@@ -0,0 +1,146 @@
+#include "assetpack.h"
+
+#include "external/sinfl.h"     // Deflate decompressor, implemented in raylib (SUPPORT_COMPRESSION_API)
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct AssetPack {
+    const unsigned char *data;              // Whole pack, from LoadFileDataMapped()
+    int dataSize;
+    const AssetPackEntryRecord *entries;    // Sorted by name
+    int entryCount;
+} AssetPack;
+
+static AssetPack pack = { 0 };
+
+// Buffers of deflated files in use, everything else returned points into the pack
+static unsigned char *inflated[ASSET_PACK_MAX_INFLATED] = { 0 };
+static pthread_mutex_t inflatedMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static int CompareEntryName(const void *name, const void *entry)
+{
+    return strcmp((const char *)name, ((const AssetPackEntryRecord *)entry)->name);
+}
+
+static const unsigned char *LoadPackedFile(const char *fileName, int *dataSize)
+{
+    const AssetPackEntryRecord *entry = bsearch(fileName, pack.entries, pack.entryCount, sizeof(AssetPackEntryRecord), CompareEntryName);
+    if (entry == NULL) return NULL;
+
+    const unsigned char *packed = pack.data + entry->offset;
+
+    if (entry->compression == ASSET_PACK_STORED) {
+        *dataSize = (int)entry->size;
+        return packed;
+    }
+
+    unsigned char *data = (unsigned char *)MemAlloc(entry->size);
+    int size = (data != NULL)? sinflate(data, (int)entry->size, packed, (int)entry->packedSize) : 0;
+
+    if (size != (int)entry->size) {
+        TraceLog(LOG_WARNING, "PACK: [%s] Failed to inflate packed file", fileName);
+        MemFree(data);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&inflatedMutex);
+    int slot = -1;
+    for (int i = 0; i < ASSET_PACK_MAX_INFLATED; i++) {
+        if (inflated[i] == NULL) { inflated[i] = data; slot = i; break; }
+    }
+    pthread_mutex_unlock(&inflatedMutex);
+
+    if (slot < 0) {
+        TraceLog(LOG_WARNING, "PACK: [%s] Too many inflated files in use, loading it from the assets", fileName);
+        MemFree(data);
+        return NULL;
+    }
+
+    *dataSize = size;
+    return data;
+}
+
+static bool UnloadPackedFile(const unsigned char *data)
+{
+    if ((data >= pack.data) && (data < pack.data + pack.dataSize)) return true;
+
+    bool found = false;
+    pthread_mutex_lock(&inflatedMutex);
+    for (int i = 0; i < ASSET_PACK_MAX_INFLATED; i++) {
+        if (inflated[i] == data) { inflated[i] = NULL; found = true; break; }
+    }
+    pthread_mutex_unlock(&inflatedMutex);
+
+    if (found) MemFree((unsigned char *)data);
+
+    return found;
+}
+
+// Header, index order and every entry range, so lookups and loads never need to check again
+static bool IsAssetPackValid(const unsigned char *data, int dataSize)
+{
+    const AssetPackFileHeader *header = (const AssetPackFileHeader *)data;
+
+    if ((data == NULL) || (dataSize < (int)sizeof(AssetPackFileHeader))) return false;
+    if ((memcmp(header->magic, ASSET_PACK_FILE_MAGIC, 4) != 0) || (header->version != ASSET_PACK_FILE_VERSION)) return false;
+    if (header->entryCount > (uint32_t)(dataSize - sizeof(AssetPackFileHeader))/sizeof(AssetPackEntryRecord)) return false;
+
+    const AssetPackEntryRecord *entries = (const AssetPackEntryRecord *)(data + sizeof(AssetPackFileHeader));
+
+    for (uint32_t i = 0; i < header->entryCount; i++) {
+        const AssetPackEntryRecord *entry = &entries[i];
+
+        if (entry->name[ASSET_PACK_NAME_LENGTH - 1] != '\0') return false;
+        if ((i > 0) && (strcmp(entries[i - 1].name, entry->name) >= 0)) return false;
+        if ((entry->offset%ASSET_PACK_ALIGNMENT) != 0) return false;
+        if ((entry->offset > (uint32_t)dataSize) || (entry->packedSize > (uint32_t)dataSize - entry->offset)) return false;
+        if ((entry->size == 0) || (entry->size > INT32_MAX)) return false;
+
+        if (entry->compression == ASSET_PACK_STORED) {
+            if (entry->packedSize != entry->size) return false;
+        }
+        else if (entry->compression != ASSET_PACK_DEFLATE) return false;
+    }
+
+    return true;
+}
+
+bool LoadAssetPack(const char *fileName)
+{
+    UnloadAssetPack();
+
+    int dataSize = 0;
+    const unsigned char *data = LoadFileDataMapped(fileName, &dataSize);
+
+    if (!IsAssetPackValid(data, dataSize)) {
+        if (data != NULL) TraceLog(LOG_WARNING, "PACK: [%s] Invalid asset pack, assets are loaded one by one", fileName);
+        else TraceLog(LOG_INFO, "PACK: [%s] No asset pack, assets are loaded one by one", fileName);
+        UnloadFileDataMapped(data);
+        return false;
+    }
+
+    pack.data = data;
+    pack.dataSize = dataSize;
+    pack.entries = (const AssetPackEntryRecord *)(data + sizeof(AssetPackFileHeader));
+    pack.entryCount = (int)((const AssetPackFileHeader *)data)->entryCount;
+
+    SetLoadFileDataMappedCallback(LoadPackedFile);
+    SetUnloadFileDataMappedCallback(UnloadPackedFile);
+
+    TraceLog(LOG_INFO, "PACK: [%s] Asset pack loaded (%i files, %i bytes)", fileName, pack.entryCount, dataSize);
+
+    return true;
+}
+
+void UnloadAssetPack(void)
+{
+    if (pack.data == NULL) return;
+
+    SetLoadFileDataMappedCallback(NULL);
+    SetUnloadFileDataMappedCallback(NULL);
+
+    UnloadFileDataMapped(pack.data);
+    pack = (AssetPack){ 0 };
+}
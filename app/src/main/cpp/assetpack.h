@@ -0,0 +1,63 @@
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include "raylib.h"
+
+#include <stdint.h>
+
+// --- Asset Pack File Format ---
+// Built offline by tools/assetpack: many asset files in one (data.pak), so the APK asset is opened once
+// and mapped once instead of once per file. Header, then one record per file sorted by name (strcmp order,
+// looked up by binary search), then the file data in the same order, so files of a directory are next to
+// each other. All values little-endian. Data starts on ASSET_PACK_ALIGNMENT bytes, files read in place
+// (course packs, atlas tables) stay aligned. Files are deflated when it saves enough (tables, fonts, GPU
+// compressed atlases with empty areas), small PNGs are stored as they are.
+#define ASSET_PACK_FILE_MAGIC       "PACK"
+#define ASSET_PACK_FILE_VERSION     1
+#define ASSET_PACK_NAME_LENGTH      48      // Path relative to the assets root ("gfx/atlas.png"), NUL terminated
+#define ASSET_PACK_ALIGNMENT        16      // File data offset alignment
+#define ASSET_PACK_MAX_INFLATED     32      // Deflated files loaded at once (they need a buffer of their own)
+
+typedef enum AssetPackCompression {
+    ASSET_PACK_STORED = 0,      // Data used in place, straight from the mapped pack
+    ASSET_PACK_DEFLATE          // Raw deflate stream (sdefl/sinfl), inflated on every load
+} AssetPackCompression;
+
+typedef struct AssetPackFileHeader {
+    char magic[4];              // ASSET_PACK_FILE_MAGIC
+    uint32_t version;           // ASSET_PACK_FILE_VERSION
+    uint32_t entryCount;        // AssetPackEntryRecord[entryCount] follow the header
+    uint32_t reserved;
+} AssetPackFileHeader;
+
+typedef struct AssetPackEntryRecord {
+    char name[ASSET_PACK_NAME_LENGTH];
+    uint32_t offset;            // From the start of the pack, multiple of ASSET_PACK_ALIGNMENT
+    uint32_t size;              // File size
+    uint32_t packedSize;        // Bytes in the pack (size when stored)
+    uint32_t compression;       // AssetPackCompression
+} AssetPackEntryRecord;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Maps 'fileName' and serves LoadFileDataMapped() from it (after InitWindow()).
+ *
+ * Files missing from the pack, or every file when it can't be loaded, still come from the assets.
+ * Loaders that go through LoadFileDataMapped() (LoadImage(), LoadFontEx(), LoadWave(), the atlas,
+ * SDF font and course loaders) find packed files without changes, from any thread.
+ */
+bool LoadAssetPack(const char *fileName);
+
+/**
+ * @brief Unmaps the pack, files loaded from it must be unloaded first.
+ */
+void UnloadAssetPack(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // ASSETPACK_H
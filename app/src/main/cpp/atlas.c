@@ -0,0 +1,198 @@
+#include "atlas.h"
+#include "texformat.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// Atlas being loaded: the region table and the image are read first (any thread), the texture made after
+typedef struct AtlasLoad {
+    SpriteAtlas *atlas;
+    char imageFile[256];
+    char tableFile[256];
+    Image image;
+} AtlasLoad;
+
+static bool DecodeSpriteAtlas(void *context)
+{
+    AtlasLoad *load = (AtlasLoad *)context;
+    SpriteAtlas *atlas = load->atlas;
+
+    int dataSize = 0;
+    const unsigned char *data = LoadFileDataMapped(load->tableFile, &dataSize);
+    if (data == NULL) return false;
+
+    const AtlasFileHeader *header = (const AtlasFileHeader *)data;
+    bool valid = ((unsigned int)dataSize >= sizeof(AtlasFileHeader)) &&
+                 (memcmp(header->magic, ATLAS_FILE_MAGIC, 4) == 0) &&
+                 (header->version == ATLAS_FILE_VERSION) &&
+                 (header->regionCount <= ATLAS_MAX_REGIONS) &&
+                 ((unsigned int)dataSize >= sizeof(AtlasFileHeader) + header->regionCount*sizeof(AtlasRegionRecord));
+
+    if (valid) {
+        const AtlasRegionRecord *records = (const AtlasRegionRecord *)(data + sizeof(AtlasFileHeader));
+
+        for (uint32_t i = 0; i < header->regionCount && valid; i++) {
+            const AtlasRegionRecord *record = &records[i];
+            if (record->name[ATLAS_NAME_LENGTH - 1] != '\0' ||
+                (uint32_t)record->x + record->width > header->width ||
+                (uint32_t)record->y + record->height > header->height) valid = false;
+
+            memcpy(atlas->names[i], record->name, ATLAS_NAME_LENGTH);
+            atlas->regions[i] = (Rectangle){ (float)record->x, (float)record->y, (float)record->width, (float)record->height };
+        }
+        atlas->regionCount = (int)header->regionCount;
+    }
+
+    if (valid) {
+        load->image = LoadImageCompressed(load->imageFile);
+        valid = (load->image.data != NULL) && ((uint32_t)load->image.width == header->width) && ((uint32_t)load->image.height == header->height);
+    }
+
+    UnloadFileDataMapped(data);
+    return valid;
+}
+
+static bool UploadSpriteAtlas(void *context, bool decoded)
+{
+    AtlasLoad *load = (AtlasLoad *)context;
+    SpriteAtlas *atlas = load->atlas;
+    bool valid = decoded;
+
+    if (valid) {
+        atlas->texture = LoadTextureFromImage(load->image);
+        valid = (atlas->texture.id != 0);
+    }
+
+    if (valid) {
+        TraceLog(LOG_INFO, "ATLAS: [%s] Loaded %i sprites (%ix%i)", load->imageFile, atlas->regionCount, atlas->texture.width, atlas->texture.height);
+    } else {
+        TraceLog(LOG_WARNING, "ATLAS: [%s] Invalid or unsupported atlas, sprites are loaded one by one", load->tableFile);
+        if (atlas->texture.id != 0) UnloadTexture(atlas->texture);
+        memset(atlas, 0, sizeof(SpriteAtlas));
+    }
+
+    UnloadImage(load->image);
+    load->image = (Image){ 0 };
+    return valid;
+}
+
+static bool UploadSpriteAtlasAsync(void *context, bool decoded)
+{
+    bool valid = UploadSpriteAtlas(context, decoded);
+    MemFree(context);
+    return valid;
+}
+
+static void InitAtlasLoad(AtlasLoad *load, SpriteAtlas *atlas, const char *imageFile, const char *tableFile)
+{
+    memset(atlas, 0, sizeof(SpriteAtlas));
+    memset(load, 0, sizeof(AtlasLoad));
+    load->atlas = atlas;
+    strncpy(load->imageFile, imageFile, sizeof(load->imageFile) - 1);
+    strncpy(load->tableFile, tableFile, sizeof(load->tableFile) - 1);
+}
+
+bool LoadSpriteAtlas(SpriteAtlas *atlas, const char *imageFile, const char *tableFile)
+{
+    AtlasLoad load = { 0 };
+    InitAtlasLoad(&load, atlas, imageFile, tableFile);
+
+    return UploadSpriteAtlas(&load, DecodeSpriteAtlas(&load));
+}
+
+int LoadSpriteAtlasAsync(AssetLoader *loader, SpriteAtlas *atlas, const char *imageFile, const char *tableFile)
+{
+    AtlasLoad *load = (AtlasLoad *)MemAlloc(sizeof(AtlasLoad));
+    InitAtlasLoad(load, atlas, imageFile, tableFile);
+    GetBestTextureFormat();     // Checked once on the GL thread
+
+    return AssetLoaderAdd(loader, imageFile, DecodeSpriteAtlas, UploadSpriteAtlasAsync, load);
+}
+
+void UnloadSpriteAtlas(SpriteAtlas *atlas)
+{
+    if (atlas->texture.id != 0) UnloadTexture(atlas->texture);
+    memset(atlas, 0, sizeof(SpriteAtlas));
+}
+
+Sprite LoadAtlasSprite(const SpriteAtlas *atlas, const char *name)
+{
+    for (int i = 0; i < atlas->regionCount; i++) {
+        if (strcmp(atlas->names[i], name) == 0) return (Sprite){ atlas->texture, atlas->regions[i] };
+    }
+
+    Texture2D texture = LoadTexture(TextFormat("gfx/%s.png", name));
+    return (Sprite){ texture, (Rectangle){ 0.0f, 0.0f, (float)texture.width, (float)texture.height } };
+}
+
+void LoadAtlasSprites(const SpriteAtlas *atlas, const char **names, int count, Sprite *sprites)
+{
+    // Sprites missing from the atlas gathered first, their files then load in one batch (LoadTextures())
+    char (*paths)[ATLAS_NAME_LENGTH + 16] = MemAlloc(count*sizeof(*paths));
+    const char **fileNames = (const char **)MemAlloc(count*sizeof(const char *));
+    int *missing = (int *)MemAlloc(count*sizeof(int));
+    int missingCount = 0;
+
+    for (int i = 0; i < count; i++) {
+        sprites[i] = (Sprite){ 0 };
+
+        bool found = false;
+        for (int r = 0; r < atlas->regionCount; r++) {
+            if (strcmp(atlas->names[r], names[i]) == 0) {
+                sprites[i] = (Sprite){ atlas->texture, atlas->regions[r] };
+                found = true;
+                break;
+            }
+        }
+
+        if (!found) {
+            snprintf(paths[missingCount], sizeof(paths[missingCount]), "gfx/%s.png", names[i]);
+            fileNames[missingCount] = paths[missingCount];
+            missing[missingCount++] = i;
+        }
+    }
+
+    if (missingCount > 0) {
+        Texture2D *textures = (Texture2D *)MemAlloc(missingCount*sizeof(Texture2D));
+        LoadTextures(fileNames, missingCount, textures);
+
+        for (int i = 0; i < missingCount; i++) {
+            sprites[missing[i]] = (Sprite){ textures[i], (Rectangle){ 0.0f, 0.0f, (float)textures[i].width, (float)textures[i].height } };
+        }
+        MemFree(textures);
+    }
+
+    MemFree(missing);
+    MemFree(fileNames);
+    MemFree(paths);
+}
+
+void UnloadSprite(Sprite sprite, const SpriteAtlas *atlas)
+{
+    if (sprite.texture.id != 0 && sprite.texture.id != atlas->texture.id) UnloadTexture(sprite.texture);
+}
+
+void SetShapesTextureAtlas(const SpriteAtlas *atlas)
+{
+    for (int i = 0; i < atlas->regionCount; i++) {
+        if (strcmp(atlas->names[i], ATLAS_WHITE_NAME) == 0) {
+            SetShapesTexture(atlas->texture, atlas->regions[i]);
+            return;
+        }
+    }
+
+    SetShapesTexture((Texture2D){ 0 }, (Rectangle){ 0 });
+}
+
+void DrawSpriteEx(Sprite sprite, Vector2 position, float scale, Color tint)
+{
+    Rectangle dest = { position.x, position.y, sprite.source.width*scale, sprite.source.height*scale };
+    DrawTexturePro(sprite.texture, sprite.source, dest, (Vector2){ 0.0f, 0.0f }, 0.0f, tint);
+}
+
+void DrawSpritePro(Sprite sprite, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint)
+{
+    source.x += sprite.source.x;
+    source.y += sprite.source.y;
+    DrawTexturePro(sprite.texture, source, dest, origin, rotation, tint);
+}
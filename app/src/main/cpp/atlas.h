@@ -0,0 +1,102 @@
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#include "raylib.h"
+#include "assetloader.h"
+
+#include <stdint.h>
+
+// --- Sprite Atlas File Format ---
+// Built offline by tools/atlaspack: all gfx/ sprites packed into one image (gfx/atlas.png),
+// plus a region table (gfx/atlas.bin): header, then one record per sprite, all values little-endian.
+// Every region is surrounded by ATLAS_PADDING pixels (more up to the next ATLAS_BLOCK_SIZE), edge pixels
+// are repeated into them so filtering never samples a neighbour. The atlas also holds a small white region
+// for shapes. The image may also be shipped GPU compressed, see texformat.h.
+#define ATLAS_FILE_MAGIC            "ATLS"
+#define ATLAS_FILE_VERSION          1
+#define ATLAS_NAME_LENGTH           24      // Sprite name (file name without extension), NUL terminated
+#define ATLAS_MAX_REGIONS           64
+#define ATLAS_PADDING               2       // Pixels between regions (edge pixels repeated)
+#define ATLAS_BLOCK_SIZE            4       // Regions and their padding cover whole 4x4 blocks, so GPU compressed blocks never mix sprites
+#define ATLAS_WHITE_NAME            "white" // Region used by SetShapesTexture()
+
+typedef struct AtlasFileHeader {
+    char magic[4];              // ATLAS_FILE_MAGIC
+    uint32_t version;           // ATLAS_FILE_VERSION
+    uint32_t width;             // Atlas image size
+    uint32_t height;
+    uint32_t regionCount;       // AtlasRegionRecord[regionCount] follow the header
+} AtlasFileHeader;
+
+typedef struct AtlasRegionRecord {
+    char name[ATLAS_NAME_LENGTH];
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+} AtlasRegionRecord;
+
+// Sprite texture and its source rectangle (the whole texture for standalone sprites)
+typedef struct Sprite {
+    Texture2D texture;
+    Rectangle source;
+} Sprite;
+
+typedef struct SpriteAtlas {
+    Texture2D texture;
+    int regionCount;
+    char names[ATLAS_MAX_REGIONS][ATLAS_NAME_LENGTH];
+    Rectangle regions[ATLAS_MAX_REGIONS];
+} SpriteAtlas;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Loads the atlas image and its region table, checking every region lies inside the image.
+ *
+ * Returns false (and an empty atlas) when either file is missing or invalid.
+ */
+bool LoadSpriteAtlas(SpriteAtlas *atlas, const char *imageFile, const char *tableFile);
+
+/**
+ * @brief Queues LoadSpriteAtlas() on 'loader', returns the job handle.
+ *
+ * The atlas must not be used before the job is done (it is empty if the load failed).
+ */
+int LoadSpriteAtlasAsync(AssetLoader *loader, SpriteAtlas *atlas, const char *imageFile, const char *tableFile);
+
+void UnloadSpriteAtlas(SpriteAtlas *atlas);
+
+/**
+ * @brief Looks a sprite up by name, or loads gfx/<name>.png on its own when the atlas doesn't have it.
+ *
+ * Sprites from the atlas share its texture and must not be unloaded, see UnloadSprite().
+ */
+Sprite LoadAtlasSprite(const SpriteAtlas *atlas, const char *name);
+
+/**
+ * @brief LoadAtlasSprite() for 'count' names, the pngs of the sprites missing from the atlas decoded in parallel.
+ */
+void LoadAtlasSprites(const SpriteAtlas *atlas, const char **names, int count, Sprite *sprites);
+
+/**
+ * @brief Unloads a standalone sprite texture (sprites from the atlas are left alone).
+ */
+void UnloadSprite(Sprite sprite, const SpriteAtlas *atlas);
+
+/**
+ * @brief Uses the atlas white region for shapes, so shapes and sprites share one texture in the batch.
+ */
+void SetShapesTextureAtlas(const SpriteAtlas *atlas);
+
+// Sprite versions of DrawTextureEx() and DrawTexturePro(), 'source' is relative to the sprite
+void DrawSpriteEx(Sprite sprite, Vector2 position, float scale, Color tint);
+void DrawSpritePro(Sprite sprite, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // ATLAS_H
@@ -0,0 +1,456 @@
+// Engine micro-benchmarks for the paths the game hits every frame
+// NOTE: Built instead of the game with app.benchmark=true (gradle.properties), or -DAPP_BENCHMARK=ON
+// Every result is one JSON line, logged as "BENCH: {...}" (adb logcat -s raylib) and saved to
+// bench.json in the app internal storage (adb shell run-as <application_id> cat files/bench.json)
+// Draw benchmarks measure the CPU side: filling the rlgl batch plus rlDrawRenderBatchActive(),
+// the GPU executes the draws asynchronously after that
+
+#include "raylib.h"
+#include "rlgl.h"
+#include <raymath.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(PLATFORM_ANDROID)
+#include <sys/system_properties.h>  // Required for: __system_property_get()
+#endif
+
+#include "physics.h"
+#include "course.h"
+#include "rules.h"
+#include "../spritebatch.h"
+#include "../textcache.h"
+#include "../shapecache.h"
+
+#define BENCH_WARMUP_SAMPLES       3        // Samples run before measuring (caches, driver, clocks)
+#define BENCH_SAMPLES             15        // Samples per benchmark, results use the median
+#define BENCH_MAX_RESULTS         32
+#define BENCH_QUADS_PER_FRAME  20000        // Sprites drawn per sample (several batch flushes)
+#define BENCH_TEXT_PER_FRAME     200        // Strings drawn per sample
+#define BENCH_MEASURE_PER_SAMPLE 2000       // Strings measured per sample
+#define BENCH_SHAPES_PER_FRAME  2000        // Rounded rectangles drawn per sample
+#define BENCH_VECTOR_COUNT      4096        // Vectors per raymath pass
+#define BENCH_VECTOR_PASSES       64        // raymath passes per sample
+#define BENCH_PHYSICS_TICKS     4800        // Physics ticks per sample (20 s of play at 240 Hz)
+
+#if defined(__aarch64__)
+    #define BENCH_ABI "arm64-v8a"
+#elif defined(__arm__)
+    #define BENCH_ABI "armeabi-v7a"
+#elif defined(__x86_64__)
+    #define BENCH_ABI "x86_64"
+#elif defined(__i386__)
+    #define BENCH_ABI "x86"
+#else
+    #define BENCH_ABI "unknown"
+#endif
+
+#if defined(PHYSICS_NO_SIMD)
+    #define BENCH_PHYSICS_PATH "scalar"
+#else
+    #define BENCH_PHYSICS_PATH "simd"
+#endif
+
+// Operations done by one sample, and the time it took (seconds)
+typedef struct BenchSample {
+    double ops;
+    double time;
+} BenchSample;
+
+// Runs one sample of a benchmark, returns the operations done
+typedef BenchSample (*BenchFunc)(void);
+
+typedef struct BenchResult {
+    char name[32];
+    char unit[16];
+    double median;                  // Operations per second (or the value, for counts)
+    double min;
+    double max;
+} BenchResult;
+
+static BenchResult results[BENCH_MAX_RESULTS] = { 0 };
+static int resultCount = 0;
+static char device[96] = "unknown";
+
+static Texture2D sprite = { 0 };
+static SpriteBatch spriteBatch = { 0 };
+static Font font = { 0 };
+static TextCache textCache = { 0 };
+static ShapeCache shapeCache = { 0 };
+static const char *benchText = "Strokes: 3  Par: 2  Hole 7 - Nice shot! Hole in one? 0123456789";
+
+static PhysicsWorld world = { 0 };
+static const unsigned char *courseData = NULL;
+static CoursePack coursePack = { 0 };
+
+static volatile float sink = 0.0f;  // Keeps the compiler from removing benchmark loops
+
+//----------------------------------------------------------------------------------
+// Results
+//----------------------------------------------------------------------------------
+static int CompareDouble(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Logs a result as one JSON line and keeps it for bench.json
+static void AddResult(const char *name, const char *unit, double median, double min, double max)
+{
+    if (resultCount >= BENCH_MAX_RESULTS) return;
+
+    BenchResult *result = &results[resultCount++];
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    snprintf(result->unit, sizeof(result->unit), "%s", unit);
+    result->median = median;
+    result->min = min;
+    result->max = max;
+
+    TraceLog(LOG_INFO, "BENCH: {\"bench\":\"%s\",\"abi\":\"%s\",\"device\":\"%s\",\"value\":%.1f,\"min\":%.1f,\"max\":%.1f,\"unit\":\"%s\"}",
+             name, BENCH_ABI, device, median, min, max, unit);
+}
+
+// Runs a benchmark sample by sample, each within its own frame so the batch is flushed and swapped as in the game
+static void RunBench(const char *name, const char *unit, BenchFunc func)
+{
+    double rates[BENCH_SAMPLES] = { 0 };
+
+    for (int i = 0; i < BENCH_WARMUP_SAMPLES + BENCH_SAMPLES; i++)
+    {
+        BeginDrawing();
+            ClearBackground(DARKGREEN);
+            BenchSample sample = func();
+            DrawText(TextFormat("BENCH: %s (%i/%i)", name, i + 1, BENCH_WARMUP_SAMPLES + BENCH_SAMPLES), 20, 20, 20, RAYWHITE);
+        EndDrawing();
+
+        if (i >= BENCH_WARMUP_SAMPLES) rates[i - BENCH_WARMUP_SAMPLES] = (sample.time > 0.0)? sample.ops/sample.time : 0.0;
+    }
+
+    qsort(rates, BENCH_SAMPLES, sizeof(double), CompareDouble);
+    AddResult(name, unit, rates[BENCH_SAMPLES/2], rates[0], rates[BENCH_SAMPLES - 1]);
+}
+
+static void SaveResults(const char *fileName)
+{
+    int capacity = 512 + resultCount*256;
+    char *text = (char *)RL_CALLOC(capacity, 1);
+    int length = snprintf(text, capacity, "{\"abi\":\"%s\",\"device\":\"%s\",\"gl\":%i,\"screen\":[%i,%i],\"physics\":\"%s\",\"results\":[\n",
+                          BENCH_ABI, device, rlGetVersion(), GetRenderWidth(), GetRenderHeight(), BENCH_PHYSICS_PATH);
+
+    for (int i = 0; i < resultCount; i++)
+    {
+        length += snprintf(text + length, capacity - length, "  {\"bench\":\"%s\",\"value\":%.1f,\"min\":%.1f,\"max\":%.1f,\"unit\":\"%s\"}%s\n",
+                           results[i].name, results[i].median, results[i].min, results[i].max, results[i].unit, (i < resultCount - 1)? "," : "");
+    }
+
+    snprintf(text + length, capacity - length, "]}\n");
+    SaveFileText(fileName, text);
+    RL_FREE(text);
+}
+
+//----------------------------------------------------------------------------------
+// Benchmarks: rlgl batch
+//----------------------------------------------------------------------------------
+static BenchSample BenchTexturePro(void)
+{
+    Rectangle source = { 0.0f, 0.0f, (float)sprite.width, (float)sprite.height };
+    int width = GetScreenWidth(), height = GetScreenHeight();
+
+    double start = GetTime();
+    for (int i = 0; i < BENCH_QUADS_PER_FRAME; i++)
+    {
+        Rectangle dest = { (float)((i*37)%width), (float)((i*53)%height), 60.0f, 60.0f };
+        DrawTexturePro(sprite, source, dest, (Vector2){ 30.0f, 30.0f }, (float)(i%360), WHITE);
+    }
+    rlDrawRenderBatchActive();
+
+    return (BenchSample){ BENCH_QUADS_PER_FRAME, GetTime() - start };
+}
+
+static BenchSample BenchTextureEx(void)
+{
+    int width = GetScreenWidth(), height = GetScreenHeight();
+
+    double start = GetTime();
+    for (int i = 0; i < BENCH_QUADS_PER_FRAME; i++)
+    {
+        DrawTextureEx(sprite, (Vector2){ (float)((i*37)%width), (float)((i*53)%height) }, 0.0f, 1.0f, WHITE);
+    }
+    rlDrawRenderBatchActive();
+
+    return (BenchSample){ BENCH_QUADS_PER_FRAME, GetTime() - start };
+}
+
+// Same sprites as BenchTexturePro(), through the instanced batch
+static BenchSample BenchSpriteBatch(void)
+{
+    Rectangle source = { 0.0f, 0.0f, (float)sprite.width, (float)sprite.height };
+    int width = GetScreenWidth(), height = GetScreenHeight();
+
+    double start = GetTime();
+    SpriteBatchBegin(&spriteBatch, sprite);
+    for (int i = 0; i < BENCH_QUADS_PER_FRAME; i++)
+    {
+        Rectangle dest = { (float)((i*37)%width), (float)((i*53)%height), 60.0f, 60.0f };
+        SpriteBatchDraw(&spriteBatch, source, dest, (Vector2){ 30.0f, 30.0f }, (float)(i%360), WHITE);
+    }
+    SpriteBatchEnd(&spriteBatch);
+
+    return (BenchSample){ BENCH_QUADS_PER_FRAME, GetTime() - start };
+}
+
+static BenchSample BenchDrawText(void)
+{
+    int glyphs = (int)strlen(benchText);
+    int height = GetScreenHeight();
+
+    double start = GetTime();
+    for (int i = 0; i < BENCH_TEXT_PER_FRAME; i++)
+    {
+        DrawTextEx(font, benchText, (Vector2){ 20.0f, (float)((i*32)%height) }, 32.0f, 0.0f, WHITE);
+    }
+    rlDrawRenderBatchActive();
+
+    return (BenchSample){ (double)BENCH_TEXT_PER_FRAME*glyphs, GetTime() - start };
+}
+
+// Same strings as draw_text_ex, replayed from the text cache (one lookup per string)
+static BenchSample BenchDrawTextRun(void)
+{
+    int glyphs = (int)strlen(benchText);
+    int height = GetScreenHeight();
+
+    double start = GetTime();
+    for (int i = 0; i < BENCH_TEXT_PER_FRAME; i++)
+    {
+        const TextRun *run = GetTextRun(&textCache, font, benchText, 32.0f, 0.0f);
+        DrawTextRun(run, (Vector2){ 20.0f, (float)((i*32)%height) }, WHITE);
+    }
+    rlDrawRenderBatchActive();
+
+    return (BenchSample){ (double)BENCH_TEXT_PER_FRAME*glyphs, GetTime() - start };
+}
+
+static BenchSample BenchMeasureText(void)
+{
+    int glyphs = (int)strlen(benchText);
+    float width = 0.0f;
+
+    double start = GetTime();
+    for (int i = 0; i < BENCH_MEASURE_PER_SAMPLE; i++) width += MeasureTextEx(font, benchText, 32.0f, 0.0f).x;
+    double time = GetTime() - start;
+
+    sink = width;
+    return (BenchSample){ (double)BENCH_MEASURE_PER_SAMPLE*glyphs, time };
+}
+
+// Same button as the game "Play Again" screen
+static BenchSample BenchRoundedRect(void)
+{
+    int width = GetScreenWidth(), height = GetScreenHeight();
+
+    double start = GetTime();
+    for (int i = 0; i < BENCH_SHAPES_PER_FRAME; i++)
+    {
+        Rectangle rec = { (float)((i*37)%width), (float)((i*53)%height), 200.0f, 50.0f };
+        DrawRectangleRounded(rec, 0.5f, 10, LIME);
+    }
+    rlDrawRenderBatchActive();
+
+    return (BenchSample){ BENCH_SHAPES_PER_FRAME, GetTime() - start };
+}
+
+static BenchSample BenchRoundedRectCached(void)
+{
+    int width = GetScreenWidth(), height = GetScreenHeight();
+
+    double start = GetTime();
+    for (int i = 0; i < BENCH_SHAPES_PER_FRAME; i++)
+    {
+        Rectangle rec = { (float)((i*37)%width), (float)((i*53)%height), 200.0f, 50.0f };
+        DrawRectangleRoundedCached(&shapeCache, rec, 0.5f, 10, LIME);
+    }
+    rlDrawRenderBatchActive();
+
+    return (BenchSample){ BENCH_SHAPES_PER_FRAME, GetTime() - start };
+}
+
+// Vertices a DrawRectangleRounded() call adds to the batch, read from a private batch
+static int CountRoundedRectVertices(float roundness, int segments)
+{
+    rlRenderBatch batch = rlLoadRenderBatch(1, 8192);
+    rlSetRenderBatchActive(&batch);
+
+    DrawRectangleRounded((Rectangle){ 100.0f, 100.0f, 200.0f, 50.0f }, roundness, segments, LIME);
+
+    int vertices = 0;
+    for (int i = 0; i < batch.drawCounter; i++) vertices += batch.draws[i].vertexCount;
+
+    rlSetRenderBatchActive(NULL);
+    rlUnloadRenderBatch(batch);
+
+    return vertices;
+}
+
+//----------------------------------------------------------------------------------
+// Benchmarks: raymath and physics
+//----------------------------------------------------------------------------------
+static Vector2 vectors[BENCH_VECTOR_COUNT] = { 0 };
+
+// Mix of the vector ops used by the game and the simulation, 6 ops per vector
+static BenchSample BenchVectorOps(void)
+{
+    Vector2 sum = { 0 };
+
+    double start = GetTime();
+    for (int pass = 0; pass < BENCH_VECTOR_PASSES; pass++)
+    {
+        for (int i = 0; i < BENCH_VECTOR_COUNT; i++)
+        {
+            Vector2 v = Vector2Normalize(Vector2Subtract(vectors[i], sum));
+            v = Vector2Rotate(Vector2Scale(v, 0.5f), 0.01f);
+            sum = Vector2Add(sum, v);
+            sink += Vector2Distance(v, vectors[i]);
+        }
+    }
+    double time = GetTime() - start;
+
+    sink += sum.x + sum.y;
+    return (BenchSample){ (double)BENCH_VECTOR_PASSES*BENCH_VECTOR_COUNT*6, time };
+}
+
+// Shoots every ball again whenever they all stopped, measured in ball-ticks
+static BenchSample BenchPhysics(void)
+{
+    double start = GetTime();
+    for (int tick = 0; tick < BENCH_PHYSICS_TICKS; tick++)
+    {
+        PhysicsStep(&world);
+
+        if ((tick%64) == 0)
+        {
+            int stopped = 0;
+            for (int i = 0; i < world.ballCount; i++) stopped += PhysicsIsBallStopped(&world, i);
+
+            if (stopped == world.ballCount)
+            {
+                for (int i = 0; i < world.ballCount; i++)
+                {
+                    int range = (int)SHOT_MAX_DRAG_DISTANCE;
+                    Vector2 drag = { (float)GetRandomValue(-range, range), (float)GetRandomValue(-range, range) };
+                    if (world.balls.sunk[i]) PhysicsResetBall(&world, i, (Vector2){ 100.0f + 70.0f*i, 500.0f });
+                    PhysicsShoot(&world, i, GolfGetShotImpulse(drag));
+                }
+            }
+        }
+    }
+    double time = GetTime() - start;
+
+    return (BenchSample){ (double)BENCH_PHYSICS_TICKS*world.ballCount, time };
+}
+
+// Physics world on the first authored hole (bare playfield without a course file)
+static void SetupPhysics(int ballCount)
+{
+    PhysicsInit(&world, PHYSICS_TICK_RATE);
+    world.width = (float)GetScreenWidth();
+    world.height = (float)GetScreenHeight();
+    world.hole = (Vector2){ world.width - 200.0f, world.height/2.0f };
+
+    if (coursePack.holeCount > 0)
+    {
+        CourseHole hole = CoursePackGetHole(&coursePack, 0);
+        world.hole = hole.cup;
+        if (hole.size.x > 0.0f) world.width = hole.size.x;
+        if (hole.size.y > 0.0f) world.height = hole.size.y;
+        PhysicsSetGeometry(&world, hole.geometry);
+    }
+
+    for (int i = 0; i < ballCount; i++) PhysicsAddBall(&world, (Vector2){ 100.0f + 70.0f*i, 500.0f });
+}
+
+int main(void)
+{
+    SetConfigFlags(FLAG_WINDOW_HIGHDPI);
+    InitWindow(0, 0, "raymob bench");
+    SetTargetFPS(0);                // Samples are not paced, only the swap interval limits them
+    SetRandomSeed(1);
+
+#if defined(PLATFORM_ANDROID)
+    char model[PROP_VALUE_MAX] = { 0 };
+    char manufacturer[PROP_VALUE_MAX] = { 0 };
+    __system_property_get("ro.product.model", model);
+    __system_property_get("ro.product.manufacturer", manufacturer);
+    snprintf(device, sizeof(device), "%s %s", manufacturer, model);
+#endif
+
+    // Same assets as the game, generated fallbacks keep the runs comparable when missing
+    sprite = LoadTexture("gfx/ball.png");
+    if (sprite.id == 0)
+    {
+        Image image = GenImageChecked(64, 64, 8, 8, WHITE, LIGHTGRAY);
+        sprite = LoadTextureFromImage(image);
+        UnloadImage(image);
+    }
+
+    font = LoadFontEx("font/rodin.otf", 64, NULL, 0);
+    if (font.texture.id == 0) font = GetFontDefault();
+
+    int dataSize = 0;
+    courseData = LoadFileDataMapped("courses/holes.bin", &dataSize);
+    if ((courseData == NULL) || !CoursePackInit(&coursePack, courseData, (unsigned int)dataSize)) coursePack = (CoursePack){ 0 };
+
+    for (int i = 0; i < BENCH_VECTOR_COUNT; i++) vectors[i] = (Vector2){ (float)GetRandomValue(-1000, 1000), (float)GetRandomValue(-1000, 1000) };
+
+    TraceLog(LOG_INFO, "BENCH: Running on %s (%s), OpenGL %i, %ix%i", device, BENCH_ABI, rlGetVersion(), GetRenderWidth(), GetRenderHeight());
+
+    RunBench("draw_texture_pro", "quads/s", BenchTexturePro);
+    RunBench("draw_texture_ex", "quads/s", BenchTextureEx);
+    SpriteBatchInit(&spriteBatch);
+    RunBench(spriteBatch.instanced? "sprite_batch_instanced" : "sprite_batch_fallback", "quads/s", BenchSpriteBatch);
+    SpriteBatchUnload(&spriteBatch);
+    RunBench("draw_text_ex", "glyphs/s", BenchDrawText);
+    RunBench("draw_text_run", "glyphs/s", BenchDrawTextRun);
+    UnloadTextCache(&textCache);
+    RunBench("measure_text_ex", "glyphs/s", BenchMeasureText);
+    RunBench("draw_rectangle_rounded", "shapes/s", BenchRoundedRect);
+    RunBench("draw_rectangle_rounded_cached", "shapes/s", BenchRoundedRectCached);
+    UnloadShapeCache(&shapeCache);
+
+    int vertices = CountRoundedRectVertices(0.5f, 10);
+    AddResult("rectangle_rounded_vertices", "vertices", vertices, vertices, vertices);
+    vertices = CountRoundedRectVertices(0.5f, 0);
+    AddResult("rectangle_rounded_vertices_auto", "vertices", vertices, vertices, vertices);
+
+    RunBench("raymath_vector2", "ops/s", BenchVectorOps);
+
+    SetupPhysics(1);
+    RunBench("physics_step_1_ball", "ball-ticks/s", BenchPhysics);
+    SetupPhysics(PHYSICS_MAX_BALLS);
+    RunBench("physics_step_max_balls", "ball-ticks/s", BenchPhysics);
+
+    SaveResults("bench.json");
+
+    // Results stay on screen until the app is closed
+    while (!WindowShouldClose())
+    {
+        BeginDrawing();
+            ClearBackground(DARKGREEN);
+            DrawText(TextFormat("BENCH: %s (%s), saved to bench.json", device, BENCH_ABI), 20, 20, 20, RAYWHITE);
+
+            for (int i = 0; i < resultCount; i++)
+            {
+                DrawText(TextFormat("%-32s %14.0f %s", results[i].name, results[i].median, results[i].unit), 20, 60 + 30*i, 20, RAYWHITE);
+            }
+        EndDrawing();
+    }
+
+    UnloadFileDataMapped(courseData);
+    if (font.texture.id != GetFontDefault().texture.id) UnloadFont(font);
+    UnloadTexture(sprite);
+    CloseWindow();
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include "coursecamera.h"
+
+#include <math.h>
+
+// Center of a view of 'half' extents kept over the course: clamped to the edges, centred when the course is smaller
+static float ClampToCourse(float center, float half, float size)
+{
+    if (size <= 2.0f*half) return size/2.0f;
+    return fminf(fmaxf(center, half), size - half);
+}
+
+void CourseCameraReset(CourseCamera *camera)
+{
+    camera->placed = false;
+}
+
+void CourseCameraUpdate(CourseCamera *camera, const PhysicsWorld *world, Vector2 focus, Vector2 viewSize, float zoom, float frameTime)
+{
+    Vector2 half = { viewSize.x/(2.0f*zoom), viewSize.y/(2.0f*zoom) };
+
+    camera->goal.x = ClampToCourse(focus.x, half.x, world->width);
+    camera->goal.y = ClampToCourse(focus.y, half.y, world->height);
+
+    if (!camera->placed) {
+        camera->position = camera->goal;
+        camera->placed = true;
+    } else {
+        float t = 1.0f - expf(-COURSE_CAMERA_FOLLOW*fmaxf(frameTime, 0.0f));
+        camera->position.x += (camera->goal.x - camera->position.x)*t;
+        camera->position.y += (camera->goal.y - camera->position.y)*t;
+        if (fabsf(camera->goal.x - camera->position.x)*zoom < COURSE_CAMERA_SETTLE &&
+            fabsf(camera->goal.y - camera->position.y)*zoom < COURSE_CAMERA_SETTLE) camera->position = camera->goal;
+
+        // A resize or a new course size moves the edges, the view never glides outside of them
+        camera->position.x = ClampToCourse(camera->position.x, half.x, world->width);
+        camera->position.y = ClampToCourse(camera->position.y, half.y, world->height);
+    }
+
+    // NOTE: Offset and target on whole pixels, the static layer is drawn texel to pixel while scrolling
+    camera->viewSize = viewSize;
+    camera->camera.offset = (Vector2){ floorf(viewSize.x/2.0f), floorf(viewSize.y/2.0f) };
+    camera->camera.target = (Vector2){ roundf(camera->position.x*zoom)/zoom, roundf(camera->position.y*zoom)/zoom };
+    camera->camera.rotation = 0.0f;
+    camera->camera.zoom = zoom;
+}
+
+bool IsCourseCameraMoving(const CourseCamera *camera)
+{
+    return camera->placed && ((camera->position.x != camera->goal.x) || (camera->position.y != camera->goal.y));
+}
+
+Rectangle GetCameraView(Camera2D camera, Vector2 viewSize)
+{
+    return (Rectangle){
+        camera.target.x - camera.offset.x/camera.zoom,
+        camera.target.y - camera.offset.y/camera.zoom,
+        viewSize.x/camera.zoom,
+        viewSize.y/camera.zoom
+    };
+}
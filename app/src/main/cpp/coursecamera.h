@@ -0,0 +1,54 @@
+#ifndef COURSECAMERA_H
+#define COURSECAMERA_H
+
+#include "raylib.h"
+#include "physics.h"
+
+// --- Course Camera ---
+// Holes can be longer than the screen: the world is drawn through a Camera2D that glides after the
+// ball and stops at the course edges, a course smaller than the view is centred in it. The view
+// rectangle it gives is what the world drawing culls against (course geometry through the physics
+// grid, see PhysicsQueryGeometry(), balls and particles), so drawing costs what is on screen.
+// Courses the size of the screen (random holes) are drawn exactly as they were without the camera.
+#define COURSE_CAMERA_FOLLOW        6.0f    // Follow rate (1/s), the distance to the ball shrinks as exp(-rate*time)
+#define COURSE_CAMERA_SETTLE        0.5f    // Closer than this to its goal (px) the camera stops
+
+typedef struct CourseCamera {
+    Camera2D camera;            // For BeginMode2D(), the target is kept on whole pixels (the static layer stays sharp)
+    Vector2 position;           // World point at the center of the view, before pixel snapping
+    Vector2 goal;               // Where the camera is heading (the ball, kept inside the course)
+    Vector2 viewSize;           // Area the course is drawn into (px)
+    bool placed;                // Cleared to jump to the next goal instead of gliding there
+} CourseCamera;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Makes the next update jump to its focus (new hole).
+ */
+void CourseCameraReset(CourseCamera *camera);
+
+/**
+ * @brief Moves the camera after 'focus' (once per frame, before drawing).
+ *
+ * 'viewSize' is the area the course is drawn into and 'zoom' its scale (1 on screen).
+ */
+void CourseCameraUpdate(CourseCamera *camera, const PhysicsWorld *world, Vector2 focus, Vector2 viewSize, float zoom, float frameTime);
+
+/**
+ * @brief Checks if the camera is still gliding (frames must keep coming).
+ */
+bool IsCourseCameraMoving(const CourseCamera *camera);
+
+/**
+ * @brief Gets the world rectangle a camera shows in a 'viewSize' area (no rotation).
+ */
+Rectangle GetCameraView(Camera2D camera, Vector2 viewSize);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // COURSECAMERA_H
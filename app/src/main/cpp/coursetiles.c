@@ -0,0 +1,314 @@
+#include "coursetiles.h"
+#include "rlgl.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// Job worker: reads and decodes one tile image, nothing here touches GL
+static void DecodeCourseTile(void *context)
+{
+    CourseTileLoad *load = (CourseTileLoad *)context;
+
+    Image image = LoadImage(load->fileName);
+    if ((image.data != NULL) && (image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)) ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    load->decoded = (image.data != NULL) && (image.width == COURSE_TILE_IMAGE_SIZE) && (image.height == COURSE_TILE_IMAGE_SIZE) &&
+                    (image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    if (!load->decoded) {
+        UnloadImage(image);
+        image = (Image){ 0 };
+    }
+    load->image = image;
+}
+
+static Rectangle GetSlotRectangle(int slot)
+{
+    return (Rectangle){
+        (float)((slot % COURSE_TILE_CACHE_COLS)*COURSE_TILE_IMAGE_SIZE),
+        (float)((slot / COURSE_TILE_CACHE_COLS)*COURSE_TILE_IMAGE_SIZE),
+        (float)COURSE_TILE_IMAGE_SIZE,
+        (float)COURSE_TILE_IMAGE_SIZE
+    };
+}
+
+// Course area of a tile, the last column and row stop at the course edges
+static Rectangle GetTileRectangle(const CourseTiles *tiles, int tile)
+{
+    float x = (float)((tile % tiles->cols)*COURSE_TILE_SIZE);
+    float y = (float)((tile / tiles->cols)*COURSE_TILE_SIZE);
+
+    return (Rectangle){ x, y, fminf((float)COURSE_TILE_SIZE, tiles->size.x - x), fminf((float)COURSE_TILE_SIZE, tiles->size.y - y) };
+}
+
+static void ResetCache(CourseTiles *tiles)
+{
+    for (int i = 0; i < COURSE_TILE_CACHE_SLOTS; i++) tiles->slotTile[i] = -1;
+    for (int i = 0; i < tiles->cols*tiles->rows; i++) {
+        tiles->tileSlot[i] = -1;
+        if ((tiles->tileState[i] != COURSE_TILE_LOADING) && (tiles->tileState[i] != COURSE_TILE_FAILED)) tiles->tileState[i] = COURSE_TILE_MISSING;
+    }
+    tiles->pendingCount = 0;
+
+    // NOTE: Decodes in flight keep their slots, their uploads go into the new cache texture
+    for (int i = 0; i < COURSE_TILE_MAX_LOADS; i++) {
+        if (tiles->loads[i].tile >= 0) tiles->slotTile[tiles->loads[i].slot] = tiles->loads[i].tile;
+    }
+}
+
+bool CourseTilesLoad(CourseTiles *tiles, const char *prefix)
+{
+    CourseTilesUnload(tiles);
+
+    int dataSize = 0;
+    const unsigned char *data = LoadFileDataMapped(TextFormat("%s.bin", prefix), &dataSize);
+    if (data == NULL) return false;
+
+    const CourseTilesFileHeader *header = (const CourseTilesFileHeader *)data;
+    bool valid = ((unsigned int)dataSize >= sizeof(CourseTilesFileHeader)) &&
+                 (memcmp(header->magic, COURSE_TILES_FILE_MAGIC, 4) == 0) &&
+                 (header->version == COURSE_TILES_FILE_VERSION) &&
+                 (header->tileSize == COURSE_TILE_SIZE) && (header->padding == COURSE_TILE_PADDING) &&
+                 (header->cols > 0) && (header->rows > 0) && ((uint64_t)header->cols*header->rows <= COURSE_TILES_MAX_TILES) &&
+                 (header->cols == (header->width + COURSE_TILE_SIZE - 1)/COURSE_TILE_SIZE) &&
+                 (header->rows == (header->height + COURSE_TILE_SIZE - 1)/COURSE_TILE_SIZE) &&
+                 ((unsigned int)dataSize >= sizeof(CourseTilesFileHeader) + header->cols*header->rows*sizeof(CourseTileRecord)) &&
+                 (strlen(prefix) + sizeof("/000_000.png") <= COURSE_TILE_NAME_LENGTH);
+
+    if (!valid) {
+        TraceLog(LOG_WARNING, "TILES: [%s.bin] Invalid or unsupported tile set", prefix);
+        UnloadFileDataMapped(data);
+        return false;
+    }
+
+    int count = (int)(header->cols*header->rows);
+    tiles->data = data;
+    tiles->records = (const CourseTileRecord *)(data + sizeof(CourseTilesFileHeader));
+    snprintf(tiles->prefix, sizeof(tiles->prefix), "%s", prefix);
+    tiles->cols = (int)header->cols;
+    tiles->rows = (int)header->rows;
+    tiles->size = (Vector2){ (float)header->width, (float)header->height };
+
+    // NOTE: One block for the per tile arrays, slots first (2-byte aligned)
+    tiles->tileSlot = (int16_t *)MemAlloc((unsigned int)count*(sizeof(int16_t) + sizeof(uint8_t)));
+    tiles->tileState = (uint8_t *)(tiles->tileSlot + count);
+    for (int i = 0; i < COURSE_TILE_MAX_LOADS; i++) tiles->loads[i].tile = -1;
+    ResetCache(tiles);
+    tiles->frame = 1;
+
+    int images = 0;
+    for (int i = 0; i < count; i++) images += ((tiles->records[i].flags & COURSE_TILE_SOLID) == 0)? 1 : 0;
+    TraceLog(LOG_INFO, "TILES: [%s] %ix%i tiles over %.0fx%.0f px, %i images", prefix, tiles->cols, tiles->rows, tiles->size.x, tiles->size.y, images);
+
+    return true;
+}
+
+void CourseTilesUnload(CourseTiles *tiles)
+{
+    for (int i = 0; i < COURSE_TILE_MAX_LOADS; i++) {
+        CourseTileLoad *load = &tiles->loads[i];
+        if ((tiles->data == NULL) || (load->tile < 0)) continue;
+        WaitJob(load->job);
+        UnloadImage(load->image);
+    }
+
+    if (tiles->cache.id != 0) UnloadTexture(tiles->cache);
+    MemFree(tiles->tileSlot);
+    UnloadFileDataMapped(tiles->data);
+    memset(tiles, 0, sizeof(CourseTiles));
+}
+
+// Cache texture made on the first upload (and again after a trim or a lost context)
+static bool LoadCacheTexture(CourseTiles *tiles)
+{
+    if (tiles->cache.id != 0) return true;
+
+    int width = COURSE_TILE_CACHE_COLS*COURSE_TILE_IMAGE_SIZE;
+    int height = COURSE_TILE_CACHE_ROWS*COURSE_TILE_IMAGE_SIZE;
+    tiles->cache.id = rlLoadTexture(NULL, width, height, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, 1);
+    if (tiles->cache.id == 0) return false;
+
+    tiles->cache.width = width;
+    tiles->cache.height = height;
+    tiles->cache.mipmaps = 1;
+    tiles->cache.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    SetTextureFilter(tiles->cache, TEXTURE_FILTER_BILINEAR);
+    SetTextureWrap(tiles->cache, TEXTURE_WRAP_CLAMP);
+
+    return true;
+}
+
+// Free slot, or the least recently drawn tile not drawn this frame (-1 when every slot is in use)
+static int FindCacheSlot(const CourseTiles *tiles)
+{
+    int best = -1;
+    unsigned int bestFrame = tiles->frame;
+
+    for (int i = 0; i < COURSE_TILE_CACHE_SLOTS; i++) {
+        int tile = tiles->slotTile[i];
+        if (tile < 0) return i;
+        if (tiles->tileState[tile] != COURSE_TILE_CACHED) continue;
+
+        unsigned int frame = tiles->slotFrame[i];
+        if (frame < bestFrame) {
+            best = i;
+            bestFrame = frame;
+        }
+    }
+
+    return best;
+}
+
+static bool IsTileInside(const CourseTiles *tiles, int tile, Rectangle area)
+{
+    return CheckCollisionRecs(GetTileRectangle(tiles, tile), area);
+}
+
+void CourseTilesUpdate(CourseTiles *tiles, Rectangle keep)
+{
+    tiles->arrivedCount = 0;
+    if (tiles->data == NULL) return;
+
+    // Decoded tiles into their slots, a few per frame
+    for (int i = 0; i < COURSE_TILE_MAX_LOADS; i++) {
+        CourseTileLoad *load = &tiles->loads[i];
+        if ((load->tile < 0) || !IsJobDone(load->job)) continue;
+        if (tiles->arrivedCount == COURSE_TILE_UPLOADS) break;
+
+        bool uploaded = load->decoded && LoadCacheTexture(tiles);
+        if (uploaded) {
+            UpdateTextureRec(tiles->cache, GetSlotRectangle(load->slot), load->image.data);
+            tiles->tileSlot[load->tile] = (int16_t)load->slot;
+            tiles->tileState[load->tile] = COURSE_TILE_CACHED;
+            tiles->slotFrame[load->slot] = tiles->frame;
+            tiles->arrived[tiles->arrivedCount++] = GetTileRectangle(tiles, load->tile);
+        } else {
+            // NOTE: A tile that fails to decode keeps its average color, it isn't requested again
+            if (!load->decoded) TraceLog(LOG_WARNING, "TILES: [%s] Tile missing or invalid, drawn with its average color", load->fileName);
+            tiles->tileState[load->tile] = load->decoded? COURSE_TILE_MISSING : COURSE_TILE_FAILED;
+            tiles->slotTile[load->slot] = -1;
+        }
+
+        UnloadImage(load->image);
+        load->image = (Image){ 0 };
+        load->tile = -1;
+    }
+
+    // Requests out of the kept area are dropped (the view moved on), the others start in request order
+    int kept = 0;
+    for (int i = 0; i < tiles->pendingCount; i++) {
+        int tile = tiles->pending[i];
+        if (IsTileInside(tiles, tile, keep)) tiles->pending[kept++] = tile;
+        else tiles->tileState[tile] = COURSE_TILE_MISSING;
+    }
+    tiles->pendingCount = kept;
+
+    int started = 0;
+    for (int i = 0; (i < COURSE_TILE_MAX_LOADS) && (started < tiles->pendingCount); i++) {
+        CourseTileLoad *load = &tiles->loads[i];
+        if (load->tile >= 0) continue;
+
+        int slot = FindCacheSlot(tiles);
+        if (slot < 0) break;
+
+        // Least recently drawn tile evicted, the static layer keeps its pixels
+        int evicted = tiles->slotTile[slot];
+        if (evicted >= 0) {
+            tiles->tileSlot[evicted] = -1;
+            tiles->tileState[evicted] = COURSE_TILE_MISSING;
+        }
+
+        int tile = tiles->pending[started++];
+        tiles->slotTile[slot] = tile;
+        tiles->tileState[tile] = COURSE_TILE_LOADING;
+
+        load->tile = tile;
+        load->slot = slot;
+        load->decoded = false;
+        snprintf(load->fileName, sizeof(load->fileName), "%s/%i_%i.png", tiles->prefix, tile % tiles->cols, tile / tiles->cols);
+        load->job = RunJob(DecodeCourseTile, load, NULL, 0);
+    }
+
+    tiles->pendingCount -= started;
+    memmove(tiles->pending, tiles->pending + started, (size_t)tiles->pendingCount*sizeof(int));
+    tiles->frame++;
+}
+
+void CourseTilesDraw(CourseTiles *tiles, SpriteBatch *batch, Rectangle bounds)
+{
+    if (tiles->data == NULL) return;
+
+    int c0 = (int)floorf(bounds.x/COURSE_TILE_SIZE), c1 = (int)floorf((bounds.x + bounds.width)/COURSE_TILE_SIZE);
+    int r0 = (int)floorf(bounds.y/COURSE_TILE_SIZE), r1 = (int)floorf((bounds.y + bounds.height)/COURSE_TILE_SIZE);
+    if (c0 < 0) c0 = 0;
+    if (r0 < 0) r0 = 0;
+    if (c1 >= tiles->cols) c1 = tiles->cols - 1;
+    if (r1 >= tiles->rows) r1 = tiles->rows - 1;
+
+    // Average colors first: solid tiles, and images not in the cache (requested for the next frames)
+    Rectangle white = GetShapesTextureRectangle();
+    int images = 0;
+    SpriteBatchBegin(batch, GetShapesTexture());
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            int tile = r*tiles->cols + c;
+            const CourseTileRecord *record = &tiles->records[tile];
+            if (tiles->tileState[tile] == COURSE_TILE_CACHED) {
+                images++;
+                continue;
+            }
+
+            if (((record->flags & COURSE_TILE_SOLID) == 0) && (tiles->tileState[tile] == COURSE_TILE_MISSING) && (tiles->pendingCount < COURSE_TILE_MAX_PENDING)) {
+                tiles->pending[tiles->pendingCount++] = tile;
+                tiles->tileState[tile] = COURSE_TILE_PENDING;
+            }
+
+            Color color = { record->color[0], record->color[1], record->color[2], record->color[3] };
+            SpriteBatchDraw(batch, white, GetTileRectangle(tiles, tile), (Vector2){ 0.0f, 0.0f }, 0.0f, color);
+        }
+    }
+    SpriteBatchEnd(batch);
+
+    if (images == 0) return;
+
+    SpriteBatchBegin(batch, tiles->cache);
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            int tile = r*tiles->cols + c;
+            if (tiles->tileState[tile] != COURSE_TILE_CACHED) continue;
+
+            int slot = tiles->tileSlot[tile];
+            Rectangle dest = GetTileRectangle(tiles, tile);
+            Rectangle source = GetSlotRectangle(slot);
+            source = (Rectangle){ source.x + COURSE_TILE_PADDING, source.y + COURSE_TILE_PADDING, dest.width, dest.height };
+            tiles->slotFrame[slot] = tiles->frame;
+            SpriteBatchDraw(batch, source, dest, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+        }
+    }
+    SpriteBatchEnd(batch);
+}
+
+bool CourseTilesIsBusy(const CourseTiles *tiles)
+{
+    if (tiles->data == NULL) return false;
+    if ((tiles->pendingCount > 0) || (tiles->arrivedCount > 0)) return true;
+
+    for (int i = 0; i < COURSE_TILE_MAX_LOADS; i++) if (tiles->loads[i].tile >= 0) return true;
+
+    return false;
+}
+
+void CourseTilesTrim(CourseTiles *tiles)
+{
+    if ((tiles->data == NULL) || (tiles->cache.id == 0)) return;
+
+    UnloadTexture(tiles->cache);
+    tiles->cache = (Texture2D){ 0 };
+    ResetCache(tiles);
+}
+
+void CourseTilesRestore(CourseTiles *tiles)
+{
+    tiles->cache = (Texture2D){ 0 };
+    if (tiles->data != NULL) ResetCache(tiles);
+}
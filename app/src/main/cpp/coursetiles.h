@@ -0,0 +1,142 @@
+#ifndef COURSETILES_H
+#define COURSETILES_H
+
+#include "raylib.h"
+#include "spritebatch.h"
+
+#include <stdint.h>
+
+// --- Course Tile File Format ---
+// Built offline by tools/tilepack: the background of a large hole cut into COURSE_TILE_SIZE tiles, one PNG
+// each (<prefix>/<col>_<row>.png, in the asset pack), plus a table (<prefix>.bin): header, then one record
+// per tile, row by row, all values little-endian. Tile images carry COURSE_TILE_PADDING pixels of their
+// neighbours (edge pixels repeated at the course edges) so filtering never samples another cache slot.
+// Tiles of one colour have no image, they are drawn as a colored quad.
+#define COURSE_TILES_FILE_MAGIC     "TILE"
+#define COURSE_TILES_FILE_VERSION   1
+#define COURSE_TILE_SIZE            256     // Course pixels covered by a tile
+#define COURSE_TILE_PADDING         2       // Neighbour pixels around a tile image
+#define COURSE_TILE_IMAGE_SIZE      (COURSE_TILE_SIZE + 2*COURSE_TILE_PADDING)
+#define COURSE_TILES_MAX_TILES      16384   // Upper bound on cols*rows (a course of 32768x32768 px)
+#define COURSE_TILE_SOLID           1       // Record flag: the tile is its color, there is no image
+
+// --- Course Tile Streaming ---
+// Tiles are decoded on job workers (RunJob()) once a draw needs them, then uploaded a few per frame
+// into one cache texture of COURSE_TILE_CACHE_SLOTS slots, so VRAM stays bounded on any course size.
+// A full cache reuses the least recently drawn slot, tiles drawn this frame are never evicted. Until its
+// image is in, a tile is drawn with its average color. Tiles are drawn through the sprite batch, one
+// instanced draw for the images and one for the colored quads. The cache only feeds the static layer
+// (and exported videos): tiles uploaded this frame are listed in 'arrived' so the layer redraws them,
+// and the cache texture can be dropped when memory is low, the layer keeps the pixels.
+#define COURSE_TILE_CACHE_COLS      10      // Cache texture slots per row (10x10 slots, 27 MB in RGBA8)
+#define COURSE_TILE_CACHE_ROWS      10
+#define COURSE_TILE_CACHE_SLOTS     (COURSE_TILE_CACHE_COLS*COURSE_TILE_CACHE_ROWS)
+#define COURSE_TILE_MAX_LOADS       8       // Tiles decoded at once
+#define COURSE_TILE_MAX_PENDING     256     // Tiles waiting for a decode
+#define COURSE_TILE_UPLOADS         4       // Decoded tiles uploaded per frame
+#define COURSE_TILE_NAME_LENGTH     48      // Longest tile file name, as in the asset pack
+
+typedef struct CourseTilesFileHeader {
+    char magic[4];              // COURSE_TILES_FILE_MAGIC
+    uint32_t version;           // COURSE_TILES_FILE_VERSION
+    uint32_t tileSize;          // COURSE_TILE_SIZE
+    uint32_t padding;           // COURSE_TILE_PADDING
+    uint32_t width;             // Course size covered (px), the last column and row may be partial
+    uint32_t height;
+    uint32_t cols;              // CourseTileRecord[cols*rows] follow the header
+    uint32_t rows;
+} CourseTilesFileHeader;
+
+typedef struct CourseTileRecord {
+    uint8_t color[4];           // Average color (RGBA), the whole tile when COURSE_TILE_SOLID is set
+    uint32_t flags;
+} CourseTileRecord;
+
+typedef enum {
+    COURSE_TILE_MISSING = 0,    // Not in the cache
+    COURSE_TILE_PENDING,        // Drawn without its image, waiting for a load
+    COURSE_TILE_LOADING,        // Being decoded into its reserved slot
+    COURSE_TILE_CACHED,         // In its cache slot
+    COURSE_TILE_FAILED          // Image missing or invalid, drawn with its average color
+} CourseTileState;
+
+// Tile being decoded on a job worker
+typedef struct CourseTileLoad {
+    char fileName[COURSE_TILE_NAME_LENGTH];
+    Image image;                // RGBA8, COURSE_TILE_IMAGE_SIZE square
+    bool decoded;
+    unsigned int job;
+    int tile;                   // -1 when the load is free
+    int slot;                   // Cache slot reserved for it
+} CourseTileLoad;
+
+typedef struct CourseTiles {
+    const unsigned char *data;  // Mapped tile table, NULL without tiles
+    const CourseTileRecord *records;
+    char prefix[COURSE_TILE_NAME_LENGTH];
+    int cols;
+    int rows;
+    Vector2 size;               // Course size covered (px)
+    int16_t *tileSlot;          // cols*rows: cache slot of each tile, -1 when it is not in
+    uint8_t *tileState;         // cols*rows: CourseTileState
+    Texture2D cache;            // Slots of COURSE_TILE_IMAGE_SIZE, allocated on the first upload
+    int slotTile[COURSE_TILE_CACHE_SLOTS];              // Tile in each slot (or being loaded into it), -1 when free
+    unsigned int slotFrame[COURSE_TILE_CACHE_SLOTS];    // Frame the slot was last drawn
+    CourseTileLoad loads[COURSE_TILE_MAX_LOADS];
+    int pending[COURSE_TILE_MAX_PENDING];               // Tiles waiting for a load, in request order
+    int pendingCount;
+    Rectangle arrived[COURSE_TILE_UPLOADS];             // Course areas of the tiles uploaded by the last update
+    int arrivedCount;
+    unsigned int frame;
+} CourseTiles;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Opens the tile set '<prefix>.bin', tiles are streamed later from '<prefix>/<col>_<row>.png'.
+ *
+ * Returns false (and no tiles) when the table is missing or invalid. A tile set already open is closed.
+ */
+bool CourseTilesLoad(CourseTiles *tiles, const char *prefix);
+
+/**
+ * @brief Closes the tile set, waiting for the decodes in flight, and frees the cache texture.
+ */
+void CourseTilesUnload(CourseTiles *tiles);
+
+/**
+ * @brief Uploads decoded tiles and starts decoding requested ones (GL thread, once per frame).
+ *
+ * Requests outside of 'keep' (the static layer area) are dropped, they come again when drawn. Fills 'arrived' with the areas of the tiles uploaded.
+ */
+void CourseTilesUpdate(CourseTiles *tiles, Rectangle keep);
+
+/**
+ * @brief Draws the tiles over 'bounds' (world coordinates), requesting the ones not in the cache.
+ */
+void CourseTilesDraw(CourseTiles *tiles, SpriteBatch *batch, Rectangle bounds);
+
+/**
+ * @brief Checks for tiles waiting for a load, being decoded or uploaded by the last update.
+ *
+ * The game loop keeps running while it is true (no event waiting), tiles only stream from CourseTilesUpdate().
+ */
+bool CourseTilesIsBusy(const CourseTiles *tiles);
+
+/**
+ * @brief Frees the cache texture (memory trim), tiles are decoded again when next drawn.
+ */
+void CourseTilesTrim(CourseTiles *tiles);
+
+/**
+ * @brief Drops the cache texture of a lost GL context, decodes in flight are kept.
+ */
+void CourseTilesRestore(CourseTiles *tiles);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // COURSETILES_H
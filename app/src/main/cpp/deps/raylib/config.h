@@ -58,6 +58,15 @@
 //#define SUPPORT_BUSY_WAIT_LOOP          1
 // Use a partial-busy wait loop, in this case frame sleeps for most of the time, but then runs a busy loop at the end for accuracy
 #define SUPPORT_PARTIALBUSY_WAIT_LOOP    1
+// Android: frames wait for choreographer vsync callbacks instead of a timed (partial busy) wait,
+// in phase with the display refresh and without spinning the CPU at the end of the frame
+#define SUPPORT_ANDROID_FRAME_PACING    1
+// Android: input events (and sensor queues created on GetAndroidInputLooper()) are polled by a thread of their own,
+// read and timestamped as they arrive instead of once per frame, and registered by PollInputEvents() on the game thread
+#define SUPPORT_ANDROID_INPUT_THREAD    1
+// Save linked shader programs (OpenGL ES 3.0 program binaries) into the directory set by SetShaderCacheDirectory(),
+// later runs (and new GL contexts) load them instead of compiling the shader code again
+#define SUPPORT_SHADER_CACHE            1
 // Allow automatic screen capture of current screen pressing F12, defined in KeyCallback()
 #define SUPPORT_SCREEN_CAPTURE          1
 // Allow automatic gif recording of current screen pressing CTRL+F12, defined in KeyCallback()
@@ -66,6 +75,23 @@
 #define SUPPORT_COMPRESSION_API         1
 // Support automatic generated events, loading and recording of those events when required
 #define SUPPORT_AUTOMATION_EVENTS       1
+// Support frame profiler: per-phase frame times with rolling histograms (GetProfilerStats()),
+// and an optional on-screen overlay drawn by EndDrawing() (SetProfilerOverlay())
+#define SUPPORT_FRAME_PROFILER          1
+// Support startup timeline: timestamped sections and markers from process start (or resume) to the first
+// presented frame, logged once complete, read with GetTimelineEvents() and emitted as ATrace sections (Perfetto)
+#define SUPPORT_STARTUP_TIMELINE        1
+// Support touch history: every touch position reported (historical samples included) with its event time,
+// per pointer, for sub-frame flick velocity (GetTouchHistory(), GetTouchVelocity())
+#define SUPPORT_TOUCH_HISTORY           1
+// Support job system: a worker thread per big core (RunJob(), WaitJob(), ParallelFor()), each with a work-stealing
+// deque, shared by the engine and the game instead of threads of their own (jobs run right away without it)
+#define SUPPORT_JOB_SYSTEM              1
+// Support memory arenas: frame memory freed all at once by EndDrawing() (MemAllocFrame()) and scratch memory scopes
+// per thread (BeginScratchMemory(), MemAllocScratch()), bump allocated from blocks kept for the next frames
+#define SUPPORT_MEMORY_ARENAS           1
+// NOTE: Memory tracking by subsystem (SUPPORT_MEMORY_TRACKING) is not set here: raylib.h and the application need it
+// as well, it comes from the compilation line (CMake option RAYLIB_MEMORY_TRACKING)
 // Support custom frame control, only for advanced users
 // By default EndDrawing() does this job: draws everything + SwapScreenBuffer() + manage frame timing + PollInputEvents()
 // Enabling this flag allows manual control of the frame processes, use at your own risk
@@ -91,6 +117,21 @@
 
 #define MAX_AUTOMATION_EVENTS       16384       // Maximum number of automation events to record
 
+#define FRAME_PROFILER_HISTORY        240       // Frames kept by the frame profiler (rolling window)
+#define FRAME_PROFILER_BINS            96       // Frame profiler histogram bins (8 per octave from 1/32 ms, longer than ~117 ms go to the last one)
+
+#define MAX_TIMELINE_EVENTS            64       // Maximum number of startup timeline events (later ones are only traced)
+#define MAX_TOUCH_HISTORY              64       // Touch samples kept per pointer (a 120 Hz touch screen fills it in ~0.5 s)
+#define MAX_JOB_WORKERS                 8       // Maximum job worker threads (a thread waiting for a job runs jobs too)
+#define MAX_JOBS                      256       // Jobs queued, waiting or running at once (power of 2), more run right away
+#define MAX_JOB_DEPENDENTS              8       // Jobs waiting for one job, a job added after them waits for it when added
+#define FRAME_MEMORY_SIZE          262144       // Frame arena first block (bytes), the arena keeps the size of its busiest frame
+#define SCRATCH_MEMORY_SIZE         65536       // Scratch arena first block of every thread (bytes), kept at the size of its busiest scope
+#define MAX_ARENA_RETAINED_SIZE  16777216       // Arenas never keep more than this between frames (scopes), the rest goes back to the heap
+#define MAX_SCRATCH_SCOPES             16       // Maximum nested scratch memory scopes per thread
+#define GIF_RECORD_FRAMERATE           10       // GIF recording frames per second
+#define GIF_CAPTURE_BUFFERS             3       // GIF frames read from the screen (pixel buffers, OpenGL ES 3.0) or encoded on job workers at once
+
 //------------------------------------------------------------------------------------
 // Module: rlgl - Configuration values
 //------------------------------------------------------------------------------------
@@ -104,8 +145,9 @@
 #define RL_SUPPORT_MESH_GPU_SKINNING           1      // GPU skinning, comment if your GPU does not support more than 8 VBOs
 
 //#define RL_DEFAULT_BATCH_BUFFER_ELEMENTS    4096    // Default internal render batch elements limits
-#define RL_DEFAULT_BATCH_BUFFERS               1      // Default number of batch buffers (multi-buffering)
+#define RL_DEFAULT_BATCH_BUFFERS               3      // Default number of batch buffers (multi-buffering)
 #define RL_DEFAULT_BATCH_DRAWCALLS           256      // Default number of batch draw calls (by state changes: mode, texture)
+#define RL_DEFAULT_BATCH_UPLOAD_MODE           2      // Default batch vertex upload mode: 0-subdata, 1-orphan, 2-map unsynchronized (ES3, orphan otherwise)
 #define RL_DEFAULT_BATCH_MAX_TEXTURE_UNITS     4      // Maximum number of textures units that can be activated on batch drawing (SetShaderValueTexture())
 
 #define RL_MAX_MATRIX_STACK_SIZE              32      // Maximum size of internal Matrix stack
@@ -174,8 +216,8 @@
 #define SUPPORT_FILEFORMAT_DDS      1
 //#define SUPPORT_FILEFORMAT_HDR      1
 //#define SUPPORT_FILEFORMAT_PIC          1
-//#define SUPPORT_FILEFORMAT_KTX      1
-//#define SUPPORT_FILEFORMAT_ASTC     1
+#define SUPPORT_FILEFORMAT_KTX      1
+#define SUPPORT_FILEFORMAT_ASTC     1
 //#define SUPPORT_FILEFORMAT_PKM      1
 //#define SUPPORT_FILEFORMAT_PVR      1
 
@@ -250,6 +292,9 @@
 //#define SUPPORT_FILEFORMAT_FLAC         1
 #define SUPPORT_FILEFORMAT_XM           1
 #define SUPPORT_FILEFORMAT_MOD          1
+// Open the playback device for low latency: on AAudio LowLatency performance mode, exclusive sharing (a request,
+// shared when the device has no MMAP path), the device native sample rate and callbacks of one native burst
+#define SUPPORT_AUDIO_LOW_LATENCY       1
 
 // raudio: Configuration values
 //------------------------------------------------------------------------------------
@@ -258,6 +303,8 @@
 #define AUDIO_DEVICE_SAMPLE_RATE           0    // Device sample rate (device default)
 
 #define MAX_AUDIO_BUFFER_POOL_CHANNELS    16    // Maximum number of audio pool channels
+#define MAX_AUDIO_VOICES                  16    // Maximum number of sounds played at once by PlaySoundVoice(), preallocated
+#define MAX_AUDIO_VOICE_COMMANDS          64    // Voice commands queued until the next device callback (power of 2)
 
 //------------------------------------------------------------------------------------
 // Module: utils - Configuration Flags
@@ -50,12 +50,73 @@
 #include <android/window.h>             // Required for: AWINDOW_FLAG_FULLSCREEN definition and others
 //#include <android/sensor.h>           // Required for: Android sensors functions (accelerometer, gyroscope, light...)
 #include <jni.h>                        // Required for: JNIEnv and JavaVM [Used in OpenURL()]
+#include <stdint.h>                     // Required for: int64_t, uint64_t [Used in input events and frame timestamps]
 
 #include <EGL/egl.h>                    // Native platform windowing system interface
 
+#if defined(SUPPORT_ANDROID_FRAME_PACING)
+    #include <android/choreographer.h>  // Required for: AChoreographer_postFrameCallback() [Used in frame pacing]
+    #include <pthread.h>                // Required for: pthread_create(), pthread_cond_timedwait() [Used in frame pacing]
+    #include <errno.h>                  // Required for: ETIMEDOUT [Used in frame pacing]
+    #include <math.h>                   // Required for: ceil() [Used in frame pacing]
+
+    #define FRAME_PACING_IDLE_VSYNCS     8      // Vsyncs without a waiting frame before callbacks stop (paused, slow frames)
+    #define FRAME_PACING_MAX_GAP      0.1f      // Callback gaps longer than this (seconds) are restarts, not missed vsyncs
+#endif
+
+#if defined(SUPPORT_ANDROID_INPUT_THREAD)
+    #include <pthread.h>                // Required for: pthread_create() [Used in input thread]
+
+    #define ANDROID_INPUT_QUEUE_SIZE   128      // Input events waiting for the game thread, power of two
+#endif
+
+#define ANDROID_INPUT_HISTORY           8       // Historical motion samples kept per input event (the newest ones)
+#define ANDROID_INPUT_AXIS_COUNT        8       // Gamepad axes kept per input event
+
+#if defined(SUPPORT_STARTUP_TIMELINE)
+    #include <android/trace.h>          // Required for: ATrace_beginSection() [Used in startup timeline]
+    #include <unistd.h>                 // Required for: sysconf() [Used in GetProcessStartTime()]
+
+    // EGL_ANDROID_get_frame_timestamps, not in every NDK eglext.h
+    #ifndef EGL_TIMESTAMPS_ANDROID
+        #define EGL_TIMESTAMPS_ANDROID              0x3430
+    #endif
+    #ifndef EGL_DISPLAY_PRESENT_TIME_ANDROID
+        #define EGL_DISPLAY_PRESENT_TIME_ANDROID    0x343A
+    #endif
+    #ifndef EGL_TIMESTAMP_PENDING_ANDROID
+        #define EGL_TIMESTAMP_PENDING_ANDROID       -2
+    #endif
+
+    typedef EGLBoolean (*PFNEGLGETNEXTFRAMEIDANDROIDPROC)(EGLDisplay dpy, EGLSurface surface, uint64_t *frameId);
+    typedef EGLBoolean (*PFNEGLGETFRAMETIMESTAMPSANDROIDPROC)(EGLDisplay dpy, EGLSurface surface, uint64_t frameId, EGLint numTimestamps, const EGLint *timestamps, int64_t *values);
+#endif
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
+// Motion event historical sample, every pointer of the event
+typedef struct {
+    int64_t time;                       // Event time (nanoseconds, monotonic clock)
+    Vector2 position[MAX_TOUCH_POINTS]; // Display coordinates
+} AndroidInputSamples;
+
+// Copy of the AInputEvent data raylib uses, captured on the thread receiving the event
+// NOTE: The event itself is finished right away, the copy is registered later on the game thread
+typedef struct {
+    int32_t type;                       // AINPUT_EVENT_TYPE_KEY or AINPUT_EVENT_TYPE_MOTION
+    int32_t source;
+    int32_t action;
+    int32_t keycode;                    // Key events
+    int64_t time;                       // Event time (nanoseconds, monotonic clock)
+    int pointerCount;                   // Motion events pointers (only MAX_TOUCH_POINTS kept)
+    int32_t pointerId[MAX_TOUCH_POINTS];
+    Vector2 position[MAX_TOUCH_POINTS]; // Display coordinates
+    float axis[ANDROID_INPUT_AXIS_COUNT];           // Gamepad axes: X, Y, Z, RZ, BRAKE, GAS, HAT_X, HAT_Y
+    int historyCount;
+    AndroidInputSamples history[ANDROID_INPUT_HISTORY];
+} AndroidInputEvent;
+
 typedef struct {
     // Application data
     struct android_app *app;            // Android activity
@@ -68,6 +129,48 @@ typedef struct {
     EGLSurface surface;                 // Surface to draw on, framebuffers (connected to context)
     EGLContext context;                 // Graphic context, mode in which drawing can be done
     EGLConfig config;                   // Graphic config
+
+#if defined(SUPPORT_ANDROID_FRAME_PACING)
+    // Frame pacing data
+    pthread_t pacingThread;             // Thread owning the choreographer, receives the vsync callbacks
+    pthread_mutex_t pacingMutex;        // Protects the pacing and vsync data below
+    pthread_cond_t pacingCond;          // Signaled on every vsync callback
+    ALooper *pacingLooper;              // Pacing thread looper, woken to post frame callbacks again
+    bool pacingStarted;                 // Pacing thread created (joined on close)
+    bool pacingRunning;                 // Choreographer available and vsync callbacks coming
+    bool pacingPosted;                  // Frame callback pending
+    unsigned long long vsyncCount;      // Vsyncs seen since the pacing thread started
+    unsigned long long vsyncRequest;    // Vsync count when a frame last waited
+    unsigned long long vsyncRelease;    // Vsync count the last frame was released on
+    unsigned long vsyncTime;            // Last callback frame time (nanoseconds, wraps on 32-bit)
+    double vsyncPeriod;                 // Measured vsync period (seconds)
+#endif
+
+#if defined(SUPPORT_ANDROID_INPUT_THREAD)
+    // Input thread data
+    pthread_t inputThread;              // Thread polling the input queue (and the sensor queues attached to its looper)
+    pthread_mutex_t inputMutex;         // Held while the input thread reads the input queue, and while the queue changes
+    pthread_cond_t inputCond;           // Signaled once the input thread looper is ready
+    ALooper *inputLooper;               // Input thread looper, NULL without input thread
+    AInputQueue *inputQueue;            // Input queue attached to the input thread looper
+    void (*glueInputQueueCreated)(ANativeActivity *activity, AInputQueue *queue);      // Glue input queue callbacks, called after ours
+    void (*glueInputQueueDestroyed)(ANativeActivity *activity, AInputQueue *queue);
+    bool inputRunning;                  // Input thread polling (atomic access)
+    AndroidInputEvent inputEvents[ANDROID_INPUT_QUEUE_SIZE];    // Single producer (input thread), single consumer (game thread) ring
+    unsigned int inputHead;             // Next event written, only moved by the input thread
+    unsigned int inputTail;             // Next event read, only moved by the game thread
+    unsigned int inputDropped;          // Events lost to a full ring
+    bool eventWaiting;                  // Game thread waiting in the main looper for input (atomic access), woken by new events
+#endif
+
+#if defined(SUPPORT_STARTUP_TIMELINE)
+    // Frame timestamps data (EGL_ANDROID_get_frame_timestamps)
+    bool frameTimestamps;               // Surface collecting frame timestamps
+    PFNEGLGETNEXTFRAMEIDANDROIDPROC eglGetNextFrameId;
+    PFNEGLGETFRAMETIMESTAMPSANDROIDPROC eglGetFrameTimestamps;
+    uint64_t presentFrameId;            // Frame waiting for its present time
+    bool presentRequested;              // Frame id valid
+#endif
 } PlatformData;
 
 //----------------------------------------------------------------------------------
@@ -254,7 +357,37 @@ void ClosePlatform(void);        // Close platform
 
 static void AndroidCommandCallback(struct android_app *app, int32_t cmd);           // Process Android activity lifecycle commands
 static int32_t AndroidInputCallback(struct android_app *app, AInputEvent *event);   // Process Android inputs
+static int32_t AndroidCaptureInputEvent(const AInputEvent *event, AndroidInputEvent *input); // Copy input event data, returns if handled
+static void AndroidProcessInputEvent(const AndroidInputEvent *input);               // Register input event into the input state
 static GamepadButton AndroidTranslateGamepadButton(int button);                     // Map Android gamepad button to raylib gamepad button
+static bool RestoreGraphicsContext(void);                                           // Replace a lost EGL context, GPU resources are loaded again
+
+#if defined(SUPPORT_ANDROID_FRAME_PACING)
+static void InitFramePacing(void);                                                  // Start the vsync callbacks thread
+static void CloseFramePacing(void);                                                 // Stop the vsync callbacks thread
+static bool WaitFramePacing(double seconds);                                        // Wait for the vsync the next frame starts on (used by EndDrawing())
+static void *AndroidPacingThread(void *arg);                                        // Pacing thread: posts choreographer frame callbacks
+static void AndroidVsyncCallback(long frameTimeNanos, void *data);                  // Choreographer frame callback, counts vsyncs
+#endif
+
+#if defined(SUPPORT_ANDROID_INPUT_THREAD)
+static void InitInputThread(void);                                                  // Start the input thread, the input queue moves to its looper
+static void CloseInputThread(void);                                                 // Stop the input thread, the input queue goes back to the main looper
+static void MoveInputQueue(AInputQueue *queue);                                     // Attach the app input queue to the input thread looper
+static void DetachInputQueue(void);                                                 // Take the input queue away from the input thread
+static void AndroidInputQueueCreated(ANativeActivity *activity, AInputQueue *queue);   // Activity callback (Java main thread), before the glue one
+static void AndroidInputQueueDestroyed(ANativeActivity *activity, AInputQueue *queue); // Activity callback (Java main thread), before the glue one
+static void ProcessInputThreadEvents(void);                                         // Register the events captured by the input thread (used by PollInputEvents())
+static void *AndroidInputThread(void *arg);                                         // Input thread: polls its looper
+static int AndroidInputQueueCallback(int fd, int events, void *data);               // Input thread: reads the input queue into the events ring
+#endif
+
+#if defined(SUPPORT_STARTUP_TIMELINE)
+static double GetProcessStartTime(void);                                            // Get process start time (monotonic clock seconds), 0 if unknown
+static void InitFrameTimestamps(void);                                              // Enable frame timestamps on the current surface (if supported)
+static void RequestFramePresentTime(void);                                          // Keep the id of the frame about to be swapped (used by EndDrawing())
+static int GetFramePresentTime(double *time);                                       // Get requested frame present time: 1 ready, 0 pending, -1 not available
+#endif
 
 //----------------------------------------------------------------------------------
 // Module Functions Declaration
@@ -275,6 +408,19 @@ void android_main(struct android_app *app)
     char arg0[] = "raylib";     // NOTE: argv[] are mutable
     platform.app = app;
 
+#if defined(SUPPORT_STARTUP_TIMELINE)
+    // NOTE: Cold start timeline goes from the process start (zygote fork), the time before android_main()
+    // is spent in the runtime and the activity launch
+    double processStart = GetProcessStartTime();
+
+    if (processStart > 0.0)
+    {
+        ResetTimeline(processStart, "process_start", false);
+        MarkTimelineEvent("android_main");
+    }
+    else ResetTimeline(GetTimelineClock(), "android_main", false);
+#endif
+
     // NOTE: Return from main is ignored
     (void)main(1, (char *[]) { arg0, NULL });
 
@@ -289,9 +435,12 @@ void android_main(struct android_app *app)
     while (!app->destroyRequested)
     {
         // Poll all events until we reach return value TIMEOUT, meaning no events left to process
+        // NOTE: Source cleared every time, a late wake up from the input thread comes with none
+        platform.source = NULL;
         while ((pollResult = ALooper_pollOnce(0, NULL, &pollEvents, (void **)&platform.source)) > ALOOPER_POLL_TIMEOUT)
         {
             if (platform.source != NULL) platform.source->process(app, platform.source);
+            platform.source = NULL;
         }
     }
 }
@@ -302,6 +451,17 @@ struct android_app *GetAndroidApp(void)
     return platform.app;
 }
 
+// Get the input thread looper, sensor event queues created on it are polled off the game thread
+// NOTE: Returns NULL without input thread, the calling thread looper must be used
+ALooper *GetAndroidInputLooper(void)
+{
+#if defined(SUPPORT_ANDROID_INPUT_THREAD)
+    return platform.inputLooper;
+#else
+    return NULL;
+#endif
+}
+
 //----------------------------------------------------------------------------------
 // Module Functions Definition: Window and Graphics Device
 //----------------------------------------------------------------------------------
@@ -548,7 +708,8 @@ void DisableCursor(void)
 // Swap back buffer with front buffer (screen drawing)
 void SwapScreenBuffer(void)
 {
-    eglSwapBuffers(platform.device, platform.surface);
+    // NOTE: A context lost while running (GPU reset, driver restart) shows up on swap, the frame is dropped
+    if ((eglSwapBuffers(platform.device, platform.surface) == EGL_FALSE) && (eglGetError() == EGL_CONTEXT_LOST)) RestoreGraphicsContext();
 }
 
 //----------------------------------------------------------------------------------
@@ -581,7 +742,11 @@ void OpenURL(const char *url)
     {
         JNIEnv *env = NULL;
         JavaVM *vm = platform.app->activity->vm;
-        (*vm)->AttachCurrentThread(vm, &env, NULL);
+
+        // NOTE: A thread attached for good (i.e. by raymob) must stay attached, only detached if attached here
+        bool attached = ((*vm)->GetEnv(vm, (void **)&env, JNI_VERSION_1_6) == JNI_EDETACHED);
+        if (attached) (*vm)->AttachCurrentThread(vm, &env, NULL);
+        else (*env)->PushLocalFrame(env, 16);
 
         jstring urlString = (*env)->NewStringUTF(env, url);
         jclass uriClass = (*env)->FindClass(env, "android/net/Uri");
@@ -599,7 +764,8 @@ void OpenURL(const char *url)
         jmethodID startActivity = (*env)->GetMethodID(env, activityClass, "startActivity", "(Landroid/content/Intent;)V");
         (*env)->CallVoidMethod(env, platform.app->activity->clazz, startActivity, intent);
 
-        (*vm)->DetachCurrentThread(vm);
+        if (attached) (*vm)->DetachCurrentThread(vm);
+        else (*env)->PopLocalFrame(env, NULL);
     }
 }
 
@@ -687,12 +853,37 @@ void PollInputEvents(void)
     int pollResult = 0;
     int pollEvents = 0;
 
+    // Event waiting: the first poll waits for an event (or the timeout) instead of the next frame starting right away
+    // NOTE: Never with a touch down, held touches send no events but gestures (hold, drag) need frames
+    int timeout = platform.appEnabled? 0 : -1;
+    bool idleWait = platform.appEnabled && CORE.Window.eventWaiting && (CORE.Input.Touch.pointCount == 0);
+    double idleStart = 0.0;
+
+    if (idleWait)
+    {
+#if defined(SUPPORT_ANDROID_INPUT_THREAD)
+        // NOTE: Flag raised before the ring check, events captured meanwhile either are seen here or wake the looper
+        __atomic_store_n(&platform.eventWaiting, true, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&platform.inputHead, __ATOMIC_SEQ_CST) != platform.inputTail) idleWait = false;
+#endif
+        if (idleWait) timeout = (CORE.Window.eventWaitingTimeout > 0.0)? (int)(CORE.Window.eventWaitingTimeout*1000.0 + 0.999) : -1;
+        idleStart = GetTime();
+    }
+
     // Poll Events (registered events) until we reach TIMEOUT which indicates there are no events left to poll
     // NOTE: Activity is paused if not enabled (platform.appEnabled)
-    while ((pollResult = ALooper_pollOnce(platform.appEnabled? 0 : -1, NULL, &pollEvents, (void**)&platform.source)) > ALOOPER_POLL_TIMEOUT)
+    platform.source = NULL;
+    while ((pollResult = ALooper_pollOnce(timeout, NULL, &pollEvents, (void**)&platform.source)) > ALOOPER_POLL_TIMEOUT)
     {
+        timeout = platform.appEnabled? 0 : -1;
+
         // Process this event
+        // NOTE: A wake up (input thread, memory trim) comes with no source
         if (platform.source != NULL) platform.source->process(platform.app, platform.source);
+        platform.source = NULL;
+
+        // NOTE: Trims also run while paused, the game thread only polls events then
+        ProcessMemoryTrim();
 
         // NOTE: Allow closing the window in case a configuration change happened.
         // The android_main function should be allowed to return to its caller in order for the
@@ -702,6 +893,24 @@ void PollInputEvents(void)
             CORE.Window.shouldClose = true;
         }
     }
+
+    if (idleWait)
+    {
+#if defined(SUPPORT_ANDROID_INPUT_THREAD)
+        __atomic_store_n(&platform.eventWaiting, false, __ATOMIC_RELAXED);
+#endif
+        // Idle time left out of the frame timing: the next frame is timed as usual, as if no wait happened
+        double idleTime = GetTime() - idleStart;
+        CORE.Time.previous += idleTime;
+#if defined(SUPPORT_FRAME_PROFILER)
+        profiler.phaseStart[PROFILER_PHASE_INPUT] += idleTime;
+#endif
+    }
+
+#if defined(SUPPORT_ANDROID_INPUT_THREAD)
+    // Events captured by the input thread since the last frame, registered in order
+    ProcessInputThreadEvents();
+#endif
 }
 
 //----------------------------------------------------------------------------------
@@ -757,6 +966,9 @@ int InitPlatform(void)
     // Initialize input events system
     //----------------------------------------------------------------------------
     platform.app->onInputEvent = AndroidInputCallback;
+#if defined(SUPPORT_ANDROID_INPUT_THREAD)
+    InitInputThread();
+#endif
     //----------------------------------------------------------------------------
 
     // Initialize storage system
@@ -766,6 +978,13 @@ int InitPlatform(void)
     CORE.Storage.basePath = platform.app->activity->internalDataPath;   // Define base path for storage
     //----------------------------------------------------------------------------
 
+#if defined(SUPPORT_ANDROID_FRAME_PACING)
+    // Initialize frame pacing
+    //----------------------------------------------------------------------------
+    InitFramePacing();
+    //----------------------------------------------------------------------------
+#endif
+
     TRACELOG(LOG_INFO, "PLATFORM: ANDROID: Initialized successfully");
 
     // Android ALooper_pollOnce() variables
@@ -792,6 +1011,13 @@ int InitPlatform(void)
 // Close platform
 void ClosePlatform(void)
 {
+#if defined(SUPPORT_ANDROID_FRAME_PACING)
+    CloseFramePacing();
+#endif
+#if defined(SUPPORT_ANDROID_INPUT_THREAD)
+    CloseInputThread();
+#endif
+
     // Close surface, context and display
     if (platform.device != EGL_NO_DISPLAY)
     {
@@ -820,6 +1046,416 @@ void ClosePlatform(void)
     }
 }
 
+#if defined(SUPPORT_ANDROID_FRAME_PACING)
+// Start the thread receiving choreographer vsync callbacks
+// NOTE: Callbacks run on the looper of the thread posting them, the main thread looper
+// can't be used, waiting on it would process input events in the middle of the frame
+static void InitFramePacing(void)
+{
+    pthread_condattr_t condAttr;
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    pthread_mutex_init(&platform.pacingMutex, NULL);
+    pthread_cond_init(&platform.pacingCond, &condAttr);
+    pthread_condattr_destroy(&condAttr);
+
+    platform.vsyncPeriod = 1.0/60.0;    // Until measured
+
+    if (pthread_create(&platform.pacingThread, NULL, AndroidPacingThread, NULL) != 0)
+    {
+        TRACELOG(LOG_WARNING, "ANDROID: Failed to start frame pacing thread, using timed waits");
+        return;
+    }
+    platform.pacingStarted = true;
+
+    // Wait for the thread looper and choreographer
+    pthread_mutex_lock(&platform.pacingMutex);
+    while (platform.pacingLooper == NULL) pthread_cond_wait(&platform.pacingCond, &platform.pacingMutex);
+    bool running = platform.pacingRunning;
+    pthread_mutex_unlock(&platform.pacingMutex);
+
+    if (running) TRACELOG(LOG_INFO, "ANDROID: Frame pacing from choreographer vsync callbacks");
+    else TRACELOG(LOG_WARNING, "ANDROID: Choreographer not available, using timed waits");
+}
+
+// Stop the vsync callbacks thread
+static void CloseFramePacing(void)
+{
+    if (!platform.pacingStarted) return;
+
+    pthread_mutex_lock(&platform.pacingMutex);
+    platform.pacingRunning = false;
+    pthread_mutex_unlock(&platform.pacingMutex);
+
+    ALooper_wake(platform.pacingLooper);
+    pthread_join(platform.pacingThread, NULL);
+    ALooper_release(platform.pacingLooper);
+
+    pthread_cond_destroy(&platform.pacingCond);
+    pthread_mutex_destroy(&platform.pacingMutex);
+    platform.pacingLooper = NULL;
+    platform.pacingStarted = false;
+}
+
+// Wait for the vsync the next frame starts on, instead of sleeping (and spinning) for the remaining frame time
+// NOTE: Returns false when vsync callbacks are not available, WaitTime() must be used instead
+static bool WaitFramePacing(double seconds)
+{
+    pthread_mutex_lock(&platform.pacingMutex);
+
+    if (!platform.pacingRunning)
+    {
+        pthread_mutex_unlock(&platform.pacingMutex);
+        return false;
+    }
+
+    // Vsyncs per frame, the frame rate never goes above the target (a 60 fps target runs at 45 fps on 90 Hz)
+    // NOTE: The period is measured, displays changing their refresh rate are followed after a few frames
+    int interval = (int)ceil(CORE.Time.target/platform.vsyncPeriod - 0.1);
+    if (interval < 1) interval = 1;
+
+    // Late frames (the vsync already passed) are released straight away and resync on it
+    unsigned long long release = platform.vsyncRelease + interval;
+
+    platform.vsyncRequest = platform.vsyncCount;
+    if (!platform.pacingPosted) ALooper_wake(platform.pacingLooper);   // Callbacks stopped while idle
+
+    // NOTE: The timeout covers callbacks stopping (window hidden), the frame is released after it
+    double timeout = seconds + platform.vsyncPeriod*interval;
+    struct timespec deadline = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += (time_t)timeout;
+    deadline.tv_nsec += (long)((timeout - (double)(time_t)timeout)*1000000000.0);
+    if (deadline.tv_nsec >= 1000000000L)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    while (platform.vsyncCount < release)
+    {
+        if (pthread_cond_timedwait(&platform.pacingCond, &platform.pacingMutex, &deadline) == ETIMEDOUT) break;
+    }
+
+    platform.vsyncRelease = platform.vsyncCount;
+
+    pthread_mutex_unlock(&platform.pacingMutex);
+
+    return true;
+}
+
+// Pacing thread: owns the choreographer and posts a frame callback per vsync while frames wait on them
+static void *AndroidPacingThread(void *arg)
+{
+    ALooper *looper = ALooper_prepare(0);
+    ALooper_acquire(looper);            // Kept valid for ALooper_wake() until CloseFramePacing()
+    AChoreographer *choreographer = AChoreographer_getInstance();
+
+    pthread_mutex_lock(&platform.pacingMutex);
+    platform.pacingLooper = looper;
+    platform.pacingRunning = (choreographer != NULL);
+    pthread_cond_broadcast(&platform.pacingCond);
+    pthread_mutex_unlock(&platform.pacingMutex);
+
+    while (choreographer != NULL)
+    {
+        pthread_mutex_lock(&platform.pacingMutex);
+        bool running = platform.pacingRunning;
+        if (running && !platform.pacingPosted && ((platform.vsyncCount - platform.vsyncRequest) < FRAME_PACING_IDLE_VSYNCS))
+        {
+            // NOTE: AChoreographer_postFrameCallback64() requires API level 29, the 32-bit frame time is handled on the callback
+            AChoreographer_postFrameCallback(choreographer, AndroidVsyncCallback, NULL);
+            platform.pacingPosted = true;
+        }
+        pthread_mutex_unlock(&platform.pacingMutex);
+
+        if (!running) break;
+
+        ALooper_pollOnce(-1, NULL, NULL, NULL);     // Runs the frame callback, or returns on ALooper_wake()
+    }
+
+    return NULL;
+}
+
+// Choreographer frame callback, counts vsyncs (missed ones included) and measures the vsync period
+static void AndroidVsyncCallback(long frameTimeNanos, void *data)
+{
+    pthread_mutex_lock(&platform.pacingMutex);
+
+    // NOTE: long is 32-bit on armeabi-v7a and the frame time wraps every 4.3 seconds,
+    // the unsigned difference between two callbacks is still right
+    double delta = (double)((unsigned long)frameTimeNanos - platform.vsyncTime)*1e-9;
+    int vsyncs = 1;
+
+    if ((platform.vsyncCount > 0) && (delta > 0.0) && (delta < FRAME_PACING_MAX_GAP))
+    {
+        vsyncs = (int)(delta/platform.vsyncPeriod + 0.5);
+        if (vsyncs < 1) vsyncs = 1;
+        platform.vsyncPeriod += (delta/vsyncs - platform.vsyncPeriod)*0.125;
+    }
+
+    platform.vsyncTime = (unsigned long)frameTimeNanos;
+    platform.vsyncCount += vsyncs;
+    platform.pacingPosted = false;
+
+    pthread_cond_broadcast(&platform.pacingCond);
+    pthread_mutex_unlock(&platform.pacingMutex);
+}
+#endif
+
+#if defined(SUPPORT_ANDROID_INPUT_THREAD)
+// Start the input thread: input events are read (and finished) as they arrive, even during a slow frame, and sensor
+// queues on its looper are drained as well; the game thread registers the captured events on PollInputEvents()
+static void InitInputThread(void)
+{
+    pthread_mutex_init(&platform.inputMutex, NULL);
+    pthread_cond_init(&platform.inputCond, NULL);
+    __atomic_store_n(&platform.inputRunning, true, __ATOMIC_RELAXED);
+
+    if (pthread_create(&platform.inputThread, NULL, AndroidInputThread, NULL) != 0)
+    {
+        TRACELOG(LOG_WARNING, "ANDROID: Failed to start input thread, input polled by the game thread");
+        __atomic_store_n(&platform.inputRunning, false, __ATOMIC_RELAXED);
+        return;
+    }
+
+    // Wait for the thread looper
+    pthread_mutex_lock(&platform.inputMutex);
+    while (platform.inputLooper == NULL) pthread_cond_wait(&platform.inputCond, &platform.inputMutex);
+    pthread_mutex_unlock(&platform.inputMutex);
+
+    // NOTE: The queue must leave the input thread before the glue lets the activity destroy it, the glue only
+    // detaches it (from whatever looper) and APP_CMD_INPUT_CHANGED comes once the queue may be freed already
+    platform.glueInputQueueCreated = platform.app->activity->callbacks->onInputQueueCreated;
+    platform.glueInputQueueDestroyed = platform.app->activity->callbacks->onInputQueueDestroyed;
+    platform.app->activity->callbacks->onInputQueueCreated = AndroidInputQueueCreated;
+    platform.app->activity->callbacks->onInputQueueDestroyed = AndroidInputQueueDestroyed;
+
+    // NOTE: A queue created before is moved now, later ones on APP_CMD_INPUT_CHANGED
+    MoveInputQueue(platform.app->inputQueue);
+
+    TRACELOG(LOG_INFO, "ANDROID: Input events polled by the input thread");
+}
+
+// Stop the input thread, the input queue goes back to the main looper (the glue polls it again)
+static void CloseInputThread(void)
+{
+    if (platform.inputLooper == NULL) return;
+
+    platform.app->activity->callbacks->onInputQueueCreated = platform.glueInputQueueCreated;
+    platform.app->activity->callbacks->onInputQueueDestroyed = platform.glueInputQueueDestroyed;
+
+    pthread_mutex_lock(&platform.inputMutex);
+    if (platform.inputQueue != NULL)
+    {
+        AInputQueue_detachLooper(platform.inputQueue);
+        AInputQueue_attachLooper(platform.inputQueue, platform.app->looper, LOOPER_ID_INPUT, NULL, &platform.app->inputPollSource);
+        platform.inputQueue = NULL;
+    }
+    pthread_mutex_unlock(&platform.inputMutex);
+
+    __atomic_store_n(&platform.inputRunning, false, __ATOMIC_RELEASE);
+    ALooper_wake(platform.inputLooper);
+    pthread_join(platform.inputThread, NULL);
+    ALooper_release(platform.inputLooper);
+
+    pthread_cond_destroy(&platform.inputCond);
+    pthread_mutex_destroy(&platform.inputMutex);
+    platform.inputLooper = NULL;
+}
+
+// Attach the app input queue to the input thread looper, instead of the main looper the glue attached it to
+// NOTE: The previous queue already left the input thread (DetachInputQueue()), before the glue gave it back
+static void MoveInputQueue(AInputQueue *queue)
+{
+    if (platform.inputLooper == NULL) return;
+
+    pthread_mutex_lock(&platform.inputMutex);
+    if (queue != NULL)
+    {
+        AInputQueue_detachLooper(queue);
+        AInputQueue_attachLooper(queue, platform.inputLooper, LOOPER_ID_INPUT, AndroidInputQueueCallback, NULL);
+    }
+    platform.inputQueue = queue;
+    pthread_mutex_unlock(&platform.inputMutex);
+}
+
+// Take the input queue away from the input thread, the mutex waits for a callback reading it to be done
+static void DetachInputQueue(void)
+{
+    pthread_mutex_lock(&platform.inputMutex);
+    if (platform.inputQueue != NULL)
+    {
+        AInputQueue_detachLooper(platform.inputQueue);
+        platform.inputQueue = NULL;
+    }
+    pthread_mutex_unlock(&platform.inputMutex);
+}
+
+// A new queue replaces any previous one, that one goes away once the glue callback returns
+static void AndroidInputQueueCreated(ANativeActivity *activity, AInputQueue *queue)
+{
+    DetachInputQueue();
+    platform.glueInputQueueCreated(activity, queue);
+}
+
+// The queue is freed once the glue callback returns, the input thread must be done with it before
+static void AndroidInputQueueDestroyed(ANativeActivity *activity, AInputQueue *queue)
+{
+    DetachInputQueue();
+    platform.glueInputQueueDestroyed(activity, queue);
+}
+
+// Register the events captured by the input thread, oldest first
+static void ProcessInputThreadEvents(void)
+{
+    if (platform.inputLooper == NULL) return;
+
+    unsigned int tail = platform.inputTail;
+    unsigned int head = __atomic_load_n(&platform.inputHead, __ATOMIC_ACQUIRE);
+
+    for (; tail != head; tail++) AndroidProcessInputEvent(&platform.inputEvents[tail & (ANDROID_INPUT_QUEUE_SIZE - 1)]);
+
+    __atomic_store_n(&platform.inputTail, tail, __ATOMIC_RELEASE);
+
+    unsigned int dropped = __atomic_exchange_n(&platform.inputDropped, 0, __ATOMIC_RELAXED);
+    if (dropped > 0) TRACELOG(LOG_WARNING, "ANDROID: Input events queue full, %u events dropped", dropped);
+}
+
+// Input thread: polls its looper, the input queue (and sensor queues) callbacks run from it
+static void *AndroidInputThread(void *arg)
+{
+    ALooper *looper = ALooper_prepare(ALOOPER_PREPARE_ALLOW_NON_CALLBACKS);
+    ALooper_acquire(looper);            // Kept valid for ALooper_wake() until CloseInputThread()
+
+    pthread_mutex_lock(&platform.inputMutex);
+    platform.inputLooper = looper;
+    pthread_cond_broadcast(&platform.inputCond);
+    pthread_mutex_unlock(&platform.inputMutex);
+
+    while (__atomic_load_n(&platform.inputRunning, __ATOMIC_ACQUIRE)) ALooper_pollOnce(-1, NULL, NULL, NULL);
+
+    return NULL;
+}
+
+// Input thread: reads every input event waiting, captures it into the events ring and finishes it
+static int AndroidInputQueueCallback(int fd, int events, void *data)
+{
+    pthread_mutex_lock(&platform.inputMutex);
+
+    AInputEvent *event = NULL;
+    bool captured = false;
+    while ((platform.inputQueue != NULL) && (AInputQueue_getEvent(platform.inputQueue, &event) >= 0))
+    {
+        // Events for the soft keyboard (IME) first
+        if (AInputQueue_preDispatchEvent(platform.inputQueue, event)) continue;
+
+        unsigned int head = platform.inputHead;
+        bool full = ((head - __atomic_load_n(&platform.inputTail, __ATOMIC_ACQUIRE)) >= ANDROID_INPUT_QUEUE_SIZE);
+
+        // NOTE: Events not fitting are still finished (handled or not), only the game doesn't see them
+        AndroidInputEvent dropped = { 0 };
+        AndroidInputEvent *input = full? &dropped : &platform.inputEvents[head & (ANDROID_INPUT_QUEUE_SIZE - 1)];
+        memset(input, 0, sizeof(AndroidInputEvent));
+
+        int32_t handled = AndroidCaptureInputEvent(event, input);
+        AInputQueue_finishEvent(platform.inputQueue, event, handled);
+
+        if (full) __atomic_fetch_add(&platform.inputDropped, 1, __ATOMIC_RELAXED);
+        else
+        {
+            __atomic_store_n(&platform.inputHead, head + 1, __ATOMIC_SEQ_CST);
+            captured = true;
+        }
+    }
+
+    pthread_mutex_unlock(&platform.inputMutex);
+
+    // An idle game thread waits in the main looper (event waiting), new input starts its next frame right away
+    if (captured && __atomic_load_n(&platform.eventWaiting, __ATOMIC_SEQ_CST)) ALooper_wake(platform.app->looper);
+
+    return 1;   // Keep receiving callbacks
+}
+#endif
+
+#if defined(SUPPORT_STARTUP_TIMELINE)
+// Get process start time, on the monotonic clock
+// NOTE: /proc/self/stat starttime is in clock ticks since boot (suspend included), converted through CLOCK_BOOTTIME
+static double GetProcessStartTime(void)
+{
+    char stat[512] = { 0 };
+    FILE *file = fopen("/proc/self/stat", "r");
+    if (file == NULL) return 0.0;
+
+    size_t length = fread(stat, 1, sizeof(stat) - 1, file);
+    fclose(file);
+    stat[length] = '\0';
+
+    // Fields after the command name (that can contain spaces), starttime is field 22
+    const char *fields = strrchr(stat, ')');
+    unsigned long long startTicks = 0;
+
+    if ((fields == NULL) || (sscanf(fields + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %*u %*u %*d %*d %*d %*d %*d %*d %llu", &startTicks) != 1)) return 0.0;
+
+    long ticksPerSecond = sysconf(_SC_CLK_TCK);
+    if (ticksPerSecond <= 0) return 0.0;
+
+    struct timespec boot = { 0 };
+    clock_gettime(CLOCK_BOOTTIME, &boot);
+
+    double now = GetTimelineClock();
+    double elapsed = (double)boot.tv_sec + (double)boot.tv_nsec*1e-9 - (double)startTicks/(double)ticksPerSecond;
+
+    // NOTE: Processes forked ahead of time (USAP pool) started long before the launch, unknown then
+    if ((elapsed < 0.0) || (elapsed > 30.0)) return 0.0;
+
+    return now - elapsed;
+}
+
+// Enable frame timestamps on the current surface, the first frame present time is read from them
+static void InitFrameTimestamps(void)
+{
+    platform.frameTimestamps = false;
+    platform.presentRequested = false;
+
+    const char *extensions = eglQueryString(platform.device, EGL_EXTENSIONS);
+    if ((extensions == NULL) || (strstr(extensions, "EGL_ANDROID_get_frame_timestamps") == NULL)) return;
+
+    platform.eglGetNextFrameId = (PFNEGLGETNEXTFRAMEIDANDROIDPROC)eglGetProcAddress("eglGetNextFrameIdANDROID");
+    platform.eglGetFrameTimestamps = (PFNEGLGETFRAMETIMESTAMPSANDROIDPROC)eglGetProcAddress("eglGetFrameTimestampsANDROID");
+
+    if ((platform.eglGetNextFrameId != NULL) && (platform.eglGetFrameTimestamps != NULL))
+    {
+        platform.frameTimestamps = (eglSurfaceAttrib(platform.device, platform.surface, EGL_TIMESTAMPS_ANDROID, EGL_TRUE) == EGL_TRUE);
+    }
+}
+
+// Keep the id of the frame about to be swapped
+static void RequestFramePresentTime(void)
+{
+    platform.presentRequested = platform.frameTimestamps &&
+        (platform.eglGetNextFrameId(platform.device, platform.surface, &platform.presentFrameId) == EGL_TRUE);
+}
+
+// Get requested frame present time (monotonic clock seconds)
+static int GetFramePresentTime(double *time)
+{
+    if (!platform.presentRequested) return -1;
+
+    const EGLint names[1] = { EGL_DISPLAY_PRESENT_TIME_ANDROID };
+    int64_t value = 0;
+
+    // NOTE: Frames older than the timestamps history fail, as the ones never presented
+    if (platform.eglGetFrameTimestamps(platform.device, platform.surface, platform.presentFrameId, 1, names, &value) == EGL_FALSE) return -1;
+    if (value == EGL_TIMESTAMP_PENDING_ANDROID) return 0;
+    if (value <= 0) return -1;
+
+    *time = (double)value*1e-9;
+
+    return 1;
+}
+#endif
+
 // Initialize display device and framebuffer
 // NOTE: width and height represent the screen (framebuffer) desired size, not actual display size
 // If width or height are 0, default display size will be used for framebuffer size
@@ -920,6 +1556,9 @@ static int InitGraphicsDevice(void)
     }
     else
     {
+#if defined(SUPPORT_STARTUP_TIMELINE)
+        InitFrameTimestamps();
+#endif
         CORE.Window.render.width = CORE.Window.screen.width;
         CORE.Window.render.height = CORE.Window.screen.height;
         CORE.Window.currentFbo.width = CORE.Window.render.width;
@@ -943,6 +1582,42 @@ static int InitGraphicsDevice(void)
     return 0;
 }
 
+// Replace a lost EGL context on the current surface, then load rlgl, default font and application resources again
+static bool RestoreGraphicsContext(void)
+{
+    const EGLint contextAttribs[] = { EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE };       // Same as InitGraphicsDevice()
+
+    TRACELOG(LOG_WARNING, "DISPLAY: EGL context lost, creating a new one");
+#if defined(SUPPORT_STARTUP_TIMELINE)
+    BeginTimelineSection("context_restore");
+#endif
+
+    eglMakeCurrent(platform.device, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(platform.device, platform.context);
+
+    platform.context = eglCreateContext(platform.device, platform.config, EGL_NO_CONTEXT, contextAttribs);
+    bool restored = (platform.context != EGL_NO_CONTEXT) &&
+                    (eglMakeCurrent(platform.device, platform.surface, platform.surface, platform.context) == EGL_TRUE);
+
+    if (restored)
+    {
+        rlLoadExtensions(eglGetProcAddress);
+        RestoreGraphicsState();
+    }
+    else
+    {
+        // NOTE: Nothing can be drawn anymore, better to close than to show a black screen
+        TRACELOG(LOG_WARNING, "DISPLAY: Failed to create a new EGL context, closing");
+        CORE.Window.shouldClose = true;
+    }
+
+#if defined(SUPPORT_STARTUP_TIMELINE)
+    EndTimelineSection("context_restore");
+#endif
+
+    return restored;
+}
+
 // ANDROID: Process activity lifecycle commands
 static void AndroidCommandCallback(struct android_app *app, int32_t cmd)
 {
@@ -951,6 +1626,10 @@ static void AndroidCommandCallback(struct android_app *app, int32_t cmd)
         case APP_CMD_START:
         {
             //rendering = true;
+#if defined(SUPPORT_STARTUP_TIMELINE)
+            // NOTE: Back from the background, a new timeline goes to the next presented frame
+            if (timeline.complete) ResetTimeline(GetTimelineClock(), "resume", true);
+#endif
         } break;
         case APP_CMD_RESUME: break;
         case APP_CMD_INIT_WINDOW:
@@ -972,10 +1651,17 @@ static void AndroidCommandCallback(struct android_app *app, int32_t cmd)
                         displayFormat);
 
                     // Recreate display surface and re-attach OpenGL context
+                    // NOTE: The context is kept while in background, so nothing has to be loaded again, unless
+                    // the system dropped it meanwhile: a new one is created and GPU resources are restored
                     platform.surface = eglCreateWindowSurface(platform.device, platform.config, app->window, NULL);
-                    eglMakeCurrent(platform.device, platform.surface, platform.surface, platform.context);
+                    if ((eglMakeCurrent(platform.device, platform.surface, platform.surface, platform.context) == EGL_FALSE) &&
+                        (eglGetError() == EGL_CONTEXT_LOST)) RestoreGraphicsContext();
 
                     platform.contextRebindRequired = false;
+#if defined(SUPPORT_STARTUP_TIMELINE)
+                    InitFrameTimestamps();
+                    MarkTimelineEvent("context_rebind");
+#endif
                 }
                 else
                 {
@@ -983,11 +1669,23 @@ static void AndroidCommandCallback(struct android_app *app, int32_t cmd)
                     CORE.Window.display.height = ANativeWindow_getHeight(platform.app->window);
 
                     // Initialize graphics device (display device and OpenGL context)
+#if defined(SUPPORT_STARTUP_TIMELINE)
+                    BeginTimelineSection("InitGraphicsDevice");
+#endif
                     InitGraphicsDevice();
+#if defined(SUPPORT_STARTUP_TIMELINE)
+                    EndTimelineSection("InitGraphicsDevice");
+#endif
 
                     // Initialize OpenGL context (states and resources)
                     // NOTE: CORE.Window.currentFbo.width and CORE.Window.currentFbo.height not used, just stored as globals in rlgl
+#if defined(SUPPORT_STARTUP_TIMELINE)
+                    BeginTimelineSection("rlglInit");
+#endif
                     rlglInit(CORE.Window.currentFbo.width, CORE.Window.currentFbo.height);
+#if defined(SUPPORT_STARTUP_TIMELINE)
+                    EndTimelineSection("rlglInit");
+#endif
                     isGpuReady = true;
 
                     // Setup default viewport
@@ -1028,20 +1726,8 @@ static void AndroidCommandCallback(struct android_app *app, int32_t cmd)
                     // Initialize random seed
                     SetRandomSeed((unsigned int)time(NULL));
 
-                    // TODO: GPU assets reload in case of lost focus (lost context)
-                    // NOTE: This problem has been solved just unbinding and rebinding context from display
-                    /*
-                    if (assetsReloadRequired)
-                    {
-                        for (int i = 0; i < assetCount; i++)
-                        {
-                            // TODO: Unload old asset if required
-
-                            // Load texture again to pointed texture
-                            (*textureAsset + i) = LoadTexture(assetPath[i]);
-                        }
-                    }
-                    */
+                    // NOTE: GPU assets reload in case of lost context is done by RestoreGraphicsContext(),
+                    // application resources through SetContextRestoredCallback()
                 }
             }
         } break;
@@ -1063,7 +1749,7 @@ static void AndroidCommandCallback(struct android_app *app, int32_t cmd)
             // Detach OpenGL context and destroy display surface
             // NOTE 1: This case is used when the user exits the app without closing it. We detach the context to ensure everything is recoverable upon resuming.
             // NOTE 2: Detaching context before destroying display surface avoids losing our resources (textures, shaders, VBOs...)
-            // NOTE 3: In some cases (too many context loaded), OS could unload context automatically... :(
+            // NOTE 3: In some cases (too many context loaded), OS could unload context automatically, it is replaced on APP_CMD_INIT_WINDOW
             if (platform.device != EGL_NO_DISPLAY)
             {
                 eglMakeCurrent(platform.device, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
@@ -1080,6 +1766,19 @@ static void AndroidCommandCallback(struct android_app *app, int32_t cmd)
             // this means that the user has already called 'CloseWindow()'
 
         } break;
+        case APP_CMD_INPUT_CHANGED:
+        {
+#if defined(SUPPORT_ANDROID_INPUT_THREAD)
+            // NOTE: The glue attached the new queue to the main looper, the previous one left the input thread in
+            // AndroidInputQueueDestroyed()
+            MoveInputQueue(app->inputQueue);
+#endif
+        } break;
+        case APP_CMD_LOW_MEMORY:
+        {
+            // NOTE: onLowMemory(), the system is about to kill background processes
+            RequestMemoryTrim(80);  // TRIM_MEMORY_COMPLETE
+        } break;
         case APP_CMD_SAVE_STATE: break;
         case APP_CMD_STOP: break;
         case APP_CMD_DESTROY: break;
@@ -1122,14 +1821,108 @@ static GamepadButton AndroidTranslateGamepadButton(int button)
 }
 
 // ANDROID: Get input events
+// NOTE: With the input thread, events come from its queue and this callback (main looper) is not used
 static int32_t AndroidInputCallback(struct android_app *app, AInputEvent *event)
+{
+    AndroidInputEvent input = { 0 };
+    int32_t handled = AndroidCaptureInputEvent(event, &input);
+
+    AndroidProcessInputEvent(&input);
+
+    return handled;
+}
+
+// ANDROID: Copy the input event data raylib uses, returns if the event is handled (not passed on to the OS)
+// NOTE: Only reads the event, safe on the input thread
+static int32_t AndroidCaptureInputEvent(const AInputEvent *event, AndroidInputEvent *input)
 {
     // If additional inputs are required check:
     // https://developer.android.com/ndk/reference/group/input
     // https://developer.android.com/training/game-controllers/controller-input
 
-    int type = AInputEvent_getType(event);
-    int source = AInputEvent_getSource(event);
+    input->type = AInputEvent_getType(event);
+    input->source = AInputEvent_getSource(event);
+
+    bool gamepad = (((input->source & AINPUT_SOURCE_JOYSTICK) == AINPUT_SOURCE_JOYSTICK) ||
+                    ((input->source & AINPUT_SOURCE_GAMEPAD) == AINPUT_SOURCE_GAMEPAD));
+
+    if (input->type == AINPUT_EVENT_TYPE_KEY)
+    {
+        input->action = AKeyEvent_getAction(event);
+        input->keycode = AKeyEvent_getKeyCode(event);
+        input->time = AKeyEvent_getEventTime(event);
+        //int32_t AKeyEvent_getMetaState(event);
+
+        if (gamepad) return 1;  // Handled gamepad button
+
+        if (input->keycode == AKEYCODE_POWER)
+        {
+            // Let the OS handle input to avoid app stuck. Behaviour: CMD_PAUSE -> CMD_SAVE_STATE -> CMD_STOP -> CMD_CONFIG_CHANGED -> CMD_LOST_FOCUS
+            // Resuming Behaviour: CMD_START -> CMD_RESUME -> CMD_CONFIG_CHANGED -> CMD_CONFIG_CHANGED -> CMD_GAINED_FOCUS
+            // It seems like locking mobile, screen size (CMD_CONFIG_CHANGED) is affected.
+            // NOTE: AndroidManifest.xml must have <activity android:configChanges="orientation|keyboardHidden|screenSize" >
+            // Before that change, activity was calling CMD_TERM_WINDOW and CMD_DESTROY when locking mobile, so that was not a normal behaviour
+            return 0;
+        }
+        else if ((input->keycode == AKEYCODE_BACK) || (input->keycode == AKEYCODE_MENU))
+        {
+            // Eat BACK_BUTTON and AKEYCODE_MENU, just do nothing... and don't let to be handled by OS!
+            return 1;
+        }
+        else if ((input->keycode == AKEYCODE_VOLUME_UP) || (input->keycode == AKEYCODE_VOLUME_DOWN))
+        {
+            // Set default OS behaviour
+            return 0;
+        }
+
+        return 0;
+    }
+
+    input->action = AMotionEvent_getAction(event);
+    input->time = AMotionEvent_getEventTime(event);
+    input->pointerCount = (int)AMotionEvent_getPointerCount(event);
+
+    if (gamepad)
+    {
+        static const int32_t axes[ANDROID_INPUT_AXIS_COUNT] = {
+            AMOTION_EVENT_AXIS_X, AMOTION_EVENT_AXIS_Y, AMOTION_EVENT_AXIS_Z, AMOTION_EVENT_AXIS_RZ,
+            AMOTION_EVENT_AXIS_BRAKE, AMOTION_EVENT_AXIS_GAS, AMOTION_EVENT_AXIS_HAT_X, AMOTION_EVENT_AXIS_HAT_Y
+        };
+
+        for (int i = 0; i < ANDROID_INPUT_AXIS_COUNT; i++) input->axis[i] = AMotionEvent_getAxisValue(event, axes[i], 0);
+
+        return 1;   // Handled gamepad axis motion
+    }
+
+    int pointerCount = (input->pointerCount < MAX_TOUCH_POINTS)? input->pointerCount : MAX_TOUCH_POINTS;
+
+    for (int i = 0; i < pointerCount; i++)
+    {
+        input->pointerId[i] = AMotionEvent_getPointerId(event, i);
+        input->position[i] = (Vector2){ AMotionEvent_getX(event, i), AMotionEvent_getY(event, i) };
+    }
+
+    // Samples batched since the previous event, only the newest ones when there are more
+    int historySize = (int)AMotionEvent_getHistorySize(event);
+    int historyStart = (historySize > ANDROID_INPUT_HISTORY)? historySize - ANDROID_INPUT_HISTORY : 0;
+
+    for (int h = historyStart; h < historySize; h++)
+    {
+        AndroidInputSamples *samples = &input->history[input->historyCount++];
+        samples->time = AMotionEvent_getHistoricalEventTime(event, h);
+
+        for (int i = 0; i < pointerCount; i++)
+            samples->position[i] = (Vector2){ AMotionEvent_getHistoricalX(event, i, h), AMotionEvent_getHistoricalY(event, i, h) };
+    }
+
+    return 0;
+}
+
+// ANDROID: Register an input event into the input state (game thread)
+static void AndroidProcessInputEvent(const AndroidInputEvent *input)
+{
+    int type = input->type;
+    int source = input->source;
 
     if (type == AINPUT_EVENT_TYPE_MOTION)
     {
@@ -1139,22 +1932,16 @@ static int32_t AndroidInputCallback(struct android_app *app, AInputEvent *event)
             // For now we'll assume a single gamepad which we "detect" on its input event
             CORE.Input.Gamepad.ready[0] = true;
 
-            CORE.Input.Gamepad.axisState[0][GAMEPAD_AXIS_LEFT_X] = AMotionEvent_getAxisValue(
-                    event, AMOTION_EVENT_AXIS_X, 0);
-            CORE.Input.Gamepad.axisState[0][GAMEPAD_AXIS_LEFT_Y] = AMotionEvent_getAxisValue(
-                    event, AMOTION_EVENT_AXIS_Y, 0);
-            CORE.Input.Gamepad.axisState[0][GAMEPAD_AXIS_RIGHT_X] = AMotionEvent_getAxisValue(
-                    event, AMOTION_EVENT_AXIS_Z, 0);
-            CORE.Input.Gamepad.axisState[0][GAMEPAD_AXIS_RIGHT_Y] = AMotionEvent_getAxisValue(
-                    event, AMOTION_EVENT_AXIS_RZ, 0);
-            CORE.Input.Gamepad.axisState[0][GAMEPAD_AXIS_LEFT_TRIGGER] = AMotionEvent_getAxisValue(
-                    event, AMOTION_EVENT_AXIS_BRAKE, 0)*2.0f - 1.0f;
-            CORE.Input.Gamepad.axisState[0][GAMEPAD_AXIS_RIGHT_TRIGGER] = AMotionEvent_getAxisValue(
-                    event, AMOTION_EVENT_AXIS_GAS, 0)*2.0f - 1.0f;
+            CORE.Input.Gamepad.axisState[0][GAMEPAD_AXIS_LEFT_X] = input->axis[0];
+            CORE.Input.Gamepad.axisState[0][GAMEPAD_AXIS_LEFT_Y] = input->axis[1];
+            CORE.Input.Gamepad.axisState[0][GAMEPAD_AXIS_RIGHT_X] = input->axis[2];
+            CORE.Input.Gamepad.axisState[0][GAMEPAD_AXIS_RIGHT_Y] = input->axis[3];
+            CORE.Input.Gamepad.axisState[0][GAMEPAD_AXIS_LEFT_TRIGGER] = input->axis[4]*2.0f - 1.0f;
+            CORE.Input.Gamepad.axisState[0][GAMEPAD_AXIS_RIGHT_TRIGGER] = input->axis[5]*2.0f - 1.0f;
 
             // dpad is reported as an axis on android
-            float dpadX = AMotionEvent_getAxisValue(event, AMOTION_EVENT_AXIS_HAT_X, 0);
-            float dpadY = AMotionEvent_getAxisValue(event, AMOTION_EVENT_AXIS_HAT_Y, 0);
+            float dpadX = input->axis[6];
+            float dpadY = input->axis[7];
 
             if (dpadX == 1.0f)
             {
@@ -1188,13 +1975,12 @@ static int32_t AndroidInputCallback(struct android_app *app, AInputEvent *event)
                 CORE.Input.Gamepad.currentButtonState[0][GAMEPAD_BUTTON_LEFT_FACE_UP] = 0;
             }
 
-            return 1; // Handled gamepad axis motion
+            return; // Handled gamepad axis motion
         }
     }
     else if (type == AINPUT_EVENT_TYPE_KEY)
     {
-        int32_t keycode = AKeyEvent_getKeyCode(event);
-        //int32_t AKeyEvent_getMetaState(event);
+        int32_t keycode = input->keycode;
 
         // Handle gamepad button presses and releases
         if (((source & AINPUT_SOURCE_JOYSTICK) == AINPUT_SOURCE_JOYSTICK) ||
@@ -1205,15 +1991,15 @@ static int32_t AndroidInputCallback(struct android_app *app, AInputEvent *event)
 
             GamepadButton button = AndroidTranslateGamepadButton(keycode);
 
-            if (button == GAMEPAD_BUTTON_UNKNOWN) return 1;
+            if (button == GAMEPAD_BUTTON_UNKNOWN) return;
 
-            if (AKeyEvent_getAction(event) == AKEY_EVENT_ACTION_DOWN)
+            if (input->action == AKEY_EVENT_ACTION_DOWN)
             {
                 CORE.Input.Gamepad.currentButtonState[0][button] = 1;
             }
             else CORE.Input.Gamepad.currentButtonState[0][button] = 0;  // Key up
 
-            return 1; // Handled gamepad button
+            return; // Handled gamepad button
         }
 
         KeyboardKey key = (keycode > 0 && keycode < KEYCODE_MAP_SIZE)? mapKeycode[keycode] : KEY_NULL;
@@ -1221,59 +2007,43 @@ static int32_t AndroidInputCallback(struct android_app *app, AInputEvent *event)
         {
             // Save current key and its state
             // NOTE: Android key action is 0 for down and 1 for up
-            if (AKeyEvent_getAction(event) == AKEY_EVENT_ACTION_DOWN)
+            if (input->action == AKEY_EVENT_ACTION_DOWN)
             {
                 CORE.Input.Keyboard.currentKeyState[key] = 1;   // Key down
 
-                CORE.Input.Keyboard.keyPressedQueue[CORE.Input.Keyboard.keyPressedQueueCount] = key;
-                CORE.Input.Keyboard.keyPressedQueueCount++;
+                // NOTE: Events of a slow frame (input thread) may not fit in the queue
+                if (CORE.Input.Keyboard.keyPressedQueueCount < MAX_KEY_PRESSED_QUEUE)
+                {
+                    CORE.Input.Keyboard.keyPressedQueue[CORE.Input.Keyboard.keyPressedQueueCount] = key;
+                    CORE.Input.Keyboard.keyPressedQueueCount++;
+                }
             }
-            else if (AKeyEvent_getAction(event) == AKEY_EVENT_ACTION_MULTIPLE) CORE.Input.Keyboard.keyRepeatInFrame[key] = 1;
+            else if (input->action == AKEY_EVENT_ACTION_MULTIPLE) CORE.Input.Keyboard.keyRepeatInFrame[key] = 1;
             else CORE.Input.Keyboard.currentKeyState[key] = 0;  // Key up
         }
 
-        if (keycode == AKEYCODE_POWER)
-        {
-            // Let the OS handle input to avoid app stuck. Behaviour: CMD_PAUSE -> CMD_SAVE_STATE -> CMD_STOP -> CMD_CONFIG_CHANGED -> CMD_LOST_FOCUS
-            // Resuming Behaviour: CMD_START -> CMD_RESUME -> CMD_CONFIG_CHANGED -> CMD_CONFIG_CHANGED -> CMD_GAINED_FOCUS
-            // It seems like locking mobile, screen size (CMD_CONFIG_CHANGED) is affected.
-            // NOTE: AndroidManifest.xml must have <activity android:configChanges="orientation|keyboardHidden|screenSize" >
-            // Before that change, activity was calling CMD_TERM_WINDOW and CMD_DESTROY when locking mobile, so that was not a normal behaviour
-            return 0;
-        }
-        else if ((keycode == AKEYCODE_BACK) || (keycode == AKEYCODE_MENU))
-        {
-            // Eat BACK_BUTTON and AKEYCODE_MENU, just do nothing... and don't let to be handled by OS!
-            return 1;
-        }
-        else if ((keycode == AKEYCODE_VOLUME_UP) || (keycode == AKEYCODE_VOLUME_DOWN))
-        {
-            // Set default OS behaviour
-            return 0;
-        }
-
-        return 0;
+        return;
     }
 
     // Register touch points count
-    CORE.Input.Touch.pointCount = AMotionEvent_getPointerCount(event);
+    CORE.Input.Touch.pointCount = input->pointerCount;
+
+    // Normalize touch positions for CORE.Window.screen.width and CORE.Window.screen.height
+    float widthRatio = (float)(CORE.Window.screen.width + CORE.Window.renderOffset.x)/(float)CORE.Window.display.width;
+    float heightRatio = (float)(CORE.Window.screen.height + CORE.Window.renderOffset.y)/(float)CORE.Window.display.height;
+    Vector2 offset = { (float)CORE.Window.renderOffset.x/2, (float)CORE.Window.renderOffset.y/2 };
 
     for (int i = 0; (i < CORE.Input.Touch.pointCount) && (i < MAX_TOUCH_POINTS); i++)
     {
         // Register touch points id
-        CORE.Input.Touch.pointId[i] = AMotionEvent_getPointerId(event, i);
+        CORE.Input.Touch.pointId[i] = input->pointerId[i];
 
         // Register touch points position
-        CORE.Input.Touch.position[i] = (Vector2){ AMotionEvent_getX(event, i), AMotionEvent_getY(event, i) };
-
-        // Normalize CORE.Input.Touch.position[i] for CORE.Window.screen.width and CORE.Window.screen.height
-        float widthRatio = (float)(CORE.Window.screen.width + CORE.Window.renderOffset.x)/(float)CORE.Window.display.width;
-        float heightRatio = (float)(CORE.Window.screen.height + CORE.Window.renderOffset.y)/(float)CORE.Window.display.height;
-        CORE.Input.Touch.position[i].x = CORE.Input.Touch.position[i].x*widthRatio - (float)CORE.Window.renderOffset.x/2;
-        CORE.Input.Touch.position[i].y = CORE.Input.Touch.position[i].y*heightRatio - (float)CORE.Window.renderOffset.y/2;
+        CORE.Input.Touch.position[i].x = input->position[i].x*widthRatio - offset.x;
+        CORE.Input.Touch.position[i].y = input->position[i].y*heightRatio - offset.y;
     }
 
-    int32_t action = AMotionEvent_getAction(event);
+    int32_t action = input->action;
     unsigned int flags = action & AMOTION_EVENT_ACTION_MASK;
 
 #if defined(SUPPORT_GESTURES_SYSTEM)
@@ -1301,6 +2071,28 @@ static int32_t AndroidInputCallback(struct android_app *app, AInputEvent *event)
 
     int32_t pointerIndex = (action & AMOTION_EVENT_ACTION_POINTER_INDEX_MASK) >> AMOTION_EVENT_ACTION_POINTER_INDEX_SHIFT;
 
+#if defined(SUPPORT_TOUCH_HISTORY)
+    // Every sample of the event goes to the touch history: the samples batched since the previous
+    // event (historical, several per frame on fast touch screens), then the event own sample
+    for (int i = 0; (i < input->pointerCount) && (i < MAX_TOUCH_POINTS); i++)
+    {
+        int id = input->pointerId[i];
+
+        for (int h = 0; h < input->historyCount; h++)
+        {
+            Vector2 position = { input->history[h].position[i].x*widthRatio - offset.x, input->history[h].position[i].y*heightRatio - offset.y };
+            AddTouchSample(id, position, (double)(input->history[h].time - (int64_t)CORE.Time.base)*1e-9, TOUCH_SAMPLE_MOVE);
+        }
+
+        int sampleAction = TOUCH_SAMPLE_MOVE;
+        if ((flags == AMOTION_EVENT_ACTION_DOWN) || ((flags == AMOTION_EVENT_ACTION_POINTER_DOWN) && (i == pointerIndex))) sampleAction = TOUCH_SAMPLE_DOWN;
+        else if ((flags == AMOTION_EVENT_ACTION_UP) || (flags == AMOTION_EVENT_ACTION_CANCEL) ||
+                 ((flags == AMOTION_EVENT_ACTION_POINTER_UP) && (i == pointerIndex))) sampleAction = TOUCH_SAMPLE_UP;
+
+        AddTouchSample(id, CORE.Input.Touch.position[i], (double)(input->time - (int64_t)CORE.Time.base)*1e-9, sampleAction);
+    }
+#endif
+
     if (flags == AMOTION_EVENT_ACTION_POINTER_UP || flags == AMOTION_EVENT_ACTION_UP)
     {
         // One of the touchpoints is released, remove it from touch point arrays
@@ -1332,8 +2124,6 @@ static int32_t AndroidInputCallback(struct android_app *app, AInputEvent *event)
     // Map touch[0] as mouse input for convenience
     CORE.Input.Mouse.currentPosition = CORE.Input.Touch.position[0];
     CORE.Input.Mouse.currentWheelMove = (Vector2){ 0.0f, 0.0f };
-
-    return 0;
 }
 
 // EOF
@@ -72,6 +72,7 @@
 #if defined(RAUDIO_STANDALONE)
     #include "raudio.h"
 #else
+    #define RL_MEMORY_TAG MEMORY_TAG_AUDIO
     #include "raylib.h"         // Declares module functions
 
     // Check if config flags have been externally provided on compilation line
@@ -160,8 +161,15 @@ typedef struct tagBITMAPINFOHEADER {
 #endif
 #endif
 
-#define MA_MALLOC RL_MALLOC
-#define MA_FREE RL_FREE
+#if defined(SUPPORT_MEMORY_TRACKING)
+    #define MA_MALLOC(sz) MemAllocTracked((unsigned int)(sz), MEMORY_TAG_MINIAUDIO)
+    #define MA_REALLOC(p,sz) MemReallocTracked(p, (unsigned int)(sz), MEMORY_TAG_MINIAUDIO)
+    #define MA_FREE(p) MemFreeTracked(p)
+#else
+    #define MA_MALLOC RL_MALLOC
+    #define MA_REALLOC RL_REALLOC
+    #define MA_FREE RL_FREE
+#endif
 
 #define MA_NO_JACK
 #define MA_NO_WAV
@@ -298,6 +306,12 @@ typedef struct tagBITMAPINFOHEADER {
 #ifndef MAX_AUDIO_BUFFER_POOL_CHANNELS
     #define MAX_AUDIO_BUFFER_POOL_CHANNELS    16    // Audio pool channels
 #endif
+#ifndef MAX_AUDIO_VOICES
+    #define MAX_AUDIO_VOICES                  16    // Voices pool size
+#endif
+#ifndef MAX_AUDIO_VOICE_COMMANDS
+    #define MAX_AUDIO_VOICE_COMMANDS          64    // Voice commands queue size (power of 2)
+#endif
 
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
@@ -375,6 +389,34 @@ struct rAudioProcessor {
 
 #define AudioBuffer rAudioBuffer    // HACK: To avoid CoreAudio (macOS) symbol collision
 
+// Voice command type
+// NOTE: PlaySoundVoice() and StopSoundVoices() only queue commands, voices are only used by the mixer
+typedef enum {
+    AUDIO_VOICE_PLAY = 0,
+    AUDIO_VOICE_STOP
+} AudioVoiceCommandType;
+
+// Voice command, one slot of the lock-free commands queue
+typedef struct {
+    ma_uint32 sequence;             // Slot position + 1 once written, position + MAX_AUDIO_VOICE_COMMANDS once read
+    int type;                       // AudioVoiceCommandType
+    const float *data;              // Sound data, device format
+    ma_uint32 frameCount;           // Sound data frames
+    float volume;                   // Voice volume, sound volume applied
+    float step;                     // Sound frames per device frame: pitch and sample rates ratio
+    float pan;                      // Voice pan (0.0f to 1.0f)
+} AudioVoiceCommand;
+
+// Voice, plays sound data without the sound AudioBuffer, so a sound plays on many voices at once
+typedef struct {
+    const float *data;              // Sound data, device format
+    ma_uint32 frameCount;           // Sound data frames
+    double cursor;                  // Frame cursor position, fractional when pitched
+    float step;                     // Sound frames per device frame
+    float levels[2];                // Channels volume, pan applied
+    bool active;                    // Voice playing
+} AudioVoice;
+
 // Audio data context
 typedef struct AudioData {
     struct {
@@ -390,6 +432,12 @@ typedef struct AudioData {
         AudioBuffer *last;          // Pointer to last AudioBuffer in the list
         int defaultSize;            // Default audio buffer size for audio streams
     } Buffer;
+    struct {
+        AudioVoice voices[MAX_AUDIO_VOICES];                    // Voices pool, only used by the mixer (locked state)
+        AudioVoiceCommand commands[MAX_AUDIO_VOICE_COMMANDS];   // Commands queue, any thread writes, the mixer reads
+        ma_uint32 head;             // Next command slot to write
+        ma_uint32 tail;             // Next command slot to read (locked state)
+    } Voice;
     rAudioProcessor *mixedProcessor;
 } AudioData;
 
@@ -418,6 +466,15 @@ static ma_uint32 ReadAudioBufferFramesInMixingFormat(AudioBuffer *audioBuffer, f
 static void OnSendAudioDataToDevice(ma_device *pDevice, void *pFramesOut, const void *pFramesInput, ma_uint32 frameCount);
 static void MixAudioFrames(float *framesOut, const float *framesIn, ma_uint32 frameCount, AudioBuffer *buffer);
 
+static bool PushAudioVoiceCommand(const AudioVoiceCommand *command);
+static void UpdateAudioVoicesInLockedState(void);
+static void StopAudioVoicesInLockedState(const float *data);
+static void MixAudioVoices(float *framesOut, ma_uint32 frameCount);
+#if defined(SUPPORT_AUDIO_LOW_LATENCY)
+static ma_uint32 GetAudioDeviceBurstPeriod(void);
+static bool IsAudioDeviceExclusive(void);
+#endif
+
 static bool IsAudioBufferPlayingInLockedState(AudioBuffer *buffer);
 static void StopAudioBufferInLockedState(AudioBuffer *buffer);
 static void UpdateAudioStreamInLockedState(AudioStream stream, const void *data, int frameCount);
@@ -482,7 +539,46 @@ void InitAudioDevice(void)
     config.dataCallback = OnSendAudioDataToDevice;
     config.pUserData = NULL;
 
+#if defined(SUPPORT_AUDIO_LOW_LATENCY)
+    // NOTE: On AAudio low latency is the LowLatency performance mode (fast mixer track, MMAP when exclusive)
+    // and the device native sample rate (AUDIO_DEVICE_SAMPLE_RATE 0), a resampler adds latency
+    config.performanceProfile = ma_performance_profile_low_latency;
+    config.playback.shareMode = ma_share_mode_exclusive;
+    config.aaudio.usage = ma_aaudio_usage_game;
+    config.aaudio.contentType = ma_aaudio_content_type_sonification;
+#endif
+
     result = ma_device_init(&AUDIO.System.context, &config, &AUDIO.System.device);
+
+#if defined(SUPPORT_AUDIO_LOW_LATENCY)
+    // Backends without exclusive mode fail instead of opening a shared stream
+    if (result != MA_SUCCESS)
+    {
+        config.playback.shareMode = ma_share_mode_shared;
+        result = ma_device_init(&AUDIO.System.context, &config, &AUDIO.System.device);
+    }
+
+    // Opened again with callbacks of one native burst, the burst is only known once a stream is open
+    // NOTE: Two bursts buffered, the least the device mixer reads without glitches
+    ma_uint32 burstPeriod = (result == MA_SUCCESS)? GetAudioDeviceBurstPeriod() : 0;
+    if (burstPeriod > 0)
+    {
+        ma_device_uninit(&AUDIO.System.device);
+
+        config.periodSizeInFrames = burstPeriod;
+        config.periods = 2;
+        result = ma_device_init(&AUDIO.System.context, &config, &AUDIO.System.device);
+
+        if (result != MA_SUCCESS)
+        {
+            TRACELOG(LOG_WARNING, "AUDIO: Failed to open playback device with %i frames callbacks", burstPeriod);
+            config.periodSizeInFrames = 0;
+            config.periods = 0;
+            result = ma_device_init(&AUDIO.System.context, &config, &AUDIO.System.device);
+        }
+    }
+#endif
+
     if (result != MA_SUCCESS)
     {
         TRACELOG(LOG_WARNING, "AUDIO: Failed to initialize playback device");
@@ -500,6 +596,10 @@ void InitAudioDevice(void)
         return;
     }
 
+    // Every voice stopped, every command slot free to write
+    memset(&AUDIO.Voice, 0, sizeof(AUDIO.Voice));
+    for (ma_uint32 i = 0; i < MAX_AUDIO_VOICE_COMMANDS; i++) AUDIO.Voice.commands[i].sequence = i;
+
     // Keep the device running the whole time. May want to consider doing something a bit smarter and only have the device running
     // while there's at least one sound being played
     result = ma_device_start(&AUDIO.System.device);
@@ -517,6 +617,10 @@ void InitAudioDevice(void)
     TRACELOG(LOG_INFO, "    > Channels:      %d -> %d", AUDIO.System.device.playback.channels, AUDIO.System.device.playback.internalChannels);
     TRACELOG(LOG_INFO, "    > Sample rate:   %d -> %d", AUDIO.System.device.sampleRate, AUDIO.System.device.playback.internalSampleRate);
     TRACELOG(LOG_INFO, "    > Periods size:  %d", AUDIO.System.device.playback.internalPeriodSizeInFrames*AUDIO.System.device.playback.internalPeriods);
+#if defined(SUPPORT_AUDIO_LOW_LATENCY)
+    TRACELOG(LOG_INFO, "    > Latency:       low latency, %s, %d frames callbacks", IsAudioDeviceExclusive()? "exclusive" : "shared",
+        AUDIO.System.device.playback.internalPeriodSizeInFrames);
+#endif
 
     AUDIO.System.isReady = true;
 }
@@ -622,6 +726,15 @@ void UnloadAudioBuffer(AudioBuffer *buffer)
 {
     if (buffer != NULL)
     {
+        // Voices playing the data (and play commands queued for it) are stopped before it is freed
+        if (AUDIO.System.isReady && (buffer->data != NULL))
+        {
+            ma_mutex_lock(&AUDIO.System.lock);
+            UpdateAudioVoicesInLockedState();
+            StopAudioVoicesInLockedState((const float *)buffer->data);
+            ma_mutex_unlock(&AUDIO.System.lock);
+        }
+
         UntrackAudioBuffer(buffer);
         ma_data_converter_uninit(&buffer->converter, NULL);
         RL_FREE(buffer->data);
@@ -770,14 +883,22 @@ Wave LoadWave(const char *fileName)
 {
     Wave wave = { 0 };
 
-    // Loading file to memory
+    // Loading file to memory (mapped, decoded in place)
     int dataSize = 0;
+#if defined(RAUDIO_STANDALONE)
     unsigned char *fileData = LoadFileData(fileName, &dataSize);
+#else
+    const unsigned char *fileData = LoadFileDataMapped(fileName, &dataSize);
+#endif
 
     // Loading wave from memory data
     if (fileData != NULL) wave = LoadWaveFromMemory(GetFileExtension(fileName), fileData, dataSize);
 
+#if defined(RAUDIO_STANDALONE)
     UnloadFileData(fileData);
+#else
+    UnloadFileDataMapped(fileData);
+#endif
 
     return wave;
 }
@@ -1220,6 +1341,46 @@ void SetSoundPan(Sound sound, float pan)
     SetAudioBufferPan(sound.stream.buffer, pan);
 }
 
+// Play a sound on a preallocated voice, plays of the same sound overlap (no alias required)
+// NOTE: Lock-free and without allocation, from any thread: the play is queued for the next device callback,
+// volume multiplies the sound volume and the voice closest to its end is taken when all of them are playing
+bool PlaySoundVoice(Sound sound, float volume, float pitch, float pan)
+{
+    if (!AUDIO.System.isReady || (sound.stream.buffer == NULL) || (sound.stream.buffer->data == NULL)) return false;
+
+    // Only data in device format, as loaded by LoadSound() and LoadSoundFromWave()
+    if ((sound.stream.sampleSize != 32) || (sound.stream.channels != AUDIO_DEVICE_CHANNELS) || (sound.frameCount < 2)) return false;
+
+    AudioVoiceCommand command = { 0 };
+    command.type = AUDIO_VOICE_PLAY;
+    command.data = (const float *)sound.stream.buffer->data;
+    command.frameCount = sound.frameCount;
+    command.volume = volume*sound.stream.buffer->volume;
+    command.step = pitch*(float)sound.stream.sampleRate/(float)AUDIO.System.device.sampleRate;
+    command.pan = pan;
+
+    return PushAudioVoiceCommand(&command);
+}
+
+// Stop the voices playing a sound, aliases of it included (shared data)
+void StopSoundVoices(Sound sound)
+{
+    if (!AUDIO.System.isReady || (sound.stream.buffer == NULL) || (sound.stream.buffer->data == NULL)) return;
+
+    AudioVoiceCommand command = { 0 };
+    command.type = AUDIO_VOICE_STOP;
+    command.data = (const float *)sound.stream.buffer->data;
+
+    // NOTE: A stop is never dropped, on a full queue the voices are stopped right away
+    if (!PushAudioVoiceCommand(&command))
+    {
+        ma_mutex_lock(&AUDIO.System.lock);
+        UpdateAudioVoicesInLockedState();
+        StopAudioVoicesInLockedState(command.data);
+        ma_mutex_unlock(&AUDIO.System.lock);
+    }
+}
+
 // Convert wave data to desired format
 void WaveFormat(Wave *wave, int sampleRate, int sampleSize, int channels)
 {
@@ -2570,6 +2731,10 @@ static void OnSendAudioDataToDevice(ma_device *pDevice, void *pFramesOut, const
         }
     }
 
+    // Voices started since the last callback join the mix
+    UpdateAudioVoicesInLockedState();
+    MixAudioVoices((float *)pFramesOut, frameCount);
+
     rAudioProcessor *processor = AUDIO.mixedProcessor;
     while (processor)
     {
@@ -2623,6 +2788,172 @@ static void MixAudioFrames(float *framesOut, const float *framesIn, ma_uint32 fr
     }
 }
 
+// Queue a voice command, from any thread (bounded queue, slots claimed with a compare-exchange on the head)
+// NOTE: Returns false when the queue is full, the device callback has not read it for a while
+static bool PushAudioVoiceCommand(const AudioVoiceCommand *command)
+{
+    ma_uint32 head = ma_atomic_load_explicit_32(&AUDIO.Voice.head, ma_atomic_memory_order_relaxed);
+    AudioVoiceCommand *slot = NULL;
+
+    while (true)
+    {
+        slot = &AUDIO.Voice.commands[head & (MAX_AUDIO_VOICE_COMMANDS - 1)];
+        ma_int32 diff = (ma_int32)(ma_atomic_load_explicit_32(&slot->sequence, ma_atomic_memory_order_acquire) - head);
+
+        if (diff < 0) return false;     // Slot not read yet: queue full
+        else if (diff == 0)
+        {
+            // Slot free, claimed unless another thread took it first (head is then updated)
+            if (ma_atomic_compare_exchange_weak_explicit_32(&AUDIO.Voice.head, &head, head + 1, ma_atomic_memory_order_relaxed, ma_atomic_memory_order_relaxed)) break;
+        }
+        else head = ma_atomic_load_explicit_32(&AUDIO.Voice.head, ma_atomic_memory_order_relaxed);
+    }
+
+    slot->type = command->type;
+    slot->data = command->data;
+    slot->frameCount = command->frameCount;
+    slot->volume = command->volume;
+    slot->step = command->step;
+    slot->pan = command->pan;
+
+    // Published to the mixer
+    ma_atomic_store_explicit_32(&slot->sequence, head + 1, ma_atomic_memory_order_release);
+
+    return true;
+}
+
+// Apply the queued voice commands, assuming the audio system mutex has been locked
+static void UpdateAudioVoicesInLockedState(void)
+{
+    while (true)
+    {
+        ma_uint32 tail = AUDIO.Voice.tail;
+        AudioVoiceCommand *command = &AUDIO.Voice.commands[tail & (MAX_AUDIO_VOICE_COMMANDS - 1)];
+        if (ma_atomic_load_explicit_32(&command->sequence, ma_atomic_memory_order_acquire) != (tail + 1)) break;
+
+        if (command->type == AUDIO_VOICE_PLAY)
+        {
+            // Free voice, or the one closest to its end
+            AudioVoice *voice = &AUDIO.Voice.voices[0];
+            for (int i = 0; i < MAX_AUDIO_VOICES; i++)
+            {
+                AudioVoice *candidate = &AUDIO.Voice.voices[i];
+                if (!candidate->active) { voice = candidate; break; }
+                if ((candidate->cursor/candidate->frameCount) > (voice->cursor/voice->frameCount)) voice = candidate;
+            }
+
+            voice->data = command->data;
+            voice->frameCount = command->frameCount;
+            voice->cursor = 0.0;
+            voice->step = command->step;
+
+            // Same pan law as MixAudioFrames()
+            const float left = command->pan;
+            const float right = 1.0f - left;
+            if (AUDIO.System.device.playback.channels == 2)
+            {
+                voice->levels[0] = command->volume*0.5f*left*(3.0f - left*left);
+                voice->levels[1] = command->volume*0.5f*right*(3.0f - right*right);
+            }
+            else voice->levels[0] = voice->levels[1] = command->volume;
+
+            voice->active = true;
+        }
+        else StopAudioVoicesInLockedState(command->data);
+
+        // Slot free for the writer one lap later
+        ma_atomic_store_explicit_32(&command->sequence, tail + MAX_AUDIO_VOICE_COMMANDS, ma_atomic_memory_order_release);
+        AUDIO.Voice.tail = tail + 1;
+    }
+}
+
+// Stop the voices playing some sound data, assuming the audio system mutex has been locked
+static void StopAudioVoicesInLockedState(const float *data)
+{
+    for (int i = 0; i < MAX_AUDIO_VOICES; i++)
+    {
+        if (AUDIO.Voice.voices[i].data == data) AUDIO.Voice.voices[i].active = false;
+    }
+}
+
+// Mix the playing voices, accumulated like MixAudioFrames()
+// NOTE: Pitched voices read between frames, linear interpolation
+static void MixAudioVoices(float *framesOut, ma_uint32 frameCount)
+{
+    const ma_uint32 channels = AUDIO.System.device.playback.channels;
+
+    for (int i = 0; i < MAX_AUDIO_VOICES; i++)
+    {
+        AudioVoice *voice = &AUDIO.Voice.voices[i];
+        if (!voice->active) continue;
+
+        float *frameOut = framesOut;
+        double cursor = voice->cursor;
+
+        for (ma_uint32 frame = 0; frame < frameCount; frame++)
+        {
+            ma_uint32 index = (ma_uint32)cursor;
+            if (index >= (voice->frameCount - 1))
+            {
+                voice->active = false;
+                break;
+            }
+
+            const float t = (float)(cursor - index);
+            const float *frameIn = voice->data + index*channels;
+
+            for (ma_uint32 c = 0; c < channels; c++)
+            {
+                frameOut[c] += (frameIn[c] + (frameIn[c + channels] - frameIn[c])*t)*voice->levels[(c < 2)? c : 1];
+            }
+
+            frameOut += channels;
+            cursor += voice->step;
+        }
+
+        voice->cursor = cursor;
+    }
+}
+
+#if defined(SUPPORT_AUDIO_LOW_LATENCY)
+// Get the device native burst size, when callbacks of that size are possible and not set yet (0 otherwise)
+// NOTE: miniaudio only sets the AAudio callback size since Android 12, before it AAudio picks it (about one burst)
+static ma_uint32 GetAudioDeviceBurstPeriod(void)
+{
+    ma_uint32 burst = 0;
+
+#if defined(MA_HAS_AAUDIO)
+    if ((AUDIO.System.context.backend == ma_backend_aaudio) && (AUDIO.System.context.aaudio.AAudioStream_getFramesPerBurst != NULL) && (ma_android_sdk_version() > 30))
+    {
+        int32_t frames = ((MA_PFN_AAudioStream_getFramesPerBurst)AUDIO.System.context.aaudio.AAudioStream_getFramesPerBurst)((ma_AAudioStream *)AUDIO.System.device.aaudio.pStreamPlayback);
+        if ((frames > 0) && ((ma_uint32)frames != AUDIO.System.device.playback.internalPeriodSizeInFrames)) burst = (ma_uint32)frames;
+    }
+#endif
+
+    return burst;
+}
+
+// Check if the device got exclusive access (AAudio MMAP stream)
+static bool IsAudioDeviceExclusive(void)
+{
+    bool result = false;
+
+#if defined(MA_HAS_AAUDIO)
+    if (AUDIO.System.context.backend == ma_backend_aaudio)
+    {
+        // NOTE: Not loaded by miniaudio
+        typedef int32_t (*GetSharingModeFunc)(ma_AAudioStream *stream);
+        GetSharingModeFunc getSharingMode = (GetSharingModeFunc)ma_dlsym(ma_context_get_log(&AUDIO.System.context), AUDIO.System.context.aaudio.hAAudio, "AAudioStream_getSharingMode");
+        if (getSharingMode != NULL) result = (getSharingMode((ma_AAudioStream *)AUDIO.System.device.aaudio.pStreamPlayback) == MA_AAUDIO_SHARING_MODE_EXCLUSIVE);
+    }
+#else
+    result = (AUDIO.System.device.playback.shareMode == ma_share_mode_exclusive);
+#endif
+
+    return result;
+}
+#endif
+
 // Check if an audio buffer is playing, assuming the audio system mutex has been locked
 static bool IsAudioBufferPlayingInLockedState(AudioBuffer *buffer)
 {
@@ -127,6 +127,18 @@
     #define RAD2DEG (180.0f/PI)
 #endif
 
+// Memory tracking: allocations are tagged by the module making them (RL_MEMORY_TAG, defined before including raylib.h),
+// every module and the application must be built with the same SUPPORT_MEMORY_TRACKING setting (see CMakeLists.txt)
+#if defined(SUPPORT_MEMORY_TRACKING) && !defined(RL_MALLOC)
+    #ifndef RL_MEMORY_TAG
+        #define RL_MEMORY_TAG   MEMORY_TAG_GAME
+    #endif
+    #define RL_MALLOC(sz)       MemAllocTracked((unsigned int)(sz), RL_MEMORY_TAG)
+    #define RL_CALLOC(n,sz)     MemCallocTracked((unsigned int)(n), (unsigned int)(sz), RL_MEMORY_TAG)
+    #define RL_REALLOC(ptr,sz)  MemReallocTracked(ptr, (unsigned int)(sz), RL_MEMORY_TAG)
+    #define RL_FREE(ptr)        MemFreeTracked(ptr)
+#endif
+
 // Allow custom memory allocators
 // NOTE: Require recompiling raylib sources
 #ifndef RL_MALLOC
@@ -532,6 +544,37 @@ typedef struct AutomationEventList {
     AutomationEvent *events;        // Events entries
 } AutomationEventList;
 
+// Frame profiler phase stats, in milliseconds over the rolling window
+typedef struct ProfilerStats {
+    float p50;                      // Median
+    float p95;                      // 95th percentile
+    float p99;                      // 99th percentile
+    float max;                      // Worst frame
+    float last;                     // Last frame
+    int samples;                    // Frames in the window
+} ProfilerStats;
+
+// Memory stats of a tag (GetMemoryStats())
+typedef struct MemoryStats {
+    long long bytes;                // Live bytes
+    long long peak;                 // Most live bytes ever
+    int count;                      // Live allocations (GPU objects)
+} MemoryStats;
+
+// Startup timeline event, a section (with its duration) or a marker
+typedef struct TimelineEvent {
+    char name[32];                  // Event name (truncated)
+    double start;                   // Seconds since the timeline origin (process start, or resume)
+    double duration;                // Section duration in seconds, 0 for markers, -1 while the section is open
+} TimelineEvent;
+
+// Touch sample, one position reported for a pointer
+typedef struct TouchSample {
+    Vector2 position;               // Touch position on screen (like GetTouchPosition())
+    double time;                    // Event time in seconds (GetTime() clock), several samples per frame when moving
+    int action;                     // Touch sample action (TouchSampleAction)
+} TouchSample;
+
 //----------------------------------------------------------------------------------
 // Enumerators Definition
 //----------------------------------------------------------------------------------
@@ -943,6 +986,51 @@ typedef enum {
     NPATCH_THREE_PATCH_HORIZONTAL   // Npatch layout: 3x1 tiles
 } NPatchLayout;
 
+// Frame profiler phases
+// NOTE: With SUPPORT_CUSTOM_FRAME_CONTROL, only batch, render and application phases are measured.
+// GPU phases come from GPU timer queries (GL_EXT_disjoint_timer_query), read back a few frames late: every
+// frame keeps the last GPU times read, they stay 0 when timer queries are not supported
+typedef enum {
+    PROFILER_PHASE_INPUT = 0,       // PollInputEvents()
+    PROFILER_PHASE_PHYSICS,         // Application phase, timed with BeginProfilerPhase()/EndProfilerPhase()
+    PROFILER_PHASE_JNI,             // Java calls made by the application (raymob), timed like application phases
+    PROFILER_PHASE_BATCH,           // BeginDrawing() to EndDrawing(): draw calls filling the render batch
+    PROFILER_PHASE_RENDER,          // rlDrawRenderBatchActive() on EndDrawing()
+    PROFILER_PHASE_SWAP,            // SwapScreenBuffer()
+    PROFILER_PHASE_WAIT,            // Waiting for the target frame time
+    PROFILER_PHASE_FRAME,           // Whole frame (update + draw + wait)
+    PROFILER_PHASE_GPU_FRAME,       // GPU time of BeginDrawing() to EndDrawing()
+    PROFILER_PHASE_GPU_BATCH,       // GPU time of the render batch draws (texture passes included)
+    PROFILER_PHASE_GPU_TEXTURE,     // GPU time of BeginTextureMode() to EndTextureMode()
+    PROFILER_PHASE_COUNT
+} ProfilerPhase;
+
+// Memory tags, CPU allocations by module (RL_MALLOC()) and GPU objects by kind
+// NOTE: GPU sizes are estimated from the formats and sizes uploaded, drivers add their own overhead
+typedef enum {
+    MEMORY_TAG_CORE = 0,            // rcore, utils and the platform
+    MEMORY_TAG_RLGL,                // rlgl: render batch, shaders locations
+    MEMORY_TAG_TEXTURES,            // rtextures: images and their decoders
+    MEMORY_TAG_TEXT,                // rtext: fonts, glyph images, text buffers
+    MEMORY_TAG_MODELS,              // rmodels and rshapes
+    MEMORY_TAG_AUDIO,               // raudio: waves, sounds, music decoders
+    MEMORY_TAG_MINIAUDIO,           // miniaudio: device, mixing and conversion buffers
+    MEMORY_TAG_RAYMOB,              // raymob: Java bridge, app storage
+    MEMORY_TAG_GAME,                // Application: MemAlloc() and RL_MALLOC() out of raylib
+    MEMORY_TAG_CPU,                 // Every CPU tag above
+    MEMORY_TAG_GPU_TEXTURES,        // Textures and renderbuffers (estimated)
+    MEMORY_TAG_GPU_BUFFERS,         // Vertex, index and shader storage buffers (estimated)
+    MEMORY_TAG_GPU,                 // Every GPU tag above
+    MEMORY_TAG_COUNT
+} MemoryTag;
+
+// Touch sample actions
+typedef enum {
+    TOUCH_SAMPLE_DOWN = 0,          // Pointer pressed, first sample of a touch
+    TOUCH_SAMPLE_MOVE,              // Pointer moved (or held)
+    TOUCH_SAMPLE_UP                 // Pointer released or canceled, last sample of a touch
+} TouchSampleAction;
+
 // Callbacks to hook some internal functions
 // WARNING: These callbacks are intended for advanced users
 typedef void (*TraceLogCallback)(int logLevel, const char *text, va_list args);  // Logging: Redirect trace log messages
@@ -950,6 +1038,12 @@ typedef unsigned char *(*LoadFileDataCallback)(const char *fileName, int *dataSi
 typedef bool (*SaveFileDataCallback)(const char *fileName, void *data, int dataSize);   // FileIO: Save binary data
 typedef char *(*LoadFileTextCallback)(const char *fileName);            // FileIO: Load text data
 typedef bool (*SaveFileTextCallback)(const char *fileName, char *text); // FileIO: Save text data
+typedef const unsigned char *(*LoadFileDataMappedCallback)(const char *fileName, int *dataSize); // FileIO: Load binary data view, NULL when not handled
+typedef bool (*UnloadFileDataMappedCallback)(const unsigned char *data);  // FileIO: Unload binary data view, false when not handled
+typedef void (*ContextRestoredCallback)(void);                          // Window: GL context lost and created again, GPU resources gone
+typedef void (*JobCallback)(void *context);                             // Jobs: Job function, runs on a job worker (or a thread waiting for jobs)
+typedef void (*JobRangeCallback)(void *context, int start, int end);    // Jobs: ParallelFor() function, for the items [start, end)
+typedef void (*MemoryTrimCallback)(int level);                          // Memory: Free caches, 'level' as Android onTrimMemory() (game thread)
 
 //------------------------------------------------------------------------------------
 // Global Variables Definition
@@ -1014,6 +1108,7 @@ RLAPI const char *GetClipboardText(void);                         // Get clipboa
 RLAPI Image GetClipboardImage(void);                              // Get clipboard image content
 RLAPI void EnableEventWaiting(void);                              // Enable waiting for events on EndDrawing(), no automatic event polling
 RLAPI void DisableEventWaiting(void);                             // Disable waiting for events on EndDrawing(), automatic events polling
+RLAPI void SetEventWaitingTimeout(double seconds);                // Set the longest wait for events with event waiting enabled (0: until an event)
 
 // Cursor-related functions
 RLAPI void ShowCursor(void);                                      // Shows cursor
@@ -1050,6 +1145,7 @@ RLAPI void UnloadVrStereoConfig(VrStereoConfig config);           // Unload VR s
 // NOTE: Shader functionality is not available on OpenGL 1.1
 RLAPI Shader LoadShader(const char *vsFileName, const char *fsFileName);   // Load shader from files and bind default locations
 RLAPI Shader LoadShaderFromMemory(const char *vsCode, const char *fsCode); // Load shader from code strings and bind default locations
+RLAPI void SetShaderCacheDirectory(const char *dirPath);                  // Set directory for linked shader program binaries (before InitWindow() to cache the default shader), NULL to disable
 RLAPI bool IsShaderValid(Shader shader);                                   // Check if a shader is valid (loaded on GPU)
 RLAPI int GetShaderLocation(Shader shader, const char *uniformName);       // Get shader uniform location
 RLAPI int GetShaderLocationAttrib(Shader shader, const char *attribName);  // Get shader attribute location
@@ -1076,6 +1172,38 @@ RLAPI float GetFrameTime(void);                                   // Get time in
 RLAPI double GetTime(void);                                       // Get elapsed time in seconds since InitWindow()
 RLAPI int GetFPS(void);                                           // Get current FPS
 
+// Frame profiler functions (requires SUPPORT_FRAME_PROFILER)
+RLAPI void SetProfilerOverlay(bool enabled);                      // Show/hide frame profiler overlay (drawn by EndDrawing())
+RLAPI bool IsProfilerOverlayEnabled(void);                        // Check if frame profiler overlay is shown
+RLAPI void BeginProfilerPhase(int phase);                         // Begin timing an application phase (i.e. PROFILER_PHASE_PHYSICS)
+RLAPI void EndProfilerPhase(int phase);                           // End timing an application phase, times add up within a frame
+RLAPI ProfilerStats GetProfilerStats(int phase);                  // Get rolling stats for a frame phase (milliseconds)
+
+// Startup timeline functions (requires SUPPORT_STARTUP_TIMELINE)
+RLAPI void BeginTimelineSection(const char *name);                // Begin a timeline section (also an ATrace section on Android), from any thread
+RLAPI void EndTimelineSection(const char *name);                  // End the last open timeline section with that name, on the thread that began it
+RLAPI void MarkTimelineEvent(const char *name);                   // Add a timeline marker
+RLAPI int GetTimelineEvents(TimelineEvent *events, int capacity); // Get a copy of the timeline events, returns the events count
+RLAPI bool IsTimelineComplete(void);                              // Check if the first frame was presented (timeline logged, ready to upload)
+
+// Job system functions (requires SUPPORT_JOB_SYSTEM, jobs otherwise run right away on the calling thread)
+RLAPI unsigned int RunJob(JobCallback job, void *context, const unsigned int *dependencies, int dependencyCount); // Queue a job run once its dependencies are done, returns its handle (0 if it already ran)
+RLAPI void WaitJob(unsigned int job);                             // Wait for a job to be done, running queued jobs meanwhile
+RLAPI bool IsJobDone(unsigned int job);                           // Check if a job is done
+RLAPI void ParallelFor(int count, int grain, JobRangeCallback job, void *context); // Run a function over the items [0, count), 'grain' items at a time on every worker, returns once all are done
+RLAPI int GetJobWorkerCount(void);                                // Get job worker threads count (0 when jobs run on the calling thread)
+
+// Memory arena functions (requires SUPPORT_MEMORY_ARENAS, otherwise frame memory is NULL and scratch memory comes from the heap)
+RLAPI void *MemAllocFrame(unsigned int size);                     // Frame memory allocator, all freed by EndDrawing() (NULL out of the InitWindow() thread)
+RLAPI void BeginScratchMemory(void);                              // Begin a scratch memory scope (calling thread, scopes nest)
+RLAPI void *MemAllocScratch(unsigned int size);                   // Scratch memory allocator, freed by the EndScratchMemory() of the scope
+RLAPI void EndScratchMemory(void);                                // End a scratch memory scope, freeing what it allocated
+
+// Memory tracking functions (requires SUPPORT_MEMORY_TRACKING, stats are otherwise 0)
+RLAPI MemoryStats GetMemoryStats(int tag);                        // Get live and peak memory of a tag (i.e. MEMORY_TAG_TEXTURES, MEMORY_TAG_CPU)
+RLAPI void SetMemoryTrimCallback(MemoryTrimCallback callback);    // Set a callback freeing application caches when memory runs low
+RLAPI void RequestMemoryTrim(int level);                          // Ask for a memory trim (any thread), run on the game thread at the next EndDrawing() or event poll
+
 // Custom frame control functions
 // NOTE: Those functions are intended for advanced users that want full control over the frame processing
 // By default EndDrawing() does this job: draws everything + SwapScreenBuffer() + manage frame timing + PollInputEvents()
@@ -1102,6 +1230,10 @@ RLAPI void SetTraceLogLevel(int logLevel);                        // Set the cur
 RLAPI void *MemAlloc(unsigned int size);                          // Internal memory allocator
 RLAPI void *MemRealloc(void *ptr, unsigned int size);             // Internal memory reallocator
 RLAPI void MemFree(void *ptr);                                    // Internal memory free
+RLAPI void *MemAllocTracked(unsigned int size, int tag);          // Tracked memory allocator (RL_MALLOC() with SUPPORT_MEMORY_TRACKING)
+RLAPI void *MemCallocTracked(unsigned int count, unsigned int size, int tag); // Tracked memory allocator, initialized to zero
+RLAPI void *MemReallocTracked(void *ptr, unsigned int size, int tag); // Tracked memory reallocator
+RLAPI void MemFreeTracked(void *ptr);                             // Tracked memory free
 
 // Set custom callbacks
 // WARNING: Callbacks setup is intended for advanced users
@@ -1110,10 +1242,15 @@ RLAPI void SetLoadFileDataCallback(LoadFileDataCallback callback); // Set custom
 RLAPI void SetSaveFileDataCallback(SaveFileDataCallback callback); // Set custom file binary data saver
 RLAPI void SetLoadFileTextCallback(LoadFileTextCallback callback); // Set custom file text data loader
 RLAPI void SetSaveFileTextCallback(SaveFileTextCallback callback); // Set custom file text data saver
+RLAPI void SetLoadFileDataMappedCallback(LoadFileDataMappedCallback callback); // Set custom file data view loader, tried before the default one
+RLAPI void SetUnloadFileDataMappedCallback(UnloadFileDataMappedCallback callback); // Set custom file data view unloader
+RLAPI void SetContextRestoredCallback(ContextRestoredCallback callback); // Set GPU resources reload, called when a lost GL context was replaced
 
 // Files management functions
 RLAPI unsigned char *LoadFileData(const char *fileName, int *dataSize); // Load file data as byte array (read)
 RLAPI void UnloadFileData(unsigned char *data);                   // Unload file data allocated by LoadFileData()
+RLAPI const unsigned char *LoadFileDataMapped(const char *fileName, int *dataSize); // Load file data as a read-only view (Android assets mapped, no copy)
+RLAPI void UnloadFileDataMapped(const unsigned char *data);       // Unload file data view returned by LoadFileDataMapped()
 RLAPI bool SaveFileData(const char *fileName, void *data, int dataSize); // Save data to file from byte array (write), returns true on success
 RLAPI bool ExportDataAsCode(const unsigned char *data, int dataSize, const char *fileName); // Export data to code (.h), returns true on success
 RLAPI char *LoadFileText(const char *fileName);                   // Load text data from file (read), returns a '\0' terminated string
@@ -1214,6 +1351,8 @@ RLAPI int GetTouchY(void);                                    // Get touch posit
 RLAPI Vector2 GetTouchPosition(int index);                    // Get touch position XY for a touch point index (relative to screen size)
 RLAPI int GetTouchPointId(int index);                         // Get touch point identifier for given index
 RLAPI int GetTouchPointCount(void);                           // Get number of touch points
+RLAPI int GetTouchHistory(int id, TouchSample *samples, int maxSamples); // Get last touch samples of a pointer identifier, oldest first (returns samples count)
+RLAPI Vector2 GetTouchVelocity(int id, float window);         // Get touch velocity of a pointer identifier (pixels/second), fitted over its last 'window' seconds
 
 //------------------------------------------------------------------------------------
 // Gestures and Touch Handling Functions (Module: rgestures)
@@ -1321,6 +1460,7 @@ RLAPI Rectangle GetCollisionRec(Rectangle rec1, Rectangle rec2);
 // Image loading functions
 // NOTE: These functions do not require GPU access
 RLAPI Image LoadImage(const char *fileName);                                                             // Load image from file into CPU memory (RAM)
+RLAPI int LoadImages(const char **fileNames, int count, Image *images);                                  // Load images from files, decoded in parallel on the job workers, returns images loaded
 RLAPI Image LoadImageRaw(const char *fileName, int width, int height, int format, int headerSize);       // Load image from RAW file data
 RLAPI Image LoadImageAnim(const char *fileName, int *frames);                                            // Load image sequence from file (frames appended to image.data)
 RLAPI Image LoadImageAnimFromMemory(const char *fileType, const unsigned char *fileData, int dataSize, int *frames); // Load image sequence from memory buffer
@@ -1411,6 +1551,7 @@ RLAPI void ImageDrawTextEx(Image *dst, Font font, const char *text, Vector2 posi
 // NOTE: These functions require GPU access
 RLAPI Texture2D LoadTexture(const char *fileName);                                                       // Load texture from file into GPU memory (VRAM)
 RLAPI Texture2D LoadTextureFromImage(Image image);                                                       // Load texture from image data
+RLAPI int LoadTextures(const char **fileNames, int count, Texture2D *textures);                          // Load textures from files, decoded in parallel then uploaded back to back, returns textures loaded
 RLAPI TextureCubemap LoadTextureCubemap(Image image, int layout);                                        // Load cubemap from image, multiple image cubemap layouts supported
 RLAPI RenderTexture2D LoadRenderTexture(int width, int height);                                          // Load texture for rendering (framebuffer)
 RLAPI bool IsTextureValid(Texture2D texture);                                                            // Check if a texture is valid (loaded in GPU)
@@ -1654,6 +1795,8 @@ RLAPI bool IsSoundPlaying(Sound sound);                               // Check i
 RLAPI void SetSoundVolume(Sound sound, float volume);                 // Set volume for a sound (1.0 is max level)
 RLAPI void SetSoundPitch(Sound sound, float pitch);                   // Set pitch for a sound (1.0 is base level)
 RLAPI void SetSoundPan(Sound sound, float pan);                       // Set pan for a sound (0.5 is center)
+RLAPI bool PlaySoundVoice(Sound sound, float volume, float pitch, float pan); // Play a sound on a preallocated voice, overlapping other plays (lock-free, no allocation)
+RLAPI void StopSoundVoices(Sound sound);                              // Stop the voices playing a sound or its aliases
 RLAPI Wave WaveCopy(Wave wave);                                       // Copy a wave to a new wave
 RLAPI void WaveCrop(Wave *wave, int initFrame, int finalFrame);       // Crop a wave to defined frames range
 RLAPI void WaveFormat(Wave *wave, int sampleRate, int sampleSize, int channels); // Convert wave data to desired format
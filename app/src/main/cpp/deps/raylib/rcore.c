@@ -95,6 +95,7 @@
     #define _POSIX_C_SOURCE 199309L // Required for: CLOCK_MONOTONIC if compiled with c99 without gnu ext.
 #endif
 
+#define RL_MEMORY_TAG MEMORY_TAG_CORE
 #include "raylib.h"                 // Declares module functions
 
 // Check if config flags have been externally provided on compilation line
@@ -110,8 +111,12 @@
 #include <time.h>                   // Required for: time() [Used in InitTimer()]
 #include <math.h>                   // Required for: tan() [Used in BeginMode3D()], atan2f() [Used in LoadVrStereoConfig()]
 
+#undef RL_MEMORY_TAG
+#define RL_MEMORY_TAG MEMORY_TAG_RLGL
 #define RLGL_IMPLEMENTATION
 #include "rlgl.h"                   // OpenGL abstraction layer to OpenGL 1.1, 3.3+ or ES2
+#undef RL_MEMORY_TAG
+#define RL_MEMORY_TAG MEMORY_TAG_CORE
 
 #define RAYMATH_IMPLEMENTATION
 #include "raymath.h"                // Vector2, Vector3, Quaternion and Matrix functionality
@@ -145,6 +150,9 @@
 #endif
 
 #if defined(SUPPORT_RPRAND_GENERATOR)
+    #define RPRAND_CALLOC(n,sz) RL_CALLOC(n,sz)
+    #define RPRAND_FREE(ptr) RL_FREE(ptr)
+
     #define RPRAND_IMPLEMENTATION
     #include "external/rprand.h"
 #endif
@@ -177,6 +185,16 @@ __declspec(dllimport) unsigned int __stdcall timeEndPeriod(unsigned int uPeriod)
 #define _CRT_INTERNAL_NONSTDC_NAMES  1
 #include <sys/stat.h>               // Required for: stat(), S_ISREG [Used in GetFileModTime(), IsFilePath()]
 
+#include <pthread.h>                // Required for: pthread_mutex_lock(), pthread_key_create() [Used in startup timeline, job system and memory arenas]
+
+#if defined(SUPPORT_JOB_SYSTEM)
+    #include <sched.h>              // Required for: sched_yield() [Used in job system]
+    #include <stdint.h>             // Required for: intptr_t [Used in job system]
+    #if defined(PLATFORM_ANDROID)
+        #include <sys/syscall.h>    // Required for: __NR_sched_setaffinity [Used in job system]
+    #endif
+#endif
+
 #if !defined(S_ISREG) && defined(S_IFMT) && defined(S_IFREG)
     #define S_ISREG(m) (((m) & S_IFMT) == S_IFREG)
 #endif
@@ -220,6 +238,15 @@ __declspec(dllimport) unsigned int __stdcall timeEndPeriod(unsigned int uPeriod)
 #ifndef MAX_KEYBOARD_KEYS
     #define MAX_KEYBOARD_KEYS            512        // Maximum number of keyboard keys supported
 #endif
+#ifndef GIF_RECORD_FRAMERATE
+    #define GIF_RECORD_FRAMERATE          10        // GIF recording frames per second
+#endif
+#ifndef GIF_RECORD_BITRATE
+    #define GIF_RECORD_BITRATE            16        // GIF recording color depth (msf_gif maxBitDepth)
+#endif
+#ifndef GIF_CAPTURE_BUFFERS
+    #define GIF_CAPTURE_BUFFERS            3        // GIF frames read or encoded at once (pixel buffers and frame buffers)
+#endif
 #ifndef MAX_MOUSE_BUTTONS
     #define MAX_MOUSE_BUTTONS              8        // Maximum number of mouse buttons supported
 #endif
@@ -279,6 +306,7 @@ typedef struct CoreData {
         bool shouldClose;                   // Check if window set for closing
         bool resizedLastFrame;              // Check if window has been resized last frame
         bool eventWaiting;                  // Wait for events before ending frame
+        double eventWaitingTimeout;         // Longest wait for events (seconds), 0 waits until an event
         bool usingFbo;                      // Using FBO (RenderTexture) for rendering instead of default framebuffer
 
         Point position;                     // Window position (required on fullscreen toggle)
@@ -381,10 +409,40 @@ bool isGpuReady = false;
 static int screenshotCounter = 0;           // Screenshots counter
 #endif
 
+#if defined(SUPPORT_SHADER_CACHE)
+static char shaderCacheDir[MAX_FILEPATH_LENGTH] = { 0 };    // Shader program binaries directory, empty when disabled
+#endif
+
+static ContextRestoredCallback contextRestored = NULL;      // Called when a lost GL context was replaced (GPU resources reload)
+static MemoryTrimCallback memoryTrim = NULL;                // Called when memory runs low (application caches)
+static int memoryTrimLevel = 0;                             // Trim level requested, 0 for none (set from any thread)
+
 #if defined(SUPPORT_GIF_RECORDING)
+// GIF frame being read from the screen (pixel buffer) or encoded (frame buffer)
+typedef struct GifCapture {
+    unsigned int pbo;                       // Pixel pack buffer, 0 when screen reads are synchronous (OpenGL ES 2.0)
+    void *fence;                            // Screen read in flight
+    int delay;                              // Centiseconds the frame is shown
+} GifCapture;
+
+typedef struct GifFrame {
+    unsigned char *pixels;                  // width*height*4 bytes
+    int delay;
+    int pitch;                              // Negative for rows from the bottom up (pixel buffer reads)
+    unsigned int job;                       // Encoding job, frame buffer busy until it is done
+} GifFrame;
+
 static unsigned int gifFrameCounter = 0;    // GIF frames counter
 static bool gifRecording = false;           // GIF recording state
 static MsfGifState gifState = { 0 };        // MSGIF context state
+static int gifWidth = 0;                    // Size of the recorded frames, set when recording starts
+static int gifHeight = 0;
+static GifCapture gifCaptures[GIF_CAPTURE_BUFFERS] = { 0 };   // Screen reads in flight, oldest at gifCaptureFirst
+static int gifCaptureFirst = 0;
+static int gifCaptureCount = 0;
+static GifFrame gifFrames[GIF_CAPTURE_BUFFERS] = { 0 };       // Frame buffers, used in turn
+static int gifFrameNext = 0;
+static unsigned int gifEncodeJob = 0;       // Last encoding job queued, every frame waits for the previous one
 #endif
 
 #if defined(SUPPORT_AUTOMATION_EVENTS)
@@ -475,6 +533,169 @@ static bool automationEventRecording = false;               // Recording automat
 #endif
 //-----------------------------------------------------------------------------------
 
+#if defined(SUPPORT_FRAME_PROFILER)
+// Frame profiler: time spent in each frame phase, kept over a rolling window of frames
+// NOTE: Every phase keeps a log-scale histogram of the window (bin resolution ~9%), so percentiles
+// are a walk over FRAME_PROFILER_BINS counters instead of a sort of the whole history
+#define PROFILER_BINS_PER_OCTAVE     8
+#define PROFILER_MIN_TIME          (1.0/32.0)   // Upper bound of the first bin (milliseconds)
+
+typedef struct FrameProfiler {
+    bool overlay;                                                   // Draw overlay on EndDrawing()
+    double frame[PROFILER_PHASE_COUNT];                             // Time accumulated by each phase this frame (seconds)
+    double phaseStart[PROFILER_PHASE_COUNT];                        // Start time of application phases
+    float history[PROFILER_PHASE_COUNT][FRAME_PROFILER_HISTORY];    // Phase times (milliseconds)
+    unsigned char historyBin[PROFILER_PHASE_COUNT][FRAME_PROFILER_HISTORY]; // Histogram bin of every history entry
+    unsigned short histogram[PROFILER_PHASE_COUNT][FRAME_PROFILER_BINS];    // Entries per bin over the window
+    int head;                                                       // Next history entry
+    int count;                                                      // Frames in the window
+} FrameProfiler;
+
+static FrameProfiler profiler = { 0 };
+#endif
+
+#if defined(SUPPORT_STARTUP_TIMELINE)
+// Startup timeline: sections and markers from the process start (or a resume) to the first presented frame
+// NOTE: Sections may come from loader threads, events are added under a lock
+#define TIMELINE_PRESENT_TIMEOUT    60      // Frames waiting for the first frame present time (and GPU time) before giving up
+#define TIMELINE_GPU_FRAMES         (2*RL_GPU_TIMER_FRAMES)     // Frame start times kept until their GPU times are read back
+
+typedef struct StartupTimeline {
+    TimelineEvent events[MAX_TIMELINE_EVENTS];
+    int count;                      // Events recorded
+    double origin;                  // Timeline start, monotonic clock (seconds)
+    bool resume;                    // Timeline started by a resume, not a cold start
+    int frames;                     // Frames drawn since the timeline start
+    bool complete;                  // First frame presented (or presentation time not available)
+    double frameStart;              // Current frame BeginDrawing() time, monotonic clock (seconds)
+    double gpuFrameStarts[TIMELINE_GPU_FRAMES];     // Start time of the frames GPU timed, by frame number
+    int gpuFrames;                  // Frames GPU times added
+} StartupTimeline;
+
+static StartupTimeline timeline = { 0 };
+static pthread_mutex_t timelineMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+#if defined(SUPPORT_TOUCH_HISTORY)
+// Touch history: samples of the last touch of every pointer identifier, a ring of MAX_TOUCH_HISTORY each
+// NOTE: Android pointer identifiers are small and reused (lowest free one), used as the ring index
+typedef struct TouchHistory {
+    TouchSample samples[MAX_TOUCH_HISTORY];
+    int head;                       // Next sample written
+    int count;                      // Samples in the ring
+} TouchHistory;
+
+static TouchHistory touchHistory[MAX_TOUCH_POINTS] = { 0 };
+#endif
+
+#if defined(SUPPORT_JOB_SYSTEM)
+// Job system: worker threads on the big cores, each with a work-stealing deque (Chase-Lev, fixed size),
+// the thread calling InitWindow() owns deque 0. A thread pushes and pops its own jobs at the bottom (newest
+// first, still in cache), idle threads steal the oldest ones at the top. Jobs added from other threads
+// (loaders, audio) go to a shared queue instead
+// NOTE: Jobs live in a fixed pool, a handle is the job slot index plus a generation: once the job is done
+// the slot handle moves on to the next generation, older handles then read as done
+#define JOB_SPIN_COUNT          64          // Failed rounds of steals before an idle worker sleeps
+#define JOB_MIN_BIG_CORES        4          // Fewer big cores than this: workers run on every core
+
+typedef struct JobSlot {
+    JobCallback callback;
+    void *context;
+    unsigned int handle;                    // Handle of the job in the slot, next generation once done
+    int used;                               // Slot taken (waiting, queued or running)
+    int pending;                            // Dependencies not done, plus one while the job is added
+    int lock;                               // Spinlock on the handle and the dependents
+    int dependentCount;
+    int dependents[MAX_JOB_DEPENDENTS];     // Slots of the jobs waiting for this one
+} JobSlot;
+
+typedef struct JobDeque {
+    long top;                               // Next job stolen (any thread)
+    char padding[64 - sizeof(long)];        // Owner and thieves counters on their own cache line
+    long bottom;                            // Next job pushed (owner thread)
+    int jobs[MAX_JOBS];                     // Slots, every job fits (deque never full)
+} JobDeque;
+
+typedef struct JobSystem {
+    JobSlot slots[MAX_JOBS];
+    JobDeque deques[MAX_JOB_WORKERS + 1];
+    int dequeCount;                         // Workers plus the InitWindow() thread
+    int workerCount;                        // Workers running (0: jobs run right away)
+    unsigned long affinity;                 // Cores mask of the workers (0: any core)
+    unsigned int nextSlot;                  // Start of the next free slot search
+    int queued;                             // Jobs in the deques and the shared queue (wake up hint)
+    int sleeping;                           // Workers waiting for jobs
+    int shared[MAX_JOBS];                   // Shared queue, under the mutex
+    int sharedHead;
+    int sharedCount;
+    bool closing;
+    pthread_t workers[MAX_JOB_WORKERS];
+    pthread_mutex_t mutex;                  // Shared queue and sleeping workers
+    pthread_cond_t jobsAdded;
+} JobSystem;
+
+// ParallelFor() items, ranges taken by every helper job in turn
+typedef struct JobRange {
+    JobRangeCallback callback;
+    void *context;
+    int count;
+    int grain;
+    int next;                               // Start of the next range
+} JobRange;
+
+static JobSystem jobSystem = { 0 };
+static __thread int jobDeque = -1;          // Deque of the calling thread (-1: not a job system thread)
+#endif
+
+// Memory arenas: a chain of blocks allocated from front to back and freed all at once (frame end, scope end).
+// A full block chains a new one twice as big (or as big as the allocation). Once empty again, the arena keeps
+// a single block as big as its peak, so the heap is only used again by a busier frame (scope) than any before.
+// The frame arena belongs to the InitWindow() thread, every thread has a scratch arena of its own
+// NOTE: Without SUPPORT_MEMORY_ARENAS every allocation is a block of its own and nothing is kept
+#if defined(SUPPORT_MEMORY_ARENAS)
+    #define ARENA_FRAME_SIZE        FRAME_MEMORY_SIZE
+    #define ARENA_SCRATCH_SIZE      SCRATCH_MEMORY_SIZE
+    #define ARENA_RETAINED_SIZE     MAX_ARENA_RETAINED_SIZE
+#else
+    #define ARENA_FRAME_SIZE        0
+    #define ARENA_SCRATCH_SIZE      0
+    #define ARENA_RETAINED_SIZE     0
+#endif
+#define ARENA_ALIGNMENT            16
+#define ARENA_HEADER_SIZE          ((sizeof(ArenaBlock) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1))
+
+typedef struct ArenaBlock {
+    struct ArenaBlock *previous;            // Block chained before, NULL for the first one
+    size_t size;                            // Bytes after the header
+    size_t used;
+} ArenaBlock;
+
+typedef struct MemoryArena {
+    ArenaBlock *block;                      // Last block of the chain, NULL while empty
+    size_t firstSize;                       // Size of the first block
+    size_t used;                            // Bytes allocated over every block
+    size_t peak;                            // Most bytes ever allocated at once
+} MemoryArena;
+
+// Arena state at the start of a scratch scope
+typedef struct ArenaMark {
+    ArenaBlock *block;
+    size_t blockUsed;
+    size_t used;
+} ArenaMark;
+
+typedef struct ScratchMemory {
+    MemoryArena arena;
+    ArenaMark scopes[MAX_SCRATCH_SCOPES];
+    int depth;                              // Scopes open, more than MAX_SCRATCH_SCOPES are merged into the last one
+    bool registered;                        // Freed on thread exit (scratchKey)
+} ScratchMemory;
+
+static MemoryArena frameArena = { NULL, ARENA_FRAME_SIZE, 0, 0 };
+static __thread bool frameArenaThread = false;      // Thread that called InitWindow()
+static __thread ScratchMemory scratchMemory = { { NULL, ARENA_SCRATCH_SIZE, 0, 0 }, { { 0 } }, 0, false };
+static pthread_key_t scratchKey;
+static pthread_once_t scratchKeyOnce = PTHREAD_ONCE_INIT;
 //----------------------------------------------------------------------------------
 // Module Functions Declaration
 // NOTE: Those functions are common for all platforms!
@@ -494,11 +715,60 @@ static void SetupViewport(int width, int height);           // Set viewport for
 
 static void ScanDirectoryFiles(const char *basePath, FilePathList *list, const char *filter);   // Scan all files and directories in a base path
 static void ScanDirectoryFilesRecursively(const char *basePath, FilePathList *list, const char *filter);  // Scan all files and directories recursively from a base path
+#if defined(SUPPORT_SHADER_CACHE)
+static unsigned char *LoadShaderCacheData(unsigned long long key, int *dataSize);              // Load shader program binary (rlgl callback)
+static void SaveShaderCacheData(unsigned long long key, const unsigned char *data, int dataSize); // Save shader program binary (rlgl callback)
+#endif
 
 #if defined(SUPPORT_AUTOMATION_EVENTS)
 static void RecordAutomationEvent(void); // Record frame events (to internal events array)
 #endif
 
+#if defined(SUPPORT_FRAME_PROFILER)
+static void CommitProfilerFrame(void);  // Move the frame phase times into the profiler history
+static void DrawProfilerOverlay(void);  // Draw profiler overlay (to the current batch)
+#endif
+
+static void RestoreGraphicsState(void);                         // Load rlgl and default font data again on a new GL context (after a context loss)
+static void UpdateGpuTimers(void);                              // Close GPU timers of the frame, read back frames go to the profiler and the timeline
+
+#if defined(SUPPORT_TOUCH_HISTORY)
+static void AddTouchSample(int id, Vector2 position, double time, int action); // Add a touch sample to the history of a pointer (a down sample starts it again)
+#endif
+
+#if defined(SUPPORT_STARTUP_TIMELINE)
+static double GetTimelineClock(void);                           // Get monotonic clock time (seconds), valid before InitTimer()
+static void ResetTimeline(double origin, const char *name, bool resume); // Start a new timeline, with a first marker at its origin
+static int AddTimelineEvent(const char *name, double time, double duration); // Add a timeline event (absolute time), returns its index or -1
+static void UpdateTimelineFrame(void);                          // Mark the first frame and wait for its present time (after SwapScreenBuffer())
+#endif
+
+#if defined(SUPPORT_JOB_SYSTEM)
+static void InitJobSystem(void);                                // Start the job workers (one per big core left), the calling thread owns deque 0
+static void CloseJobSystem(void);                               // Stop the job workers, once every queued job ran
+static int GetJobCores(unsigned long *affinity);                // Get cores for jobs (calling thread included) and their mask, 0 for any core
+static void ScheduleJob(int slot);                              // Queue a job whose dependencies are done, waking a worker
+static int FindJob(int deque);                                  // Take a job: own deque, shared queue, then steal, returns its slot or -1
+static void RunJobSlot(int slot);                               // Run a job, then queue the dependents it was the last dependency of
+static void RunJobRanges(void *context);                        // Run ParallelFor() ranges until none are left (helper job)
+#endif
+
+static void *ArenaAlloc(MemoryArena *arena, size_t size);       // Allocate from the last block, chaining a new one when full
+static void RewindArena(MemoryArena *arena, ArenaBlock *block, size_t blockUsed, size_t used); // Free what was allocated after a block state
+static void ResetArena(MemoryArena *arena);                     // Free everything, keeping a single block as big as the peak
+static void CreateScratchKey(void);                             // Create the key freeing scratch arenas on thread exit
+static void FreeScratchMemory(void *memory);                    // Free a scratch arena (thread exit)
+static void ProcessMemoryTrim(void);                            // Run a requested memory trim (game thread)
+
+#if defined(SUPPORT_GIF_RECORDING)
+static void StartGifRecording(void);                            // Start recording, screen reads go to pixel buffers when supported
+static void StopGifRecording(bool save);                        // Encode every frame still in flight, then save the GIF (or drop it)
+static void CaptureGifFrame(int delay);                         // Start reading the screen into the next GIF frame
+static void UpdateGifCaptures(bool wait);                       // Queue the encoding of the screen reads done, in order
+static GifFrame *GetGifFrame(void);                             // Get the next frame buffer, waiting for its last encoding
+static void EncodeGifFrame(void *context);                      // Add a frame to the GIF (job)
+#endif
+
 #if defined(_WIN32) && !defined(PLATFORM_DESKTOP_RGFW)
 // NOTE: We declare Sleep() function symbol to avoid including windows.h (kernel32.lib linkage required)
 void __stdcall Sleep(unsigned long msTimeout);              // Required for: WaitTime()
@@ -666,14 +936,35 @@ void InitWindow(int width, int height, const char *title)
     CORE.Input.Mouse.cursor = MOUSE_CURSOR_ARROW;
     CORE.Input.Gamepad.lastButtonPressed = GAMEPAD_BUTTON_UNKNOWN;
 
+#if defined(SUPPORT_JOB_SYSTEM)
+    // Workers first, platform and assets loading may already run jobs
+    InitJobSystem();
+#endif
+    frameArenaThread = true;
+
     // Initialize platform
     //--------------------------------------------------------------
+#if defined(SUPPORT_STARTUP_TIMELINE)
+    BeginTimelineSection("InitPlatform");
+#endif
     InitPlatform();
+#if defined(SUPPORT_STARTUP_TIMELINE)
+    EndTimelineSection("InitPlatform");
+#endif
     //--------------------------------------------------------------
 
     // Initialize rlgl default data (buffers and shaders)
     // NOTE: CORE.Window.currentFbo.width and CORE.Window.currentFbo.height not used, just stored as globals in rlgl
+#if defined(SUPPORT_STARTUP_TIMELINE)
+    BeginTimelineSection("rlglInit");
+#endif
     rlglInit(CORE.Window.currentFbo.width, CORE.Window.currentFbo.height);
+#if defined(SUPPORT_STARTUP_TIMELINE)
+    EndTimelineSection("rlglInit");
+#endif
+#if defined(SUPPORT_FRAME_PROFILER) || defined(SUPPORT_STARTUP_TIMELINE)
+    rlEnableGpuTimer();         // GPU times of the frames go to the profiler and the timeline (UpdateGpuTimers())
+#endif
     isGpuReady = true; // Flag to note GPU has been initialized successfully
 
     // Setup default viewport
@@ -722,14 +1013,16 @@ void InitWindow(int width, int height, const char *title)
 void CloseWindow(void)
 {
 #if defined(SUPPORT_GIF_RECORDING)
-    if (gifRecording)
-    {
-        MsfGifResult result = msf_gif_end(&gifState);
-        msf_gif_free(result);
-        gifRecording = false;
-    }
+    if (gifRecording) StopGifRecording(false);
+#endif
+
+#if defined(SUPPORT_JOB_SYSTEM)
+    CloseJobSystem();           // Queued jobs still run, with everything loaded
 #endif
 
+    RewindArena(&frameArena, NULL, 0, 0);
+    frameArena.peak = 0;
+
 #if defined(SUPPORT_MODULE_RTEXT) && defined(SUPPORT_DEFAULT_FONT)
     UnloadFontDefault();        // WARNING: Module required: rtext
 #endif
@@ -751,6 +1044,14 @@ bool IsWindowReady(void)
     return CORE.Window.ready;
 }
 
+// Set GPU resources reload callback
+// NOTE: Called on the GL thread once the new context is current and rlgl initialized again,
+// every texture, shader and buffer id loaded before refers to nothing and must not be unloaded
+void SetContextRestoredCallback(ContextRestoredCallback callback)
+{
+    contextRestored = callback;
+}
+
 // Check if window is currently fullscreen
 bool IsWindowFullscreen(void)
 {
@@ -843,6 +1144,13 @@ void DisableEventWaiting(void)
     CORE.Window.eventWaiting = false;
 }
 
+// Set the longest wait for events with event waiting enabled
+// NOTE: A frame then still comes every 'seconds' without input (low redraw rate instead of none)
+void SetEventWaitingTimeout(double seconds)
+{
+    CORE.Window.eventWaitingTimeout = (seconds > 0.0)? seconds : 0.0;
+}
+
 // Check if cursor is not visible
 bool IsCursorHidden(void)
 {
@@ -876,6 +1184,14 @@ void BeginDrawing(void)
     CORE.Time.update = CORE.Time.current - CORE.Time.previous;
     CORE.Time.previous = CORE.Time.current;
 
+#if defined(SUPPORT_FRAME_PROFILER)
+    profiler.phaseStart[PROFILER_PHASE_BATCH] = CORE.Time.current;
+#endif
+#if defined(SUPPORT_STARTUP_TIMELINE)
+    if (!timeline.complete) timeline.frameStart = GetTimelineClock();
+#endif
+    rlBeginGpuScope("FRAME");           // GPU time of the frame, until EndDrawing() last flush
+
     rlLoadIdentity();                   // Reset current matrix (modelview)
     rlMultMatrixf(MatrixToFloat(CORE.Window.screenScale)); // Apply screen scaling
 
@@ -886,34 +1202,33 @@ void BeginDrawing(void)
 // End canvas drawing and swap buffers (double buffering)
 void EndDrawing(void)
 {
+#if defined(SUPPORT_FRAME_PROFILER)
+    EndProfilerPhase(PROFILER_PHASE_BATCH);
+    if (profiler.overlay) DrawProfilerOverlay();
+    BeginProfilerPhase(PROFILER_PHASE_RENDER);
+#endif
+
     rlDrawRenderBatchActive();      // Update and draw internal render batch
 
+#if defined(SUPPORT_FRAME_PROFILER)
+    EndProfilerPhase(PROFILER_PHASE_RENDER);
+#endif
+
 #if defined(SUPPORT_GIF_RECORDING)
     // Draw record indicator
     if (gifRecording)
     {
-        #ifndef GIF_RECORD_FRAMERATE
-        #define GIF_RECORD_FRAMERATE    10
-        #endif
         gifFrameCounter += (unsigned int)(GetFrameTime()*1000);
 
+        // Reads done since the last frames are encoded on the job workers
+        UpdateGifCaptures(false);
+
         // NOTE: We record one gif frame depending on the desired gif framerate
         if (gifFrameCounter > 1000/GIF_RECORD_FRAMERATE)
         {
-            // Get image data for the current frame (from backbuffer)
-            // NOTE: This process is quite slow... :(
-            Vector2 scale = GetWindowScaleDPI();
-            unsigned char *screenData = rlReadScreenPixels((int)((float)CORE.Window.render.width*scale.x), (int)((float)CORE.Window.render.height*scale.y));
-
-            #ifndef GIF_RECORD_BITRATE
-            #define GIF_RECORD_BITRATE 16
-            #endif
-
-            // Add the frame to the gif recording, given how many frames have passed in centiseconds
-            msf_gif_frame(&gifState, screenData, gifFrameCounter/10, GIF_RECORD_BITRATE, (int)((float)CORE.Window.render.width*scale.x)*4);
+            // Start reading the current frame (from backbuffer), given how many frames have passed in centiseconds
+            CaptureGifFrame(gifFrameCounter/10);
             gifFrameCounter -= 1000/GIF_RECORD_FRAMERATE;
-
-            RL_FREE(screenData);    // Free image data
         }
 
     #if defined(SUPPORT_MODULE_RSHAPES) && defined(SUPPORT_MODULE_RTEXT)
@@ -929,12 +1244,28 @@ void EndDrawing(void)
     }
 #endif
 
+    rlEndGpuScope();                // GPU time of BeginDrawing() up to here
+    UpdateGpuTimers();              // Close GPU timers of this frame, read back the ones done
+    rlCommitRenderBatchStats();     // Render batch counters of this frame are complete
+
 #if defined(SUPPORT_AUTOMATION_EVENTS)
     if (automationEventRecording) RecordAutomationEvent();    // Event recording
 #endif
 
 #if !defined(SUPPORT_CUSTOM_FRAME_CONTROL)
+#if defined(SUPPORT_FRAME_PROFILER)
+    BeginProfilerPhase(PROFILER_PHASE_SWAP);
+#endif
+#if defined(SUPPORT_STARTUP_TIMELINE) && defined(PLATFORM_ANDROID)
+    if (!timeline.complete && (timeline.frames == 0)) RequestFramePresentTime();   // First frame id, before its swap
+#endif
     SwapScreenBuffer();                  // Copy back buffer to front buffer (screen)
+#if defined(SUPPORT_FRAME_PROFILER)
+    EndProfilerPhase(PROFILER_PHASE_SWAP);
+#endif
+#if defined(SUPPORT_STARTUP_TIMELINE)
+    if (!timeline.complete) UpdateTimelineFrame();
+#endif
 
     // Frame time control system
     CORE.Time.current = GetTime();
@@ -946,16 +1277,36 @@ void EndDrawing(void)
     // Wait for some milliseconds...
     if (CORE.Time.frame < CORE.Time.target)
     {
+#if defined(PLATFORM_ANDROID) && defined(SUPPORT_ANDROID_FRAME_PACING)
+        // NOTE: On Android the frame waits for its vsync callback, timed wait only if not available
+        if (!WaitFramePacing(CORE.Time.target - CORE.Time.frame)) WaitTime(CORE.Time.target - CORE.Time.frame);
+#else
         WaitTime(CORE.Time.target - CORE.Time.frame);
+#endif
 
         CORE.Time.current = GetTime();
         double waitTime = CORE.Time.current - CORE.Time.previous;
         CORE.Time.previous = CORE.Time.current;
 
         CORE.Time.frame += waitTime;    // Total frame time: update + draw + wait
+
+#if defined(SUPPORT_FRAME_PROFILER)
+        profiler.frame[PROFILER_PHASE_WAIT] += waitTime;
+#endif
     }
 
+#if defined(SUPPORT_FRAME_PROFILER)
+    BeginProfilerPhase(PROFILER_PHASE_INPUT);
+#endif
     PollInputEvents();      // Poll user events (before next frame update)
+#if defined(SUPPORT_FRAME_PROFILER)
+    EndProfilerPhase(PROFILER_PHASE_INPUT);
+    profiler.frame[PROFILER_PHASE_FRAME] = CORE.Time.frame;
+#endif
+#endif
+
+#if defined(SUPPORT_FRAME_PROFILER)
+    CommitProfilerFrame();
 #endif
 
 #if defined(SUPPORT_SCREEN_CAPTURE)
@@ -964,28 +1315,8 @@ void EndDrawing(void)
 #if defined(SUPPORT_GIF_RECORDING)
         if (IsKeyDown(KEY_LEFT_CONTROL))
         {
-            if (gifRecording)
-            {
-                gifRecording = false;
-
-                MsfGifResult result = msf_gif_end(&gifState);
-
-                SaveFileData(TextFormat("%s/screenrec%03i.gif", CORE.Storage.basePath, screenshotCounter), result.data, (unsigned int)result.dataSize);
-                msf_gif_free(result);
-
-                TRACELOG(LOG_INFO, "SYSTEM: Finish animated GIF recording");
-            }
-            else
-            {
-                gifRecording = true;
-                gifFrameCounter = 0;
-
-                Vector2 scale = GetWindowScaleDPI();
-                msf_gif_begin(&gifState, (int)((float)CORE.Window.render.width*scale.x), (int)((float)CORE.Window.render.height*scale.y));
-                screenshotCounter++;
-
-                TRACELOG(LOG_INFO, "SYSTEM: Start animated GIF recording: %s", TextFormat("screenrec%03i.gif", screenshotCounter));
-            }
+            if (gifRecording) StopGifRecording(true);
+            else StartGifRecording();
         }
         else
 #endif  // SUPPORT_GIF_RECORDING
@@ -996,6 +1327,9 @@ void EndDrawing(void)
     }
 #endif  // SUPPORT_SCREEN_CAPTURE
 
+    ResetArena(&frameArena);        // Frame memory is freed
+    ProcessMemoryTrim();
+
     CORE.Time.frameCounter++;
 }
 
@@ -1081,6 +1415,7 @@ void BeginTextureMode(RenderTexture2D target)
     rlDrawRenderBatchActive();      // Update and draw internal render batch
 
     rlEnableFramebuffer(target.id); // Enable render target
+    rlBeginGpuScope("TEXTURE");     // GPU time of the pass, until EndTextureMode() last flush
 
     // Set viewport and RLGL internal framebuffer size
     rlViewport(0, 0, target.texture.width, target.texture.height);
@@ -1110,6 +1445,7 @@ void BeginTextureMode(RenderTexture2D target)
 void EndTextureMode(void)
 {
     rlDrawRenderBatchActive();      // Update and draw internal render batch
+    rlEndGpuScope();                // GPU time of the texture pass
 
     rlDisableFramebuffer();         // Disable render target (fbo)
 
@@ -1365,6 +1701,25 @@ Shader LoadShaderFromMemory(const char *vsCode, const char *fsCode)
     return shader;
 }
 
+// Set directory for linked shader program binaries
+// NOTE: Binaries are keyed by shader code and GL driver, files from an older driver are just never loaded again
+void SetShaderCacheDirectory(const char *dirPath)
+{
+#if defined(SUPPORT_SHADER_CACHE)
+    shaderCacheDir[0] = '\0';
+    rlSetShaderBinaryCallbacks(NULL, NULL);
+
+    if ((dirPath == NULL) || (dirPath[0] == '\0')) return;
+
+    if (strlen(dirPath) >= MAX_FILEPATH_LENGTH - 32) TRACELOG(LOG_WARNING, "SHADER: Shader cache directory path too long, cache disabled");
+    else
+    {
+        strcpy(shaderCacheDir, dirPath);
+        rlSetShaderBinaryCallbacks(LoadShaderCacheData, SaveShaderCacheData);
+    }
+#endif
+}
+
 // Check if a shader is valid (loaded on GPU)
 bool IsShaderValid(Shader shader)
 {
@@ -1699,2068 +2054,3302 @@ float GetFrameTime(void)
     return (float)CORE.Time.frame;
 }
 
-//----------------------------------------------------------------------------------
-// Module Functions Definition: Custom frame control
-//----------------------------------------------------------------------------------
-
-// NOTE: Functions with a platform-specific implementation on rcore_<platform>.c
-//void SwapScreenBuffer(void);
-//void PollInputEvents(void);
-
-// Wait for some time (stop program execution)
-// NOTE: Sleep() granularity could be around 10 ms, it means, Sleep() could
-// take longer than expected... for that reason we use the busy wait loop
-// Ref: http://stackoverflow.com/questions/43057578/c-programming-win32-games-sleep-taking-longer-than-expected
-// Ref: http://www.geisswerks.com/ryan/FAQS/timing.html --> All about timing on Win32!
-void WaitTime(double seconds)
+// Show/hide frame profiler overlay
+void SetProfilerOverlay(bool enabled)
 {
-    if (seconds < 0) return;    // Security check
-
-#if defined(SUPPORT_BUSY_WAIT_LOOP) || defined(SUPPORT_PARTIALBUSY_WAIT_LOOP)
-    double destinationTime = GetTime() + seconds;
+#if defined(SUPPORT_FRAME_PROFILER)
+    profiler.overlay = enabled;
 #endif
+}
 
-#if defined(SUPPORT_BUSY_WAIT_LOOP)
-    while (GetTime() < destinationTime) { }
+// Check if frame profiler overlay is shown
+bool IsProfilerOverlayEnabled(void)
+{
+#if defined(SUPPORT_FRAME_PROFILER)
+    return profiler.overlay;
 #else
-    #if defined(SUPPORT_PARTIALBUSY_WAIT_LOOP)
-        double sleepSeconds = seconds - seconds*0.05;  // NOTE: We reserve a percentage of the time for busy waiting
-    #else
-        double sleepSeconds = seconds;
-    #endif
-
-    // System halt functions
-    #if defined(_WIN32)
-        Sleep((unsigned long)(sleepSeconds*1000.0));
-    #endif
-    #if defined(__linux__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__EMSCRIPTEN__)
-        struct timespec req = { 0 };
-        time_t sec = sleepSeconds;
-        long nsec = (sleepSeconds - sec)*1000000000L;
-        req.tv_sec = sec;
-        req.tv_nsec = nsec;
-
-        // NOTE: Use nanosleep() on Unix platforms... usleep() it's deprecated
-        while (nanosleep(&req, &req) == -1) continue;
-    #endif
-    #if defined(__APPLE__)
-        usleep(sleepSeconds*1000000.0);
-    #endif
-
-    #if defined(SUPPORT_PARTIALBUSY_WAIT_LOOP)
-        while (GetTime() < destinationTime) { }
-    #endif
+    return false;
 #endif
 }
 
-//----------------------------------------------------------------------------------
-// Module Functions Definition: Misc
-//----------------------------------------------------------------------------------
-
-// NOTE: Functions with a platform-specific implementation on rcore_<platform>.c
-//void OpenURL(const char *url)
+// Begin timing an application phase
+void BeginProfilerPhase(int phase)
+{
+#if defined(SUPPORT_FRAME_PROFILER)
+    if ((phase >= 0) && (phase < PROFILER_PHASE_COUNT)) profiler.phaseStart[phase] = GetTime();
+#endif
+}
 
-// Set the seed for the random number generator
-void SetRandomSeed(unsigned int seed)
+// End timing an application phase
+// NOTE: A phase can be timed several times per frame, the times add up
+void EndProfilerPhase(int phase)
 {
-#if defined(SUPPORT_RPRAND_GENERATOR)
-    rprand_set_seed(seed);
-#else
-    srand(seed);
+#if defined(SUPPORT_FRAME_PROFILER)
+    if ((phase >= 0) && (phase < PROFILER_PHASE_COUNT)) profiler.frame[phase] += GetTime() - profiler.phaseStart[phase];
 #endif
 }
 
-// Get a random value between min and max included
-int GetRandomValue(int min, int max)
+// Get rolling stats for a frame phase (milliseconds)
+// NOTE: Percentiles are the upper bound of the histogram bin they fall in
+ProfilerStats GetProfilerStats(int phase)
 {
-    int value = 0;
+    ProfilerStats stats = { 0 };
 
-    if (min > max)
-    {
-        int tmp = max;
-        max = min;
-        min = tmp;
-    }
+#if defined(SUPPORT_FRAME_PROFILER)
+    if ((phase < 0) || (phase >= PROFILER_PHASE_COUNT) || (profiler.count == 0)) return stats;
 
-#if defined(SUPPORT_RPRAND_GENERATOR)
-    value = rprand_get_value(min, max);
-#else
-    // WARNING: Ranges higher than RAND_MAX will return invalid results
-    // More specifically, if (max - min) > INT_MAX there will be an overflow,
-    // and otherwise if (max - min) > RAND_MAX the random value will incorrectly never exceed a certain threshold
-    // NOTE: Depending on the library it can be as low as 32767
-    if ((unsigned int)(max - min) > (unsigned int)RAND_MAX)
+    const unsigned short *histogram = profiler.histogram[phase];
+    int ranks[3] = { (profiler.count*50 + 99)/100, (profiler.count*95 + 99)/100, (profiler.count*99 + 99)/100 };
+    float *results[3] = { &stats.p50, &stats.p95, &stats.p99 };
+    int cumulative = 0, next = 0;
+
+    for (int bin = 0; (bin < FRAME_PROFILER_BINS) && (next < 3); bin++)
     {
-        TRACELOG(LOG_WARNING, "Invalid GetRandomValue() arguments, range should not be higher than %i", RAND_MAX);
+        cumulative += histogram[bin];
+        while ((next < 3) && (cumulative >= ranks[next])) *results[next++] = (float)(PROFILER_MIN_TIME*pow(2.0, (double)bin/PROFILER_BINS_PER_OCTAVE));
     }
 
-    value = (rand()%(abs(max - min) + 1) + min);
+    for (int i = 0; i < profiler.count; i++) stats.max = fmaxf(stats.max, profiler.history[phase][i]);
+    stats.last = profiler.history[phase][(profiler.head + FRAME_PROFILER_HISTORY - 1)%FRAME_PROFILER_HISTORY];
+    stats.samples = profiler.count;
 #endif
-    return value;
+
+    return stats;
 }
 
-// Load random values sequence, no values repeated, min and max included
-int *LoadRandomSequence(unsigned int count, int min, int max)
+// Begin a timeline section
+// NOTE: Sections nest per thread (ATrace rule), end them in reverse order
+void BeginTimelineSection(const char *name)
 {
-    int *values = NULL;
-
-#if defined(SUPPORT_RPRAND_GENERATOR)
-    values = rprand_load_sequence(count, min, max);
-#else
-    if (count > ((unsigned int)abs(max - min) + 1)) return values;  // Security check
+#if defined(SUPPORT_STARTUP_TIMELINE)
+#if defined(PLATFORM_ANDROID)
+    ATrace_beginSection(name);
+#endif
+    AddTimelineEvent(name, GetTimelineClock(), -1.0);
+#endif
+}
 
-    values = (int *)RL_CALLOC(count, sizeof(int));
+// End the last open timeline section with that name
+void EndTimelineSection(const char *name)
+{
+#if defined(SUPPORT_STARTUP_TIMELINE)
+    double time = GetTimelineClock();
 
-    int value = 0;
-    bool dupValue = false;
+#if defined(PLATFORM_ANDROID)
+    ATrace_endSection();
+#endif
 
-    for (int i = 0; i < (int)count;)
+    pthread_mutex_lock(&timelineMutex);
+    for (int i = timeline.count - 1; i >= 0; i--)
     {
-        value = (rand()%(abs(max - min) + 1) + min);
-        dupValue = false;
+        TimelineEvent *event = &timeline.events[i];
 
-        for (int j = 0; j < i; j++)
-        {
-            if (values[j] == value)
-            {
-                dupValue = true;
-                break;
-            }
-        }
-
-        if (!dupValue)
+        if ((event->duration < 0.0) && (strncmp(event->name, name, sizeof(event->name) - 1) == 0))
         {
-            values[i] = value;
-            i++;
+            event->duration = (time - timeline.origin) - event->start;
+            break;
         }
     }
+    pthread_mutex_unlock(&timelineMutex);
 #endif
-    return values;
 }
 
-// Unload random values sequence
-void UnloadRandomSequence(int *sequence)
+// Add a timeline marker
+void MarkTimelineEvent(const char *name)
 {
-#if defined(SUPPORT_RPRAND_GENERATOR)
-    rprand_unload_sequence(sequence);
-#else
-    RL_FREE(sequence);
+#if defined(SUPPORT_STARTUP_TIMELINE)
+#if defined(PLATFORM_ANDROID)
+    // NOTE: ATrace has no instant events before API level 29, markers are empty sections
+    ATrace_beginSection(name);
+    ATrace_endSection();
+#endif
+    AddTimelineEvent(name, GetTimelineClock(), 0.0);
 #endif
 }
 
-// Takes a screenshot of current screen
-// NOTE: Provided fileName should not contain paths, saving to working directory
-void TakeScreenshot(const char *fileName)
+// Get a copy of the timeline events
+int GetTimelineEvents(TimelineEvent *events, int capacity)
 {
-#if defined(SUPPORT_MODULE_RTEXTURES)
-    // Security check to (partially) avoid malicious code
-    if (strchr(fileName, '\'') != NULL) { TRACELOG(LOG_WARNING, "SYSTEM: Provided fileName could be potentially malicious, avoid [\'] character"); return; }
-
-    Vector2 scale = GetWindowScaleDPI();
-    unsigned char *imgData = rlReadScreenPixels((int)((float)CORE.Window.render.width*scale.x), (int)((float)CORE.Window.render.height*scale.y));
-    Image image = { imgData, (int)((float)CORE.Window.render.width*scale.x), (int)((float)CORE.Window.render.height*scale.y), 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    int count = 0;
 
-    char path[512] = { 0 };
-    strcpy(path, TextFormat("%s/%s", CORE.Storage.basePath, GetFileName(fileName)));
+#if defined(SUPPORT_STARTUP_TIMELINE)
+    pthread_mutex_lock(&timelineMutex);
+    count = (timeline.count < capacity)? timeline.count : capacity;
+    if ((events != NULL) && (count > 0)) memcpy(events, timeline.events, count*sizeof(TimelineEvent));
+    pthread_mutex_unlock(&timelineMutex);
+#endif
 
-    ExportImage(image, path);           // WARNING: Module required: rtextures
-    RL_FREE(imgData);
+    return count;
+}
 
-    if (FileExists(path)) TRACELOG(LOG_INFO, "SYSTEM: [%s] Screenshot taken successfully", path);
-    else TRACELOG(LOG_WARNING, "SYSTEM: [%s] Screenshot could not be saved", path);
+// Check if the first frame was presented
+bool IsTimelineComplete(void)
+{
+#if defined(SUPPORT_STARTUP_TIMELINE)
+    return timeline.complete;
 #else
-    TRACELOG(LOG_WARNING,"IMAGE: ExportImage() requires module: rtextures");
+    return false;
 #endif
 }
 
-// Setup window configuration flags (view FLAGS)
-// NOTE: This function is expected to be called before window creation,
-// because it sets up some flags for the window creation process
-// To configure window states after creation, just use SetWindowState()
-void SetConfigFlags(unsigned int flags)
-{
-    // Selected flags are set but not evaluated at this point,
-    // flag evaluation happens at InitWindow() or SetWindowState()
-    CORE.Window.flags |= flags;
-}
-
 //----------------------------------------------------------------------------------
-// Module Functions Definition: File system
+// Module Functions Definition: Job System
 //----------------------------------------------------------------------------------
 
-// Check if the file exists
-bool FileExists(const char *fileName)
-{
-    bool result = false;
-
-#if defined(_WIN32)
-    if (_access(fileName, 0) != -1) result = true;
-#else
-    if (access(fileName, F_OK) != -1) result = true;
-#endif
-
-    // NOTE: Alternatively, stat() can be used instead of access()
-    //#include <sys/stat.h>
-    //struct stat statbuf;
-    //if (stat(filename, &statbuf) == 0) result = true;
-
-    return result;
-}
-
-// Check file extension
-// NOTE: Extensions checking is not case-sensitive
-bool IsFileExtension(const char *fileName, const char *ext)
+// Queue a job run once its dependencies are done
+// NOTE: Without workers or with a full pool, the dependencies are waited for and the job runs right away
+unsigned int RunJob(JobCallback job, void *context, const unsigned int *dependencies, int dependencyCount)
 {
-    #define MAX_FILE_EXTENSION_LENGTH  16
-
-    bool result = false;
-    const char *fileExt = GetFileExtension(fileName);
-
-    if (fileExt != NULL)
+#if defined(SUPPORT_JOB_SYSTEM)
+    if (jobSystem.workerCount > 0)
     {
-#if defined(SUPPORT_MODULE_RTEXT) && defined(SUPPORT_TEXT_MANIPULATION)
-        int extCount = 0;
-        const char **checkExts = TextSplit(ext, ';', &extCount); // WARNING: Module required: rtext
-
-        char fileExtLower[MAX_FILE_EXTENSION_LENGTH + 1] = { 0 };
-        strncpy(fileExtLower, TextToLower(fileExt), MAX_FILE_EXTENSION_LENGTH); // WARNING: Module required: rtext
-
-        for (int i = 0; i < extCount; i++)
+        int slot = -1;
+        for (int i = 0; i < MAX_JOBS; i++)
         {
-            if (strcmp(fileExtLower, TextToLower(checkExts[i])) == 0)
+            int index = (int)(__atomic_fetch_add(&jobSystem.nextSlot, 1, __ATOMIC_RELAXED) & (MAX_JOBS - 1));
+            int expected = 0;
+
+            if (__atomic_compare_exchange_n(&jobSystem.slots[index].used, &expected, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
             {
-                result = true;
+                slot = index;
                 break;
             }
         }
-#else
-        if (strcmp(fileExt, ext) == 0) result = true;
-#endif
-    }
 
-    return result;
-}
-
-// Check if a directory path exists
-bool DirectoryExists(const char *dirPath)
-{
-    bool result = false;
-    DIR *dir = opendir(dirPath);
-
-    if (dir != NULL)
-    {
-        result = true;
-        closedir(dir);
-    }
+        if (slot >= 0)
+        {
+            JobSlot *entry = &jobSystem.slots[slot];
+            entry->callback = job;
+            entry->context = context;
+            entry->pending = 1;
+            unsigned int handle = entry->handle;
 
-    return result;
-}
+            for (int i = 0; i < dependencyCount; i++)
+            {
+                unsigned int dependency = dependencies[i];
+                if (dependency == 0) continue;
 
-// Get file length in bytes
-// NOTE: GetFileSize() conflicts with windows.h
-int GetFileLength(const char *fileName)
-{
-    int size = 0;
+                JobSlot *waited = &jobSystem.slots[dependency & (MAX_JOBS - 1)];
+                bool done = false;
+                bool added = false;
 
-    // NOTE: On Unix-like systems, it can by used the POSIX system call: stat(),
-    // but depending on the platform that call could not be available
-    //struct stat result = { 0 };
-    //stat(fileName, &result);
-    //return result.st_size;
+                while (__atomic_exchange_n(&waited->lock, 1, __ATOMIC_ACQUIRE)) { }
+                if (waited->handle != dependency) done = true;
+                else if (waited->dependentCount < MAX_JOB_DEPENDENTS)
+                {
+                    waited->dependents[waited->dependentCount++] = slot;
+                    __atomic_add_fetch(&entry->pending, 1, __ATOMIC_ACQ_REL);
+                    added = true;
+                }
+                __atomic_store_n(&waited->lock, 0, __ATOMIC_RELEASE);
 
-    FILE *file = fopen(fileName, "rb");
+                // NOTE: A job with too many dependents already is waited for here
+                if (!done && !added) WaitJob(dependency);
+            }
 
-    if (file != NULL)
-    {
-        fseek(file, 0L, SEEK_END);
-        long int fileSize = ftell(file);
+            if (__atomic_sub_fetch(&entry->pending, 1, __ATOMIC_ACQ_REL) == 0) ScheduleJob(slot);
 
-        // Check for size overflow (INT_MAX)
-        if (fileSize > 2147483647) TRACELOG(LOG_WARNING, "[%s] File size overflows expected limit, do not use GetFileLength()", fileName);
-        else size = (int)fileSize;
+            return handle;
+        }
 
-        fclose(file);
+        // NOTE: Only logged once, a burst of jobs would flood the log
+        static bool poolFullLogged = false;
+        if (!poolFullLogged) TRACELOG(LOG_WARNING, "JOBS: Job pool full (MAX_JOBS: %i), jobs run right away", MAX_JOBS);
+        poolFullLogged = true;
     }
+#endif
 
-    return size;
+    for (int i = 0; i < dependencyCount; i++) WaitJob(dependencies[i]);
+    job(context);
+
+    return 0;
 }
 
-// Get pointer to extension for a filename string (includes the dot: .png)
-const char *GetFileExtension(const char *fileName)
+// Wait for a job to be done
+// NOTE: The waiting thread runs queued jobs meanwhile, a job can wait for another one
+void WaitJob(unsigned int job)
 {
-    const char *dot = strrchr(fileName, '.');
-
-    if (!dot || dot == fileName) return NULL;
+#if defined(SUPPORT_JOB_SYSTEM)
+    while (!IsJobDone(job))
+    {
+        int slot = FindJob(jobDeque);
 
-    return dot;
+        if (slot >= 0) RunJobSlot(slot);
+        else sched_yield();
+    }
+#endif
 }
 
-// String pointer reverse break: returns right-most occurrence of charset in s
-static const char *strprbrk(const char *s, const char *charset)
+// Check if a job is done
+bool IsJobDone(unsigned int job)
 {
-    const char *latestMatch = NULL;
-
-    for (; s = strpbrk(s, charset), s != NULL; latestMatch = s++) { }
+#if defined(SUPPORT_JOB_SYSTEM)
+    if (job == 0) return true;
 
-    return latestMatch;
+    return (__atomic_load_n(&jobSystem.slots[job & (MAX_JOBS - 1)].handle, __ATOMIC_ACQUIRE) != job);
+#else
+    return true;
+#endif
 }
 
-// Get pointer to filename for a path string
-const char *GetFileName(const char *filePath)
+// Run a function over the items [0, count), 'grain' items at a time
+// NOTE: One helper job per worker takes ranges in turn with the calling thread, uneven ranges balance out
+void ParallelFor(int count, int grain, JobRangeCallback job, void *context)
 {
-    const char *fileName = NULL;
+    if (count <= 0) return;
+    if (grain < 1) grain = 1;
 
-    if (filePath != NULL) fileName = strprbrk(filePath, "\\/");
+    JobRange range = { job, context, count, grain, 0 };
 
-    if (fileName == NULL) return filePath;
+#if defined(SUPPORT_JOB_SYSTEM)
+    unsigned int helpers[MAX_JOB_WORKERS] = { 0 };
+    int rangeCount = (int)(((long long)count + grain - 1)/grain);
+    int helperCount = (jobSystem.workerCount < rangeCount - 1)? jobSystem.workerCount : rangeCount - 1;
 
-    return fileName + 1;
+    for (int i = 0; i < helperCount; i++) helpers[i] = RunJob(RunJobRanges, &range, NULL, 0);
+    RunJobRanges(&range);
+    for (int i = 0; i < helperCount; i++) WaitJob(helpers[i]);
+#else
+    job(context, 0, count);
+    (void)range;
+#endif
 }
 
-// Get filename string without extension (uses static string)
-const char *GetFileNameWithoutExt(const char *filePath)
+// Get job worker threads count
+int GetJobWorkerCount(void)
 {
-    #define MAX_FILENAME_LENGTH     256
-
-    static char fileName[MAX_FILENAME_LENGTH] = { 0 };
-    memset(fileName, 0, MAX_FILENAME_LENGTH);
-
-    if (filePath != NULL)
-    {
-        strcpy(fileName, GetFileName(filePath)); // Get filename.ext without path
-        int size = (int)strlen(fileName); // Get size in bytes
+#if defined(SUPPORT_JOB_SYSTEM)
+    return jobSystem.workerCount;
+#else
+    return 0;
+#endif
+}
 
-        for (int i = size; i > 0; i--) // Reverse search '.'
-        {
-            if (fileName[i] == '.')
-            {
-                // NOTE: We break on first '.' found
-                fileName[i] = '\0';
-                break;
-            }
-        }
-    }
+//----------------------------------------------------------------------------------
+// Module Functions Definition: Memory Arenas
+//----------------------------------------------------------------------------------
 
-    return fileName;
+// Frame memory allocator, freed all at once by EndDrawing()
+// NOTE: Returns NULL out of the InitWindow() thread (or without SUPPORT_MEMORY_ARENAS), memory is not cleared
+void *MemAllocFrame(unsigned int size)
+{
+#if defined(SUPPORT_MEMORY_ARENAS)
+    if (frameArenaThread) return ArenaAlloc(&frameArena, size);
+#endif
+    return NULL;
 }
 
-// Get directory for a given filePath
-const char *GetDirectoryPath(const char *filePath)
+// Begin a scratch memory scope on the calling thread
+void BeginScratchMemory(void)
 {
-    /*
-    // NOTE: Directory separator is different in Windows and other platforms,
-    // fortunately, Windows also support the '/' separator, that's the one should be used
-    #if defined(_WIN32)
-        char separator = '\\';
-    #else
-        char separator = '/';
-    #endif
-    */
-    const char *lastSlash = NULL;
-    static char dirPath[MAX_FILEPATH_LENGTH] = { 0 };
-    memset(dirPath, 0, MAX_FILEPATH_LENGTH);
+    ScratchMemory *scratch = &scratchMemory;
 
-    // In case provided path does not contain a root drive letter (C:\, D:\) nor leading path separator (\, /),
-    // we add the current directory path to dirPath
-    if (filePath[1] != ':' && filePath[0] != '\\' && filePath[0] != '/')
+    if (!scratch->registered)
     {
-        // For security, we set starting path to current directory,
-        // obtained path will be concatenated to this
-        dirPath[0] = '.';
-        dirPath[1] = '/';
+        pthread_once(&scratchKeyOnce, CreateScratchKey);
+        pthread_setspecific(scratchKey, scratch);
+        scratch->registered = true;
     }
 
-    lastSlash = strprbrk(filePath, "\\/");
-    if (lastSlash)
+    if (scratch->depth < MAX_SCRATCH_SCOPES)
     {
-        if (lastSlash == filePath)
-        {
-            // The last and only slash is the leading one: path is in a root directory
-            dirPath[0] = filePath[0];
-            dirPath[1] = '\0';
-        }
-        else
-        {
-            // NOTE: Be careful, strncpy() is not safe, it does not care about '\0'
-            char *dirPathPtr = dirPath;
-            if ((filePath[1] != ':') && (filePath[0] != '\\') && (filePath[0] != '/')) dirPathPtr += 2;     // Skip drive letter, "C:"
-            memcpy(dirPathPtr, filePath, strlen(filePath) - (strlen(lastSlash) - 1));
-            dirPath[strlen(filePath) - strlen(lastSlash) + (((filePath[1] != ':') && (filePath[0] != '\\') && (filePath[0] != '/'))? 2 : 0)] = '\0';  // Add '\0' manually
-        }
+        ArenaMark *mark = &scratch->scopes[scratch->depth];
+        mark->block = scratch->arena.block;
+        mark->blockUsed = (mark->block != NULL)? mark->block->used : 0;
+        mark->used = scratch->arena.used;
     }
+    else if (scratch->depth == MAX_SCRATCH_SCOPES) TRACELOG(LOG_WARNING, "MEMORY: More than %i scratch scopes, inner ones are freed with the last", MAX_SCRATCH_SCOPES);
 
-    return dirPath;
+    scratch->depth++;
 }
 
-// Get previous directory path for a given path
-const char *GetPrevDirectoryPath(const char *dirPath)
+// Scratch memory allocator, freed by the EndScratchMemory() of the scope
+// NOTE: Memory is not cleared, NULL out of a scope
+void *MemAllocScratch(unsigned int size)
 {
-    static char prevDirPath[MAX_FILEPATH_LENGTH] = { 0 };
-    memset(prevDirPath, 0, MAX_FILEPATH_LENGTH);
-    int pathLen = (int)strlen(dirPath);
-
-    if (pathLen <= 3) strcpy(prevDirPath, dirPath);
-
-    for (int i = (pathLen - 1); (i >= 0) && (pathLen > 3); i--)
+    if (scratchMemory.depth == 0)
     {
-        if ((dirPath[i] == '\\') || (dirPath[i] == '/'))
-        {
-            // Check for root: "C:\" or "/"
-            if (((i == 2) && (dirPath[1] ==':')) || (i == 0)) i++;
-
-            strncpy(prevDirPath, dirPath, i);
-            break;
-        }
+        TRACELOG(LOG_WARNING, "MEMORY: Scratch memory allocated out of BeginScratchMemory()/EndScratchMemory()");
+        return NULL;
     }
 
-    return prevDirPath;
+    return ArenaAlloc(&scratchMemory.arena, size);
 }
 
-// Get current working directory
-const char *GetWorkingDirectory(void)
+// End a scratch memory scope, freeing what it allocated
+void EndScratchMemory(void)
 {
-    static char currentDir[MAX_FILEPATH_LENGTH] = { 0 };
-    memset(currentDir, 0, MAX_FILEPATH_LENGTH);
+    ScratchMemory *scratch = &scratchMemory;
+    if (scratch->depth == 0) return;
 
-    char *path = GETCWD(currentDir, MAX_FILEPATH_LENGTH - 1);
+    scratch->depth--;
+    if (scratch->depth == 0) ResetArena(&scratch->arena);
+    else if (scratch->depth < MAX_SCRATCH_SCOPES)
+    {
+        ArenaMark *mark = &scratch->scopes[scratch->depth];
+        RewindArena(&scratch->arena, mark->block, mark->blockUsed, mark->used);
+    }
+}
 
-    return path;
+//----------------------------------------------------------------------------------
+// Module Functions Definition: Memory Tracking
+//----------------------------------------------------------------------------------
+// NOTE: GetMemoryStats() and the tracked allocators are defined in utils.c
+
+// Set a callback freeing application caches when memory runs low
+// NOTE: Called on the game thread (EndDrawing() or events polling) with the level of Android onTrimMemory()
+void SetMemoryTrimCallback(MemoryTrimCallback callback)
+{
+    memoryTrim = callback;
 }
 
-const char *GetApplicationDirectory(void)
+// Ask for a memory trim, from any thread (i.e. Java onTrimMemory())
+// NOTE: Requests before the trim runs are merged, keeping the highest level
+void RequestMemoryTrim(int level)
 {
-    static char appDir[MAX_FILEPATH_LENGTH] = { 0 };
-    memset(appDir, 0, MAX_FILEPATH_LENGTH);
+    if (level <= 0) return;
 
-#if defined(_WIN32)
-    int len = 0;
-#if defined(UNICODE)
-    unsigned short widePath[MAX_PATH];
-    len = GetModuleFileNameW(NULL, widePath, MAX_PATH);
-    len = WideCharToMultiByte(0, 0, widePath, len, appDir, MAX_PATH, NULL, NULL);
-#else
-    len = GetModuleFileNameA(NULL, appDir, MAX_PATH);
+    int current = __atomic_load_n(&memoryTrimLevel, __ATOMIC_RELAXED);
+    while ((level > current) && !__atomic_compare_exchange_n(&memoryTrimLevel, &current, level, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) { }
+
+#if defined(PLATFORM_ANDROID)
+    // A paused game thread waits for events, the trim runs once it is woken up
+    if (platform.app != NULL) ALooper_wake(platform.app->looper);
 #endif
-    if (len > 0)
-    {
-        for (int i = len; i >= 0; --i)
-        {
-            if (appDir[i] == '\\')
-            {
-                appDir[i + 1] = '\0';
-                break;
-            }
-        }
-    }
-    else
-    {
-        appDir[0] = '.';
-        appDir[1] = '\\';
-    }
+}
 
-#elif defined(__linux__)
-    unsigned int size = sizeof(appDir);
-    ssize_t len = readlink("/proc/self/exe", appDir, size);
+//----------------------------------------------------------------------------------
+// Module Functions Definition: Custom frame control
+//----------------------------------------------------------------------------------
 
-    if (len > 0)
-    {
-        for (int i = len; i >= 0; --i)
-        {
-            if (appDir[i] == '/')
+// NOTE: Functions with a platform-specific implementation on rcore_<platform>.c
+//void SwapScreenBuffer(void);
+//void PollInputEvents(void);
+
+// Wait for some time (stop program execution)
+// NOTE: Sleep() granularity could be around 10 ms, it means, Sleep() could
+// take longer than expected... for that reason we use the busy wait loop
+// Ref: http://stackoverflow.com/questions/43057578/c-programming-win32-games-sleep-taking-longer-than-expected
+// Ref: http://www.geisswerks.com/ryan/FAQS/timing.html --> All about timing on Win32!
+void WaitTime(double seconds)
+{
+    if (seconds < 0) return;    // Security check
+
+#if defined(SUPPORT_BUSY_WAIT_LOOP) || defined(SUPPORT_PARTIALBUSY_WAIT_LOOP)
+    double destinationTime = GetTime() + seconds;
+#endif
+
+#if defined(SUPPORT_BUSY_WAIT_LOOP)
+    while (GetTime() < destinationTime) { }
+#else
+    #if defined(SUPPORT_PARTIALBUSY_WAIT_LOOP)
+        double sleepSeconds = seconds - seconds*0.05;  // NOTE: We reserve a percentage of the time for busy waiting
+    #else
+        double sleepSeconds = seconds;
+    #endif
+
+    // System halt functions
+    #if defined(_WIN32)
+        Sleep((unsigned long)(sleepSeconds*1000.0));
+    #endif
+    #if defined(__linux__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__EMSCRIPTEN__)
+        struct timespec req = { 0 };
+        time_t sec = sleepSeconds;
+        long nsec = (sleepSeconds - sec)*1000000000L;
+        req.tv_sec = sec;
+        req.tv_nsec = nsec;
+
+        // NOTE: Use nanosleep() on Unix platforms... usleep() it's deprecated
+        while (nanosleep(&req, &req) == -1) continue;
+    #endif
+    #if defined(__APPLE__)
+        usleep(sleepSeconds*1000000.0);
+    #endif
+
+    #if defined(SUPPORT_PARTIALBUSY_WAIT_LOOP)
+        while (GetTime() < destinationTime) { }
+    #endif
+#endif
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition: Misc
+//----------------------------------------------------------------------------------
+
+// NOTE: Functions with a platform-specific implementation on rcore_<platform>.c
+//void OpenURL(const char *url)
+
+// Set the seed for the random number generator
+void SetRandomSeed(unsigned int seed)
+{
+#if defined(SUPPORT_RPRAND_GENERATOR)
+    rprand_set_seed(seed);
+#else
+    srand(seed);
+#endif
+}
+
+// Get a random value between min and max included
+int GetRandomValue(int min, int max)
+{
+    int value = 0;
+
+    if (min > max)
+    {
+        int tmp = max;
+        max = min;
+        min = tmp;
+    }
+
+#if defined(SUPPORT_RPRAND_GENERATOR)
+    value = rprand_get_value(min, max);
+#else
+    // WARNING: Ranges higher than RAND_MAX will return invalid results
+    // More specifically, if (max - min) > INT_MAX there will be an overflow,
+    // and otherwise if (max - min) > RAND_MAX the random value will incorrectly never exceed a certain threshold
+    // NOTE: Depending on the library it can be as low as 32767
+    if ((unsigned int)(max - min) > (unsigned int)RAND_MAX)
+    {
+        TRACELOG(LOG_WARNING, "Invalid GetRandomValue() arguments, range should not be higher than %i", RAND_MAX);
+    }
+
+    value = (rand()%(abs(max - min) + 1) + min);
+#endif
+    return value;
+}
+
+// Load random values sequence, no values repeated, min and max included
+int *LoadRandomSequence(unsigned int count, int min, int max)
+{
+    int *values = NULL;
+
+#if defined(SUPPORT_RPRAND_GENERATOR)
+    values = rprand_load_sequence(count, min, max);
+#else
+    if (count > ((unsigned int)abs(max - min) + 1)) return values;  // Security check
+
+    values = (int *)RL_CALLOC(count, sizeof(int));
+
+    int value = 0;
+    bool dupValue = false;
+
+    for (int i = 0; i < (int)count;)
+    {
+        value = (rand()%(abs(max - min) + 1) + min);
+        dupValue = false;
+
+        for (int j = 0; j < i; j++)
+        {
+            if (values[j] == value)
             {
-                appDir[i + 1] = '\0';
+                dupValue = true;
                 break;
             }
         }
+
+        if (!dupValue)
+        {
+            values[i] = value;
+            i++;
+        }
     }
-    else
-    {
-        appDir[0] = '.';
-        appDir[1] = '/';
-    }
-#elif defined(__APPLE__)
-    uint32_t size = sizeof(appDir);
+#endif
+    return values;
+}
 
-    if (_NSGetExecutablePath(appDir, &size) == 0)
+// Unload random values sequence
+void UnloadRandomSequence(int *sequence)
+{
+#if defined(SUPPORT_RPRAND_GENERATOR)
+    rprand_unload_sequence(sequence);
+#else
+    RL_FREE(sequence);
+#endif
+}
+
+// Takes a screenshot of current screen
+// NOTE: Provided fileName should not contain paths, saving to working directory
+void TakeScreenshot(const char *fileName)
+{
+#if defined(SUPPORT_MODULE_RTEXTURES)
+    // Security check to (partially) avoid malicious code
+    if (strchr(fileName, '\'') != NULL) { TRACELOG(LOG_WARNING, "SYSTEM: Provided fileName could be potentially malicious, avoid [\'] character"); return; }
+
+    Vector2 scale = GetWindowScaleDPI();
+    unsigned char *imgData = rlReadScreenPixels((int)((float)CORE.Window.render.width*scale.x), (int)((float)CORE.Window.render.height*scale.y));
+    Image image = { imgData, (int)((float)CORE.Window.render.width*scale.x), (int)((float)CORE.Window.render.height*scale.y), 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+
+    char path[512] = { 0 };
+    strcpy(path, TextFormat("%s/%s", CORE.Storage.basePath, GetFileName(fileName)));
+
+    ExportImage(image, path);           // WARNING: Module required: rtextures
+    RL_FREE(imgData);
+
+    if (FileExists(path)) TRACELOG(LOG_INFO, "SYSTEM: [%s] Screenshot taken successfully", path);
+    else TRACELOG(LOG_WARNING, "SYSTEM: [%s] Screenshot could not be saved", path);
+#else
+    TRACELOG(LOG_WARNING,"IMAGE: ExportImage() requires module: rtextures");
+#endif
+}
+
+// Setup window configuration flags (view FLAGS)
+// NOTE: This function is expected to be called before window creation,
+// because it sets up some flags for the window creation process
+// To configure window states after creation, just use SetWindowState()
+void SetConfigFlags(unsigned int flags)
+{
+    // Selected flags are set but not evaluated at this point,
+    // flag evaluation happens at InitWindow() or SetWindowState()
+    CORE.Window.flags |= flags;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition: File system
+//----------------------------------------------------------------------------------
+
+// Check if the file exists
+bool FileExists(const char *fileName)
+{
+    bool result = false;
+
+#if defined(_WIN32)
+    if (_access(fileName, 0) != -1) result = true;
+#else
+    if (access(fileName, F_OK) != -1) result = true;
+#endif
+
+    // NOTE: Alternatively, stat() can be used instead of access()
+    //#include <sys/stat.h>
+    //struct stat statbuf;
+    //if (stat(filename, &statbuf) == 0) result = true;
+
+    return result;
+}
+
+// Check file extension
+// NOTE: Extensions checking is not case-sensitive
+bool IsFileExtension(const char *fileName, const char *ext)
+{
+    #define MAX_FILE_EXTENSION_LENGTH  16
+
+    bool result = false;
+    const char *fileExt = GetFileExtension(fileName);
+
+    if (fileExt != NULL)
     {
-        int len = strlen(appDir);
-        for (int i = len; i >= 0; --i)
+#if defined(SUPPORT_MODULE_RTEXT) && defined(SUPPORT_TEXT_MANIPULATION)
+        int extCount = 0;
+        const char **checkExts = TextSplit(ext, ';', &extCount); // WARNING: Module required: rtext
+
+        char fileExtLower[MAX_FILE_EXTENSION_LENGTH + 1] = { 0 };
+        strncpy(fileExtLower, TextToLower(fileExt), MAX_FILE_EXTENSION_LENGTH); // WARNING: Module required: rtext
+
+        for (int i = 0; i < extCount; i++)
         {
-            if (appDir[i] == '/')
+            if (strcmp(fileExtLower, TextToLower(checkExts[i])) == 0)
             {
-                appDir[i + 1] = '\0';
+                result = true;
                 break;
             }
         }
+#else
+        if (strcmp(fileExt, ext) == 0) result = true;
+#endif
     }
-    else
+
+    return result;
+}
+
+// Check if a directory path exists
+bool DirectoryExists(const char *dirPath)
+{
+    bool result = false;
+    DIR *dir = opendir(dirPath);
+
+    if (dir != NULL)
     {
-        appDir[0] = '.';
-        appDir[1] = '/';
+        result = true;
+        closedir(dir);
     }
-#elif defined(__FreeBSD__)
-    size_t size = sizeof(appDir);
-    int mib[4] = {CTL_KERN, KERN_PROC, KERN_PROC_PATHNAME, -1};
 
-    if (sysctl(mib, 4, appDir, &size, NULL, 0) == 0)
-    {
-        int len = strlen(appDir);
-        for (int i = len; i >= 0; --i)
+    return result;
+}
+
+// Get file length in bytes
+// NOTE: GetFileSize() conflicts with windows.h
+int GetFileLength(const char *fileName)
+{
+    int size = 0;
+
+    // NOTE: On Unix-like systems, it can by used the POSIX system call: stat(),
+    // but depending on the platform that call could not be available
+    //struct stat result = { 0 };
+    //stat(fileName, &result);
+    //return result.st_size;
+
+    FILE *file = fopen(fileName, "rb");
+
+    if (file != NULL)
+    {
+        fseek(file, 0L, SEEK_END);
+        long int fileSize = ftell(file);
+
+        // Check for size overflow (INT_MAX)
+        if (fileSize > 2147483647) TRACELOG(LOG_WARNING, "[%s] File size overflows expected limit, do not use GetFileLength()", fileName);
+        else size = (int)fileSize;
+
+        fclose(file);
+    }
+
+    return size;
+}
+
+// Get pointer to extension for a filename string (includes the dot: .png)
+const char *GetFileExtension(const char *fileName)
+{
+    const char *dot = strrchr(fileName, '.');
+
+    if (!dot || dot == fileName) return NULL;
+
+    return dot;
+}
+
+// String pointer reverse break: returns right-most occurrence of charset in s
+static const char *strprbrk(const char *s, const char *charset)
+{
+    const char *latestMatch = NULL;
+
+    for (; s = strpbrk(s, charset), s != NULL; latestMatch = s++) { }
+
+    return latestMatch;
+}
+
+// Get pointer to filename for a path string
+const char *GetFileName(const char *filePath)
+{
+    const char *fileName = NULL;
+
+    if (filePath != NULL) fileName = strprbrk(filePath, "\\/");
+
+    if (fileName == NULL) return filePath;
+
+    return fileName + 1;
+}
+
+// Get filename string without extension (uses static string)
+const char *GetFileNameWithoutExt(const char *filePath)
+{
+    #define MAX_FILENAME_LENGTH     256
+
+    static char fileName[MAX_FILENAME_LENGTH] = { 0 };
+    memset(fileName, 0, MAX_FILENAME_LENGTH);
+
+    if (filePath != NULL)
+    {
+        strcpy(fileName, GetFileName(filePath)); // Get filename.ext without path
+        int size = (int)strlen(fileName); // Get size in bytes
+
+        for (int i = size; i > 0; i--) // Reverse search '.'
+        {
+            if (fileName[i] == '.')
+            {
+                // NOTE: We break on first '.' found
+                fileName[i] = '\0';
+                break;
+            }
+        }
+    }
+
+    return fileName;
+}
+
+// Get directory for a given filePath
+const char *GetDirectoryPath(const char *filePath)
+{
+    /*
+    // NOTE: Directory separator is different in Windows and other platforms,
+    // fortunately, Windows also support the '/' separator, that's the one should be used
+    #if defined(_WIN32)
+        char separator = '\\';
+    #else
+        char separator = '/';
+    #endif
+    */
+    const char *lastSlash = NULL;
+    static char dirPath[MAX_FILEPATH_LENGTH] = { 0 };
+    memset(dirPath, 0, MAX_FILEPATH_LENGTH);
+
+    // In case provided path does not contain a root drive letter (C:\, D:\) nor leading path separator (\, /),
+    // we add the current directory path to dirPath
+    if (filePath[1] != ':' && filePath[0] != '\\' && filePath[0] != '/')
+    {
+        // For security, we set starting path to current directory,
+        // obtained path will be concatenated to this
+        dirPath[0] = '.';
+        dirPath[1] = '/';
+    }
+
+    lastSlash = strprbrk(filePath, "\\/");
+    if (lastSlash)
+    {
+        if (lastSlash == filePath)
+        {
+            // The last and only slash is the leading one: path is in a root directory
+            dirPath[0] = filePath[0];
+            dirPath[1] = '\0';
+        }
+        else
+        {
+            // NOTE: Be careful, strncpy() is not safe, it does not care about '\0'
+            char *dirPathPtr = dirPath;
+            if ((filePath[1] != ':') && (filePath[0] != '\\') && (filePath[0] != '/')) dirPathPtr += 2;     // Skip drive letter, "C:"
+            memcpy(dirPathPtr, filePath, strlen(filePath) - (strlen(lastSlash) - 1));
+            dirPath[strlen(filePath) - strlen(lastSlash) + (((filePath[1] != ':') && (filePath[0] != '\\') && (filePath[0] != '/'))? 2 : 0)] = '\0';  // Add '\0' manually
+        }
+    }
+
+    return dirPath;
+}
+
+// Get previous directory path for a given path
+const char *GetPrevDirectoryPath(const char *dirPath)
+{
+    static char prevDirPath[MAX_FILEPATH_LENGTH] = { 0 };
+    memset(prevDirPath, 0, MAX_FILEPATH_LENGTH);
+    int pathLen = (int)strlen(dirPath);
+
+    if (pathLen <= 3) strcpy(prevDirPath, dirPath);
+
+    for (int i = (pathLen - 1); (i >= 0) && (pathLen > 3); i--)
+    {
+        if ((dirPath[i] == '\\') || (dirPath[i] == '/'))
+        {
+            // Check for root: "C:\" or "/"
+            if (((i == 2) && (dirPath[1] ==':')) || (i == 0)) i++;
+
+            strncpy(prevDirPath, dirPath, i);
+            break;
+        }
+    }
+
+    return prevDirPath;
+}
+
+// Get current working directory
+const char *GetWorkingDirectory(void)
+{
+    static char currentDir[MAX_FILEPATH_LENGTH] = { 0 };
+    memset(currentDir, 0, MAX_FILEPATH_LENGTH);
+
+    char *path = GETCWD(currentDir, MAX_FILEPATH_LENGTH - 1);
+
+    return path;
+}
+
+const char *GetApplicationDirectory(void)
+{
+    static char appDir[MAX_FILEPATH_LENGTH] = { 0 };
+    memset(appDir, 0, MAX_FILEPATH_LENGTH);
+
+#if defined(_WIN32)
+    int len = 0;
+#if defined(UNICODE)
+    unsigned short widePath[MAX_PATH];
+    len = GetModuleFileNameW(NULL, widePath, MAX_PATH);
+    len = WideCharToMultiByte(0, 0, widePath, len, appDir, MAX_PATH, NULL, NULL);
+#else
+    len = GetModuleFileNameA(NULL, appDir, MAX_PATH);
+#endif
+    if (len > 0)
+    {
+        for (int i = len; i >= 0; --i)
+        {
+            if (appDir[i] == '\\')
+            {
+                appDir[i + 1] = '\0';
+                break;
+            }
+        }
+    }
+    else
+    {
+        appDir[0] = '.';
+        appDir[1] = '\\';
+    }
+
+#elif defined(__linux__)
+    unsigned int size = sizeof(appDir);
+    ssize_t len = readlink("/proc/self/exe", appDir, size);
+
+    if (len > 0)
+    {
+        for (int i = len; i >= 0; --i)
+        {
+            if (appDir[i] == '/')
+            {
+                appDir[i + 1] = '\0';
+                break;
+            }
+        }
+    }
+    else
+    {
+        appDir[0] = '.';
+        appDir[1] = '/';
+    }
+#elif defined(__APPLE__)
+    uint32_t size = sizeof(appDir);
+
+    if (_NSGetExecutablePath(appDir, &size) == 0)
+    {
+        int len = strlen(appDir);
+        for (int i = len; i >= 0; --i)
+        {
+            if (appDir[i] == '/')
+            {
+                appDir[i + 1] = '\0';
+                break;
+            }
+        }
+    }
+    else
+    {
+        appDir[0] = '.';
+        appDir[1] = '/';
+    }
+#elif defined(__FreeBSD__)
+    size_t size = sizeof(appDir);
+    int mib[4] = {CTL_KERN, KERN_PROC, KERN_PROC_PATHNAME, -1};
+
+    if (sysctl(mib, 4, appDir, &size, NULL, 0) == 0)
+    {
+        int len = strlen(appDir);
+        for (int i = len; i >= 0; --i)
+        {
+            if (appDir[i] == '/')
+            {
+                appDir[i + 1] = '\0';
+                break;
+            }
+        }
+    }
+    else
+    {
+        appDir[0] = '.';
+        appDir[1] = '/';
+    }
+
+#endif
+
+    return appDir;
+}
+
+// Load directory filepaths
+// NOTE: Base path is prepended to the scanned filepaths
+// WARNING: Directory is scanned twice, first time to get files count
+// No recursive scanning is done!
+FilePathList LoadDirectoryFiles(const char *dirPath)
+{
+    FilePathList files = { 0 };
+    unsigned int fileCounter = 0;
+
+    struct dirent *entity;
+    DIR *dir = opendir(dirPath);
+
+    if (dir != NULL) // It's a directory
+    {
+        // SCAN 1: Count files
+        while ((entity = readdir(dir)) != NULL)
+        {
+            // NOTE: We skip '.' (current dir) and '..' (parent dir) filepaths
+            if ((strcmp(entity->d_name, ".") != 0) && (strcmp(entity->d_name, "..") != 0)) fileCounter++;
+        }
+
+        // Memory allocation for dirFileCount
+        files.capacity = fileCounter;
+        files.paths = (char **)RL_MALLOC(files.capacity*sizeof(char *));
+        for (unsigned int i = 0; i < files.capacity; i++) files.paths[i] = (char *)RL_MALLOC(MAX_FILEPATH_LENGTH*sizeof(char));
+
+        closedir(dir);
+
+        // SCAN 2: Read filepaths
+        // NOTE: Directory paths are also registered
+        ScanDirectoryFiles(dirPath, &files, NULL);
+
+        // Security check: read files.count should match fileCounter
+        if (files.count != files.capacity) TRACELOG(LOG_WARNING, "FILEIO: Read files count do not match capacity allocated");
+    }
+    else TRACELOG(LOG_WARNING, "FILEIO: Failed to open requested directory");  // Maybe it's a file...
+
+    return files;
+}
+
+// Load directory filepaths with extension filtering and recursive directory scan
+// NOTE: On recursive loading we do not pre-scan for file count, we use MAX_FILEPATH_CAPACITY
+FilePathList LoadDirectoryFilesEx(const char *basePath, const char *filter, bool scanSubdirs)
+{
+    FilePathList files = { 0 };
+
+    files.capacity = MAX_FILEPATH_CAPACITY;
+    files.paths = (char **)RL_CALLOC(files.capacity, sizeof(char *));
+    for (unsigned int i = 0; i < files.capacity; i++) files.paths[i] = (char *)RL_CALLOC(MAX_FILEPATH_LENGTH, sizeof(char));
+
+    // WARNING: basePath is always prepended to scanned paths
+    if (scanSubdirs) ScanDirectoryFilesRecursively(basePath, &files, filter);
+    else ScanDirectoryFiles(basePath, &files, filter);
+
+    return files;
+}
+
+// Unload directory filepaths
+// WARNING: files.count is not reseted to 0 after unloading
+void UnloadDirectoryFiles(FilePathList files)
+{
+    for (unsigned int i = 0; i < files.capacity; i++) RL_FREE(files.paths[i]);
+
+    RL_FREE(files.paths);
+}
+
+// Create directories (including full path requested), returns 0 on success
+int MakeDirectory(const char *dirPath)
+{
+    if ((dirPath == NULL) || (dirPath[0] == '\0')) return 1; // Path is not valid
+    if (DirectoryExists(dirPath)) return 0; // Path already exists (is valid)
+
+    // Copy path string to avoid modifying original
+    int len = (int)strlen(dirPath) + 1;
+    char *pathcpy = (char *)RL_CALLOC(len, 1);
+    memcpy(pathcpy, dirPath, len);
+
+    // Iterate over pathcpy, create each subdirectory as needed
+    for (int i = 0; (i < len) && (pathcpy[i] != '\0'); i++)
+    {
+        if (pathcpy[i] == ':') i++;
+        else
+        {
+            if ((pathcpy[i] == '\\') || (pathcpy[i] == '/'))
+            {
+                pathcpy[i] = '\0';
+                if (!DirectoryExists(pathcpy)) MKDIR(pathcpy);
+                pathcpy[i] = '/';
+            }
+        }
+    }
+
+    // Create final directory
+    if (!DirectoryExists(pathcpy)) MKDIR(pathcpy);
+
+    RL_FREE(pathcpy);
+
+    return 0;
+}
+
+// Change working directory, returns true on success
+bool ChangeDirectory(const char *dir)
+{
+    bool result = CHDIR(dir);
+
+    if (result != 0) TRACELOG(LOG_WARNING, "SYSTEM: Failed to change to directory: %s", dir);
+
+    return (result == 0);
+}
+
+// Check if a given path point to a file
+bool IsPathFile(const char *path)
+{
+    struct stat result = { 0 };
+    stat(path, &result);
+
+    return S_ISREG(result.st_mode);
+}
+
+// Check if fileName is valid for the platform/OS
+bool IsFileNameValid(const char *fileName)
+{
+    bool valid = true;
+
+    if ((fileName != NULL) && (fileName[0] != '\0'))
+    {
+        int length = (int)strlen(fileName);
+        bool allPeriods = true;
+
+        for (int i = 0; i < length; i++)
+        {
+            // Check invalid characters
+            if ((fileName[i] == '<') ||
+                (fileName[i] == '>') ||
+                (fileName[i] == ':') ||
+                (fileName[i] == '\"') ||
+                (fileName[i] == '/') ||
+                (fileName[i] == '\\') ||
+                (fileName[i] == '|') ||
+                (fileName[i] == '?') ||
+                (fileName[i] == '*')) { valid = false; break; }
+
+            // Check non-glyph characters
+            if ((unsigned char)fileName[i] < 32) { valid = false; break; }
+
+            // TODO: Check trailing periods/spaces?
+
+            // Check if filename is not all periods
+            if (fileName[i] != '.') allPeriods = false;
+        }
+
+        if (allPeriods) valid = false;
+
+/*
+        if (valid)
+        {
+            // Check invalid DOS names
+            if (length >= 3)
+            {
+                if (((fileName[0] == 'C') && (fileName[1] == 'O') && (fileName[2] == 'N')) ||   // CON
+                    ((fileName[0] == 'P') && (fileName[1] == 'R') && (fileName[2] == 'N')) ||   // PRN
+                    ((fileName[0] == 'A') && (fileName[1] == 'U') && (fileName[2] == 'X')) ||   // AUX
+                    ((fileName[0] == 'N') && (fileName[1] == 'U') && (fileName[2] == 'L'))) valid = false; // NUL
+            }
+
+            if (length >= 4)
+            {
+                if (((fileName[0] == 'C') && (fileName[1] == 'O') && (fileName[2] == 'M') && ((fileName[3] >= '0') && (fileName[3] <= '9'))) ||  // COM0-9
+                    ((fileName[0] == 'L') && (fileName[1] == 'P') && (fileName[2] == 'T') && ((fileName[3] >= '0') && (fileName[3] <= '9')))) valid = false; // LPT0-9
+            }
+        }
+*/
+    }
+
+    return valid;
+}
+
+// Check if a file has been dropped into window
+bool IsFileDropped(void)
+{
+    bool result = false;
+
+    if (CORE.Window.dropFileCount > 0) result = true;
+
+    return result;
+}
+
+// Load dropped filepaths
+FilePathList LoadDroppedFiles(void)
+{
+    FilePathList files = { 0 };
+
+    files.count = CORE.Window.dropFileCount;
+    files.paths = CORE.Window.dropFilepaths;
+
+    return files;
+}
+
+// Unload dropped filepaths
+void UnloadDroppedFiles(FilePathList files)
+{
+    // WARNING: files pointers are the same as internal ones
+
+    if (files.count > 0)
+    {
+        for (unsigned int i = 0; i < files.count; i++) RL_FREE(files.paths[i]);
+
+        RL_FREE(files.paths);
+
+        CORE.Window.dropFileCount = 0;
+        CORE.Window.dropFilepaths = NULL;
+    }
+}
+
+// Get file modification time (last write time)
+long GetFileModTime(const char *fileName)
+{
+    struct stat result = { 0 };
+    long modTime = 0;
+
+    if (stat(fileName, &result) == 0)
+    {
+        time_t mod = result.st_mtime;
+
+        modTime = (long)mod;
+    }
+
+    return modTime;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition: Compression and Encoding
+//----------------------------------------------------------------------------------
+
+// Compress data (DEFLATE algorithm)
+unsigned char *CompressData(const unsigned char *data, int dataSize, int *compDataSize)
+{
+    #define COMPRESSION_QUALITY_DEFLATE  8
+
+    unsigned char *compData = NULL;
+
+#if defined(SUPPORT_COMPRESSION_API)
+    // Compress data and generate a valid DEFLATE stream
+    struct sdefl *sdefl = RL_CALLOC(1, sizeof(struct sdefl));   // WARNING: Possible stack overflow, struct sdefl is almost 1MB
+    int bounds = sdefl_bound(dataSize);
+    compData = (unsigned char *)RL_CALLOC(bounds, 1);
+
+    *compDataSize = sdeflate(sdefl, compData, data, dataSize, COMPRESSION_QUALITY_DEFLATE);   // Compression level 8, same as stbiw
+    RL_FREE(sdefl);
+
+    TRACELOG(LOG_INFO, "SYSTEM: Compress data: Original size: %i -> Comp. size: %i", dataSize, *compDataSize);
+#endif
+
+    return compData;
+}
+
+// Decompress data (DEFLATE algorithm)
+unsigned char *DecompressData(const unsigned char *compData, int compDataSize, int *dataSize)
+{
+    unsigned char *data = NULL;
+
+#if defined(SUPPORT_COMPRESSION_API)
+    // Decompress data from a valid DEFLATE stream
+    data = (unsigned char *)RL_CALLOC(MAX_DECOMPRESSION_SIZE*1024*1024, 1);
+    int length = sinflate(data, MAX_DECOMPRESSION_SIZE*1024*1024, compData, compDataSize);
+
+    // WARNING: RL_REALLOC can make (and leave) data copies in memory, be careful with sensitive compressed data!
+    // TODO: Use a different approach, create another buffer, copy data manually to it and wipe original buffer memory
+    unsigned char *temp = (unsigned char *)RL_REALLOC(data, length);
+
+    if (temp != NULL) data = temp;
+    else TRACELOG(LOG_WARNING, "SYSTEM: Failed to re-allocate required decompression memory");
+
+    *dataSize = length;
+
+    TRACELOG(LOG_INFO, "SYSTEM: Decompress data: Comp. size: %i -> Original size: %i", compDataSize, *dataSize);
+#endif
+
+    return data;
+}
+
+// Encode data to Base64 string
+char *EncodeDataBase64(const unsigned char *data, int dataSize, int *outputSize)
+{
+    static const unsigned char base64encodeTable[] = {
+        'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X',
+        'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
+        'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'
+    };
+
+    static const int modTable[] = { 0, 2, 1 };
+
+    *outputSize = 4*((dataSize + 2)/3);
+
+    char *encodedData = (char *)RL_MALLOC(*outputSize);
+
+    if (encodedData == NULL) return NULL;   // Security check
+
+    for (int i = 0, j = 0; i < dataSize;)
+    {
+        unsigned int octetA = (i < dataSize)? (unsigned char)data[i++] : 0;
+        unsigned int octetB = (i < dataSize)? (unsigned char)data[i++] : 0;
+        unsigned int octetC = (i < dataSize)? (unsigned char)data[i++] : 0;
+
+        unsigned int triple = (octetA << 0x10) + (octetB << 0x08) + octetC;
+
+        encodedData[j++] = base64encodeTable[(triple >> 3*6) & 0x3F];
+        encodedData[j++] = base64encodeTable[(triple >> 2*6) & 0x3F];
+        encodedData[j++] = base64encodeTable[(triple >> 1*6) & 0x3F];
+        encodedData[j++] = base64encodeTable[(triple >> 0*6) & 0x3F];
+    }
+
+    for (int i = 0; i < modTable[dataSize%3]; i++) encodedData[*outputSize - 1 - i] = '=';  // Padding character
+
+    return encodedData;
+}
+
+// Decode Base64 string data
+unsigned char *DecodeDataBase64(const unsigned char *data, int *outputSize)
+{
+    static const unsigned char base64decodeTable[] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 62, 0, 0, 0, 63, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+        11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 0, 0, 0, 0, 0, 0, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36,
+        37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51
+    };
+
+    // Get output size of Base64 input data
+    int outSize = 0;
+    for (int i = 0; data[4*i] != 0; i++)
+    {
+        if (data[4*i + 3] == '=')
+        {
+            if (data[4*i + 2] == '=') outSize += 1;
+            else outSize += 2;
+        }
+        else outSize += 3;
+    }
+
+    // Allocate memory to store decoded Base64 data
+    unsigned char *decodedData = (unsigned char *)RL_MALLOC(outSize);
+
+    for (int i = 0; i < outSize/3; i++)
+    {
+        unsigned char a = base64decodeTable[(int)data[4*i]];
+        unsigned char b = base64decodeTable[(int)data[4*i + 1]];
+        unsigned char c = base64decodeTable[(int)data[4*i + 2]];
+        unsigned char d = base64decodeTable[(int)data[4*i + 3]];
+
+        decodedData[3*i] = (a << 2) | (b >> 4);
+        decodedData[3*i + 1] = (b << 4) | (c >> 2);
+        decodedData[3*i + 2] = (c << 6) | d;
+    }
+
+    if (outSize%3 == 1)
+    {
+        int n = outSize/3;
+        unsigned char a = base64decodeTable[(int)data[4*n]];
+        unsigned char b = base64decodeTable[(int)data[4*n + 1]];
+        decodedData[outSize - 1] = (a << 2) | (b >> 4);
+    }
+    else if (outSize%3 == 2)
+    {
+        int n = outSize/3;
+        unsigned char a = base64decodeTable[(int)data[4*n]];
+        unsigned char b = base64decodeTable[(int)data[4*n + 1]];
+        unsigned char c = base64decodeTable[(int)data[4*n + 2]];
+        decodedData[outSize - 2] = (a << 2) | (b >> 4);
+        decodedData[outSize - 1] = (b << 4) | (c >> 2);
+    }
+
+    *outputSize = outSize;
+    return decodedData;
+}
+
+// Compute CRC32 hash code
+unsigned int ComputeCRC32(unsigned char *data, int dataSize)
+{
+    static unsigned int crcTable[256] = {
+        0x00000000, 0x77073096, 0xEE0E612C, 0x990951BA, 0x076DC419, 0x706AF48F, 0xE963A535, 0x9E6495A3,
+        0x0eDB8832, 0x79DCB8A4, 0xE0D5E91E, 0x97D2D988, 0x09B64C2B, 0x7EB17CBD, 0xE7B82D07, 0x90BF1D91,
+        0x1DB71064, 0x6AB020F2, 0xF3B97148, 0x84BE41DE, 0x1ADAD47D, 0x6DDDE4EB, 0xF4D4B551, 0x83D385C7,
+        0x136C9856, 0x646BA8C0, 0xFD62F97A, 0x8A65C9EC, 0x14015C4F, 0x63066CD9, 0xFA0F3D63, 0x8D080DF5,
+        0x3B6E20C8, 0x4C69105E, 0xD56041E4, 0xA2677172, 0x3C03E4D1, 0x4B04D447, 0xD20D85FD, 0xA50AB56B,
+        0x35B5A8FA, 0x42B2986C, 0xDBBBC9D6, 0xACBCF940, 0x32D86CE3, 0x45DF5C75, 0xDCD60DCF, 0xABD13D59,
+        0x26D930AC, 0x51DE003A, 0xC8D75180, 0xBFD06116, 0x21B4F4B5, 0x56B3C423, 0xCFBA9599, 0xB8BDA50F,
+        0x2802B89E, 0x5F058808, 0xC60CD9B2, 0xB10BE924, 0x2F6F7C87, 0x58684C11, 0xC1611DAB, 0xB6662D3D,
+        0x76DC4190, 0x01DB7106, 0x98D220BC, 0xEFD5102A, 0x71B18589, 0x06B6B51F, 0x9FBFE4A5, 0xE8B8D433,
+        0x7807C9A2, 0x0F00F934, 0x9609A88E, 0xE10E9818, 0x7F6A0DBB, 0x086D3D2D, 0x91646C97, 0xE6635C01,
+        0x6B6B51F4, 0x1C6C6162, 0x856530D8, 0xF262004E, 0x6C0695ED, 0x1B01A57B, 0x8208F4C1, 0xF50FC457,
+        0x65B0D9C6, 0x12B7E950, 0x8BBEB8EA, 0xFCB9887C, 0x62DD1DDF, 0x15DA2D49, 0x8CD37CF3, 0xFBD44C65,
+        0x4DB26158, 0x3AB551CE, 0xA3BC0074, 0xD4BB30E2, 0x4ADFA541, 0x3DD895D7, 0xA4D1C46D, 0xD3D6F4FB,
+        0x4369E96A, 0x346ED9FC, 0xAD678846, 0xDA60B8D0, 0x44042D73, 0x33031DE5, 0xAA0A4C5F, 0xDD0D7CC9,
+        0x5005713C, 0x270241AA, 0xBE0B1010, 0xC90C2086, 0x5768B525, 0x206F85B3, 0xB966D409, 0xCE61E49F,
+        0x5EDEF90E, 0x29D9C998, 0xB0D09822, 0xC7D7A8B4, 0x59B33D17, 0x2EB40D81, 0xB7BD5C3B, 0xC0BA6CAD,
+        0xEDB88320, 0x9ABFB3B6, 0x03B6E20C, 0x74B1D29A, 0xEAD54739, 0x9DD277AF, 0x04DB2615, 0x73DC1683,
+        0xE3630B12, 0x94643B84, 0x0D6D6A3E, 0x7A6A5AA8, 0xE40ECF0B, 0x9309FF9D, 0x0A00AE27, 0x7D079EB1,
+        0xF00F9344, 0x8708A3D2, 0x1E01F268, 0x6906C2FE, 0xF762575D, 0x806567CB, 0x196C3671, 0x6E6B06E7,
+        0xFED41B76, 0x89D32BE0, 0x10DA7A5A, 0x67DD4ACC, 0xF9B9DF6F, 0x8EBEEFF9, 0x17B7BE43, 0x60B08ED5,
+        0xD6D6A3E8, 0xA1D1937E, 0x38D8C2C4, 0x4FDFF252, 0xD1BB67F1, 0xA6BC5767, 0x3FB506DD, 0x48B2364B,
+        0xD80D2BDA, 0xAF0A1B4C, 0x36034AF6, 0x41047A60, 0xDF60EFC3, 0xA867DF55, 0x316E8EEF, 0x4669BE79,
+        0xCB61B38C, 0xBC66831A, 0x256FD2A0, 0x5268E236, 0xCC0C7795, 0xBB0B4703, 0x220216B9, 0x5505262F,
+        0xC5BA3BBE, 0xB2BD0B28, 0x2BB45A92, 0x5CB36A04, 0xC2D7FFA7, 0xB5D0CF31, 0x2CD99E8B, 0x5BDEAE1D,
+        0x9B64C2B0, 0xEC63F226, 0x756AA39C, 0x026D930A, 0x9C0906A9, 0xEB0E363F, 0x72076785, 0x05005713,
+        0x95BF4A82, 0xE2B87A14, 0x7BB12BAE, 0x0CB61B38, 0x92D28E9B, 0xE5D5BE0D, 0x7CDCEFB7, 0x0BDBDF21,
+        0x86D3D2D4, 0xF1D4E242, 0x68DDB3F8, 0x1FDA836E, 0x81BE16CD, 0xF6B9265B, 0x6FB077E1, 0x18B74777,
+        0x88085AE6, 0xFF0F6A70, 0x66063BCA, 0x11010B5C, 0x8F659EFF, 0xF862AE69, 0x616BFFD3, 0x166CCF45,
+        0xA00AE278, 0xD70DD2EE, 0x4E048354, 0x3903B3C2, 0xA7672661, 0xD06016F7, 0x4969474D, 0x3E6E77DB,
+        0xAED16A4A, 0xD9D65ADC, 0x40DF0B66, 0x37D83BF0, 0xA9BCAE53, 0xDEBB9EC5, 0x47B2CF7F, 0x30B5FFE9,
+        0xBDBDF21C, 0xCABAC28A, 0x53B39330, 0x24B4A3A6, 0xBAD03605, 0xCDD70693, 0x54DE5729, 0x23D967BF,
+        0xB3667A2E, 0xC4614AB8, 0x5D681B02, 0x2A6F2B94, 0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D
+    };
+
+    unsigned int crc = ~0u;
+
+    for (int i = 0; i < dataSize; i++) crc = (crc >> 8) ^ crcTable[data[i] ^ (crc & 0xff)];
+
+    return ~crc;
+}
+
+// Compute MD5 hash code
+// NOTE: Returns a static int[4] array (16 bytes)
+unsigned int *ComputeMD5(unsigned char *data, int dataSize)
+{
+    #define ROTATE_LEFT(x, c) (((x) << (c)) | ((x) >> (32 - (c))))
+
+    static unsigned int hash[4] = { 0 };  // Hash to be returned
+
+    // WARNING: All variables are unsigned 32 bit and wrap modulo 2^32 when calculating
+
+    // NOTE: r specifies the per-round shift amounts
+    unsigned int r[] = {
+        7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+        5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20,
+        4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+        6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
+    };
+
+    // Using binary integer part of the sines of integers (in radians) as constants
+    unsigned int k[] = {
+        0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee,
+        0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+        0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
+        0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+        0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa,
+        0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+        0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed,
+        0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+        0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
+        0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+        0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05,
+        0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+        0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039,
+        0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+        0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
+        0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+    };
+
+    hash[0] = 0x67452301;
+    hash[1] = 0xefcdab89;
+    hash[2] = 0x98badcfe;
+    hash[3] = 0x10325476;
+
+    // Pre-processing: adding a single 1 bit
+    // Append '1' bit to message
+    // NOTE: The input bytes are considered as bits strings,
+    // where the first bit is the most significant bit of the byte
+
+    // Pre-processing: padding with zeros
+    // Append '0' bit until message length in bit 448 (mod 512)
+    // Append length mod (2 pow 64) to message
+
+    int newDataSize = ((((dataSize + 8)/64) + 1)*64) - 8;
+
+    unsigned char *msg = RL_CALLOC(newDataSize + 64, 1); // Initialize with '0' bits, allocating 64 extra bytes
+    memcpy(msg, data, dataSize);
+    msg[dataSize] = 128; // Write the '1' bit
+
+    unsigned int bitsLen = 8*dataSize;
+    memcpy(msg + newDataSize, &bitsLen, 4); // Append the len in bits at the end of the buffer
+
+    // Process the message in successive 512-bit chunks for each 512-bit chunk of message
+    for (int offset = 0; offset < newDataSize; offset += (512/8))
+    {
+        // Break chunk into sixteen 32-bit words w[j], 0 <= j <= 15
+        unsigned int *w = (unsigned int *)(msg + offset);
+
+        // Initialize hash value for this chunk
+        unsigned int a = hash[0];
+        unsigned int b = hash[1];
+        unsigned int c = hash[2];
+        unsigned int d = hash[3];
+
+        for (int i = 0; i < 64; i++)
+        {
+            unsigned int f = 0;
+            unsigned int g = 0;
+
+            if (i < 16)
+            {
+                f = (b & c) | ((~b) & d);
+                g = i;
+            }
+            else if (i < 32)
+            {
+                f = (d & b) | ((~d) & c);
+                g = (5*i + 1)%16;
+            }
+            else if (i < 48)
+            {
+                f = b ^ c ^ d;
+                g = (3*i + 5)%16;
+            }
+            else
+            {
+                f = c ^ (b | (~d));
+                g = (7*i)%16;
+            }
+
+            unsigned int temp = d;
+            d = c;
+            c = b;
+            b = b + ROTATE_LEFT((a + f + k[i] + w[g]), r[i]);
+            a = temp;
+        }
+
+        // Add chunk's hash to result so far
+        hash[0] += a;
+        hash[1] += b;
+        hash[2] += c;
+        hash[3] += d;
+    }
+
+    RL_FREE(msg);
+
+    return hash;
+}
+
+// Compute SHA-1 hash code
+// NOTE: Returns a static int[5] array (20 bytes)
+unsigned int *ComputeSHA1(unsigned char *data, int dataSize) {
+    #define ROTATE_LEFT(x, c) (((x) << (c)) | ((x) >> (32 - (c))))
+
+    static unsigned int hash[5] = { 0 };  // Hash to be returned
+
+    // Initialize hash values
+    hash[0] = 0x67452301;
+    hash[1] = 0xEFCDAB89;
+    hash[2] = 0x98BADCFE;
+    hash[3] = 0x10325476;
+    hash[4] = 0xC3D2E1F0;
+
+    // Pre-processing: adding a single 1 bit
+    // Append '1' bit to message
+    // NOTE: The input bytes are considered as bits strings,
+    // where the first bit is the most significant bit of the byte
+
+    // Pre-processing: padding with zeros
+    // Append '0' bit until message length in bit 448 (mod 512)
+    // Append length mod (2 pow 64) to message
+
+    int newDataSize = ((((dataSize + 8)/64) + 1)*64);
+
+    unsigned char *msg = RL_CALLOC(newDataSize, 1); // Initialize with '0' bits
+    memcpy(msg, data, dataSize);
+    msg[dataSize] = 128; // Write the '1' bit
+
+    unsigned int bitsLen = 8*dataSize;
+    msg[newDataSize-1] = bitsLen;
+
+    // Process the message in successive 512-bit chunks
+    for (int offset = 0; offset < newDataSize; offset += (512/8))
+    {
+        // Break chunk into sixteen 32-bit words w[j], 0 <= j <= 15
+        unsigned int w[80] = {0};
+        for (int i = 0; i < 16; i++) {
+            w[i] = (msg[offset + (i * 4) + 0] << 24) |
+                   (msg[offset + (i * 4) + 1] << 16) |
+                   (msg[offset + (i * 4) + 2] << 8) |
+                   (msg[offset + (i * 4) + 3]);
+        }
+
+        // Message schedule: extend the sixteen 32-bit words into eighty 32-bit words:
+        for (int i = 16; i < 80; ++i) {
+            w[i] = ROTATE_LEFT(w[i-3] ^ w[i-8] ^ w[i-14] ^ w[i-16], 1);
+        }
+
+        // Initialize hash value for this chunk
+        unsigned int a = hash[0];
+        unsigned int b = hash[1];
+        unsigned int c = hash[2];
+        unsigned int d = hash[3];
+        unsigned int e = hash[4];
+
+        for (int i = 0; i < 80; i++)
         {
-            if (appDir[i] == '/')
-            {
-                appDir[i + 1] = '\0';
-                break;
+            unsigned int f = 0;
+            unsigned int k = 0;
+
+            if (i < 20) {
+                f = (b & c) | ((~b) & d);
+                k = 0x5A827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
             }
+
+            unsigned int temp = ROTATE_LEFT(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = ROTATE_LEFT(b, 30);
+            b = a;
+            a = temp;
         }
-    }
-    else
-    {
-        appDir[0] = '.';
-        appDir[1] = '/';
+
+        // Add this chunk's hash to result so far
+        hash[0] += a;
+        hash[1] += b;
+        hash[2] += c;
+        hash[3] += d;
+        hash[4] += e;
     }
 
-#endif
+    RL_FREE(msg);
 
-    return appDir;
+    return hash;
 }
 
-// Load directory filepaths
-// NOTE: Base path is prepended to the scanned filepaths
-// WARNING: Directory is scanned twice, first time to get files count
-// No recursive scanning is done!
-FilePathList LoadDirectoryFiles(const char *dirPath)
+//----------------------------------------------------------------------------------
+// Module Functions Definition: Automation Events Recording and Playing
+//----------------------------------------------------------------------------------
+
+// Load automation events list from file, NULL for empty list, capacity = MAX_AUTOMATION_EVENTS
+AutomationEventList LoadAutomationEventList(const char *fileName)
 {
-    FilePathList files = { 0 };
-    unsigned int fileCounter = 0;
+    AutomationEventList list = { 0 };
 
-    struct dirent *entity;
-    DIR *dir = opendir(dirPath);
+    // Allocate and empty automation event list, ready to record new events
+    list.events = (AutomationEvent *)RL_CALLOC(MAX_AUTOMATION_EVENTS, sizeof(AutomationEvent));
+    list.capacity = MAX_AUTOMATION_EVENTS;
 
-    if (dir != NULL) // It's a directory
+#if defined(SUPPORT_AUTOMATION_EVENTS)
+    if (fileName == NULL) TRACELOG(LOG_INFO, "AUTOMATION: New empty events list loaded successfully");
+    else
     {
-        // SCAN 1: Count files
-        while ((entity = readdir(dir)) != NULL)
+        // Load automation events file (binary)
+        /*
+        //int dataSize = 0;
+        //unsigned char *data = LoadFileData(fileName, &dataSize);
+
+        FILE *raeFile = fopen(fileName, "rb");
+        unsigned char fileId[4] = { 0 };
+
+        fread(fileId, 1, 4, raeFile);
+
+        if ((fileId[0] == 'r') && (fileId[1] == 'A') && (fileId[2] == 'E') && (fileId[1] == ' '))
         {
-            // NOTE: We skip '.' (current dir) and '..' (parent dir) filepaths
-            if ((strcmp(entity->d_name, ".") != 0) && (strcmp(entity->d_name, "..") != 0)) fileCounter++;
+            fread(&eventCount, sizeof(int), 1, raeFile);
+            TRACELOG(LOG_WARNING, "Events loaded: %i\n", eventCount);
+            fread(events, sizeof(AutomationEvent), eventCount, raeFile);
         }
 
-        // Memory allocation for dirFileCount
-        files.capacity = fileCounter;
-        files.paths = (char **)RL_MALLOC(files.capacity*sizeof(char *));
-        for (unsigned int i = 0; i < files.capacity; i++) files.paths[i] = (char *)RL_MALLOC(MAX_FILEPATH_LENGTH*sizeof(char));
+        fclose(raeFile);
+        */
 
-        closedir(dir);
+        // Load events file (text)
+        //unsigned char *buffer = LoadFileText(fileName);
+        FILE *raeFile = fopen(fileName, "rt");
 
-        // SCAN 2: Read filepaths
-        // NOTE: Directory paths are also registered
-        ScanDirectoryFiles(dirPath, &files, NULL);
+        if (raeFile != NULL)
+        {
+            unsigned int counter = 0;
+            char buffer[256] = { 0 };
+            char eventDesc[64] = { 0 };
 
-        // Security check: read files.count should match fileCounter
-        if (files.count != files.capacity) TRACELOG(LOG_WARNING, "FILEIO: Read files count do not match capacity allocated");
-    }
-    else TRACELOG(LOG_WARNING, "FILEIO: Failed to open requested directory");  // Maybe it's a file...
+            fgets(buffer, 256, raeFile);
 
-    return files;
-}
+            while (!feof(raeFile))
+            {
+                switch (buffer[0])
+                {
+                    case 'c': sscanf(buffer, "c %i", &list.count); break;
+                    case 'e':
+                    {
+                        sscanf(buffer, "e %d %d %d %d %d %d %[^\n]s", &list.events[counter].frame, &list.events[counter].type,
+                               &list.events[counter].params[0], &list.events[counter].params[1], &list.events[counter].params[2], &list.events[counter].params[3], eventDesc);
 
-// Load directory filepaths with extension filtering and recursive directory scan
-// NOTE: On recursive loading we do not pre-scan for file count, we use MAX_FILEPATH_CAPACITY
-FilePathList LoadDirectoryFilesEx(const char *basePath, const char *filter, bool scanSubdirs)
-{
-    FilePathList files = { 0 };
+                        counter++;
+                    } break;
+                    default: break;
+                }
 
-    files.capacity = MAX_FILEPATH_CAPACITY;
-    files.paths = (char **)RL_CALLOC(files.capacity, sizeof(char *));
-    for (unsigned int i = 0; i < files.capacity; i++) files.paths[i] = (char *)RL_CALLOC(MAX_FILEPATH_LENGTH, sizeof(char));
+                fgets(buffer, 256, raeFile);
+            }
 
-    // WARNING: basePath is always prepended to scanned paths
-    if (scanSubdirs) ScanDirectoryFilesRecursively(basePath, &files, filter);
-    else ScanDirectoryFiles(basePath, &files, filter);
+            if (counter != list.count)
+            {
+                TRACELOG(LOG_WARNING, "AUTOMATION: Events read from file [%i] do not mach event count specified [%i]", counter, list.count);
+                list.count = counter;
+            }
 
-    return files;
+            fclose(raeFile);
+
+            TRACELOG(LOG_INFO, "AUTOMATION: Events file loaded successfully");
+        }
+
+        TRACELOG(LOG_INFO, "AUTOMATION: Events loaded from file: %i", list.count);
+    }
+#endif
+    return list;
 }
 
-// Unload directory filepaths
-// WARNING: files.count is not reseted to 0 after unloading
-void UnloadDirectoryFiles(FilePathList files)
+// Unload automation events list from file
+void UnloadAutomationEventList(AutomationEventList list)
 {
-    for (unsigned int i = 0; i < files.capacity; i++) RL_FREE(files.paths[i]);
-
-    RL_FREE(files.paths);
+#if defined(SUPPORT_AUTOMATION_EVENTS)
+    RL_FREE(list.events);
+#endif
 }
 
-// Create directories (including full path requested), returns 0 on success
-int MakeDirectory(const char *dirPath)
+// Export automation events list as text file
+bool ExportAutomationEventList(AutomationEventList list, const char *fileName)
 {
-    if ((dirPath == NULL) || (dirPath[0] == '\0')) return 1; // Path is not valid
-    if (DirectoryExists(dirPath)) return 0; // Path already exists (is valid)
+    bool success = false;
 
-    // Copy path string to avoid modifying original
-    int len = (int)strlen(dirPath) + 1;
-    char *pathcpy = (char *)RL_CALLOC(len, 1);
-    memcpy(pathcpy, dirPath, len);
+#if defined(SUPPORT_AUTOMATION_EVENTS)
+    // Export events as binary file
+    // TODO: Save to memory buffer and SaveFileData()
+    /*
+    unsigned char fileId[4] = "rAE ";
+    FILE *raeFile = fopen(fileName, "wb");
+    fwrite(fileId, sizeof(unsigned char), 4, raeFile);
+    fwrite(&eventCount, sizeof(int), 1, raeFile);
+    fwrite(events, sizeof(AutomationEvent), eventCount, raeFile);
+    fclose(raeFile);
+    */
 
-    // Iterate over pathcpy, create each subdirectory as needed
-    for (int i = 0; (i < len) && (pathcpy[i] != '\0'); i++)
+    // Export events as text
+    // TODO: Save to memory buffer and SaveFileText()
+    char *txtData = (char *)RL_CALLOC(256*list.count + 2048, sizeof(char)); // 256 characters per line plus some header
+
+    int byteCount = 0;
+    byteCount += sprintf(txtData + byteCount, "#\n");
+    byteCount += sprintf(txtData + byteCount, "# Automation events exporter v1.0 - raylib automation events list\n");
+    byteCount += sprintf(txtData + byteCount, "#\n");
+    byteCount += sprintf(txtData + byteCount, "#    c <events_count>\n");
+    byteCount += sprintf(txtData + byteCount, "#    e <frame> <event_type> <param0> <param1> <param2> <param3> // <event_type_name>\n");
+    byteCount += sprintf(txtData + byteCount, "#\n");
+    byteCount += sprintf(txtData + byteCount, "# more info and bugs-report:  github.com/raysan5/raylib\n");
+    byteCount += sprintf(txtData + byteCount, "# feedback and support:       ray[at]raylib.com\n");
+    byteCount += sprintf(txtData + byteCount, "#\n");
+    byteCount += sprintf(txtData + byteCount, "# Copyright (c) 2023-2024 Ramon Santamaria (@raysan5)\n");
+    byteCount += sprintf(txtData + byteCount, "#\n\n");
+
+    // Add events data
+    byteCount += sprintf(txtData + byteCount, "c %i\n", list.count);
+    for (unsigned int i = 0; i < list.count; i++)
     {
-        if (pathcpy[i] == ':') i++;
-        else
-        {
-            if ((pathcpy[i] == '\\') || (pathcpy[i] == '/'))
-            {
-                pathcpy[i] = '\0';
-                if (!DirectoryExists(pathcpy)) MKDIR(pathcpy);
-                pathcpy[i] = '/';
-            }
-        }
+        byteCount += snprintf(txtData + byteCount, 256, "e %i %i %i %i %i %i // Event: %s\n", list.events[i].frame, list.events[i].type,
+            list.events[i].params[0], list.events[i].params[1], list.events[i].params[2], list.events[i].params[3], autoEventTypeName[list.events[i].type]);
     }
 
-    // Create final directory
-    if (!DirectoryExists(pathcpy)) MKDIR(pathcpy);
+    // NOTE: Text data size exported is determined by '\0' (NULL) character
+    success = SaveFileText(fileName, txtData);
 
-    RL_FREE(pathcpy);
+    RL_FREE(txtData);
+#endif
 
-    return 0;
+    return success;
+}
+
+// Setup automation event list to record to
+void SetAutomationEventList(AutomationEventList *list)
+{
+#if defined(SUPPORT_AUTOMATION_EVENTS)
+    currentEventList = list;
+#endif
+}
+
+// Set automation event internal base frame to start recording
+void SetAutomationEventBaseFrame(int frame)
+{
+    CORE.Time.frameCounter = frame;
 }
 
-// Change working directory, returns true on success
-bool ChangeDirectory(const char *dir)
+// Start recording automation events (AutomationEventList must be set)
+void StartAutomationEventRecording(void)
 {
-    bool result = CHDIR(dir);
-
-    if (result != 0) TRACELOG(LOG_WARNING, "SYSTEM: Failed to change to directory: %s", dir);
-
-    return (result == 0);
+#if defined(SUPPORT_AUTOMATION_EVENTS)
+    automationEventRecording = true;
+#endif
 }
 
-// Check if a given path point to a file
-bool IsPathFile(const char *path)
+// Stop recording automation events
+void StopAutomationEventRecording(void)
 {
-    struct stat result = { 0 };
-    stat(path, &result);
-
-    return S_ISREG(result.st_mode);
+#if defined(SUPPORT_AUTOMATION_EVENTS)
+    automationEventRecording = false;
+#endif
 }
 
-// Check if fileName is valid for the platform/OS
-bool IsFileNameValid(const char *fileName)
+// Play a recorded automation event
+void PlayAutomationEvent(AutomationEvent event)
 {
-    bool valid = true;
+#if defined(SUPPORT_AUTOMATION_EVENTS)
+    // WARNING: When should event be played? After/before/replace PollInputEvents()? -> Up to the user!
 
-    if ((fileName != NULL) && (fileName[0] != '\0'))
+    if (!automationEventRecording)      // TODO: Allow recording events while playing?
     {
-        int length = (int)strlen(fileName);
-        bool allPeriods = true;
-
-        for (int i = 0; i < length; i++)
+        switch (event.type)
         {
-            // Check invalid characters
-            if ((fileName[i] == '<') ||
-                (fileName[i] == '>') ||
-                (fileName[i] == ':') ||
-                (fileName[i] == '\"') ||
-                (fileName[i] == '/') ||
-                (fileName[i] == '\\') ||
-                (fileName[i] == '|') ||
-                (fileName[i] == '?') ||
-                (fileName[i] == '*')) { valid = false; break; }
-
-            // Check non-glyph characters
-            if ((unsigned char)fileName[i] < 32) { valid = false; break; }
-
-            // TODO: Check trailing periods/spaces?
-
-            // Check if filename is not all periods
-            if (fileName[i] != '.') allPeriods = false;
-        }
-
-        if (allPeriods) valid = false;
+            // Input event
+            case INPUT_KEY_UP: CORE.Input.Keyboard.currentKeyState[event.params[0]] = false; break;             // param[0]: key
+            case INPUT_KEY_DOWN: {                                                                              // param[0]: key
+                CORE.Input.Keyboard.currentKeyState[event.params[0]] = true;
 
-/*
-        if (valid)
-        {
-            // Check invalid DOS names
-            if (length >= 3)
+                if (CORE.Input.Keyboard.previousKeyState[event.params[0]] == false)
+                {
+                    if (CORE.Input.Keyboard.keyPressedQueueCount < MAX_KEY_PRESSED_QUEUE)
+                    {
+                        // Add character to the queue
+                        CORE.Input.Keyboard.keyPressedQueue[CORE.Input.Keyboard.keyPressedQueueCount] = event.params[0];
+                        CORE.Input.Keyboard.keyPressedQueueCount++;
+                    }
+                }
+            } break;
+            case INPUT_MOUSE_BUTTON_UP: CORE.Input.Mouse.currentButtonState[event.params[0]] = false; break;    // param[0]: key
+            case INPUT_MOUSE_BUTTON_DOWN: CORE.Input.Mouse.currentButtonState[event.params[0]] = true; break;   // param[0]: key
+            case INPUT_MOUSE_POSITION:      // param[0]: x, param[1]: y
             {
-                if (((fileName[0] == 'C') && (fileName[1] == 'O') && (fileName[2] == 'N')) ||   // CON
-                    ((fileName[0] == 'P') && (fileName[1] == 'R') && (fileName[2] == 'N')) ||   // PRN
-                    ((fileName[0] == 'A') && (fileName[1] == 'U') && (fileName[2] == 'X')) ||   // AUX
-                    ((fileName[0] == 'N') && (fileName[1] == 'U') && (fileName[2] == 'L'))) valid = false; // NUL
-            }
+                CORE.Input.Mouse.currentPosition.x = (float)event.params[0];
+                CORE.Input.Mouse.currentPosition.y = (float)event.params[1];
+            } break;
+            case INPUT_MOUSE_WHEEL_MOTION:  // param[0]: x delta, param[1]: y delta
+            {
+                CORE.Input.Mouse.currentWheelMove.x = (float)event.params[0];
+                CORE.Input.Mouse.currentWheelMove.y = (float)event.params[1];
+            } break;
+            case INPUT_TOUCH_UP: CORE.Input.Touch.currentTouchState[event.params[0]] = false; break;            // param[0]: id
+            case INPUT_TOUCH_DOWN: CORE.Input.Touch.currentTouchState[event.params[0]] = true; break;           // param[0]: id
+            case INPUT_TOUCH_POSITION:      // param[0]: id, param[1]: x, param[2]: y
+            {
+                CORE.Input.Touch.position[event.params[0]].x = (float)event.params[1];
+                CORE.Input.Touch.position[event.params[0]].y = (float)event.params[2];
+            } break;
+            case INPUT_GAMEPAD_CONNECT: CORE.Input.Gamepad.ready[event.params[0]] = true; break;                // param[0]: gamepad
+            case INPUT_GAMEPAD_DISCONNECT: CORE.Input.Gamepad.ready[event.params[0]] = false; break;            // param[0]: gamepad
+            case INPUT_GAMEPAD_BUTTON_UP: CORE.Input.Gamepad.currentButtonState[event.params[0]][event.params[1]] = false; break;    // param[0]: gamepad, param[1]: button
+            case INPUT_GAMEPAD_BUTTON_DOWN: CORE.Input.Gamepad.currentButtonState[event.params[0]][event.params[1]] = true; break;   // param[0]: gamepad, param[1]: button
+            case INPUT_GAMEPAD_AXIS_MOTION: // param[0]: gamepad, param[1]: axis, param[2]: delta
+            {
+                CORE.Input.Gamepad.axisState[event.params[0]][event.params[1]] = ((float)event.params[2]/32768.0f);
+            } break;
+    #if defined(SUPPORT_GESTURES_SYSTEM)
+            case INPUT_GESTURE: GESTURES.current = event.params[0]; break;     // param[0]: gesture (enum Gesture) -> rgestures.h: GESTURES.current
+    #endif
+            // Window event
+            case WINDOW_CLOSE: CORE.Window.shouldClose = true; break;
+            case WINDOW_MAXIMIZE: MaximizeWindow(); break;
+            case WINDOW_MINIMIZE: MinimizeWindow(); break;
+            case WINDOW_RESIZE: SetWindowSize(event.params[0], event.params[1]); break;
 
-            if (length >= 4)
+            // Custom event
+    #if defined(SUPPORT_SCREEN_CAPTURE)
+            case ACTION_TAKE_SCREENSHOT:
             {
-                if (((fileName[0] == 'C') && (fileName[1] == 'O') && (fileName[2] == 'M') && ((fileName[3] >= '0') && (fileName[3] <= '9'))) ||  // COM0-9
-                    ((fileName[0] == 'L') && (fileName[1] == 'P') && (fileName[2] == 'T') && ((fileName[3] >= '0') && (fileName[3] <= '9')))) valid = false; // LPT0-9
-            }
+                TakeScreenshot(TextFormat("screenshot%03i.png", screenshotCounter));
+                screenshotCounter++;
+            } break;
+    #endif
+            case ACTION_SETTARGETFPS: SetTargetFPS(event.params[0]); break;
+            default: break;
         }
-*/
-    }
 
-    return valid;
+        TRACELOG(LOG_INFO, "AUTOMATION PLAY: Frame: %i | Event type: %i | Event parameters: %i, %i, %i", event.frame, event.type, event.params[0], event.params[1], event.params[2]);
+    }
+#endif
 }
 
-// Check if a file has been dropped into window
-bool IsFileDropped(void)
+//----------------------------------------------------------------------------------
+// Module Functions Definition: Input Handling: Keyboard
+//----------------------------------------------------------------------------------
+
+// Check if a key has been pressed once
+bool IsKeyPressed(int key)
 {
-    bool result = false;
 
-    if (CORE.Window.dropFileCount > 0) result = true;
+    bool pressed = false;
 
-    return result;
+    if ((key > 0) && (key < MAX_KEYBOARD_KEYS))
+    {
+        if ((CORE.Input.Keyboard.previousKeyState[key] == 0) && (CORE.Input.Keyboard.currentKeyState[key] == 1)) pressed = true;
+    }
+
+    return pressed;
 }
 
-// Load dropped filepaths
-FilePathList LoadDroppedFiles(void)
+// Check if a key has been pressed again
+bool IsKeyPressedRepeat(int key)
 {
-    FilePathList files = { 0 };
+    bool repeat = false;
 
-    files.count = CORE.Window.dropFileCount;
-    files.paths = CORE.Window.dropFilepaths;
+    if ((key > 0) && (key < MAX_KEYBOARD_KEYS))
+    {
+        if (CORE.Input.Keyboard.keyRepeatInFrame[key] == 1) repeat = true;
+    }
 
-    return files;
+    return repeat;
 }
 
-// Unload dropped filepaths
-void UnloadDroppedFiles(FilePathList files)
+// Check if a key is being pressed (key held down)
+bool IsKeyDown(int key)
 {
-    // WARNING: files pointers are the same as internal ones
+    bool down = false;
 
-    if (files.count > 0)
+    if ((key > 0) && (key < MAX_KEYBOARD_KEYS))
     {
-        for (unsigned int i = 0; i < files.count; i++) RL_FREE(files.paths[i]);
-
-        RL_FREE(files.paths);
-
-        CORE.Window.dropFileCount = 0;
-        CORE.Window.dropFilepaths = NULL;
+        if (CORE.Input.Keyboard.currentKeyState[key] == 1) down = true;
     }
+
+    return down;
 }
 
-// Get file modification time (last write time)
-long GetFileModTime(const char *fileName)
+// Check if a key has been released once
+bool IsKeyReleased(int key)
 {
-    struct stat result = { 0 };
-    long modTime = 0;
+    bool released = false;
 
-    if (stat(fileName, &result) == 0)
+    if ((key > 0) && (key < MAX_KEYBOARD_KEYS))
     {
-        time_t mod = result.st_mtime;
-
-        modTime = (long)mod;
+        if ((CORE.Input.Keyboard.previousKeyState[key] == 1) && (CORE.Input.Keyboard.currentKeyState[key] == 0)) released = true;
     }
 
-    return modTime;
+    return released;
 }
 
-//----------------------------------------------------------------------------------
-// Module Functions Definition: Compression and Encoding
-//----------------------------------------------------------------------------------
-
-// Compress data (DEFLATE algorithm)
-unsigned char *CompressData(const unsigned char *data, int dataSize, int *compDataSize)
+// Check if a key is NOT being pressed (key not held down)
+bool IsKeyUp(int key)
 {
-    #define COMPRESSION_QUALITY_DEFLATE  8
+    bool up = false;
 
-    unsigned char *compData = NULL;
+    if ((key > 0) && (key < MAX_KEYBOARD_KEYS))
+    {
+        if (CORE.Input.Keyboard.currentKeyState[key] == 0) up = true;
+    }
 
-#if defined(SUPPORT_COMPRESSION_API)
-    // Compress data and generate a valid DEFLATE stream
-    struct sdefl *sdefl = RL_CALLOC(1, sizeof(struct sdefl));   // WARNING: Possible stack overflow, struct sdefl is almost 1MB
-    int bounds = sdefl_bound(dataSize);
-    compData = (unsigned char *)RL_CALLOC(bounds, 1);
+    return up;
+}
 
-    *compDataSize = sdeflate(sdefl, compData, data, dataSize, COMPRESSION_QUALITY_DEFLATE);   // Compression level 8, same as stbiw
-    RL_FREE(sdefl);
+// Get the last key pressed
+int GetKeyPressed(void)
+{
+    int value = 0;
 
-    TRACELOG(LOG_INFO, "SYSTEM: Compress data: Original size: %i -> Comp. size: %i", dataSize, *compDataSize);
-#endif
+    if (CORE.Input.Keyboard.keyPressedQueueCount > 0)
+    {
+        // Get character from the queue head
+        value = CORE.Input.Keyboard.keyPressedQueue[0];
 
-    return compData;
-}
+        // Shift elements 1 step toward the head
+        for (int i = 0; i < (CORE.Input.Keyboard.keyPressedQueueCount - 1); i++)
+            CORE.Input.Keyboard.keyPressedQueue[i] = CORE.Input.Keyboard.keyPressedQueue[i + 1];
 
-// Decompress data (DEFLATE algorithm)
-unsigned char *DecompressData(const unsigned char *compData, int compDataSize, int *dataSize)
-{
-    unsigned char *data = NULL;
+        // Reset last character in the queue
+        CORE.Input.Keyboard.keyPressedQueue[CORE.Input.Keyboard.keyPressedQueueCount - 1] = 0;
+        CORE.Input.Keyboard.keyPressedQueueCount--;
+    }
 
-#if defined(SUPPORT_COMPRESSION_API)
-    // Decompress data from a valid DEFLATE stream
-    data = (unsigned char *)RL_CALLOC(MAX_DECOMPRESSION_SIZE*1024*1024, 1);
-    int length = sinflate(data, MAX_DECOMPRESSION_SIZE*1024*1024, compData, compDataSize);
+    return value;
+}
 
-    // WARNING: RL_REALLOC can make (and leave) data copies in memory, be careful with sensitive compressed data!
-    // TODO: Use a different approach, create another buffer, copy data manually to it and wipe original buffer memory
-    unsigned char *temp = (unsigned char *)RL_REALLOC(data, length);
+// Get the last char pressed
+int GetCharPressed(void)
+{
+    int value = 0;
 
-    if (temp != NULL) data = temp;
-    else TRACELOG(LOG_WARNING, "SYSTEM: Failed to re-allocate required decompression memory");
+    if (CORE.Input.Keyboard.charPressedQueueCount > 0)
+    {
+        // Get character from the queue head
+        value = CORE.Input.Keyboard.charPressedQueue[0];
 
-    *dataSize = length;
+        // Shift elements 1 step toward the head
+        for (int i = 0; i < (CORE.Input.Keyboard.charPressedQueueCount - 1); i++)
+            CORE.Input.Keyboard.charPressedQueue[i] = CORE.Input.Keyboard.charPressedQueue[i + 1];
 
-    TRACELOG(LOG_INFO, "SYSTEM: Decompress data: Comp. size: %i -> Original size: %i", compDataSize, *dataSize);
-#endif
+        // Reset last character in the queue
+        CORE.Input.Keyboard.charPressedQueue[CORE.Input.Keyboard.charPressedQueueCount - 1] = 0;
+        CORE.Input.Keyboard.charPressedQueueCount--;
+    }
 
-    return data;
+    return value;
 }
 
-// Encode data to Base64 string
-char *EncodeDataBase64(const unsigned char *data, int dataSize, int *outputSize)
+// Set a custom key to exit program
+// NOTE: default exitKey is set to ESCAPE
+void SetExitKey(int key)
 {
-    static const unsigned char base64encodeTable[] = {
-        'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X',
-        'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
-        'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'
-    };
+    CORE.Input.Keyboard.exitKey = key;
+}
 
-    static const int modTable[] = { 0, 2, 1 };
+//----------------------------------------------------------------------------------
+// Module Functions Definition: Input Handling: Gamepad
+//----------------------------------------------------------------------------------
 
-    *outputSize = 4*((dataSize + 2)/3);
+// NOTE: Functions with a platform-specific implementation on rcore_<platform>.c
+//int SetGamepadMappings(const char *mappings)
 
-    char *encodedData = (char *)RL_MALLOC(*outputSize);
+// Check if a gamepad is available
+bool IsGamepadAvailable(int gamepad)
+{
+    bool result = false;
 
-    if (encodedData == NULL) return NULL;   // Security check
+    if ((gamepad < MAX_GAMEPADS) && CORE.Input.Gamepad.ready[gamepad]) result = true;
 
-    for (int i = 0, j = 0; i < dataSize;)
-    {
-        unsigned int octetA = (i < dataSize)? (unsigned char)data[i++] : 0;
-        unsigned int octetB = (i < dataSize)? (unsigned char)data[i++] : 0;
-        unsigned int octetC = (i < dataSize)? (unsigned char)data[i++] : 0;
+    return result;
+}
 
-        unsigned int triple = (octetA << 0x10) + (octetB << 0x08) + octetC;
+// Get gamepad internal name id
+const char *GetGamepadName(int gamepad)
+{
+    return CORE.Input.Gamepad.name[gamepad];
+}
 
-        encodedData[j++] = base64encodeTable[(triple >> 3*6) & 0x3F];
-        encodedData[j++] = base64encodeTable[(triple >> 2*6) & 0x3F];
-        encodedData[j++] = base64encodeTable[(triple >> 1*6) & 0x3F];
-        encodedData[j++] = base64encodeTable[(triple >> 0*6) & 0x3F];
-    }
+// Check if a gamepad button has been pressed once
+bool IsGamepadButtonPressed(int gamepad, int button)
+{
+    bool pressed = false;
 
-    for (int i = 0; i < modTable[dataSize%3]; i++) encodedData[*outputSize - 1 - i] = '=';  // Padding character
+    if ((gamepad < MAX_GAMEPADS) && CORE.Input.Gamepad.ready[gamepad] && (button < MAX_GAMEPAD_BUTTONS) &&
+        (CORE.Input.Gamepad.previousButtonState[gamepad][button] == 0) && (CORE.Input.Gamepad.currentButtonState[gamepad][button] == 1)) pressed = true;
 
-    return encodedData;
+    return pressed;
 }
 
-// Decode Base64 string data
-unsigned char *DecodeDataBase64(const unsigned char *data, int *outputSize)
+// Check if a gamepad button is being pressed
+bool IsGamepadButtonDown(int gamepad, int button)
 {
-    static const unsigned char base64decodeTable[] = {
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 62, 0, 0, 0, 63, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
-        11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 0, 0, 0, 0, 0, 0, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36,
-        37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51
-    };
-
-    // Get output size of Base64 input data
-    int outSize = 0;
-    for (int i = 0; data[4*i] != 0; i++)
-    {
-        if (data[4*i + 3] == '=')
-        {
-            if (data[4*i + 2] == '=') outSize += 1;
-            else outSize += 2;
-        }
-        else outSize += 3;
-    }
+    bool down = false;
 
-    // Allocate memory to store decoded Base64 data
-    unsigned char *decodedData = (unsigned char *)RL_MALLOC(outSize);
+    if ((gamepad < MAX_GAMEPADS) && CORE.Input.Gamepad.ready[gamepad] && (button < MAX_GAMEPAD_BUTTONS) &&
+        (CORE.Input.Gamepad.currentButtonState[gamepad][button] == 1)) down = true;
 
-    for (int i = 0; i < outSize/3; i++)
-    {
-        unsigned char a = base64decodeTable[(int)data[4*i]];
-        unsigned char b = base64decodeTable[(int)data[4*i + 1]];
-        unsigned char c = base64decodeTable[(int)data[4*i + 2]];
-        unsigned char d = base64decodeTable[(int)data[4*i + 3]];
+    return down;
+}
 
-        decodedData[3*i] = (a << 2) | (b >> 4);
-        decodedData[3*i + 1] = (b << 4) | (c >> 2);
-        decodedData[3*i + 2] = (c << 6) | d;
-    }
+// Check if a gamepad button has NOT been pressed once
+bool IsGamepadButtonReleased(int gamepad, int button)
+{
+    bool released = false;
 
-    if (outSize%3 == 1)
-    {
-        int n = outSize/3;
-        unsigned char a = base64decodeTable[(int)data[4*n]];
-        unsigned char b = base64decodeTable[(int)data[4*n + 1]];
-        decodedData[outSize - 1] = (a << 2) | (b >> 4);
-    }
-    else if (outSize%3 == 2)
-    {
-        int n = outSize/3;
-        unsigned char a = base64decodeTable[(int)data[4*n]];
-        unsigned char b = base64decodeTable[(int)data[4*n + 1]];
-        unsigned char c = base64decodeTable[(int)data[4*n + 2]];
-        decodedData[outSize - 2] = (a << 2) | (b >> 4);
-        decodedData[outSize - 1] = (b << 4) | (c >> 2);
-    }
+    if ((gamepad < MAX_GAMEPADS) && CORE.Input.Gamepad.ready[gamepad] && (button < MAX_GAMEPAD_BUTTONS) &&
+        (CORE.Input.Gamepad.previousButtonState[gamepad][button] == 1) && (CORE.Input.Gamepad.currentButtonState[gamepad][button] == 0)) released = true;
 
-    *outputSize = outSize;
-    return decodedData;
+    return released;
 }
 
-// Compute CRC32 hash code
-unsigned int ComputeCRC32(unsigned char *data, int dataSize)
+// Check if a gamepad button is NOT being pressed
+bool IsGamepadButtonUp(int gamepad, int button)
 {
-    static unsigned int crcTable[256] = {
-        0x00000000, 0x77073096, 0xEE0E612C, 0x990951BA, 0x076DC419, 0x706AF48F, 0xE963A535, 0x9E6495A3,
-        0x0eDB8832, 0x79DCB8A4, 0xE0D5E91E, 0x97D2D988, 0x09B64C2B, 0x7EB17CBD, 0xE7B82D07, 0x90BF1D91,
-        0x1DB71064, 0x6AB020F2, 0xF3B97148, 0x84BE41DE, 0x1ADAD47D, 0x6DDDE4EB, 0xF4D4B551, 0x83D385C7,
-        0x136C9856, 0x646BA8C0, 0xFD62F97A, 0x8A65C9EC, 0x14015C4F, 0x63066CD9, 0xFA0F3D63, 0x8D080DF5,
-        0x3B6E20C8, 0x4C69105E, 0xD56041E4, 0xA2677172, 0x3C03E4D1, 0x4B04D447, 0xD20D85FD, 0xA50AB56B,
-        0x35B5A8FA, 0x42B2986C, 0xDBBBC9D6, 0xACBCF940, 0x32D86CE3, 0x45DF5C75, 0xDCD60DCF, 0xABD13D59,
-        0x26D930AC, 0x51DE003A, 0xC8D75180, 0xBFD06116, 0x21B4F4B5, 0x56B3C423, 0xCFBA9599, 0xB8BDA50F,
-        0x2802B89E, 0x5F058808, 0xC60CD9B2, 0xB10BE924, 0x2F6F7C87, 0x58684C11, 0xC1611DAB, 0xB6662D3D,
-        0x76DC4190, 0x01DB7106, 0x98D220BC, 0xEFD5102A, 0x71B18589, 0x06B6B51F, 0x9FBFE4A5, 0xE8B8D433,
-        0x7807C9A2, 0x0F00F934, 0x9609A88E, 0xE10E9818, 0x7F6A0DBB, 0x086D3D2D, 0x91646C97, 0xE6635C01,
-        0x6B6B51F4, 0x1C6C6162, 0x856530D8, 0xF262004E, 0x6C0695ED, 0x1B01A57B, 0x8208F4C1, 0xF50FC457,
-        0x65B0D9C6, 0x12B7E950, 0x8BBEB8EA, 0xFCB9887C, 0x62DD1DDF, 0x15DA2D49, 0x8CD37CF3, 0xFBD44C65,
-        0x4DB26158, 0x3AB551CE, 0xA3BC0074, 0xD4BB30E2, 0x4ADFA541, 0x3DD895D7, 0xA4D1C46D, 0xD3D6F4FB,
-        0x4369E96A, 0x346ED9FC, 0xAD678846, 0xDA60B8D0, 0x44042D73, 0x33031DE5, 0xAA0A4C5F, 0xDD0D7CC9,
-        0x5005713C, 0x270241AA, 0xBE0B1010, 0xC90C2086, 0x5768B525, 0x206F85B3, 0xB966D409, 0xCE61E49F,
-        0x5EDEF90E, 0x29D9C998, 0xB0D09822, 0xC7D7A8B4, 0x59B33D17, 0x2EB40D81, 0xB7BD5C3B, 0xC0BA6CAD,
-        0xEDB88320, 0x9ABFB3B6, 0x03B6E20C, 0x74B1D29A, 0xEAD54739, 0x9DD277AF, 0x04DB2615, 0x73DC1683,
-        0xE3630B12, 0x94643B84, 0x0D6D6A3E, 0x7A6A5AA8, 0xE40ECF0B, 0x9309FF9D, 0x0A00AE27, 0x7D079EB1,
-        0xF00F9344, 0x8708A3D2, 0x1E01F268, 0x6906C2FE, 0xF762575D, 0x806567CB, 0x196C3671, 0x6E6B06E7,
-        0xFED41B76, 0x89D32BE0, 0x10DA7A5A, 0x67DD4ACC, 0xF9B9DF6F, 0x8EBEEFF9, 0x17B7BE43, 0x60B08ED5,
-        0xD6D6A3E8, 0xA1D1937E, 0x38D8C2C4, 0x4FDFF252, 0xD1BB67F1, 0xA6BC5767, 0x3FB506DD, 0x48B2364B,
-        0xD80D2BDA, 0xAF0A1B4C, 0x36034AF6, 0x41047A60, 0xDF60EFC3, 0xA867DF55, 0x316E8EEF, 0x4669BE79,
-        0xCB61B38C, 0xBC66831A, 0x256FD2A0, 0x5268E236, 0xCC0C7795, 0xBB0B4703, 0x220216B9, 0x5505262F,
-        0xC5BA3BBE, 0xB2BD0B28, 0x2BB45A92, 0x5CB36A04, 0xC2D7FFA7, 0xB5D0CF31, 0x2CD99E8B, 0x5BDEAE1D,
-        0x9B64C2B0, 0xEC63F226, 0x756AA39C, 0x026D930A, 0x9C0906A9, 0xEB0E363F, 0x72076785, 0x05005713,
-        0x95BF4A82, 0xE2B87A14, 0x7BB12BAE, 0x0CB61B38, 0x92D28E9B, 0xE5D5BE0D, 0x7CDCEFB7, 0x0BDBDF21,
-        0x86D3D2D4, 0xF1D4E242, 0x68DDB3F8, 0x1FDA836E, 0x81BE16CD, 0xF6B9265B, 0x6FB077E1, 0x18B74777,
-        0x88085AE6, 0xFF0F6A70, 0x66063BCA, 0x11010B5C, 0x8F659EFF, 0xF862AE69, 0x616BFFD3, 0x166CCF45,
-        0xA00AE278, 0xD70DD2EE, 0x4E048354, 0x3903B3C2, 0xA7672661, 0xD06016F7, 0x4969474D, 0x3E6E77DB,
-        0xAED16A4A, 0xD9D65ADC, 0x40DF0B66, 0x37D83BF0, 0xA9BCAE53, 0xDEBB9EC5, 0x47B2CF7F, 0x30B5FFE9,
-        0xBDBDF21C, 0xCABAC28A, 0x53B39330, 0x24B4A3A6, 0xBAD03605, 0xCDD70693, 0x54DE5729, 0x23D967BF,
-        0xB3667A2E, 0xC4614AB8, 0x5D681B02, 0x2A6F2B94, 0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D
-    };
+    bool up = false;
 
-    unsigned int crc = ~0u;
+    if ((gamepad < MAX_GAMEPADS) && CORE.Input.Gamepad.ready[gamepad] && (button < MAX_GAMEPAD_BUTTONS) &&
+        (CORE.Input.Gamepad.currentButtonState[gamepad][button] == 0)) up = true;
 
-    for (int i = 0; i < dataSize; i++) crc = (crc >> 8) ^ crcTable[data[i] ^ (crc & 0xff)];
+    return up;
+}
 
-    return ~crc;
+// Get the last gamepad button pressed
+int GetGamepadButtonPressed(void)
+{
+    return CORE.Input.Gamepad.lastButtonPressed;
 }
 
-// Compute MD5 hash code
-// NOTE: Returns a static int[4] array (16 bytes)
-unsigned int *ComputeMD5(unsigned char *data, int dataSize)
+// Get gamepad axis count
+int GetGamepadAxisCount(int gamepad)
 {
-    #define ROTATE_LEFT(x, c) (((x) << (c)) | ((x) >> (32 - (c))))
+    return CORE.Input.Gamepad.axisCount[gamepad];
+}
 
-    static unsigned int hash[4] = { 0 };  // Hash to be returned
+// Get axis movement vector for a gamepad
+float GetGamepadAxisMovement(int gamepad, int axis)
+{
+    float value = (axis == GAMEPAD_AXIS_LEFT_TRIGGER || axis == GAMEPAD_AXIS_RIGHT_TRIGGER)? -1.0f : 0.0f;
 
-    // WARNING: All variables are unsigned 32 bit and wrap modulo 2^32 when calculating
+    if ((gamepad < MAX_GAMEPADS) && CORE.Input.Gamepad.ready[gamepad] && (axis < MAX_GAMEPAD_AXIS)) {
+        float movement = value < 0.0f ? CORE.Input.Gamepad.axisState[gamepad][axis] : fabsf(CORE.Input.Gamepad.axisState[gamepad][axis]);
 
-    // NOTE: r specifies the per-round shift amounts
-    unsigned int r[] = {
-        7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
-        5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20,
-        4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
-        6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
-    };
+        if (movement > value) value = CORE.Input.Gamepad.axisState[gamepad][axis];
+    }
 
-    // Using binary integer part of the sines of integers (in radians) as constants
-    unsigned int k[] = {
-        0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee,
-        0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
-        0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
-        0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
-        0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa,
-        0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
-        0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed,
-        0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
-        0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
-        0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
-        0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05,
-        0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
-        0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039,
-        0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
-        0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
-        0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
-    };
+    return value;
+}
 
-    hash[0] = 0x67452301;
-    hash[1] = 0xefcdab89;
-    hash[2] = 0x98badcfe;
-    hash[3] = 0x10325476;
+//----------------------------------------------------------------------------------
+// Module Functions Definition: Input Handling: Mouse
+//----------------------------------------------------------------------------------
 
-    // Pre-processing: adding a single 1 bit
-    // Append '1' bit to message
-    // NOTE: The input bytes are considered as bits strings,
-    // where the first bit is the most significant bit of the byte
+// NOTE: Functions with a platform-specific implementation on rcore_<platform>.c
+//void SetMousePosition(int x, int y)
+//void SetMouseCursor(int cursor)
 
-    // Pre-processing: padding with zeros
-    // Append '0' bit until message length in bit 448 (mod 512)
-    // Append length mod (2 pow 64) to message
+// Check if a mouse button has been pressed once
+bool IsMouseButtonPressed(int button)
+{
+    bool pressed = false;
 
-    int newDataSize = ((((dataSize + 8)/64) + 1)*64) - 8;
+    if ((CORE.Input.Mouse.currentButtonState[button] == 1) && (CORE.Input.Mouse.previousButtonState[button] == 0)) pressed = true;
 
-    unsigned char *msg = RL_CALLOC(newDataSize + 64, 1); // Initialize with '0' bits, allocating 64 extra bytes
-    memcpy(msg, data, dataSize);
-    msg[dataSize] = 128; // Write the '1' bit
+    // Map touches to mouse buttons checking
+    if ((CORE.Input.Touch.currentTouchState[button] == 1) && (CORE.Input.Touch.previousTouchState[button] == 0)) pressed = true;
 
-    unsigned int bitsLen = 8*dataSize;
-    memcpy(msg + newDataSize, &bitsLen, 4); // Append the len in bits at the end of the buffer
+    return pressed;
+}
 
-    // Process the message in successive 512-bit chunks for each 512-bit chunk of message
-    for (int offset = 0; offset < newDataSize; offset += (512/8))
-    {
-        // Break chunk into sixteen 32-bit words w[j], 0 <= j <= 15
-        unsigned int *w = (unsigned int *)(msg + offset);
+// Check if a mouse button is being pressed
+bool IsMouseButtonDown(int button)
+{
+    bool down = false;
 
-        // Initialize hash value for this chunk
-        unsigned int a = hash[0];
-        unsigned int b = hash[1];
-        unsigned int c = hash[2];
-        unsigned int d = hash[3];
+    if (CORE.Input.Mouse.currentButtonState[button] == 1) down = true;
 
-        for (int i = 0; i < 64; i++)
-        {
-            unsigned int f = 0;
-            unsigned int g = 0;
+    // NOTE: Touches are considered like mouse buttons
+    if (CORE.Input.Touch.currentTouchState[button] == 1) down = true;
 
-            if (i < 16)
-            {
-                f = (b & c) | ((~b) & d);
-                g = i;
-            }
-            else if (i < 32)
-            {
-                f = (d & b) | ((~d) & c);
-                g = (5*i + 1)%16;
-            }
-            else if (i < 48)
-            {
-                f = b ^ c ^ d;
-                g = (3*i + 5)%16;
-            }
-            else
-            {
-                f = c ^ (b | (~d));
-                g = (7*i)%16;
-            }
+    return down;
+}
 
-            unsigned int temp = d;
-            d = c;
-            c = b;
-            b = b + ROTATE_LEFT((a + f + k[i] + w[g]), r[i]);
-            a = temp;
-        }
+// Check if a mouse button has been released once
+bool IsMouseButtonReleased(int button)
+{
+    bool released = false;
 
-        // Add chunk's hash to result so far
-        hash[0] += a;
-        hash[1] += b;
-        hash[2] += c;
-        hash[3] += d;
-    }
+    if ((CORE.Input.Mouse.currentButtonState[button] == 0) && (CORE.Input.Mouse.previousButtonState[button] == 1)) released = true;
 
-    RL_FREE(msg);
+    // Map touches to mouse buttons checking
+    if ((CORE.Input.Touch.currentTouchState[button] == 0) && (CORE.Input.Touch.previousTouchState[button] == 1)) released = true;
 
-    return hash;
+    return released;
 }
 
-// Compute SHA-1 hash code
-// NOTE: Returns a static int[5] array (20 bytes)
-unsigned int *ComputeSHA1(unsigned char *data, int dataSize) {
-    #define ROTATE_LEFT(x, c) (((x) << (c)) | ((x) >> (32 - (c))))
+// Check if a mouse button is NOT being pressed
+bool IsMouseButtonUp(int button)
+{
+    bool up = false;
 
-    static unsigned int hash[5] = { 0 };  // Hash to be returned
+    if (CORE.Input.Mouse.currentButtonState[button] == 0) up = true;
 
-    // Initialize hash values
-    hash[0] = 0x67452301;
-    hash[1] = 0xEFCDAB89;
-    hash[2] = 0x98BADCFE;
-    hash[3] = 0x10325476;
-    hash[4] = 0xC3D2E1F0;
+    // NOTE: Touches are considered like mouse buttons
+    if (CORE.Input.Touch.currentTouchState[button] == 0) up = true;
 
-    // Pre-processing: adding a single 1 bit
-    // Append '1' bit to message
-    // NOTE: The input bytes are considered as bits strings,
-    // where the first bit is the most significant bit of the byte
+    return up;
+}
 
-    // Pre-processing: padding with zeros
-    // Append '0' bit until message length in bit 448 (mod 512)
-    // Append length mod (2 pow 64) to message
+// Get mouse position X
+int GetMouseX(void)
+{
+    int mouseX = (int)((CORE.Input.Mouse.currentPosition.x + CORE.Input.Mouse.offset.x)*CORE.Input.Mouse.scale.x);
+    return mouseX;
+}
 
-    int newDataSize = ((((dataSize + 8)/64) + 1)*64);
+// Get mouse position Y
+int GetMouseY(void)
+{
+    int mouseY = (int)((CORE.Input.Mouse.currentPosition.y + CORE.Input.Mouse.offset.y)*CORE.Input.Mouse.scale.y);
+    return mouseY;
+}
 
-    unsigned char *msg = RL_CALLOC(newDataSize, 1); // Initialize with '0' bits
-    memcpy(msg, data, dataSize);
-    msg[dataSize] = 128; // Write the '1' bit
+// Get mouse position XY
+Vector2 GetMousePosition(void)
+{
+    Vector2 position = { 0 };
 
-    unsigned int bitsLen = 8*dataSize;
-    msg[newDataSize-1] = bitsLen;
+    position.x = (CORE.Input.Mouse.currentPosition.x + CORE.Input.Mouse.offset.x)*CORE.Input.Mouse.scale.x;
+    position.y = (CORE.Input.Mouse.currentPosition.y + CORE.Input.Mouse.offset.y)*CORE.Input.Mouse.scale.y;
 
-    // Process the message in successive 512-bit chunks
-    for (int offset = 0; offset < newDataSize; offset += (512/8))
-    {
-        // Break chunk into sixteen 32-bit words w[j], 0 <= j <= 15
-        unsigned int w[80] = {0};
-        for (int i = 0; i < 16; i++) {
-            w[i] = (msg[offset + (i * 4) + 0] << 24) |
-                   (msg[offset + (i * 4) + 1] << 16) |
-                   (msg[offset + (i * 4) + 2] << 8) |
-                   (msg[offset + (i * 4) + 3]);
-        }
+    return position;
+}
 
-        // Message schedule: extend the sixteen 32-bit words into eighty 32-bit words:
-        for (int i = 16; i < 80; ++i) {
-            w[i] = ROTATE_LEFT(w[i-3] ^ w[i-8] ^ w[i-14] ^ w[i-16], 1);
-        }
+// Get mouse delta between frames
+Vector2 GetMouseDelta(void)
+{
+    Vector2 delta = { 0 };
 
-        // Initialize hash value for this chunk
-        unsigned int a = hash[0];
-        unsigned int b = hash[1];
-        unsigned int c = hash[2];
-        unsigned int d = hash[3];
-        unsigned int e = hash[4];
+    delta.x = CORE.Input.Mouse.currentPosition.x - CORE.Input.Mouse.previousPosition.x;
+    delta.y = CORE.Input.Mouse.currentPosition.y - CORE.Input.Mouse.previousPosition.y;
 
-        for (int i = 0; i < 80; i++)
-        {
-            unsigned int f = 0;
-            unsigned int k = 0;
+    return delta;
+}
 
-            if (i < 20) {
-                f = (b & c) | ((~b) & d);
-                k = 0x5A827999;
-            } else if (i < 40) {
-                f = b ^ c ^ d;
-                k = 0x6ED9EBA1;
-            } else if (i < 60) {
-                f = (b & c) | (b & d) | (c & d);
-                k = 0x8F1BBCDC;
-            } else {
-                f = b ^ c ^ d;
-                k = 0xCA62C1D6;
-            }
+// Set mouse offset
+// NOTE: Useful when rendering to different size targets
+void SetMouseOffset(int offsetX, int offsetY)
+{
+    CORE.Input.Mouse.offset = (Vector2){ (float)offsetX, (float)offsetY };
+}
 
-            unsigned int temp = ROTATE_LEFT(a, 5) + f + e + k + w[i];
-            e = d;
-            d = c;
-            c = ROTATE_LEFT(b, 30);
-            b = a;
-            a = temp;
-        }
+// Set mouse scaling
+// NOTE: Useful when rendering to different size targets
+void SetMouseScale(float scaleX, float scaleY)
+{
+    CORE.Input.Mouse.scale = (Vector2){ scaleX, scaleY };
+}
 
-        // Add this chunk's hash to result so far
-        hash[0] += a;
-        hash[1] += b;
-        hash[2] += c;
-        hash[3] += d;
-        hash[4] += e;
-    }
+// Get mouse wheel movement Y
+float GetMouseWheelMove(void)
+{
+    float result = 0.0f;
 
-    free(msg);
+    if (fabsf(CORE.Input.Mouse.currentWheelMove.x) > fabsf(CORE.Input.Mouse.currentWheelMove.y)) result = (float)CORE.Input.Mouse.currentWheelMove.x;
+    else result = (float)CORE.Input.Mouse.currentWheelMove.y;
 
-    return hash;
+    return result;
 }
 
-//----------------------------------------------------------------------------------
-// Module Functions Definition: Automation Events Recording and Playing
-//----------------------------------------------------------------------------------
-
-// Load automation events list from file, NULL for empty list, capacity = MAX_AUTOMATION_EVENTS
-AutomationEventList LoadAutomationEventList(const char *fileName)
+// Get mouse wheel movement X/Y as a vector
+Vector2 GetMouseWheelMoveV(void)
 {
-    AutomationEventList list = { 0 };
+    Vector2 result = { 0 };
 
-    // Allocate and empty automation event list, ready to record new events
-    list.events = (AutomationEvent *)RL_CALLOC(MAX_AUTOMATION_EVENTS, sizeof(AutomationEvent));
-    list.capacity = MAX_AUTOMATION_EVENTS;
+    result = CORE.Input.Mouse.currentWheelMove;
 
-#if defined(SUPPORT_AUTOMATION_EVENTS)
-    if (fileName == NULL) TRACELOG(LOG_INFO, "AUTOMATION: New empty events list loaded successfully");
-    else
-    {
-        // Load automation events file (binary)
-        /*
-        //int dataSize = 0;
-        //unsigned char *data = LoadFileData(fileName, &dataSize);
+    return result;
+}
 
-        FILE *raeFile = fopen(fileName, "rb");
-        unsigned char fileId[4] = { 0 };
+//----------------------------------------------------------------------------------
+// Module Functions Definition: Input Handling: Touch
+//----------------------------------------------------------------------------------
 
-        fread(fileId, 1, 4, raeFile);
+// Get touch position X for touch point 0 (relative to screen size)
+int GetTouchX(void)
+{
+    int touchX = (int)CORE.Input.Touch.position[0].x;
+    return touchX;
+}
 
-        if ((fileId[0] == 'r') && (fileId[1] == 'A') && (fileId[2] == 'E') && (fileId[1] == ' '))
-        {
-            fread(&eventCount, sizeof(int), 1, raeFile);
-            TRACELOG(LOG_WARNING, "Events loaded: %i\n", eventCount);
-            fread(events, sizeof(AutomationEvent), eventCount, raeFile);
-        }
+// Get touch position Y for touch point 0 (relative to screen size)
+int GetTouchY(void)
+{
+    int touchY = (int)CORE.Input.Touch.position[0].y;
+    return touchY;
+}
 
-        fclose(raeFile);
-        */
+// Get touch position XY for a touch point index (relative to screen size)
+// TODO: Touch position should be scaled depending on display size and render size
+Vector2 GetTouchPosition(int index)
+{
+    Vector2 position = { -1.0f, -1.0f };
 
-        // Load events file (text)
-        //unsigned char *buffer = LoadFileText(fileName);
-        FILE *raeFile = fopen(fileName, "rt");
+    if (index < MAX_TOUCH_POINTS) position = CORE.Input.Touch.position[index];
+    else TRACELOG(LOG_WARNING, "INPUT: Required touch point out of range (Max touch points: %i)", MAX_TOUCH_POINTS);
 
-        if (raeFile != NULL)
-        {
-            unsigned int counter = 0;
-            char buffer[256] = { 0 };
-            char eventDesc[64] = { 0 };
+    return position;
+}
 
-            fgets(buffer, 256, raeFile);
+// Get touch point identifier for given index
+int GetTouchPointId(int index)
+{
+    int id = -1;
 
-            while (!feof(raeFile))
-            {
-                switch (buffer[0])
-                {
-                    case 'c': sscanf(buffer, "c %i", &list.count); break;
-                    case 'e':
-                    {
-                        sscanf(buffer, "e %d %d %d %d %d %d %[^\n]s", &list.events[counter].frame, &list.events[counter].type,
-                               &list.events[counter].params[0], &list.events[counter].params[1], &list.events[counter].params[2], &list.events[counter].params[3], eventDesc);
+    if (index < MAX_TOUCH_POINTS) id = CORE.Input.Touch.pointId[index];
 
-                        counter++;
-                    } break;
-                    default: break;
-                }
+    return id;
+}
 
-                fgets(buffer, 256, raeFile);
-            }
+// Get number of touch points
+int GetTouchPointCount(void)
+{
+    return CORE.Input.Touch.pointCount;
+}
 
-            if (counter != list.count)
-            {
-                TRACELOG(LOG_WARNING, "AUTOMATION: Events read from file [%i] do not mach event count specified [%i]", counter, list.count);
-                list.count = counter;
-            }
+// Get last touch samples of a pointer identifier, oldest first (returns samples count)
+// NOTE: History of a released pointer is kept until the identifier is pressed again
+int GetTouchHistory(int id, TouchSample *samples, int maxSamples)
+{
+    int count = 0;
 
-            fclose(raeFile);
+#if defined(SUPPORT_TOUCH_HISTORY)
+    if ((id < 0) || (id >= MAX_TOUCH_POINTS)) return 0;
 
-            TRACELOG(LOG_INFO, "AUTOMATION: Events file loaded successfully");
-        }
+    const TouchHistory *history = &touchHistory[id];
+    count = (history->count < maxSamples)? history->count : maxSamples;
 
-        TRACELOG(LOG_INFO, "AUTOMATION: Events loaded from file: %i", list.count);
-    }
+    for (int i = 0; i < count; i++) samples[i] = history->samples[(history->head - count + i + MAX_TOUCH_HISTORY)%MAX_TOUCH_HISTORY];
 #endif
-    return list;
-}
 
-// Unload automation events list from file
-void UnloadAutomationEventList(AutomationEventList list)
-{
-#if defined(SUPPORT_AUTOMATION_EVENTS)
-    RL_FREE(list.events);
-#endif
+    return count;
 }
 
-// Export automation events list as text file
-bool ExportAutomationEventList(AutomationEventList list, const char *fileName)
+// Get touch velocity of a pointer identifier (pixels/second), fitted over its last 'window' seconds
+// NOTE: Least squares line through the samples, so one noisy sample doesn't decide a flick
+Vector2 GetTouchVelocity(int id, float window)
 {
-    bool success = false;
+    Vector2 velocity = { 0.0f, 0.0f };
 
-#if defined(SUPPORT_AUTOMATION_EVENTS)
-    // Export events as binary file
-    // TODO: Save to memory buffer and SaveFileData()
-    /*
-    unsigned char fileId[4] = "rAE ";
-    FILE *raeFile = fopen(fileName, "wb");
-    fwrite(fileId, sizeof(unsigned char), 4, raeFile);
-    fwrite(&eventCount, sizeof(int), 1, raeFile);
-    fwrite(events, sizeof(AutomationEvent), eventCount, raeFile);
-    fclose(raeFile);
-    */
+#if defined(SUPPORT_TOUCH_HISTORY)
+    TouchSample samples[MAX_TOUCH_HISTORY];
+    int count = GetTouchHistory(id, samples, MAX_TOUCH_HISTORY);
+    if (count < 2) return velocity;
 
-    // Export events as text
-    // TODO: Save to memory buffer and SaveFileText()
-    char *txtData = (char *)RL_CALLOC(256*list.count + 2048, sizeof(char)); // 256 characters per line plus some header
+    int first = count - 1;
+    while ((first > 0) && (samples[count - 1].time - samples[first - 1].time <= window)) first--;
 
-    int byteCount = 0;
-    byteCount += sprintf(txtData + byteCount, "#\n");
-    byteCount += sprintf(txtData + byteCount, "# Automation events exporter v1.0 - raylib automation events list\n");
-    byteCount += sprintf(txtData + byteCount, "#\n");
-    byteCount += sprintf(txtData + byteCount, "#    c <events_count>\n");
-    byteCount += sprintf(txtData + byteCount, "#    e <frame> <event_type> <param0> <param1> <param2> <param3> // <event_type_name>\n");
-    byteCount += sprintf(txtData + byteCount, "#\n");
-    byteCount += sprintf(txtData + byteCount, "# more info and bugs-report:  github.com/raysan5/raylib\n");
-    byteCount += sprintf(txtData + byteCount, "# feedback and support:       ray[at]raylib.com\n");
-    byteCount += sprintf(txtData + byteCount, "#\n");
-    byteCount += sprintf(txtData + byteCount, "# Copyright (c) 2023-2024 Ramon Santamaria (@raysan5)\n");
-    byteCount += sprintf(txtData + byteCount, "#\n\n");
+    int n = count - first;
+    if (n < 2) return velocity;
 
-    // Add events data
-    byteCount += sprintf(txtData + byteCount, "c %i\n", list.count);
-    for (unsigned int i = 0; i < list.count; i++)
+    // Times relative to the last sample, keeps the sums precise
+    double t0 = samples[count - 1].time;
+    double st = 0.0, sx = 0.0, sy = 0.0, stt = 0.0, stx = 0.0, sty = 0.0;
+    for (int i = first; i < count; i++)
     {
-        byteCount += snprintf(txtData + byteCount, 256, "e %i %i %i %i %i %i // Event: %s\n", list.events[i].frame, list.events[i].type,
-            list.events[i].params[0], list.events[i].params[1], list.events[i].params[2], list.events[i].params[3], autoEventTypeName[list.events[i].type]);
+        double t = samples[i].time - t0;
+        st += t; sx += samples[i].position.x; sy += samples[i].position.y;
+        stt += t*t; stx += t*samples[i].position.x; sty += t*samples[i].position.y;
     }
 
-    // NOTE: Text data size exported is determined by '\0' (NULL) character
-    success = SaveFileText(fileName, txtData);
-
-    RL_FREE(txtData);
+    double d = n*stt - st*st;
+    if (d > 0.0) velocity = (Vector2){ (float)((n*stx - st*sx)/d), (float)((n*sty - st*sy)/d) };
 #endif
 
-    return success;
+    return velocity;
 }
 
-// Setup automation event list to record to
-void SetAutomationEventList(AutomationEventList *list)
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// NOTE: Functions with a platform-specific implementation on rcore_<platform>.c
+//int InitPlatform(void)
+//void ClosePlatform(void)
+
+// Initialize hi-resolution timer
+void InitTimer(void)
 {
-#if defined(SUPPORT_AUTOMATION_EVENTS)
-    currentEventList = list;
+    // Setting a higher resolution can improve the accuracy of time-out intervals in wait functions
+    // However, it can also reduce overall system performance, because the thread scheduler switches tasks more often
+    // High resolutions can also prevent the CPU power management system from entering power-saving modes
+    // Setting a higher resolution does not improve the accuracy of the high-resolution performance counter
+#if defined(_WIN32) && defined(SUPPORT_WINMM_HIGHRES_TIMER) && !defined(SUPPORT_BUSY_WAIT_LOOP) && !defined(PLATFORM_DESKTOP_SDL)
+    timeBeginPeriod(1);                 // Setup high-resolution timer to 1ms (granularity of 1-2 ms)
 #endif
-}
 
-// Set automation event internal base frame to start recording
-void SetAutomationEventBaseFrame(int frame)
-{
-    CORE.Time.frameCounter = frame;
-}
+#if defined(__linux__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__EMSCRIPTEN__)
+    struct timespec now = { 0 };
 
-// Start recording automation events (AutomationEventList must be set)
-void StartAutomationEventRecording(void)
-{
-#if defined(SUPPORT_AUTOMATION_EVENTS)
-    automationEventRecording = true;
+    if (clock_gettime(CLOCK_MONOTONIC, &now) == 0)  // Success
+    {
+        CORE.Time.base = (unsigned long long int)now.tv_sec*1000000000LLU + (unsigned long long int)now.tv_nsec;
+    }
+    else TRACELOG(LOG_WARNING, "TIMER: Hi-resolution timer not available");
 #endif
+
+    CORE.Time.previous = GetTime();     // Get time as double
 }
 
-// Stop recording automation events
-void StopAutomationEventRecording(void)
+// Set viewport for a provided width and height
+void SetupViewport(int width, int height)
 {
-#if defined(SUPPORT_AUTOMATION_EVENTS)
-    automationEventRecording = false;
+    CORE.Window.render.width = width;
+    CORE.Window.render.height = height;
+
+    // Set viewport width and height
+    // NOTE: We consider render size (scaled) and offset in case black bars are required and
+    // render area does not match full display area (this situation is only applicable on fullscreen mode)
+#if defined(__APPLE__)
+    Vector2 scale = GetWindowScaleDPI();
+    rlViewport(CORE.Window.renderOffset.x/2*scale.x, CORE.Window.renderOffset.y/2*scale.y, (CORE.Window.render.width)*scale.x, (CORE.Window.render.height)*scale.y);
+#else
+    rlViewport(CORE.Window.renderOffset.x/2, CORE.Window.renderOffset.y/2, CORE.Window.render.width, CORE.Window.render.height);
 #endif
+
+    rlMatrixMode(RL_PROJECTION);        // Switch to projection matrix
+    rlLoadIdentity();                   // Reset current matrix (projection)
+
+    // Set orthographic projection to current framebuffer size
+    // NOTE: Configured top-left corner as (0, 0)
+    rlOrtho(0, CORE.Window.render.width, CORE.Window.render.height, 0, 0.0f, 1.0f);
+
+    rlMatrixMode(RL_MODELVIEW);         // Switch back to modelview matrix
+    rlLoadIdentity();                   // Reset current matrix (modelview)
 }
 
-// Play a recorded automation event
-void PlayAutomationEvent(AutomationEvent event)
+// Compute framebuffer size relative to screen size and display size
+// NOTE: Global variables CORE.Window.render.width/CORE.Window.render.height and CORE.Window.renderOffset.x/CORE.Window.renderOffset.y can be modified
+void SetupFramebuffer(int width, int height)
 {
-#if defined(SUPPORT_AUTOMATION_EVENTS)
-    // WARNING: When should event be played? After/before/replace PollInputEvents()? -> Up to the user!
-
-    if (!automationEventRecording)      // TODO: Allow recording events while playing?
+    // Calculate CORE.Window.render.width and CORE.Window.render.height, we have the display size (input params) and the desired screen size (global var)
+    if ((CORE.Window.screen.width > CORE.Window.display.width) || (CORE.Window.screen.height > CORE.Window.display.height))
     {
-        switch (event.type)
-        {
-            // Input event
-            case INPUT_KEY_UP: CORE.Input.Keyboard.currentKeyState[event.params[0]] = false; break;             // param[0]: key
-            case INPUT_KEY_DOWN: {                                                                              // param[0]: key
-                CORE.Input.Keyboard.currentKeyState[event.params[0]] = true;
+        TRACELOG(LOG_WARNING, "DISPLAY: Downscaling required: Screen size (%ix%i) is bigger than display size (%ix%i)", CORE.Window.screen.width, CORE.Window.screen.height, CORE.Window.display.width, CORE.Window.display.height);
 
-                if (CORE.Input.Keyboard.previousKeyState[event.params[0]] == false)
-                {
-                    if (CORE.Input.Keyboard.keyPressedQueueCount < MAX_KEY_PRESSED_QUEUE)
-                    {
-                        // Add character to the queue
-                        CORE.Input.Keyboard.keyPressedQueue[CORE.Input.Keyboard.keyPressedQueueCount] = event.params[0];
-                        CORE.Input.Keyboard.keyPressedQueueCount++;
-                    }
-                }
-            } break;
-            case INPUT_MOUSE_BUTTON_UP: CORE.Input.Mouse.currentButtonState[event.params[0]] = false; break;    // param[0]: key
-            case INPUT_MOUSE_BUTTON_DOWN: CORE.Input.Mouse.currentButtonState[event.params[0]] = true; break;   // param[0]: key
-            case INPUT_MOUSE_POSITION:      // param[0]: x, param[1]: y
-            {
-                CORE.Input.Mouse.currentPosition.x = (float)event.params[0];
-                CORE.Input.Mouse.currentPosition.y = (float)event.params[1];
-            } break;
-            case INPUT_MOUSE_WHEEL_MOTION:  // param[0]: x delta, param[1]: y delta
-            {
-                CORE.Input.Mouse.currentWheelMove.x = (float)event.params[0];
-                CORE.Input.Mouse.currentWheelMove.y = (float)event.params[1];
-            } break;
-            case INPUT_TOUCH_UP: CORE.Input.Touch.currentTouchState[event.params[0]] = false; break;            // param[0]: id
-            case INPUT_TOUCH_DOWN: CORE.Input.Touch.currentTouchState[event.params[0]] = true; break;           // param[0]: id
-            case INPUT_TOUCH_POSITION:      // param[0]: id, param[1]: x, param[2]: y
-            {
-                CORE.Input.Touch.position[event.params[0]].x = (float)event.params[1];
-                CORE.Input.Touch.position[event.params[0]].y = (float)event.params[2];
-            } break;
-            case INPUT_GAMEPAD_CONNECT: CORE.Input.Gamepad.ready[event.params[0]] = true; break;                // param[0]: gamepad
-            case INPUT_GAMEPAD_DISCONNECT: CORE.Input.Gamepad.ready[event.params[0]] = false; break;            // param[0]: gamepad
-            case INPUT_GAMEPAD_BUTTON_UP: CORE.Input.Gamepad.currentButtonState[event.params[0]][event.params[1]] = false; break;    // param[0]: gamepad, param[1]: button
-            case INPUT_GAMEPAD_BUTTON_DOWN: CORE.Input.Gamepad.currentButtonState[event.params[0]][event.params[1]] = true; break;   // param[0]: gamepad, param[1]: button
-            case INPUT_GAMEPAD_AXIS_MOTION: // param[0]: gamepad, param[1]: axis, param[2]: delta
-            {
-                CORE.Input.Gamepad.axisState[event.params[0]][event.params[1]] = ((float)event.params[2]/32768.0f);
-            } break;
-    #if defined(SUPPORT_GESTURES_SYSTEM)
-            case INPUT_GESTURE: GESTURES.current = event.params[0]; break;     // param[0]: gesture (enum Gesture) -> rgestures.h: GESTURES.current
-    #endif
-            // Window event
-            case WINDOW_CLOSE: CORE.Window.shouldClose = true; break;
-            case WINDOW_MAXIMIZE: MaximizeWindow(); break;
-            case WINDOW_MINIMIZE: MinimizeWindow(); break;
-            case WINDOW_RESIZE: SetWindowSize(event.params[0], event.params[1]); break;
+        // Downscaling to fit display with border-bars
+        float widthRatio = (float)CORE.Window.display.width/(float)CORE.Window.screen.width;
+        float heightRatio = (float)CORE.Window.display.height/(float)CORE.Window.screen.height;
 
-            // Custom event
-    #if defined(SUPPORT_SCREEN_CAPTURE)
-            case ACTION_TAKE_SCREENSHOT:
-            {
-                TakeScreenshot(TextFormat("screenshot%03i.png", screenshotCounter));
-                screenshotCounter++;
-            } break;
-    #endif
-            case ACTION_SETTARGETFPS: SetTargetFPS(event.params[0]); break;
-            default: break;
+        if (widthRatio <= heightRatio)
+        {
+            CORE.Window.render.width = CORE.Window.display.width;
+            CORE.Window.render.height = (int)round((float)CORE.Window.screen.height*widthRatio);
+            CORE.Window.renderOffset.x = 0;
+            CORE.Window.renderOffset.y = (CORE.Window.display.height - CORE.Window.render.height);
+        }
+        else
+        {
+            CORE.Window.render.width = (int)round((float)CORE.Window.screen.width*heightRatio);
+            CORE.Window.render.height = CORE.Window.display.height;
+            CORE.Window.renderOffset.x = (CORE.Window.display.width - CORE.Window.render.width);
+            CORE.Window.renderOffset.y = 0;
         }
 
-        TRACELOG(LOG_INFO, "AUTOMATION PLAY: Frame: %i | Event type: %i | Event parameters: %i, %i, %i", event.frame, event.type, event.params[0], event.params[1], event.params[2]);
-    }
-#endif
-}
+        // Screen scaling required
+        float scaleRatio = (float)CORE.Window.render.width/(float)CORE.Window.screen.width;
+        CORE.Window.screenScale = MatrixScale(scaleRatio, scaleRatio, 1.0f);
 
-//----------------------------------------------------------------------------------
-// Module Functions Definition: Input Handling: Keyboard
-//----------------------------------------------------------------------------------
+        // NOTE: We render to full display resolution!
+        // We just need to calculate above parameters for downscale matrix and offsets
+        CORE.Window.render.width = CORE.Window.display.width;
+        CORE.Window.render.height = CORE.Window.display.height;
 
-// Check if a key has been pressed once
-bool IsKeyPressed(int key)
-{
+        TRACELOG(LOG_WARNING, "DISPLAY: Downscale matrix generated, content will be rendered at (%ix%i)", CORE.Window.render.width, CORE.Window.render.height);
+    }
+    else if ((CORE.Window.screen.width < CORE.Window.display.width) || (CORE.Window.screen.height < CORE.Window.display.height))
+    {
+        // Required screen size is smaller than display size
+        TRACELOG(LOG_INFO, "DISPLAY: Upscaling required: Screen size (%ix%i) smaller than display size (%ix%i)", CORE.Window.screen.width, CORE.Window.screen.height, CORE.Window.display.width, CORE.Window.display.height);
 
-    bool pressed = false;
+        if ((CORE.Window.screen.width == 0) || (CORE.Window.screen.height == 0))
+        {
+            CORE.Window.screen.width = CORE.Window.display.width;
+            CORE.Window.screen.height = CORE.Window.display.height;
+        }
 
-    if ((key > 0) && (key < MAX_KEYBOARD_KEYS))
+        // Upscaling to fit display with border-bars
+        float displayRatio = (float)CORE.Window.display.width/(float)CORE.Window.display.height;
+        float screenRatio = (float)CORE.Window.screen.width/(float)CORE.Window.screen.height;
+
+        if (displayRatio <= screenRatio)
+        {
+            CORE.Window.render.width = CORE.Window.screen.width;
+            CORE.Window.render.height = (int)round((float)CORE.Window.screen.width/displayRatio);
+            CORE.Window.renderOffset.x = 0;
+            CORE.Window.renderOffset.y = (CORE.Window.render.height - CORE.Window.screen.height);
+        }
+        else
+        {
+            CORE.Window.render.width = (int)round((float)CORE.Window.screen.height*displayRatio);
+            CORE.Window.render.height = CORE.Window.screen.height;
+            CORE.Window.renderOffset.x = (CORE.Window.render.width - CORE.Window.screen.width);
+            CORE.Window.renderOffset.y = 0;
+        }
+    }
+    else
     {
-        if ((CORE.Input.Keyboard.previousKeyState[key] == 0) && (CORE.Input.Keyboard.currentKeyState[key] == 1)) pressed = true;
+        CORE.Window.render.width = CORE.Window.screen.width;
+        CORE.Window.render.height = CORE.Window.screen.height;
+        CORE.Window.renderOffset.x = 0;
+        CORE.Window.renderOffset.y = 0;
     }
-
-    return pressed;
 }
 
-// Check if a key has been pressed again
-bool IsKeyPressedRepeat(int key)
+#if defined(SUPPORT_SHADER_CACHE)
+// Load shader program binary from the cache directory (rlgl callback)
+static unsigned char *LoadShaderCacheData(unsigned long long key, int *dataSize)
 {
-    bool repeat = false;
+    const char *fileName = TextFormat("%s/shader_%016llx.bin", shaderCacheDir, key);
 
-    if ((key > 0) && (key < MAX_KEYBOARD_KEYS))
-    {
-        if (CORE.Input.Keyboard.keyRepeatInFrame[key] == 1) repeat = true;
-    }
+    // NOTE: A missing binary is the normal first run case, not a warning
+    if (!FileExists(fileName)) return NULL;
 
-    return repeat;
+    return LoadFileData(fileName, dataSize);
 }
 
-// Check if a key is being pressed (key held down)
-bool IsKeyDown(int key)
+// Save shader program binary into the cache directory (rlgl callback)
+static void SaveShaderCacheData(unsigned long long key, const unsigned char *data, int dataSize)
 {
-    bool down = false;
-
-    if ((key > 0) && (key < MAX_KEYBOARD_KEYS))
-    {
-        if (CORE.Input.Keyboard.currentKeyState[key] == 1) down = true;
-    }
-
-    return down;
+    SaveFileData(TextFormat("%s/shader_%016llx.bin", shaderCacheDir, key), (void *)data, dataSize);
 }
+#endif
 
-// Check if a key has been released once
-bool IsKeyReleased(int key)
+// Scan all files and directories in a base path
+// WARNING: files.paths[] must be previously allocated and
+// contain enough space to store all required paths
+static void ScanDirectoryFiles(const char *basePath, FilePathList *files, const char *filter)
 {
-    bool released = false;
+    static char path[MAX_FILEPATH_LENGTH] = { 0 };
+    memset(path, 0, MAX_FILEPATH_LENGTH);
 
-    if ((key > 0) && (key < MAX_KEYBOARD_KEYS))
+    struct dirent *dp = NULL;
+    DIR *dir = opendir(basePath);
+
+    if (dir != NULL)
     {
-        if ((CORE.Input.Keyboard.previousKeyState[key] == 1) && (CORE.Input.Keyboard.currentKeyState[key] == 0)) released = true;
-    }
+        while ((dp = readdir(dir)) != NULL)
+        {
+            if ((strcmp(dp->d_name, ".") != 0) &&
+                (strcmp(dp->d_name, "..") != 0))
+            {
+            #if defined(_WIN32)
+                sprintf(path, "%s\\%s", basePath, dp->d_name);
+            #else
+                sprintf(path, "%s/%s", basePath, dp->d_name);
+            #endif
 
-    return released;
+                if (filter != NULL)
+                {
+                    if (IsPathFile(path))
+                    {
+                        if (IsFileExtension(path, filter))
+                        {
+                            strcpy(files->paths[files->count], path);
+                            files->count++;
+                        }
+                    }
+                    else
+                    {
+                        if (TextFindIndex(filter, DIRECTORY_FILTER_TAG) >= 0)
+                        {
+                            strcpy(files->paths[files->count], path);
+                            files->count++;
+                        }
+                    }
+                }
+                else
+                {
+                    strcpy(files->paths[files->count], path);
+                    files->count++;
+                }
+            }
+        }
+
+        closedir(dir);
+    }
+    else TRACELOG(LOG_WARNING, "FILEIO: Directory cannot be opened (%s)", basePath);
 }
 
-// Check if a key is NOT being pressed (key not held down)
-bool IsKeyUp(int key)
+// Scan all files and directories recursively from a base path
+static void ScanDirectoryFilesRecursively(const char *basePath, FilePathList *files, const char *filter)
 {
-    bool up = false;
+    char path[MAX_FILEPATH_LENGTH] = { 0 };
+    memset(path, 0, MAX_FILEPATH_LENGTH);
 
-    if ((key > 0) && (key < MAX_KEYBOARD_KEYS))
+    struct dirent *dp = NULL;
+    DIR *dir = opendir(basePath);
+
+    if (dir != NULL)
     {
-        if (CORE.Input.Keyboard.currentKeyState[key] == 0) up = true;
-    }
+        while (((dp = readdir(dir)) != NULL) && (files->count < files->capacity))
+        {
+            if ((strcmp(dp->d_name, ".") != 0) && (strcmp(dp->d_name, "..") != 0))
+            {
+                // Construct new path from our base path
+            #if defined(_WIN32)
+                sprintf(path, "%s\\%s", basePath, dp->d_name);
+            #else
+                sprintf(path, "%s/%s", basePath, dp->d_name);
+            #endif
 
-    return up;
-}
+                if (IsPathFile(path))
+                {
+                    if (filter != NULL)
+                    {
+                        if (IsFileExtension(path, filter))
+                        {
+                            strcpy(files->paths[files->count], path);
+                            files->count++;
+                        }
+                    }
+                    else
+                    {
+                        strcpy(files->paths[files->count], path);
+                        files->count++;
+                    }
 
-// Get the last key pressed
-int GetKeyPressed(void)
-{
-    int value = 0;
+                    if (files->count >= files->capacity)
+                    {
+                        TRACELOG(LOG_WARNING, "FILEIO: Maximum filepath scan capacity reached (%i files)", files->capacity);
+                        break;
+                    }
+                }
+                else
+                {
+                    if ((filter != NULL) && (TextFindIndex(filter, DIRECTORY_FILTER_TAG) >= 0))
+                    {
+                        strcpy(files->paths[files->count], path);
+                        files->count++;
+                    }
 
-    if (CORE.Input.Keyboard.keyPressedQueueCount > 0)
-    {
-        // Get character from the queue head
-        value = CORE.Input.Keyboard.keyPressedQueue[0];
+                    if (files->count >= files->capacity)
+                    {
+                        TRACELOG(LOG_WARNING, "FILEIO: Maximum filepath scan capacity reached (%i files)", files->capacity);
+                        break;
+                    }
 
-        // Shift elements 1 step toward the head
-        for (int i = 0; i < (CORE.Input.Keyboard.keyPressedQueueCount - 1); i++)
-            CORE.Input.Keyboard.keyPressedQueue[i] = CORE.Input.Keyboard.keyPressedQueue[i + 1];
+                    ScanDirectoryFilesRecursively(path, files, filter);
+                }
+            }
+        }
 
-        // Reset last character in the queue
-        CORE.Input.Keyboard.keyPressedQueue[CORE.Input.Keyboard.keyPressedQueueCount - 1] = 0;
-        CORE.Input.Keyboard.keyPressedQueueCount--;
+        closedir(dir);
     }
-
-    return value;
+    else TRACELOG(LOG_WARNING, "FILEIO: Directory cannot be opened (%s)", basePath);
 }
 
-// Get the last char pressed
-int GetCharPressed(void)
+// Load rlgl and default font data again on a new GL context, then let the application reload its resources
+// NOTE: Called by the platform once the new context is current, nothing was created on it yet: the stale
+// ids deleted while releasing the old CPU side data can't hit new objects
+static void RestoreGraphicsState(void)
 {
-    int value = 0;
-
-    if (CORE.Input.Keyboard.charPressedQueueCount > 0)
-    {
-        // Get character from the queue head
-        value = CORE.Input.Keyboard.charPressedQueue[0];
+    double startTime = GetTime();
 
-        // Shift elements 1 step toward the head
-        for (int i = 0; i < (CORE.Input.Keyboard.charPressedQueueCount - 1); i++)
-            CORE.Input.Keyboard.charPressedQueue[i] = CORE.Input.Keyboard.charPressedQueue[i + 1];
+#if defined(SUPPORT_MODULE_RTEXT) && defined(SUPPORT_DEFAULT_FONT)
+    isGpuReady = false;         // Default font texture not deleted, it belongs to the lost context
+    UnloadFontDefault();
+#endif
+    rlglClose();
+    rlCheckErrors();            // NOTE: Deleting the stale shaders raises errors, cleared here
+#if defined(SUPPORT_MEMORY_TRACKING)
+    ResetGpuObjects();          // GPU memory went with the old context, ids are reused by the new one
+#endif
+#if defined(SUPPORT_GIF_RECORDING)
+    // Screen reads in flight are lost, pixel buffers are loaded again below
+    for (int i = 0; i < GIF_CAPTURE_BUFFERS; i++) gifCaptures[i].fence = NULL;
+    gifCaptureCount = 0;
+#endif
 
-        // Reset last character in the queue
-        CORE.Input.Keyboard.charPressedQueue[CORE.Input.Keyboard.charPressedQueueCount - 1] = 0;
-        CORE.Input.Keyboard.charPressedQueueCount--;
-    }
+    rlglInit(CORE.Window.currentFbo.width, CORE.Window.currentFbo.height);
+    isGpuReady = true;
+    SetupViewport(CORE.Window.currentFbo.width, CORE.Window.currentFbo.height);
 
-    return value;
-}
+#if defined(SUPPORT_GIF_RECORDING)
+    if (gifRecording) for (int i = 0; i < GIF_CAPTURE_BUFFERS; i++) gifCaptures[i].pbo = rlLoadPixelBuffer(gifWidth*gifHeight*4);
+#endif
 
-// Set a custom key to exit program
-// NOTE: default exitKey is set to ESCAPE
-void SetExitKey(int key)
-{
-    CORE.Input.Keyboard.exitKey = key;
-}
+#if defined(SUPPORT_MODULE_RTEXT) && defined(SUPPORT_DEFAULT_FONT)
+    LoadFontDefault();
+    #if defined(SUPPORT_MODULE_RSHAPES)
+    Rectangle rec = GetFontDefault().recs[95];
+    if (CORE.Window.flags & FLAG_MSAA_4X_HINT) SetShapesTexture(GetFontDefault().texture, (Rectangle){ rec.x + 2, rec.y + 2, 1, 1 });
+    else SetShapesTexture(GetFontDefault().texture, (Rectangle){ rec.x + 1, rec.y + 1, rec.width - 2, rec.height - 2 });
+    #endif
+#elif defined(SUPPORT_MODULE_RSHAPES)
+    Texture2D texture = { rlGetTextureIdDefault(), 1, 1, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    SetShapesTexture(texture, (Rectangle){ 0.0f, 0.0f, 1.0f, 1.0f });
+#endif
 
-//----------------------------------------------------------------------------------
-// Module Functions Definition: Input Handling: Gamepad
-//----------------------------------------------------------------------------------
+    if (contextRestored != NULL) contextRestored();
 
-// NOTE: Functions with a platform-specific implementation on rcore_<platform>.c
-//int SetGamepadMappings(const char *mappings)
+    TRACELOG(LOG_INFO, "DISPLAY: GL context restored in %.1f ms", (GetTime() - startTime)*1000.0);
+}
 
-// Check if a gamepad is available
-bool IsGamepadAvailable(int gamepad)
+#if defined(SUPPORT_STARTUP_TIMELINE)
+// Get monotonic clock time (seconds)
+// NOTE: Same clock as the Android frame timestamps, GetTime() only starts on InitTimer()
+static double GetTimelineClock(void)
 {
-    bool result = false;
-
-    if ((gamepad < MAX_GAMEPADS) && CORE.Input.Gamepad.ready[gamepad]) result = true;
+    struct timespec ts = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &ts);
 
-    return result;
+    return (double)ts.tv_sec + (double)ts.tv_nsec*1e-9;
 }
 
-// Get gamepad internal name id
-const char *GetGamepadName(int gamepad)
+// Start a new timeline, with a first marker at its origin
+static void ResetTimeline(double origin, const char *name, bool resume)
 {
-    return CORE.Input.Gamepad.name[gamepad];
+    pthread_mutex_lock(&timelineMutex);
+    timeline.count = 0;
+    timeline.origin = origin;
+    timeline.resume = resume;
+    timeline.frames = 0;
+    timeline.complete = false;
+    timeline.gpuFrames = 0;
+    pthread_mutex_unlock(&timelineMutex);
+
+    AddTimelineEvent(name, origin, 0.0);
 }
 
-// Check if a gamepad button has been pressed once
-bool IsGamepadButtonPressed(int gamepad, int button)
+// Add a timeline event, times are relative to the timeline origin
+static int AddTimelineEvent(const char *name, double time, double duration)
 {
-    bool pressed = false;
+    int index = -1;
 
-    if ((gamepad < MAX_GAMEPADS) && CORE.Input.Gamepad.ready[gamepad] && (button < MAX_GAMEPAD_BUTTONS) &&
-        (CORE.Input.Gamepad.previousButtonState[gamepad][button] == 0) && (CORE.Input.Gamepad.currentButtonState[gamepad][button] == 1)) pressed = true;
+    pthread_mutex_lock(&timelineMutex);
 
-    return pressed;
-}
+    // NOTE: Events before any timeline start one (i.e. no platform start hook)
+    if (timeline.origin == 0.0) timeline.origin = time;
 
-// Check if a gamepad button is being pressed
-bool IsGamepadButtonDown(int gamepad, int button)
-{
-    bool down = false;
+    if (timeline.count < MAX_TIMELINE_EVENTS)
+    {
+        index = timeline.count++;
+        TimelineEvent *event = &timeline.events[index];
 
-    if ((gamepad < MAX_GAMEPADS) && CORE.Input.Gamepad.ready[gamepad] && (button < MAX_GAMEPAD_BUTTONS) &&
-        (CORE.Input.Gamepad.currentButtonState[gamepad][button] == 1)) down = true;
+        strncpy(event->name, name, sizeof(event->name) - 1);
+        event->name[sizeof(event->name) - 1] = '\0';
+        event->start = time - timeline.origin;
+        event->duration = duration;
+    }
 
-    return down;
+    pthread_mutex_unlock(&timelineMutex);
+
+    return index;
 }
 
-// Check if a gamepad button has NOT been pressed once
-bool IsGamepadButtonReleased(int gamepad, int button)
+// Mark the first frame and wait for its present time, then log the timeline
+// NOTE: Called after SwapScreenBuffer() until the timeline is complete
+static void UpdateTimelineFrame(void)
 {
-    bool released = false;
+    timeline.frames++;
 
-    if ((gamepad < MAX_GAMEPADS) && CORE.Input.Gamepad.ready[gamepad] && (button < MAX_GAMEPAD_BUTTONS) &&
-        (CORE.Input.Gamepad.previousButtonState[gamepad][button] == 1) && (CORE.Input.Gamepad.currentButtonState[gamepad][button] == 0)) released = true;
+    if (timeline.frames == 1) MarkTimelineEvent("first_frame");
 
-    return released;
-}
+    // NOTE: GPU times of the first frames are read a few frames later, one of them is waited for
+    if (rlIsGpuTimerSupported() && (timeline.gpuFrames == 0) && (timeline.frames < TIMELINE_PRESENT_TIMEOUT)) return;
 
-// Check if a gamepad button is NOT being pressed
-bool IsGamepadButtonUp(int gamepad, int button)
-{
-    bool up = false;
+    double presentTime = 0.0;
+    int present = -1;
+#if defined(PLATFORM_ANDROID)
+    present = GetFramePresentTime(&presentTime);
+#endif
 
-    if ((gamepad < MAX_GAMEPADS) && CORE.Input.Gamepad.ready[gamepad] && (button < MAX_GAMEPAD_BUTTONS) &&
-        (CORE.Input.Gamepad.currentButtonState[gamepad][button] == 0)) up = true;
+    if (present > 0) AddTimelineEvent("first_present", presentTime, 0.0);
+    else if ((present == 0) && (timeline.frames < TIMELINE_PRESENT_TIMEOUT)) return;
+    else TRACELOG(LOG_INFO, "TIMELINE: First frame present time not available");
 
-    return up;
-}
+    timeline.complete = true;
 
-// Get the last gamepad button pressed
-int GetGamepadButtonPressed(void)
-{
-    return CORE.Input.Gamepad.lastButtonPressed;
+    TimelineEvent events[MAX_TIMELINE_EVENTS];
+    int count = GetTimelineEvents(events, MAX_TIMELINE_EVENTS);
+
+    TRACELOG(LOG_INFO, "TIMELINE: %s timeline, %i events", timeline.resume? "Resume" : "Cold start", count);
+    for (int i = 0; i < count; i++)
+    {
+        if (events[i].duration > 0.0) TRACELOG(LOG_INFO, "    > %9.2f ms  %-32s %8.2f ms", events[i].start*1000.0, events[i].name, events[i].duration*1000.0);
+        else TRACELOG(LOG_INFO, "    > %9.2f ms  %s", events[i].start*1000.0, events[i].name);
+    }
 }
+#endif
 
-// Get gamepad axis count
-int GetGamepadAxisCount(int gamepad)
+#if defined(SUPPORT_TOUCH_HISTORY)
+// Add a touch sample to the history of a pointer (a down sample starts it again)
+static void AddTouchSample(int id, Vector2 position, double time, int action)
 {
-    return CORE.Input.Gamepad.axisCount[gamepad];
+    if ((id < 0) || (id >= MAX_TOUCH_POINTS)) return;
+
+    TouchHistory *history = &touchHistory[id];
+    if (action == TOUCH_SAMPLE_DOWN) history->count = 0;
+
+    history->samples[history->head] = (TouchSample){ position, time, action };
+    history->head = (history->head + 1)%MAX_TOUCH_HISTORY;
+    if (history->count < MAX_TOUCH_HISTORY) history->count++;
 }
+#endif
 
-// Get axis movement vector for a gamepad
-float GetGamepadAxisMovement(int gamepad, int axis)
+#if defined(SUPPORT_JOB_SYSTEM)
+// Job worker thread: runs jobs, sleeps after JOB_SPIN_COUNT rounds without any
+static void *JobWorkerThread(void *arg)
 {
-    float value = (axis == GAMEPAD_AXIS_LEFT_TRIGGER || axis == GAMEPAD_AXIS_RIGHT_TRIGGER)? -1.0f : 0.0f;
+    int deque = (int)(intptr_t)arg;
+    jobDeque = deque;
 
-    if ((gamepad < MAX_GAMEPADS) && CORE.Input.Gamepad.ready[gamepad] && (axis < MAX_GAMEPAD_AXIS)) {
-        float movement = value < 0.0f ? CORE.Input.Gamepad.axisState[gamepad][axis] : fabsf(CORE.Input.Gamepad.axisState[gamepad][axis]);
+#if defined(PLATFORM_ANDROID)
+    // NOTE: Raw syscall, bionic only declares sched_setaffinity() with _GNU_SOURCE
+    if (jobSystem.affinity != 0) syscall(__NR_sched_setaffinity, 0, sizeof(jobSystem.affinity), &jobSystem.affinity);
+#endif
 
-        if (movement > value) value = CORE.Input.Gamepad.axisState[gamepad][axis];
-    }
+    int idleRounds = 0;
 
-    return value;
-}
+    while (true)
+    {
+        int slot = FindJob(deque);
 
-//----------------------------------------------------------------------------------
-// Module Functions Definition: Input Handling: Mouse
-//----------------------------------------------------------------------------------
+        if (slot >= 0)
+        {
+            RunJobSlot(slot);
+            idleRounds = 0;
+            continue;
+        }
 
-// NOTE: Functions with a platform-specific implementation on rcore_<platform>.c
-//void SetMousePosition(int x, int y)
-//void SetMouseCursor(int cursor)
+        if (__atomic_load_n(&jobSystem.closing, __ATOMIC_ACQUIRE)) break;
 
-// Check if a mouse button has been pressed once
-bool IsMouseButtonPressed(int button)
-{
-    bool pressed = false;
+        if (++idleRounds < JOB_SPIN_COUNT)
+        {
+            sched_yield();
+            continue;
+        }
 
-    if ((CORE.Input.Mouse.currentButtonState[button] == 1) && (CORE.Input.Mouse.previousButtonState[button] == 0)) pressed = true;
+        // NOTE: Sleeping count raised before the queued check, a job queued meanwhile sees it and signals
+        pthread_mutex_lock(&jobSystem.mutex);
+        __atomic_add_fetch(&jobSystem.sleeping, 1, __ATOMIC_SEQ_CST);
+        while (!jobSystem.closing && (__atomic_load_n(&jobSystem.queued, __ATOMIC_SEQ_CST) <= 0)) pthread_cond_wait(&jobSystem.jobsAdded, &jobSystem.mutex);
+        __atomic_sub_fetch(&jobSystem.sleeping, 1, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&jobSystem.mutex);
 
-    // Map touches to mouse buttons checking
-    if ((CORE.Input.Touch.currentTouchState[button] == 1) && (CORE.Input.Touch.previousTouchState[button] == 0)) pressed = true;
+        idleRounds = 0;
+    }
 
-    return pressed;
+    return NULL;
 }
 
-// Check if a mouse button is being pressed
-bool IsMouseButtonDown(int button)
+// Start the job workers, one per core given to jobs except the calling thread one
+static void InitJobSystem(void)
 {
-    bool down = false;
+    if (jobSystem.workerCount > 0) return;
 
-    if (CORE.Input.Mouse.currentButtonState[button] == 1) down = true;
+    memset(&jobSystem, 0, sizeof(JobSystem));
+    for (int i = 0; i < MAX_JOBS; i++) jobSystem.slots[i].handle = MAX_JOBS + i;
+    pthread_mutex_init(&jobSystem.mutex, NULL);
+    pthread_cond_init(&jobSystem.jobsAdded, NULL);
 
-    // NOTE: Touches are considered like mouse buttons
-    if (CORE.Input.Touch.currentTouchState[button] == 1) down = true;
+    int cores = GetJobCores(&jobSystem.affinity);
+    int workers = (cores - 1 < MAX_JOB_WORKERS)? cores - 1 : MAX_JOB_WORKERS;
 
-    return down;
+    jobDeque = 0;
+    jobSystem.dequeCount = workers + 1;
+
+    int started = 0;
+    for (int i = 0; i < workers; i++)
+    {
+        if (pthread_create(&jobSystem.workers[i], NULL, JobWorkerThread, (void *)(intptr_t)(i + 1)) != 0) break;
+        started++;
+    }
+    jobSystem.workerCount = started;
+
+    if (started > 0) TRACELOG(LOG_INFO, "JOBS: Job system initialized, %i workers (%s cores)", started, (jobSystem.affinity != 0)? "big" : "all");
+    else TRACELOG(LOG_INFO, "JOBS: No job workers, jobs run on the calling thread");
 }
 
-// Check if a mouse button has been released once
-bool IsMouseButtonReleased(int button)
+// Stop the job workers, once every queued job ran
+static void CloseJobSystem(void)
 {
-    bool released = false;
+    if (jobSystem.workerCount == 0) return;
 
-    if ((CORE.Input.Mouse.currentButtonState[button] == 0) && (CORE.Input.Mouse.previousButtonState[button] == 1)) released = true;
+    pthread_mutex_lock(&jobSystem.mutex);
+    __atomic_store_n(&jobSystem.closing, true, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&jobSystem.jobsAdded);
+    pthread_mutex_unlock(&jobSystem.mutex);
 
-    // Map touches to mouse buttons checking
-    if ((CORE.Input.Touch.currentTouchState[button] == 0) && (CORE.Input.Touch.previousTouchState[button] == 1)) released = true;
+    for (int i = 0; i < jobSystem.workerCount; i++) pthread_join(jobSystem.workers[i], NULL);
 
-    return released;
+    // NOTE: Jobs queued by the last jobs run here
+    int slot = -1;
+    while ((slot = FindJob(0)) >= 0) RunJobSlot(slot);
+
+    pthread_cond_destroy(&jobSystem.jobsAdded);
+    pthread_mutex_destroy(&jobSystem.mutex);
+    jobSystem.workerCount = 0;
+    jobDeque = -1;
 }
 
-// Check if a mouse button is NOT being pressed
-bool IsMouseButtonUp(int button)
+// Get cores for jobs, the calling thread included
+// NOTE: Clusters are told apart by their maximum frequency, the slowest one is the little cores. Big cores
+// alone run the jobs when there are at least JOB_MIN_BIG_CORES of them, every core runs them otherwise
+static int GetJobCores(unsigned long *affinity)
 {
-    bool up = false;
+    *affinity = 0;
+    int coreCount = 1;
 
-    if (CORE.Input.Mouse.currentButtonState[button] == 0) up = true;
+#if defined(__linux__)
+    coreCount = (int)sysconf(_SC_NPROCESSORS_CONF);
+    if (coreCount < 1) coreCount = 1;
+#endif
 
-    // NOTE: Touches are considered like mouse buttons
-    if (CORE.Input.Touch.currentTouchState[button] == 0) up = true;
+#if defined(PLATFORM_ANDROID)
+    int maskBits = (int)(8*sizeof(unsigned long));
+    int cores = (coreCount < maskBits)? coreCount : maskBits;
+    long frequencies[64] = { 0 };
+    long lowest = 0;
+    long highest = 0;
 
-    return up;
-}
+    for (int i = 0; i < cores; i++)
+    {
+        char path[96] = { 0 };
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%i/cpufreq/cpuinfo_max_freq", i);
 
-// Get mouse position X
-int GetMouseX(void)
-{
-    int mouseX = (int)((CORE.Input.Mouse.currentPosition.x + CORE.Input.Mouse.offset.x)*CORE.Input.Mouse.scale.x);
-    return mouseX;
-}
+        FILE *file = fopen(path, "r");
+        if (file == NULL) continue;
+        if (fscanf(file, "%ld", &frequencies[i]) != 1) frequencies[i] = 0;
+        fclose(file);
 
-// Get mouse position Y
-int GetMouseY(void)
-{
-    int mouseY = (int)((CORE.Input.Mouse.currentPosition.y + CORE.Input.Mouse.offset.y)*CORE.Input.Mouse.scale.y);
-    return mouseY;
-}
+        if ((frequencies[i] > 0) && ((lowest == 0) || (frequencies[i] < lowest))) lowest = frequencies[i];
+        if (frequencies[i] > highest) highest = frequencies[i];
+    }
 
-// Get mouse position XY
-Vector2 GetMousePosition(void)
-{
-    Vector2 position = { 0 };
+    if (lowest < highest)
+    {
+        unsigned long mask = 0;
+        int bigCount = 0;
 
-    position.x = (CORE.Input.Mouse.currentPosition.x + CORE.Input.Mouse.offset.x)*CORE.Input.Mouse.scale.x;
-    position.y = (CORE.Input.Mouse.currentPosition.y + CORE.Input.Mouse.offset.y)*CORE.Input.Mouse.scale.y;
+        for (int i = 0; i < cores; i++)
+        {
+            if (frequencies[i] > lowest)
+            {
+                mask |= 1ul << i;
+                bigCount++;
+            }
+        }
 
-    return position;
+        TRACELOG(LOG_INFO, "JOBS: %i cores, %i big ones", coreCount, bigCount);
+
+        if (bigCount >= JOB_MIN_BIG_CORES)
+        {
+            *affinity = mask;
+            return bigCount;
+        }
+    }
+#endif
+
+    return coreCount;
 }
 
-// Get mouse delta between frames
-Vector2 GetMouseDelta(void)
+// Queue a job whose dependencies are done, waking a worker
+static void ScheduleJob(int slot)
 {
-    Vector2 delta = { 0 };
+    if (jobDeque >= 0)
+    {
+        JobDeque *deque = &jobSystem.deques[jobDeque];
+        long bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED);
 
-    delta.x = CORE.Input.Mouse.currentPosition.x - CORE.Input.Mouse.previousPosition.x;
-    delta.y = CORE.Input.Mouse.currentPosition.y - CORE.Input.Mouse.previousPosition.y;
+        __atomic_store_n(&deque->jobs[bottom & (MAX_JOBS - 1)], slot, __ATOMIC_RELAXED);
+        __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        pthread_mutex_lock(&jobSystem.mutex);
+        jobSystem.shared[(jobSystem.sharedHead + jobSystem.sharedCount) & (MAX_JOBS - 1)] = slot;
+        __atomic_add_fetch(&jobSystem.sharedCount, 1, __ATOMIC_RELEASE);
+        pthread_mutex_unlock(&jobSystem.mutex);
+    }
 
-    return delta;
+    __atomic_add_fetch(&jobSystem.queued, 1, __ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&jobSystem.sleeping, __ATOMIC_SEQ_CST) > 0)
+    {
+        pthread_mutex_lock(&jobSystem.mutex);
+        pthread_cond_signal(&jobSystem.jobsAdded);
+        pthread_mutex_unlock(&jobSystem.mutex);
+    }
 }
 
-// Set mouse offset
-// NOTE: Useful when rendering to different size targets
-void SetMouseOffset(int offsetX, int offsetY)
+// Take a job: newest of the own deque, oldest of the shared queue, then oldest of another deque
+static int FindJob(int deque)
 {
-    CORE.Input.Mouse.offset = (Vector2){ (float)offsetX, (float)offsetY };
+    int slot = -1;
+
+    if (deque >= 0)
+    {
+        // Pop (owner): bottom taken first, the last job is raced for with the thieves on top
+        JobDeque *own = &jobSystem.deques[deque];
+        long bottom = __atomic_load_n(&own->bottom, __ATOMIC_RELAXED) - 1;
+        __atomic_store_n(&own->bottom, bottom, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        long top = __atomic_load_n(&own->top, __ATOMIC_RELAXED);
+
+        if (top <= bottom)
+        {
+            slot = __atomic_load_n(&own->jobs[bottom & (MAX_JOBS - 1)], __ATOMIC_RELAXED);
+
+            if (top == bottom)
+            {
+                if (!__atomic_compare_exchange_n(&own->top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) slot = -1;
+                __atomic_store_n(&own->bottom, bottom + 1, __ATOMIC_RELAXED);
+            }
+        }
+        else __atomic_store_n(&own->bottom, bottom + 1, __ATOMIC_RELAXED);
+    }
+
+    if ((slot < 0) && (__atomic_load_n(&jobSystem.sharedCount, __ATOMIC_ACQUIRE) > 0))
+    {
+        pthread_mutex_lock(&jobSystem.mutex);
+        if (jobSystem.sharedCount > 0)
+        {
+            slot = jobSystem.shared[jobSystem.sharedHead];
+            jobSystem.sharedHead = (jobSystem.sharedHead + 1) & (MAX_JOBS - 1);
+            __atomic_sub_fetch(&jobSystem.sharedCount, 1, __ATOMIC_RELEASE);
+        }
+        pthread_mutex_unlock(&jobSystem.mutex);
+    }
+
+    // Steal (thieves): one try per other deque, starting after the own one
+    for (int i = 1; (slot < 0) && (i <= jobSystem.dequeCount); i++)
+    {
+        int victim = (deque + i) % jobSystem.dequeCount;
+        if (victim < 0) victim += jobSystem.dequeCount;
+        if (victim == deque) continue;
+
+        JobDeque *other = &jobSystem.deques[victim];
+        long top = __atomic_load_n(&other->top, __ATOMIC_ACQUIRE);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        long bottom = __atomic_load_n(&other->bottom, __ATOMIC_ACQUIRE);
+
+        if (top < bottom)
+        {
+            int stolen = __atomic_load_n(&other->jobs[top & (MAX_JOBS - 1)], __ATOMIC_RELAXED);
+            if (__atomic_compare_exchange_n(&other->top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) slot = stolen;
+        }
+    }
+
+    if (slot >= 0) __atomic_sub_fetch(&jobSystem.queued, 1, __ATOMIC_SEQ_CST);
+
+    return slot;
 }
 
-// Set mouse scaling
-// NOTE: Useful when rendering to different size targets
-void SetMouseScale(float scaleX, float scaleY)
+// Run a job, then queue the dependents it was the last dependency of
+static void RunJobSlot(int slot)
 {
-    CORE.Input.Mouse.scale = (Vector2){ scaleX, scaleY };
+    JobSlot *entry = &jobSystem.slots[slot];
+    entry->callback(entry->context);
+
+    // NOTE: Handle moved on and dependents taken under the lock, jobs added later see this one done
+    int dependents[MAX_JOB_DEPENDENTS] = { 0 };
+
+    while (__atomic_exchange_n(&entry->lock, 1, __ATOMIC_ACQUIRE)) { }
+    int dependentCount = entry->dependentCount;
+    memcpy(dependents, entry->dependents, dependentCount*sizeof(int));
+    entry->dependentCount = 0;
+
+    unsigned int handle = entry->handle + MAX_JOBS;
+    if (handle < MAX_JOBS) handle += MAX_JOBS;      // Generation 0 skipped, handle 0 is no job
+    __atomic_store_n(&entry->handle, handle, __ATOMIC_RELEASE);
+    __atomic_store_n(&entry->lock, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&entry->used, 0, __ATOMIC_RELEASE);
+
+    for (int i = 0; i < dependentCount; i++)
+    {
+        if (__atomic_sub_fetch(&jobSystem.slots[dependents[i]].pending, 1, __ATOMIC_ACQ_REL) == 0) ScheduleJob(dependents[i]);
+    }
 }
 
-// Get mouse wheel movement Y
-float GetMouseWheelMove(void)
+// Run ParallelFor() ranges until none are left
+static void RunJobRanges(void *context)
 {
-    float result = 0.0f;
+    JobRange *range = (JobRange *)context;
 
-    if (fabsf(CORE.Input.Mouse.currentWheelMove.x) > fabsf(CORE.Input.Mouse.currentWheelMove.y)) result = (float)CORE.Input.Mouse.currentWheelMove.x;
-    else result = (float)CORE.Input.Mouse.currentWheelMove.y;
+    while (true)
+    {
+        int start = __atomic_fetch_add(&range->next, range->grain, __ATOMIC_RELAXED);
+        if (start >= range->count) break;
 
-    return result;
+        int end = (range->count - start > range->grain)? start + range->grain : range->count;
+        range->callback(range->context, start, end);
+    }
 }
+#endif
 
-// Get mouse wheel movement X/Y as a vector
-Vector2 GetMouseWheelMoveV(void)
+// Allocate from the last block, chaining a new one when full
+static void *ArenaAlloc(MemoryArena *arena, size_t size)
 {
-    Vector2 result = { 0 };
+    size = (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+    ArenaBlock *block = arena->block;
 
-    result = CORE.Input.Mouse.currentWheelMove;
+    if ((block == NULL) || ((block->size - block->used) < size))
+    {
+        size_t blockSize = (block == NULL)? arena->firstSize : 2*block->size;
+        if (blockSize < size) blockSize = size;
 
-    return result;
-}
+        ArenaBlock *next = (ArenaBlock *)RL_MALLOC(ARENA_HEADER_SIZE + blockSize);
+        if (next == NULL) return NULL;
 
-//----------------------------------------------------------------------------------
-// Module Functions Definition: Input Handling: Touch
-//----------------------------------------------------------------------------------
+        next->previous = block;
+        next->size = blockSize;
+        next->used = 0;
+        arena->block = block = next;
+    }
 
-// Get touch position X for touch point 0 (relative to screen size)
-int GetTouchX(void)
+    void *memory = (unsigned char *)block + ARENA_HEADER_SIZE + block->used;
+    block->used += size;
+    arena->used += size;
+    if (arena->used > arena->peak) arena->peak = arena->used;
+
+    return memory;
+}
+
+// Free what was allocated after a block state (NULL block: everything)
+static void RewindArena(MemoryArena *arena, ArenaBlock *block, size_t blockUsed, size_t used)
 {
-    int touchX = (int)CORE.Input.Touch.position[0].x;
-    return touchX;
+    while (arena->block != block)
+    {
+        ArenaBlock *previous = arena->block->previous;
+        RL_FREE(arena->block);
+        arena->block = previous;
+    }
+
+    if (block != NULL) block->used = blockUsed;
+    arena->used = used;
 }
 
-// Get touch position Y for touch point 0 (relative to screen size)
-int GetTouchY(void)
+// Free everything, keeping a single block as big as the peak (up to ARENA_RETAINED_SIZE)
+static void ResetArena(MemoryArena *arena)
 {
-    int touchY = (int)CORE.Input.Touch.position[0].y;
-    return touchY;
+    size_t size = (arena->peak < ARENA_RETAINED_SIZE)? arena->peak : ARENA_RETAINED_SIZE;
+    if (size < arena->firstSize) size = arena->firstSize;
+    ArenaBlock *block = arena->block;
+
+    if ((block != NULL) && ((block->previous != NULL) || (block->size != size)))
+    {
+        RewindArena(arena, NULL, 0, 0);
+        if ((size > 0) && (ArenaAlloc(arena, size) != NULL)) arena->block->used = 0;
+    }
+    else if (block != NULL) block->used = 0;
+
+    arena->used = 0;
 }
 
-// Get touch position XY for a touch point index (relative to screen size)
-// TODO: Touch position should be scaled depending on display size and render size
-Vector2 GetTouchPosition(int index)
+// Create the key freeing scratch arenas on thread exit
+static void CreateScratchKey(void)
 {
-    Vector2 position = { -1.0f, -1.0f };
+    pthread_key_create(&scratchKey, FreeScratchMemory);
+}
 
-    if (index < MAX_TOUCH_POINTS) position = CORE.Input.Touch.position[index];
-    else TRACELOG(LOG_WARNING, "INPUT: Required touch point out of range (Max touch points: %i)", MAX_TOUCH_POINTS);
+// Free a scratch arena (thread exit)
+static void FreeScratchMemory(void *memory)
+{
+    ScratchMemory *scratch = (ScratchMemory *)memory;
 
-    return position;
+    RewindArena(&scratch->arena, NULL, 0, 0);
+    scratch->depth = 0;
+    scratch->registered = false;
 }
 
-// Get touch point identifier for given index
-int GetTouchPointId(int index)
+// Run a requested memory trim: arenas shrink back to their first block, then the application frees its caches
+static void ProcessMemoryTrim(void)
 {
-    int id = -1;
+    if (__atomic_load_n(&memoryTrimLevel, __ATOMIC_RELAXED) == 0) return;
+
+    int level = __atomic_exchange_n(&memoryTrimLevel, 0, __ATOMIC_ACQUIRE);
+
+    // NOTE: Frame arena is reset at the next EndDrawing(), scratch arena only out of its scopes
+    frameArena.peak = 0;
+    scratchMemory.arena.peak = 0;
+    if (scratchMemory.depth == 0) ResetArena(&scratchMemory.arena);
 
-    if (index < MAX_TOUCH_POINTS) id = CORE.Input.Touch.pointId[index];
+    if (memoryTrim != NULL) memoryTrim(level);
 
-    return id;
+    MemoryStats cpu = GetMemoryStats(MEMORY_TAG_CPU);
+    MemoryStats gpu = GetMemoryStats(MEMORY_TAG_GPU);
+    TRACELOG(LOG_INFO, "MEMORY: Trimmed (level %i): CPU %lli KB (peak %lli KB), GPU %lli KB (estimated)", level, cpu.bytes/1024, cpu.peak/1024, gpu.bytes/1024);
 }
 
-// Get number of touch points
-int GetTouchPointCount(void)
+#if defined(SUPPORT_GIF_RECORDING)
+// Start recording, screen reads go to pixel buffers when supported (OpenGL ES 3.0)
+static void StartGifRecording(void)
 {
-    return CORE.Input.Touch.pointCount;
-}
+    Vector2 scale = GetWindowScaleDPI();
+    gifWidth = (int)((float)CORE.Window.render.width*scale.x);
+    gifHeight = (int)((float)CORE.Window.render.height*scale.y);
 
-//----------------------------------------------------------------------------------
-// Module Internal Functions Definition
-//----------------------------------------------------------------------------------
+    for (int i = 0; i < GIF_CAPTURE_BUFFERS; i++)
+    {
+        gifCaptures[i] = (GifCapture){ rlLoadPixelBuffer(gifWidth*gifHeight*4), NULL, 0 };
+        gifFrames[i] = (GifFrame){ (unsigned char *)RL_MALLOC(gifWidth*gifHeight*4), 0, 0, 0 };
+    }
 
-// NOTE: Functions with a platform-specific implementation on rcore_<platform>.c
-//int InitPlatform(void)
-//void ClosePlatform(void)
+    gifCaptureFirst = 0;
+    gifCaptureCount = 0;
+    gifFrameNext = 0;
+    gifEncodeJob = 0;
 
-// Initialize hi-resolution timer
-void InitTimer(void)
+    gifRecording = true;
+    gifFrameCounter = 0;
+
+    msf_gif_begin(&gifState, gifWidth, gifHeight);
+    screenshotCounter++;
+
+    TRACELOG(LOG_INFO, "SYSTEM: Start animated GIF recording: %s (%s screen reads)", TextFormat("screenrec%03i.gif", screenshotCounter), (gifCaptures[0].pbo != 0)? "asynchronous" : "synchronous");
+}
+
+// Encode every frame still in flight, then save the GIF (or drop it)
+static void StopGifRecording(bool save)
 {
-    // Setting a higher resolution can improve the accuracy of time-out intervals in wait functions
-    // However, it can also reduce overall system performance, because the thread scheduler switches tasks more often
-    // High resolutions can also prevent the CPU power management system from entering power-saving modes
-    // Setting a higher resolution does not improve the accuracy of the high-resolution performance counter
-#if defined(_WIN32) && defined(SUPPORT_WINMM_HIGHRES_TIMER) && !defined(SUPPORT_BUSY_WAIT_LOOP) && !defined(PLATFORM_DESKTOP_SDL)
-    timeBeginPeriod(1);                 // Setup high-resolution timer to 1ms (granularity of 1-2 ms)
-#endif
+    UpdateGifCaptures(true);
+    WaitJob(gifEncodeJob);
 
-#if defined(__linux__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__EMSCRIPTEN__)
-    struct timespec now = { 0 };
+    gifRecording = false;
 
-    if (clock_gettime(CLOCK_MONOTONIC, &now) == 0)  // Success
+    MsfGifResult result = msf_gif_end(&gifState);
+    if (save) SaveFileData(TextFormat("%s/screenrec%03i.gif", CORE.Storage.basePath, screenshotCounter), result.data, (unsigned int)result.dataSize);
+    msf_gif_free(result);
+
+    for (int i = 0; i < GIF_CAPTURE_BUFFERS; i++)
     {
-        CORE.Time.base = (unsigned long long int)now.tv_sec*1000000000LLU + (unsigned long long int)now.tv_nsec;
+        if (gifCaptures[i].pbo != 0) rlUnloadPixelBuffer(gifCaptures[i].pbo);
+        RL_FREE(gifFrames[i].pixels);
+        gifCaptures[i] = (GifCapture){ 0 };
+        gifFrames[i] = (GifFrame){ 0 };
     }
-    else TRACELOG(LOG_WARNING, "TIMER: Hi-resolution timer not available");
-#endif
 
-    CORE.Time.previous = GetTime();     // Get time as double
+    if (save) TRACELOG(LOG_INFO, "SYSTEM: Finish animated GIF recording");
 }
 
-// Set viewport for a provided width and height
-void SetupViewport(int width, int height)
+// Start reading the screen into the next GIF frame
+// NOTE: With pixel buffers the pixels are copied one or two frames later, once the GPU wrote them
+static void CaptureGifFrame(int delay)
 {
-    CORE.Window.render.width = width;
-    CORE.Window.render.height = height;
-
-    // Set viewport width and height
-    // NOTE: We consider render size (scaled) and offset in case black bars are required and
-    // render area does not match full display area (this situation is only applicable on fullscreen mode)
-#if defined(__APPLE__)
-    Vector2 scale = GetWindowScaleDPI();
-    rlViewport(CORE.Window.renderOffset.x/2*scale.x, CORE.Window.renderOffset.y/2*scale.y, (CORE.Window.render.width)*scale.x, (CORE.Window.render.height)*scale.y);
-#else
-    rlViewport(CORE.Window.renderOffset.x/2, CORE.Window.renderOffset.y/2, CORE.Window.render.width, CORE.Window.render.height);
-#endif
-
-    rlMatrixMode(RL_PROJECTION);        // Switch to projection matrix
-    rlLoadIdentity();                   // Reset current matrix (projection)
+    if (gifCaptures[0].pbo == 0)
+    {
+        // Synchronous read (OpenGL ES 2.0), only the encoding leaves the render thread
+        GifFrame *frame = GetGifFrame();
+        rlReadScreenPixelsTo(frame->pixels, gifWidth, gifHeight);
+        frame->delay = delay;
+        frame->pitch = gifWidth*4;
+        frame->job = gifEncodeJob = RunJob(EncodeGifFrame, frame, &gifEncodeJob, (gifEncodeJob != 0)? 1 : 0);
+        return;
+    }
 
-    // Set orthographic projection to current framebuffer size
-    // NOTE: Configured top-left corner as (0, 0)
-    rlOrtho(0, CORE.Window.render.width, CORE.Window.render.height, 0, 0.0f, 1.0f);
+    // Every pixel buffer in flight: the oldest read is waited for
+    if (gifCaptureCount == GIF_CAPTURE_BUFFERS)
+    {
+        rlIsSyncDone(gifCaptures[gifCaptureFirst].fence, true);
+        UpdateGifCaptures(false);
+    }
 
-    rlMatrixMode(RL_MODELVIEW);         // Switch back to modelview matrix
-    rlLoadIdentity();                   // Reset current matrix (modelview)
+    GifCapture *capture = &gifCaptures[(gifCaptureFirst + gifCaptureCount)%GIF_CAPTURE_BUFFERS];
+    capture->fence = rlReadScreenPixelsAsync(capture->pbo, gifWidth, gifHeight);
+    capture->delay = delay;
+    if (capture->fence != NULL) gifCaptureCount++;
 }
 
-// Compute framebuffer size relative to screen size and display size
-// NOTE: Global variables CORE.Window.render.width/CORE.Window.render.height and CORE.Window.renderOffset.x/CORE.Window.renderOffset.y can be modified
-void SetupFramebuffer(int width, int height)
+// Queue the encoding of the screen reads done, in order (waiting for every one if requested)
+static void UpdateGifCaptures(bool wait)
 {
-    // Calculate CORE.Window.render.width and CORE.Window.render.height, we have the display size (input params) and the desired screen size (global var)
-    if ((CORE.Window.screen.width > CORE.Window.display.width) || (CORE.Window.screen.height > CORE.Window.display.height))
+    while (gifCaptureCount > 0)
     {
-        TRACELOG(LOG_WARNING, "DISPLAY: Downscaling required: Screen size (%ix%i) is bigger than display size (%ix%i)", CORE.Window.screen.width, CORE.Window.screen.height, CORE.Window.display.width, CORE.Window.display.height);
-
-        // Downscaling to fit display with border-bars
-        float widthRatio = (float)CORE.Window.display.width/(float)CORE.Window.screen.width;
-        float heightRatio = (float)CORE.Window.display.height/(float)CORE.Window.screen.height;
+        GifCapture *capture = &gifCaptures[gifCaptureFirst];
+        if (!rlIsSyncDone(capture->fence, wait)) break;
 
-        if (widthRatio <= heightRatio)
-        {
-            CORE.Window.render.width = CORE.Window.display.width;
-            CORE.Window.render.height = (int)round((float)CORE.Window.screen.height*widthRatio);
-            CORE.Window.renderOffset.x = 0;
-            CORE.Window.renderOffset.y = (CORE.Window.display.height - CORE.Window.render.height);
-        }
-        else
+        // NOTE: Pixels are copied out right away, a mapped buffer belongs to the GL context (lost with it)
+        GifFrame *frame = GetGifFrame();
+        if (rlReadPixelBuffer(capture->pbo, frame->pixels, gifWidth*gifHeight*4))
         {
-            CORE.Window.render.width = (int)round((float)CORE.Window.screen.width*heightRatio);
-            CORE.Window.render.height = CORE.Window.display.height;
-            CORE.Window.renderOffset.x = (CORE.Window.display.width - CORE.Window.render.width);
-            CORE.Window.renderOffset.y = 0;
+            frame->delay = capture->delay;
+            frame->pitch = -gifWidth*4;     // Rows as read from the screen, msf_gif flips them
+            frame->job = gifEncodeJob = RunJob(EncodeGifFrame, frame, &gifEncodeJob, (gifEncodeJob != 0)? 1 : 0);
         }
 
-        // Screen scaling required
-        float scaleRatio = (float)CORE.Window.render.width/(float)CORE.Window.screen.width;
-        CORE.Window.screenScale = MatrixScale(scaleRatio, scaleRatio, 1.0f);
+        rlUnloadSync(capture->fence);
+        capture->fence = NULL;
+        gifCaptureFirst = (gifCaptureFirst + 1)%GIF_CAPTURE_BUFFERS;
+        gifCaptureCount--;
+    }
+}
 
-        // NOTE: We render to full display resolution!
-        // We just need to calculate above parameters for downscale matrix and offsets
-        CORE.Window.render.width = CORE.Window.display.width;
-        CORE.Window.render.height = CORE.Window.display.height;
+// Get the next frame buffer, waiting for its last encoding
+// NOTE: Frames are encoded in order, the next buffer is always the one encoded first
+static GifFrame *GetGifFrame(void)
+{
+    GifFrame *frame = &gifFrames[gifFrameNext];
+    gifFrameNext = (gifFrameNext + 1)%GIF_CAPTURE_BUFFERS;
 
-        TRACELOG(LOG_WARNING, "DISPLAY: Downscale matrix generated, content will be rendered at (%ix%i)", CORE.Window.render.width, CORE.Window.render.height);
-    }
-    else if ((CORE.Window.screen.width < CORE.Window.display.width) || (CORE.Window.screen.height < CORE.Window.display.height))
-    {
-        // Required screen size is smaller than display size
-        TRACELOG(LOG_INFO, "DISPLAY: Upscaling required: Screen size (%ix%i) smaller than display size (%ix%i)", CORE.Window.screen.width, CORE.Window.screen.height, CORE.Window.display.width, CORE.Window.display.height);
+    if (frame->job != 0) WaitJob(frame->job);
+    frame->job = 0;
 
-        if ((CORE.Window.screen.width == 0) || (CORE.Window.screen.height == 0))
-        {
-            CORE.Window.screen.width = CORE.Window.display.width;
-            CORE.Window.screen.height = CORE.Window.display.height;
-        }
+    return frame;
+}
 
-        // Upscaling to fit display with border-bars
-        float displayRatio = (float)CORE.Window.display.width/(float)CORE.Window.display.height;
-        float screenRatio = (float)CORE.Window.screen.width/(float)CORE.Window.screen.height;
+// Add a frame to the GIF (job), color quantization and LZW compression
+static void EncodeGifFrame(void *context)
+{
+    GifFrame *frame = (GifFrame *)context;
 
-        if (displayRatio <= screenRatio)
-        {
-            CORE.Window.render.width = CORE.Window.screen.width;
-            CORE.Window.render.height = (int)round((float)CORE.Window.screen.width/displayRatio);
-            CORE.Window.renderOffset.x = 0;
-            CORE.Window.renderOffset.y = (CORE.Window.render.height - CORE.Window.screen.height);
-        }
-        else
-        {
-            CORE.Window.render.width = (int)round((float)CORE.Window.screen.height*displayRatio);
-            CORE.Window.render.height = CORE.Window.screen.height;
-            CORE.Window.renderOffset.x = (CORE.Window.render.width - CORE.Window.screen.width);
-            CORE.Window.renderOffset.y = 0;
-        }
-    }
-    else
-    {
-        CORE.Window.render.width = CORE.Window.screen.width;
-        CORE.Window.render.height = CORE.Window.screen.height;
-        CORE.Window.renderOffset.x = 0;
-        CORE.Window.renderOffset.y = 0;
-    }
+    // NOTE: Alpha is ignored, the screen can be read as it is
+    if (frame->pixels != NULL) msf_gif_frame(&gifState, frame->pixels, frame->delay, GIF_RECORD_BITRATE, frame->pitch);
 }
+#endif
 
-// Scan all files and directories in a base path
-// WARNING: files.paths[] must be previously allocated and
-// contain enough space to store all required paths
-static void ScanDirectoryFiles(const char *basePath, FilePathList *files, const char *filter)
+// Close GPU timers of the frame, then move the GPU times read back into the profiler and the startup timeline
+// NOTE: Results come a few frames late, the profiler GPU phases keep the last frame read until the next one
+static void UpdateGpuTimers(void)
 {
-    static char path[MAX_FILEPATH_LENGTH] = { 0 };
-    memset(path, 0, MAX_FILEPATH_LENGTH);
+    unsigned int frame = rlCommitGpuTimerFrame();
+    (void)frame;
 
-    struct dirent *dp = NULL;
-    DIR *dir = opendir(basePath);
+#if defined(SUPPORT_STARTUP_TIMELINE)
+    // NOTE: A frame is read back at most RL_GPU_TIMER_FRAMES frames later, its start is still there
+    if (frame != 0) timeline.gpuFrameStarts[frame%TIMELINE_GPU_FRAMES] = timeline.frameStart;
+#endif
 
-    if (dir != NULL)
+    rlGpuTimerFrame result = { 0 };
+    while (rlGetGpuTimerFrame(&result))
     {
-        while ((dp = readdir(dir)) != NULL)
+#if defined(SUPPORT_FRAME_PROFILER)
+        profiler.frame[PROFILER_PHASE_GPU_FRAME] = 0.0;
+        profiler.frame[PROFILER_PHASE_GPU_BATCH] = 0.0;
+        profiler.frame[PROFILER_PHASE_GPU_TEXTURE] = 0.0;
+#endif
+
+        for (int i = 0; i < result.scopeCount; i++)
         {
-            if ((strcmp(dp->d_name, ".") != 0) &&
-                (strcmp(dp->d_name, "..") != 0))
-            {
-            #if defined(_WIN32)
-                sprintf(path, "%s\\%s", basePath, dp->d_name);
-            #else
-                sprintf(path, "%s/%s", basePath, dp->d_name);
-            #endif
+            const rlGpuTimerScope *scope = &result.scopes[i];
+            double time = scope->time/1000.0;
 
-                if (filter != NULL)
-                {
-                    if (IsPathFile(path))
-                    {
-                        if (IsFileExtension(path, filter))
-                        {
-                            strcpy(files->paths[files->count], path);
-                            files->count++;
-                        }
-                    }
-                    else
-                    {
-                        if (TextFindIndex(filter, DIRECTORY_FILTER_TAG) >= 0)
-                        {
-                            strcpy(files->paths[files->count], path);
-                            files->count++;
-                        }
-                    }
-                }
-                else
-                {
-                    strcpy(files->paths[files->count], path);
-                    files->count++;
-                }
+#if defined(SUPPORT_FRAME_PROFILER)
+            if (strcmp(scope->name, "FRAME") == 0) profiler.frame[PROFILER_PHASE_GPU_FRAME] = time;
+            else if (strcmp(scope->name, "BATCH") == 0) profiler.frame[PROFILER_PHASE_GPU_BATCH] = time;
+            else if (strcmp(scope->name, "TEXTURE") == 0) profiler.frame[PROFILER_PHASE_GPU_TEXTURE] = time;
+#endif
+#if defined(SUPPORT_STARTUP_TIMELINE)
+            // NOTE: The section starts with the frame on the CPU, the GPU runs it later
+            if (!timeline.complete && (strcmp(scope->name, "FRAME") == 0))
+            {
+                AddTimelineEvent("gpu_frame", timeline.gpuFrameStarts[result.frame%TIMELINE_GPU_FRAMES], time);
+                timeline.gpuFrames++;
             }
+#endif
         }
+    }
+}
 
-        closedir(dir);
+#if defined(SUPPORT_FRAME_PROFILER)
+// Move the frame phase times into the profiler history
+static void CommitProfilerFrame(void)
+{
+    int entry = profiler.head;
+
+    for (int phase = 0; phase < PROFILER_PHASE_COUNT; phase++)
+    {
+        float ms = (float)(profiler.frame[phase]*1000.0);
+        int bin = 0;
+        if (ms > PROFILER_MIN_TIME) bin = (int)ceil(log2(ms/PROFILER_MIN_TIME)*PROFILER_BINS_PER_OCTAVE);
+        if (bin > (FRAME_PROFILER_BINS - 1)) bin = FRAME_PROFILER_BINS - 1;
+
+        // Oldest entry leaves the window when it is full
+        if (profiler.count == FRAME_PROFILER_HISTORY) profiler.histogram[phase][profiler.historyBin[phase][entry]]--;
+
+        profiler.history[phase][entry] = ms;
+        profiler.historyBin[phase][entry] = (unsigned char)bin;
+        profiler.histogram[phase][bin]++;
+        if (phase <= PROFILER_PHASE_FRAME) profiler.frame[phase] = 0.0;    // NOTE: GPU phases keep the last times read
     }
-    else TRACELOG(LOG_WARNING, "FILEIO: Directory cannot be opened (%s)", basePath);
+
+    profiler.head = (profiler.head + 1)%FRAME_PROFILER_HISTORY;
+    if (profiler.count < FRAME_PROFILER_HISTORY) profiler.count++;
 }
 
-// Scan all files and directories recursively from a base path
-static void ScanDirectoryFilesRecursively(const char *basePath, FilePathList *files, const char *filter)
+// Draw profiler overlay: one row per phase with its percentiles and histogram
+static void DrawProfilerOverlay(void)
 {
-    char path[MAX_FILEPATH_LENGTH] = { 0 };
-    memset(path, 0, MAX_FILEPATH_LENGTH);
+#if defined(SUPPORT_MODULE_RSHAPES) && defined(SUPPORT_MODULE_RTEXT)
+    static const char *names[PROFILER_PHASE_COUNT] = { "INPUT", "PHYSICS", "JNI", "BATCH", "RENDER", "SWAP", "WAIT", "FRAME", "GPU", "GPU BAT", "GPU TEX" };
 
-    struct dirent *dp = NULL;
-    DIR *dir = opendir(basePath);
+    const int fontSize = (CORE.Window.screen.height >= 1080)? 20 : 10;
+    const int rowHeight = fontSize*2;
+    const int barWidth = 2;
+    const int textWidth = fontSize*20;
+    const int width = textWidth + FRAME_PROFILER_BINS*barWidth + fontSize;
+#if defined(SUPPORT_MEMORY_TRACKING)
+    const int memoryRows = 2;
+#else
+    const int memoryRows = 0;
+#endif
+    const int height = rowHeight*(PROFILER_PHASE_COUNT + 2 + memoryRows);
+    const int x = CORE.Window.screen.width - width - 10;
+    const int y = 10;
 
-    if (dir != NULL)
+    DrawRectangle(x, y, width, height, (Color){ 0, 0, 0, 180 });
+    DrawText(TextFormat("FRAME PROFILER (%i frames, ms)   p50 / p95 / p99 / max", profiler.count), x + fontSize/2, y + fontSize/2, fontSize, RAYWHITE);
+
+    for (int phase = 0; phase < PROFILER_PHASE_COUNT; phase++)
     {
-        while (((dp = readdir(dir)) != NULL) && (files->count < files->capacity))
-        {
-            if ((strcmp(dp->d_name, ".") != 0) && (strcmp(dp->d_name, "..") != 0))
-            {
-                // Construct new path from our base path
-            #if defined(_WIN32)
-                sprintf(path, "%s\\%s", basePath, dp->d_name);
-            #else
-                sprintf(path, "%s/%s", basePath, dp->d_name);
-            #endif
+        ProfilerStats stats = GetProfilerStats(phase);
+        int rowY = y + rowHeight*(phase + 1);
 
-                if (IsPathFile(path))
-                {
-                    if (filter != NULL)
-                    {
-                        if (IsFileExtension(path, filter))
-                        {
-                            strcpy(files->paths[files->count], path);
-                            files->count++;
-                        }
-                    }
-                    else
-                    {
-                        strcpy(files->paths[files->count], path);
-                        files->count++;
-                    }
+        if ((phase >= PROFILER_PHASE_GPU_FRAME) && !rlIsGpuTimerSupported())
+        {
+            DrawText(TextFormat("%-8s timer queries not supported", names[phase]), x + fontSize/2, rowY + fontSize/2, fontSize, GRAY);
+            continue;
+        }
 
-                    if (files->count >= files->capacity)
-                    {
-                        TRACELOG(LOG_WARNING, "FILEIO: Maximum filepath scan capacity reached (%i files)", files->capacity);
-                        break;
-                    }
-                }
-                else
-                {
-                    if ((filter != NULL) && (TextFindIndex(filter, DIRECTORY_FILTER_TAG) >= 0))
-                    {
-                        strcpy(files->paths[files->count], path);
-                        files->count++;
-                    }
+        DrawText(TextFormat("%-8s %5.2f %5.2f %5.2f %6.2f", names[phase], stats.p50, stats.p95, stats.p99, stats.max), x + fontSize/2, rowY + fontSize/2, fontSize, (stats.p99 > 1000.0f*CORE.Time.target)? ORANGE : RAYWHITE);
 
-                    if (files->count >= files->capacity)
-                    {
-                        TRACELOG(LOG_WARNING, "FILEIO: Maximum filepath scan capacity reached (%i files)", files->capacity);
-                        break;
-                    }
+        // Histogram bars, log-scale time axis, height relative to the fullest bin
+        int peak = 1;
+        for (int bin = 0; bin < FRAME_PROFILER_BINS; bin++) if (profiler.histogram[phase][bin] > peak) peak = profiler.histogram[phase][bin];
 
-                    ScanDirectoryFilesRecursively(path, files, filter);
-                }
-            }
+        for (int bin = 0; bin < FRAME_PROFILER_BINS; bin++)
+        {
+            int barHeight = (profiler.histogram[phase][bin]*(rowHeight - 4) + peak - 1)/peak;
+            if (barHeight > 0) DrawRectangle(x + textWidth + bin*barWidth, rowY + rowHeight - 2 - barHeight, barWidth, barHeight, SKYBLUE);
         }
-
-        closedir(dir);
     }
-    else TRACELOG(LOG_WARNING, "FILEIO: Directory cannot be opened (%s)", basePath);
+
+    // Render batch counters of the previous frame (this one is still being batched)
+    rlRenderBatchStats batch = rlGetRenderBatchStats();
+    DrawText(TextFormat("BATCH    %i flushes (%i buffer full, %i draw calls full), %i draw calls, %i KB, %i GPU waits", batch.flushes, batch.limitFlushes, batch.drawCallFlushes,
+        batch.drawCalls, batch.uploadedBytes/1024, batch.syncWaits), x + fontSize/2, y + rowHeight*(PROFILER_PHASE_COUNT + 1) + fontSize/2, fontSize, (batch.syncWaits > 0)? ORANGE : RAYWHITE);
+
+#if defined(SUPPORT_MEMORY_TRACKING)
+    // Live memory (KB), GPU sizes are estimates
+    MemoryStats cpu = GetMemoryStats(MEMORY_TAG_CPU);
+    MemoryStats gpuTextures = GetMemoryStats(MEMORY_TAG_GPU_TEXTURES);
+    MemoryStats gpuBuffers = GetMemoryStats(MEMORY_TAG_GPU_BUFFERS);
+    MemoryStats gpu = GetMemoryStats(MEMORY_TAG_GPU);
+    DrawText(TextFormat("MEMORY   CPU %lli KB (peak %lli), GPU ~%lli KB (peak %lli): %i textures %lli KB, %i buffers %lli KB", cpu.bytes/1024, cpu.peak/1024,
+        gpu.bytes/1024, gpu.peak/1024, gpuTextures.count, gpuTextures.bytes/1024, gpuBuffers.count, gpuBuffers.bytes/1024), x + fontSize/2, y + rowHeight*(PROFILER_PHASE_COUNT + 2) + fontSize/2, fontSize, RAYWHITE);
+    DrawText(TextFormat("  CORE %lli RLGL %lli TEX %lli TEXT %lli MODEL %lli AUDIO %lli MA %lli MOB %lli GAME %lli",
+        GetMemoryStats(MEMORY_TAG_CORE).bytes/1024, GetMemoryStats(MEMORY_TAG_RLGL).bytes/1024, GetMemoryStats(MEMORY_TAG_TEXTURES).bytes/1024,
+        GetMemoryStats(MEMORY_TAG_TEXT).bytes/1024, GetMemoryStats(MEMORY_TAG_MODELS).bytes/1024, GetMemoryStats(MEMORY_TAG_AUDIO).bytes/1024,
+        GetMemoryStats(MEMORY_TAG_MINIAUDIO).bytes/1024, GetMemoryStats(MEMORY_TAG_RAYMOB).bytes/1024, GetMemoryStats(MEMORY_TAG_GAME).bytes/1024),
+        x + fontSize/2, y + rowHeight*(PROFILER_PHASE_COUNT + 3) + fontSize/2, fontSize, RAYWHITE);
+#endif
+#endif
 }
+#endif
 
 #if defined(SUPPORT_AUTOMATION_EVENTS)
 // Automation event recording
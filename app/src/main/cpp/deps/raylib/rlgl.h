@@ -52,6 +52,7 @@
 *       #define RL_DEFAULT_BATCH_BUFFER_ELEMENTS   8192    // Default internal render batch elements limits
 *       #define RL_DEFAULT_BATCH_BUFFERS              1    // Default number of batch buffers (multi-buffering)
 *       #define RL_DEFAULT_BATCH_DRAWCALLS          256    // Default number of batch draw calls (by state changes: mode, texture)
+*       #define RL_DEFAULT_BATCH_UPLOAD_MODE          0    // Default batch vertex upload mode (rlBatchUploadMode)
 *       #define RL_DEFAULT_BATCH_MAX_TEXTURE_UNITS    4    // Maximum number of textures units that can be activated on batch drawing (SetShaderValueTexture())
 *
 *       #define RL_MAX_MATRIX_STACK_SIZE             32    // Maximum size of internal Matrix stack
@@ -59,6 +60,11 @@
 *       #define RL_CULL_DISTANCE_NEAR              0.01    // Default projection matrix near cull distance
 *       #define RL_CULL_DISTANCE_FAR             1000.0    // Default projection matrix far cull distance
 *
+*       #define RL_GPU_TIMER_FRAMES                   4    // Frames timed by GPU timer queries at once (results read this many frames later at most)
+*       #define RL_GPU_TIMER_SEGMENTS               128    // GPU timer queries per frame (one at every scope begin and end)
+*       #define RL_GPU_TIMER_SCOPES                  16    // GPU timer scope names per frame
+*       #define RL_GPU_TIMER_STACK_SIZE               8    // GPU timer scopes open at once
+*
 *       When loading a shader, the following vertex attributes and uniform
 *       location names are tried to be set automatically:
 *
@@ -218,6 +224,9 @@
 #ifndef RL_DEFAULT_BATCH_DRAWCALLS
     #define RL_DEFAULT_BATCH_DRAWCALLS             256      // Default number of batch draw calls (by state changes: mode, texture)
 #endif
+#ifndef RL_DEFAULT_BATCH_UPLOAD_MODE
+    #define RL_DEFAULT_BATCH_UPLOAD_MODE             0      // Default batch vertex upload mode (rlBatchUploadMode, 0: RL_BATCH_UPLOAD_SUBDATA)
+#endif
 #ifndef RL_DEFAULT_BATCH_MAX_TEXTURE_UNITS
     #define RL_DEFAULT_BATCH_MAX_TEXTURE_UNITS       4      // Maximum number of textures units that can be activated on batch drawing (SetShaderValueTexture())
 #endif
@@ -240,6 +249,20 @@
     #define RL_CULL_DISTANCE_FAR                1000.0      // Default far cull distance
 #endif
 
+// GPU timer queries
+#ifndef RL_GPU_TIMER_FRAMES
+    #define RL_GPU_TIMER_FRAMES                      4      // Frames timed at once, a frame is not timed while all of them wait for results
+#endif
+#ifndef RL_GPU_TIMER_SEGMENTS
+    #define RL_GPU_TIMER_SEGMENTS                  128      // Queries per frame, every scope begin and end starts one (later GPU time is not counted)
+#endif
+#ifndef RL_GPU_TIMER_SCOPES
+    #define RL_GPU_TIMER_SCOPES                     16      // Scope names per frame (32 at most, later names are not timed)
+#endif
+#ifndef RL_GPU_TIMER_STACK_SIZE
+    #define RL_GPU_TIMER_STACK_SIZE                  8      // Scopes open at once (deeper ones are not timed)
+#endif
+
 // Texture parameters (equivalent to OpenGL defines)
 #define RL_TEXTURE_WRAP_S                       0x2802      // GL_TEXTURE_WRAP_S
 #define RL_TEXTURE_WRAP_T                       0x2803      // GL_TEXTURE_WRAP_T
@@ -393,6 +416,7 @@ typedef struct rlVertexBuffer {
 #endif
     unsigned int vaoId;         // OpenGL Vertex Array Object id
     unsigned int vboId[5];      // OpenGL Vertex Buffer Objects id (5 types of vertex data)
+    void *fence;                // OpenGL sync object of the last draw from this buffer (RL_BATCH_UPLOAD_MAP_UNSYNCHRONIZED)
 } rlVertexBuffer;
 
 // Draw call type
@@ -422,6 +446,30 @@ typedef struct rlRenderBatch {
     float currentDepth;         // Current depth value for next draw
 } rlRenderBatch;
 
+// rlRenderBatchStats type, counters of one frame (rlCommitRenderBatchStats())
+typedef struct rlRenderBatchStats {
+    int flushes;                // Batch draws with vertex data (every state change flushes the batch)
+    int limitFlushes;           // Flushes forced by a full vertex buffer (rlCheckRenderBatchLimit())
+    int drawCallFlushes;        // Flushes forced by running out of draw calls (RL_DEFAULT_BATCH_DRAWCALLS)
+    int drawCalls;              // OpenGL draw calls issued by the batch
+    int uploadedBytes;          // Vertex data uploaded to the batch buffers
+    int syncWaits;              // Unsynchronized uploads that waited for the GPU (too few batch buffers)
+} rlRenderBatchStats;
+
+// rlGpuTimerScope type, GPU time of a named scope over one frame
+typedef struct rlGpuTimerScope {
+    const char *name;           // Scope name, as given to rlBeginGpuScope()
+    float time;                 // GPU time in milliseconds, scopes nested into it included
+    int count;                  // Times the scope was begun in the frame
+} rlGpuTimerScope;
+
+// rlGpuTimerFrame type, GPU times of one frame read back (rlGetGpuTimerFrame())
+typedef struct rlGpuTimerFrame {
+    unsigned int frame;         // Frame number returned by rlCommitGpuTimerFrame()
+    int scopeCount;             // Scopes begun in the frame
+    rlGpuTimerScope scopes[RL_GPU_TIMER_SCOPES]; // Scopes in the order they were first begun
+} rlGpuTimerFrame;
+
 // OpenGL version
 typedef enum {
     RL_OPENGL_11 = 1,           // OpenGL 1.1
@@ -589,6 +637,15 @@ typedef enum {
     RL_CULL_FACE_BACK
 } rlCullMode;
 
+// Render batch vertex upload mode
+// NOTE: With a single batch buffer every upload can wait for the GPU to finish the previous draw,
+// use RL_DEFAULT_BATCH_BUFFERS > 1 so consecutive flushes go to different buffers
+typedef enum {
+    RL_BATCH_UPLOAD_SUBDATA = 0,        // glBufferSubData() into the buffer storage
+    RL_BATCH_UPLOAD_ORPHAN,             // glBufferData(NULL) first, the driver replaces a storage still in use instead of waiting
+    RL_BATCH_UPLOAD_MAP_UNSYNCHRONIZED  // glMapBufferRange() unsynchronized, one fence per batch buffer (OpenGL 3.3 and ES 3.0 only)
+} rlBatchUploadMode;
+
 //------------------------------------------------------------------------------------
 // Functions Declaration - Matrix operations
 //------------------------------------------------------------------------------------
@@ -725,6 +782,10 @@ RLAPI void rlDrawRenderBatch(rlRenderBatch *batch);     // Draw render batch dat
 RLAPI void rlSetRenderBatchActive(rlRenderBatch *batch); // Set the active render batch for rlgl (NULL for default internal)
 RLAPI void rlDrawRenderBatchActive(void);               // Update and draw internal render batch
 RLAPI bool rlCheckRenderBatchLimit(int vCount);         // Check internal buffer overflow for a given number of vertex
+RLAPI void rlSetRenderBatchUploadMode(int mode);        // Set render batch vertex upload mode (rlBatchUploadMode)
+RLAPI int rlGetRenderBatchUploadMode(void);             // Get render batch vertex upload mode
+RLAPI rlRenderBatchStats rlGetRenderBatchStats(void);   // Get render batch counters of the last committed frame
+RLAPI void rlCommitRenderBatchStats(void);              // Close render batch counters of current frame (called by EndDrawing())
 
 RLAPI void rlSetTexture(unsigned int id);               // Set current texture for render batch and check buffers limits
 
@@ -753,10 +814,29 @@ RLAPI unsigned int rlLoadTextureCubemap(const void *data, int size, int format,
 RLAPI void rlUpdateTexture(unsigned int id, int offsetX, int offsetY, int width, int height, int format, const void *data); // Update texture with new data on GPU
 RLAPI void rlGetGlTextureFormats(int format, unsigned int *glInternalFormat, unsigned int *glFormat, unsigned int *glType); // Get OpenGL internal formats
 RLAPI const char *rlGetPixelFormatName(unsigned int format);              // Get name string for pixel format
+RLAPI bool rlIsPixelFormatSupported(int format);                         // Check if pixel format can be loaded as a texture (GPU compressed formats need extensions)
 RLAPI void rlUnloadTexture(unsigned int id);                              // Unload texture from GPU memory
 RLAPI void rlGenTextureMipmaps(unsigned int id, int width, int height, int format, int *mipmaps); // Generate mipmap data for selected texture
 RLAPI void *rlReadTexturePixels(unsigned int id, int width, int height, int format); // Read texture pixel data
 RLAPI unsigned char *rlReadScreenPixels(int width, int height);           // Read screen pixel data (color buffer)
+RLAPI void rlReadScreenPixelsTo(unsigned char *pixels, int width, int height); // Read screen pixel data (color buffer) into 'pixels' (width*height*4 bytes)
+
+// Asynchronous screen reads (OpenGL 3.3 and ES 3.0): pixels go to a pixel buffer, read back once its fence is signaled
+RLAPI unsigned int rlLoadPixelBuffer(int size);                            // Load a pixel pack buffer of 'size' bytes (0 if not supported)
+RLAPI void rlUnloadPixelBuffer(unsigned int pboId);                        // Unload pixel pack buffer
+RLAPI void *rlReadScreenPixelsAsync(unsigned int pboId, int width, int height); // Start reading screen pixels (RGBA) into a pixel buffer, returns its fence (NULL on failure)
+RLAPI bool rlReadPixelBuffer(unsigned int pboId, void *data, int size);    // Copy pixel buffer data once its read is done, rows bottom to top as read from the screen
+RLAPI bool rlIsSyncDone(void *sync, bool wait);                            // Check if a fence is signaled, waiting for it if requested
+RLAPI void rlUnloadSync(void *sync);                                       // Unload fence
+
+// GPU timer queries (GL_EXT_disjoint_timer_query on OpenGL ES, core on OpenGL 3.3), read back a few frames later
+RLAPI bool rlIsGpuTimerSupported(void);                                    // Check if GPU timer queries are supported
+RLAPI void rlEnableGpuTimer(void);                                         // Enable GPU timer scopes (disabled by default)
+RLAPI void rlDisableGpuTimer(void);                                        // Disable GPU timer scopes
+RLAPI void rlBeginGpuScope(const char *name);                              // Begin a named GPU timer scope, scopes nest (name kept by pointer, i.e. a literal)
+RLAPI void rlEndGpuScope(void);                                            // End the last GPU timer scope begun
+RLAPI unsigned int rlCommitGpuTimerFrame(void);                            // Close GPU timers of current frame and read the finished ones, returns the frame number (0 if not timed)
+RLAPI bool rlGetGpuTimerFrame(rlGpuTimerFrame *frame);                     // Get the oldest frame GPU times read back (false if none is ready)
 
 // Framebuffer management (fbo)
 RLAPI unsigned int rlLoadFramebuffer(void);                               // Load an empty framebuffer
@@ -777,6 +857,12 @@ RLAPI void rlSetUniformMatrices(int locIndex, const Matrix *mat, int count);
 RLAPI void rlSetUniformSampler(int locIndex, unsigned int textureId);           // Set shader value sampler
 RLAPI void rlSetShader(unsigned int id, int *locs);                             // Set shader currently active (id and locations)
 
+// Shader program binary cache (OpenGL ES 3.0): linked programs are saved and loaded back instead of compiled
+// NOTE: Keys hash the shader code and the GL renderer and version strings, a driver update changes them
+typedef unsigned char *(*rlLoadShaderBinaryCallback)(unsigned long long key, int *size);                // Load saved program binary (RL_MALLOC), NULL when missing
+typedef void (*rlSaveShaderBinaryCallback)(unsigned long long key, const unsigned char *data, int size);  // Save program binary
+RLAPI void rlSetShaderBinaryCallbacks(rlLoadShaderBinaryCallback load, rlSaveShaderBinaryCallback save); // Set program binary cache callbacks (before rlglInit() to cache the default shader)
+
 // Compute shader management
 RLAPI unsigned int rlLoadComputeShaderProgram(unsigned int shaderId);           // Load compute shader program
 RLAPI void rlComputeShaderDispatch(unsigned int groupX, unsigned int groupY, unsigned int groupZ); // Dispatch compute shader (equivalent to *draw* for graphics pipeline)
@@ -954,6 +1040,19 @@ RLAPI void rlLoadDrawQuad(void);     // Load and draw a quad
     #define GL_LINE_WIDTH                       0x0B21
 #endif
 
+#ifndef GL_QUERY_RESULT_EXT
+    #define GL_QUERY_RESULT_EXT                 0x8866
+#endif
+#ifndef GL_QUERY_RESULT_AVAILABLE_EXT
+    #define GL_QUERY_RESULT_AVAILABLE_EXT       0x8867
+#endif
+#ifndef GL_TIME_ELAPSED_EXT
+    #define GL_TIME_ELAPSED_EXT                 0x88BF
+#endif
+#ifndef GL_GPU_DISJOINT_EXT
+    #define GL_GPU_DISJOINT_EXT                 0x8FBB
+#endif
+
 #if defined(GRAPHICS_API_OPENGL_11)
     #define GL_UNSIGNED_SHORT_5_6_5             0x8363
     #define GL_UNSIGNED_SHORT_5_5_5_1           0x8034
@@ -1034,6 +1133,20 @@ RLAPI void rlLoadDrawQuad(void);     // Load and draw a quad
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+// GPU timer frame being recorded or waiting for its results
+// NOTE: Timer queries can't nest, every scope begin and end closes the running query and starts a new
+// segment, timed for all the scopes open over it (one bit per scope name)
+typedef struct rlGpuTimerSlot {
+    unsigned int queries[RL_GPU_TIMER_SEGMENTS];        // Query objects, one per segment
+    unsigned int segmentScopes[RL_GPU_TIMER_SEGMENTS];  // Scopes open over every segment
+    int segmentCount;                                   // Segments recorded
+    const char *scopeNames[RL_GPU_TIMER_SCOPES];        // Scope names, bit index order
+    int scopeBegins[RL_GPU_TIMER_SCOPES];               // Times every scope was begun
+    int scopeCount;                                     // Scope names found in the frame
+    unsigned int frame;                                 // Frame number
+    bool pending;                                       // Frame closed, waiting for its results
+} rlGpuTimerSlot;
+
 typedef struct rlglData {
     rlRenderBatch *currentBatch;            // Current render batch
     rlRenderBatch defaultBatch;             // Default internal render batch
@@ -1057,6 +1170,8 @@ typedef struct rlglData {
         unsigned int activeTextureId[RL_DEFAULT_BATCH_MAX_TEXTURE_UNITS];    // Active texture ids to be enabled on batch drawing (0 active by default)
         unsigned int defaultVShaderId;      // Default vertex shader id (used by default shader program)
         unsigned int defaultFShaderId;      // Default fragment shader id (used by default shader program)
+        const char *defaultVShaderCode;     // Default vertex shader code (compiled on first use when the program came from the binary cache)
+        const char *defaultFShaderCode;     // Default fragment shader code (compiled on first use when the program came from the binary cache)
         unsigned int defaultShaderId;       // Default shader program id, supports vertex color and diffuse texture
         int *defaultShaderLocs;             // Default shader locations pointer to be used on rendering
         unsigned int currentShaderId;       // Current shader id to be used on rendering (by default, defaultShaderId)
@@ -1082,7 +1197,25 @@ typedef struct rlglData {
         int framebufferWidth;               // Current framebuffer width
         int framebufferHeight;              // Current framebuffer height
 
+        int batchUploadMode;                // Render batch vertex upload mode (rlBatchUploadMode)
+        rlRenderBatchStats batchStats;      // Render batch counters of current frame
+        rlRenderBatchStats batchStatsFrame; // Render batch counters of the last committed frame
+
     } State;            // Renderer state
+    struct {
+        bool enabled;                       // Scopes are timed (rlEnableGpuTimer())
+        rlGpuTimerSlot slots[RL_GPU_TIMER_FRAMES]; // Frames recorded, used in turn
+        int nextSlot;                       // Slot for the next frame, the oldest one
+        int currentSlot;                    // Slot of current frame, -1 if not timed (all slots pending)
+        bool frameOpen;                     // Current frame found its slot (first scope begun)
+        int stack[RL_GPU_TIMER_STACK_SIZE]; // Scopes open (bit index, -1 if not timed)
+        int stackDepth;                     // Scopes open, deeper than the stack ones included
+        unsigned int activeScopes;          // Scopes of the running query (0 if none is running)
+        unsigned int frameCounter;          // Frames closed with timers
+        rlGpuTimerFrame results[RL_GPU_TIMER_FRAMES]; // Frames read back, not got yet
+        int resultHead;                     // Oldest frame read back
+        int resultCount;                    // Frames read back
+    } GpuTimer;         // GPU timer queries state
     struct {
         bool vao;                           // VAO support (OpenGL ES2 could not support VAO extension) (GL_ARB_vertex_array_object)
         bool instancing;                    // Instancing supported (GL_ANGLE_instanced_arrays, GL_EXT_draw_instanced + GL_EXT_instanced_arrays)
@@ -1100,6 +1233,7 @@ typedef struct rlglData {
         bool texAnisoFilter;                // Anisotropic texture filtering support (GL_EXT_texture_filter_anisotropic)
         bool computeShader;                 // Compute shaders support (GL_ARB_compute_shader)
         bool ssbo;                          // Shader storage buffer object support (GL_ARB_shader_storage_buffer_object)
+        bool timerQuery;                    // GPU timer queries support (GL_EXT_disjoint_timer_query, GL_ARB_timer_query)
 
         float maxAnisotropyLevel;           // Maximum anisotropy level supported (minimum is 2.0f)
         int maxDepthBits;                   // Maximum bits for depth component
@@ -1119,6 +1253,9 @@ static double rlCullDistanceFar = RL_CULL_DISTANCE_FAR;
 
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
 static rlglData RLGL = { 0 };
+
+static rlLoadShaderBinaryCallback rlLoadShaderBinary = NULL;    // Program binary cache loader (kept across contexts)
+static rlSaveShaderBinaryCallback rlSaveShaderBinary = NULL;    // Program binary cache saver (kept across contexts)
 #endif  // GRAPHICS_API_OPENGL_33 || GRAPHICS_API_OPENGL_ES2
 
 #if defined(GRAPHICS_API_OPENGL_ES2) && !defined(GRAPHICS_API_OPENGL_ES3)
@@ -1133,12 +1270,36 @@ static PFNGLDRAWELEMENTSINSTANCEDEXTPROC glDrawElementsInstanced = NULL;
 static PFNGLVERTEXATTRIBDIVISOREXTPROC glVertexAttribDivisor = NULL;
 #endif
 
+#if defined(GRAPHICS_API_OPENGL_33)
+// NOTE: Timer queries are core on OpenGL 3.3 (GL_ARB_timer_query)
+#define rlglGenQueries glGenQueries
+#define rlglDeleteQueries glDeleteQueries
+#define rlglBeginQuery glBeginQuery
+#define rlglEndQuery glEndQuery
+#define rlglGetQueryObjectuiv glGetQueryObjectuiv
+#define rlglGetQueryObjectui64v glGetQueryObjectui64v
+#elif defined(GRAPHICS_API_OPENGL_ES2)
+// NOTE: Timer queries are exposed through an extension (EXT), on OpenGL ES 3.0 as well (64 bit results)
+static PFNGLGENQUERIESEXTPROC rlglGenQueries = NULL;
+static PFNGLDELETEQUERIESEXTPROC rlglDeleteQueries = NULL;
+static PFNGLBEGINQUERYEXTPROC rlglBeginQuery = NULL;
+static PFNGLENDQUERYEXTPROC rlglEndQuery = NULL;
+static PFNGLGETQUERYOBJECTUIVEXTPROC rlglGetQueryObjectuiv = NULL;
+static PFNGLGETQUERYOBJECTUI64VEXTPROC rlglGetQueryObjectui64v = NULL;
+#endif
+
 //----------------------------------------------------------------------------------
 // Module specific Functions Declaration
 //----------------------------------------------------------------------------------
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
 static void rlLoadShaderDefault(void);      // Load default shader
 static void rlUnloadShaderDefault(void);    // Unload default shader
+static void rlUploadRenderBatchBuffer(unsigned int id, const void *data, int dataSize, int bufferSize); // Upload render batch vertex data (current upload mode)
+static unsigned long long rlGetShaderBinaryKey(const char *vsCode, const char *fsCode);        // Get program binary cache key (0 when caching is disabled)
+static unsigned int rlLoadShaderProgramBinary(unsigned long long key);                        // Load program from its cached binary (0 when missing or rejected)
+static void rlSaveShaderProgramBinary(unsigned int id, unsigned long long key);               // Save program binary to the cache
+static void rlSwitchGpuTimerSegment(void);  // Start a GPU timer segment for the scopes open (after a scope begin or end)
+static void rlReadGpuTimerSlots(void);      // Read back GPU timer frames whose results are available, oldest first
 #if defined(RLGL_SHOW_GL_DETAILS_INFO)
 static const char *rlGetCompressedFormatName(int format); // Get compressed format official GL identifier name
 #endif  // RLGL_SHOW_GL_DETAILS_INFO
@@ -1146,6 +1307,20 @@ static const char *rlGetCompressedFormatName(int format); // Get compressed form
 
 static int rlGetPixelDataSize(int width, int height, int format);   // Get pixel data size in bytes (image or texture)
 
+#if defined(SUPPORT_MEMORY_TRACKING) && !defined(RLGL_STANDALONE)
+// GPU memory estimates, kept by raylib memory tracking (utils.c)
+// NOTE: Types as GpuObjectType: 0 texture, 1 renderbuffer, 2 buffer
+void TrackGpuObject(int type, unsigned int id, long long bytes);
+static long long rlGetTextureMemorySize(int width, int height, int format, int mipmapCount);  // Get texture size in bytes with its mipmaps
+
+#define RL_TRACK_GPU_OBJECT(type, id, bytes) TrackGpuObject(type, id, bytes)
+#else
+#define RL_TRACK_GPU_OBJECT(type, id, bytes) ((void)0)
+#endif
+#define RL_GPU_OBJECT_TEXTURE           0
+#define RL_GPU_OBJECT_RENDERBUFFER      1
+#define RL_GPU_OBJECT_BUFFER            2
+
 // Auxiliar matrix math functions
 typedef struct rl_float16 {
     float v[16];
@@ -1470,7 +1645,11 @@ void rlBegin(int mode)
             }
         }
 
-        if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS) rlDrawRenderBatch(RLGL.currentBatch);
+        if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS)
+        {
+            RLGL.State.batchStats.drawCallFlushes++;
+            rlDrawRenderBatch(RLGL.currentBatch);
+        }
 
         RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].mode = mode;
         RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount = 0;
@@ -1637,6 +1816,7 @@ void rlSetTexture(unsigned int id)
         if (RLGL.State.vertexCounter >=
             RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].elementCount*4)
         {
+            RLGL.State.batchStats.limitFlushes++;
             rlDrawRenderBatch(RLGL.currentBatch);
         }
 #endif
@@ -1667,7 +1847,11 @@ void rlSetTexture(unsigned int id)
                 }
             }
 
-            if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS) rlDrawRenderBatch(RLGL.currentBatch);
+            if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS)
+            {
+                RLGL.State.batchStats.drawCallFlushes++;
+                rlDrawRenderBatch(RLGL.currentBatch);
+            }
 
             RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].textureId = id;
             RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount = 0;
@@ -2256,6 +2440,13 @@ void rlglInit(int width, int height)
     RLGL.defaultBatch = rlLoadRenderBatch(RL_DEFAULT_BATCH_BUFFERS, RL_DEFAULT_BATCH_BUFFER_ELEMENTS);
     RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_NORMAL] = -1;
     RLGL.currentBatch = &RLGL.defaultBatch;
+    rlSetRenderBatchUploadMode(RL_DEFAULT_BATCH_UPLOAD_MODE);
+
+    // Init GPU timer queries, every frame slot gets its segments queries
+    if (RLGL.ExtSupported.timerQuery)
+    {
+        for (int i = 0; i < RL_GPU_TIMER_FRAMES; i++) rlglGenQueries(RL_GPU_TIMER_SEGMENTS, RLGL.GpuTimer.slots[i].queries);
+    }
 
     // Init stack matrices (emulating OpenGL 1.1)
     for (int i = 0; i < RL_MAX_MATRIX_STACK_SIZE; i++) RLGL.State.stack[i] = rlMatrixIdentity();
@@ -2315,8 +2506,18 @@ void rlglClose(void)
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     rlUnloadRenderBatch(RLGL.defaultBatch);
 
+    // Unload GPU timer queries, frames not read back yet are dropped
+    if (RLGL.ExtSupported.timerQuery)
+    {
+        for (int i = 0; i < RL_GPU_TIMER_FRAMES; i++) rlglDeleteQueries(RL_GPU_TIMER_SEGMENTS, RLGL.GpuTimer.slots[i].queries);
+    }
+    bool gpuTimerEnabled = RLGL.GpuTimer.enabled;
+    memset(&RLGL.GpuTimer, 0, sizeof(RLGL.GpuTimer));
+    RLGL.GpuTimer.enabled = gpuTimerEnabled;
+
     rlUnloadShaderDefault();          // Unload default shader
 
+    RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_TEXTURE, RLGL.State.defaultTextureId, 0);
     glDeleteTextures(1, &RLGL.State.defaultTextureId); // Unload default texture
     TRACELOG(RL_LOG_INFO, "TEXTURE: [ID %i] Default texture unloaded successfully", RLGL.State.defaultTextureId);
 #endif
@@ -2367,6 +2568,7 @@ void rlLoadExtensions(void *loader)
     RLGL.ExtSupported.maxDepthBits = 32;
     RLGL.ExtSupported.texAnisoFilter = true;
     RLGL.ExtSupported.texMirrorClamp = true;
+    RLGL.ExtSupported.timerQuery = true;
 #endif
 
     // Optional OpenGL 3.3 extensions
@@ -2393,12 +2595,27 @@ void rlLoadExtensions(void *loader)
     RLGL.ExtSupported.maxDepthBits = 24;
     RLGL.ExtSupported.texAnisoFilter = true;
     RLGL.ExtSupported.texMirrorClamp = true;
+    RLGL.ExtSupported.texCompETC2 = true;   // ETC2/EAC is core in OpenGL ES 3.0
+
+    // Check texture compression extensions
+    // NOTE: ASTC LDR is the profile available on mobile GPUs, HDR is rarely exposed
+    GLint numExt = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &numExt);
+    for (int i = 0; i < numExt; i++)
+    {
+        const char *ext = (const char *)glGetStringi(GL_EXTENSIONS, i);
+        if (ext == NULL) continue;
+
+        if ((strcmp(ext, "GL_EXT_texture_compression_s3tc") == 0) ||
+            (strcmp(ext, "GL_WEBGL_compressed_texture_s3tc") == 0)) RLGL.ExtSupported.texCompDXT = true;
+        if (strcmp(ext, "GL_OES_compressed_ETC1_RGB8_texture") == 0) RLGL.ExtSupported.texCompETC1 = true;
+        if (strcmp(ext, "GL_IMG_texture_compression_pvrtc") == 0) RLGL.ExtSupported.texCompPVRT = true;
+        if ((strcmp(ext, "GL_KHR_texture_compression_astc_ldr") == 0) ||
+            (strcmp(ext, "GL_KHR_texture_compression_astc_hdr") == 0) ||
+            (strcmp(ext, "GL_OES_texture_compression_astc") == 0)) RLGL.ExtSupported.texCompASTC = true;
+        if (strcmp(ext, "GL_EXT_disjoint_timer_query") == 0) RLGL.ExtSupported.timerQuery = true;
+    }
     // TODO: Check for additional OpenGL ES 3.0 supported extensions:
-    //RLGL.ExtSupported.texCompDXT = true;
-    //RLGL.ExtSupported.texCompETC1 = true;
-    //RLGL.ExtSupported.texCompETC2 = true;
-    //RLGL.ExtSupported.texCompPVRT = true;
-    //RLGL.ExtSupported.texCompASTC = true;
     //RLGL.ExtSupported.maxAnisotropyLevel = true;
     //RLGL.ExtSupported.computeShader = true;
     //RLGL.ExtSupported.ssbo = true;
@@ -2532,13 +2749,17 @@ void rlLoadExtensions(void *loader)
         if (strcmp(extList[i], (const char *)"GL_IMG_texture_compression_pvrtc") == 0) RLGL.ExtSupported.texCompPVRT = true;
 
         // Check texture compression support: ASTC
-        if (strcmp(extList[i], (const char *)"GL_KHR_texture_compression_astc_hdr") == 0) RLGL.ExtSupported.texCompASTC = true;
+        if ((strcmp(extList[i], (const char *)"GL_KHR_texture_compression_astc_hdr") == 0) ||
+            (strcmp(extList[i], (const char *)"GL_KHR_texture_compression_astc_ldr") == 0)) RLGL.ExtSupported.texCompASTC = true;
 
         // Check anisotropic texture filter support
         if (strcmp(extList[i], (const char *)"GL_EXT_texture_filter_anisotropic") == 0) RLGL.ExtSupported.texAnisoFilter = true;
 
         // Check clamp mirror wrap mode support
         if (strcmp(extList[i], (const char *)"GL_EXT_texture_mirror_clamp") == 0) RLGL.ExtSupported.texMirrorClamp = true;
+
+        // Check GPU timer queries support
+        if (strcmp(extList[i], (const char *)"GL_EXT_disjoint_timer_query") == 0) RLGL.ExtSupported.timerQuery = true;
     }
 
     // Free extensions pointers
@@ -2546,6 +2767,22 @@ void rlLoadExtensions(void *loader)
     RL_FREE(extensionsDup);    // Duplicated string must be deallocated
 #endif  // GRAPHICS_API_OPENGL_ES2
 
+#if defined(GRAPHICS_API_OPENGL_ES2)
+    // Get GPU timer queries functions pointers, the feature is only kept if all of them are present
+    if (RLGL.ExtSupported.timerQuery)
+    {
+        rlglGenQueries = (PFNGLGENQUERIESEXTPROC)((rlglLoadProc)loader)("glGenQueriesEXT");
+        rlglDeleteQueries = (PFNGLDELETEQUERIESEXTPROC)((rlglLoadProc)loader)("glDeleteQueriesEXT");
+        rlglBeginQuery = (PFNGLBEGINQUERYEXTPROC)((rlglLoadProc)loader)("glBeginQueryEXT");
+        rlglEndQuery = (PFNGLENDQUERYEXTPROC)((rlglLoadProc)loader)("glEndQueryEXT");
+        rlglGetQueryObjectuiv = (PFNGLGETQUERYOBJECTUIVEXTPROC)((rlglLoadProc)loader)("glGetQueryObjectuivEXT");
+        rlglGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VEXTPROC)((rlglLoadProc)loader)("glGetQueryObjectui64vEXT");
+
+        RLGL.ExtSupported.timerQuery = (rlglGenQueries != NULL) && (rlglDeleteQueries != NULL) && (rlglBeginQuery != NULL) &&
+            (rlglEndQuery != NULL) && (rlglGetQueryObjectuiv != NULL) && (rlglGetQueryObjectui64v != NULL);
+    }
+#endif
+
     // Check OpenGL information and capabilities
     //------------------------------------------------------------------------------
     // Show current OpenGL and GLSL version
@@ -2608,6 +2845,7 @@ void rlLoadExtensions(void *loader)
     if (RLGL.ExtSupported.texCompASTC) TRACELOG(RL_LOG_INFO, "GL: ASTC compressed textures supported");
     if (RLGL.ExtSupported.computeShader) TRACELOG(RL_LOG_INFO, "GL: Compute shaders supported");
     if (RLGL.ExtSupported.ssbo) TRACELOG(RL_LOG_INFO, "GL: Shader storage buffer objects supported");
+    if (RLGL.ExtSupported.timerQuery) TRACELOG(RL_LOG_INFO, "GL: GPU timer queries supported");
 #endif  // RLGL_SHOW_GL_DETAILS_INFO
 
 #endif  // GRAPHICS_API_OPENGL_33 || GRAPHICS_API_OPENGL_ES2
@@ -2718,6 +2956,7 @@ rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
     for (int i = 0; i < numBuffers; i++)
     {
         batch.vertexBuffer[i].elementCount = bufferElements;
+        batch.vertexBuffer[i].fence = NULL;
 
         batch.vertexBuffer[i].vertices = (float *)RL_MALLOC(bufferElements*3*4*sizeof(float));        // 3 float by vertex, 4 vertex by quad
         batch.vertexBuffer[i].texcoords = (float *)RL_MALLOC(bufferElements*2*4*sizeof(float));       // 2 float by texcoord, 4 texcoord by quad
@@ -2801,10 +3040,16 @@ rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[4]);
 #if defined(GRAPHICS_API_OPENGL_33)
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, bufferElements*6*sizeof(int), batch.vertexBuffer[i].indices, GL_STATIC_DRAW);
+        RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_BUFFER, batch.vertexBuffer[i].vboId[4], bufferElements*6*sizeof(int));
 #endif
 #if defined(GRAPHICS_API_OPENGL_ES2)
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, bufferElements*6*sizeof(short), batch.vertexBuffer[i].indices, GL_STATIC_DRAW);
+        RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_BUFFER, batch.vertexBuffer[i].vboId[4], bufferElements*6*sizeof(short));
 #endif
+        RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_BUFFER, batch.vertexBuffer[i].vboId[0], bufferElements*3*4*sizeof(float));
+        RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_BUFFER, batch.vertexBuffer[i].vboId[1], bufferElements*2*4*sizeof(float));
+        RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_BUFFER, batch.vertexBuffer[i].vboId[2], bufferElements*3*4*sizeof(float));
+        RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_BUFFER, batch.vertexBuffer[i].vboId[3], bufferElements*4*4*sizeof(unsigned char));
     }
 
     TRACELOG(RL_LOG_INFO, "RLGL: Render batch vertex buffers loaded successfully in VRAM (GPU)");
@@ -2861,6 +3106,7 @@ void rlUnloadRenderBatch(rlRenderBatch batch)
         }
 
         // Delete VBOs from GPU (VRAM)
+        for (int j = 0; j < 5; j++) RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_BUFFER, batch.vertexBuffer[i].vboId[j], 0);
         glDeleteBuffers(1, &batch.vertexBuffer[i].vboId[0]);
         glDeleteBuffers(1, &batch.vertexBuffer[i].vboId[1]);
         glDeleteBuffers(1, &batch.vertexBuffer[i].vboId[2]);
@@ -2870,6 +3116,10 @@ void rlUnloadRenderBatch(rlRenderBatch batch)
         // Delete VAOs from GPU (VRAM)
         if (RLGL.ExtSupported.vao) glDeleteVertexArrays(1, &batch.vertexBuffer[i].vaoId);
 
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES3)
+        if (batch.vertexBuffer[i].fence != NULL) glDeleteSync((GLsync)batch.vertexBuffer[i].fence);
+#endif
+
         // Free vertex arrays memory from CPU (RAM)
         RL_FREE(batch.vertexBuffer[i].vertices);
         RL_FREE(batch.vertexBuffer[i].texcoords);
@@ -2889,49 +3139,48 @@ void rlUnloadRenderBatch(rlRenderBatch batch)
 void rlDrawRenderBatch(rlRenderBatch *batch)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    // Batches with vertex data are GPU timed, from their upload to their last draw
+    bool timed = (RLGL.State.vertexCounter > 0);
+    if (timed) rlBeginGpuScope("BATCH");
+
     // Update batch vertex buffers
     //------------------------------------------------------------------------------------------------------------
     // NOTE: If there is not vertex data, buffers doesn't need to be updated (vertexCount > 0)
     // TODO: If no data changed on the CPU arrays --> No need to re-update GPU arrays (use a change detector flag?)
     if (RLGL.State.vertexCounter > 0)
     {
+        rlVertexBuffer *buffer = &batch->vertexBuffer[batch->currentBuffer];
+        int bufferVertexCount = buffer->elementCount*4;
+
+        RLGL.State.batchStats.flushes++;
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES3)
+        // Unsynchronized writes are only safe once the GPU finished the last draw from this buffer,
+        // with enough batch buffers the fence is already signaled and nothing waits
+        if ((RLGL.State.batchUploadMode == RL_BATCH_UPLOAD_MAP_UNSYNCHRONIZED) && (buffer->fence != NULL))
+        {
+            GLenum status = glClientWaitSync((GLsync)buffer->fence, 0, 0);
+
+            if ((status != GL_ALREADY_SIGNALED) && (status != GL_CONDITION_SATISFIED))
+            {
+                RLGL.State.batchStats.syncWaits++;
+                glClientWaitSync((GLsync)buffer->fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+            }
+
+            glDeleteSync((GLsync)buffer->fence);
+            buffer->fence = NULL;
+        }
+#endif
+
         // Activate elements VAO
-        if (RLGL.ExtSupported.vao) glBindVertexArray(batch->vertexBuffer[batch->currentBuffer].vaoId);
-
-        // Vertex positions buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*3*sizeof(float), batch->vertexBuffer[batch->currentBuffer].vertices);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].vertices, GL_DYNAMIC_DRAW);  // Update all buffer
-
-        // Texture coordinates buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*2*sizeof(float), batch->vertexBuffer[batch->currentBuffer].texcoords);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*2*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].texcoords, GL_DYNAMIC_DRAW); // Update all buffer
-
-        // Normals buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[2]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*3*sizeof(float), batch->vertexBuffer[batch->currentBuffer].normals);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].normals, GL_DYNAMIC_DRAW); // Update all buffer
-
-        // Colors buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[3]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*4*sizeof(unsigned char), batch->vertexBuffer[batch->currentBuffer].colors);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*4*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].colors, GL_DYNAMIC_DRAW);    // Update all buffer
-
-        // NOTE: glMapBuffer() causes sync issue
-        // If GPU is working with this buffer, glMapBuffer() will wait(stall) until GPU to finish its job
-        // To avoid waiting (idle), you can call first glBufferData() with NULL pointer before glMapBuffer()
-        // If you do that, the previous data in PBO will be discarded and glMapBuffer() returns a new
-        // allocated pointer immediately even if GPU is still working with the previous data
-
-        // Another option: map the buffer object into client's memory
-        // Probably this code could be moved somewhere else...
-        // batch->vertexBuffer[batch->currentBuffer].vertices = (float *)glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE);
-        // if (batch->vertexBuffer[batch->currentBuffer].vertices)
-        // {
-            // Update vertex data
-        // }
-        // glUnmapBuffer(GL_ARRAY_BUFFER);
+        if (RLGL.ExtSupported.vao) glBindVertexArray(buffer->vaoId);
+
+        // Vertex positions, texture coordinates, normals and colors buffers
+        // NOTE: Only the part used by this batch is uploaded, buffer size is only required to orphan the storage
+        rlUploadRenderBatchBuffer(buffer->vboId[0], buffer->vertices, RLGL.State.vertexCounter*3*sizeof(float), bufferVertexCount*3*sizeof(float));
+        rlUploadRenderBatchBuffer(buffer->vboId[1], buffer->texcoords, RLGL.State.vertexCounter*2*sizeof(float), bufferVertexCount*2*sizeof(float));
+        rlUploadRenderBatchBuffer(buffer->vboId[2], buffer->normals, RLGL.State.vertexCounter*3*sizeof(float), bufferVertexCount*3*sizeof(float));
+        rlUploadRenderBatchBuffer(buffer->vboId[3], buffer->colors, RLGL.State.vertexCounter*4*sizeof(unsigned char), bufferVertexCount*4*sizeof(unsigned char));
 
         // Unbind the current VAO
         if (RLGL.ExtSupported.vao) glBindVertexArray(0);
@@ -3042,6 +3291,8 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
                 // Bind current draw call texture, activated as GL_TEXTURE0 and Bound to sampler2D texture0 by default
                 glBindTexture(GL_TEXTURE_2D, batch->draws[i].textureId);
 
+                if (batch->draws[i].vertexCount > 0) RLGL.State.batchStats.drawCalls++;
+
                 if ((batch->draws[i].mode == RL_LINES) || (batch->draws[i].mode == RL_TRIANGLES)) glDrawArrays(batch->draws[i].mode, vertexOffset, batch->draws[i].vertexCount);
                 else
                 {
@@ -3075,6 +3326,15 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
 
     // Restore viewport to default measures
     if (eyeCount == 2) rlViewport(0, 0, RLGL.State.framebufferWidth, RLGL.State.framebufferHeight);
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES3)
+    // Fence the draws reading this buffer, checked before the buffer is written again
+    if ((RLGL.State.batchUploadMode == RL_BATCH_UPLOAD_MAP_UNSYNCHRONIZED) && (RLGL.State.vertexCounter > 0))
+    {
+        batch->vertexBuffer[batch->currentBuffer].fence = (void *)glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+#endif
+    if (timed) rlEndGpuScope();
     //------------------------------------------------------------------------------------------------------------
 
     // Reset batch buffers
@@ -3140,6 +3400,7 @@ bool rlCheckRenderBatchLimit(int vCount)
         (RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].elementCount*4))
     {
         overflow = true;
+        RLGL.State.batchStats.limitFlushes++;
 
         // Store current primitive drawing mode and texture id
         int currentMode = RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].mode;
@@ -3156,6 +3417,46 @@ bool rlCheckRenderBatchLimit(int vCount)
     return overflow;
 }
 
+// Set render batch vertex upload mode
+// NOTE: RL_BATCH_UPLOAD_MAP_UNSYNCHRONIZED falls back to RL_BATCH_UPLOAD_ORPHAN without OpenGL 3.3 or ES 3.0
+void rlSetRenderBatchUploadMode(int mode)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if ((mode < RL_BATCH_UPLOAD_SUBDATA) || (mode > RL_BATCH_UPLOAD_MAP_UNSYNCHRONIZED)) mode = RL_BATCH_UPLOAD_SUBDATA;
+#if !defined(GRAPHICS_API_OPENGL_33) && !defined(GRAPHICS_API_OPENGL_ES3)
+    if (mode == RL_BATCH_UPLOAD_MAP_UNSYNCHRONIZED) mode = RL_BATCH_UPLOAD_ORPHAN;
+#endif
+
+    if (mode == RLGL.State.batchUploadMode) return;
+
+    // Pending vertex data is uploaded with the previous mode
+    rlDrawRenderBatch(RLGL.currentBatch);
+    RLGL.State.batchUploadMode = mode;
+
+    static const char *modeNames[3] = { "subdata", "orphan", "map unsynchronized" };
+    TRACELOG(RL_LOG_INFO, "RLGL: Render batch upload mode: %s (%i buffers)", modeNames[mode], RLGL.currentBatch->bufferCount);
+#endif
+}
+
+// Get render batch vertex upload mode
+int rlGetRenderBatchUploadMode(void)
+{
+    return RLGL.State.batchUploadMode;
+}
+
+// Get render batch counters of the last committed frame
+rlRenderBatchStats rlGetRenderBatchStats(void)
+{
+    return RLGL.State.batchStatsFrame;
+}
+
+// Close render batch counters of current frame, next frame counts from zero
+void rlCommitRenderBatchStats(void)
+{
+    RLGL.State.batchStatsFrame = RLGL.State.batchStats;
+    RLGL.State.batchStats = (rlRenderBatchStats){ 0 };
+}
+
 // Textures data management
 //-----------------------------------------------------------------------------------------
 // Convert image data to OpenGL texture (returns OpenGL valid Id)
@@ -3305,6 +3606,8 @@ unsigned int rlLoadTexture(const void *data, int width, int height, int format,
     // Unbind current texture
     glBindTexture(GL_TEXTURE_2D, 0);
 
+    RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_TEXTURE, id, rlGetTextureMemorySize(width, height, format, mipmapCount));
+
     if (id > 0) TRACELOG(RL_LOG_INFO, "TEXTURE: [ID %i] Texture loaded successfully (%ix%i | %s | %i mipmaps)", id, width, height, rlGetPixelFormatName(format), mipmapCount);
     else TRACELOG(RL_LOG_WARNING, "TEXTURE: Failed to load texture");
 
@@ -3349,6 +3652,8 @@ unsigned int rlLoadTextureDepth(int width, int height, bool useRenderBuffer)
 
         glBindTexture(GL_TEXTURE_2D, 0);
 
+        RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_TEXTURE, id, (long long)width*height*((RLGL.ExtSupported.maxDepthBits >= 24)? 4 : 2));
+
         TRACELOG(RL_LOG_INFO, "TEXTURE: Depth texture loaded successfully");
     }
     else
@@ -3361,6 +3666,9 @@ unsigned int rlLoadTextureDepth(int width, int height, bool useRenderBuffer)
 
         glBindRenderbuffer(GL_RENDERBUFFER, 0);
 
+        // NOTE: 24 bits depth is usually stored in 32 bits
+        RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_RENDERBUFFER, id, (long long)width*height*((glInternalFormat == GL_DEPTH_COMPONENT16)? 2 : 4));
+
         TRACELOG(RL_LOG_INFO, "TEXTURE: [ID %i] Depth renderbuffer loaded successfully (%i bits)", id, (RLGL.ExtSupported.maxDepthBits >= 24)? RLGL.ExtSupported.maxDepthBits : 16);
     }
 #endif
@@ -3457,6 +3765,8 @@ unsigned int rlLoadTextureCubemap(const void *data, int size, int format, int mi
 #endif
 
     glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+    RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_TEXTURE, id, 6*rlGetTextureMemorySize(size, size, format, mipmapCount));
 #endif
 
     if (id > 0) TRACELOG(RL_LOG_INFO, "TEXTURE: [ID %i] Cubemap texture loaded successfully (%ix%i)", id, size, size);
@@ -3557,6 +3867,7 @@ void rlGetGlTextureFormats(int format, unsigned int *glInternalFormat, unsigned
 // Unload texture from GPU memory
 void rlUnloadTexture(unsigned int id)
 {
+    RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_TEXTURE, id, 0);
     glDeleteTextures(1, &id);
 }
 
@@ -3582,6 +3893,7 @@ void rlGenTextureMipmaps(unsigned int id, int width, int height, int format, int
         #define MAX(a,b) (((a)>(b))? (a):(b))
 
         *mipmaps = 1 + (int)floor(log(MAX(width, height))/log(2));
+        RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_TEXTURE, id, rlGetTextureMemorySize(width, height, format, *mipmaps));
         TRACELOG(RL_LOG_INFO, "TEXTURE: [ID %i] Mipmaps generated automatically, total: %i", id, *mipmaps);
     }
     else TRACELOG(RL_LOG_WARNING, "TEXTURE: [ID %i] Failed to generate mipmaps", id);
@@ -3659,30 +3971,273 @@ void *rlReadTexturePixels(unsigned int id, int width, int height, int format)
 // Read screen pixel data (color buffer)
 unsigned char *rlReadScreenPixels(int width, int height)
 {
-    unsigned char *screenData = (unsigned char *)RL_CALLOC(width*height*4, sizeof(unsigned char));
+    unsigned char *imgData = (unsigned char *)RL_MALLOC(width*height*4*sizeof(unsigned char));
+
+    if (imgData != NULL) rlReadScreenPixelsTo(imgData, width, height);
+
+    return imgData;     // NOTE: image data should be freed
+}
 
+// Read screen pixel data (color buffer) into a buffer of width*height*4 bytes
+// NOTE: The image is flipped in place, no other buffer is needed
+void rlReadScreenPixelsTo(unsigned char *pixels, int width, int height)
+{
     // NOTE 1: glReadPixels returns image flipped vertically -> (0,0) is the bottom left corner of the framebuffer
     // NOTE 2: We are getting alpha channel! Be careful, it can be transparent if not cleared properly!
-    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, screenData);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
 
     // Flip image vertically!
-    unsigned char *imgData = (unsigned char *)RL_MALLOC(width*height*4*sizeof(unsigned char));
+    int stride = width*4;
+    for (int top = 0, bottom = height - 1; top < bottom; top++, bottom--)
+    {
+        unsigned char *topLine = pixels + top*stride;
+        unsigned char *bottomLine = pixels + bottom*stride;
+
+        for (int x = 0; x < stride; x++)
+        {
+            unsigned char value = topLine[x];
+            topLine[x] = bottomLine[x];
+            bottomLine[x] = value;
+        }
+    }
+
+    // Set alpha component value to 255 (no trasparent image retrieval)
+    // NOTE: Alpha value has already been applied to RGB in framebuffer, we don't need it!
+    for (int i = 3; i < stride*height; i += 4) pixels[i] = 255;
+}
+
+// Load a pixel pack buffer of 'size' bytes for asynchronous screen reads
+unsigned int rlLoadPixelBuffer(int size)
+{
+    unsigned int id = 0;
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES3)
+    glGenBuffers(1, &id);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, id);
+    glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_BUFFER, id, size);
+#endif
+
+    return id;
+}
+
+// Unload pixel pack buffer
+void rlUnloadPixelBuffer(unsigned int pboId)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES3)
+    RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_BUFFER, pboId, 0);
+    glDeleteBuffers(1, &pboId);
+#endif
+}
+
+// Start reading screen pixels (color buffer, RGBA) into a pixel buffer of width*height*4 bytes
+// NOTE: glReadPixels() returns right away, the fence is signaled once the GPU wrote the pixels
+void *rlReadScreenPixelsAsync(unsigned int pboId, int width, int height)
+{
+    void *sync = NULL;
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES3)
+    if (pboId == 0) return NULL;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pboId);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    sync = (void *)glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#endif
+
+    return sync;
+}
+
+// Copy pixel buffer data, once the read started into it is done (rlIsSyncDone())
+// NOTE: Rows go from the bottom of the screen to the top and alpha is kept, no conversion is done
+bool rlReadPixelBuffer(unsigned int pboId, void *data, int size)
+{
+    bool read = false;
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES3)
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pboId);
+
+    void *mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+    if (mapped != NULL)
+    {
+        memcpy(data, mapped, size);
+        read = glUnmapBuffer(GL_PIXEL_PACK_BUFFER);     // NOTE: Contents are undefined if unmapping fails
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#endif
+
+    return read;
+}
+
+// Check if a fence is signaled, waiting for it if requested
+// NOTE: No fence (NULL) is always done
+bool rlIsSyncDone(void *sync, bool wait)
+{
+    bool done = true;
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES3)
+    if (sync != NULL)
+    {
+        GLenum status = glClientWaitSync((GLsync)sync, GL_SYNC_FLUSH_COMMANDS_BIT, wait? GL_TIMEOUT_IGNORED : 0);
+        done = (status != GL_TIMEOUT_EXPIRED);      // NOTE: A failed wait (GL_WAIT_FAILED) will never be signaled
+    }
+#endif
+
+    return done;
+}
+
+// Unload fence
+void rlUnloadSync(void *sync)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES3)
+    if (sync != NULL) glDeleteSync((GLsync)sync);
+#endif
+}
+
+// GPU timer queries
+//-----------------------------------------------------------------------------------------
+// Check if GPU timer queries are supported
+bool rlIsGpuTimerSupported(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    return RLGL.ExtSupported.timerQuery;
+#else
+    return false;
+#endif
+}
+
+// Enable GPU timer scopes
+void rlEnableGpuTimer(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    RLGL.GpuTimer.enabled = true;
+#endif
+}
+
+// Disable GPU timer scopes
+// NOTE: Current frame stops being timed at its next scope begin or end
+void rlDisableGpuTimer(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    RLGL.GpuTimer.enabled = false;
+#endif
+}
+
+// Begin a named GPU timer scope
+// NOTE: Scopes are found by name pointer first, then by name, the name must outlive the frame read back
+void rlBeginGpuScope(const char *name)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (!RLGL.ExtSupported.timerQuery) return;
 
-    for (int y = height - 1; y >= 0; y--)
+    // First scope of the frame takes the next slot, unless it is still waiting for its results
+    if (!RLGL.GpuTimer.frameOpen)
     {
-        for (int x = 0; x < (width*4); x++)
+        rlGpuTimerSlot *slot = &RLGL.GpuTimer.slots[RLGL.GpuTimer.nextSlot];
+
+        RLGL.GpuTimer.frameOpen = true;
+        RLGL.GpuTimer.currentSlot = -1;
+
+        if (RLGL.GpuTimer.enabled && !slot->pending)
+        {
+            RLGL.GpuTimer.currentSlot = RLGL.GpuTimer.nextSlot;
+            slot->segmentCount = 0;
+            slot->scopeCount = 0;
+        }
+    }
+
+    int depth = RLGL.GpuTimer.stackDepth++;
+    if (depth >= RL_GPU_TIMER_STACK_SIZE) return;
+
+    int scope = -1;
+    if (RLGL.GpuTimer.currentSlot >= 0)
+    {
+        rlGpuTimerSlot *slot = &RLGL.GpuTimer.slots[RLGL.GpuTimer.currentSlot];
+
+        for (int i = 0; (i < slot->scopeCount) && (scope < 0); i++)
         {
-            imgData[((height - 1) - y)*width*4 + x] = screenData[(y*width*4) + x];  // Flip line
+            if ((slot->scopeNames[i] == name) || (strcmp(slot->scopeNames[i], name) == 0)) scope = i;
+        }
 
-            // Set alpha component value to 255 (no trasparent image retrieval)
-            // NOTE: Alpha value has already been applied to RGB in framebuffer, we don't need it!
-            if (((x + 1)%4) == 0) imgData[((height - 1) - y)*width*4 + x] = 255;
+        if ((scope < 0) && (slot->scopeCount < RL_GPU_TIMER_SCOPES) && (slot->scopeCount < 32))
+        {
+            scope = slot->scopeCount++;
+            slot->scopeNames[scope] = name;
+            slot->scopeBegins[scope] = 0;
         }
+
+        if (scope >= 0) slot->scopeBegins[scope]++;
     }
 
-    RL_FREE(screenData);
+    RLGL.GpuTimer.stack[depth] = scope;
+    rlSwitchGpuTimerSegment();
+#endif
+}
 
-    return imgData;     // NOTE: image data should be freed
+// End the last GPU timer scope begun
+void rlEndGpuScope(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (!RLGL.ExtSupported.timerQuery || (RLGL.GpuTimer.stackDepth == 0)) return;
+
+    RLGL.GpuTimer.stackDepth--;
+    if (RLGL.GpuTimer.stackDepth < RL_GPU_TIMER_STACK_SIZE) rlSwitchGpuTimerSegment();
+#endif
+}
+
+// Close GPU timers of current frame, then read back the frames whose results are available
+// NOTE: Scopes still open are closed with the frame, results are usually ready 1 to 3 frames later
+unsigned int rlCommitGpuTimerFrame(void)
+{
+    unsigned int frame = 0;
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (!RLGL.ExtSupported.timerQuery) return 0;
+
+    if (RLGL.GpuTimer.activeScopes != 0) rlglEndQuery(GL_TIME_ELAPSED_EXT);
+    RLGL.GpuTimer.activeScopes = 0;
+    RLGL.GpuTimer.stackDepth = 0;
+
+    if (RLGL.GpuTimer.frameOpen && (RLGL.GpuTimer.currentSlot >= 0))
+    {
+        rlGpuTimerSlot *slot = &RLGL.GpuTimer.slots[RLGL.GpuTimer.currentSlot];
+
+        if (slot->segmentCount > 0)
+        {
+            slot->frame = ++RLGL.GpuTimer.frameCounter;
+            slot->pending = true;
+            frame = slot->frame;
+
+            RLGL.GpuTimer.nextSlot = (RLGL.GpuTimer.nextSlot + 1)%RL_GPU_TIMER_FRAMES;
+        }
+    }
+
+    RLGL.GpuTimer.frameOpen = false;
+    RLGL.GpuTimer.currentSlot = -1;
+
+    rlReadGpuTimerSlots();
+#endif
+
+    return frame;
+}
+
+// Get the oldest frame GPU times read back
+bool rlGetGpuTimerFrame(rlGpuTimerFrame *frame)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (RLGL.GpuTimer.resultCount == 0) return false;
+
+    *frame = RLGL.GpuTimer.results[RLGL.GpuTimer.resultHead];
+    RLGL.GpuTimer.resultHead = (RLGL.GpuTimer.resultHead + 1)%RL_GPU_TIMER_FRAMES;
+    RLGL.GpuTimer.resultCount--;
+
+    return true;
+#else
+    return false;
+#endif
 }
 
 // Framebuffer management (fbo)
@@ -3791,8 +4346,16 @@ void rlUnloadFramebuffer(unsigned int id)
     glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &depthId);
 
     unsigned int depthIdU = (unsigned int)depthId;
-    if (depthType == GL_RENDERBUFFER) glDeleteRenderbuffers(1, &depthIdU);
-    else if (depthType == GL_TEXTURE) glDeleteTextures(1, &depthIdU);
+    if (depthType == GL_RENDERBUFFER)
+    {
+        RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_RENDERBUFFER, depthIdU, 0);
+        glDeleteRenderbuffers(1, &depthIdU);
+    }
+    else if (depthType == GL_TEXTURE)
+    {
+        RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_TEXTURE, depthIdU, 0);
+        glDeleteTextures(1, &depthIdU);
+    }
 
     // NOTE: If a texture object is deleted while its image is attached to the *currently bound* framebuffer,
     // the texture image is automatically detached from the currently bound framebuffer
@@ -3815,6 +4378,7 @@ unsigned int rlLoadVertexBuffer(const void *buffer, int size, bool dynamic)
     glGenBuffers(1, &id);
     glBindBuffer(GL_ARRAY_BUFFER, id);
     glBufferData(GL_ARRAY_BUFFER, size, buffer, dynamic? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+    RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_BUFFER, id, size);
 #endif
 
     return id;
@@ -3829,6 +4393,7 @@ unsigned int rlLoadVertexBufferElement(const void *buffer, int size, bool dynami
     glGenBuffers(1, &id);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, id);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, buffer, dynamic? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+    RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_BUFFER, id, size);
 #endif
 
     return id;
@@ -4035,6 +4600,7 @@ void rlUnloadVertexArray(unsigned int vaoId)
 void rlUnloadVertexBuffer(unsigned int vboId)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_BUFFER, vboId, 0);
     glDeleteBuffers(1, &vboId);
     //TRACELOG(RL_LOG_INFO, "VBO: Unloaded vertex data from VRAM (GPU)");
 #endif
@@ -4049,6 +4615,20 @@ unsigned int rlLoadShaderCode(const char *vsCode, const char *fsCode)
     unsigned int id = 0;
 
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    // NOTE: When the default program came from the binary cache there are no default shaders to reuse, their code is compiled instead
+    if ((vsCode == NULL) && (fsCode != NULL) && (RLGL.State.defaultVShaderId == 0)) vsCode = RLGL.State.defaultVShaderCode;
+    if ((fsCode == NULL) && (vsCode != NULL) && (RLGL.State.defaultFShaderId == 0)) fsCode = RLGL.State.defaultFShaderCode;
+
+    // Programs already linked from the same code (by the same driver) are loaded from the binary cache
+    // NOTE: Programs using a default shader are not cached, linking them is cheap
+    unsigned long long binaryKey = 0;
+    if ((vsCode != NULL) && (fsCode != NULL))
+    {
+        binaryKey = rlGetShaderBinaryKey(vsCode, fsCode);
+        if (binaryKey != 0) id = rlLoadShaderProgramBinary(binaryKey);
+        if (id > 0) return id;
+    }
+
     unsigned int vertexShaderId = 0;
     unsigned int fragmentShaderId = 0;
 
@@ -4091,6 +4671,7 @@ unsigned int rlLoadShaderCode(const char *vsCode, const char *fsCode)
             TRACELOG(RL_LOG_WARNING, "SHADER: Failed to load custom shader code, using default shader");
             id = RLGL.State.defaultShaderId;
         }
+        else if (binaryKey != 0) rlSaveShaderProgramBinary(id, binaryKey);
         /*
         else
         {
@@ -4209,6 +4790,11 @@ unsigned int rlLoadShaderProgram(unsigned int vShaderId, unsigned int fShaderId)
 
     // NOTE: If some attrib name is no found on the shader, it locations becomes -1
 
+#if defined(GRAPHICS_API_OPENGL_ES3)
+    // NOTE: Some drivers only keep a binary for programs marked retrievable before linking
+    if (rlSaveShaderBinary != NULL) glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+
     glLinkProgram(program);
 
     // NOTE: All uniform variables are intitialised to 0 when a program links
@@ -4394,6 +4980,14 @@ void rlSetShader(unsigned int id, int *locs)
 #endif
 }
 
+// Set shader program binary cache callbacks
+// NOTE: Binaries are only available on OpenGL ES 3.0, callbacks are never called otherwise
+void rlSetShaderBinaryCallbacks(rlLoadShaderBinaryCallback load, rlSaveShaderBinaryCallback save)
+{
+    rlLoadShaderBinary = load;
+    rlSaveShaderBinary = save;
+}
+
 // Load compute shader program
 unsigned int rlLoadComputeShaderProgram(unsigned int shaderId)
 {
@@ -4464,6 +5058,7 @@ unsigned int rlLoadShaderBuffer(unsigned int size, const void *data, int usageHi
     glBufferData(GL_SHADER_STORAGE_BUFFER, size, data, usageHint? usageHint : RL_STREAM_COPY);
     if (data == NULL) glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R8UI, GL_RED_INTEGER, GL_UNSIGNED_BYTE, NULL);    // Clear buffer data to 0
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_BUFFER, ssbo, size);
 #else
     TRACELOG(RL_LOG_WARNING, "SSBO: SSBO not enabled. Define GRAPHICS_API_OPENGL_43");
 #endif
@@ -4475,6 +5070,7 @@ unsigned int rlLoadShaderBuffer(unsigned int size, const void *data, int usageHi
 void rlUnloadShaderBuffer(unsigned int ssboId)
 {
 #if defined(GRAPHICS_API_OPENGL_43)
+    RL_TRACK_GPU_OBJECT(RL_GPU_OBJECT_BUFFER, ssboId, 0);
     glDeleteBuffers(1, &ssboId);
 #else
     TRACELOG(RL_LOG_WARNING, "SSBO: SSBO not enabled. Define GRAPHICS_API_OPENGL_43");
@@ -4824,6 +5420,18 @@ const char *rlGetPixelFormatName(unsigned int format)
     }
 }
 
+// Check if pixel format can be loaded as a texture
+// NOTE: Same checks as rlLoadTexture(), GPU compressed formats depend on the extensions found by rlLoadExtensions()
+bool rlIsPixelFormatSupported(int format)
+{
+    if ((format < RL_PIXELFORMAT_UNCOMPRESSED_GRAYSCALE) || (format > RL_PIXELFORMAT_COMPRESSED_ASTC_8x8_RGBA)) return false;
+
+    unsigned int glInternalFormat = 0, glFormat = 0, glType = 0;
+    rlGetGlTextureFormats(format, &glInternalFormat, &glFormat, &glType);
+
+    return (glInternalFormat != 0);
+}
+
 //----------------------------------------------------------------------------------
 // Module specific Functions Definition
 //----------------------------------------------------------------------------------
@@ -4938,10 +5546,23 @@ static void rlLoadShaderDefault(void)
 
     // NOTE: Compiled vertex/fragment shaders are not deleted,
     // they are kept for re-use as default shaders in case some shader loading fails
-    RLGL.State.defaultVShaderId = rlCompileShader(defaultVShaderCode, GL_VERTEX_SHADER);     // Compile default vertex shader
-    RLGL.State.defaultFShaderId = rlCompileShader(defaultFShaderCode, GL_FRAGMENT_SHADER);   // Compile default fragment shader
+    // NOTE: A program from the binary cache needs no shaders, rlLoadShaderCode() compiles their code when required
+    RLGL.State.defaultVShaderCode = defaultVShaderCode;
+    RLGL.State.defaultFShaderCode = defaultFShaderCode;
+    RLGL.State.defaultVShaderId = 0;
+    RLGL.State.defaultFShaderId = 0;
 
-    RLGL.State.defaultShaderId = rlLoadShaderProgram(RLGL.State.defaultVShaderId, RLGL.State.defaultFShaderId);
+    unsigned long long binaryKey = rlGetShaderBinaryKey(defaultVShaderCode, defaultFShaderCode);
+    RLGL.State.defaultShaderId = (binaryKey != 0)? rlLoadShaderProgramBinary(binaryKey) : 0;
+
+    if (RLGL.State.defaultShaderId == 0)
+    {
+        RLGL.State.defaultVShaderId = rlCompileShader(defaultVShaderCode, GL_VERTEX_SHADER);     // Compile default vertex shader
+        RLGL.State.defaultFShaderId = rlCompileShader(defaultFShaderCode, GL_FRAGMENT_SHADER);   // Compile default fragment shader
+
+        RLGL.State.defaultShaderId = rlLoadShaderProgram(RLGL.State.defaultVShaderId, RLGL.State.defaultFShaderId);
+        if ((RLGL.State.defaultShaderId > 0) && (binaryKey != 0)) rlSaveShaderProgramBinary(RLGL.State.defaultShaderId, binaryKey);
+    }
 
     if (RLGL.State.defaultShaderId > 0)
     {
@@ -4966,8 +5587,9 @@ static void rlUnloadShaderDefault(void)
 {
     glUseProgram(0);
 
-    glDetachShader(RLGL.State.defaultShaderId, RLGL.State.defaultVShaderId);
-    glDetachShader(RLGL.State.defaultShaderId, RLGL.State.defaultFShaderId);
+    // NOTE: There are no default shaders when the program was loaded from the binary cache
+    if (RLGL.State.defaultVShaderId != 0) glDetachShader(RLGL.State.defaultShaderId, RLGL.State.defaultVShaderId);
+    if (RLGL.State.defaultFShaderId != 0) glDetachShader(RLGL.State.defaultShaderId, RLGL.State.defaultFShaderId);
     glDeleteShader(RLGL.State.defaultVShaderId);
     glDeleteShader(RLGL.State.defaultFShaderId);
 
@@ -4978,6 +5600,178 @@ static void rlUnloadShaderDefault(void)
     TRACELOG(RL_LOG_INFO, "SHADER: [ID %i] Default shader unloaded successfully", RLGL.State.defaultShaderId);
 }
 
+// Get program binary cache key: shader code, rlgl version and the driver (renderer and version strings)
+// NOTE: Returns 0 when there are no cache callbacks or program binaries are not available
+static unsigned long long rlGetShaderBinaryKey(const char *vsCode, const char *fsCode)
+{
+    unsigned long long key = 0;
+
+#if defined(GRAPHICS_API_OPENGL_ES3)
+    if ((rlLoadShaderBinary == NULL) && (rlSaveShaderBinary == NULL)) return 0;
+
+    const char *parts[5] = { vsCode, fsCode, RLGL_VERSION, (const char *)glGetString(GL_RENDERER), (const char *)glGetString(GL_VERSION) };
+
+    // FNV-1a 64-bit hash, a NUL separates the parts
+    key = 14695981039346656037ULL;
+    for (int i = 0; i < 5; i++)
+    {
+        const unsigned char *c = (const unsigned char *)((parts[i] != NULL)? parts[i] : "");
+        do { key ^= *c; key *= 1099511628211ULL; } while (*c++ != '\0');
+    }
+
+    if (key == 0) key = 1;
+#endif
+
+    return key;
+}
+
+// Load program from its cached binary
+// NOTE: Drivers reject binaries saved by other versions, the caller compiles the code again then
+static unsigned int rlLoadShaderProgramBinary(unsigned long long key)
+{
+    unsigned int program = 0;
+
+#if defined(GRAPHICS_API_OPENGL_ES3)
+    if (rlLoadShaderBinary == NULL) return 0;
+
+    // Binary data: binary format (4 bytes), then glGetProgramBinary() output
+    int dataSize = 0;
+    unsigned char *data = rlLoadShaderBinary(key, &dataSize);
+    if (data == NULL) return 0;
+
+    if (dataSize > 4)
+    {
+        unsigned int format = 0;
+        memcpy(&format, data, 4);
+
+        GLint success = 0;
+        program = glCreateProgram();
+        glProgramBinary(program, format, data + 4, dataSize - 4);
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+
+        if (success == GL_FALSE)
+        {
+            TRACELOG(RL_LOG_INFO, "SHADER: [ID %i] Cached program binary rejected, compiling shader code", program);
+            glDeleteProgram(program);
+            while (glGetError() != GL_NO_ERROR) { }     // Invalid formats also raise GL_INVALID_ENUM
+            program = 0;
+        }
+        else TRACELOG(RL_LOG_INFO, "SHADER: [ID %i] Program shader loaded from binary cache", program);
+    }
+
+    RL_FREE(data);
+#endif
+
+    return program;
+}
+
+// Save program binary to the cache
+static void rlSaveShaderProgramBinary(unsigned int id, unsigned long long key)
+{
+#if defined(GRAPHICS_API_OPENGL_ES3)
+    if (rlSaveShaderBinary == NULL) return;
+
+    // NOTE: Drivers without binary formats report a zero length
+    GLint length = 0;
+    glGetProgramiv(id, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    unsigned char *data = (unsigned char *)RL_MALLOC(length + 4);
+    if (data == NULL) return;
+
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(id, length, &written, &format, data + 4);
+
+    if (written > 0)
+    {
+        unsigned int binaryFormat = (unsigned int)format;
+        memcpy(data, &binaryFormat, 4);
+        rlSaveShaderBinary(key, data, written + 4);
+    }
+
+    RL_FREE(data);
+#endif
+}
+
+// Start a GPU timer segment for the scopes open, closing the running one
+// NOTE: Scopes deeper than the stack or past the frame names are not timed, nor is anything past the frame segments
+static void rlSwitchGpuTimerSegment(void)
+{
+    if (RLGL.GpuTimer.currentSlot < 0) return;
+
+    rlGpuTimerSlot *slot = &RLGL.GpuTimer.slots[RLGL.GpuTimer.currentSlot];
+    unsigned int scopes = 0;
+
+    int depth = (RLGL.GpuTimer.stackDepth < RL_GPU_TIMER_STACK_SIZE)? RLGL.GpuTimer.stackDepth : RL_GPU_TIMER_STACK_SIZE;
+    for (int i = 0; i < depth; i++) if (RLGL.GpuTimer.stack[i] >= 0) scopes |= (1u << RLGL.GpuTimer.stack[i]);
+
+    if (!RLGL.GpuTimer.enabled) scopes = 0;
+    if (scopes == RLGL.GpuTimer.activeScopes) return;      // Same scopes (i.e. a scope already open), the query goes on
+
+    if (RLGL.GpuTimer.activeScopes != 0) rlglEndQuery(GL_TIME_ELAPSED_EXT);
+    RLGL.GpuTimer.activeScopes = 0;
+
+    if ((scopes != 0) && (slot->segmentCount < RL_GPU_TIMER_SEGMENTS))
+    {
+        rlglBeginQuery(GL_TIME_ELAPSED_EXT, slot->queries[slot->segmentCount]);
+        slot->segmentScopes[slot->segmentCount++] = scopes;
+        RLGL.GpuTimer.activeScopes = scopes;
+    }
+}
+
+// Read back GPU timer frames whose results are available, oldest first
+// NOTE: Results of a frame come in order, the last segment is checked for all of them. A disjoint
+// operation (i.e. the GPU changed frequency or was preempted) makes the pending times meaningless, they are dropped
+static void rlReadGpuTimerSlots(void)
+{
+    for (int i = 0; i < RL_GPU_TIMER_FRAMES; i++)
+    {
+        rlGpuTimerSlot *slot = &RLGL.GpuTimer.slots[(RLGL.GpuTimer.nextSlot + i)%RL_GPU_TIMER_FRAMES];
+        if (!slot->pending) continue;
+
+        GLuint available = 0;
+        rlglGetQueryObjectuiv(slot->queries[slot->segmentCount - 1], GL_QUERY_RESULT_AVAILABLE_EXT, &available);
+        if (!available) break;
+
+#if defined(GRAPHICS_API_OPENGL_ES2)
+        GLint disjoint = 0;
+        glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+        if (disjoint)
+        {
+            for (int j = 0; j < RL_GPU_TIMER_FRAMES; j++) RLGL.GpuTimer.slots[j].pending = false;
+            TRACELOG(RL_LOG_DEBUG, "RLGL: GPU timer disjoint, pending frames dropped");
+            break;
+        }
+#endif
+
+        // Oldest frame read back is replaced when nobody got it
+        if (RLGL.GpuTimer.resultCount == RL_GPU_TIMER_FRAMES)
+        {
+            RLGL.GpuTimer.resultHead = (RLGL.GpuTimer.resultHead + 1)%RL_GPU_TIMER_FRAMES;
+            RLGL.GpuTimer.resultCount--;
+        }
+
+        rlGpuTimerFrame *result = &RLGL.GpuTimer.results[(RLGL.GpuTimer.resultHead + RLGL.GpuTimer.resultCount)%RL_GPU_TIMER_FRAMES];
+        RLGL.GpuTimer.resultCount++;
+
+        result->frame = slot->frame;
+        result->scopeCount = slot->scopeCount;
+        for (int j = 0; j < slot->scopeCount; j++) result->scopes[j] = (rlGpuTimerScope){ slot->scopeNames[j], 0.0f, slot->scopeBegins[j] };
+
+        for (int j = 0; j < slot->segmentCount; j++)
+        {
+            GLuint64 elapsed = 0;      // Nanoseconds
+            rlglGetQueryObjectui64v(slot->queries[j], GL_QUERY_RESULT_EXT, &elapsed);
+
+            float ms = (float)((double)elapsed*1e-6);
+            for (int k = 0; k < slot->scopeCount; k++) if (slot->segmentScopes[j] & (1u << k)) result->scopes[k].time += ms;
+        }
+
+        slot->pending = false;
+    }
+}
+
 #if defined(RLGL_SHOW_GL_DETAILS_INFO)
 // Get compressed format official GL identifier name
 static const char *rlGetCompressedFormatName(int format)
@@ -5054,6 +5848,40 @@ static const char *rlGetCompressedFormatName(int format)
 }
 #endif  // RLGL_SHOW_GL_DETAILS_INFO
 
+// Upload render batch vertex data to one of the batch buffers, with the current upload mode
+static void rlUploadRenderBatchBuffer(unsigned int id, const void *data, int dataSize, int bufferSize)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, id);
+
+    switch (RLGL.State.batchUploadMode)
+    {
+        case RL_BATCH_UPLOAD_ORPHAN:
+        {
+            // NOTE: A new storage is allocated for the buffer, the old one is released once the GPU is done with it
+            glBufferData(GL_ARRAY_BUFFER, bufferSize, NULL, GL_DYNAMIC_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, dataSize, data);
+        } break;
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES3)
+        case RL_BATCH_UPLOAD_MAP_UNSYNCHRONIZED:
+        {
+            void *mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, dataSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+            bool uploaded = false;
+
+            if (mapped != NULL)
+            {
+                memcpy(mapped, data, dataSize);
+                uploaded = glUnmapBuffer(GL_ARRAY_BUFFER);  // NOTE: Contents are undefined if unmapping fails
+            }
+
+            if (!uploaded) glBufferSubData(GL_ARRAY_BUFFER, 0, dataSize, data);
+        } break;
+#endif
+        default: glBufferSubData(GL_ARRAY_BUFFER, 0, dataSize, data); break;
+    }
+
+    RLGL.State.batchStats.uploadedBytes += dataSize;
+}
+
 #endif  // GRAPHICS_API_OPENGL_33 || GRAPHICS_API_OPENGL_ES2
 
 // Get pixel data size in bytes (image or texture)
@@ -5106,6 +5934,23 @@ static int rlGetPixelDataSize(int width, int height, int format)
     return dataSize;
 }
 
+#if defined(SUPPORT_MEMORY_TRACKING) && !defined(RLGL_STANDALONE)
+// Get texture size in bytes with its mipmaps (estimate of the GPU memory it takes)
+static long long rlGetTextureMemorySize(int width, int height, int format, int mipmapCount)
+{
+    long long size = 0;
+
+    for (int i = 0; i < ((mipmapCount > 1)? mipmapCount : 1); i++)
+    {
+        size += rlGetPixelDataSize(width, height, format);
+        width = (width > 1)? width/2 : 1;
+        height = (height > 1)? height/2 : 1;
+    }
+
+    return size;
+}
+#endif
+
 // Auxiliar math functions
 
 // Get float array of matrix data
@@ -44,6 +44,7 @@
 *
 **********************************************************************************************/
 
+#define RL_MEMORY_TAG MEMORY_TAG_MODELS
 #include "raylib.h"     // Declares module functions
 
 // Check if config flags have been externally provided on compilation line
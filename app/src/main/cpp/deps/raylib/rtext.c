@@ -53,6 +53,7 @@
 *
 **********************************************************************************************/
 
+#define RL_MEMORY_TAG MEMORY_TAG_TEXT
 #include "raylib.h"         // Declares module functions
 
 // Check if config flags have been externally provided on compilation line
@@ -93,6 +94,9 @@
         #pragma GCC diagnostic ignored "-Wunused-function"
     #endif
 
+    #define STBTT_malloc(x,u) ((void)(u), RL_MALLOC(x))    // Glyph bitmaps are freed by UnloadImage()
+    #define STBTT_free(x,u) ((void)(u), RL_FREE(x))
+
     #define STBTT_STATIC
     #define STB_TRUETYPE_IMPLEMENTATION
     #include "external/stb_truetype.h"      // Required for: ttf font data reading
@@ -383,16 +387,16 @@ Font LoadFontEx(const char *fileName, int fontSize, int *codepoints, int codepoi
 {
     Font font = { 0 };
 
-    // Loading file to memory
+    // Loading file to memory (mapped, rasterized in place)
     int dataSize = 0;
-    unsigned char *fileData = LoadFileData(fileName, &dataSize);
+    const unsigned char *fileData = LoadFileDataMapped(fileName, &dataSize);
 
     if (fileData != NULL)
     {
         // Loading font from memory data
         font = LoadFontFromMemory(GetFileExtension(fileName), fileData, dataSize, fontSize, codepoints, codepointCount);
 
-        UnloadFileData(fileData);
+        UnloadFileDataMapped(fileData);
     }
 
     return font;
@@ -1432,6 +1436,16 @@ const char *TextFormat(const char *text, ...)
         sprintf(truncBuffer, "...");
     }
 
+    // NOTE: On the InitWindow() thread the text is moved to frame memory, it is then valid until EndDrawing()
+    // instead of MAX_TEXTFORMAT_BUFFERS calls, and the buffer is free again
+    int length = (int)strlen(currentBuffer);
+    char *frameBuffer = (char *)MemAllocFrame(length + 1);
+    if (frameBuffer != NULL)
+    {
+        memcpy(frameBuffer, currentBuffer, length + 1);
+        return frameBuffer;
+    }
+
     index += 1;     // Move to next buffer for next function call
     if (index >= MAX_TEXTFORMAT_BUFFERS) index = 0;
 
@@ -61,6 +61,7 @@
 *
 **********************************************************************************************/
 
+#define RL_MEMORY_TAG MEMORY_TAG_TEXTURES
 #include "raylib.h"             // Declares module functions
 
 // Check if config flags have been externally provided on compilation line
@@ -239,7 +240,11 @@
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
-// ...
+// Images decoded by LoadImages(), one ParallelFor() item each
+typedef struct ImageBatch {
+    const char **fileNames;
+    Image *images;
+} ImageBatch;
 
 //----------------------------------------------------------------------------------
 // Global Variables Definition
@@ -257,6 +262,7 @@ extern void LoadFontDefault(void);          // [Module: text] Loads default font
 static float HalfToFloat(unsigned short x);
 static unsigned short FloatToHalf(float x);
 static Vector4 *LoadImageDataNormalized(Image image);       // Load pixel data from image as Vector4 array (float normalized)
+static void LoadImageRange(void *context, int start, int end);  // Load the images [start, end) of an ImageBatch (job worker)
 
 //----------------------------------------------------------------------------------
 // Module Functions Definition
@@ -280,21 +286,36 @@ Image LoadImage(const char *fileName)
     #define STBI_REQUIRED
 #endif
 
-    // Loading file to memory
+    // Loading file to memory (mapped, decoded in place)
     int dataSize = 0;
-    unsigned char *fileData = LoadFileData(fileName, &dataSize);
+    const unsigned char *fileData = LoadFileDataMapped(fileName, &dataSize);
 
     // Loading image from memory data
     if (fileData != NULL)
     {
         image = LoadImageFromMemory(GetFileExtension(fileName), fileData, dataSize);
 
-        UnloadFileData(fileData);
+        UnloadFileDataMapped(fileData);
     }
 
     return image;
 }
 
+// Load images from files, decoded in parallel
+// NOTE: One image per range, images are far from even (sizes, formats), workers take the next one when done
+int LoadImages(const char **fileNames, int count, Image *images)
+{
+    ImageBatch batch = { fileNames, images };
+    ParallelFor(count, 1, LoadImageRange, &batch);
+
+    int loaded = 0;
+    for (int i = 0; i < count; i++) if (images[i].data != NULL) loaded++;
+
+    if (loaded < count) TRACELOG(LOG_WARNING, "IMAGE: %i of %i images failed to load", count - loaded, count);
+
+    return loaded;
+}
+
 // Load an image from RAW file data
 Image LoadImageRaw(const char *fileName, int width, int height, int format, int headerSize)
 {
@@ -4111,6 +4132,34 @@ Texture2D LoadTexture(const char *fileName)
     return texture;
 }
 
+// Load textures from files
+// NOTE: Every image is decoded before the first upload (peak memory is all of them), GL calls stay
+// on the calling thread. A texture that failed to load is left empty (id 0)
+int LoadTextures(const char **fileNames, int count, Texture2D *textures)
+{
+    if (count <= 0) return 0;
+
+    Image *images = (Image *)RL_CALLOC(count, sizeof(Image));
+    LoadImages(fileNames, count, images);
+
+    int loaded = 0;
+    for (int i = 0; i < count; i++)
+    {
+        textures[i] = (Texture2D){ 0 };
+
+        if (images[i].data != NULL)
+        {
+            textures[i] = LoadTextureFromImage(images[i]);
+            UnloadImage(images[i]);
+            if (textures[i].id != 0) loaded++;
+        }
+    }
+
+    RL_FREE(images);
+
+    return loaded;
+}
+
 // Load a texture from image data
 // NOTE: image is not unloaded, it must be done manually
 Texture2D LoadTextureFromImage(Image image)
@@ -5545,4 +5594,12 @@ static Vector4 *LoadImageDataNormalized(Image image)
     return pixels;
 }
 
+// Load the images [start, end) of an ImageBatch
+static void LoadImageRange(void *context, int start, int end)
+{
+    ImageBatch *batch = (ImageBatch *)context;
+
+    for (int i = start; i < end; i++) batch->images[i] = LoadImage(batch->fileNames[i]);
+}
+
 #endif      // SUPPORT_MODULE_RTEXTURES
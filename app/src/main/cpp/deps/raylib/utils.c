@@ -7,6 +7,10 @@
 *           Show TraceLog() output messages
 *           NOTE: By default LOG_DEBUG traces not shown
 *
+*       #define SUPPORT_MEMORY_TRACKING
+*           Count live and peak memory by tag, RL_MALLOC() and friends go through MemAllocTracked()
+*           NOTE: Set on the compilation line (public definition of the raylib target), raylib.h needs it too
+*
 *
 *   LICENSE: zlib/libpng
 *
@@ -29,6 +33,7 @@
 *
 **********************************************************************************************/
 
+#define RL_MEMORY_TAG MEMORY_TAG_CORE
 #include "raylib.h"                     // WARNING: Required for: LogType enum
 
 // Check if config flags have been externally provided on compilation line
@@ -42,12 +47,14 @@
     #include <errno.h>                  // Required for: Android error types
     #include <android/log.h>            // Required for: Android log system: __android_log_vprint()
     #include <android/asset_manager.h>  // Required for: Android assets manager: AAsset, AAssetManager_open()...
+    #include <pthread.h>                // Required for: pthread_mutex_lock() [Used in LoadFileDataMapped()]
 #endif
 
 #include <stdlib.h>                     // Required for: exit()
 #include <stdio.h>                      // Required for: FILE, fopen(), fseek(), ftell(), fread(), fwrite(), fprintf(), vprintf(), fclose()
 #include <stdarg.h>                     // Required for: va_list, va_start(), va_end()
 #include <string.h>                     // Required for: strcpy(), strcat()
+#include <assert.h>                     // Required for: assert() [Used in MemReallocTracked(), MemFreeTracked()]
 
 //----------------------------------------------------------------------------------
 // Defines and Macros
@@ -55,6 +62,12 @@
 #ifndef MAX_TRACELOG_MSG_LENGTH
     #define MAX_TRACELOG_MSG_LENGTH     256         // Max length of one trace-log message
 #endif
+#ifndef MAX_MAPPED_FILES
+    #define MAX_MAPPED_FILES             32         // Max file data views open at once (LoadFileDataMapped())
+#endif
+
+#define MEMORY_HEADER_SIZE               16         // Bytes before a tracked block, keeps the malloc() alignment
+#define MEMORY_HEADER_MAGIC      0x524c4d54u        // Marks live tracked blocks ("RLMT")
 
 //----------------------------------------------------------------------------------
 // Global Variables Definition
@@ -66,6 +79,28 @@ static LoadFileDataCallback loadFileData = NULL;    // LoadFileData callback fun
 static SaveFileDataCallback saveFileData = NULL;    // SaveFileText callback function pointer
 static LoadFileTextCallback loadFileText = NULL;    // LoadFileText callback function pointer
 static SaveFileTextCallback saveFileText = NULL;    // SaveFileText callback function pointer
+static LoadFileDataMappedCallback loadFileDataMapped = NULL;        // LoadFileDataMapped callback function pointer
+static UnloadFileDataMappedCallback unloadFileDataMapped = NULL;    // UnloadFileDataMapped callback function pointer
+
+#if defined(SUPPORT_MEMORY_TRACKING)
+// Tracked block header, right before the pointer returned
+typedef struct MemoryHeader {
+    size_t size;                    // Bytes requested
+    unsigned int tag;               // MemoryTag the bytes are counted in
+    unsigned int magic;             // MEMORY_HEADER_MAGIC while the block is live
+} MemoryHeader;
+
+// GPU object estimate, key is (id << 2) | GpuObjectType
+typedef struct GpuObject {
+    unsigned long long key;         // 0 for an empty slot
+    long long bytes;
+} GpuObject;
+
+static MemoryStats memoryStats[MEMORY_TAG_COUNT] = { 0 };   // Updated with atomics, any thread allocates
+static GpuObject *gpuObjects = NULL;                        // Open addressing, only used from the GL thread
+static int gpuObjectCapacity = 0;                           // Power of two
+static int gpuObjectCount = 0;
+#endif
 
 //----------------------------------------------------------------------------------
 // Functions to set internal callbacks
@@ -75,8 +110,18 @@ void SetLoadFileDataCallback(LoadFileDataCallback callback) { loadFileData = cal
 void SetSaveFileDataCallback(SaveFileDataCallback callback) { saveFileData = callback; }  // Set custom file data saver
 void SetLoadFileTextCallback(LoadFileTextCallback callback) { loadFileText = callback; }  // Set custom file text loader
 void SetSaveFileTextCallback(SaveFileTextCallback callback) { saveFileText = callback; }  // Set custom file text saver
+void SetLoadFileDataMappedCallback(LoadFileDataMappedCallback callback) { loadFileDataMapped = callback; }        // Set custom file data view loader
+void SetUnloadFileDataMappedCallback(UnloadFileDataMappedCallback callback) { unloadFileDataMapped = callback; }  // Set custom file data view unloader
 
 #if defined(PLATFORM_ANDROID)
+// Android asset kept open while its buffer is in use
+typedef struct MappedAsset {
+    const unsigned char *data;      // AAsset_getBuffer() pointer
+    AAsset *asset;
+} MappedAsset;
+
+static MappedAsset mappedAssets[MAX_MAPPED_FILES] = { 0 };      // File data views from LoadFileDataMapped()
+static pthread_mutex_t mappedAssetsMutex = PTHREAD_MUTEX_INITIALIZER;
 static AAssetManager *assetManager = NULL;          // Android assets manager pointer
 static const char *internalDataPath = NULL;         // Android internal data path
 #endif
@@ -94,6 +139,10 @@ static fpos_t android_seek(void *cookie, fpos_t offset, int whence);
 static int android_close(void *cookie);
 #endif
 
+#if defined(SUPPORT_MEMORY_TRACKING)
+static void CountMemory(int tag, long long bytes, int count);   // Add to a tag and its total (negative to remove)
+#endif
+
 //----------------------------------------------------------------------------------
 // Module Functions Definition - Utilities
 //----------------------------------------------------------------------------------
@@ -161,14 +210,22 @@ void TraceLog(int logType, const char *text, ...)
 // NOTE: Initializes to zero by default
 void *MemAlloc(unsigned int size)
 {
+#if defined(SUPPORT_MEMORY_TRACKING)
+    void *ptr = MemCallocTracked(size, 1, MEMORY_TAG_GAME);
+#else
     void *ptr = RL_CALLOC(size, 1);
+#endif
     return ptr;
 }
 
 // Internal memory reallocator
 void *MemRealloc(void *ptr, unsigned int size)
 {
+#if defined(SUPPORT_MEMORY_TRACKING)
+    void *ret = MemReallocTracked(ptr, size, MEMORY_TAG_GAME);
+#else
     void *ret = RL_REALLOC(ptr, size);
+#endif
     return ret;
 }
 
@@ -178,6 +235,208 @@ void MemFree(void *ptr)
     RL_FREE(ptr);
 }
 
+// Tracked memory allocator
+// NOTE: Without SUPPORT_MEMORY_TRACKING it is plain malloc(), nothing is counted
+void *MemAllocTracked(unsigned int size, int tag)
+{
+#if defined(SUPPORT_MEMORY_TRACKING)
+    if ((tag < 0) || (tag >= MEMORY_TAG_CPU)) tag = MEMORY_TAG_GAME;
+
+    MemoryHeader *header = (MemoryHeader *)malloc(MEMORY_HEADER_SIZE + (size_t)size);
+    if (header == NULL) return NULL;
+
+    header->size = size;
+    header->tag = (unsigned int)tag;
+    header->magic = MEMORY_HEADER_MAGIC;
+    CountMemory(tag, size, 1);
+
+    return (unsigned char *)header + MEMORY_HEADER_SIZE;
+#else
+    (void)tag;
+    return malloc(size);
+#endif
+}
+
+// Tracked memory allocator, initialized to zero
+void *MemCallocTracked(unsigned int count, unsigned int size, int tag)
+{
+    if ((size != 0) && (count > 0xffffffffu/size)) return NULL;
+
+    void *ptr = MemAllocTracked(count*size, tag);
+    if (ptr != NULL) memset(ptr, 0, (size_t)count*size);
+
+    return ptr;
+}
+
+// Tracked memory reallocator
+// NOTE: 'tag' is only used when 'ptr' is NULL, a block stays counted in the tag it was allocated with
+// WARNING: 'ptr' must come from a tracked allocator, blocks of other allocators are released with their own free()
+void *MemReallocTracked(void *ptr, unsigned int size, int tag)
+{
+#if defined(SUPPORT_MEMORY_TRACKING)
+    if (ptr == NULL) return MemAllocTracked(size, tag);
+
+    MemoryHeader *header = (MemoryHeader *)((unsigned char *)ptr - MEMORY_HEADER_SIZE);
+    assert((header->magic == MEMORY_HEADER_MAGIC) && "MemReallocTracked(): block not from a tracked allocator");
+    if (header->magic != MEMORY_HEADER_MAGIC)
+    {
+        // NOTE: Allocator mismatch or block already freed, the block is left alone rather than corrupting the heap
+        TRACELOG(LOG_WARNING, "MEMORY: Reallocated block [%p] is not a live tracked block", ptr);
+        return NULL;
+    }
+
+    size_t oldSize = header->size;
+    MemoryHeader *resized = (MemoryHeader *)realloc(header, MEMORY_HEADER_SIZE + (size_t)size);
+    if (resized == NULL) return NULL;
+
+    resized->size = size;
+    CountMemory((int)resized->tag, (long long)size - (long long)oldSize, 0);
+
+    return (unsigned char *)resized + MEMORY_HEADER_SIZE;
+#else
+    (void)tag;
+    return realloc(ptr, size);
+#endif
+}
+
+// Tracked memory free
+// WARNING: 'ptr' must come from a tracked allocator, blocks of other allocators are released with their own free()
+void MemFreeTracked(void *ptr)
+{
+#if defined(SUPPORT_MEMORY_TRACKING)
+    if (ptr == NULL) return;
+
+    MemoryHeader *header = (MemoryHeader *)((unsigned char *)ptr - MEMORY_HEADER_SIZE);
+    assert((header->magic == MEMORY_HEADER_MAGIC) && "MemFreeTracked(): block not from a tracked allocator");
+    if (header->magic != MEMORY_HEADER_MAGIC)
+    {
+        // NOTE: Allocator mismatch or double free, leaked rather than corrupting the heap
+        TRACELOG(LOG_WARNING, "MEMORY: Freed block [%p] is not a live tracked block", ptr);
+        return;
+    }
+
+    header->magic = 0;
+    CountMemory((int)header->tag, -(long long)header->size, -1);
+    free(header);
+#else
+    free(ptr);
+#endif
+}
+
+// Get live and peak memory of a tag
+// NOTE: GPU bytes are estimates, see TrackGpuObject()
+MemoryStats GetMemoryStats(int tag)
+{
+    MemoryStats stats = { 0 };
+
+#if defined(SUPPORT_MEMORY_TRACKING)
+    if ((tag >= 0) && (tag < MEMORY_TAG_COUNT))
+    {
+        stats.bytes = __atomic_load_n(&memoryStats[tag].bytes, __ATOMIC_RELAXED);
+        stats.peak = __atomic_load_n(&memoryStats[tag].peak, __ATOMIC_RELAXED);
+        stats.count = __atomic_load_n(&memoryStats[tag].count, __ATOMIC_RELAXED);
+    }
+#else
+    (void)tag;
+#endif
+
+    return stats;
+}
+
+#if defined(SUPPORT_MEMORY_TRACKING)
+// Slot of a GPU object key, or the empty slot it would go in
+static int FindGpuObject(unsigned long long key)
+{
+    int mask = gpuObjectCapacity - 1;
+    int index = (int)((key*0x9e3779b97f4a7c15ull) >> 40) & mask;
+
+    while ((gpuObjects[index].key != 0) && (gpuObjects[index].key != key)) index = (index + 1) & mask;
+
+    return index;
+}
+
+// Set the estimated size of a GPU object, 0 bytes to forget it (unloaded)
+// NOTE: Called by rlgl on the GL thread, the size of a reloaded id replaces the previous one
+void TrackGpuObject(int type, unsigned int id, long long bytes)
+{
+    if (id == 0) return;
+
+    unsigned long long key = ((unsigned long long)id << 2) | (unsigned long long)(type & 3);
+    int tag = (type == GPU_OBJECT_BUFFER)? MEMORY_TAG_GPU_BUFFERS : MEMORY_TAG_GPU_TEXTURES;
+
+    // Keep the table at most half full
+    if ((bytes > 0) && (2*(gpuObjectCount + 1) > gpuObjectCapacity))
+    {
+        GpuObject *old = gpuObjects;
+        int oldCapacity = gpuObjectCapacity;
+
+        // NOTE: Plain calloc(), the bookkeeping is not counted in itself
+        GpuObject *grown = (GpuObject *)calloc((oldCapacity > 0)? 2*oldCapacity : 256, sizeof(GpuObject));
+        if (grown == NULL) return;
+
+        gpuObjects = grown;
+        gpuObjectCapacity = (oldCapacity > 0)? 2*oldCapacity : 256;
+        for (int i = 0; i < oldCapacity; i++) if (old[i].key != 0) gpuObjects[FindGpuObject(old[i].key)] = old[i];
+        free(old);
+    }
+
+    if (gpuObjectCapacity == 0) return;
+
+    int index = FindGpuObject(key);
+    GpuObject *object = &gpuObjects[index];
+
+    if (object->key != 0)
+    {
+        CountMemory(tag, ((bytes > 0)? bytes : 0) - object->bytes, (bytes > 0)? 0 : -1);
+
+        if (bytes > 0) object->bytes = bytes;
+        else
+        {
+            // Backward shift deletion: entries past the hole move back if it is on their probe path
+            int mask = gpuObjectCapacity - 1;
+            int hole = index;
+
+            for (int next = (hole + 1) & mask; gpuObjects[next].key != 0; next = (next + 1) & mask)
+            {
+                int home = (int)((gpuObjects[next].key*0x9e3779b97f4a7c15ull) >> 40) & mask;
+                if (((next - home) & mask) >= ((next - hole) & mask))
+                {
+                    gpuObjects[hole] = gpuObjects[next];
+                    hole = next;
+                }
+            }
+
+            gpuObjects[hole] = (GpuObject){ 0 };
+            gpuObjectCount--;
+        }
+    }
+    else if (bytes > 0)
+    {
+        object->key = key;
+        object->bytes = bytes;
+        gpuObjectCount++;
+        CountMemory(tag, bytes, 1);
+    }
+}
+
+// Forget every GPU object, the GL context they lived in is gone
+void ResetGpuObjects(void)
+{
+    for (int i = 0; i < gpuObjectCapacity; i++)
+    {
+        if (gpuObjects[i].key == 0) continue;
+
+        int tag = ((gpuObjects[i].key & 3) == GPU_OBJECT_BUFFER)? MEMORY_TAG_GPU_BUFFERS : MEMORY_TAG_GPU_TEXTURES;
+        CountMemory(tag, -gpuObjects[i].bytes, -1);
+    }
+
+    free(gpuObjects);
+    gpuObjects = NULL;
+    gpuObjectCapacity = 0;
+    gpuObjectCount = 0;
+}
+#endif
+
 // Load data from file into a buffer
 unsigned char *LoadFileData(const char *fileName, int *dataSize)
 {
@@ -250,6 +509,88 @@ void UnloadFileData(unsigned char *data)
     RL_FREE(data);
 }
 
+// Load file data as a read-only view
+// NOTE: On Android, assets are read through AAsset_getBuffer(): stored (uncompressed) assets are mapped
+// straight from the APK and compressed ones are inflated once, without the copy made by LoadFileData()
+// Other files, or any file when a custom loader is set, are loaded with LoadFileData()
+// A custom view loader (i.e. an asset pack) is tried first, files it doesn't handle are loaded as usual
+const unsigned char *LoadFileDataMapped(const char *fileName, int *dataSize)
+{
+    if ((loadFileDataMapped != NULL) && (fileName != NULL))
+    {
+        const unsigned char *data = loadFileDataMapped(fileName, dataSize);
+        if (data != NULL) return data;
+    }
+
+#if defined(PLATFORM_ANDROID)
+    if ((fileName != NULL) && (fileName[0] != '/') && (loadFileData == NULL))
+    {
+        *dataSize = 0;
+
+        pthread_mutex_lock(&mappedAssetsMutex);
+
+        int slot = -1;
+        for (int i = 0; i < MAX_MAPPED_FILES; i++)
+        {
+            if (mappedAssets[i].asset == NULL) { slot = i; break; }
+        }
+
+        AAsset *asset = (slot >= 0)? AAssetManager_open(assetManager, fileName, AASSET_MODE_BUFFER) : NULL;
+
+        if (asset != NULL)
+        {
+            const unsigned char *data = (const unsigned char *)AAsset_getBuffer(asset);
+            off_t length = AAsset_getLength(asset);
+
+            if ((data != NULL) && (length > 0) && (length <= 2147483647))
+            {
+                mappedAssets[slot].data = data;
+                mappedAssets[slot].asset = asset;
+                pthread_mutex_unlock(&mappedAssetsMutex);
+
+                *dataSize = (int)length;
+                TRACELOG(LOG_INFO, "FILEIO: [%s] File mapped successfully (%s)", fileName, AAsset_isAllocated(asset)? "inflated" : "stored");
+
+                return data;
+            }
+
+            AAsset_close(asset);
+        }
+        else if (slot < 0) TRACELOG(LOG_WARNING, "FILEIO: [%s] Too many mapped files open, loading a copy", fileName);
+
+        pthread_mutex_unlock(&mappedAssetsMutex);
+    }
+#endif
+
+    return LoadFileData(fileName, dataSize);
+}
+
+// Unload file data view returned by LoadFileDataMapped()
+void UnloadFileDataMapped(const unsigned char *data)
+{
+    if (data == NULL) return;
+    if ((unloadFileDataMapped != NULL) && unloadFileDataMapped(data)) return;
+
+#if defined(PLATFORM_ANDROID)
+    pthread_mutex_lock(&mappedAssetsMutex);
+
+    for (int i = 0; i < MAX_MAPPED_FILES; i++)
+    {
+        if (mappedAssets[i].data == data)
+        {
+            AAsset_close(mappedAssets[i].asset);
+            mappedAssets[i] = (MappedAsset){ 0 };
+            pthread_mutex_unlock(&mappedAssetsMutex);
+            return;
+        }
+    }
+
+    pthread_mutex_unlock(&mappedAssetsMutex);
+#endif
+
+    UnloadFileData((unsigned char *)data);
+}
+
 // Save data to file from buffer
 bool SaveFileData(const char *fileName, void *data, int dataSize)
 {
@@ -450,7 +791,14 @@ void InitAssetManager(AAssetManager *manager, const char *dataPath)
 // Ref: https://developer.android.com/ndk/reference/group/asset
 FILE *android_fopen(const char *fileName, const char *mode)
 {
-    if (mode[0] == 'w')
+    if (fileName[0] == '/')
+    {
+        // NOTE: Absolute paths (cache or external storage directories) are never in the assets
+        #undef fopen
+        return fopen(fileName, mode);
+        #define fopen(name, mode) android_fopen(name, mode)
+    }
+    else if (mode[0] == 'w')
     {
         // fopen() is mapped to android_fopen() that only grants read access to
         // assets directory through AAssetManager but we want to also be able to
@@ -508,3 +856,22 @@ static int android_close(void *cookie)
     return 0;
 }
 #endif  // PLATFORM_ANDROID
+
+#if defined(SUPPORT_MEMORY_TRACKING)
+// Add to the live bytes of a tag and its total, raising their peaks
+static void CountMemory(int tag, long long bytes, int count)
+{
+    int total = (tag >= MEMORY_TAG_GPU_TEXTURES)? MEMORY_TAG_GPU : MEMORY_TAG_CPU;
+    int tags[2] = { tag, total };
+
+    for (int i = 0; i < 2; i++)
+    {
+        MemoryStats *stats = &memoryStats[tags[i]];
+        long long live = __atomic_add_fetch(&stats->bytes, bytes, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&stats->count, count, __ATOMIC_RELAXED);
+
+        long long peak = __atomic_load_n(&stats->peak, __ATOMIC_RELAXED);
+        while ((live > peak) && !__atomic_compare_exchange_n(&stats->peak, &peak, live, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) { }
+    }
+}
+#endif
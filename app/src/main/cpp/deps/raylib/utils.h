@@ -55,7 +55,12 @@
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
-//...
+// GPU object kinds (TrackGpuObject()), matching the values rlgl uses
+typedef enum {
+    GPU_OBJECT_TEXTURE = 0,         // Texture, counted in MEMORY_TAG_GPU_TEXTURES
+    GPU_OBJECT_RENDERBUFFER,        // Renderbuffer, counted in MEMORY_TAG_GPU_TEXTURES
+    GPU_OBJECT_BUFFER               // Vertex, index or shader storage buffer, counted in MEMORY_TAG_GPU_BUFFERS
+} GpuObjectType;
 
 //----------------------------------------------------------------------------------
 // Global Variables Definition
@@ -74,6 +79,11 @@ void InitAssetManager(AAssetManager *manager, const char *dataPath);   // Initia
 FILE *android_fopen(const char *fileName, const char *mode);           // Replacement for fopen() -> Read-only!
 #endif
 
+#if defined(SUPPORT_MEMORY_TRACKING)
+void TrackGpuObject(int type, unsigned int id, long long bytes);        // Set the estimated size of a GPU object (0 to forget it)
+void ResetGpuObjects(void);                                             // Forget every GPU object (GL context lost)
+#endif
+
 #if defined(__cplusplus)
 }
 #endif
@@ -1,3 +1,4 @@
+#define RL_MEMORY_TAG MEMORY_TAG_RAYMOB
 #include "raymob.h"
 
 static Callback onStart = NULL;
@@ -34,12 +35,18 @@ JNIEXPORT void JNICALL
 custom_onAppStop(JNIEnv *env, jobject obj) {
     if(onStop) onStop();
 }
+JNIEXPORT void JNICALL
+custom_onAppTrimMemory(JNIEnv *env, jobject obj, jint level) {
+    // NOTE: UI thread, the trim callback (SetMemoryTrimCallback()) runs later on the game thread
+    RequestMemoryTrim(level);
+}
 
 static JNINativeMethod methods[] = {
         {"onAppStart", "()V", (void *)custom_onAppStart},
         {"onAppResume", "()V", (void *)custom_onAppResume},
         {"onAppPause", "()V", (void *)custom_onAppPause},
         {"onAppStop", "()V", (void *)custom_onAppStop},
+        {"onAppTrimMemory", "(I)V", (void *)custom_onAppTrimMemory},
 };
 
 void InitCallBacks(){
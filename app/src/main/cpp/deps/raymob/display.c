@@ -22,53 +22,68 @@
  *  SOFTWARE.
  */
 
+#define RL_MEMORY_TAG MEMORY_TAG_RAYMOB
 #include "raymob.h"
 
-void KeepScreenOn(bool keepOn)
+/* Static variables */
+
+static struct {
+    bool ready;
+    jobject displayManager;         // com.raylib.raymob.DisplayManager (global ref)
+    jmethodID keepScreenOn;
+    jmethodID getOrientation;
+} Jni = { 0 };
+
+/* Functions definition */
+
+void InitDisplayJNI(JNIEnv *env)
 {
+    if (Jni.ready) return;
+    Jni.ready = true;
+
     jobject nativeLoaderInst = GetNativeLoaderInstance();
+    if (nativeLoaderInst == NULL) return;
 
-    if (nativeLoaderInst != NULL) {
-        JNIEnv* env = AttachCurrentThread();
+    jclass nativeLoaderClass = (*env)->GetObjectClass(env, nativeLoaderInst);
+    jfieldID displayManagerField = (*env)->GetFieldID(env, nativeLoaderClass, "displayManager", "Lcom/raylib/raymob/DisplayManager;");
+    jobject displayManager = (*env)->GetObjectField(env, nativeLoaderInst, displayManagerField);
 
-        jclass nativeLoaderClass = (*env)->GetObjectClass(env, nativeLoaderInst);
-        jfieldID displayManagerField = (*env)->GetFieldID(env, nativeLoaderClass, "displayManager", "Lcom/raylib/raymob/DisplayManager;");
-        jobject displayManager = (*env)->GetObjectField(env, nativeLoaderInst, displayManagerField);
+    if (displayManager != NULL) {
+        jclass displayManagerClass = (*env)->GetObjectClass(env, displayManager);
+        Jni.displayManager = (*env)->NewGlobalRef(env, displayManager);
+        Jni.keepScreenOn = (*env)->GetMethodID(env, displayManagerClass, "keepScreenOn", "(Z)V");
+        Jni.getOrientation = (*env)->GetMethodID(env, displayManagerClass, "getOrientation", "()I");
+    }
+}
 
-        if (displayManager != NULL) {
-            jclass displayManagerClass = (*env)->GetObjectClass(env, displayManager);
-            jmethodID method = (*env)->GetMethodID(env, displayManagerClass, "keepScreenOn", "(Z)V");
-            (*env)->CallVoidMethod(env, displayManager, method, (jboolean)keepOn);
-        }
+void KeepScreenOn(bool keepOn)
+{
+    JNIEnv* env = AttachCurrentThread();
+    InitDisplayJNI(env);
 
-        DetachCurrentThread();
+    if (Jni.displayManager != NULL) {
+        (*env)->CallVoidMethod(env, Jni.displayManager, Jni.keepScreenOn, (jboolean)keepOn);
     }
+
+    DetachCurrentThread();
 }
 
 Orientation GetScreenOrientation()
 {
     Orientation result = 0;
-    jobject nativeLoaderInst = GetNativeLoaderInstance();
 
-    if (nativeLoaderInst != NULL) {
-        JNIEnv* env = AttachCurrentThread();
+    JNIEnv* env = AttachCurrentThread();
+    InitDisplayJNI(env);
 
-        jclass nativeLoaderClass = (*env)->GetObjectClass(env, nativeLoaderInst);
-        jfieldID displayManagerField = (*env)->GetFieldID(env, nativeLoaderClass, "displayManager", "Lcom/raylib/raymob/DisplayManager;");
-        jobject displayManager = (*env)->GetObjectField(env, nativeLoaderInst, displayManagerField);
+    if (Jni.displayManager != NULL) {
+        jint screenOrientation = (*env)->CallIntMethod(env, Jni.displayManager, Jni.getOrientation);
 
-        if (displayManager != NULL) {
-            jclass displayManagerClass = (*env)->GetObjectClass(env, displayManager);
-            jmethodID screenOrientationMethod = (*env)->GetMethodID(env, displayManagerClass, "getOrientation", "()I");
-            jint screenOrientation = (*env)->CallIntMethod(env, displayManager, screenOrientationMethod);
-
-            if (result >= 0 && result < 4) { // just sanity checking in case android API changes
-                result = screenOrientation;
-            }
+        if (screenOrientation >= 0 && screenOrientation < 4) { // just sanity checking in case android API changes
+            result = screenOrientation;
         }
-
-        DetachCurrentThread();
     }
 
+    DetachCurrentThread();
+
     return result;
 }
@@ -22,30 +22,126 @@
  *  SOFTWARE.
  */
 
+#define RL_MEMORY_TAG MEMORY_TAG_RAYMOB
 #include "raymob.h"
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Defines */
+
+#define APP_STORAGE_PATH_LENGTH 1024    // Full paths of app storage files
+#define APP_STORAGE_MAX_MAPPED    16    // Files mapped by MapFromAppStorage() at once
+#define JNI_LOCAL_FRAME_CAPACITY  16    // Local references a raymob call creates (grows when exceeded)
+
+/* Types */
+
+typedef struct {
+    const unsigned char *data;
+    size_t size;
+} MappedFile;
 
 /* Static variables */
 
 static jobject featuresInstance = NULL;
 
+static __thread JNIEnv *threadEnv = NULL;          // JNI environment of the calling thread, once attached
+static __thread bool threadAttached = false;        // Attached by AttachCurrentThread(), detached by DetachCurrentThread()
+static __thread bool threadPinned = false;          // Game thread, attached for good by InitJNICache()
+static __thread int threadFrames = 0;               // Local reference frames opened by nested AttachCurrentThread()
+
+static char *appStorageRoot = NULL;                 // App storage path, resolved on first use
+static MappedFile mappedFiles[APP_STORAGE_MAX_MAPPED] = { 0 };
+static pthread_mutex_t appStorageMutex = PTHREAD_MUTEX_INITIALIZER;
+
 /* Functions definition */
 
 JNIEnv* AttachCurrentThread(void)
 {
-    JavaVM *vm = GetAndroidApp()->activity->vm;
-    JNIEnv *env = NULL;
+    // NOTE: A thread already attached (the game thread after InitJNICache(), a Java thread) is
+    // never attached again, nested calls only open a local reference frame closed by the Detach
+    if (threadEnv == NULL)
+    {
+        JavaVM *vm = GetAndroidApp()->activity->vm;
 
-    (*vm)->AttachCurrentThread(vm, &env, NULL);
-    return env;
+        if ((*vm)->GetEnv(vm, (void **)&threadEnv, JNI_VERSION_1_6) != JNI_OK)
+        {
+            threadEnv = NULL;
+            (*vm)->AttachCurrentThread(vm, &threadEnv, NULL);
+            threadAttached = (threadEnv != NULL);
+            return threadEnv;
+        }
+    }
+
+    // Outermost call of the game thread timed as the profiler JNI phase
+    if ((threadFrames == 0) && threadPinned) BeginProfilerPhase(PROFILER_PHASE_JNI);
+
+    (*threadEnv)->PushLocalFrame(threadEnv, JNI_LOCAL_FRAME_CAPACITY);
+    threadFrames++;
+
+    return threadEnv;
 }
 
 void DetachCurrentThread(void)
 {
-    JavaVM *vm = GetAndroidApp()->activity->vm;
-    (*vm)->DetachCurrentThread(vm);
+    if (threadFrames > 0)
+    {
+        (*threadEnv)->PopLocalFrame(threadEnv, NULL);
+        if ((--threadFrames == 0) && threadPinned) EndProfilerPhase(PROFILER_PHASE_JNI);
+    }
+    else if (threadAttached)
+    {
+        JavaVM *vm = GetAndroidApp()->activity->vm;
+        (*vm)->DetachCurrentThread(vm);
+
+        threadEnv = NULL;
+        threadAttached = false;
+    }
+}
+
+// The pinned thread stays attached until it ends (android_main() returns)
+static void DetachPinnedThread(void *vm){
+    (*(JavaVM *)vm)->DetachCurrentThread((JavaVM *)vm);
+}
+
+bool InitJNICache(void)
+{
+    if (threadPinned) return true;
+
+    struct android_app *app = GetAndroidApp();
+    if ((app == NULL) || (app->activity->clazz == NULL)) return false;
+
+    double startTime = GetTime();
+
+    JavaVM *vm = app->activity->vm;
+    if (AttachCurrentThread() == NULL) return false;
+
+    if (threadAttached)
+    {
+        // Attached by this call: kept attached, detached when the thread ends
+        static pthread_key_t pinnedThreadKey;
+        if (pthread_key_create(&pinnedThreadKey, DetachPinnedThread) == 0) pthread_setspecific(pinnedThreadKey, vm);
+        threadAttached = false;
+    }
+    else DetachCurrentThread();     // Already attached, only the local frame to close
+
+    JNIEnv *env = threadEnv;
+    (*env)->PushLocalFrame(env, JNI_LOCAL_FRAME_CAPACITY);
+    InitVibratorJNI(env);
+    InitDisplayJNI(env);
+    InitSoftKeyboardJNI(env);
+    InitPowerJNI(env);
+    (*env)->PopLocalFrame(env, NULL);
+
+    threadPinned = true;
+
+    TraceLog(LOG_INFO, "JNI: Classes and methods cached in %.2f ms, game thread attached", (GetTime() - startTime)*1000.0);
+
+    return true;
 }
 
 jobject GetNativeLoaderInstance(void)
@@ -78,9 +174,7 @@ char* GetCacheDir(void)
 {
     struct android_app *app = GetAndroidApp();
 
-    JavaVM* vm = app->activity->vm;
-    JNIEnv* env = NULL;
-    (*vm)->AttachCurrentThread(vm, &env, NULL);
+    JNIEnv* env = AttachCurrentThread();
 
     // Get the activity object and its class
     jobject activity = app->activity->clazz;
@@ -125,7 +219,7 @@ char* GetCacheDir(void)
     (*env)->DeleteLocalRef(env, activityClass);
 
     // Detach the current thread from the JavaVM
-    (*vm)->DetachCurrentThread(vm);
+    DetachCurrentThread();
 
     // Return the cache path
     return cachePath;
@@ -258,68 +352,97 @@ char* GetL10NString(const char* value)
     return NULL;
 }
 
-char* GetAppStoragePath(){
-
-    jobject nativeInstance = GetNativeLoaderInstance();
+// Resolved once through JNI, the path never changes while the app runs
+static const char *GetAppStorageRoot(void){
+    pthread_mutex_lock(&appStorageMutex);
 
-    if (nativeInstance != NULL)
+    if (appStorageRoot == NULL)
     {
-        JNIEnv* env = AttachCurrentThread();
-        
-        // Get the native context class (nativeInstance)
-        jclass nativeClass = (*env)->GetObjectClass(env, nativeInstance);
+        jobject nativeInstance = GetNativeLoaderInstance();
 
-        // Get the getExternalFilesDir method ID
-        jmethodID getExternalFilesDirMethod = (*env)->GetMethodID(env, nativeClass, "getExternalFilesDir", "(Ljava/lang/String;)Ljava/io/File;");
+        if (nativeInstance != NULL)
+        {
+            JNIEnv* env = AttachCurrentThread();
 
-        // Call getExternalFilesDir(null) to get the root external files directory
-        jobject fileObj = (*env)->CallObjectMethod(env, nativeInstance, getExternalFilesDirMethod, NULL);
+            // Get the native context class (nativeInstance)
+            jclass nativeClass = (*env)->GetObjectClass(env, nativeInstance);
 
-        // Get the java.io.File class
-        jclass fileClass = (*env)->GetObjectClass(env, fileObj);
+            // Get the getExternalFilesDir method ID
+            jmethodID getExternalFilesDirMethod = (*env)->GetMethodID(env, nativeClass, "getExternalFilesDir", "(Ljava/lang/String;)Ljava/io/File;");
 
-        // Get the getAbsolutePath() method ID
-        jmethodID getAbsolutePathMethod = (*env)->GetMethodID(env, fileClass, "getAbsolutePath", "()Ljava/lang/String;");
+            // Call getExternalFilesDir(null) to get the root external files directory
+            jobject fileObj = (*env)->CallObjectMethod(env, nativeInstance, getExternalFilesDirMethod, NULL);
 
-        // Call getAbsolutePath() to get the Java string
-        jstring jFilePath = (jstring)(*env)->CallObjectMethod(env, fileObj, getAbsolutePathMethod);
+            // Get the java.io.File class
+            jclass fileClass = (*env)->GetObjectClass(env, fileObj);
 
-        // Convert Java string to C string
-        const char *cFilePath = (*env)->GetStringUTFChars(env, jFilePath, NULL);
+            // Get the getAbsolutePath() method ID
+            jmethodID getAbsolutePathMethod = (*env)->GetMethodID(env, fileClass, "getAbsolutePath", "()Ljava/lang/String;");
 
-        char *filepath = strdup(cFilePath);
+            // Call getAbsolutePath() to get the Java string
+            jstring jFilePath = (jstring)(*env)->CallObjectMethod(env, fileObj, getAbsolutePathMethod);
 
-        (*env)->ReleaseStringUTFChars(env, jFilePath, cFilePath);
-        (*env)->DeleteLocalRef(env, jFilePath);
-        (*env)->DeleteLocalRef(env, fileClass);
-        (*env)->DeleteLocalRef(env, fileObj);
-        (*env)->DeleteLocalRef(env, nativeClass);
-        
-        DetachCurrentThread();
+            // Convert Java string to C string
+            const char *cFilePath = (*env)->GetStringUTFChars(env, jFilePath, NULL);
+
+            appStorageRoot = strdup(cFilePath);
+
+            (*env)->ReleaseStringUTFChars(env, jFilePath, cFilePath);
+            (*env)->DeleteLocalRef(env, jFilePath);
+            (*env)->DeleteLocalRef(env, fileClass);
+            (*env)->DeleteLocalRef(env, fileObj);
+            (*env)->DeleteLocalRef(env, nativeClass);
 
-        return filepath;
+            DetachCurrentThread();
+        }
     }
 
-    return NULL;
+    pthread_mutex_unlock(&appStorageMutex);
+
+    return appStorageRoot;
 }
 
-void* ReadFromAppStorage(const char *filepath, int *dataSize){
+// Full path of a file in app specific storage, false if it doesn't fit in 'path'
+static bool GetAppStorageFilePath(const char *filepath, char *path, size_t size){
+    const char *root = GetAppStorageRoot();
+    if (root == NULL) return false;
+
+    int length = snprintf(path, size, "%s/%s", root, filepath);
+    if ((length < 0) || ((size_t)length >= size))
+    {
+        TraceLog(LOG_WARNING, "FILEIO: [%s] App storage file path too long", filepath);
+        return false;
+    }
+
+    return true;
+}
+
+char* GetAppStoragePath(){
+    const char *root = GetAppStorageRoot();
+
+    if (root == NULL) return NULL;
+
+    // NOTE: Freed with RL_FREE() like every other raymob string
+    size_t size = strlen(root) + 1;
+    char *path = RL_MALLOC(size);
+    if (path != NULL) memcpy(path, root, size);
 
-    char *appStoragePath = GetAppStoragePath();
+    return path;
+}
+
+void* ReadFromAppStorage(const char *filepath, int *dataSize){
 
-    size_t pathLen = strlen(appStoragePath) + strlen(filepath) + 2;
-    char *path = RL_MALLOC(sizeof(char)*pathLen);
-    snprintf(path, pathLen, "%s/%s", appStoragePath, filepath);
+    char path[APP_STORAGE_PATH_LENGTH];
 
     unsigned char *data = NULL;
     *dataSize = 0;
 
+    if (!GetAppStorageFilePath(filepath, path, sizeof(path))) return NULL;
+
     FILE *file = fopen(path, "rb");
 
     if (file == NULL){
         TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to open file", path);
-        RL_FREE(appStoragePath);
-        RL_FREE(path);
         return NULL;
     }
 
@@ -361,19 +484,99 @@ void* ReadFromAppStorage(const char *filepath, int *dataSize){
 
     fclose(file);
 
-    RL_FREE(appStoragePath);
-    RL_FREE(path);
-
     return data;
 }
 
-bool WriteToAppStorage(const char *filepath, void *data, unsigned int dataSize){
+FILE* OpenFromAppStorage(const char *filepath){
+
+    char path[APP_STORAGE_PATH_LENGTH];
+    if (!GetAppStorageFilePath(filepath, path, sizeof(path))) return NULL;
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to open file", path);
+
+    return file;
+}
+
+const unsigned char* MapFromAppStorage(const char *filepath, int *dataSize){
+
+    char path[APP_STORAGE_PATH_LENGTH];
+    *dataSize = 0;
+
+    if (!GetAppStorageFilePath(filepath, path, sizeof(path))) return NULL;
 
-    char *appStoragePath = GetAppStoragePath();
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to open file", path);
+        return NULL;
+    }
+
+    struct stat info = { 0 };
+    void *data = MAP_FAILED;
+
+    // NOTE: Empty files can't be mapped, bigger than INT_MAX can't be sized
+    if ((fstat(fd, &info) == 0) && (info.st_size > 0) && (info.st_size <= 2147483647))
+    {
+        data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);     // NOTE: The mapping stays valid after the descriptor is closed
 
-    size_t pathLen = strlen(appStoragePath) + strlen(filepath) + 2;
-    char *path = RL_MALLOC(sizeof(char)*pathLen);
-    snprintf(path, pathLen, "%s/%s", appStoragePath, filepath);
+    if (data == MAP_FAILED)
+    {
+        TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to map file", path);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&appStorageMutex);
+
+    int slot = -1;
+    for (int i = 0; i < APP_STORAGE_MAX_MAPPED; i++)
+    {
+        if (mappedFiles[i].data == NULL) { slot = i; break; }
+    }
+    if (slot >= 0) mappedFiles[slot] = (MappedFile){ (const unsigned char *)data, (size_t)info.st_size };
+
+    pthread_mutex_unlock(&appStorageMutex);
+
+    if (slot < 0)
+    {
+        TraceLog(LOG_WARNING, "FILEIO: [%s] Too many mapped files open", path);
+        munmap(data, (size_t)info.st_size);
+        return NULL;
+    }
+
+    *dataSize = (int)info.st_size;
+    TraceLog(LOG_INFO, "FILEIO: [%s] File mapped successfully", path);
+
+    return (const unsigned char *)data;
+}
+
+void UnmapFromAppStorage(const unsigned char *data){
+
+    if (data == NULL) return;
+
+    size_t size = 0;
+
+    pthread_mutex_lock(&appStorageMutex);
+    for (int i = 0; i < APP_STORAGE_MAX_MAPPED; i++)
+    {
+        if (mappedFiles[i].data == data)
+        {
+            size = mappedFiles[i].size;
+            mappedFiles[i] = (MappedFile){ 0 };
+            break;
+        }
+    }
+    pthread_mutex_unlock(&appStorageMutex);
+
+    if (size > 0) munmap((void *)data, size);
+}
+
+bool WriteToAppStorage(const char *filepath, void *data, unsigned int dataSize){
+
+    char path[APP_STORAGE_PATH_LENGTH];
+    if (!GetAppStorageFilePath(filepath, path, sizeof(path))) return false;
 
     bool success = false;
 
@@ -394,38 +597,19 @@ bool WriteToAppStorage(const char *filepath, void *data, unsigned int dataSize){
     }
     else TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to open file", path);
 
-    RL_FREE(appStoragePath);
-    RL_FREE(path);
-
     return success;
 }
 
 bool IsFileExistsInAppStorage(const char *filepath){
 
-    char *appStoragePath = GetAppStoragePath();
+    char path[APP_STORAGE_PATH_LENGTH];
+    if (!GetAppStorageFilePath(filepath, path, sizeof(path))) return false;
 
-    size_t pathLen = strlen(appStoragePath) + strlen(filepath) + 2;
-    char *path = RL_MALLOC(sizeof(char)*pathLen);
-    snprintf(path, pathLen, "%s/%s", appStoragePath, filepath);
-
-    bool success = (access(path, F_OK) != -1);
-
-    RL_FREE(appStoragePath);
-    RL_FREE(path);
-
-    return success;
+    return (access(path, F_OK) != -1);
 }
 
 void RemoveFileInAppStorage(const char *filepath){
 
-    char *appStoragePath = GetAppStoragePath();
-
-    size_t pathLen = strlen(appStoragePath) + strlen(filepath) + 2;
-    char *path = RL_MALLOC(sizeof(char)*pathLen);
-    snprintf(path, pathLen, "%s/%s", appStoragePath, filepath);
-
-    remove(path);
-
-    RL_FREE(appStoragePath);
-    RL_FREE(path);
+    char path[APP_STORAGE_PATH_LENGTH];
+    if (GetAppStorageFilePath(filepath, path, sizeof(path))) remove(path);
 }
@@ -0,0 +1,143 @@
+/*
+ *  raymob License (MIT)
+ *
+ *  Copyright (c) 2023-2024 Le Juez Victor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#define RL_MEMORY_TAG MEMORY_TAG_RAYMOB
+#include "raymob.h"
+
+#include <dlfcn.h>
+#include <math.h>
+
+/* Defines */
+
+#define THERMAL_HEADROOM_INTERVAL   1.0     // Seconds between two headroom reads, the system answers NaN to faster calls
+
+/* Static variables */
+
+// NOTE: The thermal manager is API 30 (headroom API 31), looked up at runtime like the sensor batching
+typedef struct AThermalManager AThermalManager;
+typedef AThermalManager *(*AcquireThermalManagerFunc)(void);
+typedef int (*GetThermalStatusFunc)(AThermalManager *manager);
+typedef float (*GetThermalHeadroomFunc)(AThermalManager *manager, int forecastSeconds);
+
+static struct {
+    bool ready;
+    AThermalManager *manager;       // NULL before API 30
+    GetThermalStatusFunc getStatus;
+    GetThermalHeadroomFunc getHeadroom;     // NULL before API 31
+    float headroom;                 // Last headroom read, returned until the next read is allowed
+    int headroomForecast;
+    double headroomTime;
+} Thermal = { 0 };
+
+static struct {
+    bool ready;
+    jobject powerManager;           // android.os.PowerManager (global ref)
+    jmethodID isPowerSaveMode;
+} Jni = { 0 };
+
+/* Static functions */
+
+static void InitThermalManager(void)
+{
+    if (Thermal.ready) return;
+    Thermal.ready = true;
+    Thermal.headroom = -1.0f;
+
+    AcquireThermalManagerFunc acquireManager = (AcquireThermalManagerFunc)dlsym(RTLD_DEFAULT, "AThermal_acquireManager");
+    Thermal.getStatus = (GetThermalStatusFunc)dlsym(RTLD_DEFAULT, "AThermal_getCurrentThermalStatus");
+    if ((acquireManager == NULL) || (Thermal.getStatus == NULL)) {
+        TraceLog(LOG_INFO, "POWER: Thermal status not available (API 30), thermal state unknown");
+        return;
+    }
+
+    // NOTE: Kept for the process lifetime, the manager is a handle on a system service
+    Thermal.manager = acquireManager();
+    Thermal.getHeadroom = (GetThermalHeadroomFunc)dlsym(RTLD_DEFAULT, "AThermal_getThermalHeadroom");
+}
+
+/* Functions definition */
+
+void InitPowerJNI(JNIEnv *env)
+{
+    if (Jni.ready) return;
+    Jni.ready = true;
+
+    jobject nativeLoaderInst = GetNativeLoaderInstance();
+    if (nativeLoaderInst == NULL) return;
+
+    jclass nativeLoaderClass = (*env)->GetObjectClass(env, nativeLoaderInst);
+    jmethodID getSystemServiceMethod = (*env)->GetMethodID(env, nativeLoaderClass, "getSystemService", "(Ljava/lang/String;)Ljava/lang/Object;");
+
+    jstring powerService = (*env)->NewStringUTF(env, "power");
+    jobject powerManager = (*env)->CallObjectMethod(env, nativeLoaderInst, getSystemServiceMethod, powerService);
+    if (powerManager == NULL) return;
+
+    jclass powerManagerClass = (*env)->GetObjectClass(env, powerManager);
+    Jni.powerManager = (*env)->NewGlobalRef(env, powerManager);
+    Jni.isPowerSaveMode = (*env)->GetMethodID(env, powerManagerClass, "isPowerSaveMode", "()Z");
+}
+
+ThermalStatus GetThermalStatus(void)
+{
+    InitThermalManager();
+    if (Thermal.manager == NULL) return THERMAL_STATUS_UNKNOWN;
+
+    int status = Thermal.getStatus(Thermal.manager);
+
+    return ((status >= THERMAL_STATUS_NONE) && (status <= THERMAL_STATUS_SHUTDOWN))? (ThermalStatus)status : THERMAL_STATUS_UNKNOWN;
+}
+
+float GetThermalHeadroom(int forecastSeconds)
+{
+    InitThermalManager();
+    if ((Thermal.manager == NULL) || (Thermal.getHeadroom == NULL)) return -1.0f;
+
+    // NOTE: Read at most once a second (per forecast), in between the last value is returned
+    double time = GetTime();
+    if ((Thermal.headroomTime > 0.0) && (forecastSeconds == Thermal.headroomForecast) &&
+        (time - Thermal.headroomTime < THERMAL_HEADROOM_INTERVAL)) return Thermal.headroom;
+
+    float headroom = Thermal.getHeadroom(Thermal.manager, forecastSeconds);
+    Thermal.headroom = isnan(headroom)? -1.0f : headroom;
+    Thermal.headroomForecast = forecastSeconds;
+    Thermal.headroomTime = time;
+
+    return Thermal.headroom;
+}
+
+bool IsPowerSaveMode(void)
+{
+    bool result = false;
+
+    JNIEnv* env = AttachCurrentThread();
+    InitPowerJNI(env);
+
+    if (Jni.powerManager != NULL) {
+        result = (*env)->CallBooleanMethod(env, Jni.powerManager, Jni.isPowerSaveMode);
+    }
+
+    DetachCurrentThread();
+
+    return result;
+}
@@ -28,6 +28,7 @@
 #include "android_native_app_glue.h"
 #include "raylib.h"
 #include "jni.h"
+#include <stdio.h>
 
 /* ENUMS */
 
@@ -44,6 +45,35 @@ typedef enum {
     ORIENTATION_OTHER              = -1,
 } Orientation;
 
+// Thermal status, same values as the NDK AThermalStatus
+typedef enum {
+    THERMAL_STATUS_UNKNOWN   = -1,      // No thermal API (before API 30) or no status from the device
+    THERMAL_STATUS_NONE      = 0,
+    THERMAL_STATUS_LIGHT     = 1,       // Light throttling, user experience not impacted
+    THERMAL_STATUS_MODERATE  = 2,       // Moderate throttling, user experience not largely impacted
+    THERMAL_STATUS_SEVERE    = 3,       // Severe throttling, user experience largely impacted
+    THERMAL_STATUS_CRITICAL  = 4,       // Platform has done everything to reduce power
+    THERMAL_STATUS_EMERGENCY = 5,       // Key components shutting down
+    THERMAL_STATUS_SHUTDOWN  = 6,       // Device shutting down right away
+} ThermalStatus;
+
+// Video encoder codec
+typedef enum {
+    VIDEO_CODEC_H264 = 0,               // video/avc, on every device
+    VIDEO_CODEC_HEVC = 1,               // video/hevc, H.264 is used on devices without an HEVC encoder
+} VideoCodec;
+
+/* STRUCTS */
+
+// Sensor sample, as read from the sensor event queue
+typedef struct {
+    Sensor sensor;
+    Vector3 value;                  // Accelerometer (m/s^2) or gyroscope (rad/s) axes
+    int64_t timestamp;              // Event time in nanoseconds (SystemClock.elapsedRealtimeNanos() clock)
+} SensorSample;
+
+// Hardware video encoder writing an MP4 file (see LoadVideoEncoder())
+typedef struct VideoEncoder VideoEncoder;
 
 /* Callback define */
 
@@ -65,21 +95,61 @@ extern "C" {
  */
 struct android_app *GetAndroidApp(void);
 
+/**
+ * @brief Retrieves the looper of the raylib input thread.
+ *
+ * This function is defined in 'raylib/platforms/rcore_android.c', like GetAndroidApp().
+ * Sensor event queues created on it are drained off the game thread, as samples arrive.
+ *
+ * @return The input thread looper, NULL when input is polled by the game thread.
+ */
+ALooper *GetAndroidInputLooper(void);
+
 
 /* Helper functions */
 
 /**
  * @brief Attaches the current native thread to the Java VM environment.
  *
+ * A thread already attached (the game thread after InitJNICache(), Java threads,
+ * nested calls) is not attached again: a local reference frame is opened instead,
+ * so local references made until DetachCurrentThread() are released all the same.
+ *
  * @return Pointer to the JNIEnv structure.
  */
 JNIEnv* AttachCurrentThread(void);
 
 /**
  * @brief Detaches the current native thread from the Java VM environment.
+ *
+ * Only detaches a thread attached by the matching AttachCurrentThread(), else
+ * closes its local reference frame.
  */
 void DetachCurrentThread(void);
 
+/**
+ * @brief Resolves the Java objects and method IDs used by raymob, once.
+ *
+ * Call it from the game thread, at startup: the thread stays attached to
+ * the Java VM until it ends, and every raymob call only costs the Java method
+ * itself (timed as PROFILER_PHASE_JNI). Without it, each module resolves its
+ * IDs on first use and every call attaches and detaches the thread.
+ *
+ * @return true when the game thread is attached and the IDs resolved.
+ */
+bool InitJNICache(void);
+
+/**
+ * @brief Resolve the Java objects and method IDs of one module (done by InitJNICache()
+ * or on the first call of the module).
+ *
+ * @param env JNI environment of the calling thread.
+ */
+void InitVibratorJNI(JNIEnv *env);
+void InitDisplayJNI(JNIEnv *env);
+void InitSoftKeyboardJNI(JNIEnv *env);
+void InitPowerJNI(JNIEnv *env);
+
 /**
  * @brief Returns a pointer to the class that initiated the native activity.
  *
@@ -192,6 +262,52 @@ Vector3 GetAccelerotmerAxis(void);
  */
 Vector3 GetGyroscopeAxis(void);
 
+/**
+ * @brief Sets the sampling rate and hardware batching latency of a sensor.
+ *
+ * With a batching latency the sensor hub keeps samples in its FIFO and wakes the
+ * app processor less often, samples arrive in bursts with their own timestamps.
+ * Batching needs API 26, older devices only get the rate.
+ *
+ * @param sensor The sensor to configure, applied right away when enabled.
+ * @param rate Samples per second, 0 for the fastest rate (the default).
+ * @param maxLatency Longest delay in milliseconds before samples are delivered, 0 for none.
+ */
+void SetSensorRate(Sensor sensor, int rate, int maxLatency);
+
+/**
+ * @brief Retrieves every sensor sample received since the last call, oldest first.
+ *
+ * Samples are buffered from the sensor queue as they arrive (up to 512 between two
+ * reads), call it once a frame to get all of them instead of the last value only.
+ * The sensor queue is polled by the raylib input thread when there is one.
+ *
+ * @param samples Array to fill.
+ * @param maxSamples Size of the array, samples left over are returned on the next call.
+ *
+ * @return The number of samples written.
+ */
+int GetSensorSamples(SensorSample *samples, int maxSamples);
+
+/**
+ * @brief Retrieves the device tilt, accelerometer and gyroscope samples fused by a complementary filter.
+ *
+ * Every sample buffered goes through the filter, in order and with its timestamp, so the
+ * result doesn't depend on the frame rate. Works with the accelerometer alone (smoothed
+ * only), the gyroscope makes it responsive without the accelerometer jitter.
+ *
+ * @return Rotation around the device x axis (pitch) and y axis (roll) in radians, 0 when lying flat.
+ */
+Vector2 GetDeviceTilt(void);
+
+/**
+ * @brief Sets the complementary filter time constant of GetDeviceTilt().
+ *
+ * @param timeConstant Seconds the accelerometer takes to correct the gyroscope (0.5 by default),
+ * shorter follows the accelerometer closer, longer trusts the gyroscope more.
+ */
+void SetDeviceTiltFilter(float timeConstant);
+
 
 /* Soft Keyboard functions */
 
@@ -253,6 +369,91 @@ void SoftKeyboardEditText(char* text, unsigned int size);
  */
 void KeepScreenOn(bool keepOn);
 
+/* Power functions */
+
+/**
+ * @brief Retrieves the current thermal status of the device.
+ *
+ * The thermal manager is API 30, older devices always report THERMAL_STATUS_UNKNOWN.
+ *
+ * @return The thermal status, THERMAL_STATUS_UNKNOWN when not available.
+ */
+ThermalStatus GetThermalStatus(void);
+
+/**
+ * @brief Retrieves the forecast thermal headroom of the device.
+ *
+ * 1.0 is the point where severe throttling starts (THERMAL_STATUS_SEVERE), 0.0 is no
+ * load at all. The headroom needs API 31, and is read from the system at most once a
+ * second: calls in between return the last value read.
+ *
+ * @param forecastSeconds Seconds ahead to forecast (0 for the current headroom, at most 60).
+ *
+ * @return The headroom, negative when not available.
+ */
+float GetThermalHeadroom(int forecastSeconds);
+
+/**
+ * @brief Checks whether the battery saver (power save mode) is on.
+ *
+ * @return true when the device is in power save mode.
+ */
+bool IsPowerSaveMode(void);
+
+/* Video encoder functions */
+
+/**
+ * @brief Starts a hardware encoder (MediaCodec) writing an MP4 file in app specific storage.
+ *
+ * Frames are drawn with raylib straight into the encoder input surface, between
+ * BeginVideoFrame() and EndVideoFrame(): nothing is read back, the GPU renders into
+ * the buffers the encoder compresses. Call it with the raylib GL context current
+ * (the game thread). Encoder input surfaces need API 26, older devices get NULL.
+ *
+ * @param filepath Path of the file relative to app specific storage, replaced if it exists.
+ * @param width Video width in pixels (even).
+ * @param height Video height in pixels (even).
+ * @param frameRate Frames per second, frame timestamps are frame/frameRate (not the time they are drawn at).
+ * @param bitRate Target bit rate in bits per second.
+ * @param codec Codec to encode with.
+ *
+ * @return The encoder (release it with UnloadVideoEncoder()), or NULL on failure.
+ */
+VideoEncoder *LoadVideoEncoder(const char *filepath, int width, int height, int frameRate, int bitRate, VideoCodec codec);
+
+/**
+ * @brief Starts drawing the next video frame, into the encoder input surface.
+ *
+ * Like BeginTextureMode() with a width x height target: everything drawn until
+ * EndVideoFrame() goes into the video. Call it outside of BeginDrawing()/EndDrawing().
+ *
+ * @param encoder The encoder.
+ *
+ * @return false if the encoder failed (nothing must be drawn, nor EndVideoFrame() called).
+ */
+bool BeginVideoFrame(VideoEncoder *encoder);
+
+/**
+ * @brief Submits the video frame to the encoder, the screen is drawn to again.
+ *
+ * Waits when the encoder has no input buffer free, so frames are made as fast as
+ * the encoder takes them. Encoded frames are written to the file as they come out.
+ *
+ * @param encoder The encoder.
+ */
+void EndVideoFrame(VideoEncoder *encoder);
+
+/**
+ * @brief Ends the video, writes the frames still being encoded and closes the file.
+ *
+ * An encoder that failed, or got no frame, removes its file.
+ *
+ * @param encoder The encoder (may be NULL).
+ *
+ * @return true if the file is a complete video.
+ */
+bool UnloadVideoEncoder(VideoEncoder *encoder);
+
 /* Callback functions */
 
 /**
@@ -291,9 +492,12 @@ void SetOnStopCallBack(Callback callback);
 /**
  * @brief Get the app specific storage root path.
  *
+ * The path is asked through JNI on the first call of any app storage function
+ * and cached, later calls only build file paths on the stack.
+ *
  * @warning This function returns a string allocated on the heap.
  * The responsibility for releasing the memory lies with the user.
- * Use free().
+ * Use MemFree().
  *
  * @return app specific storage path.
  */
@@ -309,6 +513,39 @@ char* GetAppStoragePath();
  */
 void* ReadFromAppStorage(const char *filepath, int *size);
 
+/**
+ * @brief Open file in app specific storage for streaming reads.
+ *
+ * Large files (replays, logs) are read in chunks with fread() instead of loaded whole.
+ *
+ * @param filepath Path of the file relative to app specific storage.
+ *
+ * @return the file opened in binary read mode (close it with fclose()), or NULL.
+ */
+FILE* OpenFromAppStorage(const char *filepath);
+
+/**
+ * @brief Map file in app specific storage in memory, read-only.
+ *
+ * Pages are read on first access and no copy is made, so looking up a few records
+ * of a big file costs only those pages. Data written by WriteToAppStorageAsync()
+ * is seen once it is flushed; a file replaced later keeps its old mapped content.
+ *
+ * @param filepath Path of the file relative to app specific storage.
+ * @param size Variable to store size of data mapped.
+ *
+ * @return the mapped data (release it with UnmapFromAppStorage()), or NULL for a
+ * missing or empty file.
+ */
+const unsigned char* MapFromAppStorage(const char *filepath, int *size);
+
+/**
+ * @brief Unmap data returned by MapFromAppStorage().
+ *
+ * @param data Pointer returned by MapFromAppStorage().
+ */
+void UnmapFromAppStorage(const unsigned char *data);
+
 /**
  * @brief Write file in app specific storage.
  *
@@ -336,6 +573,41 @@ bool IsFileExistsInAppStorage(const char *filepath);
  */
 void RemoveFileInAppStorage(const char *filepath);
 
+/**
+ * @brief Start the background writer of WriteToAppStorageAsync().
+ *
+ * The app storage path is resolved once here, the writer thread never calls JNI.
+ *
+ * @return true if the writer thread is running (saves are written right away otherwise).
+ */
+bool InitAppStorageWriter();
+
+/**
+ * @brief Write file in app specific storage, in background.
+ *
+ * The data is copied and written later by the writer thread, with other saves made meanwhile.
+ * A newer write to the same file replaces a pending one. Files are written atomically: to a
+ * temporary file, synced, then renamed over the old one, so a crash keeps the old or the new file,
+ * never a partial one. ReadFromAppStorage() sees the new data once it is flushed.
+ *
+ * @param filepath Path of the file relative to app specific storage.
+ * @param data Pointer to the data.
+ * @param size Size of the data.
+ *
+ * @return true if the write was queued (or written, without the writer thread).
+ */
+bool WriteToAppStorageAsync(const char *filepath, const void *data, unsigned int size);
+
+/**
+ * @brief Wait until every queued write is on disk, e.g. from SetOnPauseCallBack().
+ */
+void FlushAppStorage();
+
+/**
+ * @brief Write what is left and stop the writer thread.
+ */
+void CloseAppStorageWriter();
+
 #if defined(__cplusplus)
 }
 #endif
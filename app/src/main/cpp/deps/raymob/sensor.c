@@ -22,17 +22,26 @@
  *  SOFTWARE.
  */
 
+#define RL_MEMORY_TAG MEMORY_TAG_RAYMOB
 #include "raymob.h"
 
 #include <android/sensor.h>
+#include <dlfcn.h>
+#include <math.h>
 #include <stdlib.h>
+#include <string.h>
+
+/* DEFINES */
+
+#define SENSOR_BUFFER_SIZE      512         // Samples kept between two reads, power of two
+#define SENSOR_EVENTS_PER_READ   32         // Events read from the queue at once (hardware batches come in bursts)
+#define SENSOR_MAX_TILT_GAP     0.1f        // Longer between two samples (seconds): tilt set again from the accelerometer
+#define SENSOR_TILT_TIME        0.5f        // Default complementary filter time constant (seconds)
 
 /* GLOBAL VARIABLES */
 
-struct SensorInputs {
-    Vector3 accelerometerAxis;
-    Vector3 gyroscopeAxis;
-};
+// NOTE: ASensorEventQueue_registerSensor() (rate and batching latency at once) is API 26, looked up at runtime
+typedef int (*RegisterSensorFunc)(ASensorEventQueue *queue, const ASensor *sensor, int32_t samplingPeriodUs, int64_t maxBatchReportLatencyUs);
 
 static struct {
 
@@ -41,7 +50,28 @@ static struct {
     const ASensor *sensors[2];
     int looperID;
 
-    struct SensorInputs inputs;
+    // Samples ring buffer, single producer (SensorCallback() on the looper thread), single consumer (game thread)
+    SensorSample buffer[SENSOR_BUFFER_SIZE];
+    unsigned int head;                      // Next sample written, only moved by the producer
+    unsigned int tail;                      // Next sample read, only moved by the consumer
+    unsigned int dropped;                   // Samples lost to a full buffer (producer side)
+
+    int rate[2];                            // Sampling rate (Hz), 0 for the sensor default
+    int latency[2];                         // Hardware batching latency (milliseconds)
+    bool enabled[2];
+    RegisterSensorFunc registerSensor;      // NULL before API 26
+
+    // Consumer side: samples read from the ring buffer, not returned by GetSensorSamples() yet
+    SensorSample pending[SENSOR_BUFFER_SIZE];
+    int pendingCount;
+    Vector3 latest[2];                      // Last value read of each sensor
+
+    // Complementary filter, fed with every sample read
+    Vector2 tilt;                           // Rotation around the device x (pitch) and y (roll) axes, radians
+    float tiltTime;                         // Filter time constant (seconds)
+    int64_t lastAccelerometer;              // Timestamps of the last samples filtered (nanoseconds)
+    int64_t lastGyroscope;
+    bool tiltReady;
 
 } State = { 0 };
 
@@ -58,33 +88,133 @@ static const char* GetSensorName(Sensor sensor)
     return sensorName;
 }
 
+static void PushSensorSample(Sensor sensor, Vector3 value, int64_t timestamp)
+{
+    unsigned int head = State.head;
+    unsigned int tail = __atomic_load_n(&State.tail, __ATOMIC_ACQUIRE);
+
+    // NOTE: A full buffer keeps its older samples, the consumer reads them in order
+    if (head - tail >= SENSOR_BUFFER_SIZE) {
+        __atomic_fetch_add(&State.dropped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    State.buffer[head & (SENSOR_BUFFER_SIZE - 1)] = (SensorSample){ sensor, value, timestamp };
+    __atomic_store_n(&State.head, head + 1, __ATOMIC_RELEASE);
+}
+
 static int SensorCallback(int fd, int events, void* data)
 {
-    ASensorEvent event;
-    while (ASensorEventQueue_getEvents(State.eventQueue, &event, 1) > 0) {
-        switch (event.type) {
-            case ASENSOR_TYPE_ACCELEROMETER:
-                State.inputs.accelerometerAxis.x = event.acceleration.x;
-                State.inputs.accelerometerAxis.y = event.acceleration.y;
-                State.inputs.accelerometerAxis.z = event.acceleration.z;
-                break;
-            case ASENSOR_TYPE_GYROSCOPE:
-                State.inputs.gyroscopeAxis.x = event.gyro.x;
-                State.inputs.gyroscopeAxis.y = event.gyro.y;
-                State.inputs.gyroscopeAxis.z = event.gyro.z;
-                break;
-            default:
-                break;
+    ASensorEvent batch[SENSOR_EVENTS_PER_READ];
+    ssize_t count = 0;
+
+    while ((count = ASensorEventQueue_getEvents(State.eventQueue, batch, SENSOR_EVENTS_PER_READ)) > 0) {
+        for (ssize_t i = 0; i < count; i++) {
+            const ASensorEvent *event = &batch[i];
+            switch (event->type) {
+                case ASENSOR_TYPE_ACCELEROMETER:
+                    PushSensorSample(SENSOR_ACCELEROMETER, (Vector3){ event->acceleration.x, event->acceleration.y, event->acceleration.z }, event->timestamp);
+                    break;
+                case ASENSOR_TYPE_GYROSCOPE:
+                    PushSensorSample(SENSOR_GYROSCOPE, (Vector3){ event->gyro.x, event->gyro.y, event->gyro.z }, event->timestamp);
+                    break;
+                default:
+                    break;
+            }
         }
     }
     return 1;
 }
 
+static float WrapAngle(float angle)
+{
+    while (angle > PI) angle -= 2*PI;
+    while (angle < -PI) angle += 2*PI;
+    return angle;
+}
+
+// Gyroscope rates integrated between samples, pulled toward the gravity direction of the accelerometer:
+// the gyroscope is smooth but drifts, the accelerometer doesn't drift but shakes with every movement
+static void FilterTilt(const SensorSample *sample)
+{
+    if (sample->sensor == SENSOR_ACCELEROMETER) {
+        Vector3 a = sample->value;
+        Vector2 gravityTilt = { atan2f(a.y, a.z), atan2f(-a.x, sqrtf(a.y*a.y + a.z*a.z)) };
+
+        float dt = (float)((sample->timestamp - State.lastAccelerometer)*1e-9);
+        State.lastAccelerometer = sample->timestamp;
+
+        if (!State.tiltReady || dt <= 0.0f || dt > SENSOR_MAX_TILT_GAP) {
+            State.tilt = gravityTilt;
+            State.tiltReady = true;
+            return;
+        }
+
+        float k = dt/(State.tiltTime + dt);
+        State.tilt.x = WrapAngle(State.tilt.x + k*WrapAngle(gravityTilt.x - State.tilt.x));
+        State.tilt.y = WrapAngle(State.tilt.y + k*WrapAngle(gravityTilt.y - State.tilt.y));
+    }
+    else if (sample->sensor == SENSOR_GYROSCOPE) {
+        float dt = (float)((sample->timestamp - State.lastGyroscope)*1e-9);
+        State.lastGyroscope = sample->timestamp;
+
+        if (State.tiltReady && dt > 0.0f && dt <= SENSOR_MAX_TILT_GAP) {
+            State.tilt.x = WrapAngle(State.tilt.x + sample->value.x*dt);
+            State.tilt.y = WrapAngle(State.tilt.y + sample->value.y*dt);
+        }
+    }
+}
+
+// Samples moved from the ring buffer to the consumer side, through the tilt filter
+static void ReadSensorSamples(void)
+{
+    unsigned int tail = State.tail;
+    unsigned int head = __atomic_load_n(&State.head, __ATOMIC_ACQUIRE);
+
+    for (; tail != head; tail++) {
+        const SensorSample *sample = &State.buffer[tail & (SENSOR_BUFFER_SIZE - 1)];
+        FilterTilt(sample);
+        State.latest[sample->sensor] = sample->value;
+
+        // NOTE: Samples never asked for only keep the newest ones
+        if (State.pendingCount == SENSOR_BUFFER_SIZE) {
+            memmove(State.pending, State.pending + 1, (SENSOR_BUFFER_SIZE - 1)*sizeof(SensorSample));
+            State.pendingCount--;
+        }
+        State.pending[State.pendingCount++] = *sample;
+    }
+
+    __atomic_store_n(&State.tail, tail, __ATOMIC_RELEASE);
+}
+
+static void ApplySensorRate(Sensor sensor)
+{
+    const ASensor *handle = State.sensors[sensor];
+    int32_t periodUs = (State.rate[sensor] > 0)? 1000000/State.rate[sensor] : ASensor_getMinDelay(handle);
+    int64_t latencyUs = (int64_t)State.latency[sensor]*1000;
+
+    if (State.registerSensor != NULL) {
+        // NOTE: The registered rate and latency replace the ones of an enabled sensor once disabled first
+        ASensorEventQueue_disableSensor(State.eventQueue, handle);
+        if (State.registerSensor(State.eventQueue, handle, periodUs, latencyUs) != 0) {
+            TraceLog(LOG_ERROR, "Cannot enable sensor: %s", GetSensorName(sensor));
+        }
+    }
+    else {
+        if (ASensorEventQueue_enableSensor(State.eventQueue, handle) != 0) {
+            TraceLog(LOG_ERROR, "Cannot enable sensor: %s", GetSensorName(sensor));
+        }
+        else if (State.rate[sensor] > 0) ASensorEventQueue_setEventRate(State.eventQueue, handle, periodUs);
+    }
+}
+
 /* PUBLIC API */
 
 void InitSensorManager(void)
 {
     State.manager = ASensorManager_getInstance();
+    State.registerSensor = (RegisterSensorFunc)dlsym(RTLD_DEFAULT, "ASensorEventQueue_registerSensor");
+    State.tiltTime = SENSOR_TILT_TIME;
 
     // Get all available sensors
 
@@ -112,10 +242,14 @@ void InitSensorManager(void)
     }
 
     // Create event queue
+    // NOTE: On the raylib input thread looper when there is one, samples are buffered as they arrive
+
+    ALooper *looper = GetAndroidInputLooper();
+    if (looper == NULL) looper = ALooper_prepare(ALOOPER_PREPARE_ALLOW_NON_CALLBACKS);
 
     State.looperID = 1;
     State.eventQueue = ASensorManager_createEventQueue(
-            State.manager, ALooper_prepare(ALOOPER_PREPARE_ALLOW_NON_CALLBACKS),
+            State.manager, looper,
             State.looperID, SensorCallback, NULL);
 
     if (State.eventQueue == NULL) {
@@ -129,9 +263,8 @@ void EnableSensor(Sensor sensor)
         TraceLog(LOG_WARNING, "Cannot enable unsupported sensor: %s", GetSensorName(sensor));
         return;
     }
-    if (ASensorEventQueue_enableSensor(State.eventQueue, State.sensors[sensor]) != 0) {
-        TraceLog(LOG_ERROR, "Cannot enable sensor: %s", GetSensorName(sensor));
-    }
+    ApplySensorRate(sensor);
+    State.enabled[sensor] = true;
 }
 
 void DisableSensor(Sensor sensor)
@@ -143,6 +276,15 @@ void DisableSensor(Sensor sensor)
     if (ASensorEventQueue_disableSensor(State.eventQueue, State.sensors[sensor]) != 0) {
         TraceLog(LOG_ERROR, "Cannot disable sensor: %s", GetSensorName(sensor));
     }
+    State.enabled[sensor] = false;
+}
+
+void SetSensorRate(Sensor sensor, int rate, int maxLatency)
+{
+    State.rate[sensor] = (rate > 0)? rate : 0;
+    State.latency[sensor] = (maxLatency > 0)? maxLatency : 0;
+
+    if (State.enabled[sensor]) ApplySensorRate(sensor);
 }
 
 bool IsSensorAvailable(Sensor sensor)
@@ -152,10 +294,43 @@ bool IsSensorAvailable(Sensor sensor)
 
 Vector3 GetAccelerotmerAxis(void)
 {
-    return State.inputs.accelerometerAxis;
+    ReadSensorSamples();
+
+    return State.latest[SENSOR_ACCELEROMETER];
 }
 
 Vector3 GetGyroscopeAxis(void)
 {
-    return State.inputs.gyroscopeAxis;
+    ReadSensorSamples();
+
+    return State.latest[SENSOR_GYROSCOPE];
+}
+
+int GetSensorSamples(SensorSample *samples, int maxSamples)
+{
+    ReadSensorSamples();
+
+    int count = (State.pendingCount < maxSamples)? State.pendingCount : maxSamples;
+    memcpy(samples, State.pending, count*sizeof(SensorSample));
+
+    // Samples not returned stay for the next call
+    State.pendingCount -= count;
+    memmove(State.pending, State.pending + count, State.pendingCount*sizeof(SensorSample));
+
+    unsigned int dropped = __atomic_exchange_n(&State.dropped, 0, __ATOMIC_RELAXED);
+    if (dropped > 0) TraceLog(LOG_WARNING, "Sensor samples buffer full, %u samples dropped", dropped);
+
+    return count;
+}
+
+Vector2 GetDeviceTilt(void)
+{
+    ReadSensorSamples();
+
+    return State.tilt;
+}
+
+void SetDeviceTiltFilter(float timeConstant)
+{
+    State.tiltTime = (timeConstant > 0.0f)? timeConstant : 0.0f;
 }
@@ -22,120 +22,119 @@
  *  SOFTWARE.
  */
 
+#define RL_MEMORY_TAG MEMORY_TAG_RAYMOB
 #include "raymob.h"
 #include <string.h>
 
-void ShowSoftKeyboard(void)
-{
-    jobject context = GetNativeLoaderInstance();
+/* Static variables */
 
-    if (context != NULL) {
-        JNIEnv* env = AttachCurrentThread();
-        jclass nativeLoaderClass = (*env)->GetObjectClass(env, context);
+static struct {
+    bool ready;
+    jobject softKeyboard;           // com.raylib.raymob.SoftKeyboard (global ref)
+    jmethodID showKeyboard;
+    jmethodID hideKeyboard;
+    jmethodID getLastKeyCode;
+    jmethodID getLastKeyLabel;
+    jmethodID getLastKeyUnicode;
+    jmethodID clearLastKeyEvent;
+} Jni = { 0 };
 
-        jfieldID softKeyboardField = (*env)->GetFieldID(env, nativeLoaderClass, "softKeyboard", "Lcom/raylib/raymob/SoftKeyboard;");
-        jobject softKeyboard = (*env)->GetObjectField(env, context, softKeyboardField);
+/* Functions definition */
 
-        if (softKeyboard != NULL) {
-            jclass softKeyboardClass = (*env)->GetObjectClass(env, softKeyboard);
-            jmethodID method = (*env)->GetMethodID(env, softKeyboardClass, "showKeyboard", "()V");
-            (*env)->CallVoidMethod(env, softKeyboard, method);
-        }
+void InitSoftKeyboardJNI(JNIEnv *env)
+{
+    if (Jni.ready) return;
+    Jni.ready = true;
 
-        DetachCurrentThread();
+    jobject context = GetNativeLoaderInstance();
+    if (context == NULL) return;
+
+    jclass nativeLoaderClass = (*env)->GetObjectClass(env, context);
+    jfieldID softKeyboardField = (*env)->GetFieldID(env, nativeLoaderClass, "softKeyboard", "Lcom/raylib/raymob/SoftKeyboard;");
+    jobject softKeyboard = (*env)->GetObjectField(env, context, softKeyboardField);
+
+    if (softKeyboard != NULL) {
+        jclass softKeyboardClass = (*env)->GetObjectClass(env, softKeyboard);
+        Jni.softKeyboard = (*env)->NewGlobalRef(env, softKeyboard);
+        Jni.showKeyboard = (*env)->GetMethodID(env, softKeyboardClass, "showKeyboard", "()V");
+        Jni.hideKeyboard = (*env)->GetMethodID(env, softKeyboardClass, "hideKeyboard", "()V");
+        Jni.getLastKeyCode = (*env)->GetMethodID(env, softKeyboardClass, "getLastKeyCode", "()I");
+        Jni.getLastKeyLabel = (*env)->GetMethodID(env, softKeyboardClass, "getLastKeyLabel", "()C");
+        Jni.getLastKeyUnicode = (*env)->GetMethodID(env, softKeyboardClass, "getLastKeyUnicode", "()I");
+        Jni.clearLastKeyEvent = (*env)->GetMethodID(env, softKeyboardClass, "clearLastKeyEvent", "()V");
     }
 }
 
-void HideSoftKeyboard(void)
+void ShowSoftKeyboard(void)
 {
-    jobject context = GetNativeLoaderInstance();
+    JNIEnv* env = AttachCurrentThread();
+    InitSoftKeyboardJNI(env);
 
-    if (context != NULL) {
-        JNIEnv* env = AttachCurrentThread();
-        jclass nativeLoaderClass = (*env)->GetObjectClass(env, context);
+    if (Jni.softKeyboard != NULL) {
+        (*env)->CallVoidMethod(env, Jni.softKeyboard, Jni.showKeyboard);
+    }
 
-        jfieldID softKeyboardField = (*env)->GetFieldID(env, nativeLoaderClass, "softKeyboard", "Lcom/raylib/raymob/SoftKeyboard;");
-        jobject softKeyboard = (*env)->GetObjectField(env, context, softKeyboardField);
+    DetachCurrentThread();
+}
 
-        if (softKeyboard != NULL) {
-            jclass softKeyboardClass = (*env)->GetObjectClass(env, softKeyboard);
-            jmethodID method = (*env)->GetMethodID(env, softKeyboardClass, "hideKeyboard", "()V");
-            (*env)->CallVoidMethod(env, softKeyboard, method);
-        }
+void HideSoftKeyboard(void)
+{
+    JNIEnv* env = AttachCurrentThread();
+    InitSoftKeyboardJNI(env);
 
-        DetachCurrentThread();
+    if (Jni.softKeyboard != NULL) {
+        (*env)->CallVoidMethod(env, Jni.softKeyboard, Jni.hideKeyboard);
     }
+
+    DetachCurrentThread();
 }
 
 int GetLastSoftKeyCode(void)
 {
-    jobject context = GetNativeLoaderInstance();
-
-    if (context != NULL) {
-        JNIEnv* env = AttachCurrentThread();
-        jclass nativeLoaderClass = (*env)->GetObjectClass(env, context);
+    int value = 0;
 
-        jfieldID softKeyboardField = (*env)->GetFieldID(env, nativeLoaderClass, "softKeyboard", "Lcom/raylib/raymob/SoftKeyboard;");
-        jobject softKeyboard = (*env)->GetObjectField(env, context, softKeyboardField);
+    JNIEnv* env = AttachCurrentThread();
+    InitSoftKeyboardJNI(env);
 
-        if (softKeyboard != NULL) {
-            jclass softKeyboardClass = (*env)->GetObjectClass(env, softKeyboard);
-            jmethodID method = (*env)->GetMethodID(env, softKeyboardClass, "getLastKeyCode", "()I");
-            int value = (*env)->CallIntMethod(env, softKeyboard, method);
-            DetachCurrentThread();
-            return value;
-        }
-
-        DetachCurrentThread();
+    if (Jni.softKeyboard != NULL) {
+        value = (*env)->CallIntMethod(env, Jni.softKeyboard, Jni.getLastKeyCode);
     }
 
-    return 0;
+    DetachCurrentThread();
+
+    return value;
 }
 
 unsigned short GetLastSoftKeyLabel(void)
 {
-    jobject context = GetNativeLoaderInstance();
-
-    if (context != NULL) {
-        JNIEnv* env = AttachCurrentThread();
-        jclass nativeLoaderClass = (*env)->GetObjectClass(env, context);
+    unsigned short value = 0;
 
-        jfieldID softKeyboardField = (*env)->GetFieldID(env, nativeLoaderClass, "softKeyboard", "Lcom/raylib/raymob/SoftKeyboard;");
-        jobject softKeyboard = (*env)->GetObjectField(env, context, softKeyboardField);
+    JNIEnv* env = AttachCurrentThread();
+    InitSoftKeyboardJNI(env);
 
-        if (softKeyboard != NULL) {
-            jclass softKeyboardClass = (*env)->GetObjectClass(env, softKeyboard);
-            jmethodID method = (*env)->GetMethodID(env, softKeyboardClass, "getLastKeyLabel", "()C");
-            unsigned short value = (*env)->CallCharMethod(env, softKeyboard, method);
-            DetachCurrentThread();
-            return value;
-        }
+    if (Jni.softKeyboard != NULL) {
+        value = (*env)->CallCharMethod(env, Jni.softKeyboard, Jni.getLastKeyLabel);
     }
 
-    return 0;
+    DetachCurrentThread();
+
+    return value;
 }
 
 int GetLastSoftKeyUnicode(void)
 {
-    jobject context = GetNativeLoaderInstance();
+    int value = 0;
 
-    if (context != NULL) {
-        JNIEnv* env = AttachCurrentThread();
-        jclass nativeLoaderClass = (*env)->GetObjectClass(env, context);
+    JNIEnv* env = AttachCurrentThread();
+    InitSoftKeyboardJNI(env);
 
-        jfieldID softKeyboardField = (*env)->GetFieldID(env, nativeLoaderClass, "softKeyboard", "Lcom/raylib/raymob/SoftKeyboard;");
-        jobject softKeyboard = (*env)->GetObjectField(env, context, softKeyboardField);
-
-        if (softKeyboard != NULL) {
-            jclass softKeyboardClass = (*env)->GetObjectClass(env, softKeyboard);
-            jmethodID method = (*env)->GetMethodID(env, softKeyboardClass, "getLastKeyUnicode", "()I");
-            int value = (*env)->CallIntMethod(env, softKeyboard, method);
-            DetachCurrentThread();
-            return value;
-        }
+    if (Jni.softKeyboard != NULL) {
+        value = (*env)->CallIntMethod(env, Jni.softKeyboard, Jni.getLastKeyUnicode);
     }
 
-    return 0;
+    DetachCurrentThread();
+
+    return value;
 }
 
 char GetLastSoftKeyChar(void)
@@ -143,68 +142,46 @@ char GetLastSoftKeyChar(void)
 #define KEYCODE_ENTER    66
 #define KEYCODE_DEL      67
 
-    jobject context = GetNativeLoaderInstance();
-
-    if (context != NULL) {
-        char value = '\0';
-
-        JNIEnv* env = AttachCurrentThread();
-        jclass nativeLoaderClass = (*env)->GetObjectClass(env, context);
-
-        jfieldID softKeyboardField = (*env)->GetFieldID(env, nativeLoaderClass, "softKeyboard", "Lcom/raylib/raymob/SoftKeyboard;");
-        jobject softKeyboard = (*env)->GetObjectField(env, context, softKeyboardField);
-
-        if (softKeyboard != NULL) {
-            jclass softKeyboardClass = (*env)->GetObjectClass(env, softKeyboard);
-
-            jmethodID methodKeyCode = (*env)->GetMethodID(env, softKeyboardClass, "getLastKeyCode", "()I");
-            int keyCode = (*env)->CallIntMethod(env, softKeyboard, methodKeyCode);
-
-            if (keyCode != 0) {
-                switch (keyCode) {
-                    case KEYCODE_ENTER: {
-                        value = '\n';
-                    } break;
-                    case KEYCODE_DEL: {
-                        value = '\b';
-                    } break;
-                    default: {
-                        jmethodID methodKeyUnicode = (*env)->GetMethodID(env, softKeyboardClass, "getLastKeyUnicode", "()I");
-                        int u = (*env)->CallIntMethod(env, softKeyboard, methodKeyUnicode);
-                        if (u > 0xFF) value = '?';
-                        else value = (char) u;
-                    }
+    char value = '\0';
+
+    JNIEnv* env = AttachCurrentThread();
+    InitSoftKeyboardJNI(env);
+
+    if (Jni.softKeyboard != NULL) {
+        int keyCode = (*env)->CallIntMethod(env, Jni.softKeyboard, Jni.getLastKeyCode);
+
+        if (keyCode != 0) {
+            switch (keyCode) {
+                case KEYCODE_ENTER: {
+                    value = '\n';
+                } break;
+                case KEYCODE_DEL: {
+                    value = '\b';
+                } break;
+                default: {
+                    int u = (*env)->CallIntMethod(env, Jni.softKeyboard, Jni.getLastKeyUnicode);
+                    if (u > 0xFF) value = '?';
+                    else value = (char) u;
                 }
             }
         }
-
-        DetachCurrentThread();
-
-        return value;
     }
 
-    return '\0';
+    DetachCurrentThread();
+
+    return value;
 }
 
 void ClearLastSoftKey(void)
 {
-    jobject context = GetNativeLoaderInstance();
-
-    if (context != NULL) {
-        JNIEnv* env = AttachCurrentThread();
-        jclass nativeLoaderClass = (*env)->GetObjectClass(env, context);
+    JNIEnv* env = AttachCurrentThread();
+    InitSoftKeyboardJNI(env);
 
-        jfieldID softKeyboardField = (*env)->GetFieldID(env, nativeLoaderClass, "softKeyboard", "Lcom/raylib/raymob/SoftKeyboard;");
-        jobject softKeyboard = (*env)->GetObjectField(env, context, softKeyboardField);
-
-        if (softKeyboard != NULL) {
-            jclass softKeyboardClass = (*env)->GetObjectClass(env, softKeyboard);
-            jmethodID method = (*env)->GetMethodID(env, softKeyboardClass, "clearLastKeyEvent", "()V");
-            (*env)->CallVoidMethod(env, softKeyboard, method);
-        }
-
-        DetachCurrentThread();
+    if (Jni.softKeyboard != NULL) {
+        (*env)->CallVoidMethod(env, Jni.softKeyboard, Jni.clearLastKeyEvent);
     }
+
+    DetachCurrentThread();
 }
 
 void SoftKeyboardEditText(char* text, unsigned int size)
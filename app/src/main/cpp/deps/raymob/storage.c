@@ -0,0 +1,247 @@
+/*
+ *  raymob License (MIT)
+ *
+ *  Copyright (c) 2023-2024 Le Juez Victor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#define RL_MEMORY_TAG MEMORY_TAG_RAYMOB
+#include "raymob.h"
+#include <pthread.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Defines */
+
+#define STORAGE_MAX_PENDING     16      // Files waiting to be written, a write to a new file waits when full
+#define STORAGE_PATH_LENGTH    512
+#define STORAGE_BATCH_DELAY_MS 200      // Writes gathered before a batch starts (later writes to the same file replace earlier ones)
+
+/* Types */
+
+typedef struct {
+    char filepath[STORAGE_PATH_LENGTH]; // Relative to app specific storage
+    unsigned char *data;                // Copy of the data, owned by the writer
+    unsigned int size;
+} PendingWrite;
+
+/* Static variables */
+
+static char storageRoot[STORAGE_PATH_LENGTH] = { 0 };
+static PendingWrite pendingWrites[STORAGE_MAX_PENDING] = { 0 };
+static int pendingCount = 0;
+static int writingCount = 0;            // Writes taken by the writer thread, not on disk yet
+static bool writerRunning = false;
+static bool writerClosing = false;
+static bool flushRequested = false;     // Batch delay skipped, a caller waits for the writes
+static pthread_t writerThread;
+static pthread_mutex_t writerMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t writesAdded = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t writesDone = PTHREAD_COND_INITIALIZER;
+
+/* Static functions */
+
+static bool WriteAll(int fd, const unsigned char *data, unsigned int size){
+    while (size > 0) {
+        ssize_t count = write(fd, data, size);
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) return false;
+        data += count;
+        size -= (unsigned int)count;
+    }
+    return true;
+}
+
+// Whole new file or old file kept: written next to it, synced, then renamed over it
+static bool WriteFileAtomic(const char *filepath, const unsigned char *data, unsigned int size){
+    char path[STORAGE_PATH_LENGTH*2];
+    char tempPath[STORAGE_PATH_LENGTH*2 + 8];
+    snprintf(path, sizeof(path), "%s/%s", storageRoot, filepath);
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", path);
+
+    int fd = open(tempPath, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to open file", tempPath);
+        return false;
+    }
+
+    bool success = WriteAll(fd, data, size) && (fsync(fd) == 0);
+    success = (close(fd) == 0) && success;
+    success = success && (rename(tempPath, path) == 0);
+
+    if (success) TraceLog(LOG_INFO, "FILEIO: [%s] File saved successfully", path);
+    else {
+        TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to write file", path);
+        unlink(tempPath);
+    }
+
+    return success;
+}
+
+// The renames of a batch are made durable with one directory sync
+static void SyncStorageRoot(){
+    int fd = open(storageRoot, O_RDONLY | O_DIRECTORY);
+    if (fd < 0) return;
+    fsync(fd);
+    close(fd);
+}
+
+static void *AppStorageWriterThread(void *arg){
+    (void)arg;
+    PendingWrite batch[STORAGE_MAX_PENDING];
+
+    pthread_mutex_lock(&writerMutex);
+
+    while (true) {
+        while (pendingCount == 0 && !writerClosing) pthread_cond_wait(&writesAdded, &writerMutex);
+        if (pendingCount == 0) break;
+
+        // Batch window: saves made in a row (same frame, same hole) end up in one batch
+        if (!flushRequested && !writerClosing) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += STORAGE_BATCH_DELAY_MS*1000000L;
+            deadline.tv_sec += deadline.tv_nsec/1000000000L;
+            deadline.tv_nsec %= 1000000000L;
+
+            while (!flushRequested && !writerClosing && pendingCount < STORAGE_MAX_PENDING) {
+                if (pthread_cond_timedwait(&writesAdded, &writerMutex, &deadline) == ETIMEDOUT) break;
+            }
+        }
+
+        int count = pendingCount;
+        memcpy(batch, pendingWrites, count*sizeof(PendingWrite));
+        pendingCount = 0;
+        writingCount = count;
+        pthread_cond_broadcast(&writesDone);    // Room for new writes
+        pthread_mutex_unlock(&writerMutex);
+
+        for (int i = 0; i < count; i++) {
+            WriteFileAtomic(batch[i].filepath, batch[i].data, batch[i].size);
+            RL_FREE(batch[i].data);
+        }
+        SyncStorageRoot();
+
+        pthread_mutex_lock(&writerMutex);
+        writingCount = 0;
+        pthread_cond_broadcast(&writesDone);
+    }
+
+    pthread_mutex_unlock(&writerMutex);
+
+    return NULL;
+}
+
+/* Public functions */
+
+bool InitAppStorageWriter(){
+    if (writerRunning) return true;
+
+    char *appStoragePath = GetAppStoragePath();
+    if (appStoragePath == NULL) return false;
+
+    bool valid = (strlen(appStoragePath) < sizeof(storageRoot));
+    if (valid) strcpy(storageRoot, appStoragePath);
+    RL_FREE(appStoragePath);
+
+    if (!valid) {
+        TraceLog(LOG_WARNING, "FILEIO: App storage path too long, write-behind disabled");
+        return false;
+    }
+
+    writerClosing = false;
+    writerRunning = (pthread_create(&writerThread, NULL, AppStorageWriterThread, NULL) == 0);
+    if (!writerRunning) TraceLog(LOG_WARNING, "FILEIO: Storage writer thread not available, saves are written right away");
+
+    return writerRunning;
+}
+
+bool WriteToAppStorageAsync(const char *filepath, const void *data, unsigned int dataSize){
+    if (strlen(filepath) >= STORAGE_PATH_LENGTH) {
+        TraceLog(LOG_WARNING, "FILEIO: [%s] File path too long", filepath);
+        return false;
+    }
+
+    // NOTE: Without the writer thread the save still is atomic, only not in background
+    if (!writerRunning) {
+        if (storageRoot[0] == '\0') return WriteToAppStorage(filepath, (void *)data, dataSize);
+        return WriteFileAtomic(filepath, (const unsigned char *)data, dataSize);
+    }
+
+    unsigned char *copy = RL_MALLOC(dataSize > 0 ? dataSize : 1);
+    if (copy == NULL) return false;
+    memcpy(copy, data, dataSize);
+
+    pthread_mutex_lock(&writerMutex);
+
+    // Coalesced: a pending write to the same file is replaced, only the last data is written
+    int index = -1;
+    for (int i = 0; i < pendingCount; i++) {
+        if (strcmp(pendingWrites[i].filepath, filepath) == 0) { index = i; break; }
+    }
+
+    if (index >= 0) RL_FREE(pendingWrites[index].data);
+    else {
+        // NOTE: A full queue ends the batch window, the writer takes everything right away
+        while (pendingCount >= STORAGE_MAX_PENDING) {
+            pthread_cond_signal(&writesAdded);
+            pthread_cond_wait(&writesDone, &writerMutex);
+        }
+        index = pendingCount++;
+        strcpy(pendingWrites[index].filepath, filepath);
+    }
+
+    pendingWrites[index].data = copy;
+    pendingWrites[index].size = dataSize;
+
+    pthread_cond_signal(&writesAdded);
+    pthread_mutex_unlock(&writerMutex);
+
+    return true;
+}
+
+void FlushAppStorage(){
+    if (!writerRunning) return;
+
+    pthread_mutex_lock(&writerMutex);
+    flushRequested = true;
+    pthread_cond_signal(&writesAdded);
+    while (pendingCount > 0 || writingCount > 0) pthread_cond_wait(&writesDone, &writerMutex);
+    flushRequested = false;
+    pthread_mutex_unlock(&writerMutex);
+}
+
+void CloseAppStorageWriter(){
+    if (!writerRunning) return;
+
+    pthread_mutex_lock(&writerMutex);
+    writerClosing = true;
+    pthread_cond_signal(&writesAdded);
+    pthread_mutex_unlock(&writerMutex);
+
+    // NOTE: Pending writes are still written before the thread ends
+    pthread_join(writerThread, NULL);
+    writerRunning = false;
+}
@@ -22,34 +22,65 @@
  *  SOFTWARE.
  */
 
+#define RL_MEMORY_TAG MEMORY_TAG_RAYMOB
 #include "raymob.h"
 
-void Vibrate(float seconds)
-{
-    VibrateMS((uint64_t)(1000 * seconds));
-}
+/* Static variables */
 
-void VibrateMS(uint64_t ms)
+static struct {
+    bool ready;
+    jobject vibrator;               // android.os.Vibrator (global ref), NULL without a vibrator
+    jmethodID vibrate;              // vibrate(long)
+    jmethodID vibrateEffect;        // vibrate(VibrationEffect), NULL before API 26
+    jclass vibrationEffectClass;    // android.os.VibrationEffect (global ref), NULL before API 26
+    jmethodID createOneShot;
+} Jni = { 0 };
+
+/* Functions definition */
+
+void InitVibratorJNI(JNIEnv *env)
 {
+    if (Jni.ready) return;
+    Jni.ready = true;
+
     jobject nativeLoaderInst = GetNativeLoaderInstance();
-    JNIEnv* env = AttachCurrentThread();
 
     jclass nativeLoaderClass = (*env)->GetObjectClass(env, nativeLoaderInst);
     jmethodID getSystemServiceMethod = (*env)->GetMethodID(env, nativeLoaderClass, "getSystemService", "(Ljava/lang/String;)Ljava/lang/Object;");
 
     jstring vibratorService = (*env)->NewStringUTF(env, "vibrator");
     jobject vibrator = (*env)->CallObjectMethod(env, nativeLoaderInst, getSystemServiceMethod, vibratorService);
-    (*env)->DeleteLocalRef(env, vibratorService);
+    if (vibrator == NULL) return;
 
     jclass vibratorClass = (*env)->GetObjectClass(env, vibrator);
     jmethodID hasVibratorMethod = (*env)->GetMethodID(env, vibratorClass, "hasVibrator", "()Z");
-    jboolean hasVibrator = (*env)->CallBooleanMethod(env, vibrator, hasVibratorMethod);
+    if (!(*env)->CallBooleanMethod(env, vibrator, hasVibratorMethod)) return;
 
-    if (hasVibrator) {
-        jmethodID vibrateMethod = (*env)->GetMethodID(env, vibratorClass, "vibrate", "(J)V");
-        if (vibrateMethod != NULL) {
-            (*env)->CallVoidMethod(env, vibrator, vibrateMethod, (jlong)ms);
-        }
+    Jni.vibrator = (*env)->NewGlobalRef(env, vibrator);
+    Jni.vibrate = (*env)->GetMethodID(env, vibratorClass, "vibrate", "(J)V");
+
+    // NOTE: VibrationEffect is only there from API 26, older devices vibrate at full intensity
+    jclass vibrationEffectClass = (*env)->FindClass(env, "android/os/VibrationEffect");
+    if (vibrationEffectClass != NULL) {
+        Jni.vibrationEffectClass = (*env)->NewGlobalRef(env, vibrationEffectClass);
+        Jni.createOneShot = (*env)->GetStaticMethodID(env, vibrationEffectClass, "createOneShot", "(JI)Landroid/os/VibrationEffect;");
+        Jni.vibrateEffect = (*env)->GetMethodID(env, vibratorClass, "vibrate", "(Landroid/os/VibrationEffect;)V");
+    }
+    else (*env)->ExceptionClear(env);
+}
+
+void Vibrate(float seconds)
+{
+    VibrateMS((uint64_t)(1000 * seconds));
+}
+
+void VibrateMS(uint64_t ms)
+{
+    JNIEnv* env = AttachCurrentThread();
+    InitVibratorJNI(env);
+
+    if (Jni.vibrator != NULL) {
+        (*env)->CallVoidMethod(env, Jni.vibrator, Jni.vibrate, (jlong)ms);
     }
 
     DetachCurrentThread();
@@ -62,33 +93,21 @@ void VibrateEx(float seconds, float intensity)
 
 void VibrateExMS(uint64_t ms, float intensity)
 {
-    jobject nativeLoaderInst = GetNativeLoaderInstance();
     JNIEnv* env = AttachCurrentThread();
+    InitVibratorJNI(env);
 
-    jclass nativeLoaderClass = (*env)->GetObjectClass(env, nativeLoaderInst);
-    jmethodID getSystemServiceMethod = (*env)->GetMethodID(env, nativeLoaderClass, "getSystemService", "(Ljava/lang/String;)Ljava/lang/Object;");
-
-    jstring vibratorService = (*env)->NewStringUTF(env, "vibrator");
-    jobject vibrator = (*env)->CallObjectMethod(env, nativeLoaderInst, getSystemServiceMethod, vibratorService);
-    (*env)->DeleteLocalRef(env, vibratorService);
-
-    jclass vibratorClass = (*env)->GetObjectClass(env, vibrator);
-    jmethodID hasVibratorMethod = (*env)->GetMethodID(env, vibratorClass, "hasVibrator", "()Z");
-    jboolean hasVibrator = (*env)->CallBooleanMethod(env, vibrator, hasVibratorMethod);
-
-    if (hasVibrator) {
-        jclass vibrationEffectClass = (*env)->FindClass(env, "android/os/VibrationEffect");
-        jmethodID createOneShotMethod = (*env)->GetStaticMethodID(env, vibrationEffectClass, "createOneShot", "(JI)Landroid/os/VibrationEffect;");
-
+    if (Jni.vibrator != NULL && Jni.vibrateEffect == NULL) {
+        (*env)->CallVoidMethod(env, Jni.vibrator, Jni.vibrate, (jlong)ms);
+    }
+    else if (Jni.vibrator != NULL) {
         int intensityValue = (int)(intensity * 255);
         if (intensityValue > 255) intensityValue = 255;
         if (intensityValue < 1) intensityValue = 1;
 
-        jobject vibrationEffect = (*env)->CallStaticObjectMethod(env, vibrationEffectClass, createOneShotMethod, (jlong)ms, (jint)intensityValue);
+        jobject vibrationEffect = (*env)->CallStaticObjectMethod(env, Jni.vibrationEffectClass, Jni.createOneShot, (jlong)ms, (jint)intensityValue);
 
         if (vibrationEffect != NULL) {
-            jmethodID vibrateMethod = (*env)->GetMethodID(env, vibratorClass, "vibrate", "(Landroid/os/VibrationEffect;)V");
-            (*env)->CallVoidMethod(env, vibrator, vibrateMethod, vibrationEffect);
+            (*env)->CallVoidMethod(env, Jni.vibrator, Jni.vibrateEffect, vibrationEffect);
         }
     }
 
@@ -0,0 +1,335 @@
+/*
+ *  raymob License (MIT)
+ *
+ *  Copyright (c) 2023-2024 Le Juez Victor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#define RL_MEMORY_TAG MEMORY_TAG_RAYMOB
+#include "raymob.h"
+#include "rlgl.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <android/native_window.h>
+#include <media/NdkMediaCodec.h>
+#include <media/NdkMediaFormat.h>
+#include <media/NdkMediaMuxer.h>
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Defines */
+
+#define VIDEO_PATH_LENGTH           1024        // Full path of the video file
+#define VIDEO_COLOR_FORMAT_SURFACE  0x7F000789  // MediaCodecInfo.CodecCapabilities.COLOR_FormatSurface
+#define VIDEO_KEYFRAME_INTERVAL     1           // Seconds between two key frames
+#define VIDEO_DRAIN_TIMEOUT         10000       // Microseconds waited for an encoded frame once the input has ended
+#define VIDEO_FINISH_TIMEOUT        2.0         // Seconds given to the encoder to write its last frames
+
+#ifndef EGL_RECORDABLE_ANDROID
+    #define EGL_RECORDABLE_ANDROID  0x3142
+#endif
+
+/* Types */
+
+// NOTE: Input surfaces are API 26, looked up at runtime like the thermal manager
+typedef media_status_t (*CreateInputSurfaceFunc)(AMediaCodec *codec, ANativeWindow **surface);
+typedef media_status_t (*SignalEndOfInputStreamFunc)(AMediaCodec *codec);
+typedef EGLBoolean (*PresentationTimeFunc)(EGLDisplay display, EGLSurface surface, int64_t time);
+
+struct VideoEncoder {
+    AMediaCodec *codec;
+    AMediaMuxer *muxer;
+    ANativeWindow *window;          // Codec input surface
+    int fd;
+    char path[VIDEO_PATH_LENGTH];
+
+    EGLDisplay display;
+    EGLContext context;             // raylib context, made current on the codec surface for each frame
+    EGLSurface surface;             // Window surface on the codec input
+    EGLSurface screenDraw;          // Surfaces current before BeginVideoFrame()
+    EGLSurface screenRead;
+
+    int width;
+    int height;
+    int frameRate;
+    int frame;                      // Frames submitted
+    int written;                    // Frames written to the file
+    int track;                      // Muxer track, -1 until the codec gives its output format
+    bool failed;
+    bool ended;                     // End of stream came out of the codec
+};
+
+/* Static variables */
+
+static struct {
+    bool ready;
+    CreateInputSurfaceFunc createInputSurface;      // NULL before API 26
+    SignalEndOfInputStreamFunc signalEndOfInputStream;
+    PresentationTimeFunc presentationTime;          // EGL_ANDROID_presentation_time
+} Api = { 0 };
+
+/* Static functions */
+
+static void InitVideoApi(void)
+{
+    if (Api.ready) return;
+    Api.ready = true;
+
+    Api.createInputSurface = (CreateInputSurfaceFunc)dlsym(RTLD_DEFAULT, "AMediaCodec_createInputSurface");
+    Api.signalEndOfInputStream = (SignalEndOfInputStreamFunc)dlsym(RTLD_DEFAULT, "AMediaCodec_signalEndOfInputStream");
+    Api.presentationTime = (PresentationTimeFunc)eglGetProcAddress("eglPresentationTimeANDROID");
+}
+
+// Writes every encoded frame the codec has, waiting up to 'timeout' microseconds for each
+static void DrainVideoEncoder(VideoEncoder *encoder, int64_t timeout)
+{
+    while (!encoder->ended) {
+        AMediaCodecBufferInfo info = { 0 };
+        ssize_t index = AMediaCodec_dequeueOutputBuffer(encoder->codec, &info, timeout);
+        if (index == AMEDIACODEC_INFO_TRY_AGAIN_LATER) break;
+
+        if (index == AMEDIACODEC_INFO_OUTPUT_FORMAT_CHANGED) {
+            // NOTE: The output format carries the codec config (SPS/PPS), the only track is added and the muxer started with it
+            if (encoder->track >= 0) continue;
+
+            AMediaFormat *format = AMediaCodec_getOutputFormat(encoder->codec);
+            encoder->track = (int)AMediaMuxer_addTrack(encoder->muxer, format);
+            AMediaFormat_delete(format);
+
+            if ((encoder->track < 0) || (AMediaMuxer_start(encoder->muxer) != AMEDIA_OK)) {
+                TraceLog(LOG_WARNING, "VIDEO: [%s] Failed to start the MP4 muxer", encoder->path);
+                encoder->track = -1;
+                encoder->failed = true;
+                encoder->ended = true;
+            }
+            continue;
+        }
+        if (index < 0) continue;   // AMEDIACODEC_INFO_OUTPUT_BUFFERS_CHANGED
+
+        size_t size = 0;
+        uint8_t *data = AMediaCodec_getOutputBuffer(encoder->codec, (size_t)index, &size);
+        if ((data != NULL) && (info.size > 0) && (encoder->track >= 0) && ((info.flags & AMEDIACODEC_BUFFER_FLAG_CODEC_CONFIG) == 0)) {
+            AMediaMuxer_writeSampleData(encoder->muxer, (size_t)encoder->track, data, &info);
+            encoder->written++;
+        }
+        AMediaCodec_releaseOutputBuffer(encoder->codec, (size_t)index, false);
+
+        if (info.flags & AMEDIACODEC_BUFFER_FLAG_END_OF_STREAM) encoder->ended = true;
+    }
+}
+
+// Creates and starts the codec, its input surface is in encoder->window
+static bool StartVideoCodec(VideoEncoder *encoder, const char *mime, int bitRate)
+{
+    encoder->codec = AMediaCodec_createEncoderByType(mime);
+    if (encoder->codec == NULL) return false;
+
+    AMediaFormat *format = AMediaFormat_new();
+    AMediaFormat_setString(format, AMEDIAFORMAT_KEY_MIME, mime);
+    AMediaFormat_setInt32(format, AMEDIAFORMAT_KEY_WIDTH, encoder->width);
+    AMediaFormat_setInt32(format, AMEDIAFORMAT_KEY_HEIGHT, encoder->height);
+    AMediaFormat_setInt32(format, AMEDIAFORMAT_KEY_BIT_RATE, bitRate);
+    AMediaFormat_setInt32(format, AMEDIAFORMAT_KEY_FRAME_RATE, encoder->frameRate);
+    AMediaFormat_setInt32(format, AMEDIAFORMAT_KEY_I_FRAME_INTERVAL, VIDEO_KEYFRAME_INTERVAL);
+    AMediaFormat_setInt32(format, AMEDIAFORMAT_KEY_COLOR_FORMAT, VIDEO_COLOR_FORMAT_SURFACE);
+
+    bool started = (AMediaCodec_configure(encoder->codec, format, NULL, NULL, AMEDIACODEC_CONFIGURE_FLAG_ENCODE) == AMEDIA_OK) &&
+                   (Api.createInputSurface(encoder->codec, &encoder->window) == AMEDIA_OK) &&
+                   (AMediaCodec_start(encoder->codec) == AMEDIA_OK);
+    AMediaFormat_delete(format);
+
+    if (!started) {
+        if (encoder->window != NULL) ANativeWindow_release(encoder->window);
+        AMediaCodec_delete(encoder->codec);
+        encoder->window = NULL;
+        encoder->codec = NULL;
+    }
+
+    return started;
+}
+
+// Config of the raylib context, the codec surface must be compatible with it
+static EGLConfig GetContextConfig(EGLDisplay display, EGLContext context)
+{
+    EGLint configId = 0;
+    eglQueryContext(display, context, EGL_CONFIG_ID, &configId);
+
+    const EGLint attribs[] = { EGL_CONFIG_ID, configId, EGL_NONE };
+    EGLConfig config = NULL;
+    EGLint count = 0;
+    if (!eglChooseConfig(display, attribs, &config, 1, &count) || (count == 0)) return NULL;
+
+    // NOTE: Most encoders take any RGB888 surface, some only the configs flagged recordable
+    EGLint recordable = EGL_FALSE;
+    eglGetConfigAttrib(display, config, EGL_RECORDABLE_ANDROID, &recordable);
+    if (recordable != EGL_TRUE) TraceLog(LOG_INFO, "VIDEO: Window config is not recordable, the encoder may reject its surface");
+
+    return config;
+}
+
+static void FreeVideoEncoder(VideoEncoder *encoder, bool complete)
+{
+    if (encoder->surface != EGL_NO_SURFACE) eglDestroySurface(encoder->display, encoder->surface);
+    if (encoder->codec != NULL) {
+        AMediaCodec_stop(encoder->codec);
+        AMediaCodec_delete(encoder->codec);
+    }
+    if (encoder->window != NULL) ANativeWindow_release(encoder->window);
+    if (encoder->muxer != NULL) {
+        if (encoder->track >= 0) AMediaMuxer_stop(encoder->muxer);
+        AMediaMuxer_delete(encoder->muxer);
+    }
+    if (encoder->fd >= 0) close(encoder->fd);
+    if (!complete && (encoder->path[0] != '\0')) unlink(encoder->path);
+
+    RL_FREE(encoder);
+}
+
+/* Functions definition */
+
+VideoEncoder *LoadVideoEncoder(const char *filepath, int width, int height, int frameRate, int bitRate, VideoCodec codec)
+{
+    InitVideoApi();
+    if ((Api.createInputSurface == NULL) || (Api.signalEndOfInputStream == NULL) || (Api.presentationTime == NULL)) {
+        TraceLog(LOG_WARNING, "VIDEO: Encoder input surfaces not available (API 26), no video export");
+        return NULL;
+    }
+
+    EGLDisplay display = eglGetCurrentDisplay();
+    EGLContext context = eglGetCurrentContext();
+    EGLConfig config = (context != EGL_NO_CONTEXT)? GetContextConfig(display, context) : NULL;
+    if (config == NULL) {
+        TraceLog(LOG_WARNING, "VIDEO: No GL context current, encoder not started");
+        return NULL;
+    }
+
+    char *storagePath = GetAppStoragePath();
+    if (storagePath == NULL) return NULL;
+
+    VideoEncoder *encoder = (VideoEncoder *)RL_CALLOC(1, sizeof(VideoEncoder));
+    snprintf(encoder->path, sizeof(encoder->path), "%s/%s", storagePath, filepath);
+    MemFree(storagePath);
+
+    encoder->fd = -1;
+    encoder->track = -1;
+    encoder->surface = EGL_NO_SURFACE;
+    encoder->display = display;
+    encoder->context = context;
+    encoder->width = width;
+    encoder->height = height;
+    encoder->frameRate = frameRate;
+
+    const char *mime = (codec == VIDEO_CODEC_HEVC)? "video/hevc" : "video/avc";
+    bool started = StartVideoCodec(encoder, mime, bitRate);
+    if (!started && (codec == VIDEO_CODEC_HEVC)) {
+        TraceLog(LOG_INFO, "VIDEO: No HEVC encoder for %ix%i, encoding H.264", width, height);
+        mime = "video/avc";
+        started = StartVideoCodec(encoder, mime, bitRate);
+    }
+    if (!started) {
+        TraceLog(LOG_WARNING, "VIDEO: Failed to start a %s encoder for %ix%i", mime, width, height);
+        FreeVideoEncoder(encoder, false);
+        return NULL;
+    }
+
+    encoder->fd = open(encoder->path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (encoder->fd >= 0) encoder->muxer = AMediaMuxer_new(encoder->fd, AMEDIAMUXER_OUTPUT_FORMAT_MPEG_4);
+    if (encoder->muxer == NULL) {
+        TraceLog(LOG_WARNING, "VIDEO: [%s] Failed to open file", encoder->path);
+        FreeVideoEncoder(encoder, false);
+        return NULL;
+    }
+
+    encoder->surface = eglCreateWindowSurface(display, config, encoder->window, NULL);
+    if (encoder->surface == EGL_NO_SURFACE) {
+        TraceLog(LOG_WARNING, "VIDEO: Failed to create the encoder surface (EGL error 0x%04x)", eglGetError());
+        FreeVideoEncoder(encoder, false);
+        return NULL;
+    }
+
+    TraceLog(LOG_INFO, "VIDEO: [%s] Encoding %s %ix%i at %i fps, %i kbps", filepath, mime, width, height, frameRate, bitRate/1000);
+
+    return encoder;
+}
+
+bool BeginVideoFrame(VideoEncoder *encoder)
+{
+    if ((encoder == NULL) || encoder->failed) return false;
+
+    // Frames encoded meanwhile are written first, the codec never runs out of output buffers
+    DrainVideoEncoder(encoder, 0);
+
+    // NOTE: Screen draws still batched go to the screen, not into the video
+    rlDrawRenderBatchActive();
+
+    encoder->screenDraw = eglGetCurrentSurface(EGL_DRAW);
+    encoder->screenRead = eglGetCurrentSurface(EGL_READ);
+    if (!eglMakeCurrent(encoder->display, encoder->surface, encoder->surface, encoder->context)) {
+        TraceLog(LOG_WARNING, "VIDEO: [%s] Failed to draw into the encoder surface (EGL error 0x%04x)", encoder->path, eglGetError());
+        encoder->failed = true;
+        return false;
+    }
+
+    // Framebuffer 0 is the codec surface now: a target without framebuffer sets its viewport and projection
+    RenderTexture2D target = { 0 };
+    target.texture.width = encoder->width;
+    target.texture.height = encoder->height;
+    BeginTextureMode(target);
+
+    return true;
+}
+
+void EndVideoFrame(VideoEncoder *encoder)
+{
+    // NOTE: EndTextureMode() puts the screen viewport and projection back, the GL state goes with the context
+    EndTextureMode();
+
+    Api.presentationTime(encoder->display, encoder->surface, (int64_t)encoder->frame*1000000000/encoder->frameRate);
+    if (!eglSwapBuffers(encoder->display, encoder->surface)) encoder->failed = true;
+    encoder->frame++;
+
+    eglMakeCurrent(encoder->display, encoder->screenDraw, encoder->screenRead, encoder->context);
+
+    DrainVideoEncoder(encoder, 0);
+}
+
+bool UnloadVideoEncoder(VideoEncoder *encoder)
+{
+    if (encoder == NULL) return false;
+
+    if (!encoder->failed && (encoder->frame > 0)) {
+        Api.signalEndOfInputStream(encoder->codec);
+
+        double deadline = GetTime() + VIDEO_FINISH_TIMEOUT;
+        while (!encoder->ended && (GetTime() < deadline)) DrainVideoEncoder(encoder, VIDEO_DRAIN_TIMEOUT);
+    }
+
+    bool complete = !encoder->failed && encoder->ended && (encoder->written > 0);
+    if (complete) TraceLog(LOG_INFO, "VIDEO: [%s] Video saved, %i frames", encoder->path, encoder->written);
+    else TraceLog(LOG_WARNING, "VIDEO: [%s] Video not saved (%i of %i frames encoded)", encoder->path, encoder->written, encoder->frame);
+
+    FreeVideoEncoder(encoder, complete);
+
+    return complete;
+}
@@ -0,0 +1,124 @@
+#include "dynres.h"
+#include "rlgl.h"
+
+#include <math.h>
+#include <string.h>
+
+void DynamicResolutionInit(DynamicResolution *dynres, int targetFps)
+{
+    memset(dynres, 0, sizeof(DynamicResolution));
+    dynres->enabled = true;
+    dynres->scale = 1.0f;
+    dynres->maxScale = 1.0f;
+    dynres->budgetMs = 1000.0f/(float)((targetFps > 0)? targetFps : 60);
+    dynres->busyMs = 0.0f;
+    dynres->settleFrames = DYNRES_SETTLE_FRAMES;
+}
+
+void DynamicResolutionSetLimits(DynamicResolution *dynres, int targetFps, float maxScale)
+{
+    dynres->budgetMs = 1000.0f/(float)((targetFps > 0)? targetFps : 60);
+    dynres->maxScale = fminf(fmaxf(maxScale, DYNRES_MIN_SCALE), 1.0f);
+    dynres->busyMs = 0.0f;      // Measured again at the new frame rate
+
+    if (dynres->scale > dynres->maxScale) {
+        dynres->scale = dynres->maxScale;
+        dynres->settleFrames = DYNRES_SETTLE_FRAMES;
+    }
+}
+
+void DynamicResolutionUpdate(DynamicResolution *dynres)
+{
+    // NOTE: The frame wait is idle time at any scale, everything else grows with the pixels drawn
+    // (GPU time shows up in the render and swap phases once the driver runs out of queued frames)
+    ProfilerStats frame = GetProfilerStats(PROFILER_PHASE_FRAME);
+    ProfilerStats wait = GetProfilerStats(PROFILER_PHASE_WAIT);
+    if (frame.samples == 0) return;
+
+    float busy = fmaxf(frame.last - wait.last, 0.0f);
+    dynres->busyMs = (dynres->busyMs == 0.0f)? busy : dynres->busyMs + (busy - dynres->busyMs)*DYNRES_SMOOTHING;
+
+    if (dynres->settleFrames > 0) {
+        dynres->settleFrames--;
+        return;
+    }
+
+    float scale = dynres->scale;
+    if (!dynres->enabled) scale = 1.0f;
+    else if (dynres->busyMs > dynres->budgetMs*DYNRES_HIGH_LOAD) scale = fmaxf(scale - DYNRES_SCALE_STEP, DYNRES_MIN_SCALE);
+    else if (dynres->busyMs < dynres->budgetMs*DYNRES_LOW_LOAD) scale = fminf(scale + DYNRES_SCALE_STEP, dynres->maxScale);
+
+    if (scale != dynres->scale) {
+        TraceLog(LOG_DEBUG, "DYNRES: Busy %.2f/%.2f ms, render scale %.2f -> %.2f", dynres->busyMs, dynres->budgetMs, dynres->scale, scale);
+        dynres->scale = scale;
+        dynres->settleFrames = DYNRES_SETTLE_FRAMES;
+    }
+}
+
+void DynamicResolutionBegin(DynamicResolution *dynres)
+{
+    int renderWidth = GetRenderWidth(), renderHeight = GetRenderHeight();
+    dynres->drawing = false;
+    if (dynres->scale >= 1.0f) return;
+
+    // Render size changes (rotation) reallocate the target, smaller scales only use less of it
+    if ((dynres->target.id == 0) || (dynres->target.texture.width != renderWidth) || (dynres->target.texture.height != renderHeight)) {
+        if (dynres->target.id != 0) UnloadRenderTexture(dynres->target);
+        dynres->target = LoadRenderTexture(renderWidth, renderHeight);
+        if (dynres->target.id == 0) {
+            TraceLog(LOG_WARNING, "DYNRES: Render target not available, the world is drawn at full resolution");
+            dynres->enabled = false;
+            dynres->scale = 1.0f;
+            return;
+        }
+        SetTextureFilter(dynres->target.texture, TEXTURE_FILTER_BILINEAR);
+        SetTextureWrap(dynres->target.texture, TEXTURE_WRAP_CLAMP);
+    }
+
+    dynres->viewWidth = (int)fmaxf(roundf((float)renderWidth*dynres->scale), 1.0f);
+    dynres->viewHeight = (int)fmaxf(roundf((float)renderHeight*dynres->scale), 1.0f);
+
+    BeginTextureMode(dynres->target);
+
+    // World in screen coordinates, mapped onto the scaled area
+    rlViewport(0, 0, dynres->viewWidth, dynres->viewHeight);
+    rlMatrixMode(RL_PROJECTION);
+    rlLoadIdentity();
+    rlOrtho(0, GetScreenWidth(), GetScreenHeight(), 0, 0.0f, 1.0f);
+    rlMatrixMode(RL_MODELVIEW);
+    rlLoadIdentity();
+
+    dynres->drawing = true;
+}
+
+void DynamicResolutionEnd(DynamicResolution *dynres)
+{
+    if (!dynres->drawing) return;
+    dynres->drawing = false;
+
+    EndTextureMode();
+
+    // NOTE: Render textures are stored upside down, the world is in the bottom rows of the texture
+    // The far edges stop half a texel short, so filtering doesn't pick up pixels outside the scaled area
+    // Blending is disabled, translucent sprites left partial alpha in the target
+    Rectangle source = { 0.0f, 0.0f, (float)dynres->viewWidth - 0.5f, -((float)dynres->viewHeight - 0.5f) };
+    Rectangle dest = { 0.0f, 0.0f, (float)GetScreenWidth(), (float)GetScreenHeight() };
+
+    rlDrawRenderBatchActive();
+    rlDisableColorBlend();
+    DrawTexturePro(dynres->target.texture, source, dest, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+    rlDrawRenderBatchActive();
+    rlEnableColorBlend();
+}
+
+void DynamicResolutionUnload(DynamicResolution *dynres)
+{
+    if (dynres->target.id != 0) UnloadRenderTexture(dynres->target);
+    memset(dynres, 0, sizeof(DynamicResolution));
+}
+
+void DynamicResolutionRestore(DynamicResolution *dynres)
+{
+    dynres->target = (RenderTexture2D){ 0 };
+    dynres->drawing = false;
+}
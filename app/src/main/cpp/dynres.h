@@ -0,0 +1,69 @@
+#ifndef DYNRES_H
+#define DYNRES_H
+
+#include "raylib.h"
+
+// --- Dynamic Resolution ---
+// QHD panels at native resolution are too much fill for low-end GPUs. The game world (static layer,
+// balls, aiming) is drawn into the bottom-left part of a render texture, scaled to keep the busy
+// frame time (profiler frame time minus the frame wait) inside the frame budget, then upscaled over
+// the screen. HUD drawn after DynamicResolutionEnd() stays at native resolution.
+// At full scale the world is drawn straight to the screen, without the extra pass.
+#define DYNRES_MIN_SCALE            0.5f    // Lowest render scale per axis (a quarter of the pixels)
+#define DYNRES_SCALE_STEP           0.05f   // Scale change per adjustment
+#define DYNRES_HIGH_LOAD            0.90f   // Busy share of the frame budget above which the scale drops
+#define DYNRES_LOW_LOAD             0.70f   // Busy share of the frame budget below which the scale grows
+#define DYNRES_SMOOTHING            0.1f    // Weight of the last frame in the smoothed busy time
+#define DYNRES_SETTLE_FRAMES        30      // Frames after a change before the next one (new scale measured)
+
+typedef struct DynamicResolution {
+    RenderTexture2D target;     // Render resolution, allocated on the first scale drop
+    bool enabled;
+    float scale;                // Render scale per axis, DYNRES_MIN_SCALE to maxScale
+    float maxScale;             // Highest render scale allowed (1.0, lower under thermal load, see governor.h)
+    float budgetMs;             // Frame budget, from the target frame rate
+    float busyMs;               // Smoothed busy frame time
+    int settleFrames;           // Frames left before the scale may change again
+    int viewWidth;              // Target area the world is drawn into
+    int viewHeight;
+    bool drawing;               // Between DynamicResolutionBegin() and DynamicResolutionEnd() into the target
+} DynamicResolution;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+void DynamicResolutionInit(DynamicResolution *dynres, int targetFps);
+
+/**
+ * @brief Changes the frame budget and caps the render scale, a higher scale drops to the cap right away.
+ */
+void DynamicResolutionSetLimits(DynamicResolution *dynres, int targetFps, float maxScale);
+
+/**
+ * @brief Adapts the scale to the last frames (before BeginDrawing(), once per frame).
+ */
+void DynamicResolutionUpdate(DynamicResolution *dynres);
+
+/**
+ * @brief Starts drawing the world, in screen coordinates (after BeginDrawing()).
+ */
+void DynamicResolutionBegin(DynamicResolution *dynres);
+
+/**
+ * @brief Ends drawing the world and upscales it over the whole screen (opaque, blending disabled).
+ */
+void DynamicResolutionEnd(DynamicResolution *dynres);
+
+void DynamicResolutionUnload(DynamicResolution *dynres);
+
+/**
+ * @brief Drops the render target of a lost GL context, allocated again when the world is next drawn scaled.
+ */
+void DynamicResolutionRestore(DynamicResolution *dynres);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // DYNRES_H
@@ -0,0 +1,244 @@
+#include "feedback.h"
+#include "raymob.h"
+#include <raymath.h>
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+#define FEEDBACK_SAMPLE_RATE        48000
+#define FEEDBACK_FADE_SECONDS       0.002f  // Faded out at the end, no click when a sound is cut short
+
+// Synthesized impact: a decaying tone with a noise click on the attack
+typedef struct ImpactSoundShape {
+    float frequency;            // Hz at the attack
+    float endFrequency;         // Hz at the end (pitch falling on bumpers)
+    float decay;                // Seconds for the tone to fall to 1/e
+    float length;               // Seconds
+    float noise;                // Attack click level (0 to 1)
+    int strikes;                // Repeats, each half as loud (the ball rattling in the cup)
+    float strikeGap;            // Seconds between two strikes
+} ImpactSoundShape;
+
+static const ImpactSoundShape impactSounds[PHYSICS_IMPACT_CUP + 1] = {
+    { 520.0f, 480.0f, 0.018f, 0.08f, 0.6f, 1, 0.0f },      // Wall: short wooden tock
+    { 900.0f, 560.0f, 0.060f, 0.16f, 0.3f, 1, 0.0f },      // Bumper: springy, falling pitch
+    { 1800.0f, 1700.0f, 0.006f, 0.03f, 0.8f, 1, 0.0f },    // Ball: hard click
+    { 180.0f, 150.0f, 0.045f, 0.30f, 0.4f, 3, 0.055f },    // Cup: clunk, then the rattle
+};
+
+static const float variantVolumes[FEEDBACK_SOUND_VARIANTS] = { 0.45f, 0.7f, 1.0f };
+
+static Sound SynthesizeImpactSound(const ImpactSoundShape *shape)
+{
+    int frameCount = (int)(shape->length*FEEDBACK_SAMPLE_RATE);
+    float *samples = (float *)MemAlloc(frameCount*sizeof(float));
+    unsigned int seed = 0x9e3779b9u;
+
+    for (int strike = 0; strike < shape->strikes; strike++) {
+        int start = (int)(strike*shape->strikeGap*FEEDBACK_SAMPLE_RATE);
+        float gain = 0.8f/(float)(1 << strike);
+        float phase = 0.0f;
+
+        for (int i = start; i < frameCount; i++) {
+            float t = (float)(i - start)/FEEDBACK_SAMPLE_RATE;
+            float frequency = Lerp(shape->frequency, shape->endFrequency, (float)i/frameCount);
+            phase += 2.0f*PI*frequency/FEEDBACK_SAMPLE_RATE;
+
+            seed = seed*1664525u + 1013904223u;
+            float noise = ((float)(seed >> 8)/8388608.0f - 1.0f)*shape->noise*expf(-t/0.002f);
+
+            samples[i] += gain*(sinf(phase)*expf(-t/shape->decay) + noise);
+        }
+    }
+
+    int fadeCount = (int)(FEEDBACK_FADE_SECONDS*FEEDBACK_SAMPLE_RATE);
+    for (int i = 0; i < fadeCount; i++) samples[frameCount - 1 - i] *= (float)i/fadeCount;
+
+    Wave wave = { (unsigned int)frameCount, FEEDBACK_SAMPLE_RATE, 32, 1, samples };
+    Sound sound = LoadSoundFromWave(wave);
+    UnloadWave(wave);
+
+    return sound;
+}
+
+// Louder alias for a harder impact, pitch slightly up with the speed
+static void PlayImpactSound(const ImpactFeedback *feedback, const FeedbackEvent *event)
+{
+    float strength = event->strength/65535.0f;
+    int variant = (int)(strength*FEEDBACK_SOUND_VARIANTS);
+    if (variant >= FEEDBACK_SOUND_VARIANTS) variant = FEEDBACK_SOUND_VARIANTS - 1;
+
+    float pitch = (event->type == PHYSICS_IMPACT_CUP)? 1.0f : 0.92f + 0.16f*strength;
+    PlaySoundVoice(feedback->sounds[event->type][variant], 0.5f + 0.5f*strength, pitch, event->pan);
+}
+
+static void *ImpactFeedbackThread(void *arg)
+{
+    ImpactFeedback *feedback = (ImpactFeedback *)arg;
+
+    // NOTE: Attached once, each vibration then only costs its Java call
+    AttachCurrentThread();
+
+    float pendingAmplitude = 0.0f;      // Strongest vibration waiting for the interval
+    int pendingMs = 0;
+    double lastHaptic = -FEEDBACK_HAPTIC_INTERVAL;
+
+    while (true) {
+        // Timed wait only while a vibration waits for its interval
+        int result = 0;
+        if (pendingAmplitude > 0.0f) {
+            double remaining = lastHaptic + FEEDBACK_HAPTIC_INTERVAL - GetTime();
+            if (remaining < 0.0) remaining = 0.0;
+
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += (long)(remaining*1000000000.0);
+            deadline.tv_sec += deadline.tv_nsec/1000000000L;
+            deadline.tv_nsec %= 1000000000L;
+            result = sem_timedwait(&feedback->wake, &deadline);
+        }
+        else result = sem_wait(&feedback->wake);
+
+        if ((result != 0) && (errno == EINTR)) continue;
+        if (__atomic_load_n(&feedback->closing, __ATOMIC_ACQUIRE)) break;
+
+        // Impacts of the same ball and type merged, a frame of wall scraping plays once
+        FeedbackEvent merged[PHYSICS_IMPACT_CUP + 1][PHYSICS_MAX_BALLS];
+        bool hit[PHYSICS_IMPACT_CUP + 1][PHYSICS_MAX_BALLS] = { 0 };
+
+        unsigned int tail = feedback->tail;
+        unsigned int head = __atomic_load_n(&feedback->head, __ATOMIC_ACQUIRE);
+        for (; tail != head; tail++) {
+            const FeedbackEvent *event = &feedback->events[tail & (FEEDBACK_QUEUE_SIZE - 1)];
+            if ((event->type > PHYSICS_IMPACT_CUP) || (event->ball >= PHYSICS_MAX_BALLS)) continue;
+
+            if (!hit[event->type][event->ball] || (event->strength > merged[event->type][event->ball].strength)) {
+                merged[event->type][event->ball] = *event;
+                hit[event->type][event->ball] = true;
+            }
+        }
+        __atomic_store_n(&feedback->tail, tail, __ATOMIC_RELEASE);
+
+        unsigned int dropped = __atomic_exchange_n(&feedback->dropped, 0, __ATOMIC_RELAXED);
+        if (dropped > 0) TraceLog(LOG_DEBUG, "FEEDBACK: %u impacts dropped, queue full", dropped);
+
+        for (int type = 0; type <= PHYSICS_IMPACT_CUP; type++) {
+            for (int ball = 0; ball < PHYSICS_MAX_BALLS; ball++) {
+                if (!hit[type][ball]) continue;
+
+                const FeedbackEvent *event = &merged[type][ball];
+                PlayImpactSound(feedback, event);
+
+                float strength = event->strength/65535.0f;
+                float amplitude = 0.0f;
+                int ms = 0;
+                if (type == PHYSICS_IMPACT_CUP) { amplitude = 0.8f; ms = 45; }
+                else if (strength*MAX_VELOCITY >= FEEDBACK_HAPTIC_MIN_SPEED) {
+                    amplitude = 0.2f + 0.8f*strength;
+                    ms = (type == PHYSICS_IMPACT_BALL)? 10 : 12 + (int)(18.0f*strength);
+                }
+
+                if (amplitude > pendingAmplitude) {
+                    pendingAmplitude = amplitude;
+                    pendingMs = ms;
+                }
+            }
+        }
+
+        if ((pendingAmplitude > 0.0f) && (GetTime() - lastHaptic >= FEEDBACK_HAPTIC_INTERVAL)) {
+            VibrateExMS(pendingMs, pendingAmplitude);
+            lastHaptic = GetTime();
+            pendingAmplitude = 0.0f;
+        }
+    }
+
+    DetachCurrentThread();
+
+    return NULL;
+}
+
+void ImpactFeedbackInit(ImpactFeedback *feedback)
+{
+    memset(feedback, 0, sizeof(ImpactFeedback));
+
+    if (IsAudioDeviceReady()) {
+        for (int type = 0; type <= PHYSICS_IMPACT_CUP; type++) {
+            Sound sound = SynthesizeImpactSound(&impactSounds[type]);
+            if (!IsSoundValid(sound)) continue;
+
+            // NOTE: Aliases share the samples, only their volume differs
+            feedback->sounds[type][0] = sound;
+            for (int variant = 1; variant < FEEDBACK_SOUND_VARIANTS; variant++) feedback->sounds[type][variant] = LoadSoundAlias(sound);
+            for (int variant = 0; variant < FEEDBACK_SOUND_VARIANTS; variant++) SetSoundVolume(feedback->sounds[type][variant], variantVolumes[variant]);
+        }
+    }
+    else TraceLog(LOG_WARNING, "FEEDBACK: Audio device not ready, impacts are not played");
+
+    if (sem_init(&feedback->wake, 0, 0) != 0) {
+        TraceLog(LOG_WARNING, "FEEDBACK: Failed to create semaphore, impact sounds played on the game thread");
+        return;
+    }
+
+    feedback->threaded = (pthread_create(&feedback->worker, NULL, ImpactFeedbackThread, feedback) == 0);
+    if (!feedback->threaded) {
+        TraceLog(LOG_WARNING, "FEEDBACK: Feedback thread not available, impact sounds played on the game thread");
+        sem_destroy(&feedback->wake);
+    }
+}
+
+void ImpactFeedbackUpdate(ImpactFeedback *feedback, const PhysicsWorld *world)
+{
+    if (world->impactCount == 0) return;
+
+    unsigned int head = feedback->head;
+    unsigned int tail = __atomic_load_n(&feedback->tail, __ATOMIC_ACQUIRE);
+
+    for (int i = 0; i < world->impactCount; i++) {
+        const PhysicsImpact *impact = &world->impacts[i];
+        FeedbackEvent event = { 0 };
+        event.type = (uint8_t)impact->type;
+        event.ball = (uint8_t)impact->ball;
+        event.strength = (uint16_t)(Clamp(impact->speed/MAX_VELOCITY, 0.0f, 1.0f)*65535.0f);
+        event.pan = (world->width > 0.0f)? Clamp(0.5f + 0.7f*(0.5f - impact->position.x/world->width), 0.0f, 1.0f) : 0.5f;
+
+        // NOTE: Without the thread the sound still plays (the voice queue is lock-free), with no vibration
+        if (!feedback->threaded) {
+            PlayImpactSound(feedback, &event);
+            continue;
+        }
+
+        if (head - tail >= FEEDBACK_QUEUE_SIZE) {
+            __atomic_fetch_add(&feedback->dropped, world->impactCount - i, __ATOMIC_RELAXED);
+            break;
+        }
+        feedback->events[head & (FEEDBACK_QUEUE_SIZE - 1)] = event;
+        head++;
+    }
+
+    if (feedback->threaded) {
+        __atomic_store_n(&feedback->head, head, __ATOMIC_RELEASE);
+        sem_post(&feedback->wake);
+    }
+}
+
+void ImpactFeedbackUnload(ImpactFeedback *feedback)
+{
+    if (feedback->threaded) {
+        __atomic_store_n(&feedback->closing, true, __ATOMIC_RELEASE);
+        sem_post(&feedback->wake);
+        pthread_join(feedback->worker, NULL);
+        sem_destroy(&feedback->wake);
+        feedback->threaded = false;
+    }
+
+    // NOTE: Aliases first, unloading the sound frees the samples they share
+    for (int type = 0; type <= PHYSICS_IMPACT_CUP; type++) {
+        if (!IsSoundValid(feedback->sounds[type][0])) continue;
+
+        for (int variant = 1; variant < FEEDBACK_SOUND_VARIANTS; variant++) UnloadSoundAlias(feedback->sounds[type][variant]);
+        UnloadSound(feedback->sounds[type][0]);
+    }
+    memset(feedback->sounds, 0, sizeof(feedback->sounds));
+}
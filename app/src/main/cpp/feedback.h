@@ -0,0 +1,68 @@
+#ifndef FEEDBACK_H
+#define FEEDBACK_H
+
+#include "raylib.h"
+#include "physics.h"
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdint.h>
+
+// --- Impact Feedback ---
+// Physics impacts (world->impacts) turned into sounds and vibrations without stalling the frame. The game
+// thread only copies the impacts of the frame into a lock-free ring, 8 bytes each, and wakes the feedback
+// thread. That thread merges them (strongest impact per type and ball), plays each on a mixer voice
+// (PlaySoundVoice(), lock-free) and sends at most one vibration: the JNI call runs there, the thread stays
+// attached to the VM. Sounds are the aliases of a few synthesized impacts, one louder alias per speed band.
+#define FEEDBACK_QUEUE_SIZE         64      // Impacts waiting for the feedback thread (power of 2), later ones dropped
+#define FEEDBACK_SOUND_VARIANTS     3       // Aliases per sound, from soft to hard impacts
+#define FEEDBACK_HAPTIC_INTERVAL    0.04f   // Seconds between two vibrations, impacts in between send the strongest next
+#define FEEDBACK_HAPTIC_MIN_SPEED   2.0f    // Wall, bumper and ball impacts slower than this only make a sound
+
+// Impact as queued for the feedback thread
+typedef struct FeedbackEvent {
+    uint8_t type;               // PhysicsImpactType
+    uint8_t ball;
+    uint16_t strength;          // Impact speed over MAX_VELOCITY, 0 to 65535
+    float pan;                  // Stereo position (raylib pan, 1.0f is left)
+} FeedbackEvent;
+
+typedef struct ImpactFeedback {
+    FeedbackEvent events[FEEDBACK_QUEUE_SIZE];
+    unsigned int head;          // Next event written (game thread)
+    unsigned int tail;          // Next event read (feedback thread)
+    unsigned int dropped;       // Events lost on a full queue, logged by the feedback thread
+
+    Sound sounds[PHYSICS_IMPACT_CUP + 1][FEEDBACK_SOUND_VARIANTS];  // Per impact type: the sound, then its aliases
+    bool threaded;              // Feedback thread running
+    bool closing;
+    pthread_t worker;
+    sem_t wake;                 // Posted once per frame with impacts, and to close
+} ImpactFeedback;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Synthesizes the impact sounds and starts the feedback thread (after InitAudioDevice()).
+ *
+ * Without an audio device only the vibrations are sent.
+ */
+void ImpactFeedbackInit(ImpactFeedback *feedback);
+
+/**
+ * @brief Queues the impacts of the frame, after the frame ticks ran. Never blocks nor allocates.
+ */
+void ImpactFeedbackUpdate(ImpactFeedback *feedback, const PhysicsWorld *world);
+
+/**
+ * @brief Stops the feedback thread and unloads the sounds (before CloseAudioDevice()).
+ */
+void ImpactFeedbackUnload(ImpactFeedback *feedback);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // FEEDBACK_H
@@ -0,0 +1,136 @@
+#include "governor.h"
+
+#include <math.h>
+#include <string.h>
+
+static const QualityLevel qualityLevels[GOVERNOR_LEVELS] = {
+    { 1.0f,  1.0f,  1.0f,  0, 0 },      // Full quality, sensors at their default rate
+    { 1.0f,  0.85f, 0.75f, 60, 0 },
+    { 0.75f, 0.7f,  0.5f,  30, 100 },
+    { 0.5f,  0.6f,  0.25f, 15, 200 },   // Half frame rate, sensor samples batched by the sensor hub
+};
+
+static int GetLevelFps(const QualityGovernor *governor, int level)
+{
+    return (int)fmaxf(roundf((float)governor->baseFps*qualityLevels[level].fpsScale), 15.0f);
+}
+
+// Level asked for by the device state alone
+static int GetThermalLevel(const QualityGovernor *governor)
+{
+    int level = 0;
+
+    if (governor->thermalStatus >= THERMAL_STATUS_SEVERE) level = 3;
+    else if (governor->thermalStatus == THERMAL_STATUS_MODERATE) level = 2;
+    else if (governor->thermalStatus == THERMAL_STATUS_LIGHT) level = 1;
+
+    // NOTE: The forecast goes up before the status does, stepping down early keeps the status from moving at all
+    if (governor->headroom >= GOVERNOR_HEADROOM_SEVERE) level = 3;
+    else if ((governor->headroom >= GOVERNOR_HEADROOM_MODERATE) && (level < 2)) level = 2;
+    else if ((governor->headroom >= GOVERNOR_HEADROOM_LIGHT) && (level < 1)) level = 1;
+
+    if (governor->powerSave && (level < 2)) level = 2;
+
+    return level;
+}
+
+static void ApplyQualityLevel(const QualityGovernor *governor, DynamicResolution *dynres)
+{
+    const QualityLevel *quality = &qualityLevels[governor->level];
+    int fps = GetLevelFps(governor, governor->level);
+
+    SetTargetFPS(fps);
+    DynamicResolutionSetLimits(dynres, fps, quality->maxRenderScale);
+
+    // NOTE: Rates are kept for sensors enabled later
+    SetSensorRate(SENSOR_ACCELEROMETER, quality->sensorRate, quality->sensorLatency);
+    SetSensorRate(SENSOR_GYROSCOPE, quality->sensorRate, quality->sensorLatency);
+}
+
+void QualityGovernorInit(QualityGovernor *governor, int targetFps)
+{
+    memset(governor, 0, sizeof(QualityGovernor));
+    governor->baseFps = (targetFps > 0)? targetFps : 60;
+    governor->thermalStatus = THERMAL_STATUS_UNKNOWN;
+    governor->headroom = -1.0f;
+    governor->nextEvaluation = GetTime() + GOVERNOR_INTERVAL;
+
+    // NOTE: The battery saver lets the screen time out, it is the first power draw of the device
+    governor->powerSave = IsPowerSaveMode();
+    KeepScreenOn(!governor->powerSave);
+}
+
+bool QualityGovernorUpdate(QualityGovernor *governor, DynamicResolution *dynres)
+{
+    double time = GetTime();
+    if (time < governor->nextEvaluation) return false;
+    governor->nextEvaluation = time + GOVERNOR_INTERVAL;
+
+    governor->thermalStatus = GetThermalStatus();
+    governor->headroom = GetThermalHeadroom(GOVERNOR_FORECAST);
+
+    bool powerSave = IsPowerSaveMode();
+    if (powerSave != governor->powerSave) {
+        governor->powerSave = powerSave;
+        KeepScreenOn(!powerSave);
+    }
+
+    // Busy frame time at the window median (frame time minus the frame wait), against the level budget
+    // NOTE: Over budget at the lowest render scale is throttling already there, or a device too slow for the level
+    ProfilerStats frame = GetProfilerStats(PROFILER_PHASE_FRAME);
+    ProfilerStats wait = GetProfilerStats(PROFILER_PHASE_WAIT);
+    float busyMs = fmaxf(frame.p50 - wait.p50, 0.0f);
+    int level = governor->level;
+
+    bool overloaded = (frame.samples > 0) && (!dynres->enabled || (dynres->scale <= DYNRES_MIN_SCALE)) &&
+                      (busyMs > 1000.0f/GetLevelFps(governor, level)*DYNRES_HIGH_LOAD);
+    governor->overloadSteps = overloaded? governor->overloadSteps + 1 : 0;
+
+    // Level forced by the frame time, only given back when the frames would fit the level above
+    if (governor->overloadSteps >= GOVERNOR_OVERLOAD_STEPS) {
+        governor->loadLevel = (level < GOVERNOR_LEVELS - 1)? level + 1 : level;
+        governor->overloadSteps = 0;
+    }
+
+    bool relaxed = (frame.samples > 0) && (level > 0) && (busyMs < 1000.0f/GetLevelFps(governor, level - 1)*DYNRES_LOW_LOAD);
+    int loadLevel = (relaxed && (governor->loadLevel >= level))? level - 1 : governor->loadLevel;
+    int thermalLevel = GetThermalLevel(governor);
+    int wanted = (thermalLevel > loadLevel)? thermalLevel : loadLevel;
+
+    // Down right away (one level per evaluation), back up only after a while asking for less
+    if (wanted > level) {
+        level++;
+        governor->recoverSteps = 0;
+    }
+    else if (wanted < level) {
+        governor->recoverSteps++;
+        if (governor->recoverSteps >= GOVERNOR_RECOVER_STEPS) {
+            level--;
+            governor->recoverSteps = 0;
+            if (governor->loadLevel > level) governor->loadLevel = level;
+        }
+    }
+    else governor->recoverSteps = 0;
+
+    if (level == governor->level) return false;
+
+    TraceLog(LOG_INFO, "GOVERNOR: Quality level %i -> %i (thermal status %i, headroom %.2f, power save %s, busy %.1f ms), %i fps",
+             governor->level, level, governor->thermalStatus, governor->headroom, governor->powerSave? "on" : "off",
+             busyMs, GetLevelFps(governor, level));
+
+    governor->level = level;
+    ApplyQualityLevel(governor, dynres);
+
+    return true;
+}
+
+const QualityLevel *QualityGovernorGetLevel(const QualityGovernor *governor)
+{
+    return &qualityLevels[governor->level];
+}
+
+void QualityGovernorUnload(QualityGovernor *governor)
+{
+    KeepScreenOn(false);
+    memset(governor, 0, sizeof(QualityGovernor));
+}
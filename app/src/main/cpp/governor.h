@@ -0,0 +1,75 @@
+#ifndef GOVERNOR_H
+#define GOVERNOR_H
+
+#include "raylib.h"
+#include "raymob.h"
+#include "dynres.h"
+
+// --- Quality Governor ---
+// Long sessions heat the device until the system throttles the CPU and GPU, and the frame time doubles
+// at once. The governor steps quality down before that happens: frame rate, render scale cap, particle
+// budget and sensor rates, one level at a time. It follows the thermal status (API 30) and the forecast
+// thermal headroom (API 31), the battery saver, and on any device the frame-time profiler: frames still
+// over budget at the lowest render scale mean the device already throttles. Quality comes back one
+// level at a time, only after a while below the level.
+#define GOVERNOR_LEVELS             4       // Quality levels, 0 is full quality
+#define GOVERNOR_INTERVAL           1.0     // Seconds between two evaluations (thermal headroom read rate)
+#define GOVERNOR_FORECAST           10      // Seconds ahead of the thermal headroom forecast
+#define GOVERNOR_HEADROOM_LIGHT     0.75f   // Forecast headroom for level 1 (1.0 is severe throttling)
+#define GOVERNOR_HEADROOM_MODERATE  0.85f   // For level 2
+#define GOVERNOR_HEADROOM_SEVERE    0.95f   // For level 3
+#define GOVERNOR_OVERLOAD_STEPS     5       // Evaluations in a row over budget at the lowest render scale before a step down
+#define GOVERNOR_RECOVER_STEPS      30      // Evaluations in a row asking for less before a step back up
+
+// Quality settings of a level
+typedef struct QualityLevel {
+    float fpsScale;             // Share of the base target frame rate
+    float maxRenderScale;       // Dynamic resolution cap
+    float particleScale;        // Share of the particle budget
+    int sensorRate;             // Sensor samples per second, 0 for the sensor default
+    int sensorLatency;          // Sensor batching latency in milliseconds
+} QualityLevel;
+
+typedef struct QualityGovernor {
+    int level;                  // Current level, 0 to GOVERNOR_LEVELS - 1
+    int baseFps;                // Target frame rate at full quality
+    ThermalStatus thermalStatus;
+    float headroom;             // Last forecast headroom, negative when not available
+    bool powerSave;
+    int loadLevel;              // Lowest level the frame time allows
+    int overloadSteps;          // Evaluations in a row over budget at the lowest render scale
+    int recoverSteps;           // Evaluations in a row asking for a lower level
+    double nextEvaluation;
+} QualityGovernor;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Starts at full quality and keeps the screen on (after SetTargetFPS() and DynamicResolutionInit()).
+ */
+void QualityGovernorInit(QualityGovernor *governor, int targetFps);
+
+/**
+ * @brief Evaluates the device state once a GOVERNOR_INTERVAL and applies a new level (once per frame).
+ *
+ * @return true when the level changed this frame.
+ */
+bool QualityGovernorUpdate(QualityGovernor *governor, DynamicResolution *dynres);
+
+/**
+ * @brief Settings of the current level.
+ */
+const QualityLevel *QualityGovernorGetLevel(const QualityGovernor *governor);
+
+/**
+ * @brief Lets the screen turn off again.
+ */
+void QualityGovernorUnload(QualityGovernor *governor);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // GOVERNOR_H
@@ -0,0 +1,117 @@
+#include "gpuresources.h"
+#include "texformat.h"
+
+#include <string.h>
+
+typedef enum GpuResourceType {
+    GPU_RESOURCE_TEXTURE = 0,
+    GPU_RESOURCE_SDF_FONT,
+    GPU_RESOURCE_CALLBACK
+} GpuResourceType;
+
+typedef struct GpuResource {
+    GpuResourceType type;
+    void *resource;                 // Texture2D, SdfFont or callback context
+    GpuRestoreCallback callback;
+    char fileName[256];
+    char *glyphs;                   // SDF font glyphs copy (NULL for ASCII)
+    int fallbackSize;
+    bool ownsFont;                  // SDF font data is its own, not a copy of the raylib default font
+} GpuResource;
+
+static GpuResource resources[GPU_RESOURCES_MAX] = { 0 };
+static int resourceCount = 0;
+
+static GpuResource *AddGpuResource(GpuResourceType type, void *resource, const char *fileName)
+{
+    if (resourceCount >= GPU_RESOURCES_MAX) {
+        TraceLog(LOG_WARNING, "GPU: Too many resources registered, [%s] is not restored on context loss", (fileName != NULL)? fileName : "callback");
+        return NULL;
+    }
+
+    GpuResource *entry = &resources[resourceCount++];
+    memset(entry, 0, sizeof(GpuResource));
+    entry->type = type;
+    entry->resource = resource;
+    if (fileName != NULL) strncpy(entry->fileName, fileName, sizeof(entry->fileName) - 1);
+
+    return entry;
+}
+
+// Font CPU data freed with the stale GPU ids left alone
+// NOTE: A copy of the default font is only forgotten, raylib already released and reloaded the default font
+static void DropSdfFont(SdfFont *font, bool ownsFont)
+{
+    MemFree(font->shader.locs);
+    if (ownsFont) {
+        UnloadFontData(font->font.glyphs, font->font.glyphCount);
+        MemFree(font->font.recs);
+    }
+    memset(font, 0, sizeof(SdfFont));
+}
+
+static void RestoreGpuResources(void)
+{
+    double startTime = GetTime();
+
+    for (int i = 0; i < resourceCount; i++) {
+        GpuResource *entry = &resources[i];
+
+        switch (entry->type) {
+            case GPU_RESOURCE_TEXTURE: {
+                Texture2D *texture = (Texture2D *)entry->resource;
+                *texture = LoadTextureCompressed(entry->fileName);
+            } break;
+            case GPU_RESOURCE_SDF_FONT: {
+                SdfFont *font = (SdfFont *)entry->resource;
+                DropSdfFont(font, entry->ownsFont);
+                *font = LoadSdfFont(entry->fileName, entry->glyphs, entry->fallbackSize);
+                entry->ownsFont = (font->font.texture.id != GetFontDefault().texture.id);
+            } break;
+            case GPU_RESOURCE_CALLBACK: entry->callback(entry->resource); break;
+            default: break;
+        }
+    }
+
+    TraceLog(LOG_INFO, "GPU: %i resources restored in %.1f ms", resourceCount, (GetTime() - startTime)*1000.0);
+}
+
+void InitGpuResources(void)
+{
+    UnloadGpuResources();
+    SetContextRestoredCallback(RestoreGpuResources);
+}
+
+void RegisterTextureResource(Texture2D *texture, const char *fileName)
+{
+    AddGpuResource(GPU_RESOURCE_TEXTURE, texture, fileName);
+}
+
+void RegisterSdfFontResource(SdfFont *font, const char *fileName, const char *glyphs, int fallbackSize)
+{
+    GpuResource *entry = AddGpuResource(GPU_RESOURCE_SDF_FONT, font, fileName);
+    if (entry == NULL) return;
+
+    entry->fallbackSize = fallbackSize;
+    entry->ownsFont = (font->font.texture.id != GetFontDefault().texture.id);
+    if (glyphs != NULL) {
+        int length = (int)strlen(glyphs);
+        entry->glyphs = (char *)MemAlloc(length + 1);
+        memcpy(entry->glyphs, glyphs, length + 1);
+    }
+}
+
+void RegisterGpuRestoreCallback(GpuRestoreCallback callback, void *context)
+{
+    GpuResource *entry = AddGpuResource(GPU_RESOURCE_CALLBACK, context, NULL);
+    if (entry != NULL) entry->callback = callback;
+}
+
+void UnloadGpuResources(void)
+{
+    SetContextRestoredCallback(NULL);
+
+    for (int i = 0; i < resourceCount; i++) MemFree(resources[i].glyphs);
+    memset(resources, 0, sizeof(resources));
+    resourceCount = 0;
+}
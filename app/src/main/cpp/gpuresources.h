@@ -0,0 +1,53 @@
+#ifndef GPURESOURCES_H
+#define GPURESOURCES_H
+
+#include "raylib.h"
+#include "sdffont.h"
+
+// --- GPU Resource Restore ---
+// Going to the background only drops the window surface, the EGL context and everything on it are kept
+// (see APP_CMD_TERM_WINDOW in rcore_android.c), so resuming reloads nothing. The system may still drop
+// the context itself, raylib then creates a new one and every texture, shader and buffer id held by the
+// game refers to nothing. Resources registered here are loaded again from their on-disk copy: the asset
+// file (mapped from data.pak, GPU compressed textures uploaded as they are) and the baked .sdf atlas, so a
+// restore costs about as much as the loading screen uploads. Stale ids are dropped, never unloaded: the
+// new context may already use the same ids for other objects.
+#define GPU_RESOURCES_MAX           16
+
+// Reloads anything else (GL thread, after the registered textures and fonts before it)
+typedef void (*GpuRestoreCallback)(void *context);
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Restores the registered resources whenever a lost GL context is replaced (after InitWindow()).
+ */
+void InitGpuResources(void);
+
+/**
+ * @brief Registers a texture loaded from 'fileName' (a .png, its GPU compressed version is used when it exists).
+ */
+void RegisterTextureResource(Texture2D *texture, const char *fileName);
+
+/**
+ * @brief Registers a font loaded by LoadSdfFont() or LoadSdfFontAsync() (once the job is done), same parameters.
+ */
+void RegisterSdfFontResource(SdfFont *font, const char *fileName, const char *glyphs, int fallbackSize);
+
+/**
+ * @brief Registers resources the game restores itself (sprites copied from an atlas, batches, render targets).
+ */
+void RegisterGpuRestoreCallback(GpuRestoreCallback callback, void *context);
+
+/**
+ * @brief Forgets every registered resource, before they are unloaded.
+ */
+void UnloadGpuResources(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // GPURESOURCES_H
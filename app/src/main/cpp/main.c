@@ -1,42 +1,108 @@
 #include "raylib.h"
+#include "raymob.h"
 #include <raymath.h>
 #include <stdio.h>
 // Needed for fminf and other math functions, although raymath often includes them.
 #include <math.h>
 
-// --- Texture Declarations ---
-Texture2D background;
-Texture2D ball_sprite;
-Texture2D ball_shadow;
-Texture2D hole_sprite;
-Texture2D arrow_sprite;
-Texture2D settings_sprite;
+#include "physics.h"
+#include "course.h"
+#include "rules.h"
+#include "preview.h"
+#include "replay.h"
+#include "atlas.h"
+#include "staticlayer.h"
+#include "spritebatch.h"
+#include "textcache.h"
+#include "sdffont.h"
+#include "shapecache.h"
+#include "dynres.h"
+#include "assetloader.h"
+#include "assetpack.h"
+#include "gpuresources.h"
+#include "feedback.h"
+#include "governor.h"
+#include "multiplayer.h"
+#include "holegen.h"
+#include "terraintexture.h"
+#include "particles.h"
+#include "videoexport.h"
+#include "coursecamera.h"
+#include "coursetiles.h"
+#include "scorecache.h"
+
+// --- Sprite Declarations ---
+// NOTE: Sprites are regions of the gfx/ atlas (one texture for the whole frame), see atlas.h
+SpriteAtlas atlas = { 0 };
+Sprite background;
+Sprite ball_sprite;
+Sprite ball_shadow;
+Sprite hole_sprite;
+Sprite arrow_sprite;
+Sprite settings_sprite;
 
 // Power Meter Textures
-Texture2D power_bg;
-Texture2D power_fg;
-Texture2D power_overlay;
+Sprite power_bg;
+Sprite power_fg;
+Sprite power_overlay;
 
 // Font Declaration
-Font gameFont;
-
-// Game State Variables
-int strokes = 0;
-bool holeInOne = false;
+// NOTE: Distance field font, one atlas for every text size (bitmap font without OpenGL ES 3.0)
+SdfFont gameFont;
+TextCache hudText = { 0 };              // Laid out HUD strings, replayed every frame
+ShapeCache hudShapes = { 0 };           // Rounded button and fallback circle geometry, replayed every frame
 
 // Game Positions (Global for easy reset)
-Vector2 ball = {100.0f, 500.0f};
-Vector2 hole = {700.0f, 100.0f};
-Vector2 velocity = {0.0f, 0.0f};
+// NOTE: Ball, hole and velocity live in the physics world, stepped at a fixed rate
+const Vector2 BALL_START = {100.0f, 500.0f};
+Vector2 ballStart = {100.0f, 500.0f};   // Start of the current hole
+PhysicsWorld world = { 0 };
+
+// Game State Variables
+// NOTE: Strokes, hazards and holing out follow the rules in rules.h
+GolfPlayer player = { 0 };
 bool dragging = false;
 Vector2 dragStart = { 0.0f, 0.0f };
+int dragPointer = -1;                   // Touch pointer identifier of the drag
+TrajectoryPreview preview = { 0 };     // Predicted path of the shot being aimed
+ReplayRecorder replay = { 0 };          // Recent rounds, as shot inputs only
+StaticLayer staticLayer = { 0 };        // Background, course and hole, drawn once per hole
+TerrainTexture terrainTexture = { 0 };  // Slopes and friction of the current hole, shaded into the static layer
+SpriteBatch sprites = { 0 };            // Instanced sprites (balls, particles)
+ParticleSystem particles = { 0 };       // Confetti, splashes and ball trail
+CourseTiles courseTiles = { 0 };        // Streamed background of the current hole, when it has one
+ImpactFeedback feedback = { 0 };        // Impact sounds and vibrations, played off the game thread
+DynamicResolution dynres = { 0 };       // World render scale, follows the measured frame time
+QualityGovernor governor = { 0 };       // Frame rate and quality caps, follow the device temperature
+AssetLoader assets = { 0 };             // Atlas and font decoding while the loading screen is drawn
+Multiplayer multiplayer = { 0 };        // Opponent over UDP (multiplayer.cfg), single player without
+VideoExport videoExport = { 0 };        // Last round exported as an MP4 file (hardware encoder), from the win screen
+CourseCamera courseCamera = { 0 };      // Follows the ball over courses larger than the screen
+
+// Authored courses (optional, random holes are used when the file is missing)
+// NOTE: courseData is kept mapped, holes point directly into it
+const unsigned char *courseData = NULL;
+CoursePack coursePack = { 0 };
+uint32_t courseId = 0;                  // Key of the course in the score cache
+ScoreCache scoreCache = { 0 };          // Personal bests and last rounds per hole (only the index stays in memory)
+int currentHole = -1;
+HoleCandidates holeCandidates = { 0 }; // Random hole cups of the current screen size (kept until it changes)
+Vector2 courseSize = { 0.0f, 0.0f };    // Playfield size of the current hole, (0, 0) uses the screen
+// NOTE: Walls and bumpers in view are listed by PhysicsQueryGeometry(), a hole has at most UINT16_MAX of them
+uint16_t visibleItems[UINT16_MAX];
+uint32_t visibleMarks[(UINT16_MAX + 31)/32];
 
 // --- Custom Constants ---
-const float SINK_DISTANCE = 45.0f; // Distance threshold for automatic sinking
-const float SINK_PULL = 0.5f;      // Strength of the pull towards the center of the hole
-const float BALL_RADIUS = 30.0f; // Ball radius for collision (assuming 20x20 ball texture)
+// NOTE: Physics constants (SINK_DISTANCE, SINK_PULL, BALL_RADIUS...) are defined in physics.h
 // This must be equal to the X offset used in DrawWiiSportsText for correct positioning
 const float SHADOW_OFFSET = 3.0f;
+const float HOLE_VISUAL_SCALE = 3.0f;
+const float HOLE_FALLBACK_RADIUS = 40.0f;
+const double IDLE_REDRAW_DELAY = 0.5;      // Seconds with nothing moving before frames wait for input
+const Color OPPONENT_TINT = { 255, 170, 170, 200 };    // Opponent ball, drawn as a ghost over the course
+const float VIDEO_FONT_SIZE = 32.0f;       // Stroke counter of exported videos
+// Farther than this between two frames is a ball put back (hazard, new hole), not a roll
+const float BALL_MAX_FRAME_TRAVEL = MAX_VELOCITY*PHYSICS_REFERENCE_RATE*PHYSICS_MAX_FRAME_TIME;
 
 // A simple utility to center the ball/hole texture on its position
 Vector2 GetCenteredPosition(Vector2 position, Texture2D texture) {
@@ -48,121 +114,501 @@ Vector2 GetCenteredPosition(Vector2 position, Texture2D texture) {
 
 // Function to check if all power meter components loaded
 bool IsPowerMeterReady() {
-    return (power_bg.id != 0 && power_fg.id != 0 && power_overlay.id != 0);
+    return (power_bg.texture.id != 0 && power_fg.texture.id != 0 && power_overlay.texture.id != 0);
 }
 
 // Custom function for drawing text with outline/shadow (Wii Sports style)
-void DrawWiiSportsText(Font font, const char *text, Vector2 position, float fontSize, float spacing, Color outlineColor, Color mainColor) {
+// NOTE: The SDF shader draws the shadow in the same pass, a bitmap font replays the cached layout twice (see textcache.h)
+void DrawWiiSportsText(const TextRun *run, Vector2 position, Color outlineColor, Color mainColor) {
+    if (gameFont.sdf) {
+        SdfTextStyle style = { { SHADOW_OFFSET, SHADOW_OFFSET }, outlineColor, 0.0f, BLANK };
+        BeginSdfText(&gameFont, run->fontSize, style);
+        DrawTextRun(run, position, mainColor);
+        EndSdfText(&gameFont);
+        return;
+    }
+
     // Draw Outline/Shadow (Offset slightly down and right)
     // NOTE: SHADOW_OFFSET (3.0f) is used here
-    DrawTextEx(font, text, (Vector2){ position.x + SHADOW_OFFSET, position.y + SHADOW_OFFSET }, fontSize, spacing, outlineColor);
+    DrawTextRun(run, (Vector2){ position.x + SHADOW_OFFSET, position.y + SHADOW_OFFSET }, outlineColor);
 
     // Draw Main Text (White foreground)
-    DrawTextEx(font, text, position, fontSize, spacing, mainColor);
+    DrawTextRun(run, position, mainColor);
+}
+
+// Loading screen, drawn until the atlas and the font are ready
+// NOTE: Uses the raylib default font and plain shapes, nothing from the assets being loaded
+void DrawLoadingScreen(float progress) {
+    int screenWidth = GetScreenWidth();
+    int screenHeight = GetScreenHeight();
+    int fontSize = screenHeight/16;
+    float barWidth = (float)screenWidth*0.5f;
+    float barHeight = (float)fontSize*0.5f;
+    Rectangle bar = { ((float)screenWidth - barWidth)/2.0f, (float)screenHeight*0.6f, barWidth, barHeight };
+
+    ClearBackground(DARKGREEN);
+    DrawText("MINI GOLF", (screenWidth - MeasureText("MINI GOLF", fontSize))/2, screenHeight*2/5 - fontSize, fontSize, WHITE);
+    DrawRectangleRec(bar, (Color){ 0, 0, 0, 96 });
+    DrawRectangleRec((Rectangle){ bar.x, bar.y, bar.width*progress, bar.height }, WHITE);
 }
 
 /**
- * @brief Generates a new, random position for the hole.
- * NOTE: Uses GetScreenWidth() and GetScreenHeight() dynamically for better mobile support.
+ * @brief Picks a new, random position for the hole.
+ * NOTE: Cups come from a candidate set of the current screen size (see holegen.h), built again after a resize,
+ * so a pick is constant time on any screen (the old rejection loop could spin on small screens)
  */
 void GenerateNewHolePosition(void) {
-    int screenWidth = GetScreenWidth();
-    int screenHeight = GetScreenHeight();
+    Vector2 screenSize = { (float)GetScreenWidth(), (float)GetScreenHeight() };
+    ballStart = BALL_START;
 
-    const float minDistance = 300.0f; // Minimum distance from the starting ball position
-    const float margin = 50.0f; // Keep the hole 50px away from the edge
+    if (!HoleCandidatesMatch(&holeCandidates, screenSize, ballStart, world.geometry)) {
+        HoleCandidatesBuild(&holeCandidates, screenSize, ballStart, world.geometry, HOLEGEN_DEFAULT_SEED);
+        TraceLog(LOG_INFO, "HOLEGEN: %.0fx%.0f screen, %i cup candidates%s", screenSize.x, screenSize.y, holeCandidates.count,
+                 holeCandidates.relaxed? " (closer to the start than usual)" : "");
+    }
 
-    // Starting position of the ball is (100, 500)
-    Vector2 startPos = { 100.0f, 500.0f };
-    Vector2 newHolePos;
+    world.hole = HoleCandidatesPick(&holeCandidates, (uint32_t)GetRandomValue(0, (holeCandidates.count > 0)? holeCandidates.count - 1 : 0));
+}
 
-    // Loop until a valid position is found
-    do {
-        // Generate X between margin and screenWidth - margin
-        newHolePos.x = (float)GetRandomValue((int)margin, screenWidth - (int)margin);
-        // Generate Y between margin and screenHeight - margin
-        newHolePos.y = (float)GetRandomValue((int)margin, screenHeight - (int)margin);
 
-    } while (Vector2Distance(newHolePos, startPos) < minDistance);
+// Draws the parts of the scene that only change between holes over a world area (into the static layer)
+// NOTE: Only what reaches into 'bounds' is drawn, walls and bumpers come from the course grid
+void DrawStaticScene(Rectangle bounds) {
+    if (courseTiles.data != NULL) {
+        // Large holes have their own background, streamed in tiles (see coursetiles.h)
+        CourseTilesDraw(&courseTiles, &sprites, bounds);
+    } else if (background.texture.id != 0) {
+        Rectangle sourceRec = { 0.0f, 0.0f, (float)background.source.width, (float)background.source.height };
+        // Stretched over the playfield (the screen for random holes)
+        Rectangle destRec = { 0.0f, 0.0f, world.width, world.height };
+        DrawSpritePro(background, sourceRec, destRec, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+    } else {
+        ClearBackground(GREEN);
+    }
+
+    // Terrain shading comes from the samples the ball rolls on (see terraintexture.h)
+    TerrainTextureDraw(&terrainTexture, &world.geometry.terrain);
+
+    // Course areas and obstacles
+    for (int i = 0; i < world.geometry.areaCount; i++) {
+        const PhysicsArea *area = &world.geometry.areas[i];
+        Rectangle areaRec = { area->x, area->y, area->width, area->height };
+        if (!CheckCollisionRecs(areaRec, bounds)) continue;
+        Color areaColor = (area->type == AREA_WATER)? Fade(BLUE, 0.6f) : (area->type == AREA_ROUGH)? Fade(BEIGE, 0.7f) : Fade(LIME, 0.3f);
+        DrawRectangleRec(areaRec, areaColor);
+    }
 
-    hole = newHolePos;
+    // Walls first, then bumpers over them
+    int itemCount = PhysicsQueryGeometry(&world.geometry, (Vector2){ bounds.x, bounds.y }, (Vector2){ bounds.x + bounds.width, bounds.y + bounds.height }, visibleItems, visibleMarks);
+    for (int i = 0; i < itemCount; i++) {
+        if (visibleItems[i] < world.geometry.wallCount) DrawLineEx(world.geometry.walls[visibleItems[i]].a, world.geometry.walls[visibleItems[i]].b, 8.0f, DARKBROWN);
+    }
+    for (int i = 0; i < itemCount; i++) {
+        if (visibleItems[i] < world.geometry.wallCount) continue;
+        const PhysicsBumper *bumper = &world.geometry.bumpers[visibleItems[i] - world.geometry.wallCount];
+        DrawCircleV(bumper->center, bumper->radius, BROWN);
+    }
+
+    if (hole_sprite.texture.id != 0) {
+        Vector2 holeDrawPos = {
+            world.hole.x - (hole_sprite.source.width * HOLE_VISUAL_SCALE) / 2.0f,
+            world.hole.y - (hole_sprite.source.height * HOLE_VISUAL_SCALE) / 2.0f
+        };
+        DrawSpriteEx(hole_sprite, holeDrawPos, HOLE_VISUAL_SCALE, WHITE);
+    } else {
+        DrawCircleV(world.hole, HOLE_FALLBACK_RADIUS, DARKGRAY);
+    }
+}
+
+// Size of the hole as drawn by DrawStaticScene()
+Vector2 GetCupSize(void) {
+    if (hole_sprite.texture.id != 0) return (Vector2){ hole_sprite.source.width * HOLE_VISUAL_SCALE, hole_sprite.source.height * HOLE_VISUAL_SCALE };
+    return (Vector2){ HOLE_FALLBACK_RADIUS * 2.0f, HOLE_FALLBACK_RADIUS * 2.0f };
+}
+
+// Loads the course pack once, switching holes afterwards is just a lookup into it
+void LoadCourse(const char *fileName) {
+    int dataSize = 0;
+    courseData = LoadFileDataMapped(fileName, &dataSize);
+
+    if (courseData != NULL && CoursePackInit(&coursePack, courseData, (unsigned int)dataSize) && coursePack.holeCount > 0) {
+        courseId = ScoreCacheGetCourseId(courseData, (unsigned int)dataSize);
+        TraceLog(LOG_INFO, "COURSE: [%s] Loaded %i holes", fileName, coursePack.holeCount);
+    } else {
+        if (courseData != NULL) TraceLog(LOG_WARNING, "COURSE: [%s] Invalid or unsupported course file", fileName);
+        UnloadFileDataMapped(courseData);
+        courseData = NULL;
+        coursePack = (CoursePack){ 0 };
+    }
 }
 
+// Background tiles of an authored hole, holes without them (and random holes) stretch the bg sprite
+void LoadHoleTiles(int holeIndex) {
+    if (holeIndex >= 0) CourseTilesLoad(&courseTiles, TextFormat("courses/tiles/hole%02i", holeIndex));
+    else CourseTilesUnload(&courseTiles);
+}
+
+// Selects the next authored hole, or a random hole without a course
+void NextHole(void) {
+    if (coursePack.holeCount > 0) {
+        currentHole = (currentHole + 1) % coursePack.holeCount;
+        CourseHole hole = CoursePackGetHole(&coursePack, currentHole);
+
+        ballStart = hole.start;
+        courseSize = hole.size;
+        world.hole = hole.cup;
+        PhysicsSetGeometry(&world, hole.geometry);
+        LoadHoleTiles(currentHole);
+    } else {
+        // Move the hole to a new random location first!
+        GenerateNewHolePosition();
+        LoadHoleTiles(-1);
+    }
+}
+
+// Playfield follows the screen (orientation changes), unless the hole has its own size
+void UpdatePlayfieldSize(void) {
+    world.width = (courseSize.x > 0.0f)? courseSize.x : (float)GetScreenWidth();
+    world.height = (courseSize.y > 0.0f)? courseSize.y : (float)GetScreenHeight();
+}
+
+// Idle redraw: once nothing moves and no finger is down, frames only start on input (event waiting)
+// NOTE: The last frame drawn stays on screen, the GPU and the CPU sleep until the next touch
+// (not in multiplayer: the socket is polled by the frames, the opponent ball moves on its own)
+void UpdateIdleRedraw(void) {
+    static double lastActivity = 0.0;
+
+    bool active = dragging || multiplayer.enabled || videoExport.active || IsParticleSystemActive(&particles) || IsCourseCameraMoving(&courseCamera) ||
+                  CourseTilesIsBusy(&courseTiles) || (GetTouchPointCount() > 0) || IsWindowResized() || IsProfilerOverlayEnabled() ||
+                  IsMouseButtonPressed(MOUSE_LEFT_BUTTON) || IsMouseButtonReleased(MOUSE_LEFT_BUTTON);
+    for (int i = 0; !active && (i < world.ballCount); i++) {
+        active = !world.balls.sunk[i] && !PhysicsIsBallStopped(&world, i);
+    }
+
+    if (active) lastActivity = GetTime();
+
+    if (GetTime() - lastActivity >= IDLE_REDRAW_DELAY) EnableEventWaiting();
+    else DisableEventWaiting();
+}
+
+// Trail behind the rolling ball, and sand kicked up where it lands in a bunker
+void UpdateBallParticles(Vector2 ball) {
+    static Vector2 lastPosition = { 0.0f, 0.0f };
+    static float trailCarry = 0.0f;
+    static bool wasInSand = false;
+
+    Vector2 velocity = PhysicsGetBallVelocity(&world, player.ball);
+    float speed = Vector2Length(velocity);
+    bool placed = Vector2Distance(lastPosition, ball) > BALL_MAX_FRAME_TRAVEL;
+    bool inSand = !player.holed && (PhysicsGetSurfaceFriction(&world, ball) < PARTICLE_SAND_FRICTION);
+
+    if (placed || player.holed || (speed < PARTICLE_TRAIL_MIN_SPEED)) trailCarry = 0.0f;
+    else EmitTrail(&particles, lastPosition, ball, &trailCarry);
+
+    if (inSand && !wasInSand && !placed && (speed > 0.0f)) EmitSandSplash(&particles, ball, Vector2Scale(velocity, 1.0f/speed));
+
+    lastPosition = ball;
+    wasInSand = inSand;
+}
+
+// Starts recording the round on the current hole
+// NOTE: A video of the last round still being exported is dropped, it is drawn with the course of its hole
+void BeginRoundRecording(void) {
+    VideoExportCancel(&videoExport);
+    videoExport.saved = false;
+    UpdatePlayfieldSize();
+
+    ReplayRoundInfo info = { 0 };
+    info.tickRate = world.tickRate;
+    info.holeIndex = (coursePack.holeCount > 0)? currentHole : -1;
+    info.start = ballStart;
+    info.cup = world.hole;
+    info.size = (Vector2){ world.width, world.height };
+    ReplayBeginRound(&replay, &info, world.tick);
+    MultiplayerBeginRound(&multiplayer, &info, world.tick, world.geometry);
+}
+
+// Keeps the round just played in app storage, and in the score cache for authored holes (a better score
+// becomes the hole ghost)
+// NOTE: Written in background (WriteToAppStorageAsync()), holing out never waits for the disk
+void SaveLastRound(void) {
+    static unsigned char data[REPLAY_MAX_ROUND_SIZE];
+
+    unsigned int size = ReplayGetRound(&replay, 0, data, sizeof(data));
+    if (size == 0) return;
+    WriteToAppStorageAsync("last_round.rpl", data, size);
+
+    if (coursePack.holeCount == 0) return;
+    ScoreCacheRecord key = { .courseId = courseId, .hole = (int16_t)currentHole, .kind = SCORE_CACHE_REPLAY, .score = player.strokes };
+    ScoreCachePut(&scoreCache, &key, data, size);
+
+    const ScoreCacheRecord *ghost = ScoreCacheFind(&scoreCache, courseId, currentHole, SCORE_CACHE_GHOST, 0);
+    if ((ghost == NULL) || (player.strokes < ghost->score)) {
+        key.kind = SCORE_CACHE_GHOST;
+        if (ScoreCachePut(&scoreCache, &key, data, size)) TraceLog(LOG_INFO, "SCORES: Hole %i personal best, %i strokes", currentHole + 1, player.strokes);
+    }
+}
+
+// Re-simulates the round just recorded and checks it ends with the same score
+void VerifyLastReplay(void) {
+    static unsigned char data[REPLAY_MAX_ROUND_SIZE];
+    static PhysicsWorld replayWorld = { 0 };
+    ReplayPlayback playback = { 0 };
+
+    unsigned int size = ReplayGetRound(&replay, 0, data, sizeof(data));
+    if (size == 0 || !ReplayPlaybackStart(&playback, data, size, &replayWorld, world.geometry)) return;
+
+    double startTime = GetTime();
+    int ticks = 0;
+    while (!playback.finished) ticks += ReplayPlaybackAdvance(&playback, &replayWorld, 1024);
+    double elapsed = GetTime() - startTime;
+
+    TraceLog((playback.player.strokes == player.strokes)? LOG_INFO : LOG_WARNING,
+             "REPLAY: Round kept in %u bytes, %i ticks re-simulated in %.2f ms (%.0fx real time), strokes %i/%i",
+             size, ticks, elapsed*1000.0, (elapsed > 0.0)? (double)ticks/replayWorld.tickRate/elapsed : 0.0,
+             playback.player.strokes, player.strokes);
+}
+
+// One frame of the last round, drawn into the video encoder (see videoexport.h)
+void DrawReplayFrame(const PhysicsWorld *replayWorld, const GolfPlayer *replayPlayer, Camera2D camera, Vector2 videoSize) {
+    const float ballVisualScale = 3.0f;
+
+    // NOTE: The static layer only holds the course around the game camera, the video view is drawn as it goes
+    BeginMode2D(camera);
+    DrawStaticScene(GetCameraView(camera, videoSize));
+
+    // NOTE: Frames fall on ticks, the ball is drawn where the tick left it (no interpolation)
+    if (!replayPlayer->holed) {
+        Vector2 position = PhysicsGetBallPosition(replayWorld, replayPlayer->ball);
+        for (int pass = 0; pass < 2; pass++) {
+            Sprite sprite = (pass == 0)? ball_shadow : ball_sprite;
+            float offset = (pass == 0)? SHADOW_OFFSET * ballVisualScale : 0.0f;
+            if (sprite.texture.id == 0) continue;
+
+            Vector2 drawPos = {
+                position.x - (sprite.source.width * ballVisualScale) / 2.0f + offset,
+                position.y - (sprite.source.height * ballVisualScale) / 2.0f + offset
+            };
+            DrawSpriteEx(sprite, drawPos, ballVisualScale, WHITE);
+        }
+        if (ball_sprite.texture.id == 0) DrawCircleV(position, BALL_RADIUS, WHITE);
+    }
+    EndMode2D();
+
+    char strokeText[32];
+    snprintf(strokeText, sizeof(strokeText), "STROKES: %d", replayPlayer->strokes);
+    const TextRun *strokeRun = GetTextRun(&hudText, gameFont.font, strokeText, VIDEO_FONT_SIZE, 0.0f);
+    DrawWiiSportsText(strokeRun, (Vector2){ videoSize.x - strokeRun->size.x - 20.0f - SHADOW_OFFSET, 20.0f }, BLACK, WHITE);
+}
 
 // Function to reset the game state
 void ResetGame(void) {
-    // Move the hole to a new random location first!
-    GenerateNewHolePosition();
+    NextHole();
 
     // Reset ball position and state
-    ball = (Vector2){100.0f, 500.0f};
-    velocity = (Vector2){0.0f, 0.0f};
-    strokes = 0;
-    holeInOne = false;
+    GolfPlayerStart(&player, &world, ballStart);
+    BeginRoundRecording();
+    CourseCameraReset(&courseCamera);
+    dragging = false;
+    dragStart = (Vector2){ 0.0f, 0.0f };
+}
+
+// Multiplayer guest: plays the hole the host started, an authored hole by index, a random one as drawn
+// NOTE: Same playfield size as the host, the opponent ball must bounce off the same edges
+void JoinHostRound(const ReplayRoundInfo *info) {
+    if (info->holeIndex >= 0 && info->holeIndex < coursePack.holeCount) {
+        currentHole = info->holeIndex;
+        PhysicsSetGeometry(&world, CoursePackGetHole(&coursePack, currentHole).geometry);
+        LoadHoleTiles(currentHole);
+    } else {
+        if (info->holeIndex >= 0) TraceLog(LOG_WARNING, "MULTIPLAYER: Host hole %i is not in the local course, played without obstacles", info->holeIndex);
+        PhysicsSetGeometry(&world, (PhysicsGeometry){ 0 });
+        LoadHoleTiles(-1);
+    }
+    ballStart = info->start;
+    courseSize = info->size;
+    world.hole = info->cup;
+
+    GolfPlayerStart(&player, &world, ballStart);
+    BeginRoundRecording();
+    CourseCameraReset(&courseCamera);
     dragging = false;
     dragStart = (Vector2){ 0.0f, 0.0f };
 }
 
+// Sprites come from the atlas, or one texture each when it is missing
+void LoadSprites(void) {
+    if (atlas.texture.id != 0) SetShapesTextureAtlas(&atlas);
+
+    // NOTE: Without the atlas the pngs are decoded in parallel, then uploaded in a row
+    const char *names[] = {
+        "bg", "ball", "ball_shadow", "hole", "point", "settings",
+        "powermeter_bg", "powermeter_fg", "powermeter_overlay"      // Power Meter Assets
+    };
+    Sprite *targets[] = {
+        &background, &ball_sprite, &ball_shadow, &hole_sprite, &arrow_sprite, &settings_sprite,
+        &power_bg, &power_fg, &power_overlay
+    };
+    const int count = sizeof(names)/sizeof(names[0]);
+
+    Sprite loaded[sizeof(names)/sizeof(names[0])];
+    LoadAtlasSprites(&atlas, names, count, loaded);
+    for (int i = 0; i < count; i++) *targets[i] = loaded[i];
+}
+
+// New GL context: atlas and font were loaded again (gpuresources.h), everything else made from them follows
+// NOTE: Old ids are dropped, the cached text runs and the static layer refer to the lost textures
+void RestoreGameResources(void *context) {
+    (void)context;
+    LoadSprites();
+    VideoExportCancel(&videoExport);
+    SpriteBatchRestore(&sprites);
+    StaticLayerRestore(&staticLayer);
+    CourseTilesRestore(&courseTiles);
+    TerrainTextureRestore(&terrainTexture);
+    DynamicResolutionRestore(&dynres);
+    UnloadTextCache(&hudText);
+}
+
+// Memory running low (raylib RequestMemoryTrim()): the HUD caches are CPU copies, rebuilt when next drawn
+// NOTE: The course tile cache goes too, the static layer keeps the tiles already drawn into it
+void TrimGameMemory(int level) {
+    (void)level;
+    UnloadTextCache(&hudText);
+    UnloadShapeCache(&hudShapes);
+    CourseTilesTrim(&courseTiles);
+}
+
 int main(void)
 {
     const float FONT_SIZE_LG = 64.0f;
     const float FONT_SIZE_SM = 32.0f;
     // Power meter scale factor for resizing (2x bigger)
     const float POWER_METER_SCALE = 2.0f;
+    const int TARGET_FPS = 60;
+    // Characters of the HUD texts, the only ones baked into the font atlas ('?' is drawn for others)
+    const char *HUD_GLYPHS = " !?-.:%/0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
 
     // 👑 Let's go true fullscreen on mobile
     // Request HighDPI (native resolution) and allow resizing for orientation changes.
     SetConfigFlags(FLAG_WINDOW_HIGHDPI | FLAG_WINDOW_RESIZABLE);
 
+    // Java method IDs resolved once, the game thread then stays attached for raymob calls
+    InitJNICache();
+
+    // Linked shader programs (default, sprite and SDF text) are kept in the app cache directory,
+    // later launches and new GL contexts load them instead of compiling the shader code again
+    char *cacheDir = GetCacheDir();
+    SetShaderCacheDirectory(cacheDir);
+    MemFree(cacheDir);
+
+    // Saves go through a background writer, flushed to disk when the activity pauses
+    InitAppStorageWriter();
+    ScoreCacheOpen(&scoreCache);
+    InitCallBacks();
+    SetOnPauseCallBack(FlushAppStorage);
+    SetMemoryTrimCallback(TrimGameMemory);
+
     // The WindowShouldClose logic will check for the Android back button too!
     // Initialize with 0,0 to use the full screen resolution automatically.
     InitWindow(0, 0, "Mini Golf (Mobile)");
-    SetTargetFPS(60);
+    // NOTE: Gameplay does not depend on this, physics always runs at PHYSICS_TICK_RATE,
+    // so weak devices can lower it without changing how far a shot goes
+    SetTargetFPS(TARGET_FPS);
+
+    // Low-latency output, impact sounds are synthesized at startup (see feedback.h)
+    InitAudioDevice();
+    ImpactFeedbackInit(&feedback);
 
     // IMPORTANT: Seed the random number generator only once
     SetRandomSeed(GetTime());
 
     // --- LOAD ASSETS (PATHS ARE ALREADY FIXED) ---
-    background    = LoadTexture("gfx/bg.png");
-    ball_sprite   = LoadTexture("gfx/ball.png");
-    ball_shadow   = LoadTexture("gfx/ball_shadow.png");
-    hole_sprite   = LoadTexture("gfx/hole.png");
-    arrow_sprite  = LoadTexture("gfx/point.png");
-    settings_sprite = LoadTexture("gfx/settings.png");
-
-    // Load Power Meter Assets
-    power_bg      = LoadTexture("gfx/powermeter_bg.png");
-    power_fg      = LoadTexture("gfx/powermeter_fg.png");
-    power_overlay = LoadTexture("gfx/powermeter_overlay.png");
-
-    // Load Custom Font
-    gameFont      = LoadFontEx("font/rodin.otf", (int)FONT_SIZE_LG, NULL, 0);
+    // Files are read from data.pak when it is shipped (tools/assetpack), from the loose assets otherwise
+    // NOTE: Startup steps are timeline sections, logged with the first presented frame (and traced for Perfetto)
+    BeginTimelineSection("LoadAssetPack");
+    LoadAssetPack("data.pak");
+    EndTimelineSection("LoadAssetPack");
+
+    // Atlas and font are decoded on a worker thread, the loading screen shows until they are uploaded
+    BeginTimelineSection("loading_screen");
+    AssetLoaderInit(&assets);
+    LoadSpriteAtlasAsync(&assets, &atlas, "gfx/atlas.png", "gfx/atlas.bin");
+    LoadSdfFontAsync(&assets, &gameFont, "font/rodin.otf", HUD_GLYPHS, (int)FONT_SIZE_LG);
+
+    while (!IsAssetLoaderDone(&assets) && !WindowShouldClose())
+    {
+        AssetLoaderUpdate(&assets, ASSET_UPLOAD_BUDGET_MS);
+
+        BeginDrawing();
+        DrawLoadingScreen(GetAssetLoaderProgress(&assets));
+        EndDrawing();
+    }
+    AssetLoaderUnload(&assets);
+    EndTimelineSection("loading_screen");
+
+    BeginTimelineSection("SpriteBatchInit");
+    SpriteBatchInit(&sprites);
+    EndTimelineSection("SpriteBatchInit");
+    LoadSprites();
+    ParticlesInit(&particles);
+
+    // Everything on the GPU is loaded again if the system drops the GL context while in background
+    InitGpuResources();
+    if (atlas.texture.id != 0) RegisterTextureResource(&atlas.texture, "gfx/atlas.png");
+    RegisterSdfFontResource(&gameFont, "font/rodin.otf", HUD_GLYPHS, (int)FONT_SIZE_LG);
+    RegisterGpuRestoreCallback(RestoreGameResources, NULL);
     // ----------------------------------------------------
 
     // Check for load errors (These will now tell us if the new paths worked)
-    if (background.id == 0 || ball_sprite.id == 0 || arrow_sprite.id == 0) {
+    if (background.texture.id == 0 || ball_sprite.texture.id == 0 || arrow_sprite.texture.id == 0) {
         TraceLog(LOG_WARNING, "One or more assets failed to load with new paths! Check 'gfx/' and 'font/' directories.");
     }
-    if (gameFont.texture.id == 0) {
+    if (gameFont.font.texture.id == GetFontDefault().texture.id) {
         TraceLog(LOG_WARNING, "Custom font failed to load. Using default font.");
-        gameFont = GetFontDefault();
     }
     // ----------------------------------------------------
 
-    const float MAX_DRAG_DISTANCE = 200.0f;
     const float ARROW_SCALE = 1.5f;
-    const float MAX_VELOCITY = 15.0f;
+
+    // Initialize the fixed-step simulation
+    PhysicsInit(&world, PHYSICS_TICK_RATE);
+    BeginTimelineSection("LoadCourse");
+    LoadCourse("courses/holes.bin");
+    EndTimelineSection("LoadCourse");
 
     // Initial call to set the hole position when the game starts (now dynamic)
-    GenerateNewHolePosition();
+    NextHole();
+    player.ball = PhysicsAddBall(&world, ballStart);
+    GolfPlayerStart(&player, &world, ballStart);
+    ReplayRecorderInit(&replay);
+    MultiplayerInit(&multiplayer);
+    BeginRoundRecording();
+    // Camera placed on the ball before the first touch is mapped through it
+    CourseCameraUpdate(&courseCamera, &world, ballStart, (Vector2){ (float)GetScreenWidth(), (float)GetScreenHeight() }, 1.0f, 0.0f);
+    DynamicResolutionInit(&dynres, TARGET_FPS);
+    QualityGovernorInit(&governor, TARGET_FPS);
+    MarkTimelineEvent("game_ready");
 
     while (!WindowShouldClose())
     {
+        // Multiplayer guest: holes follow the host
+        ReplayRoundInfo hostRound = { 0 };
+        if (MultiplayerTakeRound(&multiplayer, world.tick, &hostRound)) JoinHostRound(&hostRound);
+
+        UpdatePlayfieldSize();
+
         // Check if the ball has stopped (used to determine if a new shot is allowed)
-        bool ballStopped = Vector2LengthSqr(velocity) < 0.1f;
+        bool ballStopped = GolfCanShoot(&player, &world);
 
         // --- Input Handling ---
-        if (holeInOne && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+        // Double tap on the settings icon toggles the frame profiler overlay
+        if (IsGestureDetected(GESTURE_DOUBLETAP) &&
+            CheckCollisionPointRec(GetTouchPosition(0), (Rectangle){ 20, 20, 32, 32 })) {
+            SetProfilerOverlay(!IsProfilerOverlayEnabled());
+        }
+
+        if (player.holed && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
             // Check for Play Again Button Click
             Vector2 mouse = GetMousePosition();
             float buttonWidth = 200.0f;
@@ -173,193 +619,213 @@ int main(void)
                     buttonWidth,
                     buttonHeight
             };
-            if (CheckCollisionPointRec(mouse, buttonRec)) {
+            Rectangle videoButtonRec = { buttonRec.x, buttonRec.y + buttonHeight + 20.0f, buttonWidth, buttonHeight };
+            if (CheckCollisionPointRec(mouse, buttonRec) && !IsMultiplayerGuest(&multiplayer)) {
                 // IMPORTANT: Use GetScreenWidth/Height for mobile
                 ResetGame(); // Call updated ResetGame (no arguments)
+            } else if (CheckCollisionPointRec(mouse, videoButtonRec) && !videoExport.active && !videoExport.saved) {
+                VideoExportStart(&videoExport, &replay, world.geometry, "last_round.mp4");
             }
-        } else if (!holeInOne) {
+        } else if (!player.holed) {
             // Normal game input
+            // NOTE: The ball is picked in world coordinates, the shot is the drag on screen (same scale, the camera doesn't zoom)
             if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) &&
-                Vector2Distance(GetMousePosition(), ball) < (BALL_RADIUS * 1.5f) &&
+                Vector2Distance(GetScreenToWorld2D(GetMousePosition(), courseCamera.camera), PhysicsGetBallPosition(&world, player.ball)) < (BALL_RADIUS * 1.5f) &&
                 ballStopped) {
                 dragging = true;
                 dragStart = GetMousePosition();
+                dragPointer = GetTouchPointId(0);
+                TrajectoryPreviewReset(&preview);
             }
 
-            if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON) && dragging) {
-                Vector2 dragEnd = GetMousePosition();
-
-                Vector2 shootVector = Vector2Subtract(dragStart, dragEnd);
-                float dragDistance = Vector2Length(shootVector);
+            // The dragging finger lifting ends the drag, even with another finger still down,
+            // at its exact lift-off position (the mouse follows touch point 0, whichever finger it is)
+            TouchSample lastSample = { 0 };
+            bool lifted = dragging && (GetTouchHistory(dragPointer, &lastSample, 1) == 1) && (lastSample.action == TOUCH_SAMPLE_UP);
 
-                float powerScalar = fminf(dragDistance / MAX_DRAG_DISTANCE, 1.0f);
+            if ((IsMouseButtonReleased(MOUSE_LEFT_BUTTON) || lifted) && dragging) {
+                Vector2 dragEnd = lifted? lastSample.position : GetMousePosition();
 
-                velocity.x += shootVector.x * 0.15f * powerScalar;
-                velocity.y += shootVector.y * 0.15f * powerScalar;
+                Vector2 shootVector = Vector2Subtract(dragStart, dragEnd);
+                Vector2 shotPosition = PhysicsGetBallPosition(&world, player.ball);
+                if (PhysicsGetSurfaceFriction(&world, shotPosition) < PARTICLE_SAND_FRICTION) EmitSandSplash(&particles, shotPosition, Vector2Normalize(shootVector));
+                ReplayRecordShot(&replay, world.tick, shootVector);
+                MultiplayerRecordShot(&multiplayer, world.tick, shootVector);
+                GolfShoot(&player, &world, shootVector);
 
                 dragging = false;
-                strokes++;
             }
         }
 
         // --- Physics Update ---
-        if (!holeInOne) {
-            // 1. Gravity Well Effect (Sinking)
-            float distToHole = Vector2Distance(ball, hole);
-            if (distToHole < SINK_DISTANCE) {
-                // Direction vector from ball to hole
-                Vector2 direction = Vector2Normalize(Vector2Subtract(hole, ball));
-
-                // Add velocity to pull the ball towards the center
-                velocity = Vector2Add(velocity, Vector2Scale(direction, SINK_PULL));
-
-                // When very close and moving slowly, snap it in (Win condition)
-                if (distToHole < 5.0f && Vector2LengthSqr(velocity) < 1.0f) {
-                    holeInOne = true;
-                    ball = hole; // Snap to center
-                    velocity = (Vector2){0.0f, 0.0f};
+        // Fixed-step: consume this frame's time in PHYSICS_TICK_RATE ticks, leftover carries over
+        // Rules apply the water penalty and detect the ball holing out after every tick, as replays and
+        // netplay re-simulate them (a reset on a later tick would play a different round)
+        // NOTE: Ticks still run after holing out in multiplayer, they are the opponent clock
+        int ticks = 0;
+        if (!player.holed || multiplayer.enabled) {
+            bool splashed = false, holedOut = false;
+            Vector2 splash = { 0.0f, 0.0f };
+            unsigned int holedTick = 0;
+
+            BeginProfilerPhase(PROFILER_PHASE_PHYSICS);
+            ticks = PhysicsBeginFrame(&world, GetFrameTime());
+            for (int i = 0; i < ticks; i++) {
+                PhysicsStep(&world);
+                // Where the ball fell in, before the rules put it back
+                if (world.balls.inHazard[player.ball]) {
+                    splashed = true;
+                    splash = PhysicsGetBallPosition(&world, player.ball);
+                }
+                if (GolfUpdate(&player, &world)) {
+                    holedOut = true;
+                    holedTick = world.tick;
                 }
             }
-
-            // 2. Hard Velocity Cap
-            float currentSpeed = Vector2Length(velocity);
-            if (currentSpeed > MAX_VELOCITY) {
-                velocity = Vector2Scale(Vector2Normalize(velocity), MAX_VELOCITY);
+            EndProfilerPhase(PROFILER_PHASE_PHYSICS);
+            ImpactFeedbackUpdate(&feedback, &world);
+
+            if (splashed) EmitWaterSplash(&particles, splash);
+            if (holedOut) {
+                EmitConfetti(&particles, GetWorldToScreen2D(world.hole, courseCamera.camera));
+                ReplayEndRound(&replay, holedTick);
+                VerifyLastReplay();
+                SaveLastRound();
             }
+        }
+        MultiplayerUpdate(&multiplayer, &world, &player, ticks);
 
-            // 3. Movement and Friction
-            ball = Vector2Add(ball, velocity);
+        // Predicted path for the current drag (cached, and spread over frames when long)
+        if (dragging) TrajectoryPreviewUpdate(&preview, &world, player.ball, Vector2Subtract(dragStart, GetMousePosition()));
 
-            // Friction (slowing down)
-            velocity = Vector2Scale(velocity, 0.95f);
+        // Ball drawn between the last two ticks, so motion stays smooth at any frame rate
+        Vector2 ball = PhysicsGetRenderPosition(&world, player.ball);
+        UpdateBallParticles(ball);
 
-            // 4. Boundary Bounce (Ball must stay within screen edges)
-            // Left boundary check
-            if(ball.x < BALL_RADIUS) {
-                velocity.x *= -0.8f; // Reverse direction and dampen velocity (bounce)
-                ball.x = BALL_RADIUS; // Snap position back to the edge
-            }
-                // Right boundary check
-            else if (ball.x > GetScreenWidth() - BALL_RADIUS) {
-                velocity.x *= -0.8f;
-                ball.x = GetScreenWidth() - BALL_RADIUS;
-            }
+        // Camera after the ball, everything in the world is culled against its view
+        Vector2 screenSize = { (float)GetScreenWidth(), (float)GetScreenHeight() };
+        CourseCameraUpdate(&courseCamera, &world, ball, screenSize, 1.0f, GetFrameTime());
+        Rectangle view = GetCameraView(courseCamera.camera, screenSize);
 
-            // Top boundary check
-            if(ball.y < BALL_RADIUS) {
-                velocity.y *= -0.8f;
-                ball.y = BALL_RADIUS;
-            }
-                // Bottom boundary check
-            else if (ball.y > GetScreenHeight() - BALL_RADIUS) {
-                velocity.y *= -0.8f;
-                ball.y = GetScreenHeight() - BALL_RADIUS;
-            }
-        }
+        // Static layer follows hole changes (ResetGame()), screen resizes and the camera scrolling past it
+        TerrainTextureUpdate(&terrainTexture, &world.geometry.terrain);
+        StaticLayerUpdate(&staticLayer, &world, view, GetCupSize(), DrawStaticScene);
+        VideoExportUpdate(&videoExport, DrawReplayFrame);
 
+        // Background tiles decoded since the last frame, drawn into the layer where they fall
+        CourseTilesUpdate(&courseTiles, staticLayer.area);
+        for (int i = 0; i < courseTiles.arrivedCount; i++) StaticLayerRedrawRegion(&staticLayer, courseTiles.arrived[i], DrawStaticScene);
+        QualityGovernorUpdate(&governor, &dynres);
+        DynamicResolutionUpdate(&dynres);
+        ParticlesUpdate(&particles, GetFrameTime(), QualityGovernorGetLevel(&governor)->particleScale);
+        UpdateIdleRedraw();
 
         // ----------------------------------------------------
         // --- DRAWING SECTION ---
         // ----------------------------------------------------
         BeginDrawing();
 
-        // 1. Draw the Background and Hole
-        if (background.id != 0) {
-            Rectangle sourceRec = { 0.0f, 0.0f, (float)background.width, (float)background.height };
-            // Use GetScreenWidth() and GetScreenHeight() for destination
-            Rectangle destRec = { 0.0f, 0.0f, (float)GetScreenWidth(), (float)GetScreenHeight() };
-            DrawTexturePro(background, sourceRec, destRec, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
-        } else {
-            ClearBackground(GREEN);
-        }
-
-        float holeVisualScale = 3.0f;
-        if (hole_sprite.id != 0) {
-            Vector2 holeDrawPos = {
-                hole.x - (hole_sprite.width * holeVisualScale) / 2.0f,
-                hole.y - (hole_sprite.height * holeVisualScale) / 2.0f
-            };
-            DrawTextureEx(hole_sprite, holeDrawPos, 0.0f, holeVisualScale, WHITE);
-        } else {
-            DrawCircleV(hole, 40.0f, DARKGRAY);
-        }
-
-        // 2. Draw the Ball
-        if (!holeInOne) {
-            float ballVisualScale = 3.0f;
-            // Shadow
-            if (ball_shadow.id != 0) {
-                 Vector2 shadowDrawPos = {
-                    ball.x - (ball_shadow.width * ballVisualScale) / 2.0f + (SHADOW_OFFSET * ballVisualScale),
-                    ball.y - (ball_shadow.height * ballVisualScale) / 2.0f + (SHADOW_OFFSET * ballVisualScale)
+        // World (1-3) at the dynamic render scale through the course camera, HUD (4-7) at native resolution
+        DynamicResolutionBegin(&dynres);
+        BeginMode2D(courseCamera.camera);
+
+        // 1. Background, course and hole (cached, redrawn only when the hole, the screen or the view changes)
+        StaticLayerDraw(&staticLayer);
+
+        // Trail and splashes under the balls
+        ParticlesDraw(&particles, PARTICLE_LAYER_WORLD, &sprites, view);
+
+        // 2. Draw the Balls (shadows first, then sprites, one instanced draw call each when available)
+        const float ballVisualScale = 3.0f;
+        for (int pass = 0; pass < 2; pass++) {
+            Sprite sprite = (pass == 0)? ball_shadow : ball_sprite;
+            float offset = (pass == 0)? SHADOW_OFFSET * ballVisualScale : 0.0f;
+            if (sprite.texture.id == 0) continue;
+
+            // NOTE: The opponent ball comes last, from its own world (see multiplayer.h)
+            int ballCount = world.ballCount + (multiplayer.connected? 1 : 0);
+            SpriteBatchBegin(&sprites, sprite.texture);
+            for (int i = 0; i < ballCount; i++) {
+                bool opponent = (i == world.ballCount);
+                if (opponent? multiplayer.opponent.holed : (i == player.ball)? player.holed : world.balls.sunk[i]) continue;
+                Vector2 position = opponent? GetOpponentRenderPosition(&multiplayer, world.accumulator/world.dt) : PhysicsGetRenderPosition(&world, i);
+                Rectangle dest = {
+                    position.x - (sprite.source.width * ballVisualScale) / 2.0f + offset,
+                    position.y - (sprite.source.height * ballVisualScale) / 2.0f + offset,
+                    sprite.source.width * ballVisualScale,
+                    sprite.source.height * ballVisualScale
                 };
-                DrawTextureEx(ball_shadow, shadowDrawPos, 0.0f, ballVisualScale, WHITE);
+                if (!CheckCollisionRecs(dest, view)) continue;
+                SpriteBatchDraw(&sprites, sprite.source, dest, (Vector2){ 0.0f, 0.0f }, 0.0f, (opponent && pass == 1)? OPPONENT_TINT : WHITE);
             }
-            // Sprite
-            if (ball_sprite.id != 0) {
-                 Vector2 ballDrawPos = {
-                    ball.x - (ball_sprite.width * ballVisualScale) / 2.0f,
-                    ball.y - (ball_sprite.height * ballVisualScale) / 2.0f
-                };
-                DrawTextureEx(ball_sprite, ballDrawPos, 0.0f, ballVisualScale, WHITE);
-            } else {
-                DrawCircleV(ball, BALL_RADIUS, WHITE);
-            }
-        }
-
-        // 3. Draw Settings Button (Top Left)
-        if (settings_sprite.id != 0) {
-            // Draw 20px from top and left
-            DrawTexture(settings_sprite, 20, 20, WHITE);
-        } else {
-            // Fallback for settings icon
-            DrawRectangle(20, 20, 32, 32, GRAY);
+            SpriteBatchEnd(&sprites);
         }
+        if (ball_sprite.texture.id == 0 && !player.holed) DrawCircleCached(&hudShapes, ball, BALL_RADIUS, WHITE);
 
-
-        // 4. Draw Aiming Arrow and Power Meter (Bottom Left)
+        // 3. Draw Aiming Path and Arrow
         if (dragging)
         {
-            Vector2 mousePos = GetMousePosition();
-            Vector2 shootVector = Vector2Subtract(dragStart, mousePos);
+            Vector2 shootVector = Vector2Subtract(dragStart, GetMousePosition());
             float dragDistance = Vector2Length(shootVector);
-            // NOTE: fminf ensures the power ratio doesn't exceed 1.0f (100%)
-            float powerRatio = fminf(dragDistance / MAX_DRAG_DISTANCE, 1.0f);
+
+            // PREDICTED PATH DRAWING
+            TrajectoryPreviewDraw(&preview, WHITE);
 
             // ARROW DRAWING
-            if (arrow_sprite.id != 0) {
+            if (arrow_sprite.texture.id != 0) {
                 Vector2 shotDirection = Vector2Normalize(shootVector);
                 float angle = atan2f(shootVector.y, shootVector.x) * RAD2DEG + 90.0f;
                 float offset = fminf(dragDistance * 0.1f + 5.0f, 40.0f);
                 Vector2 arrowDrawPos = Vector2Add(ball, Vector2Scale(shotDirection, offset));
 
-                Rectangle arrowSource = { 0.0f, 0.0f, (float)arrow_sprite.width, (float)arrow_sprite.height };
-                Rectangle arrowDest = { arrowDrawPos.x, arrowDrawPos.y, (float)arrow_sprite.width * ARROW_SCALE, (float)arrow_sprite.height * ARROW_SCALE };
-                Vector2 origin = { (float)arrow_sprite.width * ARROW_SCALE / 2.0f, (float)arrow_sprite.height * ARROW_SCALE / 2.0f };
+                Rectangle arrowSource = { 0.0f, 0.0f, (float)arrow_sprite.source.width, (float)arrow_sprite.source.height };
+                Rectangle arrowDest = { arrowDrawPos.x, arrowDrawPos.y, (float)arrow_sprite.source.width * ARROW_SCALE, (float)arrow_sprite.source.height * ARROW_SCALE };
+                Vector2 origin = { (float)arrow_sprite.source.width * ARROW_SCALE / 2.0f, (float)arrow_sprite.source.height * ARROW_SCALE / 2.0f };
 
-                DrawTexturePro(arrow_sprite, arrowSource, arrowDest, origin, angle, WHITE);
+                DrawSpritePro(arrow_sprite, arrowSource, arrowDest, origin, angle, WHITE);
             }
+        }
+
+        EndMode2D();
+        DynamicResolutionEnd(&dynres);
+
+        // 4. Draw Settings Button (Top Left)
+        if (settings_sprite.texture.id != 0) {
+            // Draw 20px from top and left
+            DrawSpriteEx(settings_sprite, (Vector2){ 20.0f, 20.0f }, 1.0f, WHITE);
+        } else {
+            // Fallback for settings icon
+            DrawRectangle(20, 20, 32, 32, GRAY);
+        }
+
+
+        // 5. Draw Power Meter (Bottom Left)
+        if (dragging)
+        {
+            Vector2 shootVector = Vector2Subtract(dragStart, GetMousePosition());
+            // NOTE: Power ratio never exceeds 1.0f (100%)
+            float powerRatio = GolfGetShotPower(shootVector);
 
             // POWER METER DRAWING (Moved to bottom left and scaled)
             if (IsPowerMeterReady()) {
                 // Calculate new meter position for bottom left, considering scale
-                const int meterHeight = (int)((float)power_bg.height * POWER_METER_SCALE);
+                const int meterHeight = (int)((float)power_bg.source.height * POWER_METER_SCALE);
                 const int meterX = 20; // 20px margin from left
                 // Use GetScreenHeight() for accurate positioning on mobile
                 const int meterY = GetScreenHeight() - meterHeight - 20; // 20px margin from bottom
 
-                DrawTextureEx(power_bg, (Vector2){(float)meterX, (float)meterY}, 0.0f, POWER_METER_SCALE, WHITE);
+                DrawSpriteEx(power_bg, (Vector2){(float)meterX, (float)meterY}, POWER_METER_SCALE, WHITE);
 
-                float clippedHeight = (float)power_fg.height * powerRatio;
-                float skippedHeight = (float)power_fg.height - clippedHeight;
+                float clippedHeight = (float)power_fg.source.height * powerRatio;
+                float skippedHeight = (float)power_fg.source.height - clippedHeight;
 
-                Rectangle fgSource = { 0.0f, skippedHeight, (float)power_fg.width, clippedHeight };
+                Rectangle fgSource = { 0.0f, skippedHeight, (float)power_fg.source.width, clippedHeight };
 
                 // Draw foreground, accounting for scale and position shift
-                Vector2 fgDrawPos = {(float)meterX, (float)meterY + (float)power_bg.height * POWER_METER_SCALE - clippedHeight * POWER_METER_SCALE};
-                DrawTexturePro(power_fg, fgSource, (Rectangle){fgDrawPos.x, fgDrawPos.y, (float)power_fg.width * POWER_METER_SCALE, clippedHeight * POWER_METER_SCALE}, (Vector2){0.0f, 0.0f}, 0.0f, WHITE);
+                Vector2 fgDrawPos = {(float)meterX, (float)meterY + (float)power_bg.source.height * POWER_METER_SCALE - clippedHeight * POWER_METER_SCALE};
+                DrawSpritePro(power_fg, fgSource, (Rectangle){fgDrawPos.x, fgDrawPos.y, (float)power_fg.source.width * POWER_METER_SCALE, clippedHeight * POWER_METER_SCALE}, (Vector2){0.0f, 0.0f}, 0.0f, WHITE);
 
-                DrawTextureEx(power_overlay, (Vector2){(float)meterX, (float)meterY}, 0.0f, POWER_METER_SCALE, WHITE);
+                DrawSpriteEx(power_overlay, (Vector2){(float)meterX, (float)meterY}, POWER_METER_SCALE, WHITE);
 
             } else {
                 // Fallback for Power Meter: Draw a simple red bar (Scaled)
@@ -375,38 +841,47 @@ int main(void)
             }
         }
 
-        // 5. Draw Stroke Counter
+        // 6. Draw Stroke Counter
         char strokeText[32];
-        snprintf(strokeText, sizeof(strokeText), "STROKES: %d", strokes);
+        snprintf(strokeText, sizeof(strokeText), "STROKES: %d", player.strokes);
 
-        Vector2 textSize = MeasureTextEx(gameFont, strokeText, FONT_SIZE_SM, 0.0f);
+        const TextRun *strokeRun = GetTextRun(&hudText, gameFont.font, strokeText, FONT_SIZE_SM, 0.0f);
 
         // Calculation for X position: (Screen Width) - (Text Width) - (Margin: 20px) - (Shadow Offset: 3.0f)
-        float textX = (float)GetScreenWidth() - textSize.x - 20.0f - SHADOW_OFFSET;
+        float textX = (float)GetScreenWidth() - strokeRun->size.x - 20.0f - SHADOW_OFFSET;
         float textY = 20.0f; // 20px margin from top
 
-        DrawWiiSportsText(gameFont, strokeText, (Vector2){textX, textY}, FONT_SIZE_SM, 0.0f, BLACK, WHITE);
+        DrawWiiSportsText(strokeRun, (Vector2){textX, textY}, BLACK, WHITE);
+
+        // Opponent strokes below, while the opponent is there
+        if (multiplayer.connected) {
+            snprintf(strokeText, sizeof(strokeText), "OPPONENT: %d", multiplayer.opponent.strokes);
+            const TextRun *opponentRun = GetTextRun(&hudText, gameFont.font, strokeText, FONT_SIZE_SM, 0.0f);
+            DrawWiiSportsText(opponentRun, (Vector2){ (float)GetScreenWidth() - opponentRun->size.x - 20.0f - SHADOW_OFFSET, textY + strokeRun->size.y + 8.0f }, BLACK, OPPONENT_TINT);
+        }
 
 
-        // 6. Draw Win Condition Screen
-        if (holeInOne) {
+        // 7. Draw Win Condition Screen
+        if (player.holed) {
             // Dim the screen slightly
             DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), Fade(BLACK, 0.7f));
 
-            const char *winText = (strokes == 1) ? "HOLE-IN-ONE!!!" : "YOU DID IT!";
+            const char *winText = (player.strokes == 1) ? "HOLE-IN-ONE!!!" : "YOU DID IT!";
             char scoreText[64];
-            snprintf(scoreText, sizeof(scoreText), "Score: %d Strokes", strokes);
+            const ScoreCacheRecord *best = (coursePack.holeCount > 0)? ScoreCacheFind(&scoreCache, courseId, currentHole, SCORE_CACHE_GHOST, 0) : NULL;
+            if (best != NULL) snprintf(scoreText, sizeof(scoreText), "Score: %d Strokes - Best: %d", player.strokes, best->score);
+            else snprintf(scoreText, sizeof(scoreText), "Score: %d Strokes", player.strokes);
 
             // Title
-            Vector2 winTextSize = MeasureTextEx(gameFont, winText, FONT_SIZE_LG, 0.0f);
-            DrawWiiSportsText(gameFont, winText, (Vector2){GetScreenWidth() / 2.0f - winTextSize.x / 2.0f, GetScreenHeight() / 2.0f - 80.0f}, FONT_SIZE_LG, 0.0f, DARKGREEN, GREEN);
+            const TextRun *winRun = GetTextRun(&hudText, gameFont.font, winText, FONT_SIZE_LG, 0.0f);
+            DrawWiiSportsText(winRun, (Vector2){GetScreenWidth() / 2.0f - winRun->size.x / 2.0f, GetScreenHeight() / 2.0f - 80.0f}, DARKGREEN, GREEN);
 
             // Score
-            Vector2 scoreTextSize = MeasureTextEx(gameFont, scoreText, FONT_SIZE_SM, 0.0f);
-            DrawWiiSportsText(gameFont, scoreText, (Vector2){GetScreenWidth() / 2.0f - scoreTextSize.x / 2.0f, GetScreenHeight() / 2.0f + 20.0f}, FONT_SIZE_SM, 0.0f, BLACK, WHITE);
+            const TextRun *scoreRun = GetTextRun(&hudText, gameFont.font, scoreText, FONT_SIZE_SM, 0.0f);
+            DrawWiiSportsText(scoreRun, (Vector2){GetScreenWidth() / 2.0f - scoreRun->size.x / 2.0f, GetScreenHeight() / 2.0f + 20.0f}, BLACK, WHITE);
 
             // Play Again Button
-            const char *buttonText = "PLAY AGAIN";
+            const char *buttonText = IsMultiplayerGuest(&multiplayer)? "WAITING FOR HOST" : "PLAY AGAIN";
             float buttonWidth = 200.0f;
             float buttonHeight = 50.0f;
             Rectangle buttonRec = {
@@ -418,29 +893,67 @@ int main(void)
 
             // Check button hover/press state (optional but nice)
             Color buttonColor = IsMouseButtonDown(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(GetMousePosition(), buttonRec) ? DARKBROWN : BROWN;
-            DrawRectangleRounded(buttonRec, 0.5f, 10, buttonColor);
-            DrawRectangleRoundedLines(buttonRec, 0.5f, 10, BLACK);
-
-            Vector2 btnTxtSize = MeasureTextEx(gameFont, buttonText, FONT_SIZE_SM * 0.7f, 0.0f);
-            DrawTextEx(gameFont, buttonText, (Vector2){buttonRec.x + buttonRec.width / 2.0f - btnTxtSize.x / 2.0f, buttonRec.y + buttonRec.height / 2.0f - btnTxtSize.y / 2.0f}, FONT_SIZE_SM * 0.7f, 0.0f, WHITE);
+            DrawRectangleRoundedCached(&hudShapes, buttonRec, 0.5f, 10, buttonColor);
+            DrawRectangleRoundedLinesCached(&hudShapes, buttonRec, 0.5f, 10, 1.0f, BLACK);
+
+            const TextRun *buttonRun = GetTextRun(&hudText, gameFont.font, buttonText, FONT_SIZE_SM * 0.7f, 0.0f);
+            BeginSdfText(&gameFont, buttonRun->fontSize, (SdfTextStyle){ 0 });
+            DrawTextRun(buttonRun, (Vector2){buttonRec.x + buttonRec.width / 2.0f - buttonRun->size.x / 2.0f, buttonRec.y + buttonRec.height / 2.0f - buttonRun->size.y / 2.0f}, WHITE);
+            EndSdfText(&gameFont);
+
+            // Save Video Button (exported while the win screen is shown)
+            char videoText[32];
+            if (videoExport.active) snprintf(videoText, sizeof(videoText), "SAVING VIDEO %d%%", (int)(GetVideoExportProgress(&videoExport) * 100.0f));
+            else snprintf(videoText, sizeof(videoText), "%s", videoExport.saved? "VIDEO SAVED" : "SAVE VIDEO");
+
+            Rectangle videoButtonRec = { buttonRec.x, buttonRec.y + buttonHeight + 20.0f, buttonWidth, buttonHeight };
+            DrawRectangleRoundedCached(&hudShapes, videoButtonRec, 0.5f, 10, (videoExport.active || videoExport.saved)? GRAY : BROWN);
+            DrawRectangleRoundedLinesCached(&hudShapes, videoButtonRec, 0.5f, 10, 1.0f, BLACK);
+
+            const TextRun *videoRun = GetTextRun(&hudText, gameFont.font, videoText, FONT_SIZE_SM * 0.7f, 0.0f);
+            BeginSdfText(&gameFont, videoRun->fontSize, (SdfTextStyle){ 0 });
+            DrawTextRun(videoRun, (Vector2){videoButtonRec.x + videoButtonRec.width / 2.0f - videoRun->size.x / 2.0f, videoButtonRec.y + videoButtonRec.height / 2.0f - videoRun->size.y / 2.0f}, WHITE);
+            EndSdfText(&gameFont);
         }
 
+        // 8. Confetti over everything
+        ParticlesDraw(&particles, PARTICLE_LAYER_OVERLAY, &sprites, (Rectangle){ 0.0f, 0.0f, screenSize.x, screenSize.y });
 
         EndDrawing();
         // ----------------------------------------------------
     }
 
     // --- UNLOAD ASSETS ---
-    UnloadTexture(background);
-    UnloadTexture(ball_sprite);
-    UnloadTexture(ball_shadow);
-    UnloadTexture(hole_sprite);
-    UnloadTexture(arrow_sprite);
-    UnloadTexture(settings_sprite);
-    UnloadTexture(power_bg);
-    UnloadTexture(power_fg);
-    UnloadTexture(power_overlay);
-    UnloadFont(gameFont);
+    VideoExportCancel(&videoExport);
+    UnloadGpuResources();
+    UnloadSprite(background, &atlas);
+    UnloadSprite(ball_sprite, &atlas);
+    UnloadSprite(ball_shadow, &atlas);
+    UnloadSprite(hole_sprite, &atlas);
+    UnloadSprite(arrow_sprite, &atlas);
+    UnloadSprite(settings_sprite, &atlas);
+    UnloadSprite(power_bg, &atlas);
+    UnloadSprite(power_fg, &atlas);
+    UnloadSprite(power_overlay, &atlas);
+    StaticLayerUnload(&staticLayer);
+    CourseTilesUnload(&courseTiles);
+    TerrainTextureUnload(&terrainTexture);
+    QualityGovernorUnload(&governor);
+    DynamicResolutionUnload(&dynres);
+    SpriteBatchUnload(&sprites);
+    SetShapesTexture((Texture2D){ 0 }, (Rectangle){ 0 });
+    UnloadSpriteAtlas(&atlas);
+    UnloadTextCache(&hudText);
+    UnloadShapeCache(&hudShapes);
+    UnloadSdfFont(&gameFont);
+    UnloadFileDataMapped(courseData);
+    ReplayRecorderFree(&replay);
+    MultiplayerUnload(&multiplayer);
+    UnloadAssetPack();
+    ScoreCacheClose(&scoreCache);
+    CloseAppStorageWriter();
+    ImpactFeedbackUnload(&feedback);
+    CloseAudioDevice();
 
     CloseWindow();
 
@@ -0,0 +1,248 @@
+#include "multiplayer.h"
+#include "raymob.h"
+#include <raymath.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MULTIPLAYER_MAX_RECEIVES    32      // Packets read per frame, later ones wait for the next frame
+
+// Settings read from MULTIPLAYER_CONFIG_FILE
+typedef struct MultiplayerConfig {
+    bool host;
+    char address[128];
+    int port;
+    unsigned int sessionId;
+} MultiplayerConfig;
+
+// Reads "host <port>" or "join <address> <port>", and "session <id>", one per line
+static bool LoadMultiplayerConfig(MultiplayerConfig *config)
+{
+    if (!IsFileExistsInAppStorage(MULTIPLAYER_CONFIG_FILE)) return false;
+
+    int size = 0;
+    char *data = ReadFromAppStorage(MULTIPLAYER_CONFIG_FILE, &size);
+    if (data == NULL) return false;
+
+    BeginScratchMemory();
+    char *text = MemAllocScratch(size + 1);
+    if (text == NULL) {
+        EndScratchMemory();
+        RL_FREE(data);
+        return false;
+    }
+    memcpy(text, data, size);
+    text[size] = '\0';
+    RL_FREE(data);
+
+    bool valid = false;
+    memset(config, 0, sizeof(MultiplayerConfig));
+    config->port = MULTIPLAYER_DEFAULT_PORT;
+    config->sessionId = MULTIPLAYER_DEFAULT_SESSION;
+
+    for (char *line = text; line != NULL; ) {
+        char *next = strchr(line, '\n');
+        if (next != NULL) *next++ = '\0';
+
+        if (strncmp(line, "host", 4) == 0) {
+            sscanf(line, "host %d", &config->port);
+            config->host = true;
+            valid = true;
+        }
+        else if ((strncmp(line, "join", 4) == 0) && (sscanf(line, "join %127s %d", config->address, &config->port) >= 1)) {
+            config->host = false;
+            valid = true;
+        }
+        else if (strncmp(line, "session", 7) == 0) sscanf(line, "session %u", &config->sessionId);
+
+        line = next;
+    }
+    EndScratchMemory();
+
+    if (!valid || config->port <= 0 || config->port > 65535) {
+        TraceLog(LOG_WARNING, "MULTIPLAYER: [%s] No valid host or join line, single player", MULTIPLAYER_CONFIG_FILE);
+        return false;
+    }
+
+    return true;
+}
+
+// Host: IPv6 socket on every address, IPv4 guests included (mapped addresses)
+static int OpenHostSocket(int port)
+{
+    int fd = socket(AF_INET6, SOCK_DGRAM, 0);
+    if (fd < 0) return -1;
+
+    int off = 0;
+    setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+
+    struct sockaddr_in6 address = { 0 };
+    address.sin6_family = AF_INET6;
+    address.sin6_addr = in6addr_any;
+    address.sin6_port = htons((unsigned short)port);
+
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+// Guest: socket of the host address family, on an ephemeral port
+static int OpenGuestSocket(Multiplayer *multiplayer, const char *host, int port)
+{
+    char service[16];
+    snprintf(service, sizeof(service), "%d", port);
+
+    struct addrinfo hints = { 0 };
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+
+    // NOTE: Resolved once at startup, a name lookup may block for a moment
+    struct addrinfo *result = NULL;
+    if (getaddrinfo(host, service, &hints, &result) != 0 || result == NULL) return -1;
+
+    int fd = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+    if (fd >= 0 && result->ai_addrlen <= sizeof(multiplayer->peerAddress)) {
+        memcpy(&multiplayer->peerAddress, result->ai_addr, result->ai_addrlen);
+        multiplayer->peerAddressSize = (socklen_t)result->ai_addrlen;
+    }
+    freeaddrinfo(result);
+
+    return fd;
+}
+
+bool MultiplayerInit(Multiplayer *multiplayer)
+{
+    memset(multiplayer, 0, sizeof(Multiplayer));
+    multiplayer->socket = -1;
+
+    MultiplayerConfig config = { 0 };
+    if (!LoadMultiplayerConfig(&config)) return false;
+
+    multiplayer->socket = config.host? OpenHostSocket(config.port) : OpenGuestSocket(multiplayer, config.address, config.port);
+    if (multiplayer->socket < 0) {
+        TraceLog(LOG_WARNING, "MULTIPLAYER: Failed to open the socket (%s %s:%i), single player", config.host? "host" : "join",
+                 config.host? "*" : config.address, config.port);
+        return false;
+    }
+
+    // Polled once per frame, never waited on
+    fcntl(multiplayer->socket, F_SETFL, fcntl(multiplayer->socket, F_GETFL, 0) | O_NONBLOCK);
+
+    NetplayInit(&multiplayer->session, config.host, config.sessionId);
+    multiplayer->enabled = true;
+
+    TraceLog(LOG_INFO, "MULTIPLAYER: %s %s:%i, session %u", config.host? "Hosting on" : "Joining",
+             config.host? "*" : config.address, config.port, config.sessionId);
+
+    return true;
+}
+
+bool IsMultiplayerGuest(const Multiplayer *multiplayer)
+{
+    return multiplayer->enabled && !multiplayer->session.host;
+}
+
+bool MultiplayerTakeRound(Multiplayer *multiplayer, unsigned int tick, ReplayRoundInfo *info)
+{
+    if (!multiplayer->enabled) return false;
+
+    return NetplayTakeRound(&multiplayer->session, info, tick);
+}
+
+void MultiplayerBeginRound(Multiplayer *multiplayer, const ReplayRoundInfo *info, unsigned int tick, PhysicsGeometry geometry)
+{
+    if (!multiplayer->enabled) return;
+
+    if (multiplayer->session.host) NetplayBeginRound(&multiplayer->session, info, tick);
+
+    // NOTE: The guest ball waits at the start until the guest is in the round
+    NetplayStartPeerWorld(&multiplayer->session, &multiplayer->world, geometry, &multiplayer->opponent);
+}
+
+void MultiplayerRecordShot(Multiplayer *multiplayer, unsigned int tick, Vector2 dragVector)
+{
+    if (multiplayer->enabled) NetplayRecordShot(&multiplayer->session, tick, dragVector);
+}
+
+void MultiplayerUpdate(Multiplayer *multiplayer, const PhysicsWorld *world, const GolfPlayer *player, int ticks)
+{
+    if (!multiplayer->enabled) return;
+
+    NetplaySession *session = &multiplayer->session;
+    double time = GetTime();
+
+    for (int i = 0; i < MULTIPLAYER_MAX_RECEIVES; i++) {
+        unsigned char packet[NETPLAY_MAX_PACKET_SIZE];
+        struct sockaddr_storage from = { 0 };
+        socklen_t fromSize = sizeof(from);
+
+        ssize_t size = recvfrom(multiplayer->socket, packet, sizeof(packet), 0, (struct sockaddr *)&from, &fromSize);
+        if (size < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) TraceLog(LOG_DEBUG, "MULTIPLAYER: Receive failed (%s)", strerror(errno));
+            break;
+        }
+
+        if (!NetplayReadPacket(session, packet, (unsigned int)size)) continue;
+
+        // The host answers where the guest packets come from (NAT ports change)
+        if (session->host) {
+            memcpy(&multiplayer->peerAddress, &from, fromSize);
+            multiplayer->peerAddressSize = fromSize;
+        }
+
+        if (!multiplayer->connected) TraceLog(LOG_INFO, "MULTIPLAYER: Peer connected");
+        multiplayer->connected = true;
+        multiplayer->lastReceive = time;
+    }
+
+    if (multiplayer->connected && (time - multiplayer->lastReceive > MULTIPLAYER_TIMEOUT)) {
+        TraceLog(LOG_WARNING, "MULTIPLAYER: No packet for %.0f s, peer gone", MULTIPLAYER_TIMEOUT);
+        multiplayer->connected = false;
+    }
+
+    // Local ball reported once at rest, the opponent ball follows its own timeline
+    if (player->holed || GolfCanShoot(player, world)) NetplayRecordRest(session, world, player);
+    NetplayAdvancePeer(session, &multiplayer->world, &multiplayer->opponent, ticks);
+
+    if (multiplayer->peerAddressSize == 0) return;
+
+    double interval = NetplayHasPendingData(session)? MULTIPLAYER_SEND_INTERVAL : MULTIPLAYER_KEEPALIVE;
+    if (time - multiplayer->lastSend < interval) return;
+
+    unsigned char packet[NETPLAY_MAX_PACKET_SIZE];
+    unsigned int size = NetplayWritePacket(session, packet);
+    if (sendto(multiplayer->socket, packet, size, 0, (struct sockaddr *)&multiplayer->peerAddress, multiplayer->peerAddressSize) < 0 &&
+        errno != EAGAIN && errno != EWOULDBLOCK) {
+        TraceLog(LOG_DEBUG, "MULTIPLAYER: Send failed (%s)", strerror(errno));
+    }
+    multiplayer->lastSend = time;
+}
+
+Vector2 GetOpponentRenderPosition(const Multiplayer *multiplayer, float alpha)
+{
+    const PhysicsBalls *balls = &multiplayer->world.balls;
+    int ball = multiplayer->opponent.ball;
+
+    return Vector2Lerp((Vector2){ balls->previousX[ball], balls->previousY[ball] }, PhysicsGetBallPosition(&multiplayer->world, ball), alpha);
+}
+
+void MultiplayerUnload(Multiplayer *multiplayer)
+{
+    if (!multiplayer->enabled) return;
+    close(multiplayer->socket);
+
+    TraceLog(LOG_INFO, "MULTIPLAYER: Sent %u packets (%u bytes), received %u, %u desyncs", multiplayer->session.packetsSent,
+             multiplayer->session.bytesSent, multiplayer->session.packetsReceived, multiplayer->session.desyncCount);
+
+    memset(multiplayer, 0, sizeof(Multiplayer));
+    multiplayer->socket = -1;
+}
@@ -0,0 +1,91 @@
+#ifndef MULTIPLAYER_H
+#define MULTIPLAYER_H
+
+#include "raylib.h"
+#include "netplay.h"
+
+#include <sys/socket.h>
+
+// --- Multiplayer ---
+// Head-to-head play on the same holes over UDP, each player sees the other ball as a ghost. The session
+// (netplay.h) exchanges shots and rest hashes, this module only moves its packets: one non-blocking
+// socket polled once per frame, a packet sent when the peer is missing something (at most every
+// MULTIPLAYER_SEND_INTERVAL) and a keepalive otherwise. The peer is set in multiplayer.cfg in app
+// storage (no lobby): "host <port>" waits for a guest, "join <address> <port>" plays the holes of that
+// host, an optional "session <id>" keeps other games out. Without the file the game is single player.
+#define MULTIPLAYER_CONFIG_FILE     "multiplayer.cfg"
+#define MULTIPLAYER_DEFAULT_PORT    47820
+#define MULTIPLAYER_DEFAULT_SESSION 1
+#define MULTIPLAYER_SEND_INTERVAL   0.05    // Seconds between two packets while the peer is missing something
+#define MULTIPLAYER_KEEPALIVE       1.0     // Seconds between two packets otherwise
+#define MULTIPLAYER_TIMEOUT         10.0    // Seconds without a packet before the peer is shown as gone
+
+typedef struct Multiplayer {
+    bool enabled;               // Configured and the socket is open
+    bool connected;             // A packet arrived less than MULTIPLAYER_TIMEOUT ago
+    int socket;
+    struct sockaddr_storage peerAddress;
+    socklen_t peerAddressSize;  // 0 until known (host: the first valid packet tells it)
+    double lastSend;
+    double lastReceive;
+
+    NetplaySession session;
+    PhysicsWorld world;         // Opponent ball, re-simulated from its shots
+    GolfPlayer opponent;
+} Multiplayer;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Opens the socket set up by MULTIPLAYER_CONFIG_FILE.
+ *
+ * @return false when the file is missing or invalid (single player), or the socket can't be opened.
+ */
+bool MultiplayerInit(Multiplayer *multiplayer);
+
+/**
+ * @brief Checks if the holes come from the host (they are taken with MultiplayerTakeRound()).
+ */
+bool IsMultiplayerGuest(const Multiplayer *multiplayer);
+
+/**
+ * @brief Guest: gets the round the host started at world tick 'tick', to set up before MultiplayerBeginRound().
+ *
+ * @return false while there is no new round.
+ */
+bool MultiplayerTakeRound(Multiplayer *multiplayer, unsigned int tick, ReplayRoundInfo *info);
+
+/**
+ * @brief Starts a round on the current hole: the host sends it, both reset the opponent ball.
+ */
+void MultiplayerBeginRound(Multiplayer *multiplayer, const ReplayRoundInfo *info, unsigned int tick, PhysicsGeometry geometry);
+
+/**
+ * @brief Sends a local shot taken at world tick 'tick' (call next to GolfShoot()).
+ */
+void MultiplayerRecordShot(Multiplayer *multiplayer, unsigned int tick, Vector2 dragVector);
+
+/**
+ * @brief Receives, moves the opponent ball 'ticks' further and sends (once per frame, after the physics).
+ *
+ * The local ball is reported once at rest after a shot.
+ */
+void MultiplayerUpdate(Multiplayer *multiplayer, const PhysicsWorld *world, const GolfPlayer *player, int ticks);
+
+/**
+ * @brief Opponent ball blended between its last two ticks ('alpha' of the local world).
+ */
+Vector2 GetOpponentRenderPosition(const Multiplayer *multiplayer, float alpha);
+
+/**
+ * @brief Closes the socket.
+ */
+void MultiplayerUnload(Multiplayer *multiplayer);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // MULTIPLAYER_H
@@ -0,0 +1,262 @@
+#include "particles.h"
+
+#include <math.h>
+#include <string.h>
+
+static const Color confettiColors[] = { RED, GOLD, SKYBLUE, LIME, PINK, ORANGE, VIOLET, WHITE };
+static const Color splashColors[] = { { 200, 230, 255, 220 }, { 120, 180, 255, 200 }, { 255, 255, 255, 230 } };
+static const Color sandColors[] = { { 210, 180, 120, 230 }, { 190, 160, 100, 230 }, { 230, 205, 150, 230 } };
+
+// Cheap random numbers, effects don't need raylib's generator (nor to disturb it)
+static float RandomRange(ParticleSystem *particles, float min, float max)
+{
+    uint32_t x = particles->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    particles->rng = x;
+
+    return min + (max - min)*(float)(x >> 8)*(1.0f/16777216.0f);
+}
+
+static int GetLiveCount(const ParticleSystem *particles)
+{
+    int live = 0;
+    for (int i = 0; i < PARTICLE_LAYER_COUNT; i++) live += particles->pools[i].count;
+    return live;
+}
+
+// Reserves up to 'count' new particles at the end of a pool, the ones past the cap are refused
+static int SpawnParticles(ParticleSystem *particles, ParticleLayer layer, int count, int *first)
+{
+    ParticlePool *pool = &particles->pools[layer];
+    int room = particles->cap - GetLiveCount(particles);
+    if (room > PARTICLE_POOL_CAPACITY - pool->count) room = PARTICLE_POOL_CAPACITY - pool->count;
+    if (room < 0) room = 0;
+
+    int spawned = (count < room)? count : room;
+    particles->dropped += (unsigned int)(count - spawned);
+    *first = pool->count;
+    pool->count += spawned;
+
+    return spawned;
+}
+
+// Burst size at the current quality level
+static int GetBurstCount(const ParticleSystem *particles, int count)
+{
+    int scaled = (int)((float)count*particles->qualityScale + 0.5f);
+    return (scaled > 1)? scaled : 1;
+}
+
+static void SetParticle(ParticlePool *pool, int i, Vector2 position, Vector2 velocity, float life, float size, Color color)
+{
+    pool->x[i] = position.x;
+    pool->y[i] = position.y;
+    pool->vx[i] = velocity.x;
+    pool->vy[i] = velocity.y;
+    pool->gravity[i] = 0.0f;
+    pool->drag[i] = 0.0f;
+    pool->rotation[i] = 0.0f;
+    pool->spin[i] = 0.0f;
+    pool->size[i] = size;
+    pool->age[i] = 0.0f;
+    pool->life[i] = life;
+    pool->color[i] = color;
+}
+
+static void MoveParticle(ParticlePool *pool, int from, int to)
+{
+    pool->x[to] = pool->x[from];
+    pool->y[to] = pool->y[from];
+    pool->vx[to] = pool->vx[from];
+    pool->vy[to] = pool->vy[from];
+    pool->gravity[to] = pool->gravity[from];
+    pool->drag[to] = pool->drag[from];
+    pool->rotation[to] = pool->rotation[from];
+    pool->spin[to] = pool->spin[from];
+    pool->size[to] = pool->size[from];
+    pool->age[to] = pool->age[from];
+    pool->life[to] = pool->life[from];
+    pool->color[to] = pool->color[from];
+}
+
+void ParticlesInit(ParticleSystem *particles)
+{
+    memset(particles, 0, sizeof(ParticleSystem));
+    particles->cap = PARTICLE_LAYER_COUNT*PARTICLE_POOL_CAPACITY;
+    particles->qualityScale = 1.0f;
+    particles->rng = 0x9e3779b9u;
+}
+
+// Every particle of a pool moved by 'dt', one pass per property without branches (vectorized by the compiler)
+static void IntegratePool(ParticlePool *pool, float dt)
+{
+    float *restrict x = pool->x, *restrict y = pool->y;
+    float *restrict vx = pool->vx, *restrict vy = pool->vy;
+    const float *restrict gravity = pool->gravity, *restrict drag = pool->drag;
+    int count = pool->count;
+
+    for (int i = 0; i < count; i++) {
+        float kept = fmaxf(1.0f - drag[i]*dt, 0.0f);
+        vx[i] = vx[i]*kept;
+        vy[i] = (vy[i] + gravity[i]*dt)*kept;
+        x[i] += vx[i]*dt;
+        y[i] += vy[i]*dt;
+    }
+
+    float *restrict rotation = pool->rotation, *restrict age = pool->age;
+    const float *restrict spin = pool->spin;
+    for (int i = 0; i < count; i++) {
+        rotation[i] += spin[i]*dt;
+        age[i] += dt;
+    }
+
+    // Dead particles are replaced by the last live one
+    for (int i = 0; i < pool->count; ) {
+        if (pool->age[i] >= pool->life[i]) MoveParticle(pool, --pool->count, i);
+        else i++;
+    }
+}
+
+void ParticlesUpdate(ParticleSystem *particles, float frameTime, float qualityScale)
+{
+    double start = GetTime();
+    float dt = fminf(fmaxf(frameTime, 0.0f), PARTICLE_MAX_STEP);
+    particles->qualityScale = qualityScale;
+
+    // Last frame over budget: cut the cap to what the budget pays for, otherwise let it grow back
+    int live = GetLiveCount(particles);
+    int maxCap = (int)((float)(PARTICLE_LAYER_COUNT*PARTICLE_POOL_CAPACITY)*qualityScale);
+    if ((particles->frameCost > PARTICLE_FRAME_BUDGET) && (live > 0)) {
+        particles->cap = (int)((double)live*PARTICLE_FRAME_BUDGET/particles->frameCost);
+    } else {
+        particles->cap = (int)((float)particles->cap*PARTICLE_CAP_GROWTH) + 1;
+    }
+    if (particles->cap > maxCap) particles->cap = maxCap;
+    if (particles->cap < PARTICLE_MIN_CAP) particles->cap = PARTICLE_MIN_CAP;
+    particles->frameCost = 0.0;
+
+    for (int i = 0; i < PARTICLE_LAYER_COUNT; i++) IntegratePool(&particles->pools[i], dt);
+
+    // Excess over the cap dropped right away, from the busiest layer
+    for (live = GetLiveCount(particles); live > particles->cap; live--) {
+        ParticlePool *pool = &particles->pools[PARTICLE_LAYER_WORLD];
+        if (particles->pools[PARTICLE_LAYER_OVERLAY].count > pool->count) pool = &particles->pools[PARTICLE_LAYER_OVERLAY];
+        pool->count--;
+        particles->dropped++;
+    }
+
+    particles->frameCost += GetTime() - start;
+}
+
+void EmitConfetti(ParticleSystem *particles, Vector2 position)
+{
+    ParticlePool *pool = &particles->pools[PARTICLE_LAYER_OVERLAY];
+    int first = 0;
+    int count = SpawnParticles(particles, PARTICLE_LAYER_OVERLAY, GetBurstCount(particles, PARTICLE_CONFETTI_COUNT), &first);
+
+    for (int i = first; i < first + count; i++) {
+        // Thrown upwards in a wide fan, then it flutters down (strong drag)
+        float angle = RandomRange(particles, -0.9f*PI, -0.1f*PI);
+        float speed = RandomRange(particles, 400.0f, 1100.0f);
+        Color color = confettiColors[(int)RandomRange(particles, 0.0f, 7.999f)];
+
+        SetParticle(pool, i, position, (Vector2){ cosf(angle)*speed, sinf(angle)*speed }, RandomRange(particles, 2.0f, 3.2f), RandomRange(particles, 10.0f, 18.0f), color);
+        pool->gravity[i] = 700.0f;
+        pool->drag[i] = 1.2f;
+        pool->rotation[i] = RandomRange(particles, 0.0f, 360.0f);
+        pool->spin[i] = RandomRange(particles, -720.0f, 720.0f);
+    }
+}
+
+void EmitWaterSplash(ParticleSystem *particles, Vector2 position)
+{
+    ParticlePool *pool = &particles->pools[PARTICLE_LAYER_WORLD];
+    int first = 0;
+    int count = SpawnParticles(particles, PARTICLE_LAYER_WORLD, GetBurstCount(particles, PARTICLE_SPLASH_COUNT), &first);
+
+    for (int i = first; i < first + count; i++) {
+        float angle = RandomRange(particles, -PI, PI);
+        float speed = RandomRange(particles, 80.0f, 320.0f);
+        Color color = splashColors[(int)RandomRange(particles, 0.0f, 2.999f)];
+
+        SetParticle(pool, i, position, (Vector2){ cosf(angle)*speed, sinf(angle)*speed }, RandomRange(particles, 0.4f, 0.8f), RandomRange(particles, 6.0f, 12.0f), color);
+        pool->drag[i] = 4.0f;
+        pool->rotation[i] = 45.0f;
+    }
+}
+
+void EmitSandSplash(ParticleSystem *particles, Vector2 position, Vector2 direction)
+{
+    ParticlePool *pool = &particles->pools[PARTICLE_LAYER_WORLD];
+    int first = 0;
+    int count = SpawnParticles(particles, PARTICLE_LAYER_WORLD, GetBurstCount(particles, PARTICLE_SAND_COUNT), &first);
+
+    bool aimed = (direction.x != 0.0f) || (direction.y != 0.0f);
+    float heading = aimed? atan2f(direction.y, direction.x) : 0.0f;
+    float spread = aimed? PI/3.0f : PI;
+
+    for (int i = first; i < first + count; i++) {
+        float angle = heading + RandomRange(particles, -spread, spread);
+        float speed = RandomRange(particles, 60.0f, 260.0f);
+        Color color = sandColors[(int)RandomRange(particles, 0.0f, 2.999f)];
+
+        SetParticle(pool, i, position, (Vector2){ cosf(angle)*speed, sinf(angle)*speed }, RandomRange(particles, 0.3f, 0.6f), RandomRange(particles, 4.0f, 8.0f), color);
+        pool->drag[i] = 5.0f;
+        pool->rotation[i] = RandomRange(particles, 0.0f, 90.0f);
+    }
+}
+
+void EmitTrail(ParticleSystem *particles, Vector2 from, Vector2 to, float *carry)
+{
+    float dx = to.x - from.x, dy = to.y - from.y;
+    float length = sqrtf(dx*dx + dy*dy);
+    if (length <= 0.0f) return;
+
+    ParticlePool *pool = &particles->pools[PARTICLE_LAYER_WORLD];
+    float distance = PARTICLE_TRAIL_SPACING - *carry;
+
+    for (; distance <= length; distance += PARTICLE_TRAIL_SPACING) {
+        int i = 0;
+        if (SpawnParticles(particles, PARTICLE_LAYER_WORLD, 1, &i) == 0) continue;
+
+        float t = distance/length;
+        SetParticle(pool, i, (Vector2){ from.x + dx*t, from.y + dy*t }, (Vector2){ 0.0f, 0.0f }, 0.35f, 14.0f, (Color){ 255, 255, 255, 90 });
+        pool->rotation[i] = 45.0f;
+    }
+
+    *carry = length - (distance - PARTICLE_TRAIL_SPACING);
+}
+
+void ParticlesDraw(ParticleSystem *particles, ParticleLayer layer, SpriteBatch *batch, Rectangle view)
+{
+    const ParticlePool *pool = &particles->pools[layer];
+    if (pool->count == 0) return;
+
+    double start = GetTime();
+    Rectangle source = GetShapesTextureRectangle();
+
+    SpriteBatchBegin(batch, GetShapesTexture());
+    for (int i = 0; i < pool->count; i++) {
+        // NOTE: The size bounds a rotated particle (its half diagonal is under it), culled ones cost no vertices
+        float size = pool->size[i];
+        if ((pool->x[i] + size < view.x) || (pool->x[i] - size > view.x + view.width) ||
+            (pool->y[i] + size < view.y) || (pool->y[i] - size > view.y + view.height)) continue;
+
+        // Faded out over the second half of the life
+        float fade = fminf(2.0f*(pool->life[i] - pool->age[i])/pool->life[i], 1.0f);
+        Color color = pool->color[i];
+        color.a = (unsigned char)((float)color.a*fade);
+
+        SpriteBatchDraw(batch, source, (Rectangle){ pool->x[i], pool->y[i], size, size }, (Vector2){ size/2.0f, size/2.0f }, pool->rotation[i], color);
+    }
+    SpriteBatchEnd(batch);
+
+    particles->frameCost += GetTime() - start;
+}
+
+bool IsParticleSystemActive(const ParticleSystem *particles)
+{
+    return GetLiveCount(particles) > 0;
+}
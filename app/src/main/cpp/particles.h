@@ -0,0 +1,113 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include "raylib.h"
+#include "spritebatch.h"
+
+#include <stdint.h>
+
+// --- Particles ---
+// Confetti when holing out, water and sand splashes, and a trail behind fast balls. Particles live in
+// fixed-capacity pools kept as structure of arrays (nothing is allocated while playing), updated by
+// branch-free loops the compiler vectorizes, and drawn as one instanced batch of the shapes texture
+// (spritebatch.h). Updating and drawing have a hard CPU budget per frame: a frame over it lowers the
+// live cap at once, the excess is dropped and new particles are refused past the cap, so slow devices
+// lose particles instead of frames. The cap grows back slowly and follows the quality governor
+// (particleScale). Bursts are scaled the same way.
+#define PARTICLE_POOL_CAPACITY      1024    // Particles per layer
+#define PARTICLE_FRAME_BUDGET       0.0005  // Seconds of CPU per frame for the update and the draws
+#define PARTICLE_MIN_CAP            32      // Live cap never goes lower (a burst is still visible)
+#define PARTICLE_CAP_GROWTH         1.05f   // Cap growth per frame under budget
+#define PARTICLE_MAX_STEP           0.05f   // Longest step of one update (s), hitches don't throw particles away
+#define PARTICLE_CONFETTI_COUNT     160     // Hole out burst at full quality
+#define PARTICLE_SPLASH_COUNT       40      // Water splash
+#define PARTICLE_SAND_COUNT         24      // Sand kicked up by a shot or a landing
+#define PARTICLE_TRAIL_SPACING      12.0f   // Distance between two trail particles (px)
+#define PARTICLE_TRAIL_MIN_SPEED    4.0f    // Balls slower than this (px per reference frame) leave no trail
+#define PARTICLE_SAND_FRICTION      0.97f   // Surfaces keeping less than this are sand (see PhysicsGetSurfaceFriction())
+
+// Where a particle is drawn
+typedef enum {
+    PARTICLE_LAYER_WORLD = 0,   // With the balls, at the dynamic render scale
+    PARTICLE_LAYER_OVERLAY,     // Over the HUD and the win screen
+    PARTICLE_LAYER_COUNT
+} ParticleLayer;
+
+// One layer of particles, live particles are [0, count)
+typedef struct ParticlePool {
+    float x[PARTICLE_POOL_CAPACITY];
+    float y[PARTICLE_POOL_CAPACITY];
+    float vx[PARTICLE_POOL_CAPACITY];           // px/s
+    float vy[PARTICLE_POOL_CAPACITY];
+    float gravity[PARTICLE_POOL_CAPACITY];      // px/s^2, down the screen
+    float drag[PARTICLE_POOL_CAPACITY];         // Share of the velocity lost per second
+    float rotation[PARTICLE_POOL_CAPACITY];     // Degrees
+    float spin[PARTICLE_POOL_CAPACITY];         // Degrees/s
+    float size[PARTICLE_POOL_CAPACITY];         // px
+    float age[PARTICLE_POOL_CAPACITY];          // s
+    float life[PARTICLE_POOL_CAPACITY];         // s, faded out towards the end
+    Color color[PARTICLE_POOL_CAPACITY];
+    int count;
+} ParticlePool;
+
+typedef struct ParticleSystem {
+    ParticlePool pools[PARTICLE_LAYER_COUNT];
+    int cap;                    // Live particles allowed over all layers
+    float qualityScale;         // particleScale of the quality level
+    double frameCost;           // CPU time spent on particles this frame (update and draws)
+    uint32_t rng;
+    unsigned int dropped;       // Particles refused or cut by the budget
+} ParticleSystem;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+void ParticlesInit(ParticleSystem *particles);
+
+/**
+ * @brief Moves and ages every particle, and sets the cap from the last frame cost (once per frame).
+ *
+ * 'qualityScale' is the particleScale of the quality level (see governor.h).
+ */
+void ParticlesUpdate(ParticleSystem *particles, float frameTime, float qualityScale);
+
+/**
+ * @brief Confetti over the screen from 'position' (hole out).
+ */
+void EmitConfetti(ParticleSystem *particles, Vector2 position);
+
+/**
+ * @brief Water splash where a ball fell in.
+ */
+void EmitWaterSplash(ParticleSystem *particles, Vector2 position);
+
+/**
+ * @brief Sand kicked up around 'position', mostly along 'direction' (normalized, or zero for all around).
+ */
+void EmitSandSplash(ParticleSystem *particles, Vector2 position, Vector2 direction);
+
+/**
+ * @brief Trail particles along a ball path since the last frame, one every PARTICLE_TRAIL_SPACING.
+ *
+ * 'carry' keeps the distance left over between calls (one per ball, 0 to start a new trail).
+ */
+void EmitTrail(ParticleSystem *particles, Vector2 from, Vector2 to, float *carry);
+
+/**
+ * @brief Draws the particles of one layer inside 'view' through the sprite batch, with the texture the raylib shapes use.
+ *
+ * 'view' is the world area on screen for PARTICLE_LAYER_WORLD (see GetCameraView()), the screen for the overlay.
+ */
+void ParticlesDraw(ParticleSystem *particles, ParticleLayer layer, SpriteBatch *batch, Rectangle view);
+
+/**
+ * @brief Checks if any particle is alive (frames must keep coming).
+ */
+bool IsParticleSystemActive(const ParticleSystem *particles);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // PARTICLES_H
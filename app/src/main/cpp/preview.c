@@ -0,0 +1,79 @@
+#include "preview.h"
+#include "rules.h"
+
+#include <raymath.h>
+
+void TrajectoryPreviewReset(TrajectoryPreview *preview)
+{
+    preview->started = false;
+    preview->complete = false;
+    preview->pointCount = 0;
+}
+
+static void StartPrediction(TrajectoryPreview *preview, const PhysicsWorld *world, int ball, Vector2 drag)
+{
+    // NOTE: The world copy keeps the other balls, so the prediction shows contacts with them too
+    preview->world = *world;
+    preview->ball = ball;
+    preview->drag = drag;
+    preview->started = true;
+    preview->complete = false;
+    preview->ticks = 0;
+
+    preview->lastPosition = PhysicsGetBallPosition(world, ball);
+    preview->travelled = 0.0f;
+    preview->pointCount = 0;
+
+    PhysicsShoot(&preview->world, ball, GolfGetShotImpulse(drag));
+}
+
+// Simulates one tick of the prediction and drops a dot every PREVIEW_POINT_SPACING px of path
+static void StepPrediction(TrajectoryPreview *preview)
+{
+    PhysicsWorld *world = &preview->world;
+    int ball = preview->ball;
+
+    PhysicsStep(world);
+    preview->ticks++;
+
+    Vector2 position = PhysicsGetBallPosition(world, ball);
+    preview->travelled += Vector2Distance(position, preview->lastPosition);
+    preview->lastPosition = position;
+
+    bool finished = world->balls.sunk[ball] || world->balls.inHazard[ball] || PhysicsIsBallStopped(world, ball) ||
+                    (preview->ticks >= PREVIEW_MAX_SECONDS*world->tickRate);
+
+    if ((preview->travelled >= PREVIEW_POINT_SPACING) || finished) {
+        if (preview->pointCount < PREVIEW_MAX_POINTS) preview->points[preview->pointCount++] = position;
+        else finished = true;
+        preview->travelled = 0.0f;
+    }
+
+    preview->complete = finished;
+}
+
+void TrajectoryPreviewUpdate(TrajectoryPreview *preview, const PhysicsWorld *world, int ball, Vector2 drag)
+{
+    // NOTE: The drag is quantized as GolfShoot() does, the prediction is the shot that would be taken
+    Vector2 shot = GolfQuantizeDrag(drag);
+
+    // Small drag jitter (finger resting on the screen) keeps the cached prediction
+    if (!preview->started || (ball != preview->ball) || (Vector2Distance(shot, preview->drag) > PREVIEW_REBUILD_DISTANCE)) {
+        StartPrediction(preview, world, ball, shot);
+    }
+
+    // Long predictions are spread over several frames
+    double start = GetTime();
+    while (!preview->complete) {
+        for (int i = 0; (i < PREVIEW_TICKS_PER_CHECK) && !preview->complete; i++) StepPrediction(preview);
+        if ((GetTime() - start) > PREVIEW_FRAME_BUDGET) break;
+    }
+}
+
+void TrajectoryPreviewDraw(const TrajectoryPreview *preview, Color color)
+{
+    for (int i = 0; i < preview->pointCount; i++) {
+        float alpha = 1.0f - 0.8f*(float)i/(float)PREVIEW_MAX_POINTS;
+        DrawCircleV(preview->points[i], 5.0f, Fade(color, alpha));
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef PREVIEW_H
+#define PREVIEW_H
+
+#include "raylib.h"
+#include "physics.h"
+
+// --- Trajectory Preview ---
+#define PREVIEW_MAX_POINTS          96      // Dots along the predicted path
+#define PREVIEW_POINT_SPACING       24.0f   // Path length (px) between two dots
+#define PREVIEW_MAX_SECONDS         4       // Prediction horizon (simulated seconds)
+#define PREVIEW_REBUILD_DISTANCE    2.0f    // Drag change (px) under which the last prediction is kept
+#define PREVIEW_FRAME_BUDGET        0.0015  // Simulation time allowed per frame (seconds), the rest carries over
+#define PREVIEW_TICKS_PER_CHECK     32      // Ticks simulated between two budget checks
+
+// Predicted path of one shot, built by running the real physics on a copy of the world
+typedef struct TrajectoryPreview {
+    PhysicsWorld world;         // Private copy, advanced a few ticks each frame
+    int ball;                   // Predicted ball index
+    Vector2 drag;               // Drag vector the prediction was started for (quantized, GolfQuantizeDrag())
+    bool started;
+    bool complete;              // Ball came to rest, sunk, hit water or reached the horizon
+    int ticks;                  // Ticks simulated so far
+
+    Vector2 points[PREVIEW_MAX_POINTS];
+    int pointCount;
+    Vector2 lastPosition;
+    float travelled;            // Path length since the last dot
+} TrajectoryPreview;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Drops the current prediction (call when a drag starts or ends).
+ */
+void TrajectoryPreviewReset(TrajectoryPreview *preview);
+
+/**
+ * @brief Updates the prediction for the current drag, within PREVIEW_FRAME_BUDGET.
+ *
+ * A new prediction is only started when the drag moved more than PREVIEW_REBUILD_DISTANCE,
+ * otherwise the cached one is kept, and continued if it wasn't finished yet.
+ */
+void TrajectoryPreviewUpdate(TrajectoryPreview *preview, const PhysicsWorld *world, int ball, Vector2 drag);
+
+/**
+ * @brief Draws the predicted path as fading dots.
+ */
+void TrajectoryPreviewDraw(const TrajectoryPreview *preview, Color color);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // PREVIEW_H
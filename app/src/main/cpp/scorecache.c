@@ -0,0 +1,237 @@
+#include "scorecache.h"
+#include "raymob.h"
+
+#include "external/sinfl.h"     // Deflate decompressor, implemented in raylib (SUPPORT_COMPRESSION_API)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Index order: course, hole, kind, slot
+static int CompareKey(const ScoreCacheRecord *a, uint32_t courseId, int hole, int kind, int slot)
+{
+    if (a->courseId != courseId) return (a->courseId < courseId)? -1 : 1;
+    if (a->hole != hole) return (a->hole < hole)? -1 : 1;
+    if (a->kind != kind) return (a->kind < kind)? -1 : 1;
+    if (a->slot != slot) return (a->slot < slot)? -1 : 1;
+    return 0;
+}
+
+// First index entry not before the key
+static int FindPosition(const ScoreCache *cache, uint32_t courseId, int hole, int kind, int slot)
+{
+    int lo = 0, hi = cache->count;
+
+    while (lo < hi) {
+        int mid = (lo + hi)/2;
+        if (CompareKey(&cache->records[mid], courseId, hole, kind, slot) < 0) lo = mid + 1;
+        else hi = mid;
+    }
+
+    return lo;
+}
+
+static void GetEntryFileName(const ScoreCacheRecord *record, char *fileName)
+{
+    snprintf(fileName, SCORE_CACHE_NAME_LENGTH, "score_%08x_%i_%i_%i.z", (unsigned int)record->courseId, record->hole, record->kind, record->slot);
+}
+
+static void WriteIndex(const ScoreCache *cache)
+{
+    unsigned int size = sizeof(ScoreCacheFileHeader) + (unsigned int)cache->count*sizeof(ScoreCacheRecord);
+    unsigned char *data = (unsigned char *)MemAlloc(size);
+    if (data == NULL) return;
+
+    ScoreCacheFileHeader *header = (ScoreCacheFileHeader *)data;
+    memcpy(header->magic, SCORE_CACHE_FILE_MAGIC, 4);
+    header->version = SCORE_CACHE_FILE_VERSION;
+    header->entryCount = (uint32_t)cache->count;
+    header->generation = cache->generation;
+    memcpy(data + sizeof(ScoreCacheFileHeader), cache->records, (size_t)cache->count*sizeof(ScoreCacheRecord));
+
+    WriteToAppStorageAsync(SCORE_CACHE_INDEX_FILE, data, size);
+    MemFree(data);
+}
+
+bool ScoreCacheOpen(ScoreCache *cache)
+{
+    memset(cache, 0, sizeof(ScoreCache));
+    cache->records = (ScoreCacheRecord *)MemAlloc(SCORE_CACHE_MAX_ENTRIES*sizeof(ScoreCacheRecord));
+    if (cache->records == NULL) return false;
+
+    if (!IsFileExistsInAppStorage(SCORE_CACHE_INDEX_FILE)) return true;
+
+    int size = 0;
+    unsigned char *data = (unsigned char *)ReadFromAppStorage(SCORE_CACHE_INDEX_FILE, &size);
+    if (data == NULL) return true;
+
+    const ScoreCacheFileHeader *header = (const ScoreCacheFileHeader *)data;
+    bool valid = ((unsigned int)size >= sizeof(ScoreCacheFileHeader)) &&
+                 (memcmp(header->magic, SCORE_CACHE_FILE_MAGIC, 4) == 0) &&
+                 (header->version == SCORE_CACHE_FILE_VERSION) &&
+                 (header->entryCount <= SCORE_CACHE_MAX_ENTRIES) &&
+                 ((unsigned int)size == sizeof(ScoreCacheFileHeader) + header->entryCount*sizeof(ScoreCacheRecord));
+
+    if (valid) {
+        memcpy(cache->records, data + sizeof(ScoreCacheFileHeader), header->entryCount*sizeof(ScoreCacheRecord));
+        cache->count = (int)header->entryCount;
+        cache->generation = header->generation;
+
+        // NOTE: An index out of order would break the lookups, it is dropped like a corrupt one
+        for (int i = 1; i < cache->count; i++) {
+            const ScoreCacheRecord *r = &cache->records[i];
+            if (CompareKey(&cache->records[i - 1], r->courseId, r->hole, r->kind, r->slot) >= 0) valid = false;
+        }
+    }
+
+    if (!valid) {
+        TraceLog(LOG_WARNING, "SCORES: [%s] Invalid or unsupported index, starting an empty cache", SCORE_CACHE_INDEX_FILE);
+        cache->count = 0;
+        cache->generation = 0;
+    }
+    else TraceLog(LOG_INFO, "SCORES: [%s] %i entries", SCORE_CACHE_INDEX_FILE, cache->count);
+
+    RL_FREE(data);
+
+    return true;
+}
+
+void ScoreCacheClose(ScoreCache *cache)
+{
+    MemFree(cache->records);
+    memset(cache, 0, sizeof(ScoreCache));
+}
+
+uint32_t ScoreCacheGetCourseId(const unsigned char *data, unsigned int size)
+{
+    uint32_t hash = 2166136261u;
+    for (unsigned int i = 0; i < size; i++) hash = (hash ^ data[i])*16777619u;
+
+    return hash;
+}
+
+const ScoreCacheRecord *ScoreCacheFind(const ScoreCache *cache, uint32_t courseId, int hole, int kind, int slot)
+{
+    int i = FindPosition(cache, courseId, hole, kind, slot);
+    if ((i < cache->count) && (CompareKey(&cache->records[i], courseId, hole, kind, slot) == 0)) return &cache->records[i];
+
+    return NULL;
+}
+
+int ScoreCacheGetCourse(const ScoreCache *cache, uint32_t courseId, const ScoreCacheRecord **records)
+{
+    int first = FindPosition(cache, courseId, INT16_MIN, 0, 0);
+    int last = first;
+    while ((last < cache->count) && (cache->records[last].courseId == courseId)) last++;
+
+    *records = cache->records + first;
+    return last - first;
+}
+
+// Index full: drops the oldest entry that isn't a ghost (personal bests are never evicted)
+static bool MakeRoom(ScoreCache *cache)
+{
+    int oldest = -1;
+    for (int i = 0; i < cache->count; i++) {
+        if (cache->records[i].kind == SCORE_CACHE_GHOST) continue;
+        if ((oldest < 0) || (cache->records[i].generation < cache->records[oldest].generation)) oldest = i;
+    }
+    if (oldest < 0) return false;
+
+    char fileName[SCORE_CACHE_NAME_LENGTH];
+    GetEntryFileName(&cache->records[oldest], fileName);
+    RemoveFileInAppStorage(fileName);
+
+    cache->count--;
+    memmove(cache->records + oldest, cache->records + oldest + 1, (size_t)(cache->count - oldest)*sizeof(ScoreCacheRecord));
+
+    return true;
+}
+
+bool ScoreCachePut(ScoreCache *cache, const ScoreCacheRecord *key, const unsigned char *data, unsigned int size)
+{
+    if ((cache->records == NULL) || (size == 0) || (size > SCORE_CACHE_MAX_ENTRY_SIZE)) return false;
+
+    int packedSize = 0;
+    unsigned char *packed = CompressData(data, (int)size, &packedSize);
+    if ((packed == NULL) || (packedSize <= 0)) {
+        MemFree(packed);
+        return false;
+    }
+
+    ScoreCacheRecord record = *key;
+    record.size = size;
+    record.packedSize = (uint32_t)packedSize;
+    record.generation = ++cache->generation;
+
+    int i = FindPosition(cache, record.courseId, record.hole, record.kind, record.slot);
+    bool replace = (i < cache->count) && (CompareKey(&cache->records[i], record.courseId, record.hole, record.kind, record.slot) == 0);
+    if (!replace && (cache->count == SCORE_CACHE_MAX_ENTRIES)) {
+        if (!MakeRoom(cache)) {
+            TraceLog(LOG_WARNING, "SCORES: Index full (%i ghosts), entry not kept", SCORE_CACHE_MAX_ENTRIES);
+            MemFree(packed);
+            return false;
+        }
+        i = FindPosition(cache, record.courseId, record.hole, record.kind, record.slot);
+    }
+
+    // Entry file: its record, then the deflated data
+    unsigned int fileSize = sizeof(ScoreCacheRecord) + (unsigned int)packedSize;
+    unsigned char *file = (unsigned char *)MemAlloc(fileSize);
+    if (file == NULL) {
+        MemFree(packed);
+        return false;
+    }
+    memcpy(file, &record, sizeof(ScoreCacheRecord));
+    memcpy(file + sizeof(ScoreCacheRecord), packed, (size_t)packedSize);
+    MemFree(packed);
+
+    char fileName[SCORE_CACHE_NAME_LENGTH];
+    GetEntryFileName(&record, fileName);
+    bool queued = WriteToAppStorageAsync(fileName, file, fileSize);
+    MemFree(file);
+    if (!queued) return false;
+
+    if (!replace) {
+        memmove(cache->records + i + 1, cache->records + i, (size_t)(cache->count - i)*sizeof(ScoreCacheRecord));
+        cache->count++;
+    }
+    cache->records[i] = record;
+    WriteIndex(cache);
+
+    return true;
+}
+
+unsigned char *ScoreCacheLoad(const ScoreCacheRecord *record, unsigned int *size)
+{
+    *size = 0;
+
+    char fileName[SCORE_CACHE_NAME_LENGTH];
+    GetEntryFileName(record, fileName);
+    if (!IsFileExistsInAppStorage(fileName)) return NULL;
+
+    int fileSize = 0;
+    unsigned char *file = (unsigned char *)ReadFromAppStorage(fileName, &fileSize);
+    if (file == NULL) return NULL;
+
+    // NOTE: The entry must be the write the index knows, a pending write or a torn update is a miss
+    unsigned char *data = NULL;
+    bool current = ((unsigned int)fileSize == sizeof(ScoreCacheRecord) + record->packedSize) &&
+                   (memcmp(file, record, sizeof(ScoreCacheRecord)) == 0) && (record->size <= SCORE_CACHE_MAX_ENTRY_SIZE);
+
+    if (current) {
+        data = (unsigned char *)MemAlloc(record->size);
+        int inflated = (data != NULL)? sinflate(data, (int)record->size, file + sizeof(ScoreCacheRecord), (int)record->packedSize) : 0;
+        if (inflated != (int)record->size) {
+            TraceLog(LOG_WARNING, "SCORES: [%s] Failed to inflate entry", fileName);
+            MemFree(data);
+            data = NULL;
+        }
+        else *size = record->size;
+    }
+    else TraceLog(LOG_INFO, "SCORES: [%s] Entry not written yet or out of date", fileName);
+
+    RL_FREE(file);
+
+    return data;
+}
@@ -0,0 +1,107 @@
+#ifndef SCORECACHE_H
+#define SCORECACHE_H
+
+#include "raylib.h"
+
+#include <stdint.h>
+
+// --- Score Cache ---
+// Personal-best ghosts, recent rounds and leaderboard pages kept in app storage, one deflated file per
+// entry (CompressData()) plus a small table of contents (SCORE_CACHE_INDEX_FILE) sorted by course, hole,
+// kind and slot. Opening the cache reads the index only: the course list gets every best score from it,
+// entry files are read and inflated when one is asked for. Writes go through WriteToAppStorageAsync(),
+// the index is rewritten after each entry (coalesced by the writer). Each entry file starts with its own
+// record, so an entry read before its write reached the disk, or out of step with the index after a crash,
+// is reported missing instead of returning the wrong data. All values little-endian.
+#define SCORE_CACHE_INDEX_FILE      "scores.toc"
+#define SCORE_CACHE_FILE_MAGIC      "SCOR"
+#define SCORE_CACHE_FILE_VERSION    1
+#define SCORE_CACHE_MAX_ENTRIES     1024    // Full index: the oldest entry that isn't a ghost makes room
+#define SCORE_CACHE_MAX_ENTRY_SIZE  (256*1024)  // Largest inflated entry (a leaderboard page, a long round)
+#define SCORE_CACHE_NAME_LENGTH     40      // Entry file name, "score_<course>_<hole>_<kind>_<slot>.z"
+
+typedef enum {
+    SCORE_CACHE_GHOST = 0,      // Round of the personal best on a hole (replay.h encoding), score is the strokes
+    SCORE_CACHE_REPLAY,         // Last round played on a hole, score is the strokes
+    SCORE_CACHE_LEADERBOARD     // Leaderboard page 'slot' of a hole, as sent by the server
+} ScoreCacheKind;
+
+typedef struct ScoreCacheFileHeader {
+    char magic[4];              // SCORE_CACHE_FILE_MAGIC
+    uint32_t version;           // SCORE_CACHE_FILE_VERSION
+    uint32_t entryCount;        // ScoreCacheRecord[entryCount] follow the header, sorted
+    uint32_t generation;        // Last generation given to an entry write
+} ScoreCacheFileHeader;
+
+// Index entry, also the first bytes of the entry file (then packedSize bytes of raw deflate)
+typedef struct ScoreCacheRecord {
+    uint32_t courseId;          // ScoreCacheGetCourseId() of the course file
+    int16_t hole;               // Hole index in the course
+    uint8_t kind;               // ScoreCacheKind
+    uint8_t slot;               // Leaderboard page, 0 otherwise
+    int32_t score;
+    uint32_t size;              // Inflated size
+    uint32_t packedSize;        // Deflated size in the entry file
+    uint32_t generation;        // Write that made the entry file, must match the index
+} ScoreCacheRecord;
+
+typedef struct ScoreCache {
+    ScoreCacheRecord *records;  // SCORE_CACHE_MAX_ENTRIES, the first 'count' sorted
+    int count;
+    uint32_t generation;
+} ScoreCache;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Reads the index from app storage, no entry is loaded (call after InitAppStorageWriter()).
+ *
+ * A missing or invalid index opens an empty cache. Returns false only without memory for the index.
+ */
+bool ScoreCacheOpen(ScoreCache *cache);
+
+/**
+ * @brief Frees the index, writes already queued still reach the disk.
+ */
+void ScoreCacheClose(ScoreCache *cache);
+
+/**
+ * @brief Identifies a course by its content (FNV-1a), so entries of an edited course aren't mixed up.
+ */
+uint32_t ScoreCacheGetCourseId(const unsigned char *data, unsigned int size);
+
+/**
+ * @brief Finds the entry of a key in the index, NULL when there is none (no file is read).
+ *
+ * Records returned here and by ScoreCacheGetCourse() point into the index, valid until the next put.
+ */
+const ScoreCacheRecord *ScoreCacheFind(const ScoreCache *cache, uint32_t courseId, int hole, int kind, int slot);
+
+/**
+ * @brief Gets the entries of one course, contiguous in the index and sorted by hole (for the course list).
+ *
+ * @return Number of entries, 'records' points to the first one.
+ */
+int ScoreCacheGetCourse(const ScoreCache *cache, uint32_t courseId, const ScoreCacheRecord **records);
+
+/**
+ * @brief Deflates and stores an entry (replacing the one of the same key), written in background.
+ *
+ * 'key' gives courseId, hole, kind, slot and score, the rest is filled in.
+ */
+bool ScoreCachePut(ScoreCache *cache, const ScoreCacheRecord *key, const unsigned char *data, unsigned int size);
+
+/**
+ * @brief Reads and inflates an entry found in the index.
+ *
+ * @return The entry data (release it with MemFree()), NULL when the file is missing or out of date.
+ */
+unsigned char *ScoreCacheLoad(const ScoreCacheRecord *record, unsigned int *size);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // SCORECACHE_H
@@ -0,0 +1,495 @@
+#include "sdffont.h"
+#include "rlgl.h"
+#include "raymob.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(SDF_FONT_SHADER)
+#if defined(GRAPHICS_API_OPENGL_ES3)
+    #define SDF_GLSL_VERSION "#version 300 es\n"
+#else
+    #define SDF_GLSL_VERSION "#version 330\n"
+#endif
+
+static const char *sdfVertexShader = SDF_GLSL_VERSION
+    "in vec3 vertexPosition;\n"
+    "in vec2 vertexTexCoord;\n"
+    "in vec4 vertexColor;\n"
+    "uniform mat4 mvp;\n"
+    "out vec2 fragTexCoord;\n"
+    "out vec4 fragColor;\n"
+    "void main()\n"
+    "{\n"
+    "    fragTexCoord = vertexTexCoord;\n"
+    "    fragColor = vertexColor;\n"
+    "    gl_Position = mvp*vec4(vertexPosition, 1.0);\n"
+    "}\n";
+
+// Distance 0.5 is the glyph edge, layers are composed (premultiplied) as text over outline over shadow
+static const char *sdfFragmentShader = SDF_GLSL_VERSION
+    "precision mediump float;\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec2 shadowOffset;\n"
+    "uniform vec4 shadowColor;\n"
+    "uniform float outlineWidth;\n"
+    "uniform vec4 outlineColor;\n"
+    "out vec4 finalColor;\n"
+    "void main()\n"
+    "{\n"
+    "    float distance = texture(texture0, fragTexCoord).a;\n"
+    "    float smoothing = max(0.7*length(vec2(dFdx(distance), dFdy(distance))), 0.001);\n"
+    "    float fill = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);\n"
+    "    float outline = smoothstep(0.5 - outlineWidth - smoothing, 0.5 - outlineWidth + smoothing, distance);\n"
+    "    float shadowDistance = texture(texture0, fragTexCoord - shadowOffset).a;\n"
+    "    float shadow = smoothstep(0.5 - outlineWidth - smoothing, 0.5 - outlineWidth + smoothing, shadowDistance);\n"
+    "    vec4 color = vec4(shadowColor.rgb, 1.0)*shadowColor.a*shadow;\n"
+    "    color = vec4(outlineColor.rgb, 1.0)*outlineColor.a*outline + color*(1.0 - outlineColor.a*outline);\n"
+    "    color = vec4(fragColor.rgb, 1.0)*fragColor.a*fill + color*(1.0 - fragColor.a*fill);\n"
+    "    finalColor = (color.a > 0.0)? vec4(color.rgb/color.a, color.a) : vec4(0.0);\n"
+    "}\n";
+
+#define SDF_FAR         1e20f       // Squared distance standing for "no such pixel"
+
+static int FloorDiv(int a, int b)
+{
+    return (a >= 0)? a/b : -((-a + b - 1)/b);
+}
+
+// Squared distance transform of one row or column (Felzenszwalb and Huttenlocher, lower envelope of parabolas)
+static void DistanceTransform1D(float *f, int n, int stride, float *d, int *v, float *z)
+{
+    int k = 0;
+    v[0] = 0;
+    z[0] = -SDF_FAR;
+    z[1] = SDF_FAR;
+
+    for (int q = 1; q < n; q++) {
+        float s = 0.0f;
+        do {
+            int p = v[k];
+            s = ((f[q*stride] + (float)(q*q)) - (f[p*stride] + (float)(p*p)))/(2.0f*(float)(q - p));
+        } while (s <= z[k] && --k >= 0);
+
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = SDF_FAR;
+    }
+
+    k = 0;
+    for (int q = 0; q < n; q++) {
+        while (z[k + 1] < (float)q) k++;
+        d[q] = (float)((q - v[k])*(q - v[k])) + f[v[k]*stride];
+    }
+    for (int q = 0; q < n; q++) f[q*stride] = d[q];
+}
+
+static void DistanceTransform2D(float *grid, int width, int height)
+{
+    int n = (width > height)? width : height;
+    float *d = (float *)MemAlloc(n*sizeof(float));
+    float *z = (float *)MemAlloc((n + 1)*sizeof(float));
+    int *v = (int *)MemAlloc(n*sizeof(int));
+
+    for (int x = 0; x < width; x++) DistanceTransform1D(grid + x, height, width, d, v, z);
+    for (int y = 0; y < height; y++) DistanceTransform1D(grid + y*width, width, 1, d, v, z);
+
+    MemFree(d);
+    MemFree(z);
+    MemFree(v);
+}
+
+// Replaces a supersampled coverage glyph by its distance field at base size
+// NOTE: stb_truetype SDF generation skips cubic curves (CFF outlines, as in rodin.otf), distances are
+// taken from the rasterized glyph instead, exact to 1/SDF_FONT_SUPERSAMPLE of a pixel
+static void GenGlyphDistanceField(GlyphInfo *glyph)
+{
+    const int ss = SDF_FONT_SUPERSAMPLE;
+    const int padding = SDF_FONT_GLYPH_PADDING;
+    const Image coverage = glyph->image;
+    int coverageWidth = (coverage.data != NULL)? coverage.width : 0;
+    int coverageHeight = (coverage.data != NULL)? coverage.height : 0;
+
+    // Field rectangle in base pixels, coverage bitmap position inside the supersampled grid
+    int fieldX = FloorDiv(glyph->offsetX, ss) - padding;
+    int fieldY = FloorDiv(glyph->offsetY, ss) - padding;
+    int width = FloorDiv(glyph->offsetX + coverageWidth + ss - 1, ss) + padding - fieldX;
+    int height = FloorDiv(glyph->offsetY + coverageHeight + ss - 1, ss) + padding - fieldY;
+    int gridWidth = width*ss, gridHeight = height*ss;
+    int coverageX = glyph->offsetX - fieldX*ss, coverageY = glyph->offsetY - fieldY*ss;
+
+    float *toInside = (float *)MemAlloc(gridWidth*gridHeight*sizeof(float));
+    float *toOutside = (float *)MemAlloc(gridWidth*gridHeight*sizeof(float));
+    unsigned char *field = (unsigned char *)MemAlloc(width*height);
+
+    for (int y = 0; y < gridHeight; y++) {
+        for (int x = 0; x < gridWidth; x++) {
+            int cx = x - coverageX, cy = y - coverageY;
+            bool inside = (cx >= 0) && (cy >= 0) && (cx < coverageWidth) && (cy < coverageHeight) &&
+                          (((const unsigned char *)coverage.data)[cy*coverage.width + cx] >= 128);
+
+            toInside[y*gridWidth + x] = inside? 0.0f : SDF_FAR;
+            toOutside[y*gridWidth + x] = inside? SDF_FAR : 0.0f;
+        }
+    }
+
+    DistanceTransform2D(toInside, gridWidth, gridHeight);
+    DistanceTransform2D(toOutside, gridWidth, gridHeight);
+
+    // Sampled at the supersampled pixel nearest to each field pixel center, edge half a pixel from it
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int k = (y*ss + ss/2)*gridWidth + (x*ss + ss/2);
+            float distance = (toInside[k] == 0.0f)? sqrtf(toOutside[k]) - 0.5f : 0.5f - sqrtf(toInside[k]);
+            float value = 128.0f + distance/(float)ss*(128.0f/SDF_FONT_SPREAD);
+
+            field[y*width + x] = (unsigned char)fminf(fmaxf(value, 0.0f), 255.0f);
+        }
+    }
+
+    MemFree(toInside);
+    MemFree(toOutside);
+    UnloadImage(glyph->image);
+
+    glyph->image = (Image){ field, width, height, 1, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE };
+    glyph->offsetX = fieldX;
+    glyph->offsetY = fieldY;
+    glyph->advanceX = (int)roundf((float)glyph->advanceX/(float)ss);
+}
+
+// FNV-1a of everything the baked atlas depends on, besides the font file
+static uint32_t GetBakeHash(const int *codepoints, int codepointCount)
+{
+    const int settings[] = { SDF_FONT_BASE_SIZE, SDF_FONT_SUPERSAMPLE, SDF_FONT_GLYPH_PADDING, SDF_FONT_ATLAS_PADDING, (int)(SDF_FONT_SPREAD*256.0f) };
+    uint32_t hash = 2166136261u;
+
+    for (int i = 0; i < (int)(sizeof(settings)/sizeof(settings[0])); i++) hash = (hash ^ (uint32_t)settings[i])*16777619u;
+    for (int i = 0; i < codepointCount; i++) hash = (hash ^ (uint32_t)codepoints[i])*16777619u;
+
+    return hash;
+}
+
+// Reads a baked font file: glyphs and rectangles into 'font', the atlas into 'atlas' (no texture yet)
+static bool LoadSdfFontFile(Font *font, Image *atlas, const char *fileName, uint32_t sourceSize, uint32_t bakeHash)
+{
+    int dataSize = 0;
+    const unsigned char *data = LoadFileDataMapped(fileName, &dataSize);
+    if (data == NULL) return false;
+
+    const SdfFontFileHeader *header = (const SdfFontFileHeader *)data;
+    bool valid = ((unsigned int)dataSize >= sizeof(SdfFontFileHeader)) &&
+                 (memcmp(header->magic, SDF_FONT_FILE_MAGIC, 4) == 0) &&
+                 (header->version == SDF_FONT_FILE_VERSION) &&
+                 (header->sourceSize == sourceSize) &&
+                 (header->bakeHash == bakeHash) &&
+                 (header->glyphCount > 0) && (header->glyphCount <= SDF_FONT_MAX_GLYPHS) &&
+                 (header->atlasWidth > 0) && (header->atlasWidth <= 4096) &&
+                 (header->atlasHeight > 0) && (header->atlasHeight <= 4096) &&
+                 ((unsigned int)dataSize == sizeof(SdfFontFileHeader) + header->glyphCount*sizeof(SdfGlyphRecord) + header->atlasWidth*header->atlasHeight);
+
+    Font sdf = { 0 };
+
+    if (valid) {
+        const SdfGlyphRecord *records = (const SdfGlyphRecord *)(data + sizeof(SdfFontFileHeader));
+
+        sdf.baseSize = SDF_FONT_BASE_SIZE;
+        sdf.glyphCount = (int)header->glyphCount;
+        sdf.glyphs = (GlyphInfo *)MemAlloc(sdf.glyphCount*sizeof(GlyphInfo));
+        sdf.recs = (Rectangle *)MemAlloc(sdf.glyphCount*sizeof(Rectangle));
+
+        for (int i = 0; i < sdf.glyphCount && valid; i++) {
+            const SdfGlyphRecord *record = &records[i];
+            if ((uint32_t)record->x + record->width > header->atlasWidth ||
+                (uint32_t)record->y + record->height > header->atlasHeight) valid = false;
+
+            sdf.glyphs[i] = (GlyphInfo){ record->codepoint, record->offsetX, record->offsetY, record->advanceX, { 0 } };
+            sdf.recs[i] = (Rectangle){ (float)record->x, (float)record->y, (float)record->width, (float)record->height };
+        }
+    }
+
+    if (valid) {
+        // NOTE: Only the distances are stored, the gray channel is always white
+        int pixelCount = (int)(header->atlasWidth*header->atlasHeight);
+        const unsigned char *field = data + sizeof(SdfFontFileHeader) + header->glyphCount*sizeof(SdfGlyphRecord);
+        *atlas = (Image){ MemAlloc(pixelCount*2), (int)header->atlasWidth, (int)header->atlasHeight, 1, PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA };
+
+        for (int i = 0; i < pixelCount; i++) {
+            ((unsigned char *)atlas->data)[i*2] = 255;
+            ((unsigned char *)atlas->data)[i*2 + 1] = field[i];
+        }
+    }
+
+    UnloadFileDataMapped(data);
+
+    if (!valid) {
+        TraceLog(LOG_INFO, "SDF: [%s] Baked font out of date or invalid, ignored", fileName);
+        MemFree(sdf.glyphs);
+        MemFree(sdf.recs);
+        return false;
+    }
+
+    *font = sdf;
+    return true;
+}
+
+static void SaveSdfFontFile(const Font *font, Image atlas, const char *fileName, uint32_t sourceSize, uint32_t bakeHash)
+{
+    int pixelCount = atlas.width*atlas.height;
+    int dataSize = (int)(sizeof(SdfFontFileHeader) + font->glyphCount*sizeof(SdfGlyphRecord)) + pixelCount;
+    unsigned char *data = (unsigned char *)MemAlloc(dataSize);
+
+    SdfFontFileHeader *header = (SdfFontFileHeader *)data;
+    memcpy(header->magic, SDF_FONT_FILE_MAGIC, 4);
+    header->version = SDF_FONT_FILE_VERSION;
+    header->sourceSize = sourceSize;
+    header->bakeHash = bakeHash;
+    header->glyphCount = (uint32_t)font->glyphCount;
+    header->atlasWidth = (uint32_t)atlas.width;
+    header->atlasHeight = (uint32_t)atlas.height;
+
+    SdfGlyphRecord *records = (SdfGlyphRecord *)(data + sizeof(SdfFontFileHeader));
+    for (int i = 0; i < font->glyphCount; i++) {
+        const GlyphInfo *glyph = &font->glyphs[i];
+        const Rectangle rec = font->recs[i];
+        records[i] = (SdfGlyphRecord){ glyph->value, (int16_t)glyph->offsetX, (int16_t)glyph->offsetY, (int16_t)glyph->advanceX,
+                                       (uint16_t)rec.x, (uint16_t)rec.y, (uint16_t)rec.width, (uint16_t)rec.height, 0 };
+    }
+
+    unsigned char *field = data + sizeof(SdfFontFileHeader) + font->glyphCount*sizeof(SdfGlyphRecord);
+    for (int i = 0; i < pixelCount; i++) field[i] = ((const unsigned char *)atlas.data)[i*2 + 1];
+
+    if (SaveFileData(fileName, data, dataSize)) TraceLog(LOG_INFO, "SDF: [%s] Baked font saved (%i bytes)", fileName, dataSize);
+    MemFree(data);
+}
+
+// Rasterizes the glyphs and builds the atlas image, saved to 'bakedFile' when given
+static bool BakeSdfFont(Font *font, Image *atlas, const char *fileName, const int *codepoints, int codepointCount,
+                        const char *bakedFile, uint32_t sourceSize, uint32_t bakeHash)
+{
+    int dataSize = 0;
+    const unsigned char *data = LoadFileDataMapped(fileName, &dataSize);
+    if (data == NULL) return false;
+
+    Font sdf = { 0 };
+    sdf.baseSize = SDF_FONT_BASE_SIZE;
+    sdf.glyphCount = codepointCount;
+    sdf.glyphs = LoadFontData(data, dataSize, SDF_FONT_BASE_SIZE*SDF_FONT_SUPERSAMPLE, (int *)codepoints, codepointCount, FONT_DEFAULT);
+    UnloadFileDataMapped(data);
+    if (sdf.glyphs == NULL) return false;
+
+    for (int i = 0; i < sdf.glyphCount; i++) GenGlyphDistanceField(&sdf.glyphs[i]);
+
+    // NOTE: Glyph images already hold the field padding, glyphPadding stays 0
+    *atlas = GenImageFontAtlas(sdf.glyphs, &sdf.recs, sdf.glyphCount, SDF_FONT_BASE_SIZE, SDF_FONT_ATLAS_PADDING, 1);
+
+    // Glyph images are only needed to build the atlas
+    for (int i = 0; i < sdf.glyphCount; i++) {
+        UnloadImage(sdf.glyphs[i].image);
+        sdf.glyphs[i].image = (Image){ 0 };
+    }
+
+    if (atlas->data == NULL) {
+        MemFree(sdf.glyphs);
+        MemFree(sdf.recs);
+        return false;
+    }
+
+    if (bakedFile != NULL) SaveSdfFontFile(&sdf, *atlas, bakedFile, sourceSize, bakeHash);
+
+    *font = sdf;
+    return true;
+}
+#endif
+
+// Font being loaded: the atlas is read or baked first (any thread), the texture and the shader made after
+typedef struct SdfFontLoad {
+    SdfFont *font;
+    char fileName[256];
+    char *glyphs;               // Copy of the glyph set, NULL for printable ASCII
+    int fallbackSize;
+    Font sdf;                   // Glyphs and rectangles read or baked, no texture yet
+    Image atlas;
+    bool baked;
+    double decodeTime;          // Milliseconds
+} SdfFontLoad;
+
+static bool DecodeSdfFont(void *context)
+{
+#if defined(SDF_FONT_SHADER)
+    SdfFontLoad *load = (SdfFontLoad *)context;
+    const char *fileName = load->fileName;
+    double startTime = GetTime();
+
+    // Printable ASCII when no glyph set is given
+    int asciiCodepoints[95] = { 0 };
+    for (int i = 0; i < 95; i++) asciiCodepoints[i] = 32 + i;
+
+    int codepointCount = 95;
+    int *codepoints = (load->glyphs != NULL)? LoadCodepoints(load->glyphs, &codepointCount) : asciiCodepoints;
+    if (codepointCount > SDF_FONT_MAX_GLYPHS) codepointCount = SDF_FONT_MAX_GLYPHS;
+
+    uint32_t bakeHash = GetBakeHash(codepoints, codepointCount);
+    uint32_t sourceSize = (uint32_t)GetFileLength(fileName);
+
+    // Baked file names: "font/rodin.otf" -> "font/rodin.sdf" in the assets, "<cache>/rodin.sdf"
+    char assetFile[256] = { 0 };
+    char cacheFile[512] = { 0 };
+    const char *extension = strrchr(fileName, '.');
+    int nameLength = (extension != NULL)? (int)(extension - fileName) : (int)strlen(fileName);
+    snprintf(assetFile, sizeof(assetFile), "%.*s.sdf", nameLength, fileName);
+
+    char *cacheDir = GetCacheDir();
+    if (cacheDir != NULL) {
+        snprintf(cacheFile, sizeof(cacheFile), "%s/%s", cacheDir, GetFileName(assetFile));
+        MemFree(cacheDir);
+    }
+
+    bool loaded = (sourceSize > 0) && (LoadSdfFontFile(&load->sdf, &load->atlas, assetFile, sourceSize, bakeHash) ||
+                                       ((cacheFile[0] != '\0') && LoadSdfFontFile(&load->sdf, &load->atlas, cacheFile, sourceSize, bakeHash)));
+
+    if (!loaded && (sourceSize > 0)) {
+        loaded = BakeSdfFont(&load->sdf, &load->atlas, fileName, codepoints, codepointCount, (cacheFile[0] != '\0')? cacheFile : NULL, sourceSize, bakeHash);
+        load->baked = loaded;
+    }
+
+    if (codepoints != asciiCodepoints) UnloadCodepoints(codepoints);
+    load->decodeTime = (GetTime() - startTime)*1000.0;
+
+    return loaded;
+#else
+    (void)context;
+    return false;
+#endif
+}
+
+static bool UploadSdfFont(void *context, bool decoded)
+{
+    SdfFontLoad *load = (SdfFontLoad *)context;
+    SdfFont font = { 0 };
+
+#if defined(SDF_FONT_SHADER)
+    if (decoded) {
+        font.shader = LoadShaderFromMemory(sdfVertexShader, sdfFragmentShader);
+
+        if (IsShaderValid(font.shader) && (font.shader.id != rlGetShaderIdDefault())) {
+            load->sdf.texture = LoadTextureFromImage(load->atlas);
+
+            if (load->sdf.texture.id != 0) {
+                SetTextureFilter(load->sdf.texture, TEXTURE_FILTER_BILINEAR);
+                TraceLog(LOG_INFO, "SDF: Font atlas %s in %.1f ms (%i glyphs, %ix%i)", load->baked? "baked" : "loaded",
+                         load->decodeTime, load->sdf.glyphCount, load->sdf.texture.width, load->sdf.texture.height);
+
+                font.font = load->sdf;
+                font.sdf = true;
+                font.shadowOffsetLoc = GetShaderLocation(font.shader, "shadowOffset");
+                font.shadowColorLoc = GetShaderLocation(font.shader, "shadowColor");
+                font.outlineWidthLoc = GetShaderLocation(font.shader, "outlineWidth");
+                font.outlineColorLoc = GetShaderLocation(font.shader, "outlineColor");
+            }
+        } else {
+            TraceLog(LOG_WARNING, "SDF: Shader failed to load, text uses a bitmap font");
+        }
+
+        if (!font.sdf && font.shader.id != 0 && font.shader.id != rlGetShaderIdDefault()) UnloadShader(font.shader);
+        if (!font.sdf) font.shader = (Shader){ 0 };
+    }
+#endif
+
+    if (!font.sdf) {
+        MemFree(load->sdf.glyphs);
+        MemFree(load->sdf.recs);
+
+        int codepointCount = 0;
+        int *codepoints = (load->glyphs != NULL)? LoadCodepoints(load->glyphs, &codepointCount) : NULL;
+        font.font = LoadFontEx(load->fileName, load->fallbackSize, codepoints, codepointCount);
+        if (codepoints != NULL) UnloadCodepoints(codepoints);
+        if (font.font.texture.id == 0) font.font = GetFontDefault();
+    }
+
+    UnloadImage(load->atlas);
+    MemFree(load->glyphs);
+    *load->font = font;
+
+    return font.sdf;
+}
+
+static bool UploadSdfFontAsync(void *context, bool decoded)
+{
+    bool sdf = UploadSdfFont(context, decoded);
+    MemFree(context);
+    return sdf;
+}
+
+static void InitSdfFontLoad(SdfFontLoad *load, SdfFont *font, const char *fileName, const char *glyphs, int fallbackSize)
+{
+    memset(load, 0, sizeof(SdfFontLoad));
+    load->font = font;
+    strncpy(load->fileName, fileName, sizeof(load->fileName) - 1);
+    load->fallbackSize = fallbackSize;
+
+    if (glyphs != NULL) {
+        int length = (int)strlen(glyphs);
+        load->glyphs = (char *)MemAlloc(length + 1);
+        memcpy(load->glyphs, glyphs, length + 1);
+    }
+}
+
+SdfFont LoadSdfFont(const char *fileName, const char *glyphs, int fallbackSize)
+{
+    SdfFont font = { 0 };
+    SdfFontLoad load = { 0 };
+    InitSdfFontLoad(&load, &font, fileName, glyphs, fallbackSize);
+    UploadSdfFont(&load, DecodeSdfFont(&load));
+
+    return font;
+}
+
+int LoadSdfFontAsync(AssetLoader *loader, SdfFont *font, const char *fileName, const char *glyphs, int fallbackSize)
+{
+    // NOTE: Text drawn before the job is done uses the raylib default font
+    memset(font, 0, sizeof(SdfFont));
+    font->font = GetFontDefault();
+
+    SdfFontLoad *load = (SdfFontLoad *)MemAlloc(sizeof(SdfFontLoad));
+    InitSdfFontLoad(load, font, fileName, glyphs, fallbackSize);
+
+    return AssetLoaderAdd(loader, fileName, DecodeSdfFont, UploadSdfFontAsync, load);
+}
+
+void UnloadSdfFont(SdfFont *font)
+{
+    if (font->shader.id != 0) UnloadShader(font->shader);
+    if (font->font.texture.id != GetFontDefault().texture.id) UnloadFont(font->font);
+    memset(font, 0, sizeof(SdfFont));
+}
+
+void BeginSdfText(const SdfFont *font, float fontSize, SdfTextStyle style)
+{
+    if (!font->sdf) return;
+
+    // Screen pixels to atlas units: texture coordinates for the offset, distance for the width
+    float atlasScale = (float)font->font.baseSize/fontSize;
+    float shadowOffset[2] = { style.shadowOffset.x*atlasScale/(float)font->font.texture.width,
+                              style.shadowOffset.y*atlasScale/(float)font->font.texture.height };
+    // NOTE: Outline edge is kept inside the stored range, distance 0 covers the whole glyph quad
+    float outlineWidth = fminf(style.outlineWidth*atlasScale/SDF_FONT_SPREAD, 0.9f)*0.5f;
+    Vector4 shadowColor = ColorNormalize(style.shadowColor);
+    Vector4 outlineColor = ColorNormalize(style.outlineColor);
+    if (style.outlineWidth <= 0.0f) outlineColor.w = 0.0f;
+
+    // NOTE: Uniforms are common to the whole batch, BeginShaderMode() flushes what was batched before
+    BeginShaderMode(font->shader);
+    SetShaderValue(font->shader, font->shadowOffsetLoc, shadowOffset, SHADER_UNIFORM_VEC2);
+    SetShaderValue(font->shader, font->shadowColorLoc, &shadowColor, SHADER_UNIFORM_VEC4);
+    SetShaderValue(font->shader, font->outlineWidthLoc, &outlineWidth, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(font->shader, font->outlineColorLoc, &outlineColor, SHADER_UNIFORM_VEC4);
+}
+
+void EndSdfText(const SdfFont *font)
+{
+    if (font->sdf) EndShaderMode();
+}
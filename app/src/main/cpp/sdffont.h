@@ -0,0 +1,106 @@
+#ifndef SDFFONT_H
+#define SDFFONT_H
+
+#include "raylib.h"
+#include "assetloader.h"
+
+#include <stdint.h>
+
+// --- SDF Font ---
+// Glyphs are stored as signed distance fields in one small atlas and drawn with a built-in shader
+// that stays sharp at any size. The same shader adds the outline and the drop shadow, so outlined or
+// shadowed text is a single draw instead of one per layer.
+// Needs OpenGL ES 3.0 (GL_VERSION ES30 or higher), other builds, or a shader that fails to load, get
+// a bitmap font and draw without the effects.
+#define SDF_FONT_BASE_SIZE          32      // Glyph size in the atlas, any drawn size is resampled from it
+#define SDF_FONT_SUPERSAMPLE         4      // Glyphs are rasterized this many times larger, then turned into distances
+#define SDF_FONT_GLYPH_PADDING       4      // Field pixels around each glyph, shadows and outlines must fit in them
+#define SDF_FONT_ATLAS_PADDING       4      // Atlas pixels between glyphs, shadows sample up to this far outside a glyph
+#define SDF_FONT_SPREAD           2.0f      // Field pixels from the edge to the farthest distance stored
+
+// --- SDF Font File Format ---
+// Baking the atlas reads the whole font and rasterizes every glyph, so the result is saved as
+// <font name>.sdf: header, one record per glyph, then the atlas pixels, all values little-endian.
+// It is looked up next to the font in the assets first (prebaked, shipped in the APK), then in the app
+// cache directory (baked and saved by the first launch). A file made for another font file, glyph set
+// or SDF_FONT_* settings is ignored and baked again.
+#define SDF_FONT_FILE_MAGIC         "SDFB"
+#define SDF_FONT_FILE_VERSION       1
+#define SDF_FONT_MAX_GLYPHS         256
+
+typedef struct SdfFontFileHeader {
+    char magic[4];              // SDF_FONT_FILE_MAGIC
+    uint32_t version;           // SDF_FONT_FILE_VERSION
+    uint32_t sourceSize;        // Size of the font file it was baked from
+    uint32_t bakeHash;          // Glyph set and SDF_FONT_* settings it was baked with
+    uint32_t glyphCount;        // SdfGlyphRecord[glyphCount] follow the header
+    uint32_t atlasWidth;        // Atlas distances (1 byte per pixel) follow the records
+    uint32_t atlasHeight;
+} SdfFontFileHeader;
+
+typedef struct SdfGlyphRecord {
+    int32_t codepoint;
+    int16_t offsetX;            // Field offset from the pen position, base size pixels
+    int16_t offsetY;
+    int16_t advanceX;
+    uint16_t x;                 // Field rectangle in the atlas
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+    uint16_t reserved;
+} SdfGlyphRecord;
+
+#if defined(GRAPHICS_API_OPENGL_ES3) || defined(GRAPHICS_API_OPENGL_33)
+    #define SDF_FONT_SHADER
+#endif
+
+// Effects for text drawn between BeginSdfText() and EndSdfText(), sizes in screen pixels
+typedef struct SdfTextStyle {
+    Vector2 shadowOffset;       // Drop shadow offset, limited by the glyph padding
+    Color shadowColor;          // BLANK for no shadow
+    float outlineWidth;         // 0 for no outline, limited by SDF_FONT_SPREAD
+    Color outlineColor;
+} SdfTextStyle;
+
+typedef struct SdfFont {
+    Font font;
+    bool sdf;                   // Distance field atlas and shader loaded, otherwise font is a plain bitmap font
+    Shader shader;
+    int shadowOffsetLoc;
+    int shadowColorLoc;
+    int outlineWidthLoc;
+    int outlineColorLoc;
+} SdfFont;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Loads a TTF/OTF font as SDF (after InitWindow()), only the characters of 'glyphs' (UTF-8).
+ *
+ * The baked atlas is cached (see SDF_FONT_FILE_MAGIC). Falls back to a bitmap font of 'fallbackSize'
+ * pixels when SDF text is not available, and to the raylib default font when the file can't be loaded.
+ * Characters missing from 'glyphs' are drawn as '?' (keep it in the set).
+ */
+SdfFont LoadSdfFont(const char *fileName, const char *glyphs, int fallbackSize);
+
+/**
+ * @brief Queues LoadSdfFont() on 'loader', returns the job handle ('font' is the default font until it is done).
+ */
+int LoadSdfFontAsync(AssetLoader *loader, SdfFont *font, const char *fileName, const char *glyphs, int fallbackSize);
+
+void UnloadSdfFont(SdfFont *font);
+
+/**
+ * @brief Starts drawing text of 'fontSize' with 'style' (shadow and outline are skipped on a bitmap font).
+ */
+void BeginSdfText(const SdfFont *font, float fontSize, SdfTextStyle style);
+
+void EndSdfText(const SdfFont *font);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // SDFFONT_H
@@ -0,0 +1,304 @@
+#include "shapecache.h"
+#include "rlgl.h"
+
+#include <math.h>
+#include <string.h>
+
+#define SHAPE_CIRCLE_ERROR_RATE   0.5f      // rshapes SMOOTH_CIRCLE_ERROR_RATE
+
+// Shapes texture rectangle corners, as used by rshapes
+enum { CORNER_TOP_LEFT = 0, CORNER_TOP_RIGHT, CORNER_BOTTOM_RIGHT, CORNER_BOTTOM_LEFT };
+
+// Corner angles and segment counts of DrawRectangleRounded() and DrawRectangleRoundedLinesEx()
+static const float cornerAngles[4] = { 180.0f, 270.0f, 0.0f, 90.0f };
+
+static int GetCornerSegments(float radius, int segments, float divider)
+{
+    if (segments >= 4) return segments;
+
+    float th = acosf(2*powf(1 - SHAPE_CIRCLE_ERROR_RATE/radius, 2) - 1);
+    segments = (int)(ceilf(2*PI/th)/divider);
+
+    return (segments <= 0)? 4 : segments;
+}
+
+static bool ReserveShapeVertices(ShapeMesh *mesh, int count)
+{
+    mesh->vertexCount = 0;
+    if (count <= mesh->vertexCapacity) return true;
+
+    Vector2 *vertices = (Vector2 *)MemRealloc(mesh->vertices, count*sizeof(Vector2));
+    if (vertices == NULL) return false;
+    mesh->vertices = vertices;
+
+    unsigned char *corners = (unsigned char *)MemRealloc(mesh->corners, count);
+    if (corners == NULL) return false;
+    mesh->corners = corners;
+
+    mesh->vertexCapacity = count;
+    return true;
+}
+
+static void AddShapeVertex(ShapeMesh *mesh, float x, float y, int corner)
+{
+    mesh->vertices[mesh->vertexCount] = (Vector2){ x, y };
+    mesh->corners[mesh->vertexCount] = (unsigned char)corner;
+    mesh->vertexCount++;
+}
+
+static void AddArcVertex(ShapeMesh *mesh, Vector2 center, float angle, float radius, int corner)
+{
+    AddShapeVertex(mesh, center.x + cosf(DEG2RAD*angle)*radius, center.y + sinf(DEG2RAD*angle)*radius, corner);
+}
+
+static void AddShapeQuad(ShapeMesh *mesh, Vector2 a, Vector2 b, Vector2 c, Vector2 d)
+{
+    AddShapeVertex(mesh, a.x, a.y, CORNER_TOP_LEFT);
+    AddShapeVertex(mesh, b.x, b.y, CORNER_BOTTOM_LEFT);
+    AddShapeVertex(mesh, c.x, c.y, CORNER_BOTTOM_RIGHT);
+    AddShapeVertex(mesh, d.x, d.y, CORNER_TOP_RIGHT);
+}
+
+// Quads of DrawCircleSector(), every quad covers two segments
+static void AddFanQuads(ShapeMesh *mesh, Vector2 center, float radius, float angle, float stepLength, int segments)
+{
+    for (int i = 0; i < segments/2; i++) {
+        AddShapeVertex(mesh, center.x, center.y, CORNER_TOP_LEFT);
+        AddArcVertex(mesh, center, angle + stepLength*2.0f, radius, CORNER_TOP_RIGHT);
+        AddArcVertex(mesh, center, angle + stepLength, radius, CORNER_BOTTOM_RIGHT);
+        AddArcVertex(mesh, center, angle, radius, CORNER_BOTTOM_LEFT);
+        angle += stepLength*2.0f;
+    }
+
+    if (segments%2) {
+        AddShapeVertex(mesh, center.x, center.y, CORNER_TOP_LEFT);
+        AddArcVertex(mesh, center, angle + stepLength, radius, CORNER_BOTTOM_RIGHT);
+        AddArcVertex(mesh, center, angle, radius, CORNER_BOTTOM_LEFT);
+        AddShapeVertex(mesh, center.x, center.y, CORNER_TOP_RIGHT);
+    }
+}
+
+// Geometry of DrawRectangleRounded() with the rectangle at (0, 0)
+static bool BuildRoundedRect(ShapeMesh *mesh)
+{
+    float width = mesh->width, height = mesh->height;
+    float radius = ((width > height)? height : width)*fminf(mesh->roundness, 1.0f)/2;
+    int segments = GetCornerSegments(radius, mesh->segments, 4.0f);
+    float stepLength = 90.0f/(float)segments;
+
+    mesh->mode = RL_QUADS;
+    if (!ReserveShapeVertices(mesh, 4*(4*(segments/2 + segments%2) + 5))) return false;
+
+    const Vector2 point[12] = {
+        { radius, 0 }, { width - radius, 0 }, { width, radius },                        // P0, P1, P2
+        { width, height - radius }, { width - radius, height },                         // P3, P4
+        { radius, height }, { 0, height - radius }, { 0, radius },                      // P5, P6, P7
+        { radius, radius }, { width - radius, radius },                                 // P8, P9
+        { width - radius, height - radius }, { radius, height - radius }                // P10, P11
+    };
+
+    for (int k = 0; k < 4; k++) AddFanQuads(mesh, point[8 + k], radius, cornerAngles[k], stepLength, segments);
+
+    AddShapeQuad(mesh, point[0], point[8], point[9], point[1]);     // Upper
+    AddShapeQuad(mesh, point[2], point[9], point[10], point[3]);    // Right
+    AddShapeQuad(mesh, point[11], point[5], point[4], point[10]);   // Bottom
+    AddShapeQuad(mesh, point[7], point[6], point[11], point[8]);    // Left
+    AddShapeQuad(mesh, point[8], point[11], point[10], point[9]);   // Middle
+
+    return true;
+}
+
+// Geometry of DrawRectangleRoundedLinesEx() with the rectangle at (0, 0), lines up to 1 pixel thick
+static bool BuildRoundedRectLines(ShapeMesh *mesh)
+{
+    float width = mesh->width, height = mesh->height, lineThick = mesh->lineThick;
+    float radius = ((width > height)? height : width)*fminf(mesh->roundness, 1.0f)/2;
+    int segments = GetCornerSegments(radius, mesh->segments, 2.0f);
+    float stepLength = 90.0f/(float)segments;
+    const float outerRadius = radius + lineThick, innerRadius = radius;
+
+    const Vector2 point[16] = {
+        { innerRadius, -lineThick }, { width - innerRadius, -lineThick }, { width + lineThick, innerRadius },  // P0, P1, P2
+        { width + lineThick, height - innerRadius }, { width - innerRadius, height + lineThick },              // P3, P4
+        { innerRadius, height + lineThick }, { -lineThick, height - innerRadius }, { -lineThick, innerRadius }, // P5, P6, P7
+        { innerRadius, 0 }, { width - innerRadius, 0 },                                                        // P8, P9
+        { width, innerRadius }, { width, height - innerRadius },                                               // P10, P11
+        { width - innerRadius, height }, { innerRadius, height },                                              // P12, P13
+        { 0, height - innerRadius }, { 0, innerRadius }                                                        // P14, P15
+    };
+    const Vector2 centers[4] = {
+        { innerRadius, innerRadius }, { width - innerRadius, innerRadius },
+        { width - innerRadius, height - innerRadius }, { innerRadius, height - innerRadius }
+    };
+
+    if (lineThick > 1) {
+        mesh->mode = RL_QUADS;
+        if (!ReserveShapeVertices(mesh, 4*(4*segments + 4))) return false;
+
+        for (int k = 0; k < 4; k++) {
+            float angle = cornerAngles[k];
+
+            for (int i = 0; i < segments; i++) {
+                AddArcVertex(mesh, centers[k], angle, innerRadius, CORNER_TOP_LEFT);
+                AddArcVertex(mesh, centers[k], angle + stepLength, innerRadius, CORNER_TOP_RIGHT);
+                AddArcVertex(mesh, centers[k], angle + stepLength, outerRadius, CORNER_BOTTOM_RIGHT);
+                AddArcVertex(mesh, centers[k], angle, outerRadius, CORNER_BOTTOM_LEFT);
+                angle += stepLength;
+            }
+        }
+
+        AddShapeQuad(mesh, point[0], point[8], point[9], point[1]);     // Upper
+        AddShapeQuad(mesh, point[2], point[10], point[11], point[3]);   // Right
+        AddShapeQuad(mesh, point[13], point[5], point[4], point[12]);   // Lower
+        AddShapeQuad(mesh, point[15], point[7], point[6], point[14]);   // Left
+    } else {
+        mesh->mode = RL_LINES;
+        if (!ReserveShapeVertices(mesh, 2*(4*segments + 4))) return false;
+
+        for (int k = 0; k < 4; k++) {
+            float angle = cornerAngles[k];
+
+            for (int i = 0; i < segments; i++) {
+                AddArcVertex(mesh, centers[k], angle, outerRadius, CORNER_TOP_LEFT);
+                AddArcVertex(mesh, centers[k], angle + stepLength, outerRadius, CORNER_TOP_LEFT);
+                angle += stepLength;
+            }
+        }
+
+        for (int i = 0; i < 8; i++) AddShapeVertex(mesh, point[i].x, point[i].y, CORNER_TOP_LEFT);
+    }
+
+    return true;
+}
+
+// Geometry of DrawCircleV() around (0, 0)
+static bool BuildCircle(ShapeMesh *mesh)
+{
+    int segments = mesh->segments;
+    float radius = (mesh->width <= 0.0f)? 0.1f : mesh->width;
+
+    mesh->mode = RL_QUADS;
+    if (!ReserveShapeVertices(mesh, 4*(segments/2 + segments%2))) return false;
+
+    AddFanQuads(mesh, (Vector2){ 0.0f, 0.0f }, radius, 0.0f, 360.0f/(float)segments, segments);
+
+    return true;
+}
+
+static const ShapeMesh *GetShapeMesh(ShapeCache *cache, ShapeMeshType type, float width, float height, float roundness, int segments, float lineThick)
+{
+    ShapeMesh *mesh = NULL;
+    cache->useCounter++;
+
+    for (int i = 0; i < SHAPE_CACHE_MESHES; i++) {
+        ShapeMesh *candidate = &cache->meshes[i];
+
+        if (candidate->type == type && candidate->width == width && candidate->height == height &&
+            candidate->roundness == roundness && candidate->segments == segments && candidate->lineThick == lineThick) {
+            candidate->lastUse = cache->useCounter;
+            return candidate;
+        }
+
+        // Replaced if not found: least recently used mesh (empty slots were never used)
+        if (mesh == NULL || candidate->lastUse < mesh->lastUse) mesh = candidate;
+    }
+
+    mesh->type = type;
+    mesh->lastUse = cache->useCounter;
+    mesh->width = width;
+    mesh->height = height;
+    mesh->roundness = roundness;
+    mesh->segments = segments;
+    mesh->lineThick = lineThick;
+
+    bool built = false;
+    if (type == SHAPE_MESH_ROUNDED_RECT) built = BuildRoundedRect(mesh);
+    else if (type == SHAPE_MESH_ROUNDED_RECT_LINES) built = BuildRoundedRectLines(mesh);
+    else if (type == SHAPE_MESH_CIRCLE) built = BuildCircle(mesh);
+
+    if (!built) {
+        mesh->type = SHAPE_MESH_NONE;
+        mesh->vertexCount = 0;
+        return NULL;
+    }
+
+    return mesh;
+}
+
+static void DrawShapeMesh(const ShapeMesh *mesh, Vector2 position, Color color)
+{
+    float u[4] = { 0 }, v[4] = { 0 };
+
+    if (mesh->mode == RL_QUADS) {
+        Texture2D texture = GetShapesTexture();
+        Rectangle shapeRect = GetShapesTextureRectangle();
+
+        u[CORNER_TOP_LEFT] = u[CORNER_BOTTOM_LEFT] = shapeRect.x/texture.width;
+        u[CORNER_TOP_RIGHT] = u[CORNER_BOTTOM_RIGHT] = (shapeRect.x + shapeRect.width)/texture.width;
+        v[CORNER_TOP_LEFT] = v[CORNER_TOP_RIGHT] = shapeRect.y/texture.height;
+        v[CORNER_BOTTOM_LEFT] = v[CORNER_BOTTOM_RIGHT] = (shapeRect.y + shapeRect.height)/texture.height;
+
+        rlSetTexture(texture.id);
+    }
+
+    // NOTE: rlVertex3f() flushes the batch between quads (or lines) when it fills up
+    rlBegin(mesh->mode);
+
+        rlColor4ub(color.r, color.g, color.b, color.a);
+
+        if (mesh->mode == RL_QUADS) {
+            for (int i = 0; i < mesh->vertexCount; i++) {
+                int corner = mesh->corners[i];
+                rlTexCoord2f(u[corner], v[corner]);
+                rlVertex2f(position.x + mesh->vertices[i].x, position.y + mesh->vertices[i].y);
+            }
+        } else {
+            for (int i = 0; i < mesh->vertexCount; i++) rlVertex2f(position.x + mesh->vertices[i].x, position.y + mesh->vertices[i].y);
+        }
+
+    rlEnd();
+
+    if (mesh->mode == RL_QUADS) rlSetTexture(0);
+}
+
+void DrawRectangleRoundedCached(ShapeCache *cache, Rectangle rec, float roundness, int segments, Color color)
+{
+    // Shapes without corners are left to rshapes, as are meshes that could not be allocated
+    const ShapeMesh *mesh = NULL;
+    if (roundness > 0.0f && rec.width >= 1 && rec.height >= 1) {
+        mesh = GetShapeMesh(cache, SHAPE_MESH_ROUNDED_RECT, rec.width, rec.height, roundness, segments, 0.0f);
+    }
+
+    if (mesh != NULL) DrawShapeMesh(mesh, (Vector2){ rec.x, rec.y }, color);
+    else DrawRectangleRounded(rec, roundness, segments, color);
+}
+
+void DrawRectangleRoundedLinesCached(ShapeCache *cache, Rectangle rec, float roundness, int segments, float lineThick, Color color)
+{
+    if (lineThick < 0) lineThick = 0;
+
+    const ShapeMesh *mesh = NULL;
+    if (roundness > 0.0f && fminf(rec.width, rec.height) > 0.0f) {
+        mesh = GetShapeMesh(cache, SHAPE_MESH_ROUNDED_RECT_LINES, rec.width, rec.height, roundness, segments, lineThick);
+    }
+
+    if (mesh != NULL) DrawShapeMesh(mesh, (Vector2){ rec.x, rec.y }, color);
+    else DrawRectangleRoundedLinesEx(rec, roundness, segments, lineThick, color);
+}
+
+void DrawCircleCached(ShapeCache *cache, Vector2 center, float radius, Color color)
+{
+    const ShapeMesh *mesh = GetShapeMesh(cache, SHAPE_MESH_CIRCLE, radius, 0.0f, 0.0f, SHAPE_CIRCLE_SEGMENTS, 0.0f);
+
+    if (mesh != NULL) DrawShapeMesh(mesh, center, color);
+    else DrawCircleV(center, radius, color);
+}
+
+void UnloadShapeCache(ShapeCache *cache)
+{
+    for (int i = 0; i < SHAPE_CACHE_MESHES; i++) {
+        MemFree(cache->meshes[i].vertices);
+        MemFree(cache->meshes[i].corners);
+    }
+    memset(cache, 0, sizeof(ShapeCache));
+}
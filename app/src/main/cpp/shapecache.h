@@ -0,0 +1,68 @@
+#ifndef SHAPECACHE_H
+#define SHAPECACHE_H
+
+#include "raylib.h"
+
+// --- Shape Mesh Cache ---
+// DrawRectangleRounded(), DrawRectangleRoundedLines() and DrawCircleV() evaluate sinf()/cosf() for
+// every corner segment of every shape, every frame, although UI shapes keep the same size for many
+// frames. A shape mesh keeps those vertices (relative to the rectangle corner or the circle center)
+// and replays them straight into the render batch, same geometry and texture coordinates as rshapes.
+// Meshes are keyed by shape, size, roundness, segments and line thickness, the least recently used
+// one is replaced when full.
+#define SHAPE_CACHE_MESHES          16      // Shape meshes kept by a cache
+#define SHAPE_CIRCLE_SEGMENTS       36      // Same as DrawCircleV()
+
+typedef enum {
+    SHAPE_MESH_NONE = 0,                // Empty slot
+    SHAPE_MESH_ROUNDED_RECT,
+    SHAPE_MESH_ROUNDED_RECT_LINES,
+    SHAPE_MESH_CIRCLE
+} ShapeMeshType;
+
+typedef struct ShapeMesh {
+    ShapeMeshType type;
+    unsigned int lastUse;       // Cache use counter value when the mesh was last requested
+    float width;                // Circle radius for SHAPE_MESH_CIRCLE
+    float height;
+    float roundness;
+    float lineThick;
+    int segments;               // As requested, 0 or less picks them from the size like rshapes
+    int mode;                   // RL_QUADS (shapes texture) or RL_LINES
+    Vector2 *vertices;          // Relative to the rectangle top left corner or the circle center
+    unsigned char *corners;     // Shapes texture rectangle corner of each vertex (RL_QUADS only)
+    int vertexCount;
+    int vertexCapacity;
+} ShapeMesh;
+
+typedef struct ShapeCache {
+    ShapeMesh meshes[SHAPE_CACHE_MESHES];
+    unsigned int useCounter;
+} ShapeCache;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Same output as DrawRectangleRounded(), built the first time this size is drawn.
+ */
+void DrawRectangleRoundedCached(ShapeCache *cache, Rectangle rec, float roundness, int segments, Color color);
+
+/**
+ * @brief Same output as DrawRectangleRoundedLinesEx(), built the first time this size is drawn.
+ */
+void DrawRectangleRoundedLinesCached(ShapeCache *cache, Rectangle rec, float roundness, int segments, float lineThick, Color color);
+
+/**
+ * @brief Same output as DrawCircleV(), built the first time this radius is drawn.
+ */
+void DrawCircleCached(ShapeCache *cache, Vector2 center, float radius, Color color);
+
+void UnloadShapeCache(ShapeCache *cache);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // SHAPECACHE_H
@@ -0,0 +1,401 @@
+#include "course.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define ALIGN4(n) (((n) + 3u) & ~3u)
+
+// Checks that an array of 'count' elements at 'offset' lies inside the file and is aligned
+static bool IsRangeValid(const CoursePack *pack, uint32_t offset, uint32_t count, uint32_t elementSize)
+{
+    if ((offset & 3u) != 0) return false;
+    if (offset > pack->dataSize) return false;
+    if (count > (pack->dataSize - offset)/elementSize) return false;
+    return true;
+}
+
+bool CoursePackInit(CoursePack *pack, const void *data, unsigned int dataSize)
+{
+    memset(pack, 0, sizeof(CoursePack));
+    if (data == NULL || dataSize < sizeof(CourseFileHeader)) return false;
+
+    // NOTE: Data is read in place, buffers returned by LoadFileData()/malloc() are suitably aligned
+    if (((uintptr_t)data & 3u) != 0) return false;
+
+    const CourseFileHeader *header = (const CourseFileHeader *)data;
+    if (memcmp(header->magic, COURSE_FILE_MAGIC, 4) != 0) return false;
+    if (header->version != COURSE_FILE_VERSION) return false;
+    if (header->fileSize > dataSize) return false;
+
+    pack->data = (const unsigned char *)data;
+    pack->dataSize = header->fileSize;
+
+    if (!IsRangeValid(pack, header->holeTableOffset, header->holeCount, sizeof(CourseHoleRecord))) return false;
+    const CourseHoleRecord *holes = (const CourseHoleRecord *)(pack->data + header->holeTableOffset);
+
+    for (uint32_t i = 0; i < header->holeCount; i++) {
+        const CourseHoleRecord *hole = &holes[i];
+
+        if (!IsRangeValid(pack, hole->wallOffset, hole->wallCount, sizeof(PhysicsSegment)) ||
+            !IsRangeValid(pack, hole->bumperOffset, hole->bumperCount, sizeof(PhysicsBumper)) ||
+            !IsRangeValid(pack, hole->areaOffset, hole->areaCount, sizeof(PhysicsArea)) ||
+            hole->wallCount + hole->bumperCount > UINT16_MAX) return false;
+
+        // NOTE: Each side is bounded before the product, which can't wrap then
+        if (hole->gridCols < 0 || hole->gridRows < 0 || hole->gridCols > COURSE_GRID_MAX_CELLS || hole->gridRows > COURSE_GRID_MAX_CELLS) return false;
+        uint64_t gridCells = (uint64_t)hole->gridCols*(uint64_t)hole->gridRows;
+        if (gridCells > COURSE_GRID_MAX_CELLS) return false;
+        uint32_t cells = (uint32_t)gridCells;
+        if (cells > 0) {
+            if (!(hole->gridCellSize > 0.0f)) return false;
+            if (!IsRangeValid(pack, hole->gridCellOffset, cells + 1, sizeof(uint32_t)) ||
+                !IsRangeValid(pack, hole->gridItemOffset, hole->gridItemCount, sizeof(uint16_t))) return false;
+
+            // NOTE: SweepItem() trusts the grid, cell ranges must be in order and items must be obstacles
+            const uint32_t *cellStart = (const uint32_t *)(pack->data + hole->gridCellOffset);
+            for (uint32_t c = 0; c < cells; c++) if (cellStart[c] > cellStart[c + 1]) return false;
+            if (cellStart[cells] > hole->gridItemCount) return false;
+
+            const uint16_t *items = (const uint16_t *)(pack->data + hole->gridItemOffset);
+            for (uint32_t k = 0; k < hole->gridItemCount; k++) if (items[k] >= hole->wallCount + hole->bumperCount) return false;
+        }
+
+        if (hole->terrainCols < 0 || hole->terrainRows < 0 ||
+            hole->terrainCols > COURSE_TERRAIN_MAX_SAMPLES || hole->terrainRows > COURSE_TERRAIN_MAX_SAMPLES) return false;
+        uint64_t terrainSamples = (uint64_t)hole->terrainCols*(uint64_t)hole->terrainRows;
+        if (terrainSamples > COURSE_TERRAIN_MAX_SAMPLES) return false;
+        uint32_t samples = (uint32_t)terrainSamples;
+        if (samples > 0) {
+            if (hole->terrainCols < 2 || hole->terrainRows < 2 || !(hole->terrainCellSize > 0.0f)) return false;
+            if (!IsRangeValid(pack, hole->terrainOffset, samples, sizeof(PhysicsTerrainSample))) return false;
+        }
+    }
+
+    pack->holes = holes;
+    pack->holeCount = (int)header->holeCount;
+
+    return true;
+}
+
+CourseHole CoursePackGetHole(const CoursePack *pack, int index)
+{
+    CourseHole result = { 0 };
+    if (pack->holes == NULL || index < 0 || index >= pack->holeCount) return result;
+
+    const CourseHoleRecord *hole = &pack->holes[index];
+    const unsigned char *data = pack->data;
+
+    result.start = hole->start;
+    result.cup = hole->cup;
+    result.size = hole->size;
+    result.par = hole->par;
+
+    result.geometry.walls = (const PhysicsSegment *)(data + hole->wallOffset);
+    result.geometry.wallCount = (int)hole->wallCount;
+    result.geometry.bumpers = (const PhysicsBumper *)(data + hole->bumperOffset);
+    result.geometry.bumperCount = (int)hole->bumperCount;
+    result.geometry.areas = (const PhysicsArea *)(data + hole->areaOffset);
+    result.geometry.areaCount = (int)hole->areaCount;
+
+    if (hole->gridCols > 0 && hole->gridRows > 0) {
+        result.geometry.grid.origin = hole->gridOrigin;
+        result.geometry.grid.cellSize = hole->gridCellSize;
+        result.geometry.grid.cols = hole->gridCols;
+        result.geometry.grid.rows = hole->gridRows;
+        result.geometry.grid.cellStart = (const uint32_t *)(data + hole->gridCellOffset);
+        result.geometry.grid.items = (const uint16_t *)(data + hole->gridItemOffset);
+    }
+
+    if (hole->terrainCols > 0 && hole->terrainRows > 0) {
+        result.geometry.terrain.origin = hole->terrainOrigin;
+        result.geometry.terrain.cellSize = hole->terrainCellSize;
+        result.geometry.terrain.cols = hole->terrainCols;
+        result.geometry.terrain.rows = hole->terrainRows;
+        result.geometry.terrain.slopeScale = hole->terrainSlopeScale;
+        result.geometry.terrain.heightScale = hole->terrainHeightScale;
+        result.geometry.terrain.samples = (const PhysicsTerrainSample *)(data + hole->terrainOffset);
+    }
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------
+// Course baking
+//----------------------------------------------------------------------------------
+
+typedef struct { float minX, minY, maxX, maxY; } Bounds;
+
+// Bounds of one obstacle (item index as in PhysicsGrid), inflated by the ball radius
+static Bounds GetItemBounds(const CourseHoleDesc *desc, int item)
+{
+    Bounds b;
+    if (item < desc->wallCount) {
+        PhysicsSegment w = desc->walls[item];
+        b.minX = fminf(w.a.x, w.b.x) - BALL_RADIUS;
+        b.maxX = fmaxf(w.a.x, w.b.x) + BALL_RADIUS;
+        b.minY = fminf(w.a.y, w.b.y) - BALL_RADIUS;
+        b.maxY = fmaxf(w.a.y, w.b.y) + BALL_RADIUS;
+    }
+    else {
+        PhysicsBumper bumper = desc->bumpers[item - desc->wallCount];
+        float r = bumper.radius + BALL_RADIUS;
+        b.minX = bumper.center.x - r;
+        b.maxX = bumper.center.x + r;
+        b.minY = bumper.center.y - r;
+        b.maxY = bumper.center.y + r;
+    }
+    return b;
+}
+
+// Grid layout of one hole, covering the playfield and every obstacle
+typedef struct {
+    Vector2 origin;
+    float cellSize;
+    int cols;
+    int rows;
+    uint32_t *cellStart;
+    uint16_t *items;
+    uint32_t itemCount;
+} GridBuild;
+
+static void GetItemCells(const GridBuild *grid, Bounds b, int *x0, int *y0, int *x1, int *y1)
+{
+    *x0 = (int)floorf((b.minX - grid->origin.x)/grid->cellSize);
+    *y0 = (int)floorf((b.minY - grid->origin.y)/grid->cellSize);
+    *x1 = (int)floorf((b.maxX - grid->origin.x)/grid->cellSize);
+    *y1 = (int)floorf((b.maxY - grid->origin.y)/grid->cellSize);
+    if (*x0 < 0) *x0 = 0;
+    if (*y0 < 0) *y0 = 0;
+    if (*x1 >= grid->cols) *x1 = grid->cols - 1;
+    if (*y1 >= grid->rows) *y1 = grid->rows - 1;
+}
+
+static bool BuildGrid(const CourseHoleDesc *desc, GridBuild *grid)
+{
+    int itemCount = desc->wallCount + desc->bumperCount;
+    memset(grid, 0, sizeof(GridBuild));
+    if (itemCount == 0) return true;
+
+    Bounds all = { 0.0f, 0.0f, desc->size.x, desc->size.y };
+    for (int i = 0; i < itemCount; i++) {
+        Bounds b = GetItemBounds(desc, i);
+        all.minX = fminf(all.minX, b.minX);
+        all.minY = fminf(all.minY, b.minY);
+        all.maxX = fmaxf(all.maxX, b.maxX);
+        all.maxY = fmaxf(all.maxY, b.maxY);
+    }
+
+    grid->origin = (Vector2){ all.minX, all.minY };
+    grid->cellSize = COURSE_GRID_CELL_SIZE;
+    for (;;) {
+        grid->cols = (int)ceilf((all.maxX - all.minX)/grid->cellSize);
+        grid->rows = (int)ceilf((all.maxY - all.minY)/grid->cellSize);
+        if (grid->cols < 1) grid->cols = 1;
+        if (grid->rows < 1) grid->rows = 1;
+        if (grid->cols*grid->rows <= COURSE_GRID_MAX_CELLS) break;
+        grid->cellSize *= 2.0f;
+    }
+
+    int cells = grid->cols*grid->rows;
+    grid->cellStart = (uint32_t *)calloc(cells + 1, sizeof(uint32_t));
+    if (grid->cellStart == NULL) return false;
+
+    // 1st pass: count items per cell, 2nd pass: fill (counting sort)
+    for (int i = 0; i < itemCount; i++) {
+        int x0, y0, x1, y1;
+        GetItemCells(grid, GetItemBounds(desc, i), &x0, &y0, &x1, &y1);
+        for (int y = y0; y <= y1; y++) for (int x = x0; x <= x1; x++) grid->cellStart[y*grid->cols + x + 1]++;
+    }
+    for (int c = 0; c < cells; c++) grid->cellStart[c + 1] += grid->cellStart[c];
+
+    grid->itemCount = grid->cellStart[cells];
+    grid->items = (uint16_t *)malloc((grid->itemCount + 1)*sizeof(uint16_t));
+    uint32_t *fill = (uint32_t *)malloc(cells*sizeof(uint32_t));
+    if (grid->items == NULL || fill == NULL) {
+        free(fill);
+        return false;
+    }
+    memcpy(fill, grid->cellStart, cells*sizeof(uint32_t));
+
+    for (int i = 0; i < itemCount; i++) {
+        int x0, y0, x1, y1;
+        GetItemCells(grid, GetItemBounds(desc, i), &x0, &y0, &x1, &y1);
+        for (int y = y0; y <= y1; y++) for (int x = x0; x <= x1; x++) grid->items[fill[y*grid->cols + x]++] = (uint16_t)i;
+    }
+
+    free(fill);
+    return true;
+}
+
+// Checks the terrain of a hole description, false when it has none
+static bool HasTerrain(const CourseHoleDesc *desc)
+{
+    return ((desc->terrainHeights != NULL) || (desc->terrainFriction != NULL)) &&
+           (desc->terrainCols >= 2) && (desc->terrainRows >= 2) && (desc->terrainCellSize > 0.0f);
+}
+
+static uint8_t QuantizeUnit(float value, float scale)
+{
+    return (uint8_t)lrintf(fminf(fmaxf(value, 0.0f), 1.0f)*scale);
+}
+
+// Height gradient of one sample, central differences inside the grid and one-sided on its edges
+static Vector2 GetHeightGradient(const CourseHoleDesc *desc, int x, int y)
+{
+    const float *h = desc->terrainHeights;
+    int cols = desc->terrainCols;
+    int x0 = (x > 0)? x - 1 : x, x1 = (x < cols - 1)? x + 1 : x;
+    int y0 = (y > 0)? y - 1 : y, y1 = (y < desc->terrainRows - 1)? y + 1 : y;
+
+    return (Vector2){
+        (h[y*cols + x1] - h[y*cols + x0])/((float)(x1 - x0)*desc->terrainCellSize),
+        (h[y1*cols + x] - h[y0*cols + x])/((float)(y1 - y0)*desc->terrainCellSize)
+    };
+}
+
+// Bakes the terrain samples and scales of one hole into its record
+static void BakeTerrain(const CourseHoleDesc *desc, CourseHoleRecord *record, PhysicsTerrainSample *samples)
+{
+    float slopeScale = 0.0f;
+    float minHeight = 0.0f, maxHeight = 0.0f;
+
+    if (desc->terrainHeights != NULL) {
+        minHeight = maxHeight = desc->terrainHeights[0];
+        for (int y = 0; y < desc->terrainRows; y++) {
+            for (int x = 0; x < desc->terrainCols; x++) {
+                Vector2 gradient = GetHeightGradient(desc, x, y);
+                float height = desc->terrainHeights[y*desc->terrainCols + x];
+                slopeScale = fmaxf(slopeScale, TERRAIN_GRAVITY*fmaxf(fabsf(gradient.x), fabsf(gradient.y)));
+                minHeight = fminf(minHeight, height);
+                maxHeight = fmaxf(maxHeight, height);
+            }
+        }
+    }
+    if (slopeScale <= 0.0f) slopeScale = 1.0f;      // Flat, any scale decodes to no push
+
+    for (int y = 0; y < desc->terrainRows; y++) {
+        for (int x = 0; x < desc->terrainCols; x++) {
+            int i = y*desc->terrainCols + x;
+            PhysicsTerrainSample *sample = &samples[i];
+            sample->slopeX = 128;
+            sample->slopeY = 128;
+            sample->height = 0;
+            sample->friction = (desc->terrainFriction != NULL)? QuantizeUnit(desc->terrainFriction[i], 255.0f) : 255;
+
+            if (desc->terrainHeights != NULL) {
+                // Downhill push, -TERRAIN_GRAVITY times the gradient, as 1..255 around 128
+                Vector2 gradient = GetHeightGradient(desc, x, y);
+                sample->slopeX = (uint8_t)(1 + QuantizeUnit((-TERRAIN_GRAVITY*gradient.x/slopeScale + 1.0f)*0.5f, 254.0f));
+                sample->slopeY = (uint8_t)(1 + QuantizeUnit((-TERRAIN_GRAVITY*gradient.y/slopeScale + 1.0f)*0.5f, 254.0f));
+                if (maxHeight > minHeight) sample->height = QuantizeUnit((desc->terrainHeights[i] - minHeight)/(maxHeight - minHeight), 255.0f);
+            }
+        }
+    }
+
+    record->terrainOrigin = desc->terrainOrigin;
+    record->terrainCellSize = desc->terrainCellSize;
+    record->terrainCols = desc->terrainCols;
+    record->terrainRows = desc->terrainRows;
+    record->terrainSlopeScale = slopeScale;
+    record->terrainHeightScale = maxHeight - minHeight;
+}
+
+unsigned char *CoursePackBuild(const CourseHoleDesc *holes, int holeCount, unsigned int *dataSize)
+{
+    *dataSize = 0;
+    if (holeCount < 0) return NULL;
+
+    GridBuild *grids = (GridBuild *)calloc(holeCount + 1, sizeof(GridBuild));
+    if (grids == NULL) return NULL;
+
+    bool ok = true;
+    uint32_t size = ALIGN4(sizeof(CourseFileHeader));
+    uint32_t tableOffset = size;
+    size += holeCount*sizeof(CourseHoleRecord);
+
+    // Compute the layout first, so the whole file is one allocation
+    for (int i = 0; i < holeCount && ok; i++) {
+        if (holes[i].wallCount + holes[i].bumperCount > UINT16_MAX) ok = false;
+        else if (HasTerrain(&holes[i]) && (holes[i].terrainCols*holes[i].terrainRows > COURSE_TERRAIN_MAX_SAMPLES)) ok = false;
+        else ok = BuildGrid(&holes[i], &grids[i]);
+
+        size += holes[i].wallCount*sizeof(PhysicsSegment);
+        size += holes[i].bumperCount*sizeof(PhysicsBumper);
+        size += holes[i].areaCount*sizeof(PhysicsArea);
+        if (grids[i].cols > 0) size += (grids[i].cols*grids[i].rows + 1)*sizeof(uint32_t);
+        size += ALIGN4(grids[i].itemCount*sizeof(uint16_t));
+        if (HasTerrain(&holes[i])) size += holes[i].terrainCols*holes[i].terrainRows*sizeof(PhysicsTerrainSample);
+    }
+
+    unsigned char *data = ok? (unsigned char *)calloc(1, size) : NULL;
+
+    if (data != NULL) {
+        CourseFileHeader *header = (CourseFileHeader *)data;
+        memcpy(header->magic, COURSE_FILE_MAGIC, 4);
+        header->version = COURSE_FILE_VERSION;
+        header->fileSize = size;
+        header->holeCount = (uint32_t)holeCount;
+        header->holeTableOffset = tableOffset;
+
+        CourseHoleRecord *records = (CourseHoleRecord *)(data + tableOffset);
+        uint32_t offset = tableOffset + holeCount*sizeof(CourseHoleRecord);
+
+        for (int i = 0; i < holeCount; i++) {
+            const CourseHoleDesc *desc = &holes[i];
+            CourseHoleRecord *record = &records[i];
+            GridBuild *grid = &grids[i];
+
+            record->start = desc->start;
+            record->cup = desc->cup;
+            record->size = desc->size;
+            record->par = desc->par;
+
+            record->wallOffset = offset;
+            record->wallCount = (uint32_t)desc->wallCount;
+            if (desc->wallCount > 0) memcpy(data + offset, desc->walls, desc->wallCount*sizeof(PhysicsSegment));
+            offset += desc->wallCount*sizeof(PhysicsSegment);
+
+            record->bumperOffset = offset;
+            record->bumperCount = (uint32_t)desc->bumperCount;
+            if (desc->bumperCount > 0) memcpy(data + offset, desc->bumpers, desc->bumperCount*sizeof(PhysicsBumper));
+            offset += desc->bumperCount*sizeof(PhysicsBumper);
+
+            record->areaOffset = offset;
+            record->areaCount = (uint32_t)desc->areaCount;
+            if (desc->areaCount > 0) memcpy(data + offset, desc->areas, desc->areaCount*sizeof(PhysicsArea));
+            offset += desc->areaCount*sizeof(PhysicsArea);
+
+            record->gridOrigin = grid->origin;
+            record->gridCellSize = grid->cellSize;
+            record->gridCols = grid->cols;
+            record->gridRows = grid->rows;
+            record->gridCellOffset = offset;
+            if (grid->cols > 0) {
+                uint32_t cellBytes = (grid->cols*grid->rows + 1)*sizeof(uint32_t);
+                memcpy(data + offset, grid->cellStart, cellBytes);
+                offset += cellBytes;
+            }
+            record->gridItemOffset = offset;
+            record->gridItemCount = grid->itemCount;
+            if (grid->itemCount > 0) memcpy(data + offset, grid->items, grid->itemCount*sizeof(uint16_t));
+            offset += ALIGN4(grid->itemCount*sizeof(uint16_t));
+
+            record->terrainOffset = offset;
+            if (HasTerrain(desc)) {
+                BakeTerrain(desc, record, (PhysicsTerrainSample *)(data + offset));
+                offset += desc->terrainCols*desc->terrainRows*sizeof(PhysicsTerrainSample);
+            }
+        }
+
+        *dataSize = size;
+    }
+
+    for (int i = 0; i < holeCount; i++) {
+        free(grids[i].cellStart);
+        free(grids[i].items);
+    }
+    free(grids);
+
+    return data;
+}
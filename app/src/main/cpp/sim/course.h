@@ -0,0 +1,132 @@
+#ifndef COURSE_H
+#define COURSE_H
+
+#include "physics.h"
+
+// --- Course File Format ---
+// A course file is a pack of holes laid out exactly as the game uses them in memory:
+// header, hole table, then per hole the obstacle arrays, a prebuilt uniform grid and the baked terrain.
+// All offsets are from the start of the file and 4-byte aligned, all values little-endian.
+// Loading is one read plus a few bounds checks, switching holes is pointer arithmetic.
+#define COURSE_FILE_MAGIC           "GOLF"
+#define COURSE_FILE_VERSION         2
+#define COURSE_GRID_CELL_SIZE       128.0f  // Preferred grid cell size (grows for very large holes)
+#define COURSE_GRID_MAX_CELLS       4096    // Upper bound on cols*rows per hole
+#define COURSE_TERRAIN_MAX_SAMPLES  65536   // Upper bound on terrain cols*rows per hole (256 KB)
+
+typedef struct CourseFileHeader {
+    char magic[4];              // COURSE_FILE_MAGIC
+    uint32_t version;           // COURSE_FILE_VERSION
+    uint32_t fileSize;          // Total size in bytes
+    uint32_t holeCount;
+    uint32_t holeTableOffset;   // CourseHoleRecord[holeCount]
+} CourseFileHeader;
+
+typedef struct CourseHoleRecord {
+    Vector2 start;              // Ball start position
+    Vector2 cup;                // Hole position
+    Vector2 size;               // Playfield size (0, 0 to use the screen size)
+    int32_t par;
+    uint32_t flags;             // Reserved
+
+    uint32_t wallOffset;        // PhysicsSegment[wallCount]
+    uint32_t wallCount;
+    uint32_t bumperOffset;      // PhysicsBumper[bumperCount]
+    uint32_t bumperCount;
+    uint32_t areaOffset;        // PhysicsArea[areaCount]
+    uint32_t areaCount;
+
+    // Spatial index (see PhysicsGrid)
+    Vector2 gridOrigin;
+    float gridCellSize;
+    int32_t gridCols;
+    int32_t gridRows;
+    uint32_t gridCellOffset;    // uint32_t[gridCols*gridRows + 1]
+    uint32_t gridItemOffset;    // uint16_t[gridItemCount]
+    uint32_t gridItemCount;
+
+    // Terrain (see PhysicsTerrain), gradients and channels already baked
+    Vector2 terrainOrigin;
+    float terrainCellSize;
+    int32_t terrainCols;        // 0 for a flat green
+    int32_t terrainRows;
+    float terrainSlopeScale;
+    float terrainHeightScale;
+    uint32_t terrainOffset;     // PhysicsTerrainSample[terrainCols*terrainRows]
+} CourseHoleRecord;
+
+// View over a course file in memory (the data is not copied nor owned)
+typedef struct CoursePack {
+    const unsigned char *data;
+    unsigned int dataSize;
+    const CourseHoleRecord *holes;
+    int holeCount;
+} CoursePack;
+
+// One hole, ready for PhysicsSetGeometry()
+typedef struct CourseHole {
+    Vector2 start;
+    Vector2 cup;
+    Vector2 size;
+    int par;
+    PhysicsGeometry geometry;
+} CourseHole;
+
+// Authoring description of a hole, input of CoursePackBuild()
+typedef struct CourseHoleDesc {
+    Vector2 start;
+    Vector2 cup;
+    Vector2 size;
+    int par;
+    const PhysicsSegment *walls;
+    int wallCount;
+    const PhysicsBumper *bumpers;
+    int bumperCount;
+    const PhysicsArea *areas;
+    int areaCount;
+
+    // Optional terrain, one value per sample on a terrainCols x terrainRows grid (at least 2x2), row by row
+    const float *terrainHeights;    // Height (px), NULL for a flat green
+    const float *terrainFriction;   // Velocity kept per reference frame (multiplies FRICTION), NULL keeps it all
+    Vector2 terrainOrigin;
+    float terrainCellSize;
+    int terrainCols;
+    int terrainRows;
+} CourseHoleDesc;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Validates a course file in place and sets up a view over it.
+ *
+ * Only the header, hole table and spatial index are checked (sizes, offsets, alignment, grid ranges and items),
+ * nothing is parsed nor copied.
+ * The data must stay alive and unchanged while the pack is used.
+ *
+ * @return true if the data is a valid course file of the supported version.
+ */
+bool CoursePackInit(CoursePack *pack, const void *data, unsigned int dataSize);
+
+/**
+ * @brief Gets one hole of the pack, its geometry points directly into the pack data.
+ */
+CourseHole CoursePackGetHole(const CoursePack *pack, int index);
+
+/**
+ * @brief Builds a course file from hole descriptions, including each hole's spatial index and baked terrain.
+ *
+ * Terrain heights are turned into slopes (central differences) and both are quantized to PhysicsTerrainSample.
+ *
+ * @warning This function returns data allocated on the heap, release it with free().
+ *
+ * @return The file data (NULL on failure), its size is written to 'dataSize'.
+ */
+unsigned char *CoursePackBuild(const CourseHoleDesc *holes, int holeCount, unsigned int *dataSize);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // COURSE_H
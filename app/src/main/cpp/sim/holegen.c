@@ -0,0 +1,177 @@
+#include "holegen.h"
+
+#define RAYMATH_STATIC_INLINE
+#include "raymath.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HOLEGEN_DENSITY             0.7f    // Poisson-disk samples per spacing^2 at most (area packing bound)
+
+// Deterministic random numbers, the same set on every device for the same seed
+static float RandomFloat(uint32_t *state)
+{
+    uint32_t x = (*state += 0x9e3779b9u);
+    x ^= x >> 16; x *= 0x7feb352du;
+    x ^= x >> 15; x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return (float)(x >> 8)*(1.0f/16777216.0f);
+}
+
+static float GetSegmentDistance(Vector2 point, PhysicsSegment segment)
+{
+    Vector2 ab = Vector2Subtract(segment.b, segment.a);
+    float lengthSqr = Vector2LengthSqr(ab);
+    float t = (lengthSqr > 0.0f)? Vector2DotProduct(Vector2Subtract(point, segment.a), ab)/lengthSqr : 0.0f;
+    t = fminf(fmaxf(t, 0.0f), 1.0f);
+
+    return Vector2Distance(point, Vector2Add(segment.a, Vector2Scale(ab, t)));
+}
+
+// Checks the cup keeps HOLEGEN_CLEARANCE to every obstacle and water area
+static bool IsCupClear(const PhysicsGeometry *geometry, Vector2 cup)
+{
+    for (int i = 0; i < geometry->wallCount; i++) {
+        if (GetSegmentDistance(cup, geometry->walls[i]) < HOLEGEN_CLEARANCE) return false;
+    }
+    for (int i = 0; i < geometry->bumperCount; i++) {
+        const PhysicsBumper *bumper = &geometry->bumpers[i];
+        if (Vector2Distance(cup, bumper->center) - bumper->radius < HOLEGEN_CLEARANCE) return false;
+    }
+    for (int i = 0; i < geometry->areaCount; i++) {
+        const PhysicsArea *area = &geometry->areas[i];
+        if (area->type != AREA_WATER) continue;
+
+        float dx = fmaxf(fmaxf(area->x - cup.x, cup.x - (area->x + area->width)), 0.0f);
+        float dy = fmaxf(fmaxf(area->y - cup.y, cup.y - (area->y + area->height)), 0.0f);
+        if (dx*dx + dy*dy < HOLEGEN_CLEARANCE*HOLEGEN_CLEARANCE) return false;
+    }
+
+    return true;
+}
+
+// Poisson-disk sampling (Bridson): samples spawn new ones between 1 and 2 spacings away,
+// a background grid of spacing/sqrt(2) cells holds at most one sample each
+static int GenerateSamples(Vector2 *samples, Vector2 origin, Vector2 extent, uint32_t seed)
+{
+    float area = extent.x*extent.y;
+    float spacing = fmaxf(HOLEGEN_SPACING, sqrtf(area*HOLEGEN_DENSITY/HOLEGEN_MAX_CANDIDATES));
+    float cellSize = spacing/sqrtf(2.0f);
+    int cols = (int)ceilf(extent.x/cellSize);
+    int rows = (int)ceilf(extent.y/cellSize);
+
+    int *grid = (int *)malloc((size_t)cols*rows*sizeof(int));
+    int *active = (int *)malloc(HOLEGEN_MAX_CANDIDATES*sizeof(int));
+    if (grid == NULL || active == NULL) {
+        free(grid);
+        free(active);
+        return 0;
+    }
+    for (int i = 0; i < cols*rows; i++) grid[i] = -1;
+
+    uint32_t rng = seed;
+    int count = 0, activeCount = 0;
+
+    Vector2 first = { origin.x + RandomFloat(&rng)*extent.x, origin.y + RandomFloat(&rng)*extent.y };
+    samples[count] = first;
+    grid[(int)((first.y - origin.y)/cellSize)*cols + (int)((first.x - origin.x)/cellSize)] = count;
+    active[activeCount++] = count++;
+
+    while ((activeCount > 0) && (count < HOLEGEN_MAX_CANDIDATES)) {
+        int slot = (int)(RandomFloat(&rng)*activeCount);
+        if (slot >= activeCount) slot = activeCount - 1;
+        Vector2 parent = samples[active[slot]];
+        bool spawned = false;
+
+        for (int attempt = 0; (attempt < HOLEGEN_ATTEMPTS) && !spawned; attempt++) {
+            // NOTE: Uniform over the annulus by rejection, no libm trigonometry (results differ between libms)
+            Vector2 offset = { (4.0f*RandomFloat(&rng) - 2.0f)*spacing, (4.0f*RandomFloat(&rng) - 2.0f)*spacing };
+            float distanceSqr = Vector2LengthSqr(offset);
+            if (distanceSqr < spacing*spacing || distanceSqr >= 4.0f*spacing*spacing) continue;
+            Vector2 point = Vector2Add(parent, offset);
+
+            if (point.x < origin.x || point.y < origin.y || point.x >= origin.x + extent.x || point.y >= origin.y + extent.y) continue;
+
+            int cx = (int)((point.x - origin.x)/cellSize);
+            int cy = (int)((point.y - origin.y)/cellSize);
+            if (cx >= cols || cy >= rows) continue;
+
+            bool clear = true;
+            for (int y = (cy > 1)? cy - 2 : 0; clear && (y <= cy + 2) && (y < rows); y++) {
+                for (int x = (cx > 1)? cx - 2 : 0; (x <= cx + 2) && (x < cols); x++) {
+                    int other = grid[y*cols + x];
+                    if ((other >= 0) && (Vector2DistanceSqr(samples[other], point) < spacing*spacing)) {
+                        clear = false;
+                        break;
+                    }
+                }
+            }
+            if (!clear) continue;
+
+            samples[count] = point;
+            grid[cy*cols + cx] = count;
+            active[activeCount++] = count++;
+            spawned = true;
+        }
+
+        if (!spawned) active[slot] = active[--activeCount];
+    }
+
+    free(grid);
+    free(active);
+
+    return count;
+}
+
+void HoleCandidatesBuild(HoleCandidates *set, Vector2 size, Vector2 start, PhysicsGeometry geometry, uint32_t seed)
+{
+    memset(set, 0, sizeof(HoleCandidates));
+    set->size = size;
+    set->start = start;
+    set->geometry = geometry;
+    set->seed = seed;
+
+    Vector2 origin = { HOLEGEN_MARGIN, HOLEGEN_MARGIN };
+    Vector2 extent = { size.x - 2.0f*HOLEGEN_MARGIN, size.y - 2.0f*HOLEGEN_MARGIN };
+    if (extent.x <= 0.0f || extent.y <= 0.0f) return;
+
+    set->sampleCount = GenerateSamples(set->cups, origin, extent, seed);
+
+    // Filters, compacted in place (sample order is kept, so picks stay spread over the playfield)
+    Vector2 farthest = { 0 };
+    float farthestDistance = -1.0f;
+
+    for (int i = 0; i < set->sampleCount; i++) {
+        Vector2 cup = set->cups[i];
+        if (!IsCupClear(&geometry, cup)) continue;
+
+        float distance = Vector2Distance(cup, start);
+        if (distance > farthestDistance) {
+            farthest = cup;
+            farthestDistance = distance;
+        }
+        if (distance >= HOLEGEN_MIN_START_DISTANCE) set->cups[set->count++] = cup;
+    }
+
+    // NOTE: A playfield too small for the start distance still gets a hole, as far as it can be
+    if ((set->count == 0) && (farthestDistance >= 0.0f)) {
+        set->cups[set->count++] = farthest;
+        set->relaxed = true;
+    }
+}
+
+bool HoleCandidatesMatch(const HoleCandidates *set, Vector2 size, Vector2 start, PhysicsGeometry geometry)
+{
+    return (set->size.x == size.x) && (set->size.y == size.y) && (set->start.x == start.x) && (set->start.y == start.y) &&
+           (set->geometry.walls == geometry.walls) && (set->geometry.wallCount == geometry.wallCount) &&
+           (set->geometry.bumpers == geometry.bumpers) && (set->geometry.bumperCount == geometry.bumperCount) &&
+           (set->geometry.areas == geometry.areas) && (set->geometry.areaCount == geometry.areaCount);
+}
+
+Vector2 HoleCandidatesPick(const HoleCandidates *set, uint32_t random)
+{
+    if (set->count == 0) return (Vector2){ set->size.x/2.0f, set->size.y/2.0f };
+
+    return set->cups[random%(uint32_t)set->count];
+}
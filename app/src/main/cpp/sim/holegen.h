@@ -0,0 +1,59 @@
+#ifndef HOLEGEN_H
+#define HOLEGEN_H
+
+#include "physics.h"
+
+// --- Procedural Holes ---
+// Random cups come from a candidate set built once per playfield (screen size), start and course: a
+// Poisson-disk sample of the playfield (no two cups closer than the spacing, so picks are spread evenly),
+// filtered against the distance to the start and the clearance to walls, bumpers and water. A new hole
+// is then one pick, however small the screen or busy the course. Sets only depend on their inputs and
+// the seed (plain float arithmetic, no FMA contraction), so tools/shotsim builds the same set as the
+// game and checks every cup can be holed (-p).
+#define HOLEGEN_MAX_CANDIDATES      512     // Samples per set (the spacing grows on playfields that would need more)
+#define HOLEGEN_SPACING             80.0f   // Minimum distance between two candidates (px)
+#define HOLEGEN_MARGIN              50.0f   // Distance to the playfield edges
+#define HOLEGEN_MIN_START_DISTANCE  300.0f  // Distance to the ball start
+#define HOLEGEN_CLEARANCE           60.0f   // Distance to walls, bumpers and water
+#define HOLEGEN_ATTEMPTS            30      // Samples tried around each candidate (Bridson's k)
+#define HOLEGEN_DEFAULT_SEED        0x484f4c45u
+
+// Cup candidates of one playfield, start and course
+typedef struct HoleCandidates {
+    Vector2 size;               // Inputs the set was built for
+    Vector2 start;
+    PhysicsGeometry geometry;
+    uint32_t seed;
+
+    Vector2 cups[HOLEGEN_MAX_CANDIDATES];
+    int count;                  // Candidates passing every filter
+    int sampleCount;            // Poisson-disk samples before filtering
+    bool relaxed;               // Nothing far enough from the start, the farthest clear cup is the only candidate
+} HoleCandidates;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Builds the cup candidates of a playfield (Bridson's Poisson-disk algorithm, then the filters).
+ *
+ * The geometry arrays are only read during the build, they are compared by HoleCandidatesMatch().
+ */
+void HoleCandidatesBuild(HoleCandidates *set, Vector2 size, Vector2 start, PhysicsGeometry geometry, uint32_t seed);
+
+/**
+ * @brief Checks if a set was built for this playfield, start and course (to keep it cached).
+ */
+bool HoleCandidatesMatch(const HoleCandidates *set, Vector2 size, Vector2 start, PhysicsGeometry geometry);
+
+/**
+ * @brief Picks a cup, 'random' is any random value. The playfield center when the set is empty.
+ */
+Vector2 HoleCandidatesPick(const HoleCandidates *set, uint32_t random);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // HOLEGEN_H
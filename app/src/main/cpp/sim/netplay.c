@@ -0,0 +1,525 @@
+#include "netplay.h"
+#include "varint.h"
+
+#include <string.h>
+#include <math.h>
+
+#define NETPLAY_MAGIC               'N'
+#define NETPLAY_STATE_FIELDS        10      // 32-bit fields of a ball state, hashed and delta encoded
+
+// Packet sections, flagged in the header (acknowledgements are always there)
+#define NETPLAY_HAS_ROUND           0x01    // Host: round setup, until the guest is in the round
+#define NETPLAY_HAS_SHOTS           0x02    // Shots the peer doesn't have
+#define NETPLAY_HAS_REST            0x04    // Hash of the sender ball once its last shot came to rest
+#define NETPLAY_HAS_SNAPSHOT        0x08    // Sender ball state, asked for by the peer
+#define NETPLAY_WANTS_SNAPSHOT      0x10    // Peer ball hash differs from the local result
+
+// Bytes left for shots once every other section has its largest size
+#define NETPLAY_SHOTS_BUDGET        (NETPLAY_MAX_PACKET_SIZE - 2 - 8*VARINT_MAX_SIZE - REPLAY_ROUND_INFO_MAX_SIZE - \
+                                     3*VARINT_MAX_SIZE - (NETPLAY_STATE_FIELDS + 2)*VARINT_MAX_SIZE)
+#define NETPLAY_SHOT_MAX_SIZE       (3*VARINT_MAX_SIZE)
+
+// Packet as read, applied only once it is known to be valid
+typedef struct NetplayPacket {
+    uint32_t sessionId;
+    uint32_t flags;
+    uint32_t round;
+    ReplayRoundInfo info;
+    uint32_t shotsAck;
+    uint32_t restAck;
+    uint32_t snapshotAck;
+    uint32_t firstShot;
+    uint32_t shotCount;
+    NetplayShot shots[NETPLAY_SHOTS_PER_PACKET];    // Ticks relative to the shot before the first one
+    uint32_t restShot;
+    uint32_t restTick;
+    uint32_t restHash;
+    uint32_t snapshotId;
+    uint32_t baselineId;
+    uint32_t snapshotFields[NETPLAY_STATE_FIELDS];
+} NetplayPacket;
+
+//----------------------------------------------------------------------------------
+// Ball states
+//----------------------------------------------------------------------------------
+static NetplayBallState GetBallState(const PhysicsWorld *world, const GolfPlayer *player, unsigned int shot, unsigned int tick)
+{
+    NetplayBallState state = { 0 };
+    state.shot = shot;
+    state.tick = tick;
+    state.position = PhysicsGetBallPosition(world, player->ball);
+    state.velocity = PhysicsGetBallVelocity(world, player->ball);
+    state.lastShotPosition = player->lastShotPosition;
+    state.strokes = player->strokes;
+    state.holed = player->holed;
+
+    return state;
+}
+
+static void SetBallState(PhysicsWorld *world, GolfPlayer *player, const NetplayBallState *state)
+{
+    PhysicsSetBallState(world, player->ball, state->position, state->velocity);
+    player->lastShotPosition = state->lastShotPosition;
+    player->strokes = state->strokes;
+    player->holed = state->holed;
+
+    // NOTE: A holed ball only has to stay out of play, it rests in the cup
+    if (state->holed) world->balls.sunk[player->ball] = true;
+}
+
+// State every peer knows without a snapshot, the first delta baseline
+static NetplayBallState GetRoundStartState(const NetplaySession *session)
+{
+    NetplayBallState state = { 0 };
+    state.position = session->roundInfo.start;
+    state.lastShotPosition = session->roundInfo.start;
+
+    return state;
+}
+
+static void GetStateFields(const NetplayBallState *state, uint32_t *fields)
+{
+    fields[0] = state->shot;
+    fields[1] = state->tick;
+    fields[2] = FloatBits(state->position.x);
+    fields[3] = FloatBits(state->position.y);
+    fields[4] = FloatBits(state->velocity.x);
+    fields[5] = FloatBits(state->velocity.y);
+    fields[6] = FloatBits(state->lastShotPosition.x);
+    fields[7] = FloatBits(state->lastShotPosition.y);
+    fields[8] = (uint32_t)state->strokes;
+    fields[9] = state->holed? 1 : 0;
+}
+
+static NetplayBallState SetStateFields(const uint32_t *fields)
+{
+    NetplayBallState state = { 0 };
+    state.shot = fields[0];
+    state.tick = fields[1];
+    state.position = (Vector2){ BitsFloat(fields[2]), BitsFloat(fields[3]) };
+    state.velocity = (Vector2){ BitsFloat(fields[4]), BitsFloat(fields[5]) };
+    state.lastShotPosition = (Vector2){ BitsFloat(fields[6]), BitsFloat(fields[7]) };
+    state.strokes = (int)fields[8];
+    state.holed = (fields[9] != 0);
+
+    return state;
+}
+
+uint32_t NetplayHashBall(const NetplayBallState *state)
+{
+    uint32_t fields[NETPLAY_STATE_FIELDS];
+    GetStateFields(state, fields);
+
+    // FNV-1a over the field bytes
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < NETPLAY_STATE_FIELDS; i++) {
+        for (int b = 0; b < 4; b++) {
+            hash ^= (fields[i] >> (8*b)) & 0xff;
+            hash *= 16777619u;
+        }
+    }
+
+    return hash;
+}
+
+//----------------------------------------------------------------------------------
+// Session
+//----------------------------------------------------------------------------------
+static void ResetRound(NetplaySession *session, unsigned int round, const ReplayRoundInfo *info)
+{
+    session->round = round;
+    session->roundInfo = *info;
+    session->peerInRound = false;
+
+    session->shotCount = 0;
+    session->shotsAcked = 0;
+    memset(&session->rest, 0, sizeof(session->rest));
+    session->restHash = 0;
+    session->restAcked = true;
+    session->snapshotRequested = false;
+    memset(session->snapshotIds, 0, sizeof(session->snapshotIds));
+    session->snapshotId = 0;
+    session->snapshotAcked = 0;
+
+    session->peerShotCount = 0;
+    session->peerShotsApplied = 0;
+    session->peerTick = 0;
+    session->peerTime = 0;
+    session->peerAnchor = GetRoundStartState(session);
+    memset(&session->peerRest, 0, sizeof(session->peerRest));
+    session->peerRestHash = 0;
+    session->peerRestChecked = false;
+    session->desync = false;
+    session->snapshotReady = false;
+    session->peerBaseline = GetRoundStartState(session);
+    session->peerSnapshotId = 0;
+    session->ackPending = true;
+}
+
+void NetplayInit(NetplaySession *session, bool host, uint32_t sessionId)
+{
+    memset(session, 0, sizeof(NetplaySession));
+    session->host = host;
+    session->sessionId = sessionId;
+    session->restAcked = true;
+}
+
+void NetplayBeginRound(NetplaySession *session, const ReplayRoundInfo *info, unsigned int tick)
+{
+    if (!session->host) return;
+    ResetRound(session, session->round + 1, info);
+    session->startTick = tick;
+}
+
+bool NetplayTakeRound(NetplaySession *session, ReplayRoundInfo *info, unsigned int tick)
+{
+    if (!session->roundStarted) return false;
+    session->roundStarted = false;
+    session->startTick = tick;
+    *info = session->roundInfo;
+
+    return true;
+}
+
+void NetplayStartPeerWorld(const NetplaySession *session, PhysicsWorld *world, PhysicsGeometry geometry, GolfPlayer *opponent)
+{
+    const ReplayRoundInfo *info = &session->roundInfo;
+
+    PhysicsInit(world, info->tickRate);
+    PhysicsSetGeometry(world, geometry);
+    world->hole = info->cup;
+    world->width = info->size.x;
+    world->height = info->size.y;
+
+    opponent->ball = PhysicsAddBall(world, info->start);
+    GolfPlayerStart(opponent, world, info->start);
+}
+
+void NetplayRecordShot(NetplaySession *session, unsigned int tick, Vector2 dragVector)
+{
+    if (session->round == 0 || session->shotCount >= NETPLAY_MAX_SHOTS) return;
+
+    NetplayShot *shot = &session->shots[session->shotCount++];
+    shot->tick = tick - session->startTick;
+    shot->drag = GolfQuantizeDrag(dragVector);
+}
+
+void NetplayRecordRest(NetplaySession *session, const PhysicsWorld *world, const GolfPlayer *player)
+{
+    if (session->round == 0 || session->shotCount == 0 || session->rest.shot == session->shotCount) return;
+
+    session->rest = GetBallState(world, player, session->shotCount, world->tick - session->startTick);
+    session->restHash = NetplayHashBall(&session->rest);
+    session->restAcked = false;
+}
+
+// Checks if the opponent has to be re-simulated from its anchor: a shot or a rest hash older than the simulation
+static bool IsPeerBehind(NetplaySession *session)
+{
+    if ((session->peerShotsApplied < session->peerShotCount) &&
+        (session->peerShots[session->peerShotsApplied].tick < session->peerTick)) return true;
+
+    const NetplayBallState *rest = &session->peerRest;
+    if ((rest->shot == 0) || session->peerRestChecked) return false;
+
+    bool passed = (rest->shot < session->peerShotsApplied) || ((rest->shot == session->peerShotsApplied) && (rest->tick < session->peerTick));
+    if (!passed) return false;
+
+    // NOTE: A rest before the anchor can't be checked anymore, a later state was
+    if ((rest->shot < session->peerAnchor.shot) || (rest->tick < session->peerAnchor.tick)) {
+        session->peerRestChecked = true;
+        return false;
+    }
+
+    return true;
+}
+
+static void RestorePeer(NetplaySession *session, PhysicsWorld *world, GolfPlayer *opponent, const NetplayBallState *state)
+{
+    SetBallState(world, opponent, state);
+    session->peerShotsApplied = state->shot;
+    session->peerTick = state->tick;
+}
+
+int NetplayAdvancePeer(NetplaySession *session, PhysicsWorld *world, GolfPlayer *opponent, int ticks)
+{
+    if (session->round == 0) return 0;
+    if (ticks > 0) session->peerTime += (unsigned int)ticks;
+
+    // A snapshot is a known good state to go on from
+    if (session->snapshotReady) {
+        session->snapshotReady = false;
+        session->desync = false;
+        session->peerAnchor = session->peerSnapshot;
+        RestorePeer(session, world, opponent, &session->peerSnapshot);
+
+        const NetplayBallState *rest = &session->peerRest;
+        if ((rest->shot < session->peerAnchor.shot) || ((rest->shot == session->peerAnchor.shot) && (rest->tick <= session->peerAnchor.tick))) {
+            session->peerRestChecked = true;
+        }
+    }
+    else if (IsPeerBehind(session)) RestorePeer(session, world, opponent, &session->peerAnchor);
+
+    int simulated = 0;
+
+    while (session->peerTick < session->peerTime) {
+        // Rest hash of the peer against the local result, a match is the new anchor
+        const NetplayBallState *rest = &session->peerRest;
+        if ((rest->shot > 0) && !session->peerRestChecked && (rest->shot == session->peerShotsApplied) && (rest->tick == session->peerTick)) {
+            NetplayBallState state = GetBallState(world, opponent, session->peerShotsApplied, session->peerTick);
+            session->peerRestChecked = true;
+
+            if (NetplayHashBall(&state) == session->peerRestHash) session->peerAnchor = state;
+            else {
+                session->desync = true;
+                session->desyncCount++;
+                session->ackPending = true;
+            }
+        }
+
+        // Shots are applied between ticks, the state right before one is kept to re-simulate from
+        // NOTE: While a snapshot is awaited the anchor stays where the results were still the same
+        while ((session->peerShotsApplied < session->peerShotCount) &&
+               (session->peerShots[session->peerShotsApplied].tick <= session->peerTick)) {
+            if (!session->desync) session->peerAnchor = GetBallState(world, opponent, session->peerShotsApplied, session->peerTick);
+            GolfShoot(opponent, world, session->peerShots[session->peerShotsApplied].drag);
+            session->peerShotsApplied++;
+        }
+
+        PhysicsStep(world);
+        GolfUpdate(opponent, world);
+        session->peerTick++;
+        simulated++;
+    }
+
+    return simulated;
+}
+
+bool NetplayHasPendingData(const NetplaySession *session)
+{
+    if (session->ackPending || session->desync || session->snapshotRequested) return true;
+    if (session->round == 0) return false;
+    if (session->host && !session->peerInRound) return true;
+
+    return (session->shotsAcked < session->shotCount) || !session->restAcked;
+}
+
+//----------------------------------------------------------------------------------
+// Packets
+//----------------------------------------------------------------------------------
+static const NetplayBallState *FindSentSnapshot(const NetplaySession *session, unsigned int id)
+{
+    for (int i = 0; i < NETPLAY_SNAPSHOT_HISTORY; i++) {
+        if (session->snapshotIds[i] == id) return &session->sentSnapshots[i];
+    }
+    return NULL;
+}
+
+unsigned int NetplayWritePacket(NetplaySession *session, unsigned char *buffer)
+{
+    unsigned int count = 0;
+    uint32_t flags = 0;
+
+    // Snapshot of the last rest, a new one only when the rest changed since the last sent
+    const NetplayBallState *baseline = NULL;
+    NetplayBallState start = GetRoundStartState(session);
+    if (session->snapshotRequested && (session->rest.shot > 0)) {
+        const NetplayBallState *last = FindSentSnapshot(session, session->snapshotId);
+        if ((session->snapshotId == 0) || (last == NULL) || (memcmp(last, &session->rest, sizeof(NetplayBallState)) != 0)) {
+            session->snapshotId++;
+            int slot = (int)(session->snapshotId%NETPLAY_SNAPSHOT_HISTORY);
+            session->snapshotIds[slot] = session->snapshotId;
+            session->sentSnapshots[slot] = session->rest;
+        }
+
+        baseline = FindSentSnapshot(session, session->snapshotAcked);
+        if ((session->snapshotAcked == 0) || (baseline == NULL)) {
+            session->snapshotAcked = 0;
+            baseline = &start;
+        }
+        flags |= NETPLAY_HAS_SNAPSHOT;
+    }
+
+    // Shots the peer doesn't have, ticks as deltas from the shot before
+    unsigned char shotBytes[NETPLAY_SHOTS_BUDGET];
+    unsigned int shotSize = 0, shotCount = 0;
+    unsigned int firstShot = session->shotsAcked;
+    unsigned int lastTick = (firstShot > 0)? session->shots[firstShot - 1].tick : 0;
+
+    while ((firstShot + shotCount < session->shotCount) && (shotCount < NETPLAY_SHOTS_PER_PACKET) &&
+           (shotSize + NETPLAY_SHOT_MAX_SIZE <= NETPLAY_SHOTS_BUDGET)) {
+        const NetplayShot *shot = &session->shots[firstShot + shotCount];
+        shotSize += EncodeVarint(shotBytes + shotSize, shot->tick - lastTick);
+        shotSize += EncodeVarint(shotBytes + shotSize, ZigZag((int32_t)lrintf(shot->drag.x*SHOT_DRAG_PRECISION)));
+        shotSize += EncodeVarint(shotBytes + shotSize, ZigZag((int32_t)lrintf(shot->drag.y*SHOT_DRAG_PRECISION)));
+        lastTick = shot->tick;
+        shotCount++;
+    }
+
+    if (session->host && !session->peerInRound && (session->round > 0)) flags |= NETPLAY_HAS_ROUND;
+    if (shotCount > 0) flags |= NETPLAY_HAS_SHOTS;
+    if (!session->restAcked) flags |= NETPLAY_HAS_REST;
+    if (session->desync && !session->snapshotReady) flags |= NETPLAY_WANTS_SNAPSHOT;
+
+    buffer[count++] = NETPLAY_MAGIC;
+    buffer[count++] = NETPLAY_VERSION;
+    count += EncodeVarint(buffer + count, session->sessionId);
+    count += EncodeVarint(buffer + count, session->round);
+    count += EncodeVarint(buffer + count, flags);
+    count += EncodeVarint(buffer + count, session->peerShotCount);
+    count += EncodeVarint(buffer + count, session->peerRest.shot);
+    count += EncodeVarint(buffer + count, session->peerSnapshotId);
+
+    if (flags & NETPLAY_HAS_ROUND) count += ReplayEncodeRoundInfo(&session->roundInfo, buffer + count);
+
+    if (flags & NETPLAY_HAS_SHOTS) {
+        count += EncodeVarint(buffer + count, firstShot);
+        count += EncodeVarint(buffer + count, shotCount);
+        memcpy(buffer + count, shotBytes, shotSize);
+        count += shotSize;
+    }
+
+    if (flags & NETPLAY_HAS_REST) {
+        count += EncodeVarint(buffer + count, session->rest.shot);
+        count += EncodeVarint(buffer + count, session->rest.tick);
+        count += EncodeVarint(buffer + count, session->restHash);
+    }
+
+    if (flags & NETPLAY_HAS_SNAPSHOT) {
+        uint32_t fields[NETPLAY_STATE_FIELDS], baseFields[NETPLAY_STATE_FIELDS];
+        GetStateFields(&session->rest, fields);
+        GetStateFields(baseline, baseFields);
+
+        count += EncodeVarint(buffer + count, session->snapshotId);
+        count += EncodeVarint(buffer + count, session->snapshotAcked);
+        for (int i = 0; i < NETPLAY_STATE_FIELDS; i++) count += EncodeVarint(buffer + count, fields[i] ^ baseFields[i]);
+    }
+
+    session->ackPending = false;
+    session->packetsSent++;
+    session->bytesSent += count;
+
+    return count;
+}
+
+static bool ParsePacket(const unsigned char *data, unsigned int size, NetplayPacket *packet)
+{
+    unsigned int offset = 2;
+
+    if (size < 2 || data[0] != NETPLAY_MAGIC || data[1] != NETPLAY_VERSION) return false;
+    if (!DecodeVarint(data, size, &offset, &packet->sessionId) ||
+        !DecodeVarint(data, size, &offset, &packet->round) ||
+        !DecodeVarint(data, size, &offset, &packet->flags) ||
+        !DecodeVarint(data, size, &offset, &packet->shotsAck) ||
+        !DecodeVarint(data, size, &offset, &packet->restAck) ||
+        !DecodeVarint(data, size, &offset, &packet->snapshotAck)) return false;
+
+    if ((packet->flags & NETPLAY_HAS_ROUND) && !ReplayDecodeRoundInfo(data, size, &offset, &packet->info)) return false;
+
+    if (packet->flags & NETPLAY_HAS_SHOTS) {
+        if (!DecodeVarint(data, size, &offset, &packet->firstShot) ||
+            !DecodeVarint(data, size, &offset, &packet->shotCount)) return false;
+        if (packet->shotCount > NETPLAY_SHOTS_PER_PACKET || packet->firstShot > NETPLAY_MAX_SHOTS ||
+            packet->firstShot + packet->shotCount > NETPLAY_MAX_SHOTS) return false;
+
+        uint32_t tick = 0;
+        for (uint32_t i = 0; i < packet->shotCount; i++) {
+            uint32_t delta = 0, x = 0, y = 0;
+            if (!DecodeVarint(data, size, &offset, &delta) ||
+                !DecodeVarint(data, size, &offset, &x) ||
+                !DecodeVarint(data, size, &offset, &y)) return false;
+
+            tick += delta;
+            packet->shots[i].tick = tick;
+            packet->shots[i].drag = (Vector2){ (float)UnZigZag(x)/SHOT_DRAG_PRECISION, (float)UnZigZag(y)/SHOT_DRAG_PRECISION };
+        }
+    }
+
+    if ((packet->flags & NETPLAY_HAS_REST) &&
+        (!DecodeVarint(data, size, &offset, &packet->restShot) ||
+         !DecodeVarint(data, size, &offset, &packet->restTick) ||
+         !DecodeVarint(data, size, &offset, &packet->restHash))) return false;
+
+    if (packet->flags & NETPLAY_HAS_SNAPSHOT) {
+        if (!DecodeVarint(data, size, &offset, &packet->snapshotId) || !DecodeVarint(data, size, &offset, &packet->baselineId)) return false;
+        for (int i = 0; i < NETPLAY_STATE_FIELDS; i++) if (!DecodeVarint(data, size, &offset, &packet->snapshotFields[i])) return false;
+    }
+
+    return offset == size;
+}
+
+bool NetplayReadPacket(NetplaySession *session, const unsigned char *data, unsigned int size)
+{
+    NetplayPacket packet = { 0 };
+    if (!ParsePacket(data, size, &packet) || packet.sessionId != session->sessionId) return false;
+
+    session->packetsReceived++;
+
+    // Rounds: the guest follows the host, the host only reads a guest in its round
+    // NOTE: A guest still in another round is a valid peer, it only has nothing for this round yet
+    if (session->host) {
+        if (packet.round != session->round || session->round == 0) return true;
+        session->peerInRound = true;
+    }
+    else if (packet.round > session->round) {
+        if (!(packet.flags & NETPLAY_HAS_ROUND)) return true;
+        ResetRound(session, packet.round, &packet.info);
+        session->roundStarted = true;
+    }
+    else if (packet.round < session->round) return true;
+
+    // Acknowledgements, only ever moving forward
+    if (packet.shotsAck > session->shotsAcked && packet.shotsAck <= session->shotCount) session->shotsAcked = packet.shotsAck;
+    if (!session->restAcked && packet.restAck == session->rest.shot) session->restAcked = true;
+    if (packet.snapshotAck > session->snapshotAcked && packet.snapshotAck <= session->snapshotId) session->snapshotAcked = packet.snapshotAck;
+
+    // Snapshot sent while asked for, until the peer has the last one
+    if (packet.flags & NETPLAY_WANTS_SNAPSHOT) {
+        if (!session->snapshotRequested) session->ackPending = true;
+        session->snapshotRequested = true;
+    }
+    else if (session->snapshotAcked == session->snapshotId) session->snapshotRequested = false;
+
+    // Shots, appended when they follow the ones received (ticks rebased on the shot before)
+    if ((packet.flags & NETPLAY_HAS_SHOTS) && packet.firstShot <= session->peerShotCount &&
+        packet.firstShot + packet.shotCount > session->peerShotCount) {
+        unsigned int baseTick = (packet.firstShot > 0)? session->peerShots[packet.firstShot - 1].tick : 0;
+        for (uint32_t i = session->peerShotCount - packet.firstShot; i < packet.shotCount; i++) {
+            NetplayShot *shot = &session->peerShots[session->peerShotCount++];
+            shot->tick = baseTick + packet.shots[i].tick;
+            shot->drag = packet.shots[i].drag;
+        }
+        session->ackPending = true;
+    }
+
+    if ((packet.flags & NETPLAY_HAS_REST) && packet.restShot > session->peerRest.shot) {
+        session->peerRest.shot = packet.restShot;
+        session->peerRest.tick = packet.restTick;
+        session->peerRestHash = packet.restHash;
+        session->peerRestChecked = false;
+        session->ackPending = true;
+    }
+
+    // Snapshot, delta decoded from the round start or the last one received
+    if ((packet.flags & NETPLAY_HAS_SNAPSHOT) && session->desync && packet.snapshotId > session->peerSnapshotId) {
+        NetplayBallState start = GetRoundStartState(session);
+        const NetplayBallState *baseline = (packet.baselineId == 0)? &start :
+                                           (packet.baselineId == session->peerSnapshotId)? &session->peerBaseline : NULL;
+        if (baseline != NULL) {
+            uint32_t fields[NETPLAY_STATE_FIELDS];
+            GetStateFields(baseline, fields);
+            for (int i = 0; i < NETPLAY_STATE_FIELDS; i++) fields[i] ^= packet.snapshotFields[i];
+
+            NetplayBallState state = SetStateFields(fields);
+            if (state.shot <= session->peerShotCount) {
+                session->peerSnapshot = state;
+                session->peerBaseline = state;
+                session->peerSnapshotId = packet.snapshotId;
+                session->snapshotReady = true;
+                session->ackPending = true;
+            }
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,162 @@
+#ifndef NETPLAY_H
+#define NETPLAY_H
+
+#include "physics.h"
+#include "rules.h"
+#include "replay.h"
+
+// --- Netplay Session ---
+// Head-to-head play without streaming ball positions: a shot is fully determined by its drag vector,
+// the tick it was taken at and the physics, so peers only exchange the shots (a few bytes each, encoded
+// like replays) and every peer re-simulates the opponent ball in a world of its own. A shot arriving
+// after its tick re-simulates the opponent ball from its last known state, so latency only delays the
+// opponent ball and a peer joining late catches up at once.
+// Once a shot comes to rest its owner also sends a hash of its ball; a different local result (another
+// build, a bad shot) makes the peer ask for a snapshot of the ball, sent as the XOR of its fields with
+// the last snapshot acknowledged (varints, unchanged fields take one byte).
+// Packets only carry what the peer hasn't acknowledged yet, so any packet lost is covered by the next
+// one: no transport state beyond the session, suited to UDP. No sockets here, see multiplayer.h.
+#define NETPLAY_VERSION             2
+#define NETPLAY_MAX_SHOTS           64      // Shots per player and round, later shots are played locally only
+#define NETPLAY_MAX_PACKET_SIZE     512     // Largest packet written (fits any path MTU)
+#define NETPLAY_SHOTS_PER_PACKET    32      // Unacknowledged shots sent at once, the rest go in the next packets
+#define NETPLAY_SNAPSHOT_HISTORY    4       // Snapshots kept as delta baselines until acknowledged
+
+// Shot as exchanged, on the round timeline of its player
+typedef struct NetplayShot {
+    unsigned int tick;          // Ticks since the round start of the player
+    Vector2 drag;               // Quantized drag vector
+} NetplayShot;
+
+// Ball of a player at a tick of its round, everything needed to go on from there
+typedef struct NetplayBallState {
+    unsigned int shot;          // Shots taken before this state
+    unsigned int tick;          // Ticks since the round start
+    Vector2 position;
+    Vector2 velocity;
+    Vector2 lastShotPosition;
+    int strokes;
+    bool holed;
+} NetplayBallState;
+
+typedef struct NetplaySession {
+    bool host;                  // The host picks the holes, the guest follows its rounds
+    uint32_t sessionId;         // Same on both peers, packets of other sessions are dropped
+    unsigned int round;         // Current round, 0 until the guest received one
+    ReplayRoundInfo roundInfo;
+    bool roundStarted;          // Guest: a new round arrived, taken by NetplayTakeRound()
+    bool peerInRound;           // Host: the guest acknowledged the current round
+    unsigned int startTick;     // Local world tick at the round start
+
+    // Local player
+    NetplayShot shots[NETPLAY_MAX_SHOTS];
+    unsigned int shotCount;
+    unsigned int shotsAcked;                // Shots the peer has
+    NetplayBallState rest;                  // Local ball once its last shot came to rest
+    uint32_t restHash;
+    bool restAcked;
+    bool snapshotRequested;                 // Peer got another result, the rest state is sent
+    NetplayBallState sentSnapshots[NETPLAY_SNAPSHOT_HISTORY];
+    unsigned int snapshotIds[NETPLAY_SNAPSHOT_HISTORY];
+    unsigned int snapshotId;                // Last snapshot sent
+    unsigned int snapshotAcked;             // Last snapshot the peer received, 0 for the round start
+
+    // Opponent, re-simulated from its shots
+    NetplayShot peerShots[NETPLAY_MAX_SHOTS];
+    unsigned int peerShotCount;             // Shots received, all previous ones included
+    unsigned int peerShotsApplied;          // Shots applied to the opponent ball
+    unsigned int peerTick;                  // Ticks simulated on the opponent timeline
+    unsigned int peerTime;                  // Ticks since the local round start, where the opponent ball should be
+    NetplayBallState peerAnchor;            // Latest opponent state known good, re-simulated from
+    NetplayBallState peerRest;              // Rest as reported by the peer (shot and tick), 0 shots for none
+    uint32_t peerRestHash;
+    bool peerRestChecked;
+    bool desync;                            // Hashes differ, a snapshot is asked for
+    bool snapshotReady;                     // Snapshot received, applied by the next NetplayAdvancePeer()
+    NetplayBallState peerSnapshot;
+    NetplayBallState peerBaseline;          // Last snapshot received, the delta base of the next one
+    unsigned int peerSnapshotId;            // Last snapshot received, acknowledged to the peer
+    bool ackPending;                        // New data received, acknowledged by the next packet
+
+    unsigned int packetsSent;
+    unsigned int packetsReceived;
+    unsigned int bytesSent;
+    unsigned int desyncCount;
+} NetplaySession;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Starts a session, both peers use the same 'sessionId'.
+ */
+void NetplayInit(NetplaySession *session, bool host, uint32_t sessionId);
+
+/**
+ * @brief Host: starts a new round on a hole, 'tick' is the world tick at the round start.
+ *
+ * The round is sent to the guest until acknowledged.
+ */
+void NetplayBeginRound(NetplaySession *session, const ReplayRoundInfo *info, unsigned int tick);
+
+/**
+ * @brief Guest: takes the round the host started, 'tick' is the world tick at the round start.
+ *
+ * @return false while there is no new round.
+ */
+bool NetplayTakeRound(NetplaySession *session, ReplayRoundInfo *info, unsigned int tick);
+
+/**
+ * @brief Prepares a world to re-simulate the opponent on the current round (like ReplayPlaybackStart()).
+ */
+void NetplayStartPeerWorld(const NetplaySession *session, PhysicsWorld *world, PhysicsGeometry geometry, GolfPlayer *opponent);
+
+/**
+ * @brief Records a local shot taken at world tick 'tick' (call next to GolfShoot()).
+ */
+void NetplayRecordShot(NetplaySession *session, unsigned int tick, Vector2 dragVector);
+
+/**
+ * @brief Records the local ball at rest after its last shot or holed (later calls for the same shot are ignored).
+ */
+void NetplayRecordRest(NetplaySession *session, const PhysicsWorld *world, const GolfPlayer *player);
+
+/**
+ * @brief Moves the opponent ball 'ticks' further on its timeline, applying its shots on their ticks.
+ *
+ * Late shots, rest hashes and snapshots re-simulate it from its latest known state first.
+ *
+ * @return Ticks simulated, re-simulated ones included.
+ */
+int NetplayAdvancePeer(NetplaySession *session, PhysicsWorld *world, GolfPlayer *opponent, int ticks);
+
+/**
+ * @brief Hashes a ball state (bit exact, every field).
+ */
+uint32_t NetplayHashBall(const NetplayBallState *state);
+
+/**
+ * @brief Writes the next packet: acknowledgements and everything the peer doesn't have yet.
+ *
+ * @return Packet size in bytes, at most NETPLAY_MAX_PACKET_SIZE.
+ */
+unsigned int NetplayWritePacket(NetplaySession *session, unsigned char *buffer);
+
+/**
+ * @brief Reads a packet from the peer. Old, duplicated or malformed packets change nothing.
+ *
+ * @return false if the packet is malformed or from another session.
+ */
+bool NetplayReadPacket(NetplaySession *session, const unsigned char *data, unsigned int size);
+
+/**
+ * @brief Checks if the peer is missing something (round, shots, rest, snapshot or acknowledgements).
+ */
+bool NetplayHasPendingData(const NetplaySession *session);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // NETPLAY_H
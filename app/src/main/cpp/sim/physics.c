@@ -0,0 +1,988 @@
+#include "physics.h"
+
+#define RAYMATH_STATIC_INLINE
+#include "raymath.h"
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+// NOTE: Results must be bit-identical on every ABI (see physics.h), which needs IEEE single precision
+// for every float operation: no fast-math reassociation, no x87 extended precision intermediates
+#if defined(__FAST_MATH__)
+    #error "physics.c must not be built with -ffast-math, replays would no longer verify across devices"
+#endif
+#if !defined(FLT_EVAL_METHOD) || (FLT_EVAL_METHOD != 0)
+    #error "physics.c needs FLT_EVAL_METHOD 0 (on 32-bit x86 build with -msse2 -mfpmath=sse)"
+#endif
+
+#if !defined(PHYSICS_NO_SIMD)
+    #if defined(__aarch64__) && defined(__ARM_NEON)
+        #define PHYSICS_SIMD_NEON
+        #include <arm_neon.h>
+    #elif defined(__SSE2__) || defined(_M_X64)
+        #define PHYSICS_SIMD_SSE
+        #include <emmintrin.h>
+    #endif
+#endif
+
+// NOTE: Vector and scalar paths must round the same way, a*b + c must never be fused into an FMA
+// (also forced with -ffp-contract=off for this file, see CMakeLists.txt)
+#if defined(__clang__)
+    #pragma STDC FP_CONTRACT OFF
+#endif
+
+// Scalar copy of one ball, used by the per-ball collision code
+typedef struct BallMotion {
+    Vector2 position;
+    Vector2 velocity;
+    float impactSpeed;          // Strongest bounce of the move, along the normal
+    int32_t impactType;         // PhysicsImpactType of that bounce
+} BallMotion;
+
+//----------------------------------------------------------------------------------
+// Vector lanes: PHYSICS_SIMD_WIDTH floats, with all-ones/all-zeros lane masks
+//----------------------------------------------------------------------------------
+#if defined(PHYSICS_SIMD_NEON)
+typedef float32x4_t SimdFloat;
+typedef uint32x4_t SimdMask;
+
+static inline SimdFloat SimdLoad(const float *p) { return vld1q_f32(p); }
+static inline void SimdStore(float *p, SimdFloat v) { vst1q_f32(p, v); }
+static inline SimdFloat SimdSet(float v) { return vdupq_n_f32(v); }
+static inline SimdFloat SimdAdd(SimdFloat a, SimdFloat b) { return vaddq_f32(a, b); }
+static inline SimdFloat SimdSub(SimdFloat a, SimdFloat b) { return vsubq_f32(a, b); }
+static inline SimdFloat SimdMul(SimdFloat a, SimdFloat b) { return vmulq_f32(a, b); }
+static inline SimdFloat SimdDiv(SimdFloat a, SimdFloat b) { return vdivq_f32(a, b); }
+static inline SimdFloat SimdSqrt(SimdFloat a) { return vsqrtq_f32(a); }
+static inline SimdMask SimdLoadMask(const uint32_t *p) { return vld1q_u32(p); }
+static inline SimdMask SimdLess(SimdFloat a, SimdFloat b) { return vcltq_f32(a, b); }
+static inline SimdMask SimdGreater(SimdFloat a, SimdFloat b) { return vcgtq_f32(a, b); }
+static inline SimdMask SimdAnd(SimdMask a, SimdMask b) { return vandq_u32(a, b); }
+static inline SimdMask SimdOr(SimdMask a, SimdMask b) { return vorrq_u32(a, b); }
+static inline SimdMask SimdAndNot(SimdMask a, SimdMask b) { return vbicq_u32(a, b); }  // a & ~b
+static inline SimdFloat SimdSelect(SimdMask m, SimdFloat a, SimdFloat b) { return vbslq_f32(m, a, b); }
+#elif defined(PHYSICS_SIMD_SSE)
+typedef __m128 SimdFloat;
+typedef __m128 SimdMask;
+
+static inline SimdFloat SimdLoad(const float *p) { return _mm_loadu_ps(p); }
+static inline void SimdStore(float *p, SimdFloat v) { _mm_storeu_ps(p, v); }
+static inline SimdFloat SimdSet(float v) { return _mm_set1_ps(v); }
+static inline SimdFloat SimdAdd(SimdFloat a, SimdFloat b) { return _mm_add_ps(a, b); }
+static inline SimdFloat SimdSub(SimdFloat a, SimdFloat b) { return _mm_sub_ps(a, b); }
+static inline SimdFloat SimdMul(SimdFloat a, SimdFloat b) { return _mm_mul_ps(a, b); }
+static inline SimdFloat SimdDiv(SimdFloat a, SimdFloat b) { return _mm_div_ps(a, b); }
+static inline SimdFloat SimdSqrt(SimdFloat a) { return _mm_sqrt_ps(a); }
+static inline SimdMask SimdLoadMask(const uint32_t *p) { return _mm_castsi128_ps(_mm_loadu_si128((const __m128i *)p)); }
+static inline SimdMask SimdLess(SimdFloat a, SimdFloat b) { return _mm_cmplt_ps(a, b); }
+static inline SimdMask SimdGreater(SimdFloat a, SimdFloat b) { return _mm_cmpgt_ps(a, b); }
+static inline SimdMask SimdAnd(SimdMask a, SimdMask b) { return _mm_and_ps(a, b); }
+static inline SimdMask SimdOr(SimdMask a, SimdMask b) { return _mm_or_ps(a, b); }
+static inline SimdMask SimdAndNot(SimdMask a, SimdMask b) { return _mm_andnot_ps(b, a); }  // a & ~b
+static inline SimdFloat SimdSelect(SimdMask m, SimdFloat a, SimdFloat b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+#endif
+
+#if defined(PHYSICS_SIMD_NEON) || defined(PHYSICS_SIMD_SSE)
+    #define PHYSICS_SIMD
+#endif
+
+// base^exponent for base in [0, 1], exponent > 0, from IEEE double adds, multiplies and divides only
+// NOTE: libm powf() results differ between C libraries (bionic, glibc, MSVC), this one is the same everywhere
+static float StrictPow(float base, float exponent)
+{
+    if (base <= 0.0f) return 0.0f;
+    if ((base == 1.0f) || (exponent == 1.0f)) return base;
+
+    const double LN2 = 0.69314718055994530942;
+
+    // ln(base) = e*ln(2) + ln(m), with m in [sqrt(1/2), sqrt(2)) and ln(m) = 2*atanh((m - 1)/(m + 1))
+    int e = 0;
+    double m = frexp((double)base, &e);
+    if (m < 0.70710678118654752440) { m *= 2.0; e--; }
+    double s = (m - 1.0)/(m + 1.0), s2 = s*s;
+    double series = 1.0/17.0;
+    for (int k = 15; k >= 1; k -= 2) series = 1.0/(double)k + s2*series;
+    double y = (double)exponent*((double)e*LN2 + 2.0*s*series);
+
+    // exp(y) = 2^n*exp(r), |r| <= ln(2)/2
+    double n = floor(y/LN2 + 0.5);
+    double r = y - n*LN2;
+    double taylor = 1.0;
+    for (int k = 13; k >= 1; k--) taylor = 1.0 + r*taylor/(double)k;
+
+    return (float)ldexp(taylor, (int)n);
+}
+
+void PhysicsInit(PhysicsWorld *world, int tickRate)
+{
+    if (tickRate <= 0) tickRate = PHYSICS_TICK_RATE;
+
+    world->tickRate = tickRate;
+    world->dt = 1.0f/(float)tickRate;
+    world->tickScale = (float)PHYSICS_REFERENCE_RATE/(float)tickRate;
+
+    // Friction was applied once per reference frame, so one tick keeps FRICTION^tickScale
+    world->friction = StrictPow(FRICTION, world->tickScale);
+    // Distance covered per tick, chosen so a free rolling ball coasts as far as it did at 60 FPS
+    // (sum of a geometric series: v/(1 - FRICTION) per reference frame vs v*moveScale/(1 - friction) per tick)
+    world->moveScale = (1.0f - world->friction)/(1.0f - FRICTION);
+
+    world->accumulator = 0.0f;
+    world->tick = 0;
+
+    memset(&world->balls, 0, sizeof(world->balls));
+    world->ballCount = 0;
+    world->ghostBalls = false;
+    for (int i = 0; i < PHYSICS_BALL_BUCKETS; i++) world->ballBuckets[i] = -1;
+}
+
+//----------------------------------------------------------------------------------
+// Ball broadphase: spatial hash over PHYSICS_BALL_CELL_SIZE cells
+// Balls are only relinked when they cross a cell border, which is rare at tick rate
+//----------------------------------------------------------------------------------
+static int HashBallCell(int x, int y)
+{
+    return (int)(((unsigned int)x*73856093u ^ (unsigned int)y*19349663u) & (PHYSICS_BALL_BUCKETS - 1));
+}
+
+static void UnlinkBall(PhysicsWorld *world, int index)
+{
+    PhysicsBalls *balls = &world->balls;
+    if (balls->bucket[index] < 0) return;
+
+    int *link = &world->ballBuckets[balls->bucket[index]];
+    while (*link != index) link = &balls->nextInBucket[*link];
+    *link = balls->nextInBucket[index];
+
+    balls->bucket[index] = -1;
+    balls->nextInBucket[index] = -1;
+}
+
+static void LinkBall(PhysicsWorld *world, int index)
+{
+    PhysicsBalls *balls = &world->balls;
+
+    balls->cellX[index] = (int)floorf(balls->x[index]/PHYSICS_BALL_CELL_SIZE);
+    balls->cellY[index] = (int)floorf(balls->y[index]/PHYSICS_BALL_CELL_SIZE);
+    balls->bucket[index] = HashBallCell(balls->cellX[index], balls->cellY[index]);
+    balls->nextInBucket[index] = world->ballBuckets[balls->bucket[index]];
+    world->ballBuckets[balls->bucket[index]] = index;
+}
+
+// Relinks a ball if it moved to another cell (or takes it out of the hash if it left play)
+static void UpdateBallCell(PhysicsWorld *world, int index)
+{
+    PhysicsBalls *balls = &world->balls;
+
+    if (balls->sunk[index] || balls->inHazard[index]) {
+        UnlinkBall(world, index);
+        return;
+    }
+
+    int x = (int)floorf(balls->x[index]/PHYSICS_BALL_CELL_SIZE);
+    int y = (int)floorf(balls->y[index]/PHYSICS_BALL_CELL_SIZE);
+    if (balls->bucket[index] >= 0 && x == balls->cellX[index] && y == balls->cellY[index]) return;
+
+    UnlinkBall(world, index);
+    LinkBall(world, index);
+}
+
+int PhysicsAddBall(PhysicsWorld *world, Vector2 position)
+{
+    if (world->ballCount >= PHYSICS_MAX_BALLS) return -1;
+
+    int index = world->ballCount++;
+    world->balls.bucket[index] = -1;
+    world->balls.nextInBucket[index] = -1;
+    PhysicsResetBall(world, index, position);
+
+    return index;
+}
+
+void PhysicsResetBall(PhysicsWorld *world, int index, Vector2 position)
+{
+    PhysicsBalls *balls = &world->balls;
+
+    balls->x[index] = position.x;
+    balls->y[index] = position.y;
+    balls->previousX[index] = position.x;
+    balls->previousY[index] = position.y;
+    balls->vx[index] = 0.0f;
+    balls->vy[index] = 0.0f;
+    balls->sunk[index] = false;
+    balls->inHazard[index] = false;
+
+    UnlinkBall(world, index);
+    LinkBall(world, index);
+}
+
+void PhysicsSetBallState(PhysicsWorld *world, int index, Vector2 position, Vector2 velocity)
+{
+    PhysicsResetBall(world, index, position);
+    world->balls.vx[index] = velocity.x;
+    world->balls.vy[index] = velocity.y;
+}
+
+void PhysicsShoot(PhysicsWorld *world, int index, Vector2 impulse)
+{
+    world->balls.vx[index] += impulse.x;
+    world->balls.vy[index] += impulse.y;
+}
+
+Vector2 PhysicsGetBallPosition(const PhysicsWorld *world, int index)
+{
+    return (Vector2){ world->balls.x[index], world->balls.y[index] };
+}
+
+Vector2 PhysicsGetBallVelocity(const PhysicsWorld *world, int index)
+{
+    return (Vector2){ world->balls.vx[index], world->balls.vy[index] };
+}
+
+// Earliest time t in [0, 1] at which a circle moving from 'p' by 'd' touches the circle (center, radius)
+// Returns a value > 1 when there is no contact during this move
+static float SweepCircleCircle(Vector2 p, Vector2 d, Vector2 center, float radius)
+{
+    Vector2 m = Vector2Subtract(p, center);
+    float b = Vector2DotProduct(m, d);
+    float c = Vector2DotProduct(m, m) - radius*radius;
+
+    if (b >= 0.0f) return 2.0f;     // Moving away (or not moving)
+    if (c <= 0.0f) return 0.0f;     // Already touching and moving closer
+
+    float a = Vector2DotProduct(d, d);
+    float disc = b*b - a*c;
+    if (disc < 0.0f) return 2.0f;
+
+    return fmaxf((-b - sqrtf(disc))/a, 0.0f);
+}
+
+// Earliest time of impact of the ball against one wall capsule, 'normal' receives the contact normal
+static float SweepWall(Vector2 p, Vector2 d, PhysicsSegment wall, Vector2 *normal)
+{
+    float best = 2.0f;
+    Vector2 ab = Vector2Subtract(wall.b, wall.a);
+    float lengthSqr = Vector2LengthSqr(ab);
+
+    // Flat side of the capsule (offset line facing the ball)
+    if (lengthSqr > 0.0f) {
+        Vector2 n = Vector2Normalize((Vector2){ -ab.y, ab.x });
+        float dist = Vector2DotProduct(Vector2Subtract(p, wall.a), n);
+        if (dist < 0.0f) { n = Vector2Negate(n); dist = -dist; }
+
+        float approach = Vector2DotProduct(d, n);
+        if (approach < 0.0f) {
+            float t = (dist >= BALL_RADIUS)? (dist - BALL_RADIUS)/-approach : 0.0f;
+            if (t <= 1.0f) {
+                Vector2 contact = Vector2Add(p, Vector2Scale(d, t));
+                float u = Vector2DotProduct(Vector2Subtract(contact, wall.a), ab)/lengthSqr;
+                if (u >= 0.0f && u <= 1.0f) {
+                    best = t;
+                    *normal = n;
+                }
+            }
+        }
+    }
+
+    // Rounded ends of the capsule
+    Vector2 ends[2] = { wall.a, wall.b };
+    for (int i = 0; i < 2; i++) {
+        float t = SweepCircleCircle(p, d, ends[i], BALL_RADIUS);
+        if (t < best) {
+            Vector2 contact = Vector2Add(p, Vector2Scale(d, t));
+            best = t;
+            *normal = Vector2Normalize(Vector2Subtract(contact, ends[i]));
+        }
+    }
+
+    return best;
+}
+
+// Tests one grid item (wall or bumper) and keeps it if it is hit first
+static void SweepItem(const PhysicsGeometry *geometry, int item, Vector2 p, Vector2 d, float *best, Vector2 *normal, float *restitution, int32_t *type)
+{
+    Vector2 n = { 0 };
+    float t = 2.0f;
+    float e = BOUNCE_RESTITUTION;
+    int32_t kind = PHYSICS_IMPACT_WALL;
+
+    if (item < geometry->wallCount) t = SweepWall(p, d, geometry->walls[item], &n);
+    else {
+        const PhysicsBumper *bumper = &geometry->bumpers[item - geometry->wallCount];
+        t = SweepCircleCircle(p, d, bumper->center, bumper->radius + BALL_RADIUS);
+        if (t <= 1.0f) n = Vector2Normalize(Vector2Subtract(Vector2Add(p, Vector2Scale(d, t)), bumper->center));
+        e = bumper->restitution;
+        kind = PHYSICS_IMPACT_BUMPER;
+    }
+
+    if (t < *best) {
+        *best = t;
+        *normal = n;
+        *restitution = e;
+        *type = kind;
+    }
+}
+
+// Earliest time of impact against the playfield edges and the course obstacles
+static float FindWallImpact(const PhysicsWorld *world, Vector2 p, Vector2 d, Vector2 *normal, float *restitution, int32_t *type)
+{
+    float best = 2.0f;
+    *restitution = BOUNCE_RESTITUTION;
+    *type = PHYSICS_IMPACT_WALL;
+
+    // Playfield edges (inner side only)
+    float minX = BALL_RADIUS, maxX = world->width - BALL_RADIUS;
+    float minY = BALL_RADIUS, maxY = world->height - BALL_RADIUS;
+
+    if (d.x < 0.0f && p.x + d.x < minX) {
+        float t = fmaxf((minX - p.x)/d.x, 0.0f);
+        if (t < best) { best = t; *normal = (Vector2){ 1.0f, 0.0f }; }
+    }
+    else if (d.x > 0.0f && p.x + d.x > maxX) {
+        float t = fmaxf((maxX - p.x)/d.x, 0.0f);
+        if (t < best) { best = t; *normal = (Vector2){ -1.0f, 0.0f }; }
+    }
+
+    if (d.y < 0.0f && p.y + d.y < minY) {
+        float t = fmaxf((minY - p.y)/d.y, 0.0f);
+        if (t < best) { best = t; *normal = (Vector2){ 0.0f, 1.0f }; }
+    }
+    else if (d.y > 0.0f && p.y + d.y > maxY) {
+        float t = fmaxf((maxY - p.y)/d.y, 0.0f);
+        if (t < best) { best = t; *normal = (Vector2){ 0.0f, -1.0f }; }
+    }
+
+    // Course obstacles
+    const PhysicsGeometry *geometry = &world->geometry;
+    const PhysicsGrid *grid = &geometry->grid;
+
+    if (grid->cols > 0) {
+        // Only cells touched by the swept center, obstacles are already inflated by BALL_RADIUS in the grid
+        // NOTE: An obstacle spanning several cells may be tested more than once, that's harmless
+        float inv = 1.0f/grid->cellSize;
+        int x0 = (int)floorf((fminf(p.x, p.x + d.x) - grid->origin.x)*inv);
+        int x1 = (int)floorf((fmaxf(p.x, p.x + d.x) - grid->origin.x)*inv);
+        int y0 = (int)floorf((fminf(p.y, p.y + d.y) - grid->origin.y)*inv);
+        int y1 = (int)floorf((fmaxf(p.y, p.y + d.y) - grid->origin.y)*inv);
+        if (x0 < 0) x0 = 0;
+        if (y0 < 0) y0 = 0;
+        if (x1 >= grid->cols) x1 = grid->cols - 1;
+        if (y1 >= grid->rows) y1 = grid->rows - 1;
+
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                int cell = y*grid->cols + x;
+                for (uint32_t i = grid->cellStart[cell]; i < grid->cellStart[cell + 1]; i++) {
+                    SweepItem(geometry, grid->items[i], p, d, &best, normal, restitution, type);
+                }
+            }
+        }
+    }
+    else {
+        int itemCount = geometry->wallCount + geometry->bumperCount;
+        for (int i = 0; i < itemCount; i++) SweepItem(geometry, i, p, d, &best, normal, restitution, type);
+    }
+
+    return best;
+}
+
+// Reflects the normal part of the velocity, damped like the original edge bounce
+static Vector2 Bounce(Vector2 velocity, Vector2 normal, float restitution)
+{
+    float vn = Vector2DotProduct(velocity, normal);
+    if (vn >= 0.0f) return velocity;
+    return Vector2Subtract(velocity, Vector2Scale(normal, (1.0f + restitution)*vn));
+}
+
+// Moves the ball for 'duration' (fraction of a tick), bouncing at every exact time of impact.
+// With 'stopAtSink', the move stops where the path enters the sink radius.
+// Returns the fraction of a tick actually simulated.
+static float SweepBall(const PhysicsWorld *world, BallMotion *ball, float duration, bool stopAtSink)
+{
+    float elapsed = 0.0f;
+
+    for (int i = 0; i <= PHYSICS_MAX_BOUNCES; i++) {
+        float left = duration - elapsed;
+        Vector2 d = Vector2Scale(ball->velocity, world->moveScale*left);
+
+        Vector2 normal = { 0 };
+        float restitution = BOUNCE_RESTITUTION;
+        int32_t type = PHYSICS_IMPACT_WALL;
+        float t = FindWallImpact(world, ball->position, d, &normal, &restitution, &type);
+        float tSink = stopAtSink? SweepCircleCircle(ball->position, d, world->hole, SINK_DISTANCE) : 2.0f;
+
+        if (tSink <= 1.0f && tSink <= t) {
+            ball->position = Vector2Add(ball->position, Vector2Scale(d, tSink));
+            return elapsed + left*tSink;
+        }
+
+        if (t > 1.0f) {
+            ball->position = Vector2Add(ball->position, d);
+            return duration;
+        }
+
+        // Strongest impact kept for the feedback, it doesn't change the motion
+        float approach = -Vector2DotProduct(ball->velocity, normal);
+        if (approach > ball->impactSpeed) {
+            ball->impactSpeed = approach;
+            ball->impactType = type;
+        }
+
+        ball->position = Vector2Add(ball->position, Vector2Scale(d, t));
+        ball->velocity = Bounce(ball->velocity, normal, restitution);
+        elapsed += left*t;
+    }
+
+    // Too many impacts in one tick (ball wedged in a corner): drop the rest of the tick
+    return duration;
+}
+
+//----------------------------------------------------------------------------------
+// Lane-wise integration over the ball store
+// 'live' holds one all-ones/all-zeros mask per lane, only live lanes are changed.
+// Each vector loop is the exact transcription of the scalar loop below it: same operations,
+// same order, IEEE div/sqrt on both sides, so both paths give bit-identical results
+//----------------------------------------------------------------------------------
+
+// Safety net for balls placed outside the playfield (i.e. screen resized or rotated)
+static void IntegrateBounce(PhysicsBalls *balls, const uint32_t *live, float width, float height)
+{
+    const float minX = BALL_RADIUS, maxX = width - BALL_RADIUS;
+    const float minY = BALL_RADIUS, maxY = height - BALL_RADIUS;
+
+#if defined(PHYSICS_SIMD)
+    const SimdFloat zero = SimdSet(0.0f), bounce = SimdSet(-BOUNCE_RESTITUTION);
+    const SimdFloat vMinX = SimdSet(minX), vMaxX = SimdSet(maxX);
+    const SimdFloat vMinY = SimdSet(minY), vMaxY = SimdSet(maxY);
+
+    for (int i = 0; i < PHYSICS_MAX_BALLS; i += PHYSICS_SIMD_WIDTH) {
+        SimdMask active = SimdLoadMask(live + i);
+        SimdFloat x = SimdLoad(balls->x + i), vx = SimdLoad(balls->vx + i);
+        SimdFloat y = SimdLoad(balls->y + i), vy = SimdLoad(balls->vy + i);
+
+        SimdMask lo = SimdAnd(active, SimdLess(x, vMinX));
+        SimdMask hi = SimdAndNot(SimdAnd(active, SimdGreater(x, vMaxX)), lo);
+        SimdMask flip = SimdOr(SimdAnd(lo, SimdLess(vx, zero)), SimdAnd(hi, SimdGreater(vx, zero)));
+        vx = SimdSelect(flip, SimdMul(vx, bounce), vx);
+        x = SimdSelect(lo, vMinX, SimdSelect(hi, vMaxX, x));
+
+        lo = SimdAnd(active, SimdLess(y, vMinY));
+        hi = SimdAndNot(SimdAnd(active, SimdGreater(y, vMaxY)), lo);
+        flip = SimdOr(SimdAnd(lo, SimdLess(vy, zero)), SimdAnd(hi, SimdGreater(vy, zero)));
+        vy = SimdSelect(flip, SimdMul(vy, bounce), vy);
+        y = SimdSelect(lo, vMinY, SimdSelect(hi, vMaxY, y));
+
+        SimdStore(balls->x + i, x);
+        SimdStore(balls->y + i, y);
+        SimdStore(balls->vx + i, vx);
+        SimdStore(balls->vy + i, vy);
+    }
+#else
+    for (int i = 0; i < PHYSICS_MAX_BALLS; i++) {
+        if (!live[i]) continue;
+
+        if (balls->x[i] < minX) {
+            if (balls->vx[i] < 0.0f) balls->vx[i] = balls->vx[i]*-BOUNCE_RESTITUTION;
+            balls->x[i] = minX;
+        }
+        else if (balls->x[i] > maxX) {
+            if (balls->vx[i] > 0.0f) balls->vx[i] = balls->vx[i]*-BOUNCE_RESTITUTION;
+            balls->x[i] = maxX;
+        }
+
+        if (balls->y[i] < minY) {
+            if (balls->vy[i] < 0.0f) balls->vy[i] = balls->vy[i]*-BOUNCE_RESTITUTION;
+            balls->y[i] = minY;
+        }
+        else if (balls->y[i] > maxY) {
+            if (balls->vy[i] > 0.0f) balls->vy[i] = balls->vy[i]*-BOUNCE_RESTITUTION;
+            balls->y[i] = maxY;
+        }
+    }
+#endif
+}
+
+// Gravity well of the hole (sinking), then the hard velocity cap
+static void IntegratePullAndCap(PhysicsBalls *balls, const uint32_t *live, Vector2 hole, float pull)
+{
+#if defined(PHYSICS_SIMD)
+    const SimdFloat zero = SimdSet(0.0f), one = SimdSet(1.0f);
+    const SimdFloat holeX = SimdSet(hole.x), holeY = SimdSet(hole.y);
+    const SimdFloat sinkDistance = SimdSet(SINK_DISTANCE), vPull = SimdSet(pull), maxVelocity = SimdSet(MAX_VELOCITY);
+
+    for (int i = 0; i < PHYSICS_MAX_BALLS; i += PHYSICS_SIMD_WIDTH) {
+        SimdMask active = SimdLoadMask(live + i);
+        SimdFloat vx = SimdLoad(balls->vx + i), vy = SimdLoad(balls->vy + i);
+
+        // Direction vector from ball to hole
+        SimdFloat dx = SimdSub(holeX, SimdLoad(balls->x + i));
+        SimdFloat dy = SimdSub(holeY, SimdLoad(balls->y + i));
+        SimdFloat dist = SimdSqrt(SimdAdd(SimdMul(dx, dx), SimdMul(dy, dy)));
+        SimdMask inSink = SimdAnd(active, SimdAnd(SimdLess(dist, sinkDistance), SimdGreater(dist, zero)));
+        SimdFloat inv = SimdDiv(one, SimdSelect(inSink, dist, one));
+        vx = SimdSelect(inSink, SimdAdd(vx, SimdMul(SimdMul(dx, inv), vPull)), vx);
+        vy = SimdSelect(inSink, SimdAdd(vy, SimdMul(SimdMul(dy, inv), vPull)), vy);
+
+        SimdFloat length = SimdSqrt(SimdAdd(SimdMul(vx, vx), SimdMul(vy, vy)));
+        SimdMask capped = SimdAnd(active, SimdGreater(length, maxVelocity));
+        inv = SimdDiv(one, SimdSelect(capped, length, one));
+        vx = SimdSelect(capped, SimdMul(SimdMul(vx, inv), maxVelocity), vx);
+        vy = SimdSelect(capped, SimdMul(SimdMul(vy, inv), maxVelocity), vy);
+
+        SimdStore(balls->vx + i, vx);
+        SimdStore(balls->vy + i, vy);
+    }
+#else
+    for (int i = 0; i < PHYSICS_MAX_BALLS; i++) {
+        if (!live[i]) continue;
+
+        // Direction vector from ball to hole
+        float dx = hole.x - balls->x[i];
+        float dy = hole.y - balls->y[i];
+        float dist = sqrtf(dx*dx + dy*dy);
+        if (dist < SINK_DISTANCE && dist > 0.0f) {
+            float inv = 1.0f/dist;
+            balls->vx[i] = balls->vx[i] + dx*inv*pull;
+            balls->vy[i] = balls->vy[i] + dy*inv*pull;
+        }
+
+        float length = sqrtf(balls->vx[i]*balls->vx[i] + balls->vy[i]*balls->vy[i]);
+        if (length > MAX_VELOCITY) {
+            float inv = 1.0f/length;
+            balls->vx[i] = balls->vx[i]*inv*MAX_VELOCITY;
+            balls->vy[i] = balls->vy[i]*inv*MAX_VELOCITY;
+        }
+    }
+#endif
+}
+
+// Friction (slowing down)
+static void IntegrateFriction(PhysicsBalls *balls, const uint32_t *live, float friction)
+{
+#if defined(PHYSICS_SIMD)
+    const SimdFloat vFriction = SimdSet(friction);
+
+    for (int i = 0; i < PHYSICS_MAX_BALLS; i += PHYSICS_SIMD_WIDTH) {
+        SimdMask active = SimdLoadMask(live + i);
+        SimdFloat vx = SimdLoad(balls->vx + i), vy = SimdLoad(balls->vy + i);
+        SimdStore(balls->vx + i, SimdSelect(active, SimdMul(vx, vFriction), vx));
+        SimdStore(balls->vy + i, SimdSelect(active, SimdMul(vy, vFriction), vy));
+    }
+#else
+    for (int i = 0; i < PHYSICS_MAX_BALLS; i++) {
+        if (!live[i]) continue;
+        balls->vx[i] = balls->vx[i]*friction;
+        balls->vy[i] = balls->vy[i]*friction;
+    }
+#endif
+}
+
+static inline float Bilinear(float c00, float c10, float c01, float c11, float fx, float fy)
+{
+    float top = c00 + (c10 - c00)*fx;
+    float bottom = c01 + (c11 - c01)*fx;
+    return top + (bottom - top)*fy;
+}
+
+#if defined(PHYSICS_SIMD)
+static inline SimdFloat SimdBilinear(const float *c00, const float *c10, const float *c01, const float *c11, SimdFloat fx, SimdFloat fy)
+{
+    SimdFloat a = SimdLoad(c00), b = SimdLoad(c10), c = SimdLoad(c01), d = SimdLoad(c11);
+    SimdFloat top = SimdAdd(a, SimdMul(SimdSub(b, a), fx));
+    SimdFloat bottom = SimdAdd(c, SimdMul(SimdSub(d, c), fx));
+    return SimdAdd(top, SimdMul(SimdSub(bottom, top), fy));
+}
+#endif
+
+// Finds the 4 samples around a position (00, 10, 01, 11) and the position between them
+static void GetTerrainCorners(const PhysicsTerrain *terrain, Vector2 position, const PhysicsTerrainSample **corners, float *fx, float *fy)
+{
+    float inv = 1.0f/terrain->cellSize;
+    float u = fminf(fmaxf((position.x - terrain->origin.x)*inv, 0.0f), (float)(terrain->cols - 1));
+    float v = fminf(fmaxf((position.y - terrain->origin.y)*inv, 0.0f), (float)(terrain->rows - 1));
+    int cx = (int)u, cy = (int)v;
+    if (cx > terrain->cols - 2) cx = terrain->cols - 2;
+    if (cy > terrain->rows - 2) cy = terrain->rows - 2;
+    *fx = u - (float)cx;
+    *fy = v - (float)cy;
+
+    const PhysicsTerrainSample *cell = terrain->samples + cy*terrain->cols + cx;
+    corners[0] = cell;
+    corners[1] = cell + 1;
+    corners[2] = cell + terrain->cols;
+    corners[3] = cell + terrain->cols + 1;
+}
+
+// Terrain slope push then terrain friction, blended between the 4 samples around each ball.
+// A stopped ball only starts rolling on slopes steeper than TERRAIN_REST_SLOPE, it would never rest otherwise.
+// NOTE: Samples are gathered lane by lane (NEON has no gather), only the blend and the update are vector code
+static void IntegrateTerrain(const PhysicsWorld *world, PhysicsBalls *balls, const uint32_t *live)
+{
+    const PhysicsTerrain *terrain = &world->geometry.terrain;
+    if (terrain->cols < 2 || terrain->rows < 2) return;
+
+    float fx[PHYSICS_MAX_BALLS], fy[PHYSICS_MAX_BALLS];
+    float slopeX[4][PHYSICS_MAX_BALLS], slopeY[4][PHYSICS_MAX_BALLS], friction[4][PHYSICS_MAX_BALLS];
+    float rest = TERRAIN_REST_SLOPE*world->tickScale;
+
+    for (int i = 0; i < PHYSICS_MAX_BALLS; i++) {
+        // Lanes out of play read the first cell, their result is never stored
+        Vector2 position = live[i]? (Vector2){ balls->x[i], balls->y[i] } : terrain->origin;
+        const PhysicsTerrainSample *corners[4];
+        GetTerrainCorners(terrain, position, corners, &fx[i], &fy[i]);
+        for (int c = 0; c < 4; c++) {
+            slopeX[c][i] = (float)((int)corners[c]->slopeX - 128)*world->terrainSlope;
+            slopeY[c][i] = (float)((int)corners[c]->slopeY - 128)*world->terrainSlope;
+            friction[c][i] = world->terrainFriction[corners[c]->friction];
+        }
+    }
+
+#if defined(PHYSICS_SIMD)
+    const SimdFloat zero = SimdSet(0.0f), stopped = SimdSet(STOPPED_SPEED_SQR), restSqr = SimdSet(rest*rest);
+
+    for (int i = 0; i < PHYSICS_MAX_BALLS; i += PHYSICS_SIMD_WIDTH) {
+        SimdMask active = SimdLoadMask(live + i);
+        SimdFloat u = SimdLoad(fx + i), v = SimdLoad(fy + i);
+        SimdFloat vx = SimdLoad(balls->vx + i), vy = SimdLoad(balls->vy + i);
+
+        SimdFloat sx = SimdBilinear(slopeX[0] + i, slopeX[1] + i, slopeX[2] + i, slopeX[3] + i, u, v);
+        SimdFloat sy = SimdBilinear(slopeY[0] + i, slopeY[1] + i, slopeY[2] + i, slopeY[3] + i, u, v);
+        SimdFloat kept = SimdBilinear(friction[0] + i, friction[1] + i, friction[2] + i, friction[3] + i, u, v);
+
+        SimdMask still = SimdLess(SimdAdd(SimdMul(vx, vx), SimdMul(vy, vy)), stopped);
+        SimdMask held = SimdAndNot(still, SimdGreater(SimdAdd(SimdMul(sx, sx), SimdMul(sy, sy)), restSqr));
+        sx = SimdSelect(held, zero, sx);
+        sy = SimdSelect(held, zero, sy);
+
+        SimdStore(balls->vx + i, SimdSelect(active, SimdMul(SimdAdd(vx, sx), kept), vx));
+        SimdStore(balls->vy + i, SimdSelect(active, SimdMul(SimdAdd(vy, sy), kept), vy));
+    }
+#else
+    for (int i = 0; i < PHYSICS_MAX_BALLS; i++) {
+        if (!live[i]) continue;
+
+        float sx = Bilinear(slopeX[0][i], slopeX[1][i], slopeX[2][i], slopeX[3][i], fx[i], fy[i]);
+        float sy = Bilinear(slopeY[0][i], slopeY[1][i], slopeY[2][i], slopeY[3][i], fx[i], fy[i]);
+        float kept = Bilinear(friction[0][i], friction[1][i], friction[2][i], friction[3][i], fx[i], fy[i]);
+
+        if ((balls->vx[i]*balls->vx[i] + balls->vy[i]*balls->vy[i] < STOPPED_SPEED_SQR) && !(sx*sx + sy*sy > rest*rest)) {
+            sx = 0.0f;
+            sy = 0.0f;
+        }
+
+        balls->vx[i] = (balls->vx[i] + sx)*kept;
+        balls->vy[i] = (balls->vy[i] + sy)*kept;
+    }
+#endif
+}
+
+// Applies the area under the ball (first match wins), returns false if the ball fell into water
+static bool ApplyAreas(const PhysicsWorld *world, BallMotion *ball)
+{
+    for (int i = 0; i < world->geometry.areaCount; i++) {
+        const PhysicsArea *area = &world->geometry.areas[i];
+        if (ball->position.x < area->x || ball->position.x > area->x + area->width ||
+            ball->position.y < area->y || ball->position.y > area->y + area->height) continue;
+
+        switch (area->type) {
+            case AREA_SLOPE: ball->velocity = Vector2Add(ball->velocity, Vector2Scale(area->slope, world->tickScale)); break;
+            case AREA_ROUGH: ball->velocity = Vector2Scale(ball->velocity, StrictPow(area->friction, world->tickScale)); break;
+            case AREA_WATER:
+            {
+                ball->velocity = (Vector2){ 0.0f, 0.0f };
+                return false;
+            }
+            default: break;
+        }
+        break;
+    }
+
+    return true;
+}
+
+float PhysicsGetSurfaceFriction(const PhysicsWorld *world, Vector2 position)
+{
+    float friction = 1.0f;
+
+    for (int i = 0; i < world->geometry.areaCount; i++) {
+        const PhysicsArea *area = &world->geometry.areas[i];
+        if (position.x < area->x || position.x > area->x + area->width ||
+            position.y < area->y || position.y > area->y + area->height) continue;
+
+        if (area->type == AREA_ROUGH) friction = area->friction;
+        break;
+    }
+
+    const PhysicsTerrain *terrain = &world->geometry.terrain;
+    if (terrain->cols >= 2 && terrain->rows >= 2) {
+        const PhysicsTerrainSample *corners[4];
+        float fx, fy;
+        GetTerrainCorners(terrain, position, corners, &fx, &fy);
+        friction *= Bilinear(corners[0]->friction, corners[1]->friction, corners[2]->friction, corners[3]->friction, fx, fy)/255.0f;
+    }
+
+    return friction;
+}
+
+void PhysicsSetGeometry(PhysicsWorld *world, PhysicsGeometry geometry)
+{
+    world->geometry = geometry;
+
+    // Terrain channels decoded once per hole, a tick only does table lookups (friction^tickScale as in ApplyAreas())
+    const PhysicsTerrain *terrain = &geometry.terrain;
+    if (terrain->cols >= 2 && terrain->rows >= 2) {
+        world->terrainSlope = terrain->slopeScale/127.0f*world->tickScale;
+        for (int i = 0; i < 256; i++) world->terrainFriction[i] = StrictPow((float)i/255.0f, world->tickScale);
+    }
+}
+
+int PhysicsQueryGeometry(const PhysicsGeometry *geometry, Vector2 min, Vector2 max, uint16_t *items, uint32_t *marks)
+{
+    const PhysicsGrid *grid = &geometry->grid;
+    int count = 0;
+
+    if (grid->cols == 0) {
+        int itemCount = geometry->wallCount + geometry->bumperCount;
+        for (int i = 0; i < itemCount; i++) items[count++] = (uint16_t)i;
+        return count;
+    }
+
+    float inv = 1.0f/grid->cellSize;
+    int x0 = (int)floorf((min.x - grid->origin.x)*inv);
+    int x1 = (int)floorf((max.x - grid->origin.x)*inv);
+    int y0 = (int)floorf((min.y - grid->origin.y)*inv);
+    int y1 = (int)floorf((max.y - grid->origin.y)*inv);
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= grid->cols) x1 = grid->cols - 1;
+    if (y1 >= grid->rows) y1 = grid->rows - 1;
+
+    // NOTE: Items spanning several cells are kept the first time only, the marks are cleared again from the list
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            int cell = y*grid->cols + x;
+            for (uint32_t i = grid->cellStart[cell]; i < grid->cellStart[cell + 1]; i++) {
+                uint16_t item = grid->items[i];
+                uint32_t bit = 1u << (item & 31);
+                if (marks[item >> 5] & bit) continue;
+                marks[item >> 5] |= bit;
+                items[count++] = item;
+            }
+        }
+    }
+    for (int i = 0; i < count; i++) marks[items[i] >> 5] = 0;
+
+    return count;
+}
+
+// Moves one ball through a tick against the course, velocity was already pulled and capped.
+// Returns false if the ball snapped into the hole.
+static bool MoveBall(const PhysicsWorld *world, BallMotion *ball)
+{
+    // 1. Outside the sink: one swept move, stopping exactly where the path enters the sink
+    float remaining = 1.0f;
+    if (Vector2Distance(ball->position, world->hole) >= SINK_DISTANCE) {
+        remaining -= SweepBall(world, ball, remaining, true);
+    }
+
+    // 2. Inside the sink: sub-step the move, sized so the ball never travels past the snap disk
+    if (remaining > 0.0f) {
+        float travel = Vector2Length(ball->velocity)*world->moveScale*remaining;
+        int substeps = (int)ceilf(travel/SINK_MAX_TRAVEL);
+        if (substeps < 1) substeps = 1;
+        if (substeps > PHYSICS_MAX_SUBSTEPS) substeps = PHYSICS_MAX_SUBSTEPS;
+
+        float h = remaining/(float)substeps;
+
+        for (int i = 0; i < substeps; i++) {
+            // When very close and moving slowly, snap it in (Win condition)
+            if (Vector2Distance(ball->position, world->hole) < SINK_SNAP_DISTANCE &&
+                Vector2LengthSqr(ball->velocity) < SINK_SNAP_SPEED_SQR) return false;
+
+            SweepBall(world, ball, h, false);
+        }
+    }
+
+    return true;
+}
+
+// Records an impact of this tick, dropped when the frame already has PHYSICS_MAX_IMPACTS
+static void AddImpact(PhysicsWorld *world, int32_t type, int ball, float speed)
+{
+    if (world->impactCount >= PHYSICS_MAX_IMPACTS) return;
+
+    PhysicsImpact *impact = &world->impacts[world->impactCount++];
+    impact->type = type;
+    impact->ball = ball;
+    impact->speed = speed;
+    impact->position = PhysicsGetBallPosition(world, ball);
+    impact->tick = world->tick;
+}
+
+// Pushes two overlapping balls apart and exchanges the normal part of their velocities (equal masses)
+// Returns the speed at which they closed in (0 when already separating)
+static float ResolveBallContact(PhysicsBalls *balls, int a, int b)
+{
+    Vector2 delta = { balls->x[b] - balls->x[a], balls->y[b] - balls->y[a] };
+    float distSqr = Vector2LengthSqr(delta);
+    float minDist = 2.0f*BALL_RADIUS;
+
+    if (distSqr >= minDist*minDist) return 0.0f;
+
+    float dist = sqrtf(distSqr);
+    Vector2 normal = (dist > 0.0f)? Vector2Scale(delta, 1.0f/dist) : (Vector2){ 1.0f, 0.0f };
+
+    Vector2 push = Vector2Scale(normal, 0.5f*(minDist - dist));
+    balls->x[a] -= push.x;
+    balls->y[a] -= push.y;
+    balls->x[b] += push.x;
+    balls->y[b] += push.y;
+
+    Vector2 relative = { balls->vx[b] - balls->vx[a], balls->vy[b] - balls->vy[a] };
+    float vn = Vector2DotProduct(relative, normal);
+    if (vn < 0.0f) {
+        Vector2 impulse = Vector2Scale(normal, -0.5f*(1.0f + BALL_RESTITUTION)*vn);
+        balls->vx[a] -= impulse.x;
+        balls->vy[a] -= impulse.y;
+        balls->vx[b] += impulse.x;
+        balls->vy[b] += impulse.y;
+    }
+
+    return -vn;
+}
+
+// Narrowphase over the pairs found in the 3x3 cells around each ball
+// NOTE: Balls move a few pixels per tick at most, far less than their diameter,
+// so a discrete overlap test after the sweeps can't miss a contact
+static void ResolveBallContacts(PhysicsWorld *world)
+{
+    PhysicsBalls *balls = &world->balls;
+
+    for (int i = 0; i < world->ballCount; i++) {
+        if (balls->bucket[i] < 0) continue;
+
+        unsigned int tested = 0;    // Neighbouring cells can share a bucket, test each pair once
+
+        for (int y = balls->cellY[i] - 1; y <= balls->cellY[i] + 1; y++) {
+            for (int x = balls->cellX[i] - 1; x <= balls->cellX[i] + 1; x++) {
+                for (int j = world->ballBuckets[HashBallCell(x, y)]; j >= 0; j = balls->nextInBucket[j]) {
+                    if (j <= i || (tested & (1u << j))) continue;
+                    tested |= 1u << j;
+                    float speed = ResolveBallContact(balls, i, j);
+                    if (speed >= PHYSICS_MIN_IMPACT_SPEED) AddImpact(world, PHYSICS_IMPACT_BALL, i, speed);
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < world->ballCount; i++) UpdateBallCell(world, i);
+}
+
+void PhysicsStep(PhysicsWorld *world)
+{
+    PhysicsBalls *balls = &world->balls;
+    uint32_t live[PHYSICS_MAX_BALLS];
+
+    world->tick++;
+
+    for (int i = 0; i < PHYSICS_MAX_BALLS; i++) {
+        balls->previousX[i] = balls->x[i];
+        balls->previousY[i] = balls->y[i];
+        live[i] = (i < world->ballCount && !balls->sunk[i] && !balls->inHazard[i])? 0xffffffffu : 0u;
+    }
+
+    IntegrateBounce(balls, live, world->width, world->height);
+
+    for (int i = 0; i < world->ballCount; i++) {
+        if (!live[i]) continue;
+
+        BallMotion ball = { .position = { balls->x[i], balls->y[i] }, .velocity = { balls->vx[i], balls->vy[i] } };
+        if (!ApplyAreas(world, &ball)) {
+            balls->inHazard[i] = true;
+            live[i] = 0u;
+        }
+        balls->vx[i] = ball.velocity.x;
+        balls->vy[i] = ball.velocity.y;
+    }
+
+    IntegrateTerrain(world, balls, live);
+    IntegratePullAndCap(balls, live, world->hole, SINK_PULL*world->tickScale);
+
+    for (int i = 0; i < world->ballCount; i++) {
+        if (!live[i]) continue;
+
+        BallMotion ball = { .position = { balls->x[i], balls->y[i] }, .velocity = { balls->vx[i], balls->vy[i] } };
+        if (MoveBall(world, &ball)) {
+            balls->x[i] = ball.position.x;
+            balls->y[i] = ball.position.y;
+            balls->vx[i] = ball.velocity.x;
+            balls->vy[i] = ball.velocity.y;
+            if (ball.impactSpeed >= PHYSICS_MIN_IMPACT_SPEED) AddImpact(world, ball.impactType, i, ball.impactSpeed);
+        }
+        else {
+            balls->sunk[i] = true;
+            balls->x[i] = world->hole.x;
+            balls->y[i] = world->hole.y;
+            balls->previousX[i] = world->hole.x;
+            balls->previousY[i] = world->hole.y;
+            balls->vx[i] = 0.0f;
+            balls->vy[i] = 0.0f;
+            live[i] = 0u;
+            AddImpact(world, PHYSICS_IMPACT_CUP, i, Vector2Length(ball.velocity));
+        }
+    }
+
+    IntegrateFriction(balls, live, world->friction);
+
+    for (int i = 0; i < world->ballCount; i++) UpdateBallCell(world, i);
+    if ((world->ballCount > 1) && !world->ghostBalls) ResolveBallContacts(world);
+}
+
+int PhysicsBeginFrame(PhysicsWorld *world, float frameTime)
+{
+    // A long hitch (app resumed, debugger) would otherwise try to catch up for seconds
+    if (frameTime > PHYSICS_MAX_FRAME_TIME) frameTime = PHYSICS_MAX_FRAME_TIME;
+    if (frameTime < 0.0f) frameTime = 0.0f;
+
+    world->accumulator += frameTime;
+    world->impactCount = 0;
+
+    // NOTE: Ticks are taken from the accumulator now, the render blend (leftover time) is right once they ran
+    int steps = 0;
+    while (world->accumulator >= world->dt) {
+        world->accumulator -= world->dt;
+        steps++;
+    }
+
+    return steps;
+}
+
+Vector2 PhysicsGetRenderPosition(const PhysicsWorld *world, int index)
+{
+    float alpha = world->accumulator/world->dt;
+    Vector2 previous = { world->balls.previousX[index], world->balls.previousY[index] };
+    return Vector2Lerp(previous, PhysicsGetBallPosition(world, index), alpha);
+}
+
+uint64_t PhysicsGetBallHash(const PhysicsWorld *world, int index)
+{
+    const PhysicsBalls *balls = &world->balls;
+    const float values[4] = { balls->x[index], balls->y[index], balls->vx[index], balls->vy[index] };
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    // FNV-1a over the bit patterns, 32 bits at a time
+    for (int i = 0; i < 4; i++) {
+        uint32_t bits = 0;
+        memcpy(&bits, &values[i], sizeof(bits));
+        hash = (hash ^ bits)*0x100000001b3ull;
+    }
+    hash = (hash ^ (uint32_t)((balls->sunk[index]? 1u : 0u) | (balls->inHazard[index]? 2u : 0u)))*0x100000001b3ull;
+
+    return hash;
+}
+
+bool PhysicsIsBallStopped(const PhysicsWorld *world, int index)
+{
+    return Vector2LengthSqr(PhysicsGetBallVelocity(world, index)) < STOPPED_SPEED_SQR;
+}
@@ -0,0 +1,320 @@
+#ifndef PHYSICS_H
+#define PHYSICS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// NOTE: Same guard raylib/raymath use, so this header also works without raylib.h
+// When both are used, include raylib.h first
+#if !defined(RL_VECTOR2_TYPE)
+typedef struct Vector2 {
+    float x;
+    float y;
+} Vector2;
+#define RL_VECTOR2_TYPE
+#endif
+
+// --- Simulation Rate ---
+// Physics runs at a fixed rate, no matter how fast frames are rendered
+#define PHYSICS_TICK_RATE           240
+// Gameplay constants below were tuned "per frame" at 60 FPS.
+// Velocities are still expressed in pixels per reference frame, each tick covers a fraction of it.
+#define PHYSICS_REFERENCE_RATE      60
+// Never simulate more than this many ticks in one rendered frame (avoids the spiral of death after a hitch)
+#define PHYSICS_MAX_FRAME_TIME      0.25f
+
+// --- Gameplay Constants ---
+#define SINK_DISTANCE               45.0f   // Distance threshold for automatic sinking
+#define SINK_PULL                   0.5f    // Strength of the pull towards the center of the hole
+#define SINK_SNAP_DISTANCE          5.0f    // Ball snaps into the hole closer than this...
+#define SINK_SNAP_SPEED_SQR         1.0f    // ...when moving slower than this (squared)
+#define BALL_RADIUS                 30.0f   // Ball radius for collision
+#define MAX_VELOCITY                15.0f   // Hard velocity cap (px per reference frame)
+#define FRICTION                    0.95f   // Velocity kept after one reference frame
+#define BOUNCE_RESTITUTION          0.8f    // Velocity kept after bouncing on an edge
+#define STOPPED_SPEED_SQR           0.1f    // Ball counts as stopped below this speed (squared)
+#define TERRAIN_GRAVITY             1.0f    // Push of a 1:1 terrain slope (px per reference frame, per frame)
+#define TERRAIN_REST_SLOPE          0.015f  // A stopped ball stays put on terrain pushing less than this (static friction)
+
+// --- Continuous Collision ---
+#define PHYSICS_MAX_BOUNCES         4       // Wall impacts resolved per tick (the rest of the tick is dropped)
+#define SINK_MAX_TRAVEL             SINK_SNAP_DISTANCE  // Max travel per sub-step inside the sink, so the snap disk can't be skipped
+#define PHYSICS_MAX_SUBSTEPS        16      // Upper bound on sink sub-steps in one tick
+
+// --- Multi-Ball ---
+#define PHYSICS_MAX_BALLS           8       // Balls simulated together (party mode)
+#define BALL_RESTITUTION            0.9f    // Velocity kept along the normal when two balls collide
+// Ball broadphase: spatial hash of cells at least one ball diameter wide,
+// so two touching balls are always in the same or neighbouring cells
+#define PHYSICS_BALL_CELL_SIZE      (2.0f*BALL_RADIUS)
+#define PHYSICS_BALL_BUCKETS        64      // Hash buckets (power of two)
+
+// --- Impact Events ---
+// Bounces, ball contacts and the ball dropping into the cup, reported for sounds and haptics
+#define PHYSICS_MAX_IMPACTS         16      // Impacts kept per frame (see PhysicsBeginFrame()), later ones are dropped
+#define PHYSICS_MIN_IMPACT_SPEED    0.25f   // Slower impacts (px per reference frame along the normal) are not reported
+
+// --- Vector Integrator ---
+// Velocity cap, friction, terrain, sink pull and playfield bounce run 4 balls per instruction
+// with NEON (arm64-v8a) or SSE2 (x86, x86_64), and give bit-identical results to the scalar path.
+// Define PHYSICS_NO_SIMD to force the scalar path (armeabi-v7a always uses it, its NEON has no IEEE div/sqrt)
+#define PHYSICS_SIMD_WIDTH          4
+#if (PHYSICS_MAX_BALLS % PHYSICS_SIMD_WIDTH) != 0
+    #error "PHYSICS_MAX_BALLS must be a multiple of PHYSICS_SIMD_WIDTH"
+#endif
+
+// --- Determinism ---
+// Rounds are stored and sent as shot inputs only (replay.h, netplay.h), so a tick must give the same bits
+// on every device and on the desktop tools, for scores to be checked by re-simulating them. The simulation
+// only uses IEEE single precision adds, multiplies, divides and square roots (correctly rounded on every
+// Android ABI and on desktop), never contracted into FMAs (golfsim is built with -ffp-contract=off) and
+// never libm transcendentals (pow is computed by the simulation itself). physics.c refuses to build with
+// -ffast-math or with extended precision intermediates. See PhysicsGetBallHash() to compare runs.
+
+// NOTE: Geometry structs below are also the on-disk layout of course files (see course.h),
+// so they only use 32-bit fields and must not change without bumping COURSE_FILE_VERSION
+
+// Wall the ball bounces off, treated as a capsule of radius BALL_RADIUS around it
+typedef struct PhysicsSegment {
+    Vector2 a;
+    Vector2 b;
+} PhysicsSegment;
+
+// Round obstacle
+typedef struct PhysicsBumper {
+    Vector2 center;
+    float radius;
+    float restitution;          // Velocity kept after bouncing on it (> 1 kicks the ball)
+} PhysicsBumper;
+
+typedef enum {
+    AREA_SLOPE = 0,             // Constant push along 'slope' (px per reference frame, per frame)
+    AREA_ROUGH,                 // Extra friction (sand, rough)
+    AREA_WATER,                 // Hazard: ball is taken out and replayed from its last spot
+} PhysicsAreaType;
+
+// Rectangular patch of the green that changes how the ball rolls
+typedef struct PhysicsArea {
+    float x, y, width, height;
+    int32_t type;               // PhysicsAreaType
+    float friction;             // AREA_ROUGH: velocity kept per reference frame (multiplies FRICTION)
+    Vector2 slope;              // AREA_SLOPE: acceleration
+} PhysicsArea;
+
+// Terrain sample, 4 bytes so a terrain is also an RGBA8 texture (the game shades the green from it)
+// Slopes are the downhill push, -TERRAIN_GRAVITY times the height gradient, baked by CoursePackBuild()
+typedef struct PhysicsTerrainSample {
+    uint8_t slopeX;             // 128 is flat, 1 and 255 are -slopeScale and +slopeScale
+    uint8_t slopeY;
+    uint8_t height;             // 0 is the lowest sample, 255 is heightScale above it (shading only)
+    uint8_t friction;           // Velocity kept per reference frame (multiplies FRICTION), 255 keeps it all
+} PhysicsTerrainSample;
+
+// Height field under the playfield: one sample per grid node, blended bilinearly between the 4 nodes around
+// the ball (clamped to the edge samples outside of the grid)
+typedef struct PhysicsTerrain {
+    Vector2 origin;             // Position of sample 0
+    float cellSize;             // Distance between two samples
+    int cols;                   // Samples per row, 0 for a flat green
+    int rows;
+    float slopeScale;           // Push of a slope channel at 1 or 255 (px per reference frame, per frame)
+    float heightScale;          // Height of the height channel at 255 (px)
+    const PhysicsTerrainSample *samples;    // cols*rows, row by row
+} PhysicsTerrain;
+
+// Uniform grid over walls and bumpers, each cell lists obstacles closer than BALL_RADIUS to it
+// Items are wall indices, or wallCount + bumper index
+typedef struct PhysicsGrid {
+    Vector2 origin;
+    float cellSize;
+    int cols;
+    int rows;
+    const uint32_t *cellStart;  // cols*rows + 1 entries, cell i items are [cellStart[i], cellStart[i + 1])
+    const uint16_t *items;
+} PhysicsGrid;
+
+// Static course geometry (not owned by the world, usually points into a loaded course file)
+typedef struct PhysicsGeometry {
+    const PhysicsSegment *walls;
+    int wallCount;
+    const PhysicsBumper *bumpers;
+    int bumperCount;
+    const PhysicsArea *areas;
+    int areaCount;
+    PhysicsGrid grid;           // Optional: cols == 0 tests every obstacle
+    PhysicsTerrain terrain;     // Optional: cols == 0 is flat with no extra friction
+} PhysicsGeometry;
+
+typedef enum {
+    PHYSICS_IMPACT_WALL = 0,    // Wall or playfield edge
+    PHYSICS_IMPACT_BUMPER,
+    PHYSICS_IMPACT_BALL,        // Two balls touching, 'ball' is the lower index
+    PHYSICS_IMPACT_CUP,         // Ball snapped into the hole, 'speed' is its speed then
+} PhysicsImpactType;
+
+// Strongest impact of one ball during one tick
+typedef struct PhysicsImpact {
+    int32_t type;               // PhysicsImpactType
+    int32_t ball;
+    float speed;                // Speed along the contact normal, px per reference frame
+    Vector2 position;           // Ball position after the tick
+    unsigned int tick;
+} PhysicsImpact;
+
+// Ball store, kept as structure of arrays so the per-tick integration runs several balls per instruction
+// NOTE: Lanes at or past ballCount are kept at zero and out of play, so vector code can always run
+// over PHYSICS_MAX_BALLS lanes
+typedef struct PhysicsBalls {
+    float x[PHYSICS_MAX_BALLS];             // Position after the last tick
+    float y[PHYSICS_MAX_BALLS];
+    float previousX[PHYSICS_MAX_BALLS];     // Position before the last tick, used for render interpolation
+    float previousY[PHYSICS_MAX_BALLS];
+    float vx[PHYSICS_MAX_BALLS];            // Velocity in px per reference frame
+    float vy[PHYSICS_MAX_BALLS];
+    bool sunk[PHYSICS_MAX_BALLS];           // Set when the ball snapped into the hole
+    bool inHazard[PHYSICS_MAX_BALLS];       // Set when the ball rolled into a water area (cleared by PhysicsResetBall())
+
+    // Broadphase links, kept up to date by the world as balls move
+    int cellX[PHYSICS_MAX_BALLS];
+    int cellY[PHYSICS_MAX_BALLS];
+    int bucket[PHYSICS_MAX_BALLS];          // -1 while out of play (sunk or in a hazard)
+    int nextInBucket[PHYSICS_MAX_BALLS];    // Next ball index in the same bucket, -1 ends the list
+} PhysicsBalls;
+
+typedef struct PhysicsWorld {
+    PhysicsBalls balls;
+    int ballCount;
+    int ballBuckets[PHYSICS_BALL_BUCKETS];  // First ball index in each hash bucket, -1 if empty
+    Vector2 hole;
+    float width;                // Playfield size (balls are kept inside [0, width]x[0, height])
+    float height;
+    bool ghostBalls;            // Balls pass through each other (independent shots simulated side by side)
+
+    PhysicsGeometry geometry;   // Course obstacles (see PhysicsSetGeometry())
+
+    // Fixed-step state
+    int tickRate;               // Ticks per second
+    float dt;                   // Seconds per tick
+    float tickScale;            // Fraction of a reference frame covered by one tick
+    float friction;             // FRICTION converted to one tick
+    float moveScale;            // Velocity to displacement factor for one tick
+    float terrainSlope;         // Terrain slope channel step converted to one tick (see PhysicsSetGeometry())
+    float terrainFriction[256]; // Terrain friction channel converted to the velocity kept for one tick
+    float accumulator;          // Unsimulated time carried to the next frame
+    unsigned int tick;          // Ticks simulated since PhysicsInit()
+
+    // Impacts of the ticks run since the last PhysicsBeginFrame(), PhysicsStep() only appends
+    PhysicsImpact impacts[PHYSICS_MAX_IMPACTS];
+    int impactCount;
+} PhysicsWorld;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Initializes the world for a given tick rate (0 uses PHYSICS_TICK_RATE), with no balls.
+ */
+void PhysicsInit(PhysicsWorld *world, int tickRate);
+
+/**
+ * @brief Adds a ball at rest.
+ *
+ * @return The ball index, or -1 if there are already PHYSICS_MAX_BALLS balls.
+ */
+int PhysicsAddBall(PhysicsWorld *world, Vector2 position);
+
+/**
+ * @brief Sets the course obstacles and terrain. Arrays referenced by the geometry must outlive the world.
+ *
+ * Call after PhysicsInit(), the terrain is converted for the tick rate.
+ */
+void PhysicsSetGeometry(PhysicsWorld *world, PhysicsGeometry geometry);
+
+/**
+ * @brief Lists the walls and bumpers that may reach into a rectangle, each once (for drawing what is in view).
+ *
+ * Items are numbered as in PhysicsGrid. Only the grid cells under the rectangle are read, so the cost follows
+ * the area and not the course, every item is listed without a grid. 'items' has room for wallCount + bumperCount
+ * indices, 'marks' is a bit set of (wallCount + bumperCount + 31)/32 words, clear on entry and left clear.
+ *
+ * @return Number of items written.
+ */
+int PhysicsQueryGeometry(const PhysicsGeometry *geometry, Vector2 min, Vector2 max, uint16_t *items, uint32_t *marks);
+
+/**
+ * @brief Places a ball at rest and puts it back in play.
+ */
+void PhysicsResetBall(PhysicsWorld *world, int index, Vector2 position);
+
+/**
+ * @brief Places a ball with a given velocity and puts it back in play (state restored from elsewhere).
+ */
+void PhysicsSetBallState(PhysicsWorld *world, int index, Vector2 position, Vector2 velocity);
+
+/**
+ * @brief Adds an impulse (px per reference frame) to a ball.
+ */
+void PhysicsShoot(PhysicsWorld *world, int index, Vector2 impulse);
+
+/**
+ * @brief Gets a ball position after the last tick.
+ */
+Vector2 PhysicsGetBallPosition(const PhysicsWorld *world, int index);
+
+/**
+ * @brief Gets a ball velocity (px per reference frame).
+ */
+Vector2 PhysicsGetBallVelocity(const PhysicsWorld *world, int index);
+
+/**
+ * @brief Gets the velocity kept per reference frame by the surface at a position, on top of FRICTION.
+ *
+ * Rough areas and the terrain friction, 1 on the plain green (for effects, PhysicsStep() applies them per tick).
+ */
+float PhysicsGetSurfaceFriction(const PhysicsWorld *world, Vector2 position);
+
+/**
+ * @brief Simulates exactly one fixed tick.
+ *
+ * Lane-wise work (bounce, terrain, sink pull, velocity cap, friction) runs over all balls at once.
+ * Walls and playfield edges are hit at their exact time of impact, and the sink
+ * is entered exactly where the path crosses SINK_DISTANCE. Only the part of a tick
+ * spent inside the sink is sub-stepped, so shots far from the hole cost one sweep.
+ * Ball vs ball contacts are then resolved for pairs found in neighbouring hash cells.
+ */
+void PhysicsStep(PhysicsWorld *world);
+
+/**
+ * @brief Consumes a rendered frame's elapsed time in fixed ticks, the caller then runs them with PhysicsStep().
+ *
+ * The impacts of the previous frame are cleared, world->impacts then lists those of the ticks run.
+ * NOTE: The rules (GolfUpdate()) must run after each tick, as replays and netplay re-simulate them, so
+ * the ticks are only counted here.
+ *
+ * @return Number of ticks to simulate this frame.
+ */
+int PhysicsBeginFrame(PhysicsWorld *world, float frameTime);
+
+/**
+ * @brief Ball position blended between the last two ticks for the current frame.
+ */
+Vector2 PhysicsGetRenderPosition(const PhysicsWorld *world, int index);
+
+/**
+ * @brief Hashes a ball state (position, velocity and play flags, as bits).
+ *
+ * Equal on two machines only if both simulated exactly the same ticks, for cross-device checks (tools/shotsim).
+ */
+uint64_t PhysicsGetBallHash(const PhysicsWorld *world, int index);
+
+/**
+ * @brief Checks if a ball is slow enough to take a new shot.
+ */
+bool PhysicsIsBallStopped(const PhysicsWorld *world, int index);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // PHYSICS_H
@@ -0,0 +1,287 @@
+#include "replay.h"
+#include "varint.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define REPLAY_MAGIC                'R'
+#define REPLAY_EVENT_SHOT           0
+#define REPLAY_EVENT_END            1
+
+//----------------------------------------------------------------------------------
+// Round encoding
+//----------------------------------------------------------------------------------
+// Appends bytes to the round being recorded, drops the round if it gets too long
+static void AppendRound(ReplayRecorder *recorder, const unsigned char *bytes, unsigned int count)
+{
+    if (recorder->overflow || (recorder->roundSize + count > REPLAY_MAX_ROUND_SIZE)) {
+        recorder->overflow = true;
+        return;
+    }
+
+    memcpy(recorder->round + recorder->roundSize, bytes, count);
+    recorder->roundSize += count;
+}
+
+static void AppendEvent(ReplayRecorder *recorder, unsigned int tick, int type)
+{
+    unsigned char bytes[5];
+    uint32_t delta = tick - recorder->lastTick;
+    recorder->lastTick = tick;
+    AppendRound(recorder, bytes, EncodeVarint(bytes, (delta << 1) | (uint32_t)type));
+}
+
+//----------------------------------------------------------------------------------
+// Ring buffer
+//----------------------------------------------------------------------------------
+static unsigned char RingByte(const ReplayRecorder *recorder, unsigned int offset)
+{
+    return recorder->ring[(recorder->head + offset)%recorder->capacity];
+}
+
+// Reads the size prefix of the round at 'offset' (from the oldest byte), returns its total size
+static unsigned int RingRoundSpan(const ReplayRecorder *recorder, unsigned int offset, unsigned int *prefix)
+{
+    uint32_t size = 0;
+    unsigned int count = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        unsigned char byte = RingByte(recorder, offset + count++);
+        size |= (uint32_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) break;
+    }
+
+    *prefix = count;
+    return count + size;
+}
+
+// Makes room for 'count' more bytes, growing the ring first and dropping the oldest rounds at max capacity
+static bool RingReserve(ReplayRecorder *recorder, unsigned int count)
+{
+    if (count > REPLAY_MAX_CAPACITY) return false;
+
+    if (recorder->size + count > recorder->capacity && recorder->capacity < REPLAY_MAX_CAPACITY) {
+        unsigned int capacity = (recorder->capacity > 0)? recorder->capacity : REPLAY_INITIAL_CAPACITY;
+        while (capacity < recorder->size + count && capacity < REPLAY_MAX_CAPACITY) capacity *= 2;
+        if (capacity > REPLAY_MAX_CAPACITY) capacity = REPLAY_MAX_CAPACITY;
+
+        unsigned char *ring = (unsigned char *)malloc(capacity);
+        if (ring == NULL) return false;
+
+        // Linearize the old contents at the start of the new ring
+        for (unsigned int i = 0; i < recorder->size; i++) ring[i] = RingByte(recorder, i);
+
+        free(recorder->ring);
+        recorder->ring = ring;
+        recorder->capacity = capacity;
+        recorder->head = 0;
+    }
+
+    while (recorder->size + count > recorder->capacity && recorder->roundCount > 0) {
+        unsigned int prefix = 0;
+        unsigned int span = RingRoundSpan(recorder, 0, &prefix);
+        recorder->head = (recorder->head + span)%recorder->capacity;
+        recorder->size -= span;
+        recorder->roundCount--;
+    }
+
+    return recorder->size + count <= recorder->capacity;
+}
+
+static void RingWrite(ReplayRecorder *recorder, const unsigned char *bytes, unsigned int count)
+{
+    for (unsigned int i = 0; i < count; i++) {
+        recorder->ring[(recorder->head + recorder->size)%recorder->capacity] = bytes[i];
+        recorder->size++;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Recording
+//----------------------------------------------------------------------------------
+unsigned int ReplayEncodeRoundInfo(const ReplayRoundInfo *info, unsigned char *out)
+{
+    unsigned int count = 0;
+    count += EncodeVarint(out + count, (uint32_t)info->tickRate);
+    count += EncodeVarint(out + count, ZigZag(info->holeIndex));
+
+    // NOTE: Positions are kept bit exact, they are the initial state of the simulation
+    const float values[6] = { info->start.x, info->start.y, info->cup.x, info->cup.y, info->size.x, info->size.y };
+    for (int i = 0; i < 6; i++, count += 4) WriteFloat(out + count, values[i]);
+
+    return count;
+}
+
+bool ReplayDecodeRoundInfo(const unsigned char *data, unsigned int size, unsigned int *offset, ReplayRoundInfo *info)
+{
+    uint32_t tickRate = 0, holeIndex = 0;
+    float values[6] = { 0 };
+    if (!DecodeVarint(data, size, offset, &tickRate) ||
+        !DecodeVarint(data, size, offset, &holeIndex)) return false;
+    for (int i = 0; i < 6; i++) if (!ReadFloat(data, size, offset, &values[i])) return false;
+
+    info->tickRate = (int)tickRate;
+    info->holeIndex = UnZigZag(holeIndex);
+    info->start = (Vector2){ values[0], values[1] };
+    info->cup = (Vector2){ values[2], values[3] };
+    info->size = (Vector2){ values[4], values[5] };
+
+    return true;
+}
+
+void ReplayRecorderInit(ReplayRecorder *recorder)
+{
+    memset(recorder, 0, sizeof(ReplayRecorder));
+}
+
+void ReplayRecorderFree(ReplayRecorder *recorder)
+{
+    free(recorder->ring);
+    ReplayRecorderInit(recorder);
+}
+
+void ReplayBeginRound(ReplayRecorder *recorder, const ReplayRoundInfo *info, unsigned int tick)
+{
+    unsigned char bytes[2 + REPLAY_ROUND_INFO_MAX_SIZE];
+    unsigned int count = 0;
+
+    bytes[count++] = REPLAY_MAGIC;
+    bytes[count++] = REPLAY_VERSION;
+    count += ReplayEncodeRoundInfo(info, bytes + count);
+
+    recorder->roundSize = 0;
+    recorder->lastTick = tick;
+    recorder->recording = true;
+    recorder->overflow = false;
+    AppendRound(recorder, bytes, count);
+}
+
+void ReplayRecordShot(ReplayRecorder *recorder, unsigned int tick, Vector2 dragVector)
+{
+    if (!recorder->recording) return;
+
+    Vector2 drag = GolfQuantizeDrag(dragVector);
+    unsigned char bytes[10];
+    unsigned int count = 0;
+
+    AppendEvent(recorder, tick, REPLAY_EVENT_SHOT);
+    count += EncodeVarint(bytes + count, ZigZag((int32_t)lrintf(drag.x*SHOT_DRAG_PRECISION)));
+    count += EncodeVarint(bytes + count, ZigZag((int32_t)lrintf(drag.y*SHOT_DRAG_PRECISION)));
+    AppendRound(recorder, bytes, count);
+}
+
+bool ReplayEndRound(ReplayRecorder *recorder, unsigned int tick)
+{
+    if (!recorder->recording) return false;
+
+    AppendEvent(recorder, tick, REPLAY_EVENT_END);
+    recorder->recording = false;
+    if (recorder->overflow) return false;
+
+    unsigned char prefix[5];
+    unsigned int prefixSize = EncodeVarint(prefix, recorder->roundSize);
+    if (!RingReserve(recorder, prefixSize + recorder->roundSize)) return false;
+
+    RingWrite(recorder, prefix, prefixSize);
+    RingWrite(recorder, recorder->round, recorder->roundSize);
+    recorder->roundCount++;
+
+    return true;
+}
+
+unsigned int ReplayGetRound(const ReplayRecorder *recorder, int index, unsigned char *buffer, unsigned int bufferSize)
+{
+    if (index < 0 || index >= recorder->roundCount) return 0;
+
+    // Rounds are stored oldest first
+    unsigned int offset = 0, prefix = 0;
+    for (int i = recorder->roundCount - 1; i > index; i--) offset += RingRoundSpan(recorder, offset, &prefix);
+
+    unsigned int size = RingRoundSpan(recorder, offset, &prefix) - prefix;
+    if (size > bufferSize) return 0;
+
+    for (unsigned int i = 0; i < size; i++) buffer[i] = RingByte(recorder, offset + prefix + i);
+
+    return size;
+}
+
+//----------------------------------------------------------------------------------
+// Playback
+//----------------------------------------------------------------------------------
+
+// Reads the next event, a malformed or truncated stream ends the playback
+static void ReadEvent(ReplayPlayback *playback)
+{
+    uint32_t header = 0, x = 0, y = 0;
+
+    if (!DecodeVarint(playback->data, playback->size, &playback->offset, &header)) {
+        playback->finished = true;
+        return;
+    }
+
+    playback->eventTick += header >> 1;
+    playback->eventType = (int)(header & 1);
+
+    if (playback->eventType == REPLAY_EVENT_SHOT) {
+        if (!DecodeVarint(playback->data, playback->size, &playback->offset, &x) ||
+            !DecodeVarint(playback->data, playback->size, &playback->offset, &y)) {
+            playback->finished = true;
+            return;
+        }
+
+        playback->eventDrag = (Vector2){ (float)UnZigZag(x)/SHOT_DRAG_PRECISION, (float)UnZigZag(y)/SHOT_DRAG_PRECISION };
+    }
+}
+
+bool ReplayPlaybackStart(ReplayPlayback *playback, const unsigned char *data, unsigned int size, PhysicsWorld *world, PhysicsGeometry geometry)
+{
+    memset(playback, 0, sizeof(ReplayPlayback));
+    playback->data = data;
+    playback->size = size;
+
+    if (size < 2 || data[0] != REPLAY_MAGIC || data[1] != REPLAY_VERSION) return false;
+    playback->offset = 2;
+
+    ReplayRoundInfo *info = &playback->info;
+    if (!ReplayDecodeRoundInfo(data, size, &playback->offset, info)) return false;
+
+    PhysicsInit(world, info->tickRate);
+    PhysicsSetGeometry(world, geometry);
+    world->hole = info->cup;
+    world->width = info->size.x;
+    world->height = info->size.y;
+
+    playback->player.ball = PhysicsAddBall(world, info->start);
+    GolfPlayerStart(&playback->player, world, info->start);
+
+    ReadEvent(playback);
+
+    return !playback->finished;
+}
+
+int ReplayPlaybackAdvance(ReplayPlayback *playback, PhysicsWorld *world, int maxTicks)
+{
+    int ticks = 0;
+
+    while (!playback->finished && ticks < maxTicks) {
+        // Shots are taken between ticks, exactly where they were recorded
+        while (!playback->finished && playback->eventTick <= playback->tick) {
+            if (playback->eventType == REPLAY_EVENT_END) {
+                playback->finished = true;
+                break;
+            }
+
+            GolfShoot(&playback->player, world, playback->eventDrag);
+            ReadEvent(playback);
+        }
+
+        if (playback->finished) break;
+
+        PhysicsStep(world);
+        GolfUpdate(&playback->player, world);
+        playback->tick++;
+        ticks++;
+    }
+
+    return ticks;
+}
@@ -0,0 +1,132 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "physics.h"
+#include "rules.h"
+
+// --- Replay Recording ---
+// A round is stored as its setup plus the shots, each shot being the tick it was taken at
+// (delta from the previous event) and the drag vector (in 1/SHOT_DRAG_PRECISION px).
+// Everything is zigzag/LEB128 varint encoded, so a whole round usually takes a few dozen bytes.
+// Since the physics is deterministic per tick, replaying the shots rebuilds the exact round.
+#define REPLAY_VERSION              2
+#define REPLAY_INITIAL_CAPACITY     1024        // Ring buffer start size (bytes)
+#define REPLAY_MAX_CAPACITY         (64*1024)   // Ring buffer stops growing here, oldest rounds are dropped
+#define REPLAY_MAX_ROUND_SIZE       4096        // Max encoded size of one round (bytes)
+#define REPLAY_ROUND_INFO_MAX_SIZE  34          // Max encoded size of a round setup (bytes)
+
+// Setup of a recorded round
+typedef struct ReplayRoundInfo {
+    int tickRate;               // Physics tick rate of the recording
+    int holeIndex;              // Course hole index, -1 for a random hole
+    Vector2 start;              // Ball start position
+    Vector2 cup;                // Hole position
+    Vector2 size;               // Playfield size
+} ReplayRoundInfo;
+
+// Recorder keeping the most recent rounds in a growable ring buffer
+typedef struct ReplayRecorder {
+    unsigned char *ring;        // Encoded rounds, each prefixed by its varint size
+    unsigned int capacity;
+    unsigned int head;          // Offset of the oldest byte
+    unsigned int size;          // Bytes used
+    int roundCount;
+
+    unsigned char round[REPLAY_MAX_ROUND_SIZE];     // Round being recorded
+    unsigned int roundSize;
+    unsigned int lastTick;      // Tick of the last recorded event
+    bool recording;
+    bool overflow;              // Round too long, it won't be kept
+} ReplayRecorder;
+
+// Re-simulation state of one recorded round
+typedef struct ReplayPlayback {
+    const unsigned char *data;
+    unsigned int size;
+    unsigned int offset;        // Next event
+    ReplayRoundInfo info;
+
+    GolfPlayer player;
+    unsigned int tick;          // Ticks simulated since the round start
+    unsigned int eventTick;     // Tick of the next event
+    int eventType;
+    Vector2 eventDrag;
+    bool finished;
+} ReplayPlayback;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Initializes an empty recorder.
+ */
+void ReplayRecorderInit(ReplayRecorder *recorder);
+
+/**
+ * @brief Releases the recorder ring buffer.
+ */
+void ReplayRecorderFree(ReplayRecorder *recorder);
+
+/**
+ * @brief Encodes a round setup (also sent by netplay.h), at most REPLAY_ROUND_INFO_MAX_SIZE bytes.
+ *
+ * @return Bytes written.
+ */
+unsigned int ReplayEncodeRoundInfo(const ReplayRoundInfo *info, unsigned char *out);
+
+/**
+ * @brief Decodes a round setup at 'offset', moved past it.
+ *
+ * @return false if the data is truncated.
+ */
+bool ReplayDecodeRoundInfo(const unsigned char *data, unsigned int size, unsigned int *offset, ReplayRoundInfo *info);
+
+/**
+ * @brief Starts recording a round, 'tick' is the world tick at the round start.
+ */
+void ReplayBeginRound(ReplayRecorder *recorder, const ReplayRoundInfo *info, unsigned int tick);
+
+/**
+ * @brief Records a shot taken after world tick 'tick' (call right before GolfShoot()).
+ */
+void ReplayRecordShot(ReplayRecorder *recorder, unsigned int tick, Vector2 dragVector);
+
+/**
+ * @brief Ends the current round and moves it into the ring buffer.
+ *
+ * @return true if the round was kept.
+ */
+bool ReplayEndRound(ReplayRecorder *recorder, unsigned int tick);
+
+/**
+ * @brief Copies a recorded round out of the ring buffer (0 is the most recent one).
+ *
+ * @return Size of the round in bytes, 0 if there is no such round or it doesn't fit.
+ */
+unsigned int ReplayGetRound(const ReplayRecorder *recorder, int index, unsigned char *buffer, unsigned int bufferSize);
+
+/**
+ * @brief Reads the setup of an encoded round and prepares a world to replay it.
+ *
+ * The world is reinitialized at the recorded tick rate with one ball, geometry must be
+ * the one of the recorded hole. The data must stay alive while the playback is used.
+ *
+ * @return false if the data isn't a valid round.
+ */
+bool ReplayPlaybackStart(ReplayPlayback *playback, const unsigned char *data, unsigned int size, PhysicsWorld *world, PhysicsGeometry geometry);
+
+/**
+ * @brief Re-simulates up to 'maxTicks' ticks, applying the recorded shots on their ticks.
+ *
+ * There is no frame pacing, so whole rounds re-simulate much faster than real time.
+ *
+ * @return Ticks simulated (0 once the round is finished).
+ */
+int ReplayPlaybackAdvance(ReplayPlayback *playback, PhysicsWorld *world, int maxTicks);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // REPLAY_H
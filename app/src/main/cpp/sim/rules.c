@@ -0,0 +1,58 @@
+#include "rules.h"
+
+#include <math.h>
+
+Vector2 GolfQuantizeDrag(Vector2 dragVector)
+{
+    return (Vector2){ rintf(dragVector.x*SHOT_DRAG_PRECISION)/SHOT_DRAG_PRECISION, rintf(dragVector.y*SHOT_DRAG_PRECISION)/SHOT_DRAG_PRECISION };
+}
+
+float GolfGetShotPower(Vector2 dragVector)
+{
+    float dragDistance = sqrtf(dragVector.x*dragVector.x + dragVector.y*dragVector.y);
+    return fminf(dragDistance/SHOT_MAX_DRAG_DISTANCE, 1.0f);
+}
+
+Vector2 GolfGetShotImpulse(Vector2 dragVector)
+{
+    float scale = SHOT_POWER_SCALE*GolfGetShotPower(dragVector);
+    return (Vector2){ dragVector.x*scale, dragVector.y*scale };
+}
+
+void GolfPlayerStart(GolfPlayer *player, PhysicsWorld *world, Vector2 start)
+{
+    PhysicsResetBall(world, player->ball, start);
+    player->strokes = 0;
+    player->lastShotPosition = start;
+    player->holed = false;
+}
+
+bool GolfCanShoot(const GolfPlayer *player, const PhysicsWorld *world)
+{
+    return !player->holed && PhysicsIsBallStopped(world, player->ball);
+}
+
+void GolfShoot(GolfPlayer *player, PhysicsWorld *world, Vector2 dragVector)
+{
+    player->lastShotPosition = PhysicsGetBallPosition(world, player->ball);
+    PhysicsShoot(world, player->ball, GolfGetShotImpulse(GolfQuantizeDrag(dragVector)));
+    player->strokes++;
+}
+
+bool GolfUpdate(GolfPlayer *player, PhysicsWorld *world)
+{
+    if (player->holed) return false;
+
+    // Water hazard: penalty stroke, replay from where the shot was taken
+    if (world->balls.inHazard[player->ball]) {
+        player->strokes += HAZARD_PENALTY_STROKES;
+        PhysicsResetBall(world, player->ball, player->lastShotPosition);
+    }
+
+    if (world->balls.sunk[player->ball]) {
+        player->holed = true;
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,65 @@
+#ifndef RULES_H
+#define RULES_H
+
+#include "physics.h"
+
+// --- Shot Rules ---
+#define SHOT_MAX_DRAG_DISTANCE      200.0f  // Drag length (px) giving full power
+#define SHOT_POWER_SCALE            0.15f   // Drag to impulse factor at full power (px per reference frame per px)
+#define HAZARD_PENALTY_STROKES      1       // Strokes added when the ball ends in water
+#define SHOT_DRAG_PRECISION         8.0f    // Drags are rounded to 1/8 px, so recorded shots replay exactly
+
+// One player's state on the current hole
+typedef struct GolfPlayer {
+    int ball;                   // Ball index in the physics world
+    int strokes;                // Strokes on this hole, penalties included
+    Vector2 lastShotPosition;   // Where the ball is replayed from after a water hazard
+    bool holed;                 // Set once the ball is in the hole
+} GolfPlayer;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Rounds a drag vector to SHOT_DRAG_PRECISION (done by GolfShoot()).
+ */
+Vector2 GolfQuantizeDrag(Vector2 dragVector);
+
+/**
+ * @brief Gets the shot power for a drag vector, in [0, 1].
+ */
+float GolfGetShotPower(Vector2 dragVector);
+
+/**
+ * @brief Gets the ball impulse (px per reference frame) for a drag vector (from drag end to drag start).
+ */
+Vector2 GolfGetShotImpulse(Vector2 dragVector);
+
+/**
+ * @brief Places the player's ball at the start of a hole and clears the score.
+ */
+void GolfPlayerStart(GolfPlayer *player, PhysicsWorld *world, Vector2 start);
+
+/**
+ * @brief Checks if the player may take a shot (ball at rest and not holed yet).
+ */
+bool GolfCanShoot(const GolfPlayer *player, const PhysicsWorld *world);
+
+/**
+ * @brief Takes a shot: one stroke, ball pushed along the drag vector.
+ */
+void GolfShoot(GolfPlayer *player, PhysicsWorld *world, Vector2 dragVector);
+
+/**
+ * @brief Applies the rules after the physics advanced (water penalty and replay, holing out).
+ *
+ * @return true if the ball went into the hole since the last call.
+ */
+bool GolfUpdate(GolfPlayer *player, PhysicsWorld *world);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // RULES_H
@@ -0,0 +1,74 @@
+#ifndef VARINT_H
+#define VARINT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// --- Encoding Helpers ---
+// Shared by the replay and netplay encoders: zigzag/LEB128 varints (small values of either sign take
+// one byte) and floats kept bit exact, little endian. Decoders check every read against the end of the data.
+#define VARINT_MAX_SIZE             5       // Bytes of the longest 32-bit varint
+
+static inline unsigned int EncodeVarint(unsigned char *out, uint32_t value)
+{
+    unsigned int count = 0;
+    while (value >= 0x80) {
+        out[count++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    out[count++] = (unsigned char)value;
+    return count;
+}
+
+static inline uint32_t ZigZag(int32_t value) { return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31); }
+static inline int32_t UnZigZag(uint32_t value) { return (int32_t)(value >> 1) ^ -(int32_t)(value & 1); }
+
+static inline bool DecodeVarint(const unsigned char *data, unsigned int size, unsigned int *offset, uint32_t *value)
+{
+    uint32_t result = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (*offset >= size) return false;
+        unsigned char byte = data[(*offset)++];
+        result |= (uint32_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static inline uint32_t FloatBits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static inline float BitsFloat(uint32_t bits)
+{
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static inline void WriteFloat(unsigned char *out, float value)
+{
+    uint32_t bits = FloatBits(value);
+    for (int i = 0; i < 4; i++) out[i] = (unsigned char)(bits >> (8*i));
+}
+
+static inline bool ReadFloat(const unsigned char *data, unsigned int size, unsigned int *offset, float *value)
+{
+    if (*offset > size || size - *offset < 4) return false;
+
+    uint32_t bits = 0;
+    for (int i = 0; i < 4; i++) bits |= (uint32_t)data[*offset + i] << (8*i);
+    *value = BitsFloat(bits);
+    *offset += 4;
+
+    return true;
+}
+
+#endif // VARINT_H
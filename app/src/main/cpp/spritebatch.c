@@ -0,0 +1,189 @@
+#include "spritebatch.h"
+#include "rlgl.h"
+
+#include <raymath.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(SPRITE_BATCH_INSTANCING)
+#if defined(GRAPHICS_API_OPENGL_ES3)
+    #define SPRITE_GLSL_VERSION "#version 300 es\n"
+#else
+    #define SPRITE_GLSL_VERSION "#version 330\n"
+#endif
+
+// Quad corner, expanded by the instance transform (rotation about origin, as in DrawTexturePro())
+static const char *spriteVertexShader = SPRITE_GLSL_VERSION
+    "in vec2 corner;\n"
+    "in vec4 instanceDest;\n"
+    "in vec3 instanceOrigin;\n"
+    "in vec4 instanceSource;\n"
+    "in vec4 instanceColor;\n"
+    "uniform mat4 mvp;\n"
+    "out vec2 fragTexCoord;\n"
+    "out vec4 fragColor;\n"
+    "void main()\n"
+    "{\n"
+    "    vec2 local = corner*instanceDest.zw - instanceOrigin.xy;\n"
+    "    float s = sin(instanceOrigin.z);\n"
+    "    float c = cos(instanceOrigin.z);\n"
+    "    vec2 position = instanceDest.xy + vec2(c*local.x - s*local.y, s*local.x + c*local.y);\n"
+    "    fragTexCoord = mix(instanceSource.xy, instanceSource.zw, corner);\n"
+    "    fragColor = instanceColor;\n"
+    "    gl_Position = mvp*vec4(position, 0.0, 1.0);\n"
+    "}\n";
+
+static const char *spriteFragmentShader = SPRITE_GLSL_VERSION
+    "precision mediump float;\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "out vec4 finalColor;\n"
+    "void main()\n"
+    "{\n"
+    "    finalColor = texture(texture0, fragTexCoord)*fragColor;\n"
+    "}\n";
+
+// Two triangles, drawn with RL_TRIANGLES by rlDrawVertexArrayInstanced()
+static const float quadCorners[12] = { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+
+static void LoadInstanceAttribute(Shader shader, const char *name, int size, int type, bool normalized, int offset)
+{
+    int location = GetShaderLocationAttrib(shader, name);
+    if (location < 0) return;
+
+    rlSetVertexAttribute((unsigned int)location, size, type, normalized, sizeof(SpriteInstance), offset);
+    rlEnableVertexAttribute((unsigned int)location);
+    rlSetVertexAttributeDivisor((unsigned int)location, 1);
+}
+#endif
+
+void SpriteBatchInit(SpriteBatch *batch)
+{
+    memset(batch, 0, sizeof(SpriteBatch));
+
+#if defined(SPRITE_BATCH_INSTANCING)
+    batch->shader = LoadShaderFromMemory(spriteVertexShader, spriteFragmentShader);
+    if (!IsShaderValid(batch->shader) || (batch->shader.id == rlGetShaderIdDefault())) {
+        TraceLog(LOG_WARNING, "SPRITES: Instancing shader failed to load, sprites are drawn one by one");
+        batch->shader = (Shader){ 0 };
+        return;
+    }
+
+    batch->mvpLoc = GetShaderLocation(batch->shader, "mvp");
+    int cornerLoc = GetShaderLocationAttrib(batch->shader, "corner");
+    int textureSlot = 0;
+    SetShaderValue(batch->shader, GetShaderLocation(batch->shader, "texture0"), &textureSlot, SHADER_UNIFORM_INT);
+
+    batch->cornerVboId = rlLoadVertexBuffer(quadCorners, sizeof(quadCorners), false);
+
+    for (int i = 0; i < SPRITE_BATCH_BUFFERS; i++) {
+        batch->vaoIds[i] = rlLoadVertexArray();
+        rlEnableVertexArray(batch->vaoIds[i]);
+
+        rlEnableVertexBuffer(batch->cornerVboId);
+        rlSetVertexAttribute((unsigned int)cornerLoc, 2, RL_FLOAT, false, 0, 0);
+        rlEnableVertexAttribute((unsigned int)cornerLoc);
+
+        batch->instanceVboIds[i] = rlLoadVertexBuffer(NULL, SPRITE_BATCH_MAX_INSTANCES*sizeof(SpriteInstance), true);
+        LoadInstanceAttribute(batch->shader, "instanceDest", 4, RL_FLOAT, false, offsetof(SpriteInstance, dest));
+        LoadInstanceAttribute(batch->shader, "instanceOrigin", 3, RL_FLOAT, false, offsetof(SpriteInstance, origin));
+        LoadInstanceAttribute(batch->shader, "instanceSource", 4, RL_FLOAT, false, offsetof(SpriteInstance, source));
+        LoadInstanceAttribute(batch->shader, "instanceColor", 4, RL_UNSIGNED_BYTE, true, offsetof(SpriteInstance, color));
+
+        rlDisableVertexArray();
+    }
+    rlDisableVertexBuffer();
+
+    batch->instances = (SpriteInstance *)MemAlloc(SPRITE_BATCH_MAX_INSTANCES*sizeof(SpriteInstance));
+    batch->instanced = (cornerLoc >= 0) && (batch->vaoIds[0] != 0) && (batch->instances != NULL);
+
+    if (batch->instanced) TraceLog(LOG_INFO, "SPRITES: Instanced sprite batch ready (%i sprites per draw call)", SPRITE_BATCH_MAX_INSTANCES);
+    else TraceLog(LOG_WARNING, "SPRITES: Instancing not available, sprites are drawn one by one");
+#endif
+}
+
+void SpriteBatchUnload(SpriteBatch *batch)
+{
+#if defined(SPRITE_BATCH_INSTANCING)
+    for (int i = 0; i < SPRITE_BATCH_BUFFERS; i++) {
+        if (batch->vaoIds[i] != 0) rlUnloadVertexArray(batch->vaoIds[i]);
+        if (batch->instanceVboIds[i] != 0) rlUnloadVertexBuffer(batch->instanceVboIds[i]);
+    }
+    if (batch->cornerVboId != 0) rlUnloadVertexBuffer(batch->cornerVboId);
+    if (batch->shader.id != 0) UnloadShader(batch->shader);
+    MemFree(batch->instances);
+#endif
+    memset(batch, 0, sizeof(SpriteBatch));
+}
+
+void SpriteBatchRestore(SpriteBatch *batch)
+{
+    MemFree(batch->shader.locs);
+    MemFree(batch->instances);
+    SpriteBatchInit(batch);
+}
+
+static void FlushSprites(SpriteBatch *batch)
+{
+#if defined(SPRITE_BATCH_INSTANCING)
+    if (batch->count == 0) return;
+
+    // Whatever rlgl batched before is drawn first, so draw order is kept
+    rlDrawRenderBatchActive();
+
+    Matrix mvp = MatrixMultiply(MatrixMultiply(rlGetMatrixTransform(), rlGetMatrixModelview()), rlGetMatrixProjection());
+    int buffer = batch->currentBuffer;
+
+    rlUpdateVertexBuffer(batch->instanceVboIds[buffer], batch->instances, batch->count*(int)sizeof(SpriteInstance), 0);
+
+    rlEnableShader(batch->shader.id);
+    rlSetUniformMatrix(batch->mvpLoc, mvp);
+    rlActiveTextureSlot(0);
+    rlEnableTexture(batch->texture.id);
+
+    rlEnableVertexArray(batch->vaoIds[buffer]);
+    rlDrawVertexArrayInstanced(0, 6, batch->count);
+    rlDisableVertexArray();
+
+    rlDisableTexture();
+    rlDisableShader();
+
+    batch->currentBuffer = (buffer + 1)%SPRITE_BATCH_BUFFERS;
+    batch->count = 0;
+#else
+    (void)batch;
+#endif
+}
+
+void SpriteBatchBegin(SpriteBatch *batch, Texture2D texture)
+{
+    batch->texture = texture;
+    batch->count = 0;
+}
+
+void SpriteBatchDraw(SpriteBatch *batch, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint)
+{
+    if (!batch->instanced) {
+        DrawTexturePro(batch->texture, source, dest, origin, rotation, tint);
+        return;
+    }
+
+    if (batch->count == SPRITE_BATCH_MAX_INSTANCES) FlushSprites(batch);
+
+    float width = (float)batch->texture.width;
+    float height = (float)batch->texture.height;
+    SpriteInstance *instance = &batch->instances[batch->count++];
+
+    *instance = (SpriteInstance){
+        { dest.x, dest.y, dest.width, dest.height },
+        { origin.x, origin.y, rotation*DEG2RAD },
+        { source.x/width, source.y/height, (source.x + source.width)/width, (source.y + source.height)/height },
+        { tint.r, tint.g, tint.b, tint.a }
+    };
+}
+
+void SpriteBatchEnd(SpriteBatch *batch)
+{
+    FlushSprites(batch);
+}
@@ -0,0 +1,75 @@
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+#include "raylib.h"
+
+// --- Instanced Sprite Batch ---
+// Many sprites of one texture drawn with a single instanced draw call: each sprite is one instance
+// (transform, UV rect and tint, 48 bytes) expanded to a quad by the vertex shader, instead of four
+// vertices built on the CPU by the rlgl batch. Needs OpenGL ES 3.0 (GL_VERSION ES30 or higher),
+// other builds, or a shader that fails to load, draw every sprite with DrawTexturePro().
+#define SPRITE_BATCH_MAX_INSTANCES  4096    // Instances per draw call, the batch flushes when full
+#define SPRITE_BATCH_BUFFERS        2       // Instance buffers used in turns, so an upload never waits for the previous draw
+
+#if defined(GRAPHICS_API_OPENGL_ES3) || defined(GRAPHICS_API_OPENGL_33)
+    #define SPRITE_BATCH_INSTANCING
+#endif
+
+// One sprite, as read by the vertex shader
+typedef struct SpriteInstance {
+    float dest[4];              // Position (x, y) and size
+    float origin[3];            // Rotation origin (relative to dest), rotation (radians)
+    float source[4];            // Texture coordinates (u0, v0, u1, v1)
+    unsigned char color[4];
+} SpriteInstance;
+
+typedef struct SpriteBatch {
+    bool instanced;             // Instancing available, otherwise sprites go through DrawTexturePro()
+    Shader shader;
+    int mvpLoc;
+    unsigned int vaoIds[SPRITE_BATCH_BUFFERS];
+    unsigned int instanceVboIds[SPRITE_BATCH_BUFFERS];
+    unsigned int cornerVboId;   // Quad corners, shared by all the vertex arrays
+    int currentBuffer;
+
+    Texture2D texture;          // Texture of the sprites being batched
+    SpriteInstance *instances;
+    int count;
+} SpriteBatch;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Loads the instancing shader and buffers (after InitWindow()).
+ */
+void SpriteBatchInit(SpriteBatch *batch);
+
+void SpriteBatchUnload(SpriteBatch *batch);
+
+/**
+ * @brief Loads the shader and buffers again on a new GL context, the lost ones are dropped (see gpuresources.h).
+ */
+void SpriteBatchRestore(SpriteBatch *batch);
+
+/**
+ * @brief Starts batching sprites of one texture, anything drawn until SpriteBatchEnd() must be batch sprites.
+ */
+void SpriteBatchBegin(SpriteBatch *batch, Texture2D texture);
+
+/**
+ * @brief Adds one sprite of the batch texture, same parameters as DrawTexturePro().
+ */
+void SpriteBatchDraw(SpriteBatch *batch, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint);
+
+/**
+ * @brief Draws the sprites added since SpriteBatchBegin().
+ */
+void SpriteBatchEnd(SpriteBatch *batch);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // SPRITEBATCH_H
@@ -0,0 +1,147 @@
+#include "staticlayer.h"
+#include "rlgl.h"
+
+#include <math.h>
+#include <string.h>
+
+static bool IsSameGeometry(const PhysicsGeometry *a, const PhysicsGeometry *b)
+{
+    return (a->walls == b->walls) && (a->wallCount == b->wallCount) &&
+           (a->bumpers == b->bumpers) && (a->bumperCount == b->bumperCount) &&
+           (a->areas == b->areas) && (a->areaCount == b->areaCount) && (a->terrain.samples == b->terrain.samples);
+}
+
+// Redraws one world area of the layer, layer pixels outside of it are kept
+static void RedrawRegion(const StaticLayer *layer, Rectangle region, StaticLayerDrawFunc draw)
+{
+    float x = (region.x - layer->area.x)*layer->scale;
+    float y = (region.y - layer->area.y)*layer->scale;
+
+    BeginScissorMode((int)x, (int)y, (int)(region.width*layer->scale + 1.0f), (int)(region.height*layer->scale + 1.0f));
+        ClearBackground(GREEN);
+        draw(region);
+    EndScissorMode();
+}
+
+// Layer texture as the render target, drawn in world coordinates
+static void BeginLayer(const StaticLayer *layer)
+{
+    Camera2D camera = { 0 };
+    camera.target = (Vector2){ layer->area.x, layer->area.y };
+    camera.zoom = layer->scale;
+
+    // NOTE: Alpha accumulates towards opaque, translucent areas would otherwise leave see-through pixels
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+
+    BeginTextureMode(layer->target);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    BeginMode2D(camera);
+}
+
+static void EndLayer(void)
+{
+    EndMode2D();
+    EndBlendMode();
+    EndTextureMode();
+}
+
+// Layer size along one axis: the view and its margins, no more than the course unless the view is larger
+static float GetLayerExtent(float view, float course)
+{
+    return fmaxf(view, fminf(view*(1.0f + 2.0f*STATIC_LAYER_MARGIN), course));
+}
+
+// Layer start along one axis: centred on the view, kept over the course (or the view, past the course edges)
+static float GetLayerStart(float viewStart, float viewSize, float extent, float course)
+{
+    float start = viewStart + (viewSize - extent)/2.0f;
+    start = fminf(fmaxf(start, fminf(0.0f, viewStart)), fmaxf(course, viewStart + viewSize) - extent);
+    return roundf(start);
+}
+
+// NOTE: A pixel of slack, layer starts are rounded to whole pixels
+static bool IsViewInside(Rectangle view, Rectangle area)
+{
+    return (view.x >= area.x - 1.0f) && (view.y >= area.y - 1.0f) &&
+           (view.x + view.width <= area.x + area.width + 1.0f) && (view.y + view.height <= area.y + area.height + 1.0f);
+}
+
+void StaticLayerUpdate(StaticLayer *layer, const PhysicsWorld *world, Rectangle view, Vector2 cupSize, StaticLayerDrawFunc draw)
+{
+    float scale = (float)GetRenderWidth()/(float)GetScreenWidth();
+    Rectangle area = layer->area;
+    area.width = GetLayerExtent(view.width, world->width);
+    area.height = GetLayerExtent(view.height, world->height);
+    Rectangle cup = {
+        world->hole.x - cupSize.x/2.0f - STATIC_LAYER_CUP_MARGIN,
+        world->hole.y - cupSize.y/2.0f - STATIC_LAYER_CUP_MARGIN,
+        cupSize.x + 2.0f*STATIC_LAYER_CUP_MARGIN,
+        cupSize.y + 2.0f*STATIC_LAYER_CUP_MARGIN
+    };
+
+    bool sameSize = layer->valid && (scale == layer->scale) && (area.width == layer->area.width) && (area.height == layer->area.height);
+    bool sameArea = sameSize && IsViewInside(view, layer->area);
+    bool sameCourse = sameArea && IsSameGeometry(&world->geometry, &layer->geometry);
+    if (sameCourse && (memcmp(&cup, &layer->cup, sizeof(Rectangle)) == 0)) return;
+
+    // View past the layer edge: the layer moves to be centred on it again
+    if (!sameArea) {
+        area.x = GetLayerStart(view.x, view.width, area.width, world->width);
+        area.y = GetLayerStart(view.y, view.height, area.height, world->height);
+    }
+
+    // NOTE: The layer is drawn at render resolution, the scene is given in world coordinates
+    int width = (int)ceilf(area.width*scale);
+    int height = (int)ceilf(area.height*scale);
+    if ((layer->target.id == 0) || (layer->target.texture.width != width) || (layer->target.texture.height != height)) {
+        if (layer->target.id != 0) UnloadRenderTexture(layer->target);
+        layer->target = LoadRenderTexture(width, height);
+    }
+    layer->scale = scale;
+    layer->area = area;
+
+    BeginLayer(layer);
+        if (sameCourse) {
+            // Only the cup moved: its old and new places are the only pixels that changed
+            RedrawRegion(layer, layer->cup, draw);
+            RedrawRegion(layer, cup, draw);
+        } else {
+            ClearBackground(GREEN);
+            draw(area);
+        }
+    EndLayer();
+
+    layer->valid = (layer->target.id != 0);
+    layer->geometry = world->geometry;
+    layer->cup = cup;
+}
+
+void StaticLayerRedrawRegion(StaticLayer *layer, Rectangle region, StaticLayerDrawFunc draw)
+{
+    if (!layer->valid || !CheckCollisionRecs(region, layer->area)) return;
+
+    BeginLayer(layer);
+        RedrawRegion(layer, region, draw);
+    EndLayer();
+}
+
+void StaticLayerDraw(const StaticLayer *layer)
+{
+    if (!layer->valid) return;
+
+    // NOTE: Render textures are stored upside down, hence the negative source height
+    Rectangle source = { 0.0f, 0.0f, (float)layer->target.texture.width, -(float)layer->target.texture.height };
+    Rectangle dest = { layer->area.x, layer->area.y, (float)layer->target.texture.width/layer->scale, (float)layer->target.texture.height/layer->scale };
+    DrawTexturePro(layer->target.texture, source, dest, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+}
+
+void StaticLayerUnload(StaticLayer *layer)
+{
+    if (layer->target.id != 0) UnloadRenderTexture(layer->target);
+    memset(layer, 0, sizeof(StaticLayer));
+}
+
+void StaticLayerRestore(StaticLayer *layer)
+{
+    memset(layer, 0, sizeof(StaticLayer));
+}
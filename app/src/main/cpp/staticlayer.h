@@ -0,0 +1,67 @@
+#ifndef STATICLAYER_H
+#define STATICLAYER_H
+
+#include "raylib.h"
+#include "physics.h"
+
+// --- Static Layer ---
+// Background, course geometry and cup change only between holes, so they are drawn once into a
+// render texture. Every frame then costs one opaque quad instead of the whole scene. The layer holds
+// the view and STATIC_LAYER_MARGIN of course around it (the whole course when it is smaller), and is
+// drawn again around the view when the course camera scrolls past its edge.
+#define STATIC_LAYER_CUP_MARGIN     4.0f    // Extra pixels around the cup when only it is redrawn
+#define STATIC_LAYER_MARGIN         0.25f   // Course held past each side of the view, share of the view size
+
+// Draws the static scene over 'area', in world coordinates (called only when the layer is out of date)
+// NOTE: Pixels outside of 'area' are clipped, the scene only needs to draw what reaches into it
+typedef void (*StaticLayerDrawFunc)(Rectangle area);
+
+typedef struct StaticLayer {
+    RenderTexture2D target;
+    bool valid;
+    float scale;                // Texels per world pixel (render resolution over screen size)
+    Rectangle area;             // World area held by the layer
+    PhysicsGeometry geometry;   // Course geometry the layer was drawn with (arrays are not owned)
+    Rectangle cup;              // World area covered by the cup
+} StaticLayer;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Redraws the layer when the view left it, or the screen size, the course geometry or the cup changed.
+ *
+ * Only the old and new cup areas are redrawn when nothing else changed (random holes on the same course),
+ * everything is redrawn otherwise. 'view' is the world area on screen (see GetCameraView()), 'cupSize' the
+ * size of the cup as drawn, centred on world->hole. Call outside of BeginDrawing()/EndDrawing().
+ */
+void StaticLayerUpdate(StaticLayer *layer, const PhysicsWorld *world, Rectangle view, Vector2 cupSize, StaticLayerDrawFunc draw);
+
+/**
+ * @brief Redraws one world area of the layer (content that streamed in, see CourseTilesUpdate()).
+ *
+ * Areas outside of the layer are skipped, they are drawn when the layer moves over them. Call outside
+ * of BeginDrawing()/EndDrawing().
+ */
+void StaticLayerRedrawRegion(StaticLayer *layer, Rectangle region, StaticLayerDrawFunc draw);
+
+/**
+ * @brief Draws the layer in world coordinates, under the camera of the last update.
+ *
+ * It is opaque and covers the view, nothing needs to be cleared under it.
+ */
+void StaticLayerDraw(const StaticLayer *layer);
+
+void StaticLayerUnload(StaticLayer *layer);
+
+/**
+ * @brief Drops the render texture of a lost GL context, the next update draws the layer again.
+ */
+void StaticLayerRestore(StaticLayer *layer);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // STATICLAYER_H
@@ -0,0 +1,130 @@
+#include "terraintexture.h"
+#include "rlgl.h"
+
+#include <string.h>
+
+#if defined(TERRAIN_TEXTURE_SHADER)
+#if defined(GRAPHICS_API_OPENGL_ES3)
+    #define TERRAIN_GLSL_VERSION "#version 300 es\n"
+#else
+    #define TERRAIN_GLSL_VERSION "#version 330\n"
+#endif
+
+static const char *terrainVertexShader = TERRAIN_GLSL_VERSION
+    "in vec3 vertexPosition;\n"
+    "in vec2 vertexTexCoord;\n"
+    "in vec4 vertexColor;\n"
+    "uniform mat4 mvp;\n"
+    "out vec2 fragTexCoord;\n"
+    "out vec4 fragColor;\n"
+    "void main()\n"
+    "{\n"
+    "    fragTexCoord = vertexTexCoord;\n"
+    "    fragColor = vertexColor;\n"
+    "    gl_Position = mvp*vec4(vertexPosition, 1.0);\n"
+    "}\n";
+
+// Channels as in PhysicsTerrainSample: slopes are the downhill push, so the surface normal leans along them.
+// Layers are composed as shade over contour lines over sand (straight alpha, drawn over the green)
+static const char *terrainFragmentShader = TERRAIN_GLSL_VERSION
+    "precision mediump float;\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform float relief;\n"
+    "uniform float contours;\n"
+    "out vec4 finalColor;\n"
+    "vec4 over(vec4 top, vec4 bottom)\n"
+    "{\n"
+    "    float a = top.a + bottom.a*(1.0 - top.a);\n"
+    "    return (a > 0.0)? vec4((top.rgb*top.a + bottom.rgb*bottom.a*(1.0 - top.a))/a, a) : vec4(0.0);\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "    vec4 terrain = texture(texture0, fragTexCoord);\n"
+    "    vec2 slope = (terrain.rg*255.0 - 128.0)/127.0*relief;\n"
+    "    vec3 normal = normalize(vec3(slope, 1.0));\n"
+    "    float light = dot(normal, vec3(-0.408, -0.408, 0.816))/0.816 - 1.0;\n"
+    "    vec4 shade = (light > 0.0)? vec4(1.0, 1.0, 0.85, min(light*1.5, 0.5)) : vec4(0.0, 0.15, 0.0, min(-light*1.5, 0.5));\n"
+    "    float level = terrain.b*contours;\n"
+    "    float line = (contours > 0.0)? 1.0 - smoothstep(0.0, 1.5*fwidth(level), abs(fract(level + 0.5) - 0.5)) : 0.0;\n"
+    "    vec4 sand = vec4(0.82, 0.71, 0.47, clamp((1.0 - terrain.a)*5.0, 0.0, 0.85));\n"
+    "    finalColor = over(shade, over(vec4(0.0, 0.2, 0.0, 0.25*line), sand))*fragColor;\n"
+    "}\n";
+#endif
+
+static void LoadTerrainShader(TerrainTexture *terrainTexture)
+{
+#if defined(TERRAIN_TEXTURE_SHADER)
+    terrainTexture->shader = LoadShaderFromMemory(terrainVertexShader, terrainFragmentShader);
+    if (!IsShaderValid(terrainTexture->shader) || (terrainTexture->shader.id == rlGetShaderIdDefault())) {
+        TraceLog(LOG_WARNING, "TERRAIN: Shader failed to load, the green is drawn without terrain shading");
+        terrainTexture->shader = (Shader){ 0 };
+        terrainTexture->shaderFailed = true;
+        return;
+    }
+
+    terrainTexture->reliefLoc = GetShaderLocation(terrainTexture->shader, "relief");
+    terrainTexture->contoursLoc = GetShaderLocation(terrainTexture->shader, "contours");
+#else
+    terrainTexture->shaderFailed = true;
+#endif
+}
+
+void TerrainTextureUpdate(TerrainTexture *terrainTexture, const PhysicsTerrain *terrain)
+{
+    const PhysicsTerrainSample *samples = (terrain->cols >= 2 && terrain->rows >= 2)? terrain->samples : NULL;
+    if ((samples == terrainTexture->samples) && ((samples == NULL) || (terrainTexture->texture.id != 0) || terrainTexture->shaderFailed)) return;
+
+    if (terrainTexture->texture.id != 0) UnloadTexture(terrainTexture->texture);
+    terrainTexture->texture = (Texture2D){ 0 };
+    terrainTexture->samples = samples;
+    if (samples == NULL) return;
+
+    if ((terrainTexture->shader.id == 0) && !terrainTexture->shaderFailed) LoadTerrainShader(terrainTexture);
+    if (terrainTexture->shader.id == 0) return;
+
+    // NOTE: The course data is uploaded in place, it is never copied nor converted
+    Image image = { (void *)samples, terrain->cols, terrain->rows, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    terrainTexture->texture = LoadTextureFromImage(image);
+    SetTextureFilter(terrainTexture->texture, TEXTURE_FILTER_BILINEAR);
+    SetTextureWrap(terrainTexture->texture, TEXTURE_WRAP_CLAMP);
+
+    TraceLog(LOG_INFO, "TERRAIN: %ix%i samples every %.0f px (%.0f px high)", terrain->cols, terrain->rows, terrain->cellSize, terrain->heightScale);
+}
+
+void TerrainTextureDraw(const TerrainTexture *terrainTexture, const PhysicsTerrain *terrain)
+{
+    if ((terrainTexture->texture.id == 0) || (terrainTexture->samples != terrain->samples)) return;
+
+    float relief = terrain->slopeScale/TERRAIN_GRAVITY*TERRAIN_SHADE_RELIEF;
+    float contours = terrain->heightScale/TERRAIN_CONTOUR_STEP;
+
+    // Texel centers on the sample nodes: the quad reaches half a cell past the first and last samples
+    Rectangle source = { 0.0f, 0.0f, (float)terrain->cols, (float)terrain->rows };
+    Rectangle dest = {
+        terrain->origin.x - terrain->cellSize/2.0f,
+        terrain->origin.y - terrain->cellSize/2.0f,
+        terrain->cols*terrain->cellSize,
+        terrain->rows*terrain->cellSize
+    };
+
+    BeginShaderMode(terrainTexture->shader);
+    SetShaderValue(terrainTexture->shader, terrainTexture->reliefLoc, &relief, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(terrainTexture->shader, terrainTexture->contoursLoc, &contours, SHADER_UNIFORM_FLOAT);
+    DrawTexturePro(terrainTexture->texture, source, dest, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+    EndShaderMode();
+}
+
+void TerrainTextureUnload(TerrainTexture *terrainTexture)
+{
+    if (terrainTexture->texture.id != 0) UnloadTexture(terrainTexture->texture);
+    if (terrainTexture->shader.id != 0) UnloadShader(terrainTexture->shader);
+    memset(terrainTexture, 0, sizeof(TerrainTexture));
+}
+
+void TerrainTextureRestore(TerrainTexture *terrainTexture)
+{
+    MemFree(terrainTexture->shader.locs);
+    memset(terrainTexture, 0, sizeof(TerrainTexture));
+}
@@ -0,0 +1,58 @@
+#ifndef TERRAINTEXTURE_H
+#define TERRAINTEXTURE_H
+
+#include "raylib.h"
+#include "physics.h"
+
+// --- Terrain Texture ---
+// The terrain samples of a hole (physics.h) are uploaded as they are into an RGBA8 texture, one texel
+// per sample, so the green is shaded from the very slopes, heights and friction the ball rolls on.
+// Texel centers sit on the sample nodes and the texture is filtered bilinearly and clamped, like the
+// physics blends them. A small shader turns the slopes into light and shade, adds height contour lines
+// and tints rough patches. It is drawn into the static layer, so it costs nothing per frame.
+// Needs OpenGL ES 3.0 (GL_VERSION ES30 or higher), other builds, or a shader that fails to load, draw
+// the green without terrain shading.
+#define TERRAIN_SHADE_RELIEF        4.0f    // Slopes are drawn this many times steeper than they are
+#define TERRAIN_CONTOUR_STEP        8.0f    // Height between two contour lines (px)
+
+#if defined(GRAPHICS_API_OPENGL_ES3) || defined(GRAPHICS_API_OPENGL_33)
+    #define TERRAIN_TEXTURE_SHADER
+#endif
+
+typedef struct TerrainTexture {
+    Texture2D texture;
+    Shader shader;
+    bool shaderFailed;          // Not retried until the next GL context
+    int reliefLoc;
+    int contoursLoc;
+    const PhysicsTerrainSample *samples;    // Terrain held by the texture (not owned), NULL when none
+} TerrainTexture;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Uploads the terrain when it changed (hole switch), a flat green unloads the texture.
+ *
+ * Call outside of BeginDrawing()/EndDrawing(), before the static layer is drawn.
+ */
+void TerrainTextureUpdate(TerrainTexture *terrainTexture, const PhysicsTerrain *terrain);
+
+/**
+ * @brief Draws the shaded terrain over the green, in world coordinates.
+ */
+void TerrainTextureDraw(const TerrainTexture *terrainTexture, const PhysicsTerrain *terrain);
+
+void TerrainTextureUnload(TerrainTexture *terrainTexture);
+
+/**
+ * @brief Drops the texture and shader of a lost GL context, the next update loads them again.
+ */
+void TerrainTextureRestore(TerrainTexture *terrainTexture);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // TERRAINTEXTURE_H
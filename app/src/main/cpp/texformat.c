@@ -0,0 +1,49 @@
+#include "texformat.h"
+#include "rlgl.h"
+
+#include <stdio.h>
+#include <string.h>
+
+TextureFileFormat GetBestTextureFormat(void)
+{
+    static int bestFormat = -1;
+
+    if (bestFormat < 0) {
+        if (rlIsPixelFormatSupported(PIXELFORMAT_COMPRESSED_ASTC_4x4_RGBA)) bestFormat = TEXTURE_FORMAT_ASTC;
+        else if (rlIsPixelFormatSupported(PIXELFORMAT_COMPRESSED_ETC2_EAC_RGBA)) bestFormat = TEXTURE_FORMAT_ETC2;
+        else bestFormat = TEXTURE_FORMAT_PNG;
+
+        const char *names[] = { "PNG (RGBA8)", "ETC2", "ASTC 4x4" };
+        TraceLog(LOG_INFO, "TEXFORMAT: Compressed textures use %s", names[bestFormat]);
+    }
+
+    return (TextureFileFormat)bestFormat;
+}
+
+Texture2D LoadTextureCompressed(const char *fileName)
+{
+    Image image = LoadImageCompressed(fileName);
+    Texture2D texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+
+    return texture;
+}
+
+Image LoadImageCompressed(const char *fileName)
+{
+    static const char *extensions[] = { NULL, ".ktx", ".astc" };
+    const char *dot = strrchr(fileName, '.');
+    int length = (dot != NULL)? (int)(dot - fileName) : (int)strlen(fileName);
+
+    // Best format first, ETC2 is also tried on ASTC devices when only the .ktx was shipped
+    // NOTE: FileExists() can't see into the APK assets, a missing file just fails to load
+    for (int format = GetBestTextureFormat(); format > TEXTURE_FORMAT_PNG; format--) {
+        char compressedFile[256] = { 0 };
+        snprintf(compressedFile, sizeof(compressedFile), "%.*s%s", length, fileName, extensions[format]);
+
+        Image image = LoadImage(compressedFile);
+        if (image.data != NULL) return image;
+    }
+
+    return LoadImage(fileName);
+}
@@ -0,0 +1,40 @@
+#ifndef TEXFORMAT_H
+#define TEXFORMAT_H
+
+#include "raylib.h"
+
+// --- GPU Compressed Textures ---
+// Big images can be shipped pre-encoded by tools/texcompress next to their PNG: <name>.astc (ASTC 4x4)
+// and <name>.ktx (ETC2 RGBA8 EAC). Both take 8 bits per pixel in VRAM instead of 32 and are uploaded
+// as is, without PNG decoding. The best format the GL extensions support is picked at startup (ASTC,
+// then ETC2, core in OpenGL ES 3.0), the PNG is loaded when no compressed file can be used.
+typedef enum {
+    TEXTURE_FORMAT_PNG = 0,             // No GPU compressed format available, images are decoded to RGBA8
+    TEXTURE_FORMAT_ETC2,
+    TEXTURE_FORMAT_ASTC
+} TextureFileFormat;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Best compressed format supported by the device (after InitWindow()), checked once.
+ */
+TextureFileFormat GetBestTextureFormat(void);
+
+/**
+ * @brief Loads 'fileName' (a .png) from its compressed version in the best supported format when it exists.
+ */
+Texture2D LoadTextureCompressed(const char *fileName);
+
+/**
+ * @brief Image version of LoadTextureCompressed(), for any thread once GetBestTextureFormat() was called.
+ */
+Image LoadImageCompressed(const char *fileName);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // TEXFORMAT_H
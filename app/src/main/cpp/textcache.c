@@ -0,0 +1,158 @@
+#include "textcache.h"
+#include "rlgl.h"
+
+#include <string.h>
+
+#define TEXT_LINE_SPACING   2       // rtext default, SetTextLineSpacing() is not used by the game
+
+// FNV-1a over the string and the layout parameters
+static unsigned int HashTextRun(const char *text, unsigned int fontId, float fontSize, float spacing)
+{
+    unsigned int hash = 2166136261u;
+    unsigned int params[3] = { fontId, 0, 0 };
+    memcpy(&params[1], &fontSize, sizeof(float));
+    memcpy(&params[2], &spacing, sizeof(float));
+
+    for (const unsigned char *c = (const unsigned char *)text; *c != '\0'; c++) hash = (hash ^ *c)*16777619u;
+    for (int i = 0; i < (int)sizeof(params); i++) hash = (hash ^ ((const unsigned char *)params)[i])*16777619u;
+
+    return (hash != 0)? hash : 1;
+}
+
+static void AddGlyphQuad(TextRun *run, Font font, int index, float x, float y, float scaleFactor)
+{
+    if (run->glyphCount == run->glyphCapacity) {
+        int capacity = (run->glyphCapacity > 0)? run->glyphCapacity*2 : 16;
+        TextGlyphQuad *glyphs = (TextGlyphQuad *)MemRealloc(run->glyphs, capacity*sizeof(TextGlyphQuad));
+        if (glyphs == NULL) return;
+
+        run->glyphs = glyphs;
+        run->glyphCapacity = capacity;
+    }
+
+    // Same rectangles as DrawTextCodepoint(), glyph padding included
+    float padding = (float)font.glyphPadding;
+    Rectangle source = { font.recs[index].x - padding, font.recs[index].y - padding,
+                         font.recs[index].width + 2.0f*padding, font.recs[index].height + 2.0f*padding };
+    float dx = x + (font.glyphs[index].offsetX - padding)*scaleFactor;
+    float dy = y + (font.glyphs[index].offsetY - padding)*scaleFactor;
+
+    TextGlyphQuad *quad = &run->glyphs[run->glyphCount++];
+    quad->x0 = dx;
+    quad->y0 = dy;
+    quad->x1 = dx + source.width*scaleFactor;
+    quad->y1 = dy + source.height*scaleFactor;
+    quad->u0 = source.x/(float)font.texture.width;
+    quad->v0 = source.y/(float)font.texture.height;
+    quad->u1 = (source.x + source.width)/(float)font.texture.width;
+    quad->v1 = (source.y + source.height)/(float)font.texture.height;
+}
+
+// Glyph walk of DrawTextEx(), recording the quads instead of drawing them
+static void LayoutTextRun(TextRun *run, Font font, const char *text)
+{
+    float scaleFactor = run->fontSize/(float)font.baseSize;
+    float offsetX = 0.0f;
+    float offsetY = 0.0f;
+    int size = TextLength(text);
+
+    run->glyphCount = 0;
+    run->texture = font.texture;
+    run->size = MeasureTextEx(font, text, run->fontSize, run->spacing);
+
+    for (int i = 0; i < size;) {
+        int byteCount = 0;
+        int codepoint = GetCodepointNext(&text[i], &byteCount);
+        int index = GetGlyphIndex(font, codepoint);
+
+        if (codepoint == '\n') {
+            offsetY += run->fontSize + TEXT_LINE_SPACING;
+            offsetX = 0.0f;
+        } else {
+            if ((codepoint != ' ') && (codepoint != '\t')) AddGlyphQuad(run, font, index, offsetX, offsetY, scaleFactor);
+
+            if (font.glyphs[index].advanceX == 0) offsetX += (float)font.recs[index].width*scaleFactor + run->spacing;
+            else offsetX += (float)font.glyphs[index].advanceX*scaleFactor + run->spacing;
+        }
+
+        i += byteCount;
+    }
+}
+
+const TextRun *GetTextRun(TextCache *cache, Font font, const char *text, float fontSize, float spacing)
+{
+    if (font.texture.id == 0) font = GetFontDefault();
+    if (text == NULL) text = "";
+
+    unsigned int hash = HashTextRun(text, font.texture.id, fontSize, spacing);
+    TextRun *run = NULL;
+    cache->useCounter++;
+
+    for (int i = 0; i < TEXT_CACHE_RUNS; i++) {
+        TextRun *candidate = &cache->runs[i];
+
+        if (candidate->hash == hash && candidate->fontId == font.texture.id && candidate->fontSize == fontSize &&
+            candidate->spacing == spacing && strcmp(candidate->text, text) == 0) {
+            candidate->lastUse = cache->useCounter;
+            return candidate;
+        }
+
+        // Replaced if not found: least recently used run (empty slots were never used)
+        if (run == NULL || candidate->lastUse < run->lastUse) run = candidate;
+    }
+
+    size_t length = strlen(text);
+    char *copy = (char *)MemRealloc(run->text, (unsigned int)length + 1);
+    if (copy == NULL) {
+        run->hash = 0;
+        run->glyphCount = 0;
+        run->size = (Vector2){ 0.0f, 0.0f };
+        return run;
+    }
+    memcpy(copy, text, length + 1);
+
+    run->text = copy;
+    run->hash = hash;
+    run->lastUse = cache->useCounter;
+    run->fontId = font.texture.id;
+    run->fontSize = fontSize;
+    run->spacing = spacing;
+    LayoutTextRun(run, font, text);
+
+    return run;
+}
+
+void DrawTextRun(const TextRun *run, Vector2 position, Color tint)
+{
+    if (run->glyphCount == 0) return;
+
+    // NOTE: rlVertex3f() flushes the batch between quads when it fills up
+    rlSetTexture(run->texture.id);
+    rlBegin(RL_QUADS);
+
+        rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+
+        for (int i = 0; i < run->glyphCount; i++) {
+            const TextGlyphQuad *quad = &run->glyphs[i];
+            float x0 = position.x + quad->x0, y0 = position.y + quad->y0;
+            float x1 = position.x + quad->x1, y1 = position.y + quad->y1;
+
+            rlTexCoord2f(quad->u0, quad->v0); rlVertex2f(x0, y0);
+            rlTexCoord2f(quad->u0, quad->v1); rlVertex2f(x0, y1);
+            rlTexCoord2f(quad->u1, quad->v1); rlVertex2f(x1, y1);
+            rlTexCoord2f(quad->u1, quad->v0); rlVertex2f(x1, y0);
+        }
+
+    rlEnd();
+    rlSetTexture(0);
+}
+
+void UnloadTextCache(TextCache *cache)
+{
+    for (int i = 0; i < TEXT_CACHE_RUNS; i++) {
+        MemFree(cache->runs[i].text);
+        MemFree(cache->runs[i].glyphs);
+    }
+    memset(cache, 0, sizeof(TextCache));
+}
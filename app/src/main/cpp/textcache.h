@@ -0,0 +1,60 @@
+#ifndef TEXTCACHE_H
+#define TEXTCACHE_H
+
+#include "raylib.h"
+
+// --- Text Layout Cache ---
+// HUD strings change rarely but are drawn every frame, and DrawTextEx() decodes UTF-8, looks up glyph
+// indices and builds every quad each time. A text run keeps the glyph quads of one string (relative to
+// its position, texture coordinates already normalized) and replays them straight into the render batch.
+// Runs are keyed by font, size, spacing and string, the least recently used one is replaced when full.
+#define TEXT_CACHE_RUNS             16      // Text runs kept by a cache
+
+// One glyph of a run, position relative to the run origin
+typedef struct TextGlyphQuad {
+    float x0, y0, x1, y1;
+    float u0, v0, u1, v1;
+} TextGlyphQuad;
+
+typedef struct TextRun {
+    unsigned int hash;          // Hash of string, font, size and spacing (0 for an empty slot)
+    unsigned int lastUse;       // Cache use counter value when the run was last requested
+    unsigned int fontId;        // Font texture id
+    float fontSize;
+    float spacing;
+    char *text;                 // Copy of the string, compared on hash match
+    Texture2D texture;          // Font texture the quads sample
+    Vector2 size;               // Same as MeasureTextEx()
+    TextGlyphQuad *glyphs;
+    int glyphCount;
+    int glyphCapacity;
+} TextRun;
+
+typedef struct TextCache {
+    TextRun runs[TEXT_CACHE_RUNS];
+    unsigned int useCounter;
+} TextCache;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Returns the run of 'text', laid out the first time it is requested with these parameters.
+ *
+ * The pointer is valid until TEXT_CACHE_RUNS other strings have been requested, use it right away.
+ */
+const TextRun *GetTextRun(TextCache *cache, Font font, const char *text, float fontSize, float spacing);
+
+/**
+ * @brief Draws a run at 'position', same output as DrawTextEx() with the run parameters.
+ */
+void DrawTextRun(const TextRun *run, Vector2 position, Color tint);
+
+void UnloadTextCache(TextCache *cache);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // TEXTCACHE_H
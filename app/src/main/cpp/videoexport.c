@@ -0,0 +1,89 @@
+#include "videoexport.h"
+
+#include <math.h>
+#include <stdio.h>
+
+bool VideoExportStart(VideoExport *videoExport, const ReplayRecorder *recorder, PhysicsGeometry geometry, const char *fileName)
+{
+    VideoExportCancel(videoExport);
+    videoExport->saved = false;
+
+    unsigned int size = ReplayGetRound(recorder, 0, videoExport->data, sizeof(videoExport->data));
+    if ((size == 0) || !ReplayPlaybackStart(&videoExport->playback, videoExport->data, size, &videoExport->world, geometry)) return false;
+
+    // The round is simulated once for its length (a few ms), then from the start again for the frames
+    long long ticks = 0;
+    while (!videoExport->playback.finished) ticks += ReplayPlaybackAdvance(&videoExport->playback, &videoExport->world, 1024);
+    ReplayPlaybackStart(&videoExport->playback, videoExport->data, size, &videoExport->world, geometry);
+
+    int tickRate = videoExport->world.tickRate;
+    videoExport->frameCount = (int)(ticks*VIDEO_EXPORT_FRAMERATE/tickRate) + 1 + (int)(VIDEO_EXPORT_TAIL*VIDEO_EXPORT_FRAMERATE);
+    if (videoExport->frameCount > (int)(VIDEO_EXPORT_MAX_LENGTH*VIDEO_EXPORT_FRAMERATE)) videoExport->frameCount = (int)(VIDEO_EXPORT_MAX_LENGTH*VIDEO_EXPORT_FRAMERATE);
+
+    videoExport->encoder = LoadVideoEncoder(fileName, VIDEO_EXPORT_WIDTH, VIDEO_EXPORT_HEIGHT, VIDEO_EXPORT_FRAMERATE, VIDEO_EXPORT_BITRATE, VIDEO_EXPORT_CODEC);
+    if (videoExport->encoder == NULL) return false;
+
+    snprintf(videoExport->fileName, sizeof(videoExport->fileName), "%s", fileName);
+    videoExport->frame = 0;
+    videoExport->active = true;
+    CourseCameraReset(&videoExport->camera);
+    TraceLog(LOG_INFO, "REPLAY: Exporting %lld ticks to %s (%i frames)", ticks, fileName, videoExport->frameCount);
+
+    return true;
+}
+
+void VideoExportUpdate(VideoExport *videoExport, VideoExportDrawFunc draw)
+{
+    if (!videoExport->active) return;
+
+    // Playfield on screen fitted into the video, the rest is left black (a course smaller than the screen is centred)
+    Vector2 videoSize = { (float)VIDEO_EXPORT_WIDTH, (float)VIDEO_EXPORT_HEIGHT };
+    const PhysicsWorld *world = &videoExport->world;
+    float zoom = fminf(videoSize.x/fminf(world->width, (float)GetScreenWidth()), videoSize.y/fminf(world->height, (float)GetScreenHeight()));
+
+    double start = GetTime();
+    bool failed = false;
+    while ((videoExport->frame < videoExport->frameCount) && (GetTime() - start < VIDEO_EXPORT_FRAME_BUDGET)) {
+        // Ticks up to the frame time, the last frames repeat the end of the round
+        long long tick = (long long)(videoExport->frame + 1)*world->tickRate/VIDEO_EXPORT_FRAMERATE;
+        if (!videoExport->playback.finished && (tick > videoExport->playback.tick)) {
+            ReplayPlaybackAdvance(&videoExport->playback, &videoExport->world, (int)(tick - videoExport->playback.tick));
+        }
+
+        failed = !BeginVideoFrame(videoExport->encoder);
+        if (failed) break;
+
+        Vector2 ball = PhysicsGetBallPosition(world, videoExport->playback.player.ball);
+        CourseCameraUpdate(&videoExport->camera, world, ball, videoSize, zoom, 1.0f/VIDEO_EXPORT_FRAMERATE);
+
+        ClearBackground(BLACK);
+        draw(world, &videoExport->playback.player, videoExport->camera.camera, videoSize);
+        EndVideoFrame(videoExport->encoder);
+        videoExport->frame++;
+    }
+
+    // Done, or the encoder failed (its file is removed)
+    if (failed || (videoExport->frame == videoExport->frameCount)) {
+        videoExport->saved = UnloadVideoEncoder(videoExport->encoder);
+        videoExport->encoder = NULL;
+        videoExport->active = false;
+    }
+}
+
+void VideoExportCancel(VideoExport *videoExport)
+{
+    if (!videoExport->active) return;
+
+    // NOTE: The encoder closes a valid but partial video, removed since nobody asked for it
+    if (UnloadVideoEncoder(videoExport->encoder)) RemoveFileInAppStorage(videoExport->fileName);
+    TraceLog(LOG_INFO, "REPLAY: Video export cancelled at frame %i of %i", videoExport->frame, videoExport->frameCount);
+
+    videoExport->encoder = NULL;
+    videoExport->active = false;
+}
+
+float GetVideoExportProgress(const VideoExport *videoExport)
+{
+    if (videoExport->frameCount <= 0) return 0.0f;
+    return (float)videoExport->frame/(float)videoExport->frameCount;
+}
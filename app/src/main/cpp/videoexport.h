@@ -0,0 +1,77 @@
+#ifndef VIDEOEXPORT_H
+#define VIDEOEXPORT_H
+
+#include "raylib.h"
+#include "raymob.h"
+#include "replay.h"
+#include "coursecamera.h"
+
+// --- Replay Video Export ---
+// The last recorded round is re-simulated (replay.h) and drawn straight into the input surface of the
+// hardware encoder (raymob LoadVideoEncoder()), then muxed into an MP4 file in app storage. Nothing is
+// read back: the GPU renders into the buffers the encoder compresses, unlike GIF recording. Frames are
+// made as fast as the encoder takes them, within a CPU budget per game frame, so a round exports in a
+// fraction of its length while the game keeps running. Frame times come from the replay ticks, never
+// from the clock. The video goes on VIDEO_EXPORT_TAIL seconds after the round ends. It shows as much of
+// the course as the screen does, following the ball like the game camera (the whole hole when it fits).
+#define VIDEO_EXPORT_WIDTH          1280
+#define VIDEO_EXPORT_HEIGHT         720
+#define VIDEO_EXPORT_FRAMERATE      30
+#define VIDEO_EXPORT_BITRATE        6000000             // bits/s
+#define VIDEO_EXPORT_CODEC          VIDEO_CODEC_HEVC    // H.264 on devices without an HEVC encoder
+#define VIDEO_EXPORT_TAIL           1.5f                // Seconds kept after the ball drops
+#define VIDEO_EXPORT_MAX_LENGTH     180.0f              // Longest video (s), longer rounds are cut
+#define VIDEO_EXPORT_FRAME_BUDGET   0.006               // Seconds per game frame spent exporting
+#define VIDEO_EXPORT_NAME_LENGTH    64                  // Longest file name kept
+
+// Draws one frame of the replayed round, world coordinates are mapped into the video by 'camera'
+typedef void (*VideoExportDrawFunc)(const PhysicsWorld *world, const GolfPlayer *player, Camera2D camera, Vector2 videoSize);
+
+typedef struct VideoExport {
+    unsigned char data[REPLAY_MAX_ROUND_SIZE];  // Round being exported, the playback reads from it
+    ReplayPlayback playback;
+    PhysicsWorld world;
+    VideoEncoder *encoder;
+    CourseCamera camera;        // Follows the replayed ball, in video pixels
+    char fileName[VIDEO_EXPORT_NAME_LENGTH];    // Relative to app storage
+    int frame;                  // Frames encoded
+    int frameCount;             // Length of the video (frames)
+    bool active;
+    bool saved;                 // Last export finished with a complete file
+} VideoExport;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Starts exporting the most recent round of 'recorder' to 'fileName' (relative to app storage).
+ *
+ * 'geometry' must be the one of the recorded hole. An export already running is cancelled.
+ *
+ * @return false if there is no round to export or no encoder (before API 26).
+ */
+bool VideoExportStart(VideoExport *videoExport, const ReplayRecorder *recorder, PhysicsGeometry geometry, const char *fileName);
+
+/**
+ * @brief Encodes frames for up to VIDEO_EXPORT_FRAME_BUDGET, then saves the file once the round is over.
+ *
+ * Call it once a frame, outside of BeginDrawing()/EndDrawing().
+ */
+void VideoExportUpdate(VideoExport *videoExport, VideoExportDrawFunc draw);
+
+/**
+ * @brief Stops the export, the file is removed.
+ */
+void VideoExportCancel(VideoExport *videoExport);
+
+/**
+ * @brief Share of the video encoded, 0.0 to 1.0.
+ */
+float GetVideoExportProgress(const VideoExport *videoExport);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // VIDEOEXPORT_H
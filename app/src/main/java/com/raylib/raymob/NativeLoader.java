@@ -91,9 +91,19 @@ public class NativeLoader extends NativeActivity {
         }
     }
 
+    // Memory pressure, forwarded to raylib RequestMemoryTrim() (the game frees its caches)
+    @Override
+    public void onTrimMemory(int level) {
+        super.onTrimMemory(level);
+        if(initCallback) {
+            onAppTrimMemory(level);
+        }
+    }
+
     private native void onAppStart();
     private native void onAppResume();
     private native void onAppPause();
     private native void onAppStop();
+    private native void onAppTrimMemory(int level);
 
 }
\ No newline at end of file
@@ -0,0 +1,141 @@
+// Asset packer: puts asset files into one pack read by assetpack.c
+// Usage: assetpack <data.pak> <assets dir> <file>...
+// Files are named by their path relative to the assets directory (gfx/atlas.png), as the game loads them
+#include "assetpack.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SDEFL_IMPLEMENTATION
+#include "external/sdefl.h"
+
+#define MAX_FILES           1024
+#define DEFLATE_LEVEL       8       // sdefl compression level (0 to 8)
+#define DEFLATE_MIN_SAVING  8       // Files are deflated when it saves at least 1/8 of their size
+
+typedef struct InputFile {
+    AssetPackEntryRecord record;
+    unsigned char *data;            // Bytes written to the pack (deflated or not)
+} InputFile;
+
+static InputFile files[MAX_FILES];
+static int fileCount = 0;
+
+static int CompareFileName(const void *a, const void *b)
+{
+    return strcmp(((const InputFile *)a)->record.name, ((const InputFile *)b)->record.name);
+}
+
+static unsigned char *ReadFile(const char *path, long *size)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return NULL;
+
+    unsigned char *data = NULL;
+    if ((fseek(file, 0, SEEK_END) == 0) && ((*size = ftell(file)) > 0) && (fseek(file, 0, SEEK_SET) == 0)) {
+        data = (unsigned char *)malloc((size_t)*size);
+        if ((data != NULL) && (fread(data, 1, (size_t)*size, file) != (size_t)*size)) { free(data); data = NULL; }
+    }
+
+    fclose(file);
+    return data;
+}
+
+static bool AddFile(const char *root, const char *name)
+{
+    if (fileCount >= MAX_FILES) { fprintf(stderr, "assetpack: too many files (max %i)\n", MAX_FILES); return false; }
+    if (strlen(name) >= ASSET_PACK_NAME_LENGTH) { fprintf(stderr, "assetpack: %s: name too long\n", name); return false; }
+
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/%s", root, name);
+
+    long size = 0;
+    unsigned char *data = ReadFile(path, &size);
+    if (data == NULL) { fprintf(stderr, "assetpack: %s: can't read (or empty)\n", path); return false; }
+    if (size > INT32_MAX) { fprintf(stderr, "assetpack: %s: too big\n", path); free(data); return false; }
+
+    InputFile *file = &files[fileCount];
+    memset(file, 0, sizeof(InputFile));
+    strcpy(file->record.name, name);
+    file->record.size = (uint32_t)size;
+    file->record.packedSize = (uint32_t)size;
+    file->record.compression = ASSET_PACK_STORED;
+    file->data = data;
+
+    // Kept deflated only when it pays for the inflate on every load
+    static struct sdefl deflater;
+    unsigned char *packed = (unsigned char *)malloc((size_t)sdefl_bound((int)size));
+    int packedSize = (packed != NULL)? sdeflate(&deflater, packed, data, (int)size, DEFLATE_LEVEL) : 0;
+
+    if ((packedSize > 0) && (packedSize <= size - size/DEFLATE_MIN_SAVING)) {
+        file->record.packedSize = (uint32_t)packedSize;
+        file->record.compression = ASSET_PACK_DEFLATE;
+        file->data = packed;
+        free(data);
+    }
+    else free(packed);
+
+    fileCount++;
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 4) {
+        fprintf(stderr, "usage: assetpack <data.pak> <assets dir> <file>...\n");
+        return 2;
+    }
+
+    for (int i = 3; i < argc; i++) {
+        if (!AddFile(argv[2], argv[i])) return 1;
+    }
+
+    // Sorted for the binary search, data follows in the same order (a directory's files end up together)
+    qsort(files, (size_t)fileCount, sizeof(InputFile), CompareFileName);
+
+    for (int i = 1; i < fileCount; i++) {
+        if (strcmp(files[i - 1].record.name, files[i].record.name) == 0) { fprintf(stderr, "assetpack: %s: duplicated file\n", files[i].record.name); return 1; }
+    }
+
+    AssetPackFileHeader header = { 0 };
+    memcpy(header.magic, ASSET_PACK_FILE_MAGIC, 4);
+    header.version = ASSET_PACK_FILE_VERSION;
+    header.entryCount = (uint32_t)fileCount;
+
+    unsigned long long offset = sizeof(AssetPackFileHeader) + (unsigned long long)fileCount*sizeof(AssetPackEntryRecord);
+    for (int i = 0; i < fileCount; i++) {
+        offset = (offset + ASSET_PACK_ALIGNMENT - 1)/ASSET_PACK_ALIGNMENT*ASSET_PACK_ALIGNMENT;
+        files[i].record.offset = (uint32_t)offset;
+        offset += files[i].record.packedSize;
+    }
+    if (offset > INT32_MAX) { fprintf(stderr, "assetpack: pack too big (%llu bytes)\n", offset); return 1; }
+
+    FILE *file = fopen(argv[1], "wb");
+    bool written = (file != NULL) && (fwrite(&header, sizeof(header), 1, file) == 1);
+
+    for (int i = 0; written && (i < fileCount); i++) written = (fwrite(&files[i].record, sizeof(AssetPackEntryRecord), 1, file) == 1);
+
+    for (int i = 0; written && (i < fileCount); i++) {
+        static const unsigned char zeros[ASSET_PACK_ALIGNMENT] = { 0 };
+        long padding = (long)files[i].record.offset - ftell(file);
+
+        written = (padding >= 0) && (fwrite(zeros, 1, (size_t)padding, file) == (size_t)padding) &&
+                  (fwrite(files[i].data, 1, files[i].record.packedSize, file) == files[i].record.packedSize);
+    }
+
+    if (file != NULL) fclose(file);
+    if (!written) {
+        fprintf(stderr, "assetpack: %s: write failed\n", argv[1]);
+        return 1;
+    }
+
+    printf("assetpack: %i files, %llu bytes\n", fileCount, offset);
+    for (int i = 0; i < fileCount; i++) {
+        const AssetPackEntryRecord *record = &files[i].record;
+        printf("  %-40s %9u %9u %s\n", record->name, record->size, record->packedSize, (record->compression == ASSET_PACK_DEFLATE)? "deflate" : "stored");
+        free(files[i].data);
+    }
+
+    return 0;
+}
@@ -0,0 +1,189 @@
+// Sprite atlas packer: packs sprites into one image plus the region table read by atlas.c
+// Usage: atlaspack <atlas.png> <atlas.bin> <sprite.png>...
+// Sprites are named after their file name without extension (gfx/ball.png -> "ball")
+#include "atlas.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#include "external/stb_image.h"
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "external/stb_image_write.h"
+
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "external/stb_rect_pack.h"
+
+#define ATLAS_MIN_SIZE      64
+#define ATLAS_MAX_SIZE      4096
+#define WHITE_SIZE          4       // White region used for shapes
+
+typedef struct InputSprite {
+    char name[ATLAS_NAME_LENGTH];
+    unsigned char *pixels;          // RGBA, NULL for the white region
+    int width;
+    int height;
+} InputSprite;
+
+static InputSprite sprites[ATLAS_MAX_REGIONS];
+static int spriteCount = 0;
+
+static bool AddSprite(const char *fileName)
+{
+    const char *base = strrchr(fileName, '/');
+    base = (base != NULL)? base + 1 : fileName;
+    const char *dot = strrchr(base, '.');
+    size_t length = (dot != NULL)? (size_t)(dot - base) : strlen(base);
+
+    if (spriteCount >= ATLAS_MAX_REGIONS - 1) { fprintf(stderr, "atlaspack: too many sprites (max %i)\n", ATLAS_MAX_REGIONS - 1); return false; }
+    if (length >= ATLAS_NAME_LENGTH) { fprintf(stderr, "atlaspack: %s: name too long\n", fileName); return false; }
+
+    InputSprite *sprite = &sprites[spriteCount];
+    memset(sprite, 0, sizeof(InputSprite));
+    memcpy(sprite->name, base, length);
+
+    for (int i = 0; i < spriteCount; i++) {
+        if (strcmp(sprites[i].name, sprite->name) == 0) { fprintf(stderr, "atlaspack: %s: duplicated sprite name\n", fileName); return false; }
+    }
+    if (strcmp(sprite->name, ATLAS_WHITE_NAME) == 0) { fprintf(stderr, "atlaspack: %s: name is reserved\n", fileName); return false; }
+
+    int channels = 0;
+    sprite->pixels = stbi_load(fileName, &sprite->width, &sprite->height, &channels, 4);
+    if (sprite->pixels == NULL) { fprintf(stderr, "atlaspack: %s: %s\n", fileName, stbi_failure_reason()); return false; }
+
+    spriteCount++;
+    return true;
+}
+
+// Sprite size plus padding, rounded up to whole blocks
+static int BlockCount(int size)
+{
+    return (size + 2*ATLAS_PADDING + ATLAS_BLOCK_SIZE - 1)/ATLAS_BLOCK_SIZE;
+}
+
+// Smallest power of two atlas holding every sprite (width >= height)
+// NOTE: Packed in ATLAS_BLOCK_SIZE units, rects are returned in pixels
+static bool Pack(stbrp_rect *rects, int *atlasWidth, int *atlasHeight)
+{
+    static stbrp_node nodes[ATLAS_MAX_SIZE/ATLAS_BLOCK_SIZE];
+
+    for (int size = ATLAS_MIN_SIZE; size <= ATLAS_MAX_SIZE; size *= 2) {
+        for (int height = size/2; height <= size; height *= 2) {
+            stbrp_context context;
+            stbrp_init_target(&context, size/ATLAS_BLOCK_SIZE, height/ATLAS_BLOCK_SIZE, nodes, size/ATLAS_BLOCK_SIZE);
+
+            for (int i = 0; i < spriteCount; i++) {
+                rects[i].id = i;
+                rects[i].w = BlockCount(sprites[i].width);
+                rects[i].h = BlockCount(sprites[i].height);
+                rects[i].was_packed = 0;
+            }
+
+            if (stbrp_pack_rects(&context, rects, spriteCount)) {
+                for (int i = 0; i < spriteCount; i++) {
+                    rects[i].x *= ATLAS_BLOCK_SIZE;
+                    rects[i].y *= ATLAS_BLOCK_SIZE;
+                    rects[i].w *= ATLAS_BLOCK_SIZE;
+                    rects[i].h *= ATLAS_BLOCK_SIZE;
+                }
+
+                *atlasWidth = size;
+                *atlasHeight = height;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 4) {
+        fprintf(stderr, "usage: atlaspack <atlas.png> <atlas.bin> <sprite.png>...\n");
+        return 2;
+    }
+
+    for (int i = 3; i < argc; i++) {
+        if (!AddSprite(argv[i])) return 1;
+    }
+
+    // White region, so shapes can be drawn from the atlas too
+    InputSprite *white = &sprites[spriteCount++];
+    memset(white, 0, sizeof(InputSprite));
+    strcpy(white->name, ATLAS_WHITE_NAME);
+    white->width = WHITE_SIZE;
+    white->height = WHITE_SIZE;
+
+    stbrp_rect rects[ATLAS_MAX_REGIONS];
+    int width = 0, height = 0;
+    if (!Pack(rects, &width, &height)) {
+        fprintf(stderr, "atlaspack: sprites don't fit in %ix%i\n", ATLAS_MAX_SIZE, ATLAS_MAX_SIZE);
+        return 1;
+    }
+
+    unsigned char *image = (unsigned char *)calloc((size_t)width*height, 4);
+    AtlasFileHeader header = { 0 };
+    AtlasRegionRecord records[ATLAS_MAX_REGIONS];
+    memset(records, 0, sizeof(records));
+
+    memcpy(header.magic, ATLAS_FILE_MAGIC, 4);
+    header.version = ATLAS_FILE_VERSION;
+    header.width = (uint32_t)width;
+    header.height = (uint32_t)height;
+    header.regionCount = (uint32_t)spriteCount;
+
+    for (int i = 0; i < spriteCount; i++) {
+        const InputSprite *sprite = &sprites[rects[i].id];
+        AtlasRegionRecord *record = &records[rects[i].id];
+        int x = rects[i].x + ATLAS_PADDING;
+        int y = rects[i].y + ATLAS_PADDING;
+
+        memcpy(record->name, sprite->name, ATLAS_NAME_LENGTH);
+        record->x = (uint16_t)x;
+        record->y = (uint16_t)y;
+        record->width = (uint16_t)sprite->width;
+        record->height = (uint16_t)sprite->height;
+
+        // Sprite plus its padding (to the end of its blocks), padding repeats the nearest edge pixel
+        for (int py = -ATLAS_PADDING; py < rects[i].h - ATLAS_PADDING; py++) {
+            int sy = (py < 0)? 0 : (py >= sprite->height)? sprite->height - 1 : py;
+
+            for (int px = -ATLAS_PADDING; px < rects[i].w - ATLAS_PADDING; px++) {
+                int sx = (px < 0)? 0 : (px >= sprite->width)? sprite->width - 1 : px;
+                unsigned char *dst = image + ((size_t)(y + py)*width + (x + px))*4;
+
+                if (sprite->pixels != NULL) memcpy(dst, sprite->pixels + ((size_t)sy*sprite->width + sx)*4, 4);
+                else memset(dst, 255, 4);
+            }
+        }
+    }
+
+    if (!stbi_write_png(argv[1], width, height, 4, image, width*4)) {
+        fprintf(stderr, "atlaspack: %s: write failed\n", argv[1]);
+        return 1;
+    }
+
+    FILE *file = fopen(argv[2], "wb");
+    if (file == NULL ||
+        fwrite(&header, sizeof(header), 1, file) != 1 ||
+        fwrite(records, sizeof(AtlasRegionRecord), (size_t)spriteCount, file) != (size_t)spriteCount) {
+        fprintf(stderr, "atlaspack: %s: write failed\n", argv[2]);
+        if (file != NULL) fclose(file);
+        return 1;
+    }
+    fclose(file);
+
+    printf("atlaspack: %i sprites in %ix%i\n", spriteCount, width, height);
+    for (int i = 0; i < spriteCount; i++) {
+        printf("  %-24s %4u %4u %4u %4u\n", records[i].name, records[i].x, records[i].y, records[i].width, records[i].height);
+    }
+
+    for (int i = 0; i < spriteCount; i++) stbi_image_free(sprites[i].pixels);
+    free(image);
+
+    return 0;
+}
@@ -0,0 +1,485 @@
+/*******************************************************************************************
+*
+*   shotsim - Headless batch shot simulator
+*
+*   Plays large numbers of shots on every hole of a course file with the game's own physics
+*   and rules (sim/), spread over all cores, to tune difficulty and validate courses.
+*
+*   Two runs per hole:
+*     - Sweep: one shot from the tee at a random angle and power (hole-in-one, water and reach rates)
+*     - Rounds: a noisy player aiming straight at the cup until holing out (strokes vs par)
+*
+*   Every worker packs PHYSICS_MAX_BALLS independent shots into one world (ghost balls),
+*   so the vector integrator runs full lanes. Results only depend on the shot index,
+*   never on the thread count.
+*
+*   USAGE: shotsim [options] [course.bin]
+*       -n <shots>      Sweep shots per hole (default 1000000)
+*       -g <rounds>     Rounds per hole (default 10000)
+*       -t <threads>    Worker threads (default: all cores)
+*       -r <rate>       Physics tick rate (default PHYSICS_TICK_RATE)
+*
+*       -p <w>x<h>      Procedural holes: every cup candidate of that playfield (sim/holegen.h)
+*                       instead of the course holes, with a par estimate each
+*
+*   Exit code is 1 when a hole can't be finished by the aiming player (course validation)
+*
+*   Each hole also prints a digest of every final ball state (PhysicsGetBallHash()), summed so it
+*   doesn't depend on the thread count either: runs on two machines or ABIs print the same digest
+*   only if the physics reproduced bit for bit (the replays of one device then verify on the other)
+*
+********************************************************************************************/
+
+#include "physics.h"
+#include "course.h"
+#include "rules.h"
+#include "holegen.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SIM_DEFAULT_WIDTH           1920.0f // Playfield of holes without their own size (the game uses the screen)
+#define SIM_DEFAULT_HEIGHT          1080.0f
+#define SIM_MAX_SHOT_SECONDS        20      // A shot still rolling after this is counted as stopped
+#define SIM_MAX_ROUND_STROKES       12      // Rounds are given up after this many strokes
+#define SIM_MAX_THREADS             256
+#define SIM_GAME_START_X            100.0f  // Tee of the game random holes (BALL_START in main.c)
+#define SIM_GAME_START_Y            500.0f
+
+#define AIM_ANGLE_ERROR             0.06f   // Max aiming error (radians, within 0.01%)
+#define AIM_POWER_ERROR             0.15f   // Max power error (fraction of the intended power)
+#define AIM_OVERSHOOT               1.1f    // Aim slightly past the cup, the sink catches slow balls
+
+#define SALT_SWEEP                  0x5357454550ull
+#define SALT_ROUND                  0x524f554e44ull
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct SimJob {
+    const CourseHole *hole;
+    int holeIndex;
+    int tickRate;
+
+    uint64_t firstShot;         // Sweep shots [firstShot, firstShot + shotCount)
+    uint64_t shotCount;
+    uint64_t firstRound;        // Rounds [firstRound, firstRound + roundCount)
+    uint64_t roundCount;
+
+    // Results
+    uint64_t sunk;
+    uint64_t water;
+    double restDistance;        // Sum of final distances to the cup (shots not holed nor in water)
+    uint64_t roundStrokes;
+    uint64_t roundsGivenUp;
+    uint64_t ballTicks;         // Ticks simulated, summed over all balls
+    uint64_t digest;            // Sum of the final state hashes of every shot and round
+} SimJob;
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Deterministic random numbers, seeded by (hole, shot) so results don't depend on threading
+static uint64_t Mix64(uint64_t x)
+{
+    x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27; x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+static float RandomFloat(uint64_t *state)
+{
+    *state += 0x9e3779b97f4a7c15ull;
+    return (float)(Mix64(*state) >> 40)*(1.0f/16777216.0f);
+}
+
+static uint64_t SeedFor(int holeIndex, uint64_t salt, uint64_t index)
+{
+    return Mix64(((uint64_t)holeIndex << 48) ^ (salt << 8) ^ Mix64(index));
+}
+
+static double GetTime(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec*1e-9;
+}
+
+static void SetupWorld(PhysicsWorld *world, const CourseHole *hole, int tickRate)
+{
+    PhysicsInit(world, tickRate);
+    PhysicsSetGeometry(world, hole->geometry);
+
+    world->hole = hole->cup;
+    world->width = (hole->size.x > 0.0f)? hole->size.x : SIM_DEFAULT_WIDTH;
+    world->height = (hole->size.y > 0.0f)? hole->size.y : SIM_DEFAULT_HEIGHT;
+    world->ghostBalls = true;
+
+    for (int i = 0; i < PHYSICS_MAX_BALLS; i++) PhysicsAddBall(world, hole->start);
+}
+
+static float DistanceToCup(const PhysicsWorld *world, int ball)
+{
+    Vector2 position = PhysicsGetBallPosition(world, ball);
+    float dx = world->hole.x - position.x;
+    float dy = world->hole.y - position.y;
+    return sqrtf(dx*dx + dy*dy);
+}
+
+// NOTE: Shots are part of the digest, they are made with basic arithmetic and sqrtf() only (correctly rounded
+// everywhere): libm trigonometry differs between C libraries and would look like a physics divergence
+
+// Rotates a unit vector by 2*atan(t), cos = (1 - t^2)/(1 + t^2) and sin = 2t/(1 + t^2)
+static Vector2 RotateDirection(Vector2 direction, float t)
+{
+    float d = 1.0f + t*t;
+    float c = (1.0f - t*t)/d;
+    float s = 2.0f*t/d;
+    return (Vector2){ direction.x*c - direction.y*s, direction.x*s + direction.y*c };
+}
+
+// Uniformly distributed unit vector, from a point drawn in the unit disk
+static Vector2 RandomDirection(uint64_t *rng)
+{
+    for (;;) {
+        float x = 2.0f*RandomFloat(rng) - 1.0f;
+        float y = 2.0f*RandomFloat(rng) - 1.0f;
+        float lengthSq = x*x + y*y;
+        if ((lengthSq > 1e-6f) && (lengthSq <= 1.0f)) {
+            float length = sqrtf(lengthSq);
+            return (Vector2){ x/length, y/length };
+        }
+    }
+}
+
+// Drag vector a player would use to roll the ball straight to the cup, with some error
+static Vector2 GetAimedDrag(const PhysicsWorld *world, int ball, uint64_t *rng)
+{
+    Vector2 position = PhysicsGetBallPosition(world, ball);
+    Vector2 toCup = { world->hole.x - position.x, world->hole.y - position.y };
+    float distance = sqrtf(toCup.x*toCup.x + toCup.y*toCup.y);
+    Vector2 direction = (distance > 0.0f)? (Vector2){ toCup.x/distance, toCup.y/distance } : (Vector2){ 1.0f, 0.0f };
+
+    // A free rolling ball launched at v (px per reference frame) coasts v/(1 - FRICTION) px
+    float speed = fminf(distance*(1.0f - FRICTION)*AIM_OVERSHOOT, MAX_VELOCITY);
+    speed *= 1.0f + (2.0f*RandomFloat(rng) - 1.0f)*AIM_POWER_ERROR;
+
+    // Invert the shot rule: impulse = SHOT_POWER_SCALE*drag^2/SHOT_MAX_DRAG_DISTANCE
+    float drag = fminf(sqrtf(speed*SHOT_MAX_DRAG_DISTANCE/SHOT_POWER_SCALE), SHOT_MAX_DRAG_DISTANCE);
+    direction = RotateDirection(direction, (2.0f*RandomFloat(rng) - 1.0f)*AIM_ANGLE_ERROR*0.5f);
+
+    return (Vector2){ direction.x*drag, direction.y*drag };
+}
+
+// Single shots from the tee, random angle and power, PHYSICS_MAX_BALLS in flight at once
+static void RunSweep(SimJob *job)
+{
+    PhysicsWorld world;
+    SetupWorld(&world, job->hole, job->tickRate);
+
+    const int maxTicks = SIM_MAX_SHOT_SECONDS*world.tickRate;
+    int laneTicks[PHYSICS_MAX_BALLS] = { 0 };
+    bool laneBusy[PHYSICS_MAX_BALLS] = { 0 };
+    uint64_t next = 0;
+    int busy = 0;
+
+    for (;;) {
+        for (int lane = 0; (lane < PHYSICS_MAX_BALLS) && (next < job->shotCount); lane++) {
+            if (laneBusy[lane]) continue;
+
+            uint64_t rng = SeedFor(job->holeIndex, SALT_SWEEP, job->firstShot + next++);
+            Vector2 direction = RandomDirection(&rng);
+            float power = RandomFloat(&rng)*SHOT_MAX_DRAG_DISTANCE;
+
+            PhysicsResetBall(&world, lane, job->hole->start);
+            PhysicsShoot(&world, lane, GolfGetShotImpulse((Vector2){ direction.x*power, direction.y*power }));
+            laneTicks[lane] = 0;
+            laneBusy[lane] = true;
+            busy++;
+        }
+
+        if (busy == 0) break;
+
+        PhysicsStep(&world);
+
+        for (int lane = 0; lane < PHYSICS_MAX_BALLS; lane++) {
+            if (!laneBusy[lane]) continue;
+            laneTicks[lane]++;
+
+            if (world.balls.sunk[lane]) job->sunk++;
+            else if (world.balls.inHazard[lane]) job->water++;
+            else if (PhysicsIsBallStopped(&world, lane) || (laneTicks[lane] >= maxTicks)) job->restDistance += DistanceToCup(&world, lane);
+            else continue;
+
+            job->ballTicks += (uint64_t)laneTicks[lane];
+            job->digest += Mix64(PhysicsGetBallHash(&world, lane) ^ (uint64_t)laneTicks[lane]);
+            laneBusy[lane] = false;
+            busy--;
+        }
+    }
+}
+
+// Full rounds with the game rules (strokes, water penalty), PHYSICS_MAX_BALLS players at once
+static void RunRounds(SimJob *job)
+{
+    PhysicsWorld world;
+    SetupWorld(&world, job->hole, job->tickRate);
+
+    const int maxTicks = SIM_MAX_ROUND_STROKES*SIM_MAX_SHOT_SECONDS*world.tickRate;
+    GolfPlayer players[PHYSICS_MAX_BALLS] = { 0 };
+    uint64_t laneRng[PHYSICS_MAX_BALLS] = { 0 };
+    int laneTicks[PHYSICS_MAX_BALLS] = { 0 };
+    bool laneBusy[PHYSICS_MAX_BALLS] = { 0 };
+    uint64_t next = 0;
+    int busy = 0;
+
+    for (;;) {
+        for (int lane = 0; lane < PHYSICS_MAX_BALLS; lane++) {
+            GolfPlayer *player = &players[lane];
+
+            if (!laneBusy[lane] && (next < job->roundCount)) {
+                player->ball = lane;
+                GolfPlayerStart(player, &world, job->hole->start);
+                laneRng[lane] = SeedFor(job->holeIndex, SALT_ROUND, job->firstRound + next++);
+                laneTicks[lane] = 0;
+                laneBusy[lane] = true;
+                busy++;
+            }
+
+            if (!laneBusy[lane] || !GolfCanShoot(player, &world)) continue;
+
+            if (player->strokes < SIM_MAX_ROUND_STROKES) GolfShoot(player, &world, GetAimedDrag(&world, lane, &laneRng[lane]));
+            else {
+                job->roundStrokes += SIM_MAX_ROUND_STROKES;
+                job->roundsGivenUp++;
+                job->ballTicks += (uint64_t)laneTicks[lane];
+                laneBusy[lane] = false;
+                busy--;
+            }
+        }
+
+        if (busy == 0) break;
+
+        PhysicsStep(&world);
+
+        for (int lane = 0; lane < PHYSICS_MAX_BALLS; lane++) {
+            if (!laneBusy[lane]) continue;
+
+            GolfPlayer *player = &players[lane];
+            laneTicks[lane]++;
+
+            // Stuck rolling (e.g. on a slope that never lets the ball stop) counts as given up
+            bool holed = GolfUpdate(player, &world);
+            if (!holed && (laneTicks[lane] < maxTicks)) continue;
+
+            job->roundStrokes += holed? (uint64_t)player->strokes : SIM_MAX_ROUND_STROKES;
+            if (!holed) job->roundsGivenUp++;
+            job->ballTicks += (uint64_t)laneTicks[lane];
+            job->digest += Mix64(PhysicsGetBallHash(&world, lane) ^ ((uint64_t)player->strokes << 32) ^ (uint64_t)laneTicks[lane]);
+            laneBusy[lane] = false;
+            busy--;
+        }
+    }
+}
+
+static void *RunJob(void *arg)
+{
+    SimJob *job = (SimJob *)arg;
+
+    RunSweep(job);
+    RunRounds(job);
+
+    return NULL;
+}
+
+static bool LoadCourseFile(const char *fileName, unsigned char **data, CoursePack *pack)
+{
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return false;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    *data = (size > 0)? (unsigned char *)malloc((size_t)size) : NULL;
+    bool loaded = (*data != NULL) && (fread(*data, 1, (size_t)size, file) == (size_t)size);
+    fclose(file);
+
+    return loaded && CoursePackInit(pack, *data, (unsigned int)size);
+}
+
+static void PrintUsage(void)
+{
+    printf("USAGE: shotsim [options] [course.bin]\n"
+           "    -n <shots>      Sweep shots per hole (default 1000000)\n"
+           "    -g <rounds>     Rounds per hole (default 10000)\n"
+           "    -t <threads>    Worker threads (default: all cores)\n"
+           "    -r <rate>       Physics tick rate (default %i)\n"
+           "    -p <w>x<h>      Procedural cups of a playfield, on the course geometry of hole 1 if any\n", PHYSICS_TICK_RATE);
+}
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    uint64_t shotsPerHole = 1000000;
+    uint64_t roundsPerHole = 10000;
+    int threadCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int tickRate = PHYSICS_TICK_RATE;
+    const char *fileName = NULL;
+    Vector2 procedural = { 0.0f, 0.0f };
+
+    for (int i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc)) shotsPerHole = strtoull(argv[++i], NULL, 10);
+        else if ((strcmp(argv[i], "-g") == 0) && (i + 1 < argc)) roundsPerHole = strtoull(argv[++i], NULL, 10);
+        else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc)) threadCount = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-r") == 0) && (i + 1 < argc)) tickRate = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-p") == 0) && (i + 1 < argc)) {
+            if ((sscanf(argv[++i], "%fx%f", &procedural.x, &procedural.y) != 2) || (procedural.x <= 0.0f) || (procedural.y <= 0.0f)) {
+                PrintUsage();
+                return 2;
+            }
+        }
+        else if (argv[i][0] != '-') fileName = argv[i];
+        else { PrintUsage(); return 2; }
+    }
+
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > SIM_MAX_THREADS) threadCount = SIM_MAX_THREADS;
+
+    // Course holes, or the game's default tee shot on an empty screen-sized green
+    unsigned char *courseData = NULL;
+    CoursePack pack = { 0 };
+    int holeCount = 1;
+
+    if (fileName != NULL) {
+        if (!LoadCourseFile(fileName, &courseData, &pack)) {
+            fprintf(stderr, "shotsim: [%s] Failed to load course file\n", fileName);
+            free(courseData);
+            return 2;
+        }
+        holeCount = pack.holeCount;
+    }
+
+    // Procedural holes: the candidate set the game builds for that screen, one hole per cup
+    // NOTE: Without a course the game plays random holes on an empty green, the course geometry is only used here
+    static HoleCandidates candidates;
+    if (procedural.x > 0.0f) {
+        PhysicsGeometry geometry = { 0 };
+        if ((courseData != NULL) && (pack.holeCount > 0)) geometry = CoursePackGetHole(&pack, 0).geometry;
+
+        HoleCandidatesBuild(&candidates, procedural, (Vector2){ SIM_GAME_START_X, SIM_GAME_START_Y }, geometry, HOLEGEN_DEFAULT_SEED);
+        printf("shotsim: %.0fx%.0f playfield, %i cup candidates out of %i samples%s\n", procedural.x, procedural.y,
+               candidates.count, candidates.sampleCount, candidates.relaxed? " (closer to the start than HOLEGEN_MIN_START_DISTANCE)" : "");
+        holeCount = candidates.count;
+    }
+
+    printf("shotsim: %i hole(s), %llu shots and %llu rounds per hole, %i threads, %i Hz\n", holeCount,
+           (unsigned long long)shotsPerHole, (unsigned long long)roundsPerHole, threadCount, (tickRate > 0)? tickRate : PHYSICS_TICK_RATE);
+
+    SimJob jobs[SIM_MAX_THREADS];
+    pthread_t threads[SIM_MAX_THREADS];
+    bool started[SIM_MAX_THREADS];
+    uint64_t totalShots = 0, totalBallTicks = 0;
+    int parMax = 0, unfinished = 0;
+    bool allFinished = true;
+    uint64_t digest = 0;
+    double startTime = GetTime();
+
+    for (int h = 0; h < holeCount; h++) {
+        CourseHole hole = { 0 };
+        if (procedural.x > 0.0f) {
+            if (courseData != NULL) hole.geometry = candidates.geometry;
+            hole.start = candidates.start;
+            hole.cup = candidates.cups[h];
+            hole.size = procedural;
+        }
+        else if (courseData != NULL) hole = CoursePackGetHole(&pack, h);
+        else {
+            hole.start = (Vector2){ 100.0f, 500.0f };
+            hole.cup = (Vector2){ 380.0f, 420.0f };
+            hole.par = 2;
+        }
+
+        double holeStart = GetTime();
+
+        for (int t = 0; t < threadCount; t++) {
+            SimJob *job = &jobs[t];
+            memset(job, 0, sizeof(SimJob));
+            job->hole = &hole;
+            job->holeIndex = h;
+            job->tickRate = tickRate;
+            job->firstShot = shotsPerHole*(uint64_t)t/(uint64_t)threadCount;
+            job->shotCount = shotsPerHole*(uint64_t)(t + 1)/(uint64_t)threadCount - job->firstShot;
+            job->firstRound = roundsPerHole*(uint64_t)t/(uint64_t)threadCount;
+            job->roundCount = roundsPerHole*(uint64_t)(t + 1)/(uint64_t)threadCount - job->firstRound;
+
+            // Run it on this thread if no thread can be created
+            started[t] = (pthread_create(&threads[t], NULL, RunJob, job) == 0);
+            if (!started[t]) RunJob(job);
+        }
+
+        SimJob total = { 0 };
+        for (int t = 0; t < threadCount; t++) {
+            if (started[t]) pthread_join(threads[t], NULL);
+            total.sunk += jobs[t].sunk;
+            total.water += jobs[t].water;
+            total.restDistance += jobs[t].restDistance;
+            total.roundStrokes += jobs[t].roundStrokes;
+            total.roundsGivenUp += jobs[t].roundsGivenUp;
+            total.ballTicks += jobs[t].ballTicks;
+            total.digest += jobs[t].digest;
+        }
+
+        double holeTime = GetTime() - holeStart;
+        uint64_t rested = shotsPerHole - total.sunk - total.water;
+
+        // Procedural par: what the aiming player needs, rounded (par 2 at least, like authored holes)
+        if ((procedural.x > 0.0f) && (roundsPerHole > 0)) {
+            hole.par = (int)lrint((double)total.roundStrokes/(double)roundsPerHole);
+            if (hole.par < 2) hole.par = 2;
+            if (hole.par > parMax) parMax = hole.par;
+        }
+
+        printf("hole %2i (par %i): holed %6.3f%%  water %6.3f%%  mean rest %7.1f px  |  mean strokes %5.2f  given up %6.3f%%  |  %016llx  %.3f s\n",
+               h + 1, hole.par,
+               (shotsPerHole > 0)? 100.0*(double)total.sunk/(double)shotsPerHole : 0.0,
+               (shotsPerHole > 0)? 100.0*(double)total.water/(double)shotsPerHole : 0.0,
+               (rested > 0)? total.restDistance/(double)rested : 0.0,
+               (roundsPerHole > 0)? (double)total.roundStrokes/(double)roundsPerHole : 0.0,
+               (roundsPerHole > 0)? 100.0*(double)total.roundsGivenUp/(double)roundsPerHole : 0.0,
+               (unsigned long long)total.digest, holeTime);
+
+        if ((roundsPerHole > 0) && (total.roundsGivenUp == roundsPerHole)) {
+            fprintf(stderr, "shotsim: hole %i could not be finished in any round\n", h + 1);
+            allFinished = false;
+            unfinished++;
+        }
+
+        totalShots += shotsPerHole;
+        totalBallTicks += total.ballTicks;
+        digest = Mix64(digest ^ total.digest);
+    }
+
+    double elapsed = GetTime() - startTime;
+    printf("shotsim: %llu sweep shots in %.2f s (%.2f M shots/s incl. rounds, %.1f M ball ticks/s)\n",
+           (unsigned long long)totalShots, elapsed, (double)totalShots/elapsed*1e-6, (double)totalBallTicks/elapsed*1e-6);
+
+    printf("shotsim: physics digest %016llx\n", (unsigned long long)digest);
+    if (procedural.x > 0.0f) printf("shotsim: %i/%i procedural holes can be finished, par up to %i\n", holeCount - unfinished, holeCount, parMax);
+
+    free(courseData);
+
+    return allFinished? 0 : 1;
+}
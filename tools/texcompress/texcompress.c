@@ -0,0 +1,501 @@
+// GPU texture compressor: encodes PNG images as ASTC 4x4 (.astc) and ETC2 RGBA8 EAC (.ktx), read by texformat.c
+// Usage: texcompress <image.png>...
+// Files are written next to each image (gfx/atlas.png -> gfx/atlas.astc, gfx/atlas.ktx). Both formats use
+// 16 bytes per 4x4 block (8 bits per pixel, 4x smaller than RGBA8), image sizes must be multiples of 4.
+// Blocks are encoded independently, so sprites should not share a block (see ATLAS_BLOCK_SIZE in atlas.h).
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#include "external/stb_image.h"
+
+#define BLOCK_SIZE          4
+#define BLOCK_BYTES         16
+
+#define GL_RGBA                         0x1908
+#define GL_COMPRESSED_RGBA8_ETC2_EAC    0x9278
+
+// Pixels of one block, RGBA
+typedef struct Block {
+    int pixels[16][4];
+} Block;
+
+// Transparent pixels still count a little, their color shows when filtered next to opaque ones
+static int ColorWeight(int alpha)
+{
+    return alpha + 8;
+}
+
+static int Clamp255(int value)
+{
+    return (value < 0)? 0 : (value > 255)? 255 : value;
+}
+
+//----------------------------------------------------------------------------------
+// ETC2 RGBA8 EAC: EAC alpha block, then an ETC2 color block (individual and differential modes),
+// both 64 bit big-endian, pixels in column-major order
+//----------------------------------------------------------------------------------
+static const int etcModifiers[8][4] = {
+    { 2, 8, -2, -8 }, { 5, 17, -5, -17 }, { 9, 29, -9, -29 }, { 13, 42, -13, -42 },
+    { 18, 60, -18, -60 }, { 24, 80, -24, -80 }, { 33, 106, -33, -106 }, { 47, 183, -47, -183 }
+};
+
+static const int eacModifiers[16][8] = {
+    { -3, -6, -9, -15, 2, 5, 8, 14 }, { -3, -7, -10, -13, 2, 6, 9, 12 }, { -2, -5, -8, -13, 1, 4, 7, 12 },
+    { -2, -4, -6, -13, 1, 3, 5, 12 }, { -3, -6, -8, -12, 2, 5, 7, 11 }, { -3, -7, -9, -11, 2, 6, 8, 10 },
+    { -4, -7, -8, -11, 3, 6, 7, 10 }, { -3, -5, -8, -11, 2, 4, 7, 10 }, { -2, -6, -8, -10, 1, 5, 7, 9 },
+    { -2, -5, -8, -10, 1, 4, 7, 9 }, { -2, -4, -8, -10, 1, 3, 7, 9 }, { -2, -5, -7, -10, 1, 4, 6, 9 },
+    { -3, -4, -7, -10, 2, 3, 6, 9 }, { -1, -2, -3, -10, 0, 1, 2, 9 }, { -4, -6, -8, -9, 3, 5, 7, 8 },
+    { -3, -5, -7, -9, 2, 4, 6, 8 }
+};
+
+#define EAC_CONSTANT_TABLE  13  // Has a 0 modifier (index 4), any constant alpha is exact
+
+// Column-major pixel index of ETC/EAC blocks
+static int EtcPixel(int x, int y)
+{
+    return x*4 + y;
+}
+
+static uint64_t EncodeEacAlpha(const Block *block)
+{
+    int minAlpha = 255, maxAlpha = 0;
+    for (int i = 0; i < 16; i++) {
+        if (block->pixels[i][3] < minAlpha) minAlpha = block->pixels[i][3];
+        if (block->pixels[i][3] > maxAlpha) maxAlpha = block->pixels[i][3];
+    }
+
+    int bestBase = minAlpha, bestMultiplier = 1, bestTable = EAC_CONSTANT_TABLE;
+    int bestIndices[16];
+    for (int i = 0; i < 16; i++) bestIndices[i] = 4;
+
+    if (minAlpha != maxAlpha) {
+        int bestError = 0x7fffffff;
+        int range = maxAlpha - minAlpha;
+
+        for (int table = 0; table < 16; table++) {
+            const int *modifiers = eacModifiers[table];
+            int span = modifiers[7] - modifiers[3];
+
+            for (int multiplier = 1; multiplier < 16; multiplier++) {
+                if (multiplier > 1 && span*(multiplier - 1) > range) break;
+
+                int center = (minAlpha + maxAlpha)/2 - ((modifiers[7] + modifiers[3])*multiplier)/2;
+
+                for (int base = center - 2; base <= center + 2; base++) {
+                    if (base < 0 || base > 255) continue;
+
+                    int error = 0;
+                    int indices[16];
+                    for (int i = 0; i < 16 && error < bestError; i++) {
+                        int bestPixelError = 0x7fffffff;
+                        for (int k = 0; k < 8; k++) {
+                            int d = Clamp255(base + modifiers[k]*multiplier) - block->pixels[i][3];
+                            if (d*d < bestPixelError) { bestPixelError = d*d; indices[i] = k; }
+                        }
+                        error += bestPixelError;
+                    }
+
+                    if (error < bestError) {
+                        bestError = error;
+                        bestBase = base;
+                        bestMultiplier = multiplier;
+                        bestTable = table;
+                        memcpy(bestIndices, indices, sizeof(indices));
+                    }
+                }
+            }
+        }
+    }
+
+    uint64_t bits = ((uint64_t)bestBase << 56) | ((uint64_t)bestMultiplier << 52) | ((uint64_t)bestTable << 48);
+    for (int x = 0; x < 4; x++) {
+        for (int y = 0; y < 4; y++) {
+            int i = EtcPixel(x, y);
+            bits |= (uint64_t)bestIndices[y*4 + x] << (45 - 3*i);
+        }
+    }
+
+    return bits;
+}
+
+// Best table and pixel indices for a half block around 'base' (8 bit per channel), returns the error
+static int FitEtcSubblock(const Block *block, int flip, int half, const int base[3], int *table, int indices[16])
+{
+    int bestError = 0x7fffffff;
+
+    for (int t = 0; t < 8; t++) {
+        int error = 0;
+        int tableIndices[16];
+
+        for (int p = 0; p < 16; p++) {
+            int x = p%4, y = p/4;
+            if (((flip? y : x) >= 2) != half) continue;
+
+            const int *pixel = block->pixels[p];
+            int bestPixelError = 0x7fffffff;
+            for (int k = 0; k < 4; k++) {
+                int dr = Clamp255(base[0] + etcModifiers[t][k]) - pixel[0];
+                int dg = Clamp255(base[1] + etcModifiers[t][k]) - pixel[1];
+                int db = Clamp255(base[2] + etcModifiers[t][k]) - pixel[2];
+                int e = (dr*dr + dg*dg + db*db)*ColorWeight(pixel[3]);
+                if (e < bestPixelError) { bestPixelError = e; tableIndices[p] = k; }
+            }
+            error += bestPixelError;
+        }
+
+        if (error < bestError) {
+            bestError = error;
+            *table = t;
+            for (int p = 0; p < 16; p++) {
+                int x = p%4, y = p/4;
+                if (((flip? y : x) >= 2) == half) indices[p] = tableIndices[p];
+            }
+        }
+    }
+
+    return bestError;
+}
+
+static uint64_t EncodeEtcColor(const Block *block)
+{
+    uint64_t bestBits = 0;
+    int64_t bestError = INT64_MAX;
+
+    for (int flip = 0; flip < 2; flip++) {
+        // Weighted average color of each half
+        int average[2][3] = { { 0 } };
+        for (int half = 0; half < 2; half++) {
+            int sum[3] = { 0 }, weight = 0;
+            for (int p = 0; p < 16; p++) {
+                int x = p%4, y = p/4;
+                if (((flip? y : x) >= 2) != half) continue;
+
+                int w = ColorWeight(block->pixels[p][3]);
+                for (int c = 0; c < 3; c++) sum[c] += block->pixels[p][c]*w;
+                weight += w;
+            }
+            for (int c = 0; c < 3; c++) average[half][c] = (sum[c] + weight/2)/weight;
+        }
+
+        for (int differential = 0; differential < 2; differential++) {
+            int quantized[2][3], base[2][3];
+
+            for (int half = 0; half < 2; half++) {
+                for (int c = 0; c < 3; c++) {
+                    if (differential) {
+                        quantized[half][c] = (average[half][c]*31 + 127)/255;
+                        if (half == 1) {
+                            // Second color is stored as a -4..3 delta of the first
+                            int delta = quantized[1][c] - quantized[0][c];
+                            if (delta < -4) quantized[1][c] = quantized[0][c] - 4;
+                            if (delta > 3) quantized[1][c] = quantized[0][c] + 3;
+                        }
+                        base[half][c] = (quantized[half][c] << 3) | (quantized[half][c] >> 2);
+                    } else {
+                        quantized[half][c] = (average[half][c]*15 + 127)/255;
+                        base[half][c] = quantized[half][c]*17;
+                    }
+                }
+            }
+
+            int tables[2] = { 0 }, indices[16] = { 0 };
+            int64_t error = (int64_t)FitEtcSubblock(block, flip, 0, base[0], &tables[0], indices) +
+                            FitEtcSubblock(block, flip, 1, base[1], &tables[1], indices);
+            if (error >= bestError) continue;
+
+            uint64_t bits = 0;
+            if (differential) {
+                bits |= ((uint64_t)quantized[0][0] << 59) | ((uint64_t)((quantized[1][0] - quantized[0][0]) & 7) << 56);
+                bits |= ((uint64_t)quantized[0][1] << 51) | ((uint64_t)((quantized[1][1] - quantized[0][1]) & 7) << 48);
+                bits |= ((uint64_t)quantized[0][2] << 43) | ((uint64_t)((quantized[1][2] - quantized[0][2]) & 7) << 40);
+            } else {
+                bits |= ((uint64_t)quantized[0][0] << 60) | ((uint64_t)quantized[1][0] << 56);
+                bits |= ((uint64_t)quantized[0][1] << 52) | ((uint64_t)quantized[1][1] << 48);
+                bits |= ((uint64_t)quantized[0][2] << 44) | ((uint64_t)quantized[1][2] << 40);
+            }
+            bits |= ((uint64_t)tables[0] << 37) | ((uint64_t)tables[1] << 34) | ((uint64_t)differential << 33) | ((uint64_t)flip << 32);
+
+            for (int x = 0; x < 4; x++) {
+                for (int y = 0; y < 4; y++) {
+                    int i = EtcPixel(x, y), index = indices[y*4 + x];
+                    bits |= (uint64_t)(index >> 1) << (16 + i);
+                    bits |= (uint64_t)(index & 1) << i;
+                }
+            }
+
+            bestError = error;
+            bestBits = bits;
+        }
+    }
+
+    return bestBits;
+}
+
+static void StoreBigEndian64(unsigned char *dst, uint64_t value)
+{
+    for (int i = 0; i < 8; i++) dst[i] = (unsigned char)(value >> (56 - 8*i));
+}
+
+static void EncodeEtc2Block(const Block *block, unsigned char *dst)
+{
+    StoreBigEndian64(dst, EncodeEacAlpha(block));
+    StoreBigEndian64(dst + 8, EncodeEtcColor(block));
+}
+
+//----------------------------------------------------------------------------------
+// ASTC 4x4 LDR: one partition, RGBA direct endpoints (CEM 12) at 8 bits, 4x4 grid of 2 bit weights
+//----------------------------------------------------------------------------------
+#define ASTC_BLOCK_MODE     0x042   // 4x4 weight grid, weight range 0..3, single plane
+#define ASTC_CEM_RGBA       12
+
+static const int astcWeights[4] = { 0, 21, 43, 64 };    // Unquantized 2 bit weights
+
+static int DecodeAstcChannel(int e0, int e1, int weight)
+{
+    int c0 = e0*257, c1 = e1*257;
+    return ((c0*(64 - weight) + c1*weight + 32) >> 6) >> 8;
+}
+
+static int64_t AstcPixelError(const int *pixel, const int e0[4], const int e1[4], int weight)
+{
+    int64_t error = 0;
+    for (int c = 0; c < 3; c++) {
+        int d = DecodeAstcChannel(e0[c], e1[c], weight) - pixel[c];
+        error += (int64_t)d*d*ColorWeight(pixel[3]);
+    }
+    int d = DecodeAstcChannel(e0[3], e1[3], weight) - pixel[3];
+
+    return error + (int64_t)d*d*ColorWeight(255);
+}
+
+// Best weight of every pixel for two endpoints, returns the block error
+static int64_t AssignAstcWeights(const Block *block, const int e0[4], const int e1[4], int weights[16])
+{
+    int64_t error = 0;
+
+    for (int p = 0; p < 16; p++) {
+        int64_t bestPixelError = INT64_MAX;
+        for (int w = 0; w < 4; w++) {
+            int64_t e = AstcPixelError(block->pixels[p], e0, e1, astcWeights[w]);
+            if (e < bestPixelError) { bestPixelError = e; weights[p] = w; }
+        }
+        error += bestPixelError;
+    }
+
+    return error;
+}
+
+// Least squares endpoints for fixed weights
+static bool RefineAstcEndpoints(const Block *block, const int weights[16], int e0[4], int e1[4])
+{
+    double aa = 0.0, ab = 0.0, bb = 0.0, ax[4] = { 0 }, bx[4] = { 0 };
+
+    for (int p = 0; p < 16; p++) {
+        double b = astcWeights[weights[p]]/64.0, a = 1.0 - b;
+        aa += a*a; ab += a*b; bb += b*b;
+        for (int c = 0; c < 4; c++) {
+            ax[c] += a*block->pixels[p][c];
+            bx[c] += b*block->pixels[p][c];
+        }
+    }
+
+    double det = aa*bb - ab*ab;
+    if (det < 1e-9 && det > -1e-9) return false;
+
+    for (int c = 0; c < 4; c++) {
+        e0[c] = Clamp255((int)((ax[c]*bb - bx[c]*ab)/det + 0.5));
+        e1[c] = Clamp255((int)((bx[c]*aa - ax[c]*ab)/det + 0.5));
+    }
+    return true;
+}
+
+static void EncodeAstcBlock(const Block *block, unsigned char *dst)
+{
+    // Principal axis of the block colors (power iteration on the covariance)
+    double mean[4] = { 0 }, cov[4][4] = { { 0 } }, axis[4] = { 1.0, 1.0, 1.0, 1.0 };
+    for (int p = 0; p < 16; p++) for (int c = 0; c < 4; c++) mean[c] += block->pixels[p][c]/16.0;
+    for (int p = 0; p < 16; p++) {
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 4; j++) cov[i][j] += (block->pixels[p][i] - mean[i])*(block->pixels[p][j] - mean[j]);
+        }
+    }
+    for (int iteration = 0; iteration < 8; iteration++) {
+        double next[4] = { 0 }, length = 0.0;
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 4; j++) next[i] += cov[i][j]*axis[j];
+            length += next[i]*next[i];
+        }
+        if (length < 1e-12) break;
+        for (int i = 0; i < 4; i++) axis[i] = next[i]/sqrt(length);
+    }
+
+    double minT = 0.0, maxT = 0.0;
+    for (int p = 0; p < 16; p++) {
+        double t = 0.0;
+        for (int c = 0; c < 4; c++) t += (block->pixels[p][c] - mean[c])*axis[c];
+        if (t < minT) minT = t;
+        if (t > maxT) maxT = t;
+    }
+
+    int e0[4], e1[4], weights[16];
+    for (int c = 0; c < 4; c++) {
+        e0[c] = Clamp255((int)(mean[c] + minT*axis[c] + 0.5));
+        e1[c] = Clamp255((int)(mean[c] + maxT*axis[c] + 0.5));
+    }
+    int64_t error = AssignAstcWeights(block, e0, e1, weights);
+
+    for (int iteration = 0; iteration < 2 && error > 0; iteration++) {
+        int r0[4], r1[4], rw[16];
+        if (!RefineAstcEndpoints(block, weights, r0, r1)) break;
+
+        int64_t refined = AssignAstcWeights(block, r0, r1, rw);
+        if (refined >= error) break;
+
+        error = refined;
+        memcpy(e0, r0, sizeof(e0));
+        memcpy(e1, r1, sizeof(e1));
+        memcpy(weights, rw, sizeof(weights));
+    }
+
+    // Endpoints with a smaller RGB sum than the first are decoded with blue contraction, swap them
+    if (e1[0] + e1[1] + e1[2] < e0[0] + e0[1] + e0[2]) {
+        for (int c = 0; c < 4; c++) { int t = e0[c]; e0[c] = e1[c]; e1[c] = t; }
+        for (int p = 0; p < 16; p++) weights[p] = 3 - weights[p];
+    }
+
+    // Header and endpoints from bit 0 up, weights from bit 127 down
+    memset(dst, 0, BLOCK_BYTES);
+    int values[8] = { e0[0], e1[0], e0[1], e1[1], e0[2], e1[2], e0[3], e1[3] };
+    uint64_t low = ASTC_BLOCK_MODE | (0u << 11) | ((uint64_t)ASTC_CEM_RGBA << 13);
+    unsigned char bits[128] = { 0 };
+
+    for (int i = 0; i < 17; i++) bits[i] = (low >> i) & 1;
+    for (int v = 0; v < 8; v++) {
+        for (int b = 0; b < 8; b++) bits[17 + v*8 + b] = (values[v] >> b) & 1;
+    }
+    for (int p = 0; p < 16; p++) {
+        bits[127 - 2*p] = weights[p] & 1;
+        bits[127 - (2*p + 1)] = (weights[p] >> 1) & 1;
+    }
+
+    for (int i = 0; i < 128; i++) dst[i/8] |= (unsigned char)(bits[i] << (i%8));
+}
+
+//----------------------------------------------------------------------------------
+// Files
+//----------------------------------------------------------------------------------
+static void GetBlock(const unsigned char *pixels, int width, int bx, int by, Block *block)
+{
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+            const unsigned char *src = pixels + ((size_t)(by*4 + y)*width + (bx*4 + x))*4;
+            for (int c = 0; c < 4; c++) block->pixels[y*4 + x][c] = src[c];
+        }
+    }
+}
+
+static bool WriteAstc(const char *fileName, const unsigned char *pixels, int width, int height)
+{
+    FILE *file = fopen(fileName, "wb");
+    if (file == NULL) return false;
+
+    unsigned char header[16] = {
+        0x13, 0xab, 0xa1, 0x5c, BLOCK_SIZE, BLOCK_SIZE, 1,
+        (unsigned char)width, (unsigned char)(width >> 8), (unsigned char)(width >> 16),
+        (unsigned char)height, (unsigned char)(height >> 8), (unsigned char)(height >> 16),
+        1, 0, 0
+    };
+    bool ok = (fwrite(header, sizeof(header), 1, file) == 1);
+
+    for (int by = 0; by < height/4 && ok; by++) {
+        for (int bx = 0; bx < width/4 && ok; bx++) {
+            Block block;
+            unsigned char data[BLOCK_BYTES];
+            GetBlock(pixels, width, bx, by, &block);
+            EncodeAstcBlock(&block, data);
+            ok = (fwrite(data, BLOCK_BYTES, 1, file) == 1);
+        }
+    }
+
+    return (fclose(file) == 0) && ok;
+}
+
+static bool WriteEtc2Ktx(const char *fileName, const unsigned char *pixels, int width, int height)
+{
+    FILE *file = fopen(fileName, "wb");
+    if (file == NULL) return false;
+
+    // KTX 1.1 header, one mipmap level
+    static const unsigned char identifier[12] = { 0xab, 'K', 'T', 'X', ' ', '1', '1', 0xbb, '\r', '\n', 0x1a, '\n' };
+    uint32_t header[13] = {
+        0x04030201, 0, 1, 0, GL_COMPRESSED_RGBA8_ETC2_EAC, GL_RGBA,
+        (uint32_t)width, (uint32_t)height, 0, 0, 1, 1, 0
+    };
+    uint32_t imageSize = (uint32_t)(width/4)*(uint32_t)(height/4)*BLOCK_BYTES;
+
+    bool ok = (fwrite(identifier, sizeof(identifier), 1, file) == 1) &&
+              (fwrite(header, sizeof(header), 1, file) == 1) &&
+              (fwrite(&imageSize, sizeof(imageSize), 1, file) == 1);
+
+    for (int by = 0; by < height/4 && ok; by++) {
+        for (int bx = 0; bx < width/4 && ok; bx++) {
+            Block block;
+            unsigned char data[BLOCK_BYTES];
+            GetBlock(pixels, width, bx, by, &block);
+            EncodeEtc2Block(&block, data);
+            ok = (fwrite(data, BLOCK_BYTES, 1, file) == 1);
+        }
+    }
+
+    return (fclose(file) == 0) && ok;
+}
+
+static bool CompressImage(const char *fileName)
+{
+    int width = 0, height = 0, channels = 0;
+    unsigned char *pixels = stbi_load(fileName, &width, &height, &channels, 4);
+    if (pixels == NULL) { fprintf(stderr, "texcompress: %s: %s\n", fileName, stbi_failure_reason()); return false; }
+
+    if (width%BLOCK_SIZE != 0 || height%BLOCK_SIZE != 0) {
+        fprintf(stderr, "texcompress: %s: %ix%i is not a multiple of %i\n", fileName, width, height, BLOCK_SIZE);
+        stbi_image_free(pixels);
+        return false;
+    }
+
+    char outName[1024];
+    const char *dot = strrchr(fileName, '.');
+    int length = (dot != NULL && strchr(dot, '/') == NULL)? (int)(dot - fileName) : (int)strlen(fileName);
+    if (length + 6 > (int)sizeof(outName)) { fprintf(stderr, "texcompress: %s: path too long\n", fileName); stbi_image_free(pixels); return false; }
+
+    bool ok = true;
+    snprintf(outName, sizeof(outName), "%.*s.astc", length, fileName);
+    if (!WriteAstc(outName, pixels, width, height)) { fprintf(stderr, "texcompress: %s: write failed\n", outName); ok = false; }
+
+    snprintf(outName, sizeof(outName), "%.*s.ktx", length, fileName);
+    if (ok && !WriteEtc2Ktx(outName, pixels, width, height)) { fprintf(stderr, "texcompress: %s: write failed\n", outName); ok = false; }
+
+    if (ok) printf("texcompress: %s %ix%i, %i KB compressed (RGBA8 %i KB)\n", fileName, width, height, width*height/1024, width*height*4/1024);
+
+    stbi_image_free(pixels);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: texcompress <image.png>...\n");
+        return 2;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (!CompressImage(argv[i])) return 1;
+    }
+
+    return 0;
+}
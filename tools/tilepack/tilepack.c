@@ -0,0 +1,163 @@
+// Course background tiler: cuts a hole background into the tiles streamed by coursetiles.c
+// Usage: tilepack <background.png> <prefix>
+// Writes <prefix>.bin (tile table) and <prefix>/<col>_<row>.png, tiles of one color get no image
+#include "coursetiles.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#include "external/stb_image.h"
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "external/stb_image_write.h"
+
+static bool IsDirectory(const char *path)
+{
+    struct stat info;
+    return (stat(path, &info) == 0) && S_ISDIR(info.st_mode);
+}
+
+// Creates a directory and its missing parents
+static bool MakeDirectories(const char *path)
+{
+    char partial[COURSE_TILE_NAME_LENGTH];
+    snprintf(partial, sizeof(partial), "%s", path);
+
+    for (char *c = partial + 1; ; c++) {
+        if ((*c != '/') && (*c != '\0')) continue;
+        char end = *c;
+        *c = '\0';
+        if ((mkdir(partial, 0755) != 0) && !IsDirectory(partial)) return false;
+        if (end == '\0') return true;
+        *c = end;
+    }
+}
+
+static int Clamp(int value, int min, int max)
+{
+    return (value < min)? min : (value > max)? max : value;
+}
+
+// Tile image with its padding, pixels past the background edges repeat the nearest edge pixel
+static void CutTile(const unsigned char *pixels, int width, int height, int col, int row, unsigned char *tile)
+{
+    for (int py = 0; py < COURSE_TILE_IMAGE_SIZE; py++) {
+        int sy = Clamp(row*COURSE_TILE_SIZE + py - COURSE_TILE_PADDING, 0, height - 1);
+
+        for (int px = 0; px < COURSE_TILE_IMAGE_SIZE; px++) {
+            int sx = Clamp(col*COURSE_TILE_SIZE + px - COURSE_TILE_PADDING, 0, width - 1);
+            memcpy(tile + ((size_t)py*COURSE_TILE_IMAGE_SIZE + px)*4, pixels + ((size_t)sy*width + sx)*4, 4);
+        }
+    }
+}
+
+// Average color of the pixels a tile covers, and whether they are all that color
+static bool GetTileColor(const unsigned char *pixels, int width, int height, int col, int row, uint8_t *color)
+{
+    int x0 = col*COURSE_TILE_SIZE, x1 = Clamp(x0 + COURSE_TILE_SIZE, 0, width);
+    int y0 = row*COURSE_TILE_SIZE, y1 = Clamp(y0 + COURSE_TILE_SIZE, 0, height);
+    const unsigned char *first = pixels + ((size_t)y0*width + x0)*4;
+    uint64_t sum[4] = { 0 };
+    bool solid = true;
+
+    for (int y = y0; y < y1; y++) {
+        for (int x = x0; x < x1; x++) {
+            const unsigned char *pixel = pixels + ((size_t)y*width + x)*4;
+            for (int c = 0; c < 4; c++) sum[c] += pixel[c];
+            if (memcmp(pixel, first, 4) != 0) solid = false;
+        }
+    }
+
+    uint64_t count = (uint64_t)(x1 - x0)*(uint64_t)(y1 - y0);
+    for (int c = 0; c < 4; c++) color[c] = (uint8_t)((sum[c] + count/2)/count);
+
+    return solid;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3) {
+        fprintf(stderr, "usage: tilepack <background.png> <prefix>\n");
+        return 2;
+    }
+
+    const char *prefix = argv[2];
+    int width = 0, height = 0, channels = 0;
+    unsigned char *pixels = stbi_load(argv[1], &width, &height, &channels, 4);
+    if (pixels == NULL) { fprintf(stderr, "tilepack: %s: %s\n", argv[1], stbi_failure_reason()); return 1; }
+
+    int cols = (width + COURSE_TILE_SIZE - 1)/COURSE_TILE_SIZE;
+    int rows = (height + COURSE_TILE_SIZE - 1)/COURSE_TILE_SIZE;
+    if (cols*rows > COURSE_TILES_MAX_TILES) {
+        fprintf(stderr, "tilepack: %s: %ix%i is more than %i tiles\n", argv[1], width, height, COURSE_TILES_MAX_TILES);
+        return 1;
+    }
+
+    // NOTE: The game reads tile names from the asset pack path, keep the prefix relative to the assets
+    if (strlen(prefix) + sizeof("/000_000.png") > COURSE_TILE_NAME_LENGTH) {
+        fprintf(stderr, "tilepack: %s: prefix too long (max %i characters)\n", prefix, (int)(COURSE_TILE_NAME_LENGTH - sizeof("/000_000.png")));
+        return 1;
+    }
+
+    if (!MakeDirectories(prefix)) {
+        fprintf(stderr, "tilepack: %s: can't create directory\n", prefix);
+        return 1;
+    }
+
+    CourseTilesFileHeader header = { 0 };
+    memcpy(header.magic, COURSE_TILES_FILE_MAGIC, 4);
+    header.version = COURSE_TILES_FILE_VERSION;
+    header.tileSize = COURSE_TILE_SIZE;
+    header.padding = COURSE_TILE_PADDING;
+    header.width = (uint32_t)width;
+    header.height = (uint32_t)height;
+    header.cols = (uint32_t)cols;
+    header.rows = (uint32_t)rows;
+
+    CourseTileRecord *records = (CourseTileRecord *)calloc((size_t)cols*rows, sizeof(CourseTileRecord));
+    unsigned char *tile = (unsigned char *)malloc((size_t)COURSE_TILE_IMAGE_SIZE*COURSE_TILE_IMAGE_SIZE*4);
+    int images = 0;
+
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < cols; col++) {
+            CourseTileRecord *record = &records[row*cols + col];
+            if (GetTileColor(pixels, width, height, col, row, record->color)) {
+                record->flags |= COURSE_TILE_SOLID;
+                continue;
+            }
+
+            char fileName[COURSE_TILE_NAME_LENGTH];
+            snprintf(fileName, sizeof(fileName), "%s/%i_%i.png", prefix, col, row);
+            CutTile(pixels, width, height, col, row, tile);
+            if (!stbi_write_png(fileName, COURSE_TILE_IMAGE_SIZE, COURSE_TILE_IMAGE_SIZE, 4, tile, COURSE_TILE_IMAGE_SIZE*4)) {
+                fprintf(stderr, "tilepack: %s: write failed\n", fileName);
+                return 1;
+            }
+            images++;
+        }
+    }
+
+    char tableName[COURSE_TILE_NAME_LENGTH + 8];
+    snprintf(tableName, sizeof(tableName), "%s.bin", prefix);
+    FILE *file = fopen(tableName, "wb");
+    if (file == NULL ||
+        fwrite(&header, sizeof(header), 1, file) != 1 ||
+        fwrite(records, sizeof(CourseTileRecord), (size_t)cols*rows, file) != (size_t)cols*rows) {
+        fprintf(stderr, "tilepack: %s: write failed\n", tableName);
+        if (file != NULL) fclose(file);
+        return 1;
+    }
+    fclose(file);
+
+    printf("tilepack: %ix%i px in %ix%i tiles, %i images, %i solid\n", width, height, cols, rows, images, cols*rows - images);
+
+    free(tile);
+    free(records);
+    stbi_image_free(pixels);
+
+    return 0;
+}